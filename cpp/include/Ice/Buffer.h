@@ -15,6 +15,8 @@
 namespace IceInternal
 {
 
+class BufferPool;
+
 class ICE_API Buffer : private IceUtil::noncopyable
 {
 public:
@@ -83,6 +85,12 @@ public:
 
         void clear();
 
+        //
+        // Use the given pool to allocate the buffer memory. The pool is
+        // only set if the container doesn't already own memory.
+        //
+        void setPool(BufferPool*);
+
         void resize(size_type n) // Inlined for performance reasons.
         {
             if(n == 0)
@@ -142,12 +150,14 @@ public:
         Container(const Container&);
         void operator=(const Container&);
         void reserve(size_type);
+        void deallocate();
 
         pointer _buf;
         size_type _size;
         size_type _capacity;
         int _shrinkCounter;
         bool _owned;
+        BufferPool* _pool;
     };
 
     Container b;
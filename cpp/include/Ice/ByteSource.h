@@ -0,0 +1,59 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_BYTE_SOURCE_H
+#define ICE_BYTE_SOURCE_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Handle.h>
+#include <Ice/Config.h>
+#include <vector>
+
+namespace Ice
+{
+
+//
+// A byte source provides the data of a byte sequence parameter with
+// the "cpp:stream" metadata. The application implements it to send the
+// data of a parameter, the Ice run time provides it to read the data
+// of a received parameter.
+//
+// The data of a byte source is sent in chunks after the request or
+// reply which carries the parameter, so it doesn't need to fit in
+// memory or in Ice.MessageSizeMax. The chunks are only sent as fast as
+// the receiver reads them with read().
+//
+// A source implemented by the application is read by a dedicated thread,
+// and a request or reply with a received source is dispatched by a
+// dedicated thread unless a dispatcher is configured. Reading a source
+// doesn't block the thread pool threads.
+//
+class ICE_API ByteSource
+#ifndef ICE_CPP11_MAPPING
+    : public virtual IceUtil::Shared
+#endif
+{
+public:
+
+    virtual ~ByteSource();
+
+    //
+    // Reads at most maxSize bytes into data, replacing its contents.
+    // Returns false once all the data has been read, data is empty in
+    // this case. A source provided by the Ice run time blocks until
+    // data is received and raises the local exception which aborted
+    // the transfer, if any.
+    //
+    virtual bool read(std::vector<Byte>& data, Int maxSize) = 0;
+};
+ICE_DEFINE_PTR(ByteSourcePtr, ByteSource);
+
+}
+
+#endif
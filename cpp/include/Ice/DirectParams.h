@@ -0,0 +1,78 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_DIRECT_PARAMS_H
+#define ICE_DIRECT_PARAMS_H
+
+#include <IceUtil/Config.h>
+#include <Ice/Config.h>
+#include <Ice/Version.h>
+
+namespace Ice
+{
+
+class OutputStream;
+
+}
+
+namespace IceInternal
+{
+
+class OutgoingAsync;
+class Incoming;
+
+//
+// The parameters of a synchronous invocation. The generated code
+// derives a class from DirectParams for each operation which can be
+// dispatched without marshaling its parameters: the in parameters
+// are held by reference and the results are stored by the generated
+// dispatch code when the servant returns.
+//
+// A collocated request dispatched from the invoking thread passes
+// the parameters directly to the servant. In all other cases, the
+// parameters are marshaled with write() before the request is sent,
+// or when the dispatch requires the encoded parameters (blobjects,
+// AMD servants, ...).
+//
+class ICE_API DirectParams : private IceUtil::noncopyable
+{
+public:
+
+    DirectParams() : _completed(false)
+    {
+    }
+    virtual ~DirectParams();
+
+    virtual void write(Ice::OutputStream*) const = 0;
+
+    //
+    // Called by the generated dispatch code once the results are set.
+    //
+    void completed()
+    {
+        _completed = true;
+    }
+
+    bool isCompleted() const
+    {
+        return _completed;
+    }
+
+private:
+
+    friend class OutgoingAsync;
+    friend class Incoming;
+
+    Ice::EncodingVersion _encoding;
+    bool _completed;
+};
+
+}
+
+#endif
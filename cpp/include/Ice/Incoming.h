@@ -21,6 +21,8 @@
 #include <Ice/IncomingAsyncF.h>
 #include <Ice/ObserverHelper.h>
 #include <Ice/ResponseHandlerF.h>
+#include <Ice/DirectParams.h>
+#include <Ice/UniquePtr.h>
 
 #include <deque>
 
@@ -163,15 +165,36 @@ public:
         _format = format;
     }
 
+    void setDirectParams(DirectParams*);
+
     void invoke(const ServantManagerPtr&, Ice::InputStream*);
 
+    //
+    // The parameters of a collocated request dispatched from the
+    // invoking thread, or null if the parameters are marshaled.
+    //
+    DirectParams* getDirectParams() const
+    {
+        return _directParams;
+    }
+
     // Inlined for speed optimization.
     void skipReadParams()
     {
+        if(_directParams)
+        {
+            _directParams = 0;
+            return;
+        }
         _current.encoding = _is->skipEncapsulation();
     }
     Ice::InputStream* startReadParams()
     {
+        if(_directParams)
+        {
+            readDirectParams();
+        }
+
         //
         // Remember the encoding used by the input parameters, we'll
         // encode the response parameters with the same encoding.
@@ -185,20 +208,33 @@ public:
     }
     void readEmptyParams()
     {
+        if(_directParams)
+        {
+            readDirectParams();
+        }
         _current.encoding = _is->skipEmptyEncapsulation();
     }
     void readParamEncaps(const Ice::Byte*& v, Ice::Int& sz)
     {
+        if(_directParams)
+        {
+            readDirectParams();
+        }
         _current.encoding = _is->readEncapsulation(v, sz);
     }
 
 private:
 
+    void readDirectParams();
+
     friend class IncomingAsync;
 
     Ice::InputStream* _is;
     Ice::Byte* _inParamPos;
 
+    DirectParams* _directParams;
+    UniquePtr<Ice::InputStream> _directStream;
+
     IncomingAsyncPtr _inAsync;
 };
 
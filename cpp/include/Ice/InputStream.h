@@ -23,6 +23,7 @@
 #include <Ice/UserExceptionFactory.h>
 #include <Ice/StreamHelpers.h>
 #include <Ice/FactoryTable.h>
+#include <Ice/ByteSource.h>
 
 namespace Ice
 {
@@ -471,6 +472,15 @@ public:
     void read(std::vector<Byte>&);
     void read(std::pair<const Byte*, const Byte*>&);
 
+    //
+    // Streamed byte sequence. If the data of the sequence is received
+    // after the message, the source set with setStreamedSource() is
+    // returned, otherwise the returned source provides the data of the
+    // sequence marshaled in the message.
+    //
+    void read(ByteSourcePtr&);
+    void setStreamedSource(const ByteSourcePtr&);
+
 #ifndef ICE_CPP11_MAPPING
     // This method is useful for generic stream helpers
     void read(std::pair<const Byte*, const Byte*>& p, ::IceUtil::ScopedArray<Byte>& result)
@@ -971,6 +981,8 @@ private:
 
     void* _closure;
 
+    ByteSourcePtr _streamedSource;
+
     bool _sliceValues;
 
     int _startSeq;
@@ -23,6 +23,7 @@
 #include <Ice/ObserverHelper.h>
 #include <Ice/LocalException.h>
 #include <Ice/UniquePtr.h>
+#include <Ice/DirectParams.h>
 
 #ifndef ICE_CPP11_MAPPING
 #    include <Ice/AsyncResult.h>
@@ -233,6 +234,18 @@ protected:
 
     virtual void runTimerTask();
 
+    //
+    // Returns true if the invocation sends a message, the send queue
+    // limit of the connection only applies to these invocations.
+    //
+    virtual bool sendsMessage() const;
+
+    //
+    // Returns true if the caller waits for the completion of the
+    // invocation, only these invocations block on a full send queue.
+    //
+    virtual bool synchronous() const;
+
     const Ice::ObjectPrxPtr _proxy;
     RequestHandlerPtr _handler;
     Ice::OperationMode _mode;
@@ -262,9 +275,11 @@ public:
 
     void abort(const Ice::Exception&);
     void invoke(const std::string&);
+    void invoke(const std::string&, DirectParams&);
 #ifdef ICE_CPP11_MAPPING
     void invoke(const std::string&, Ice::OperationMode, Ice::FormatType, const Ice::Context&,
                 std::function<void(Ice::OutputStream*)>);
+    void invoke(const std::string&, Ice::OperationMode, Ice::FormatType, const Ice::Context&, DirectParams&);
     void throwUserException();
 #endif
 
@@ -295,6 +310,10 @@ public:
 
 protected:
 
+    virtual bool synchronous() const;
+
+    void writeDirectParams();
+
     const Ice::EncodingVersion _encoding;
 
 #ifdef ICE_CPP11_MAPPING
@@ -302,6 +321,14 @@ protected:
 #endif
 
     bool _synchronous;
+
+    //
+    // The parameters which are not yet marshaled, see invoke(const
+    // std::string&, DirectParams&).
+    //
+    DirectParams* _directParams;
+    bool _hasDirectParams;
+    bool _directDispatch;
 };
 
 }
@@ -432,6 +459,20 @@ public:
         OutgoingAsync::invoke(operation, mode, format, ctx, std::move(write));
     }
 
+    void
+    invoke(const std::string& operation,
+           Ice::OperationMode mode,
+           Ice::FormatType format,
+           const Ice::Context& ctx,
+           DirectParams& params,
+           std::function<void(const Ice::UserException&)> userException,
+           std::function<T(Ice::InputStream*)> read)
+    {
+        _read = std::move(read);
+        _userException = std::move(userException);
+        OutgoingAsync::invoke(operation, mode, format, ctx, params);
+    }
+
 protected:
 
     std::function<T(Ice::InputStream*)> _read;
@@ -455,6 +496,18 @@ public:
         _userException = std::move(userException);
         OutgoingAsync::invoke(operation, mode, format, ctx, std::move(write));
     }
+
+    void
+    invoke(const std::string& operation,
+           Ice::OperationMode mode,
+           Ice::FormatType format,
+           const Ice::Context& ctx,
+           DirectParams& params,
+           std::function<void(const Ice::UserException&)> userException)
+    {
+        _userException = std::move(userException);
+        OutgoingAsync::invoke(operation, mode, format, ctx, params);
+    }
 };
 
 template<typename R>
@@ -19,6 +19,7 @@
 #include <Ice/Protocol.h>
 #include <Ice/SlicedDataF.h>
 #include <Ice/StreamHelpers.h>
+#include <Ice/ByteSource.h>
 
 namespace Ice
 {
@@ -255,6 +256,25 @@ public:
         StreamHelper<T, StreamableTraits<T>::helper>::write(this, v);
     }
 
+    //
+    // Streamed byte sequence. The sequence is written empty, its data
+    // is sent by the connection after the message, or marshaled in
+    // place by inlineStreamedSource(). A message holds at most one
+    // streamed sequence.
+    //
+    void write(const ByteSourcePtr&);
+
+    const ByteSourcePtr& getStreamedSource() const
+    {
+        return _streamedSource;
+    }
+
+    //
+    // Reads all the data of the streamed sequence, if any, and
+    // marshals it in place of the empty sequence.
+    //
+    void inlineStreamedSource();
+
     template<typename T> void write(Int tag, const IceUtil::Optional<T>& v)
     {
         if(!v)
@@ -551,6 +571,14 @@ private:
     //
     void* _closure;
 
+    //
+    // The streamed sequence, the position of its size and the start of
+    // its encapsulation.
+    //
+    ByteSourcePtr _streamedSource;
+    size_type _streamedPos;
+    size_type _streamedEncapsPos;
+
     class Encaps;
     enum SliceType { NoSlice, ValueSlice, ExceptionSlice };
 
@@ -56,11 +56,60 @@ const ::Ice::Byte validateConnectionMsg = 3;
 const ::Ice::Byte closeConnectionMsg = 4;
 
 //
-// The request header, batch request header and reply header.
+// A fragment message carries a slice of a message larger than the
+// fragment size. It's only sent to peers which advertised support for
+// fragments with the validate connection message.
+//
+const ::Ice::Byte fragmentMsg = 5;
+
+//
+// The data of a streamed byte sequence parameter is sent with stream
+// chunk messages after the request or reply which carries it. The
+// receiver grants credits to the sender with stream credit messages,
+// the sender never sends more data than the credits granted. Both
+// messages are only sent to peers which advertised support for streams
+// with the validate connection message.
+//
+const ::Ice::Byte streamChunkMsg = 6;
+const ::Ice::Byte streamCreditMsg = 7;
+
+//
+// The flags of stream chunk and stream credit messages. The reply flag
+// is set for the streams of replies, the end flag is set on the last
+// chunk and the abort flag cancels the transfer.
+//
+const ::Ice::Byte streamReplyFlag = 0x01;
+const ::Ice::Byte streamEndFlag = 0x02;
+const ::Ice::Byte streamAbortFlag = 0x04;
+
+//
+// The flags of the compression status of validate connection messages,
+// in addition to the offered codec. Older Ice versions ignore them. The
+// sender of a validate connection message with the request flag wants
+// to send fragments and expects a validate connection message with the
+// support flag from the peer. The stream support flag advertises the
+// support for streamed parameters.
+//
+const ::Ice::Byte fragmentSupportFlag = 0x80;
+const ::Ice::Byte fragmentRequestFlag = 0x40;
+const ::Ice::Byte streamSupportFlag = 0x20;
+
+//
+// The flag of the compression status of requests and replies whose
+// streamed parameter is sent with stream chunk messages.
+//
+const ::Ice::Byte streamFlag = 0x80;
+
+//
+// The request header, batch request header, reply header, fragment
+// header and stream headers.
 //
 extern const ::Ice::Byte requestHdr[headerSize + sizeof(Ice::Int)];
 extern const ::Ice::Byte requestBatchHdr[headerSize + sizeof(Ice::Int)];
 extern const ::Ice::Byte replyHdr[headerSize];
+extern const ::Ice::Byte fragmentHdr[headerSize + sizeof(Ice::Int)];
+extern const ::Ice::Byte streamChunkHdr[headerSize + sizeof(Ice::Int) + sizeof(Ice::Byte)];
+extern const ::Ice::Byte streamCreditHdr[headerSize + sizeof(Ice::Int) + sizeof(Ice::Byte)];
 
 //
 // IPv4/IPv6 support enumeration.
@@ -94,6 +94,10 @@ public:
     virtual Ice::ConnectionPtr getConnection() const;
 
     void invoke(const std::string&);
+
+protected:
+
+    virtual bool sendsMessage() const;
 };
 typedef IceUtil::Handle<ProxyGetConnection> ProxyGetConnectionPtr;
 
@@ -548,6 +552,9 @@ public:
     bool ice_isConnectionCached() const;
     ::std::shared_ptr<::Ice::ObjectPrx> ice_connectionCached(bool) const;
 
+    ::Ice::Int ice_getConnectionStripes() const;
+    ::std::shared_ptr<::Ice::ObjectPrx> ice_connectionStripes(::Ice::Int) const;
+
     ::Ice::EndpointSelectionType ice_getEndpointSelection() const;
     ::std::shared_ptr<::Ice::ObjectPrx> ice_endpointSelection(::Ice::EndpointSelectionType) const;
 
@@ -572,6 +579,9 @@ public:
     ::Ice::Int ice_getInvocationTimeout() const;
     ::std::shared_ptr<::Ice::ObjectPrx> ice_invocationTimeout(::Ice::Int) const;
 
+    ::Ice::Int ice_getPriority() const;
+    ::std::shared_ptr<::Ice::ObjectPrx> ice_priority(::Ice::Int) const;
+
     ::std::shared_ptr<::Ice::ObjectPrx> ice_twoway() const;
     bool ice_isTwoway() const;
     ::std::shared_ptr<::Ice::ObjectPrx> ice_oneway() const;
@@ -751,6 +761,11 @@ public:
         return ::std::dynamic_pointer_cast<Prx>(ObjectPrx::ice_connectionCached(cached));
     }
 
+    ::std::shared_ptr<Prx> ice_connectionStripes(int stripes) const
+    {
+        return ::std::dynamic_pointer_cast<Prx>(ObjectPrx::ice_connectionStripes(stripes));
+    }
+
     ::std::shared_ptr<Prx> ice_endpointSelection(::Ice::EndpointSelectionType selection) const
     {
         return ::std::dynamic_pointer_cast<Prx>(ObjectPrx::ice_endpointSelection(selection));
@@ -786,6 +801,11 @@ public:
         return ::std::dynamic_pointer_cast<Prx>(ObjectPrx::ice_invocationTimeout(timeout));
     }
 
+    ::std::shared_ptr<Prx> ice_priority(int priority) const
+    {
+        return ::std::dynamic_pointer_cast<Prx>(ObjectPrx::ice_priority(priority));
+    }
+
     ::std::shared_ptr<Prx> ice_twoway() const
     {
         return ::std::dynamic_pointer_cast<Prx>(ObjectPrx::ice_twoway());
@@ -1332,6 +1352,9 @@ public:
     bool ice_isConnectionCached() const;
     ::Ice::ObjectPrx ice_connectionCached(bool) const;
 
+    ::Ice::Int ice_getConnectionStripes() const;
+    ::Ice::ObjectPrx ice_connectionStripes(::Ice::Int) const;
+
     ::Ice::EndpointSelectionType ice_getEndpointSelection() const;
     ::Ice::ObjectPrx ice_endpointSelection(::Ice::EndpointSelectionType) const;
 
@@ -1356,6 +1379,9 @@ public:
     ::Ice::Int ice_getInvocationTimeout() const;
     ::Ice::ObjectPrx ice_invocationTimeout(::Ice::Int) const;
 
+    ::Ice::Int ice_getPriority() const;
+    ::Ice::ObjectPrx ice_priority(::Ice::Int) const;
+
     ::Ice::ObjectPrx ice_twoway() const;
     bool ice_isTwoway() const;
     ::Ice::ObjectPrx ice_oneway() const;
@@ -1538,6 +1564,11 @@ public:
         return dynamic_cast<Prx*>(::IceProxy::Ice::Object::ice_connectionCached(cached).get());
     }
 
+    IceInternal::ProxyHandle<Prx> ice_connectionStripes(int stripes) const
+    {
+        return dynamic_cast<Prx*>(::IceProxy::Ice::Object::ice_connectionStripes(stripes).get());
+    }
+
     IceInternal::ProxyHandle<Prx> ice_endpointSelection(::Ice::EndpointSelectionType selection) const
     {
         return dynamic_cast<Prx*>(::IceProxy::Ice::Object::ice_endpointSelection(selection).get());
@@ -1573,6 +1604,11 @@ public:
         return dynamic_cast<Prx*>(::IceProxy::Ice::Object::ice_invocationTimeout(timeout).get());
     }
 
+    IceInternal::ProxyHandle<Prx> ice_priority(int priority) const
+    {
+        return dynamic_cast<Prx*>(::IceProxy::Ice::Object::ice_priority(priority).get());
+    }
+
     IceInternal::ProxyHandle<Prx> ice_twoway() const
     {
         return dynamic_cast<Prx*>(::IceProxy::Ice::Object::ice_twoway().get());
@@ -466,6 +466,12 @@ public:
     // occurs.
     //
     virtual CertificatePtr decode(const std::string&) const = 0;
+
+    //
+    // Get the number of trust manager decisions found (hits) and not
+    // found (misses) in the cache configured with IceSSL.TrustCache.Size.
+    //
+    virtual void getTrustCacheStatistics(Ice::Long&, Ice::Long&) const = 0;
 };
 ICE_DEFINE_PTR(PluginPtr, Plugin);
 
@@ -39,6 +39,7 @@
 #include <IceUtil/ThreadException.h>
 #include <IceUtil/Time.h>
 #include <IceUtil/Timer.h>
+#include <IceUtil/TimerWheel.h>
 #include <IceUtil/UUID.h>
 
 #include <IceUtil/PopDisableWarnings.h>
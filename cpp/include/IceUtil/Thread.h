@@ -176,5 +176,17 @@ typedef Handle<Thread> ThreadPtr;
     
 }
 
+namespace IceUtilInternal
+{
+
+//
+// Returns a hash of the calling thread ID, used to spread the threads
+// over the shards of a data structure. A given thread always gets the
+// same hash.
+//
+ICE_API size_t getThreadIdHash();
+
+}
+
 #endif
 
@@ -65,18 +65,18 @@ public:
     // Destroy the timer and detach its execution thread if the calling thread 
     // is the timer thread, join the timer execution thread otherwise.
     //
-    void destroy();
+    virtual void destroy();
 
     //
     // Schedule a task for execution after a given delay.
     //
-    void schedule(const TimerTaskPtr&, const IceUtil::Time&);
+    virtual void schedule(const TimerTaskPtr&, const IceUtil::Time&);
 
     //
     // Schedule a task for repeated execution with the given delay
     // between each execution.
     //
-    void scheduleRepeated(const TimerTaskPtr&, const IceUtil::Time&);
+    virtual void scheduleRepeated(const TimerTaskPtr&, const IceUtil::Time&);
 
     //
     // Cancel a task. Returns true if the task has not yet run or if
@@ -84,10 +84,20 @@ public:
     // the task has already run, was already cancelled or was never
     // schedulded.
     //
-    bool cancel(const TimerTaskPtr&);
+    virtual bool cancel(const TimerTaskPtr&);
 
 protected:
 
+    struct NoThread
+    {
+    };
+
+    //
+    // Construct a timer without starting its execution thread, for
+    // timers which execute tasks with their own threads.
+    //
+    Timer(NoThread);
+
     virtual void run();
     virtual void runTimerTask(const TimerTaskPtr&);
 
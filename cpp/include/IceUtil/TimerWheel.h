@@ -0,0 +1,119 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_UTIL_TIMER_WHEEL_H
+#define ICE_UTIL_TIMER_WHEEL_H
+
+#include <IceUtil/Timer.h>
+#include <IceUtil/Cond.h>
+
+#include <vector>
+
+namespace IceUtil
+{
+
+//
+// A timer implemented with a hierarchical timing wheel. Scheduling and
+// cancelling a task are O(1) regardless of the number of scheduled
+// tasks, at the cost of precision: the timer time is divided in ticks
+// and a task runs at the first tick following its scheduled time,
+// together with the other tasks of this tick. Tasks are executed by a
+// set of timer threads, tasks scheduled for the same tick might
+// therefore run concurrently. A repeated task never runs concurrently
+// with itself.
+//
+class ICE_API TimerWheel : public Timer
+{
+public:
+
+    //
+    // Construct a timer with the given tick and number of execution
+    // threads and start its threads.
+    //
+    TimerWheel(const IceUtil::Time&, int);
+
+    //
+    // Construct a timer with the given tick and number of execution
+    // threads and start its threads with the priority.
+    //
+    TimerWheel(const IceUtil::Time&, int, int);
+
+    virtual ~TimerWheel();
+
+    //
+    // Destroy the timer and detach the calling thread if it's a timer
+    // thread, join the timer execution threads otherwise.
+    //
+    virtual void destroy();
+
+    virtual void schedule(const TimerTaskPtr&, const IceUtil::Time&);
+    virtual void scheduleRepeated(const TimerTaskPtr&, const IceUtil::Time&);
+    virtual bool cancel(const TimerTaskPtr&);
+
+private:
+
+    struct Link
+    {
+        Link* prev;
+        Link* next;
+    };
+
+    struct Entry;
+    class WheelThread;
+    friend class WheelThread;
+
+    void start(int, bool, int);
+    void add(const TimerTaskPtr&, const IceUtil::Time&, bool);
+    void insert(Entry*, const IceUtil::Time&, const IceUtil::Time&);
+    void place(Entry*);
+    void advance(Int64);
+    void cascade(int, size_t);
+    Int64 nextTick() const;
+    void runThread();
+    void runTask(const TimerTaskPtr&);
+
+    Entry* find(const TimerTask*) const;
+    void erase(const TimerTask*);
+    void rehash();
+    Entry* newEntry();
+    void freeEntry(Entry*);
+
+    IceUtil::Mutex _mutex;
+    IceUtil::Cond _tickCond;
+    IceUtil::Cond _readyCond;
+
+    const IceUtil::Time _start;
+    const Int64 _tick;
+
+    //
+    // The level 0 slots followed by the slots of the upper levels, and
+    // the tasks ready for execution.
+    //
+    std::vector<Link> _slots;
+    Link _ready;
+    size_t _scheduled;
+    Int64 _currentTick;
+    Int64 _wakeUpTick;
+    bool _ticking;
+    int _idle;
+
+    //
+    // The scheduled tasks hashed by address, and the free entries.
+    //
+    std::vector<Entry*> _buckets;
+    size_t _entries;
+    Entry* _free;
+
+    std::vector<IceUtil::ThreadPtr> _threads;
+};
+typedef IceUtil::Handle<TimerWheel> TimerWheelPtr;
+
+}
+
+#endif
@@ -25,6 +25,10 @@ class TcpAcceptor;
 ICE_API IceUtil::Shared* upCast(TcpAcceptor*);
 typedef Handle<TcpAcceptor> TcpAcceptorPtr;
 
+class UnixAcceptor;
+ICE_API IceUtil::Shared* upCast(UnixAcceptor*);
+typedef Handle<UnixAcceptor> UnixAcceptorPtr;
+
 }
 
 #endif
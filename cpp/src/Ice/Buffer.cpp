@@ -8,6 +8,7 @@
 // **********************************************************************
 
 #include <Ice/Buffer.h>
+#include <Ice/BufferPool.h>
 #include <Ice/LocalException.h>
 
 using namespace std;
@@ -26,7 +27,8 @@ IceInternal::Buffer::Container::Container() :
     _size(0),
     _capacity(0),
     _shrinkCounter(0),
-    _owned(true)
+    _owned(true),
+    _pool(0)
 {
 }
 
@@ -35,12 +37,14 @@ IceInternal::Buffer::Container::Container(const_iterator beg, const_iterator end
     _size(end - beg),
     _capacity(end - beg),
     _shrinkCounter(0),
-    _owned(false)
+    _owned(false),
+    _pool(0)
 {
 }
 
 IceInternal::Buffer::Container::Container(const vector<value_type>& v) :
-    _shrinkCounter(0)
+    _shrinkCounter(0),
+    _pool(0)
 {
     if(v.empty())
     {
@@ -67,12 +71,14 @@ IceInternal::Buffer::Container::Container(Container& other, bool adopt)
         _capacity = other._capacity;
         _shrinkCounter = other._shrinkCounter;
         _owned = other._owned;
+        _pool = other._pool;
 
         other._buf = 0;
         other._size = 0;
         other._capacity = 0;
         other._shrinkCounter = 0;
         other._owned = true;
+        other._pool = 0;
     }
     else
     {
@@ -81,14 +87,16 @@ IceInternal::Buffer::Container::Container(Container& other, bool adopt)
         _capacity = other._capacity;
         _shrinkCounter = 0;
         _owned = false;
+        _pool = 0;
     }
 }
 
 IceInternal::Buffer::Container::~Container()
 {
-    if(_buf && _owned)
+    deallocate();
+    if(_pool)
     {
-        ::free(_buf);
+        _pool->__decRef();
     }
 }
 
@@ -100,15 +108,13 @@ IceInternal::Buffer::Container::swap(Container& other)
     std::swap(_capacity, other._capacity);
     std::swap(_shrinkCounter, other._shrinkCounter);
     std::swap(_owned, other._owned);
+    std::swap(_pool, other._pool);
 }
 
 void
 IceInternal::Buffer::Container::clear()
 {
-    if(_buf && _owned)
-    {
-        ::free(_buf);
-    }
+    deallocate();
 
     _buf = 0;
     _size = 0;
@@ -136,7 +142,33 @@ IceInternal::Buffer::Container::reserve(size_type n)
     }
 
     pointer p;
-    if(_owned)
+    if(_pool)
+    {
+        //
+        // The pool rounds up the capacity to its size class, there's
+        // nothing to do if it doesn't change the buffer capacity.
+        //
+        if(_owned && _buf && BufferPool::getCapacity(_capacity) == c)
+        {
+            _capacity = c;
+            return;
+        }
+
+        p = _pool->allocate(_capacity);
+        if(p && _buf)
+        {
+            ::memcpy(p, _buf, std::min(_size, _capacity));
+            if(_owned)
+            {
+                _pool->release(_buf, c);
+            }
+        }
+        if(p)
+        {
+            _owned = true;
+        }
+    }
+    else if(_owned)
     {
         p = reinterpret_cast<pointer>(::realloc(_buf, _capacity));
     }
@@ -158,3 +190,30 @@ IceInternal::Buffer::Container::reserve(size_type n)
 
     _buf = p;
 }
+
+void
+IceInternal::Buffer::Container::setPool(BufferPool* pool)
+{
+    if(!pool || _pool || (_buf && _owned))
+    {
+        return;
+    }
+    _pool = pool;
+    _pool->__incRef();
+}
+
+void
+IceInternal::Buffer::Container::deallocate()
+{
+    if(_buf && _owned)
+    {
+        if(_pool)
+        {
+            _pool->release(_buf, _capacity);
+        }
+        else
+        {
+            ::free(_buf);
+        }
+    }
+}
@@ -0,0 +1,160 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/BufferPool.h>
+#include <Ice/InstrumentationI.h>
+#include <IceUtil/Thread.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(BufferPool* p) { return p; }
+
+IceInternal::BufferPool::BufferPool(size_t maxBytes) :
+    _maxBytes(std::min(maxBytes, static_cast<size_t>(0x7fffffff)))
+{
+}
+
+IceInternal::BufferPool::~BufferPool()
+{
+    for(int i = 0; i < ShardCount; ++i)
+    {
+        for(int c = 0; c < ClassCount; ++c)
+        {
+            vector<Byte*>& buffers = _shards[i].buffers[c];
+            for(vector<Byte*>::const_iterator p = buffers.begin(); p != buffers.end(); ++p)
+            {
+                ::free(*p);
+            }
+        }
+    }
+}
+
+Byte*
+IceInternal::BufferPool::allocate(size_t& capacity)
+{
+    capacity = getCapacity(capacity);
+    if(capacity > (static_cast<size_t>(1) << MaxClassShift))
+    {
+        //
+        // Buffers larger than the largest size class aren't cached.
+        //
+        return reinterpret_cast<Byte*>(::malloc(capacity));
+    }
+
+    Shard& shard = getShard();
+    Byte* p = 0;
+    BufferPoolObserverIPtr observer;
+    {
+        IceUtil::Mutex::Lock sync(shard.mutex);
+        vector<Byte*>& buffers = shard.buffers[getClass(capacity)];
+        if(!buffers.empty())
+        {
+            p = buffers.back();
+            buffers.pop_back();
+        }
+        observer = shard.observer;
+    }
+
+    bool cached = p != 0;
+    int cachedBytes;
+    if(cached)
+    {
+        cachedBytes = _cachedBytes.fetch_sub(static_cast<int>(capacity)) - static_cast<int>(capacity);
+    }
+    else
+    {
+        cachedBytes = _cachedBytes.load();
+        p = reinterpret_cast<Byte*>(::malloc(capacity));
+    }
+
+    if(observer && p)
+    {
+        observer->allocated(cached, cachedBytes);
+    }
+    return p;
+}
+
+void
+IceInternal::BufferPool::release(Byte* p, size_t capacity)
+{
+    assert(p);
+    if(capacity <= (static_cast<size_t>(1) << MaxClassShift) && capacity == getCapacity(capacity))
+    {
+        size_t cachedBytes = static_cast<size_t>(_cachedBytes.fetch_add(static_cast<int>(capacity))) + capacity;
+        if(cachedBytes <= _maxBytes)
+        {
+            Shard& shard = getShard();
+            BufferPoolObserverIPtr observer;
+            {
+                IceUtil::Mutex::Lock sync(shard.mutex);
+                shard.buffers[getClass(capacity)].push_back(p);
+                observer = shard.observer;
+            }
+            if(observer)
+            {
+                observer->cached(static_cast<Int>(cachedBytes));
+            }
+            return;
+        }
+        _cachedBytes.fetch_sub(static_cast<int>(capacity));
+    }
+    ::free(p);
+}
+
+size_t
+IceInternal::BufferPool::getCapacity(size_t n)
+{
+    if(n > (static_cast<size_t>(1) << MaxClassShift))
+    {
+        return n;
+    }
+    return static_cast<size_t>(1) << (getClass(n) + MinClassShift);
+}
+
+void
+IceInternal::BufferPool::setObserver(const BufferPoolObserverIPtr& observer)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    _observer = observer;
+    for(int i = 0; i < ShardCount; ++i)
+    {
+        IceUtil::Mutex::Lock shardSync(_shards[i].mutex);
+        _shards[i].observer = observer;
+    }
+}
+
+BufferPoolObserverIPtr
+IceInternal::BufferPool::getObserver() const
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    return _observer;
+}
+
+size_t
+IceInternal::BufferPool::getClass(size_t capacity)
+{
+    size_t c = 0;
+    while((static_cast<size_t>(1) << (c + MinClassShift)) < capacity)
+    {
+        ++c;
+    }
+    return c;
+}
+
+IceInternal::BufferPool::Shard&
+IceInternal::BufferPool::getShard()
+{
+    //
+    // Pick the shard from the calling thread ID, a given thread always
+    // uses the same shard.
+    //
+    return _shards[IceUtilInternal::getThreadIdHash() % ShardCount];
+}
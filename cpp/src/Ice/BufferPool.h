@@ -0,0 +1,86 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_BUFFER_POOL_H
+#define ICE_BUFFER_POOL_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Atomic.h>
+#include <Ice/BufferPoolF.h>
+
+#include <vector>
+
+namespace IceInternal
+{
+
+class BufferPoolObserverI;
+ICE_DEFINE_PTR(BufferPoolObserverIPtr, BufferPoolObserverI);
+
+//
+// The buffer pool caches the memory of the stream buffers of a
+// communicator. Buffers are allocated with power of two size classes
+// and returned to the pool when released. The pool is split in
+// several shards, each protected by its own mutex, to reduce the
+// contention between threads.
+//
+class BufferPool : public IceUtil::Shared
+{
+public:
+
+    BufferPool(size_t);
+    virtual ~BufferPool();
+
+    //
+    // Allocate a buffer of at least the given capacity. The capacity
+    // is updated with the size class of the allocated buffer.
+    //
+    Ice::Byte* allocate(size_t&);
+    void release(Ice::Byte*, size_t);
+
+    //
+    // Returns the capacity of the buffer allocated by the pool for
+    // the given size.
+    //
+    static size_t getCapacity(size_t);
+
+    void setObserver(const BufferPoolObserverIPtr&);
+    BufferPoolObserverIPtr getObserver() const;
+
+private:
+
+    enum
+    {
+        MinClassShift = 8, // 256 bytes
+        MaxClassShift = 20, // 1MB
+        ClassCount = MaxClassShift - MinClassShift + 1,
+        ShardCount = 8
+    };
+
+    struct Shard
+    {
+        IceUtil::Mutex mutex;
+        std::vector<Ice::Byte*> buffers[ClassCount];
+        BufferPoolObserverIPtr observer;
+    };
+
+    static size_t getClass(size_t);
+    Shard& getShard();
+
+    const size_t _maxBytes;
+    IceUtilInternal::Atomic _cachedBytes;
+    Shard _shards[ShardCount];
+
+    IceUtil::Mutex _mutex;
+    BufferPoolObserverIPtr _observer;
+};
+
+}
+
+#endif
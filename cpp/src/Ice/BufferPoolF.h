@@ -0,0 +1,24 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_BUFFER_POOL_F_H
+#define ICE_BUFFER_POOL_F_H
+
+#include <Ice/Handle.h>
+
+namespace IceInternal
+{
+
+class BufferPool;
+IceUtil::Shared* upCast(BufferPool*);
+typedef Handle<BufferPool> BufferPoolPtr;
+
+}
+
+#endif
@@ -75,6 +75,13 @@ CollocatedRequestHandler::CollocatedRequestHandler(const ReferencePtr& ref, cons
     _dispatcher(_reference->getInstance()->initializationData().dispatcher),
     _logger(_reference->getInstance()->initializationData().logger), // Cached for better performance.
     _traceLevels(_reference->getInstance()->traceLevels()), // Cached for better performance.
+    //
+    // Requests are only dispatched from the invoking thread if there's no
+    // dispatcher and no invocation timeout. The protocol tracing and the
+    // observers also need the marshaled parameters.
+    //
+    _directDispatch(_response && !_dispatcher && _reference->getInvocationTimeout() <= 0 &&
+                    _traceLevels->protocol < 1 && !_reference->getInstance()->initializationData().observer),
     _requestId(0)
 {
 }
@@ -135,8 +142,11 @@ CollocatedRequestHandler::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAs
 }
 
 AsyncStatus
-CollocatedRequestHandler::invokeAsyncRequest(OutgoingAsyncBase* outAsync, int batchRequestNum, bool synchronous)
+CollocatedRequestHandler::invokeAsyncRequest(OutgoingAsyncBase* outAsync, int batchRequestNum, bool synchronous,
+                                             DirectParams* params)
 {
+    assert(!params || (synchronous && _directDispatch));
+
     //
     // Increase the direct count to prevent the thread pool from being destroyed before
     // invokeAll is called. This will also throw if the object adapter has been deactivated.
@@ -197,7 +207,7 @@ CollocatedRequestHandler::invokeAsyncRequest(OutgoingAsyncBase* outAsync, int ba
         CollocatedRequestHandlerPtr self(ICE_SHARED_FROM_THIS);
         if(sentAsync(outAsync))
         {
-            invokeAll(outAsync->getOs(), requestId, batchRequestNum);
+            invokeAll(outAsync->getOs(), requestId, batchRequestNum, params);
         }
     }
     return AsyncStatusQueued;
@@ -218,6 +228,7 @@ CollocatedRequestHandler::sendResponse(Int requestId, OutputStream* os, Byte, bo
 
         InputStream is(os->instance(), os->getEncoding(), *os, true); // Adopting the OutputStream's buffer.
         is.pos(sizeof(replyHdr) + 4);
+        is.setStreamedSource(os->getStreamedSource()); // The streamed sequence is read from its source.
 
         if(_traceLevels->protocol >= 1)
         {
@@ -309,7 +320,7 @@ CollocatedRequestHandler::sentAsync(OutgoingAsyncBase* outAsync)
 }
 
 void
-CollocatedRequestHandler::invokeAll(OutputStream* os, Int requestId, Int batchRequestNum)
+CollocatedRequestHandler::invokeAll(OutputStream* os, Int requestId, Int batchRequestNum, DirectParams* params)
 {
     if(_traceLevels->protocol >= 1)
     {
@@ -326,6 +337,7 @@ CollocatedRequestHandler::invokeAll(OutputStream* os, Int requestId, Int batchRe
     }
 
     InputStream is(os->instance(), os->getEncoding(), *os);
+    is.setStreamedSource(os->getStreamedSource()); // The streamed sequence is read from its source.
 
     if(batchRequestNum > 0)
     {
@@ -359,6 +371,10 @@ CollocatedRequestHandler::invokeAll(OutputStream* os, Int requestId, Int batchRe
             }
 
             Incoming in(_reference->getInstance().get(), this, 0, _adapter, _response, 0, requestId);
+            if(params)
+            {
+                in.setDirectParams(params);
+            }
             in.invoke(servantManager, &is);
             --invokeNum;
         }
@@ -33,6 +33,7 @@ namespace IceInternal
 
 class OutgoingAsyncBase;
 class OutgoingAsync;
+class DirectParams;
 
 class CollocatedRequestHandler : public RequestHandler,
                                  public ResponseHandler,
@@ -59,11 +60,20 @@ public:
     virtual Ice::ConnectionIPtr getConnection();
     virtual Ice::ConnectionIPtr waitForConnection();
 
-    AsyncStatus invokeAsyncRequest(OutgoingAsyncBase*, int, bool);
+    AsyncStatus invokeAsyncRequest(OutgoingAsyncBase*, int, bool, DirectParams* = 0);
 
     bool sentAsync(OutgoingAsyncBase*);
 
-    void invokeAll(Ice::OutputStream*, Ice::Int, Ice::Int);
+    void invokeAll(Ice::OutputStream*, Ice::Int, Ice::Int, DirectParams* = 0);
+
+    //
+    // Returns true if synchronous requests are dispatched from the
+    // invoking thread and can pass their parameters by reference.
+    //
+    bool canDispatchDirectly() const
+    {
+        return _directDispatch;
+    }
 
 #ifdef ICE_CPP11_MAPPING
     std::shared_ptr<CollocatedRequestHandler> shared_from_this()
@@ -80,6 +90,7 @@ private:
     const bool _dispatcher;
     const Ice::LoggerPtr _logger;
     const TraceLevelsPtr _traceLevels;
+    const bool _directDispatch;
 
     int _requestId;
     std::map<OutgoingAsyncBasePtr, Ice::Int> _sendAsyncRequests;
@@ -146,7 +146,7 @@ CommunicatorFlushBatchAsync::flushConnection(const ConnectionIPtr& con, Ice::Com
             {
                 compress = false;
             }
-            con->sendAsyncRequest(flushBatch, compress, false, batchRequestNum);
+            con->sendAsyncRequest(flushBatch, compress, false, batchRequestNum, 0);
         }
     }
     catch(const LocalException&)
@@ -0,0 +1,380 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Compressor.h>
+#include <Ice/LocalException.h>
+
+#ifdef ICE_HAS_BZIP2
+#  include <bzlib.h>
+#endif
+
+#ifdef ICE_USE_LZ4
+#  include <lz4.h>
+#endif
+
+#ifdef ICE_USE_ZSTD
+#  include <zstd.h>
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(Compressor* p) { return p; }
+
+IceInternal::Compressor::~Compressor()
+{
+    // Out of line to avoid weak vtable
+}
+
+namespace
+{
+
+#ifdef ICE_HAS_BZIP2
+string
+getBZ2Error(int bzError)
+{
+    if(bzError == BZ_RUN_OK)
+    {
+        return ": BZ_RUN_OK";
+    }
+    else if(bzError == BZ_FLUSH_OK)
+    {
+        return ": BZ_FLUSH_OK";
+    }
+    else if(bzError == BZ_FINISH_OK)
+    {
+        return ": BZ_FINISH_OK";
+    }
+    else if(bzError == BZ_STREAM_END)
+    {
+        return ": BZ_STREAM_END";
+    }
+    else if(bzError == BZ_CONFIG_ERROR)
+    {
+        return ": BZ_CONFIG_ERROR";
+    }
+    else if(bzError == BZ_SEQUENCE_ERROR)
+    {
+        return ": BZ_SEQUENCE_ERROR";
+    }
+    else if(bzError == BZ_PARAM_ERROR)
+    {
+        return ": BZ_PARAM_ERROR";
+    }
+    else if(bzError == BZ_MEM_ERROR)
+    {
+        return ": BZ_MEM_ERROR";
+    }
+    else if(bzError == BZ_DATA_ERROR)
+    {
+        return ": BZ_DATA_ERROR";
+    }
+    else if(bzError == BZ_DATA_ERROR_MAGIC)
+    {
+        return ": BZ_DATA_ERROR_MAGIC";
+    }
+    else if(bzError == BZ_IO_ERROR)
+    {
+        return ": BZ_IO_ERROR";
+    }
+    else if(bzError == BZ_UNEXPECTED_EOF)
+    {
+        return ": BZ_UNEXPECTED_EOF";
+    }
+    else if(bzError == BZ_OUTBUFF_FULL)
+    {
+        return ": BZ_OUTBUFF_FULL";
+    }
+    else
+    {
+        return "";
+    }
+}
+
+//
+// The bzip2 library doesn't support resetting a compression stream,
+// the one-shot buffer to buffer functions are used instead.
+//
+class BZip2Compressor : public Compressor
+{
+public:
+
+    BZip2Compressor(int level) : _level(level)
+    {
+    }
+
+    virtual CompressionCodec
+    codec() const
+    {
+        return CompressionCodecBZip2;
+    }
+
+    virtual size_t
+    compressBound(size_t size) const
+    {
+        return static_cast<size_t>(size * 1.01 + 600);
+    }
+
+    virtual size_t
+    compress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        unsigned int compressedLen = static_cast<unsigned int>(dstSize);
+        int bzError = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(dst), &compressedLen,
+                                               reinterpret_cast<char*>(const_cast<Byte*>(src)),
+                                               static_cast<unsigned int>(srcSize), _level, 0, 0);
+        if(bzError != BZ_OK)
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError);
+            throw ex;
+        }
+        return compressedLen;
+    }
+
+    virtual void
+    uncompress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        unsigned int uncompressedLen = static_cast<unsigned int>(dstSize);
+        int bzError = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(dst), &uncompressedLen,
+                                                 reinterpret_cast<char*>(const_cast<Byte*>(src)),
+                                                 static_cast<unsigned int>(srcSize), 0, 0);
+        if(bzError != BZ_OK)
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "BZ2_bzBuffToBuffDecompress failed" + getBZ2Error(bzError);
+            throw ex;
+        }
+    }
+
+private:
+
+    const int _level;
+};
+#endif
+
+#ifdef ICE_USE_LZ4
+//
+// The LZ4 compressor keeps the compression state of the connection,
+// the compression level isn't used, LZ4 always uses its fastest mode.
+//
+class LZ4Compressor : public Compressor
+{
+public:
+
+    LZ4Compressor() : _state(::malloc(LZ4_sizeofState()))
+    {
+        if(!_state)
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    ~LZ4Compressor()
+    {
+        ::free(_state);
+    }
+
+    virtual CompressionCodec
+    codec() const
+    {
+        return CompressionCodecLZ4;
+    }
+
+    virtual size_t
+    compressBound(size_t size) const
+    {
+        return static_cast<size_t>(LZ4_compressBound(static_cast<int>(size)));
+    }
+
+    virtual size_t
+    compress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        int sz = LZ4_compress_fast_extState(_state, reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                                            static_cast<int>(srcSize), static_cast<int>(dstSize), 1);
+        if(sz <= 0)
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "LZ4_compress_fast_extState failed";
+            throw ex;
+        }
+        return static_cast<size_t>(sz);
+    }
+
+    virtual void
+    uncompress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        int sz = LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                                     static_cast<int>(srcSize), static_cast<int>(dstSize));
+        if(sz != static_cast<int>(dstSize))
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "LZ4_decompress_safe failed";
+            throw ex;
+        }
+    }
+
+private:
+
+    void* _state;
+};
+#endif
+
+#ifdef ICE_USE_ZSTD
+//
+// The Zstandard compressor keeps a compression and decompression
+// context for the connection.
+//
+class ZstdCompressor : public Compressor
+{
+public:
+
+    ZstdCompressor(int level) : _level(level), _cctx(ZSTD_createCCtx()), _dctx(ZSTD_createDCtx())
+    {
+        if(!_cctx || !_dctx)
+        {
+            ZSTD_freeCCtx(_cctx);
+            ZSTD_freeDCtx(_dctx);
+            throw std::bad_alloc();
+        }
+    }
+
+    ~ZstdCompressor()
+    {
+        ZSTD_freeCCtx(_cctx);
+        ZSTD_freeDCtx(_dctx);
+    }
+
+    virtual CompressionCodec
+    codec() const
+    {
+        return CompressionCodecZstd;
+    }
+
+    virtual size_t
+    compressBound(size_t size) const
+    {
+        return ZSTD_compressBound(size);
+    }
+
+    virtual size_t
+    compress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        size_t sz = ZSTD_compressCCtx(_cctx, dst, dstSize, src, srcSize, _level);
+        if(ZSTD_isError(sz))
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = string("ZSTD_compressCCtx failed: ") + ZSTD_getErrorName(sz);
+            throw ex;
+        }
+        return sz;
+    }
+
+    virtual void
+    uncompress(const Byte* src, size_t srcSize, Byte* dst, size_t dstSize)
+    {
+        size_t sz = ZSTD_decompressDCtx(_dctx, dst, dstSize, src, srcSize);
+        if(ZSTD_isError(sz) || sz != dstSize)
+        {
+            CompressionException ex(__FILE__, __LINE__);
+            ex.reason = "ZSTD_decompressDCtx failed";
+            if(ZSTD_isError(sz))
+            {
+                ex.reason += string(": ") + ZSTD_getErrorName(sz);
+            }
+            throw ex;
+        }
+    }
+
+private:
+
+    const int _level;
+    ZSTD_CCtx* _cctx;
+    ZSTD_DCtx* _dctx;
+};
+#endif
+
+}
+
+CompressorPtr
+IceInternal::createCompressor(CompressionCodec codec, int level)
+{
+    switch(codec)
+    {
+#ifdef ICE_HAS_BZIP2
+        case CompressionCodecBZip2:
+        {
+            return new BZip2Compressor(level);
+        }
+#endif
+#ifdef ICE_USE_LZ4
+        case CompressionCodecLZ4:
+        {
+            return new LZ4Compressor();
+        }
+#endif
+#ifdef ICE_USE_ZSTD
+        case CompressionCodecZstd:
+        {
+            return new ZstdCompressor(level);
+        }
+#endif
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+bool
+IceInternal::stringToCompressionCodec(const string& str, CompressionCodec& codec)
+{
+    if(str == "bzip2")
+    {
+        codec = CompressionCodecBZip2;
+    }
+    else if(str == "lz4")
+    {
+        codec = CompressionCodecLZ4;
+    }
+    else if(str == "zstd")
+    {
+        codec = CompressionCodecZstd;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+string
+IceInternal::compressionCodecToString(CompressionCodec codec)
+{
+    switch(codec)
+    {
+        case CompressionCodecBZip2:
+        {
+            return "bzip2";
+        }
+        case CompressionCodecLZ4:
+        {
+            return "lz4";
+        }
+        case CompressionCodecZstd:
+        {
+            return "zstd";
+        }
+        default:
+        {
+            assert(false);
+            return "";
+        }
+    }
+}
@@ -0,0 +1,72 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_COMPRESSOR_H
+#define ICE_COMPRESSOR_H
+
+#include <IceUtil/Shared.h>
+#include <Ice/CompressorF.h>
+#include <Ice/Config.h>
+
+#if !defined(ICE_OS_UWP)
+#    ifndef ICE_HAS_BZIP2
+#        define ICE_HAS_BZIP2
+#    endif
+#endif
+
+namespace IceInternal
+{
+
+//
+// A compressor compresses and uncompresses the body of protocol
+// messages. A compressor is used by a single connection and can keep
+// a compression context which is reused for each message.
+//
+class Compressor : public IceUtil::Shared
+{
+public:
+
+    virtual ~Compressor();
+
+    virtual CompressionCodec codec() const = 0;
+
+    //
+    // Returns the maximum size of the compressed data for the given
+    // uncompressed size.
+    //
+    virtual size_t compressBound(size_t) const = 0;
+
+    //
+    // Compress the given data and return the size of the compressed
+    // data. Raises CompressionException on failure.
+    //
+    virtual size_t compress(const Ice::Byte*, size_t, Ice::Byte*, size_t) = 0;
+
+    //
+    // Uncompress the given data, the uncompressed data must fill the
+    // destination buffer. Raises CompressionException on failure.
+    //
+    virtual void uncompress(const Ice::Byte*, size_t, Ice::Byte*, size_t) = 0;
+};
+
+//
+// Create a compressor for the given codec and compression level,
+// returns null if the codec isn't supported by this build.
+//
+CompressorPtr createCompressor(CompressionCodec, int);
+
+//
+// Parse the name of a codec, returns false if the name is unknown.
+//
+bool stringToCompressionCodec(const std::string&, CompressionCodec&);
+std::string compressionCodecToString(CompressionCodec);
+
+}
+
+#endif
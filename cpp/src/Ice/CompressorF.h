@@ -0,0 +1,36 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_COMPRESSOR_F_H
+#define ICE_COMPRESSOR_F_H
+
+#include <Ice/Handle.h>
+
+namespace IceInternal
+{
+
+//
+// The compression codecs. The value of a codec other than bzip2 is
+// sent in the compression status of the validate connection message
+// to offer the codec to the peer.
+//
+enum CompressionCodec
+{
+    CompressionCodecBZip2 = 0,
+    CompressionCodecLZ4 = 1,
+    CompressionCodecZstd = 2
+};
+
+class Compressor;
+IceUtil::Shared* upCast(Compressor*);
+typedef Handle<Compressor> CompressorPtr;
+
+}
+
+#endif
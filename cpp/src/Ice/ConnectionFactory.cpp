@@ -127,6 +127,39 @@ find(const multimap<K,::IceInternal::Handle<V> >& m,
 }
 #endif
 
+//
+// Returns the connection with the least outstanding bytes if there
+// are already the given number of connection stripes for the key,
+// including the connections being established. Returns null if
+// another stripe needs to be established.
+//
+template<typename Map> typename Map::mapped_type
+findStripe(const Map& m, const typename Map::key_type& k, int stripes)
+{
+    typename Map::mapped_type connection;
+    size_t bytes = 0;
+    int count = 0;
+    pair<typename Map::const_iterator, typename Map::const_iterator> pr = m.equal_range(k);
+    for(typename Map::const_iterator q = pr.first; q != pr.second; ++q)
+    {
+        if(q->second->isActiveOrHolding())
+        {
+            size_t outstanding = q->second->getOutstandingBytes();
+            if(!connection || outstanding < bytes)
+            {
+                connection = q->second;
+                bytes = outstanding;
+            }
+            ++count;
+        }
+        else if(q->second->isInitializing())
+        {
+            ++count;
+        }
+    }
+    return count < stripes ? typename Map::mapped_type() : connection;
+}
+
 class StartAcceptor : public IceUtil::TimerTask
 {
 public:
@@ -227,6 +260,7 @@ void
 IceInternal::OutgoingConnectionFactory::create(const vector<EndpointIPtr>& endpts,
                                                bool hasMore,
                                                Ice::EndpointSelectionType selType,
+                                               int stripes,
                                                const CreateConnectionCallbackPtr& callback)
 {
     assert(!endpts.empty());
@@ -242,7 +276,7 @@ IceInternal::OutgoingConnectionFactory::create(const vector<EndpointIPtr>& endpt
     try
     {
         bool compress;
-        Ice::ConnectionIPtr connection = findConnection(endpoints, compress);
+        Ice::ConnectionIPtr connection = findConnection(endpoints, stripes, compress);
         if(connection)
         {
             callback->setConnection(connection, compress);
@@ -256,9 +290,9 @@ IceInternal::OutgoingConnectionFactory::create(const vector<EndpointIPtr>& endpt
     }
 
 #ifdef ICE_CPP11_MAPPING
-    auto cb = make_shared<ConnectCallback>(_instance, this, endpoints, hasMore, callback, selType);
+    auto cb = make_shared<ConnectCallback>(_instance, this, endpoints, hasMore, callback, selType, stripes);
 #else
-    ConnectCallbackPtr cb = new ConnectCallback(_instance, this, endpoints, hasMore, callback, selType);
+    ConnectCallbackPtr cb = new ConnectCallback(_instance, this, endpoints, hasMore, callback, selType, stripes);
 #endif
     cb->getConnectors();
 }
@@ -405,7 +439,8 @@ IceInternal::OutgoingConnectionFactory::applyOverrides(const vector<EndpointIPtr
 }
 
 ConnectionIPtr
-IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr>& endpoints, bool& compress)
+IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr>& endpoints, int stripes,
+                                                       bool& compress)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     if(_destroyed)
@@ -417,7 +452,15 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr
     assert(!endpoints.empty());
     for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
     {
-        ConnectionIPtr connection = find(_connectionsByEndpoint, *p, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
+        ConnectionIPtr connection;
+        if(stripes > 1)
+        {
+            connection = findStripe(_connectionsByEndpoint, *p, stripes);
+        }
+        else
+        {
+            connection = find(_connectionsByEndpoint, *p, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
+        }
         if(connection)
         {
             if(defaultsAndOverrides->overrideCompress)
@@ -435,19 +478,27 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr
 }
 
 ConnectionIPtr
-IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInfo>& connectors, bool& compress)
+IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInfo>& connectors, int stripes,
+                                                       bool& compress)
 {
     // This must be called with the mutex locked.
 
     DefaultsAndOverridesPtr defaultsAndOverrides = _instance->defaultsAndOverrides();
     for(vector<ConnectorInfo>::const_iterator p = connectors.begin(); p != connectors.end(); ++p)
     {
-        if(_pending.find(p->connector) != _pending.end())
+        ConnectionIPtr connection;
+        if(stripes > 1)
         {
-            continue;
+            //
+            // The existing stripes can be used while another stripe is
+            // being established.
+            //
+            connection = findStripe(_connections, p->connector, stripes);
+        }
+        else if(_pending.find(p->connector) == _pending.end())
+        {
+            connection = find(_connections, p->connector, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
         }
-
-        ConnectionIPtr connection = find(_connections, p->connector, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
         if(connection)
         {
             if(defaultsAndOverrides->overrideCompress)
@@ -498,6 +549,7 @@ IceInternal::OutgoingConnectionFactory::decPendingConnectCount()
 
 ConnectionIPtr
 IceInternal::OutgoingConnectionFactory::getConnection(const vector<ConnectorInfo>& connectors,
+                                                      int stripes,
                                                       const ConnectCallbackPtr& cb,
                                                       bool& compress)
 {
@@ -535,7 +587,7 @@ IceInternal::OutgoingConnectionFactory::getConnection(const vector<ConnectorInfo
             //
             // Search for a matching connection. If we find one, we're done.
             //
-            Ice::ConnectionIPtr connection = findConnection(connectors, compress);
+            Ice::ConnectionIPtr connection = findConnection(connectors, stripes, compress);
             if(connection)
             {
                 return connection;
@@ -866,13 +918,17 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::ConnectCallback(const I
                                                                          const vector<EndpointIPtr>& endpoints,
                                                                          bool hasMore,
                                                                          const CreateConnectionCallbackPtr& cb,
-                                                                         Ice::EndpointSelectionType selType) :
+                                                                         Ice::EndpointSelectionType selType,
+                                                                         int stripes) :
     _instance(instance),
     _factory(factory),
     _endpoints(endpoints),
     _hasMore(hasMore),
     _callback(cb),
-    _selType(selType)
+    _selType(selType),
+    _stripes(stripes),
+    _parallel(instance->parallelConnect()),
+    _finished(false)
 {
     _endpointsIter = _endpoints.begin();
 }
@@ -883,6 +939,12 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::ConnectCallback(const I
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartCompleted(const ConnectionIPtr& connection)
 {
+    if(_parallel)
+    {
+        parallelConnectionStartCompleted(connection);
+        return;
+    }
+
     if(_observer)
     {
         _observer->detach();
@@ -893,9 +955,15 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartComplete
 }
 
 void
-IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailed(const ConnectionIPtr& /*connection*/,
+IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailed(const ConnectionIPtr& connection,
                                                                                const LocalException& ex)
 {
+    if(_parallel)
+    {
+        parallelConnectionStartFailed(connection, ex);
+        return;
+    }
+
     assert(_iter != _connectors.end());
     if(connectionStartFailedImpl(ex))
     {
@@ -1001,7 +1069,7 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::getConnection()
         // connection.
         //
         bool compress;
-        Ice::ConnectionIPtr connection = _factory->getConnection(_connectors, ICE_SHARED_FROM_THIS, compress);
+        Ice::ConnectionIPtr connection = _factory->getConnection(_connectors, _stripes, ICE_SHARED_FROM_THIS, compress);
         if(!connection)
         {
             //
@@ -1026,6 +1094,12 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::getConnection()
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::nextConnector()
 {
+    if(_parallel)
+    {
+        nextParallelConnector();
+        return;
+    }
+
     while(true)
     {
         try
@@ -1069,6 +1143,94 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::nextConnector()
     }
 }
 
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::nextParallelConnector()
+{
+    while(true)
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_finished || _iter == _connectors.end())
+        {
+            return;
+        }
+
+        Attempt attempt;
+        attempt.connector = _iter++;
+
+        //
+        // Try the next connector if this connector doesn't establish its
+        // connection within the delay.
+        //
+        try
+        {
+            IceUtil::TimerPtr timer = _instance->timer();
+            if(_timerTask)
+            {
+                timer->cancel(_timerTask);
+                _timerTask = ICE_NULLPTR;
+            }
+            if(_iter != _connectors.end())
+            {
+                _timerTask = ICE_MAKE_SHARED(ParallelConnectTimerTask, ICE_SHARED_FROM_THIS);
+                timer->schedule(_timerTask, IceUtil::Time::milliSeconds(_instance->parallelConnectDelay()));
+            }
+        }
+        catch(const IceUtil::Exception&)
+        {
+            // The communicator is being destroyed, connecting will fail.
+        }
+
+        const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
+        if(obsv)
+        {
+            attempt.observer = obsv->getConnectionEstablishmentObserver(attempt.connector->endpoint,
+                                                                        attempt.connector->connector->toString());
+            if(attempt.observer)
+            {
+                attempt.observer->attach();
+            }
+        }
+
+        //
+        // The connection is created with the mutex locked: once the callback
+        // is finished, no more connections are created and the connections
+        // of the pending attempts are closed.
+        //
+        try
+        {
+            if(_instance->traceLevels()->network >= 2)
+            {
+                Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+                out << "trying to establish " << attempt.connector->endpoint->protocol() << " connection to "
+                    << attempt.connector->connector->toString();
+            }
+            attempt.connection = _factory->createConnection(attempt.connector->connector->connect(),
+                                                            *attempt.connector);
+            _attempts.push_back(attempt);
+        }
+        catch(const Ice::LocalException& ex)
+        {
+            if(_instance->traceLevels()->network >= 2)
+            {
+                Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+                out << "failed to establish " << attempt.connector->endpoint->protocol() << " connection to "
+                    << attempt.connector->connector->toString() << "\n" << ex;
+            }
+
+            sync.release();
+            if(parallelConnectionFailed(attempt, ex))
+            {
+                continue; // Try the next connector now.
+            }
+            return;
+        }
+
+        sync.release();
+        attempt.connection->start(ICE_SHARED_FROM_THIS);
+        return;
+    }
+}
+
 void
 IceInternal::OutgoingConnectionFactory::ConnectCallback::setConnection(const Ice::ConnectionIPtr& connection,
                                                                        bool compress)
@@ -1149,32 +1311,203 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::connectionStartFailedIm
     return false;
 }
 
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::parallelConnectionStartCompleted(
+    const ConnectionIPtr& connection)
+{
+    Attempt attempt;
+    vector<Attempt> attempts;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_finished)
+        {
+            return; // Another connection was established, this connection is being closed.
+        }
+
+        for(vector<Attempt>::iterator p = _attempts.begin(); p != _attempts.end(); ++p)
+        {
+            if(p->connection == connection)
+            {
+                attempt = *p;
+                _attempts.erase(p);
+                break;
+            }
+        }
+        assert(attempt.connection);
+
+        setFinished();
+        attempts.swap(_attempts);
+    }
+
+    if(attempt.observer)
+    {
+        attempt.observer->detach();
+    }
+    closeAttempts(attempts);
+
+    connection->activate();
+    _factory->finishGetConnection(_connectors, *attempt.connector, connection, ICE_SHARED_FROM_THIS);
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::parallelConnectionStartFailed(
+    const ConnectionIPtr& connection, const LocalException& ex)
+{
+    Attempt attempt;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        for(vector<Attempt>::iterator p = _attempts.begin(); p != _attempts.end(); ++p)
+        {
+            if(p->connection == connection)
+            {
+                attempt = *p;
+                _attempts.erase(p);
+                break;
+            }
+        }
+
+        if(!attempt.connection)
+        {
+            return; // The connection was closed because another connection was established.
+        }
+    }
+
+    if(parallelConnectionFailed(attempt, ex))
+    {
+        nextParallelConnector();
+    }
+}
+
+bool
+IceInternal::OutgoingConnectionFactory::ConnectCallback::parallelConnectionFailed(const Attempt& attempt,
+                                                                                  const Ice::LocalException& ex)
+{
+    if(attempt.observer)
+    {
+        attempt.observer->failed(ex.ice_id());
+        attempt.observer->detach();
+    }
+
+    bool hasMore;
+    bool finished = false;
+    vector<Attempt> attempts;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_finished)
+        {
+            return false;
+        }
+
+        hasMore = _iter != _connectors.end() || !_attempts.empty();
+        if(!hasMore || dynamic_cast<const Ice::CommunicatorDestroyedException*>(&ex)) // No need to continue.
+        {
+            setFinished();
+            finished = true;
+            attempts.swap(_attempts);
+        }
+    }
+
+    _factory->handleConnectionException(ex, _hasMore || hasMore);
+    if(!finished)
+    {
+        return true; // Try the next connector, if any, or wait for the pending attempts.
+    }
+
+    closeAttempts(attempts);
+    _factory->finishGetConnection(_connectors, ex, ICE_SHARED_FROM_THIS);
+    return false;
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::closeAttempts(const vector<Attempt>& attempts)
+{
+    for(vector<Attempt>::const_iterator p = attempts.begin(); p != attempts.end(); ++p)
+    {
+        if(p->observer)
+        {
+            p->observer->detach();
+        }
+        p->connection->close(ICE_SCOPED_ENUM(ConnectionClose, Forcefully));
+    }
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ConnectCallback::setFinished()
+{
+    //
+    // Must be called with the mutex locked. The timer task holds a
+    // reference on the callback, it's canceled so that the callback
+    // isn't kept alive until the delay expires.
+    //
+    _finished = true;
+    if(_timerTask)
+    {
+        try
+        {
+            _instance->timer()->cancel(_timerTask);
+        }
+        catch(const IceUtil::Exception&)
+        {
+            // The communicator is being destroyed, the timer is destroyed as well.
+        }
+        _timerTask = ICE_NULLPTR;
+    }
+}
+
+IceInternal::OutgoingConnectionFactory::ParallelConnectTimerTask::ParallelConnectTimerTask(
+    const ConnectCallbackPtr& callback) :
+    _callback(callback)
+{
+}
+
+void
+IceInternal::OutgoingConnectionFactory::ParallelConnectTimerTask::runTimerTask()
+{
+    _callback->nextParallelConnector();
+}
+
 void
 IceInternal::IncomingConnectionFactory::activate()
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    setState(StateActive);
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        setState(StateActive);
+    }
+    for_each(_reusePortFactories.begin(), _reusePortFactories.end(),
+             Ice::voidMemFun(&IncomingConnectionFactory::activate));
 }
 
 void
 IceInternal::IncomingConnectionFactory::hold()
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    setState(StateHolding);
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        setState(StateHolding);
+    }
+    for_each(_reusePortFactories.begin(), _reusePortFactories.end(),
+             Ice::voidMemFun(&IncomingConnectionFactory::hold));
 }
 
 void
 IceInternal::IncomingConnectionFactory::destroy()
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    setState(StateClosed);
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        setState(StateClosed);
+    }
+    for_each(_reusePortFactories.begin(), _reusePortFactories.end(),
+             Ice::voidMemFun(&IncomingConnectionFactory::destroy));
 }
 
 void
 IceInternal::IncomingConnectionFactory::updateConnectionObservers()
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    for_each(_connections.begin(), _connections.end(), Ice::voidMemFun(&ConnectionI::updateObserver));
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        for_each(_connections.begin(), _connections.end(), Ice::voidMemFun(&ConnectionI::updateObserver));
+    }
+    for_each(_reusePortFactories.begin(), _reusePortFactories.end(),
+             Ice::voidMemFun(&IncomingConnectionFactory::updateConnectionObservers));
 }
 
 void
@@ -1205,6 +1538,9 @@ IceInternal::IncomingConnectionFactory::waitUntilHolding() const
     // Now we wait until each connection is in holding state.
     //
     for_each(connections.begin(), connections.end(), Ice::constVoidMemFun(&ConnectionI::waitUntilHolding));
+
+    for_each(_reusePortFactories.begin(), _reusePortFactories.end(),
+             Ice::constVoidMemFun(&IncomingConnectionFactory::waitUntilHolding));
 }
 
 void
@@ -1227,6 +1563,7 @@ IceInternal::IncomingConnectionFactory::waitUntilFinished()
         // Clear the OA. See bug 1673 for the details of why this is necessary.
         //
         _adapter = 0;
+        _threadPool = 0;
 
         // We want to wait until all connections are finished outside the
         // thread synchronization.
@@ -1253,6 +1590,9 @@ IceInternal::IncomingConnectionFactory::waitUntilFinished()
         _connections.clear();
         _monitor->destroy();
     }
+
+    for_each(_reusePortFactories.begin(), _reusePortFactories.end(),
+             Ice::voidMemFun(&IncomingConnectionFactory::waitUntilFinished));
 }
 
 EndpointIPtr
@@ -1265,16 +1605,24 @@ IceInternal::IncomingConnectionFactory::endpoint() const
 list<ConnectionIPtr>
 IceInternal::IncomingConnectionFactory::connections() const
 {
-    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-
     list<ConnectionIPtr> result;
 
-    //
-    // Only copy connections which have not been destroyed.
-    //
-    remove_copy_if(_connections.begin(), _connections.end(), back_inserter(result),
-                   not1(Ice::constMemFun(&ConnectionI::isActiveOrHolding)));
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+
+        //
+        // Only copy connections which have not been destroyed.
+        //
+        remove_copy_if(_connections.begin(), _connections.end(), back_inserter(result),
+                       not1(Ice::constMemFun(&ConnectionI::isActiveOrHolding)));
+    }
 
+    for(vector<IncomingConnectionFactoryPtr>::const_iterator p = _reusePortFactories.begin();
+        p != _reusePortFactories.end(); ++p)
+    {
+        list<ConnectionIPtr> connections = (*p)->connections();
+        result.splice(result.end(), connections);
+    }
     return result;
 }
 
@@ -1337,7 +1685,7 @@ IceInternal::IncomingConnectionFactory::finishAsync(SocketOperation)
 
         Error out(_instance->initializationData().logger);
         out << "couldn't accept connection:\n" << ex << '\n' << _acceptor->toString();
-        if(_adapter->getThreadPool()->finish(ICE_SHARED_FROM_THIS, true))
+        if(_threadPool->finish(ICE_SHARED_FROM_THIS, true))
         {
             closeAcceptor();
         }
@@ -1408,7 +1756,7 @@ IceInternal::IncomingConnectionFactory::message(ThreadPoolCurrent& current)
                 Error out(_instance->initializationData().logger);
                 out << "can't accept more connections:\n" << ex << '\n' << _acceptor->toString();
 
-                if(_adapter->getThreadPool()->finish(ICE_SHARED_FROM_THIS, true))
+                if(_threadPool->finish(ICE_SHARED_FROM_THIS, true))
                 {
                     closeAcceptor();
                 }
@@ -1576,6 +1924,9 @@ IceInternal::IncomingConnectionFactory::IncomingConnectionFactory(const Instance
 void
 IceInternal::IncomingConnectionFactory::startAcceptor()
 {
+    for_each(_reusePortFactories.begin(), _reusePortFactories.end(),
+             Ice::voidMemFun(&IncomingConnectionFactory::startAcceptor));
+
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     if(_state >= StateClosed || _acceptorStarted)
     {
@@ -1599,6 +1950,9 @@ IceInternal::IncomingConnectionFactory::startAcceptor()
 void
 IceInternal::IncomingConnectionFactory::stopAcceptor()
 {
+    for_each(_reusePortFactories.begin(), _reusePortFactories.end(),
+             Ice::voidMemFun(&IncomingConnectionFactory::stopAcceptor));
+
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     if(_state >= StateClosed || !_acceptorStarted)
     {
@@ -1607,7 +1961,7 @@ IceInternal::IncomingConnectionFactory::stopAcceptor()
 
     _acceptorStopped = true;
 
-    if(_adapter->getThreadPool()->finish(ICE_SHARED_FROM_THIS, true))
+    if(_threadPool->finish(ICE_SHARED_FROM_THIS, true))
     {
         closeAcceptor();
     }
@@ -1675,6 +2029,17 @@ IceInternal::IncomingConnectionFactory::initialize()
     }
 }
 
+void
+IceInternal::IncomingConnectionFactory::addReusePortFactory(const IncomingConnectionFactoryPtr& factory)
+{
+    //
+    // Called by the object adapter for each additional acceptor listening
+    // on this factory endpoint with SO_REUSEPORT, the factory forwards
+    // state changes to these acceptors.
+    //
+    _reusePortFactories.push_back(factory);
+}
+
 IceInternal::IncomingConnectionFactory::~IncomingConnectionFactory()
 {
     assert(_state == StateFinished);
@@ -1704,7 +2069,7 @@ IceInternal::IncomingConnectionFactory::setState(State state)
                     Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
                     out << "accepting " << _endpoint->protocol() << " connections at " << _acceptor->toString();
                 }
-                _adapter->getThreadPool()->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
+                _threadPool->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
             }
             for_each(_connections.begin(), _connections.end(), Ice::voidMemFun(&ConnectionI::activate));
             break;
@@ -1723,7 +2088,7 @@ IceInternal::IncomingConnectionFactory::setState(State state)
                     Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
                     out << "holding " << _endpoint->protocol() << " connections at " << _acceptor->toString();
                 }
-                _adapter->getThreadPool()->unregister(ICE_SHARED_FROM_THIS, SocketOperationRead);
+                _threadPool->unregister(ICE_SHARED_FROM_THIS, SocketOperationRead);
             }
             for_each(_connections.begin(), _connections.end(), Ice::voidMemFun(&ConnectionI::hold));
             break;
@@ -1740,7 +2105,7 @@ IceInternal::IncomingConnectionFactory::setState(State state)
                 // the finish() call. Not all selector implementations do support this
                 // however.
                 //
-                if(_adapter->getThreadPool()->finish(ICE_SHARED_FROM_THIS, true))
+                if(_threadPool->finish(ICE_SHARED_FROM_THIS, true))
                 {
                     closeAcceptor();
                 }
@@ -1772,6 +2137,14 @@ IceInternal::IncomingConnectionFactory::createAcceptor()
     try
     {
         assert(!_acceptorStarted);
+
+        //
+        // If the adapter thread pool is sharded, each acceptor is assigned
+        // to a shard, this spreads the accept calls of acceptors listening
+        // with SO_REUSEPORT over the shards.
+        //
+        _threadPool = _adapter->getThreadPool()->getShard();
+
         _acceptor = _endpoint->acceptor(_adapter->getName());
         assert(_acceptor);
         if(_instance->traceLevels()->network >= 2)
@@ -1787,10 +2160,10 @@ IceInternal::IncomingConnectionFactory::createAcceptor()
             out << "listening for " << _endpoint->protocol() << " connections\n" << _acceptor->toDetailedString();
         }
 
-        _adapter->getThreadPool()->initialize(ICE_SHARED_FROM_THIS);
+        _threadPool->initialize(ICE_SHARED_FROM_THIS);
         if(_state == StateActive)
         {
-            _adapter->getThreadPool()->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
+            _threadPool->_register(ICE_SHARED_FROM_THIS, SocketOperationRead);
         }
 
         _acceptorStarted = true;
@@ -12,6 +12,7 @@
 
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
+#include <IceUtil/Timer.h>
 #include <Ice/CommunicatorF.h>
 #include <Ice/ConnectionFactoryF.h>
 #include <Ice/ConnectionI.h>
@@ -27,6 +28,7 @@
 #include <Ice/EndpointI.h>
 #include <Ice/InstrumentationF.h>
 #include <Ice/ACMF.h>
+#include <Ice/ThreadPoolF.h>
 #include <Ice/Comparable.h>
 
 #include <list>
@@ -63,7 +65,8 @@ public:
 
     void waitUntilFinished();
 
-    void create(const std::vector<EndpointIPtr>&, bool, Ice::EndpointSelectionType, const CreateConnectionCallbackPtr&);
+    void create(const std::vector<EndpointIPtr>&, bool, Ice::EndpointSelectionType, int,
+                const CreateConnectionCallbackPtr&);
     void setRouterInfo(const RouterInfoPtr&);
     void removeAdapter(const Ice::ObjectAdapterPtr&);
     void flushAsyncBatchRequests(const CommunicatorFlushBatchAsyncPtr&, Ice::CompressBatch);
@@ -96,7 +99,7 @@ private:
     public:
 
         ConnectCallback(const InstancePtr&, const OutgoingConnectionFactoryPtr&, const std::vector<EndpointIPtr>&, bool,
-                        const CreateConnectionCallbackPtr&, Ice::EndpointSelectionType);
+                        const CreateConnectionCallbackPtr&, Ice::EndpointSelectionType, int);
 
         virtual void connectionStartCompleted(const Ice::ConnectionIPtr&);
         virtual void connectionStartFailed(const Ice::ConnectionIPtr&, const Ice::LocalException&);
@@ -109,6 +112,7 @@ private:
 
         void getConnection();
         void nextConnector();
+        void nextParallelConnector();
 
         void setConnection(const Ice::ConnectionIPtr&, bool);
         void setException(const Ice::LocalException&);
@@ -123,25 +127,67 @@ private:
 
         bool connectionStartFailedImpl(const Ice::LocalException&);
 
+        struct Attempt;
+
+        void parallelConnectionStartCompleted(const Ice::ConnectionIPtr&);
+        void parallelConnectionStartFailed(const Ice::ConnectionIPtr&, const Ice::LocalException&);
+        bool parallelConnectionFailed(const Attempt&, const Ice::LocalException&);
+        void closeAttempts(const std::vector<Attempt>&);
+        void setFinished();
+
         const InstancePtr _instance;
         const OutgoingConnectionFactoryPtr _factory;
         const std::vector<EndpointIPtr> _endpoints;
         const bool _hasMore;
         const CreateConnectionCallbackPtr _callback;
         const Ice::EndpointSelectionType _selType;
+        const int _stripes;
         Ice::Instrumentation::ObserverPtr _observer;
         std::vector<EndpointIPtr>::const_iterator _endpointsIter;
         std::vector<ConnectorInfo> _connectors;
         std::vector<ConnectorInfo>::const_iterator _iter;
+
+        //
+        // With Ice.ParallelConnect, the next connector is tried when the
+        // previous one fails or doesn't establish its connection within
+        // Ice.ParallelConnect.Delay. The first connection to complete its
+        // validation is used and the others are closed. _iter is the next
+        // connector to try.
+        //
+        struct Attempt
+        {
+            Ice::ConnectionIPtr connection;
+            std::vector<ConnectorInfo>::const_iterator connector;
+            Ice::Instrumentation::ObserverPtr observer;
+        };
+
+        const bool _parallel;
+        IceUtil::Mutex _mutex;
+        std::vector<Attempt> _attempts;
+        IceUtil::TimerTaskPtr _timerTask;
+        bool _finished;
     };
     ICE_DEFINE_PTR(ConnectCallbackPtr, ConnectCallback);
     friend class ConnectCallback;
 
+    class ParallelConnectTimerTask : public IceUtil::TimerTask
+    {
+    public:
+
+        ParallelConnectTimerTask(const ConnectCallbackPtr&);
+
+        virtual void runTimerTask();
+
+    private:
+
+        const ConnectCallbackPtr _callback;
+    };
+
     std::vector<EndpointIPtr> applyOverrides(const std::vector<EndpointIPtr>&);
-    Ice::ConnectionIPtr findConnection(const std::vector<EndpointIPtr>&, bool&);
+    Ice::ConnectionIPtr findConnection(const std::vector<EndpointIPtr>&, int, bool&);
     void incPendingConnectCount();
     void decPendingConnectCount();
-    Ice::ConnectionIPtr getConnection(const std::vector<ConnectorInfo>&, const ConnectCallbackPtr&, bool&);
+    Ice::ConnectionIPtr getConnection(const std::vector<ConnectorInfo>&, int, const ConnectCallbackPtr&, bool&);
     void finishGetConnection(const std::vector<ConnectorInfo>&, const ConnectorInfo&, const Ice::ConnectionIPtr&,
                              const ConnectCallbackPtr&);
     void finishGetConnection(const std::vector<ConnectorInfo>&, const Ice::LocalException&, const ConnectCallbackPtr&);
@@ -149,7 +195,7 @@ private:
     bool addToPending(const ConnectCallbackPtr&, const std::vector<ConnectorInfo>&);
     void removeFromPending(const ConnectCallbackPtr&, const std::vector<ConnectorInfo>&);
 
-    Ice::ConnectionIPtr findConnection(const std::vector<ConnectorInfo>&, bool&);
+    Ice::ConnectionIPtr findConnection(const std::vector<ConnectorInfo>&, int, bool&);
     Ice::ConnectionIPtr createConnection(const TransceiverPtr&, const ConnectorInfo&);
 
     void handleException(const Ice::LocalException&, bool);
@@ -212,6 +258,7 @@ public:
 
     IncomingConnectionFactory(const InstancePtr&, const EndpointIPtr&, const Ice::ObjectAdapterIPtr&);
     void initialize();
+    void addReusePortFactory(const IncomingConnectionFactoryPtr&);
     virtual ~IncomingConnectionFactory();
 
 #ifdef ICE_CPP11_MAPPING
@@ -249,10 +296,17 @@ private:
     bool _acceptorStopped;
 
     Ice::ObjectAdapterIPtr _adapter;
+    ThreadPoolPtr _threadPool;
     const bool _warn;
     std::set<Ice::ConnectionIPtr> _connections;
     State _state;
 
+    //
+    // The factories of the other acceptors listening on the same endpoint
+    // with SO_REUSEPORT. Immutable once the object adapter is created.
+    //
+    std::vector<IncomingConnectionFactoryPtr> _reusePortFactories;
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
     IceInternal::UniquePtr<Ice::LocalException> _acceptorException;
 #endif
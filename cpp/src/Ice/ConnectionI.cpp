@@ -27,10 +27,9 @@
 #include <Ice/ReferenceFactory.h> // For createProxy().
 #include <Ice/ProxyFactory.h> // For createProxy().
 #include <Ice/BatchRequestQueue.h>
-
-#ifdef ICE_HAS_BZIP2
-#  include <bzlib.h>
-#endif
+#include <Ice/StreamReader.h>
+#include <Ice/StreamThreadPool.h>
+#include <Ice/InstrumentationI.h>
 
 using namespace std;
 using namespace Ice;
@@ -133,6 +132,57 @@ private:
     const bool _close;
 };
 
+//
+// Runs the dispatch of a message with a streamed sequence or pumps the
+// source of a streamed sequence on the stream thread pool. Reading a
+// received stream blocks until its chunks are received by the thread pool
+// and the source provided by the application might block as well, this
+// doesn't tie up the thread pool threads. Returns false if the stream
+// thread pool is full or destroyed.
+//
+bool
+startStreamCall(const InstancePtr& instance, const DispatchWorkItemPtr& call)
+{
+    try
+    {
+        return instance->streamThreadPool()->execute(call);
+    }
+    catch(const CommunicatorDestroyedException&)
+    {
+        return false;
+    }
+}
+
+class StreamCall : public DispatchWorkItem
+{
+public:
+
+    StreamCall(const Ice::ConnectionIPtr& connection, Int requestId, bool reply, bool abort) :
+        DispatchWorkItem(connection), _connection(connection), _requestId(requestId), _reply(reply), _abort(abort)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        if(_abort)
+        {
+            _connection->abortStream(_requestId, _reply);
+        }
+        else
+        {
+            _connection->pumpStream(_requestId, _reply);
+        }
+    }
+
+private:
+
+    const ConnectionIPtr _connection;
+    const Int _requestId;
+    const bool _reply;
+    const bool _abort;
+};
+
 //
 // Class for handling Ice::Connection::begin_flushBatchRequests
 //
@@ -203,7 +253,7 @@ ConnectionFlushBatchAsync::invoke(const string& operation, Ice::CompressBatch co
             {
                 compress = false;
             }
-            status = _connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, compress, false, batchRequestNum);
+            status = _connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, compress, false, batchRequestNum, 0);
         }
 
         if(status & AsyncStatusSent)
@@ -231,7 +281,7 @@ ConnectionFlushBatchAsync::invoke(const string& operation, Ice::CompressBatch co
     }
 }
 
-Ice::ConnectionI::Observer::Observer() : _readStreamPos(0), _writeStreamPos(0)
+Ice::ConnectionI::Observer::Observer() : _readStreamPos(0), _writeStreamPos(0), _metricsObserver(0), _queuedBytes(0)
 {
 }
 
@@ -286,6 +336,20 @@ Ice::ConnectionI::Observer::finishWrite(const Buffer& buf)
 void
 Ice::ConnectionI::Observer::attach(const Ice::Instrumentation::ConnectionObserverPtr& observer)
 {
+    ConnectionObserverI* metricsObserver = dynamic_cast<ConnectionObserverI*>(observer.get());
+    if(metricsObserver != _metricsObserver && _queuedBytes > 0)
+    {
+        if(_metricsObserver)
+        {
+            _metricsObserver->queuedBytes(-_queuedBytes);
+        }
+        if(metricsObserver)
+        {
+            metricsObserver->queuedBytes(_queuedBytes);
+        }
+    }
+    _metricsObserver = metricsObserver;
+
     ObserverHelperT<Ice::Instrumentation::ConnectionObserver>::attach(observer);
     if(!observer)
     {
@@ -294,6 +358,27 @@ Ice::ConnectionI::Observer::attach(const Ice::Instrumentation::ConnectionObserve
     }
 }
 
+void
+Ice::ConnectionI::Observer::detach()
+{
+    if(_metricsObserver && _queuedBytes > 0)
+    {
+        _metricsObserver->queuedBytes(-_queuedBytes);
+    }
+    _metricsObserver = 0;
+    ObserverHelperT<Ice::Instrumentation::ConnectionObserver>::detach();
+}
+
+void
+Ice::ConnectionI::Observer::queuedBytes(Int num)
+{
+    _queuedBytes += num;
+    if(_metricsObserver)
+    {
+        _metricsObserver->queuedBytes(num);
+    }
+}
+
 
 void
 Ice::ConnectionI::OutgoingMessage::adopt(OutputStream* str)
@@ -535,6 +620,14 @@ Ice::ConnectionI::isActiveOrHolding() const
     return _state > StateNotValidated && _state < StateClosing;
 }
 
+bool
+Ice::ConnectionI::isInitializing() const
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+
+    return _state < StateActive;
+}
+
 bool
 Ice::ConnectionI::isFinished() const
 {
@@ -559,6 +652,18 @@ Ice::ConnectionI::isFinished() const
     return true;
 }
 
+size_t
+Ice::ConnectionI::getOutstandingBytes() const
+{
+    //
+    // The size of the requests waiting for a reply and of the other
+    // messages waiting to be sent. The counters are read without the
+    // connection lock, the connection factory calls this with its own
+    // lock held.
+    //
+    return _asyncRequests.bytes() + static_cast<size_t>(_outstandingMessageBytes.load());
+}
+
 void
 Ice::ConnectionI::throwException() const
 {
@@ -679,7 +784,8 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
             setState(StateClosed, ConnectionTimeoutException(__FILE__, __LINE__));
         }
         else if(acm.close != ICE_ENUM(ACMClose, CloseOnInvocation) &&
-                _dispatchCount == 0 && _batchRequestQueue->isEmpty() && _asyncRequests.empty())
+                _dispatchCount == 0 && _batchRequestQueue->isEmpty() && _asyncRequests.empty() &&
+                _inStreams.empty() && _outStreams.empty())
         {
             //
             // The connection is idle, close it.
@@ -690,10 +796,22 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
 }
 
 AsyncStatus
-Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compress, bool response, int batchRequestNum)
+Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compress, bool response, int batchRequestNum,
+                                   int priority)
 {
     OutputStream* os = out->getOs();
 
+    //
+    // The streamed sequence of a request is marshaled in the request if
+    // the peer doesn't support streams. This reads the source so it's
+    // done without the mutex locked, _peerStreams doesn't change once
+    // the connection is validated.
+    //
+    if(os->getStreamedSource() && (!response || !_peerStreams))
+    {
+        os->inlineStreamedSource();
+    }
+
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     //
     // If the exception is closed before we even have a chance
@@ -722,14 +840,10 @@ Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compres
     if(response)
     {
         //
-        // Create a new unique request ID.
+        // Add to the async requests table, this allocates a new unique
+        // request ID.
         //
-        requestId = _nextRequestId++;
-        if(requestId <= 0)
-        {
-            _nextRequestId = 1;
-            requestId = _nextRequestId++;
-        }
+        requestId = _asyncRequests.add(out, os->b.size());
 
         //
         // Fill in the request ID.
@@ -751,30 +865,108 @@ Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compres
 #endif
     }
 
+    //
+    // Tell the peer that the streamed sequence follows the request. The
+    // flag might be set by a previous attempt whose sequence was inlined.
+    //
+    if(os->getStreamedSource())
+    {
+        os->b[9] = static_cast<Byte>(os->b[9] | streamFlag);
+    }
+    else if(os->b[9] & streamFlag)
+    {
+        os->b[9] = static_cast<Byte>(os->b[9] & ~streamFlag);
+    }
+
     out->attachRemoteObserver(initConnectionInfo(), _endpoint, requestId);
 
     AsyncStatus status = AsyncStatusQueued;
     try
     {
         OutgoingMessage message(out, os, compress, requestId);
+        message.priority = priority;
         status = sendMessage(message);
     }
     catch(const LocalException& ex)
     {
+        //
+        // The exception is raised to the caller, the request must not be
+        // notified when the requests are cleared.
+        //
+        _asyncRequests.remove(requestId);
         setState(StateClosed, ex);
         assert(_exception);
         _exception->ice_throw();
     }
 
-    if(response)
+    if(response && os->getStreamedSource())
+    {
+        addOutStream(requestId, false, os->getStreamedSource(), priority);
+    }
+    return status;
+}
+
+void
+Ice::ConnectionI::checkSendQueue(int timeout, bool block)
+{
+    //
+    // This is called before sending a new request, a synchronous request
+    // is sent once the send queue is below its limit. Asynchronous
+    // requests and the requests sent with the Throw policy raise
+    // SendQueueFullException instead of waiting.
+    //
+    if(_sendQueueMax == 0)
+    {
+        return;
+    }
+
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    if(_sendQueueSize < _sendQueueMax || _state >= StateClosing)
+    {
+        return;
+    }
+
+    if(_sendQueueThrow || !block)
+    {
+        throw SendQueueFullException(__FILE__, __LINE__);
+    }
+    else if(ThreadPool::isThreadPoolThread())
     {
         //
-        // Add to the async requests map.
+        // Don't block thread pool threads (dispatch threads or AMI
+        // callbacks), they might be needed to drain the queue.
         //
-        _asyncRequestsHint = _asyncRequests.insert(_asyncRequests.end(),
-                                                   pair<const Int, OutgoingAsyncBasePtr>(requestId, out));
+        return;
     }
-    return status;
+
+    //
+    // Wait at most for the invocation timeout. If the connection is
+    // closed while waiting, sending the request raises the exception.
+    //
+    IceUtil::Time deadline;
+    if(timeout > 0)
+    {
+        deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::milliSeconds(timeout);
+    }
+    ++_sendQueueWaiters;
+    while(_sendQueueSize >= _sendQueueMax && _state < StateClosing)
+    {
+        if(timeout > 0)
+        {
+            IceUtil::Time remaining = deadline - IceUtil::Time::now(IceUtil::Time::Monotonic);
+            if(remaining <= IceUtil::Time())
+            {
+                --_sendQueueWaiters;
+                throw InvocationTimeoutException(__FILE__, __LINE__);
+            }
+            timedWait(remaining);
+        }
+        else
+        {
+            wait();
+        }
+    }
+    --_sendQueueWaiters;
 }
 
 BatchRequestQueuePtr
@@ -950,7 +1142,7 @@ public:
             _os.write(headerSize); // Message size.
             _os.i = _os.b.begin();
 
-            AsyncStatus status = _connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, false, false, 0);
+            AsyncStatus status = _connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, false, false, 0, 0);
             if(status & AsyncStatusSent)
             {
                 _sentSynchronously = true;
@@ -1206,16 +1398,8 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
         {
             if(o->requestId)
             {
-                if(_asyncRequestsHint != _asyncRequests.end() &&
-                   _asyncRequestsHint->second == ICE_DYNAMIC_CAST(OutgoingAsync, outAsync))
-                {
-                    _asyncRequests.erase(_asyncRequestsHint);
-                    _asyncRequestsHint = _asyncRequests.end();
-                }
-                else
-                {
-                    _asyncRequests.erase(o->requestId);
-                }
+                _asyncRequests.remove(o->requestId);
+                abortOutStream(o->requestId);
             }
 
             if(dynamic_cast<const Ice::ConnectionTimeoutException*>(&ex))
@@ -1226,15 +1410,18 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
             {
                 //
                 // If the request is being sent, don't remove it from the send streams,
-                // it will be removed once the sending is finished.
+                // it will be removed once the sending is finished. This is also the
+                // case if the request was already partially sent by a gather write or
+                // if it's the last fragment of a request, the peer expects it.
                 //
-                if(o == _sendStreams.begin())
+                if(o == _sendStreams.begin() || o->stream->i || o->fragment)
                 {
                     o->canceled(true); // true = adopt the stream
                 }
                 else
                 {
                     o->canceled(false);
+                    dequeued(*o);
                     _sendStreams.erase(o);
                 }
                 if(outAsync->exception(ex))
@@ -1248,53 +1435,46 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
 
     if(ICE_DYNAMIC_CAST(OutgoingAsync, outAsync))
     {
-        if(_asyncRequestsHint != _asyncRequests.end())
+        Int requestId = _asyncRequests.find(outAsync);
+        if(requestId)
         {
-            if(_asyncRequestsHint->second == outAsync)
+            if(dynamic_cast<const Ice::ConnectionTimeoutException*>(&ex))
             {
-                if(dynamic_cast<const Ice::ConnectionTimeoutException*>(&ex))
-                {
-                    setState(StateClosed, ex);
-                }
-                else
-                {
-                    _asyncRequests.erase(_asyncRequestsHint);
-                    _asyncRequestsHint = _asyncRequests.end();
-                    if(outAsync->exception(ex))
-                    {
-                        outAsync->invokeExceptionAsync();
-                    }
-                }
-                return;
+                setState(StateClosed, ex);
             }
-        }
-
-        for(map<Int, OutgoingAsyncBasePtr>::iterator p = _asyncRequests.begin(); p != _asyncRequests.end(); ++p)
-        {
-            if(p->second.get() == outAsync.get())
+            else
             {
-                if(dynamic_cast<const Ice::ConnectionTimeoutException*>(&ex))
-                {
-                    setState(StateClosed, ex);
-                }
-                else
+                abortOutStream(requestId);
+                _asyncRequests.remove(requestId);
+                if(outAsync->exception(ex))
                 {
-                    assert(p != _asyncRequestsHint);
-                    _asyncRequests.erase(p);
-                    if(outAsync->exception(ex))
-                    {
-                        outAsync->invokeExceptionAsync();
-                    }
+                    outAsync->invokeExceptionAsync();
                 }
-                return;
             }
         }
     }
 }
 
 void
-Ice::ConnectionI::sendResponse(Int, OutputStream* os, Byte compressFlag, bool /*amd*/)
+Ice::ConnectionI::sendResponse(Int requestId, OutputStream* os, Byte compressFlag, bool amd)
 {
+    //
+    // See sendAsyncRequest(), a source which can't be read is fatal for
+    // the connection since the peer can't be told to stop reading.
+    //
+    if(os->getStreamedSource() && !_peerStreams)
+    {
+        try
+        {
+            os->inlineStreamedSource();
+        }
+        catch(const LocalException& ex)
+        {
+            invokeException(requestId, ex, 1, amd);
+            return;
+        }
+    }
+
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     assert(_state > StateNotValidated);
 
@@ -1315,9 +1495,19 @@ Ice::ConnectionI::sendResponse(Int, OutputStream* os, Byte compressFlag, bool /*
             _exception->ice_throw();
         }
 
+        if(os->getStreamedSource())
+        {
+            os->b[9] = static_cast<Byte>(os->b[9] | streamFlag);
+        }
+
         OutgoingMessage message(os, compressFlag > 0);
         sendMessage(message);
 
+        if(os->getStreamedSource())
+        {
+            addOutStream(requestId, true, os->getStreamedSource(), 0);
+        }
+
         if(_state == StateClosing && _dispatchCount == 0)
         {
             initiateShutdown();
@@ -1570,6 +1760,7 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
     StartCallbackPtr startCB;
     vector<OutgoingMessage> sentCBs;
     Byte compress = 0;
+    bool streamed = false;
     Int requestId = 0;
     Int invokeNum = 0;
     ServantManagerPtr servantManager;
@@ -1753,6 +1944,7 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
                                                                               invokeNum,
                                                                               requestId,
                                                                               compress,
+                                                                              streamed,
                                                                               servantManager,
                                                                               adapter,
                                                                               outAsync,
@@ -1827,7 +2019,31 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
         }
     }
 
-    if(!_dispatcher) // Optimization, call dispatch() directly if there's no dispatcher.
+    if(streamed && !_dispatcher)
+    {
+        //
+        // Reading the streamed sequence of the request or reply blocks until
+        // its chunks are received by the thread pool, it's dispatched on a
+        // dedicated thread. The thread pool can receive the chunks even if
+        // it has a single thread.
+        //
+        DispatchWorkItemPtr call = new DispatchCall(ICE_SHARED_FROM_THIS, startCB, sentCBs, compress, requestId,
+                                                    invokeNum, servantManager, adapter, outAsync, heartbeatCallback,
+                                                    current.stream);
+        if(!startStreamCall(_instance, call))
+        {
+            //
+            // The streamed sequence is rejected, the dispatch fails to read
+            // it instead of blocking this thread.
+            //
+            {
+                IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+                rejectInStream(requestId, outAsync != 0);
+            }
+            call->run();
+        }
+    }
+    else if(!_dispatcher) // Optimization, call dispatch() directly if there's no dispatcher.
     {
         dispatch(startCB, sentCBs, compress, requestId, invokeNum, servantManager, adapter, outAsync, heartbeatCallback,
                  current.stream);
@@ -2084,6 +2300,7 @@ Ice::ConnectionI::finish(bool close)
                         outAsync->invokeResponse();
                     }
                 }
+                dequeued(*message);
                 _sendStreams.pop_front();
             }
 #endif
@@ -2092,21 +2309,22 @@ Ice::ConnectionI::finish(bool close)
 
         for(deque<OutgoingMessage>::iterator o = _sendStreams.begin(); o != _sendStreams.end(); ++o)
         {
+            dequeued(*o);
             o->completed(*_exception);
             if(o->requestId) // Make sure finished isn't called twice.
             {
-                _asyncRequests.erase(o->requestId);
+                _asyncRequests.remove(o->requestId);
             }
         }
 
         _sendStreams.clear();
     }
 
-    for(map<Int, OutgoingAsyncBasePtr>::const_iterator q = _asyncRequests.begin(); q != _asyncRequests.end(); ++q)
+    for(RequestTable::const_iterator q = _asyncRequests.begin(); q != _asyncRequests.end(); ++q)
     {
-        if(q->second->exception(*_exception))
+        if(q.outAsync()->exception(*_exception))
         {
-            q->second->invokeException();
+            q.outAsync()->invokeException();
         }
     }
 
@@ -2242,10 +2460,22 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _warn(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Connections") > 0),
     _warnUdp(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Datagrams") > 0),
     _compressionLevel(1),
-    _nextRequestId(1),
-    _asyncRequestsHint(_asyncRequests.end()),
+    _compressionMinSize(100),
     _messageSizeMax(adapter ? adapter->messageSizeMax() : _instance->messageSizeMax()),
     _batchRequestQueue(new BatchRequestQueue(instance, endpoint->datagram())),
+    _sendQueueMax(_instance->sendQueueMax()),
+    _sendQueueThrow(_instance->sendQueueThrow()),
+    _sendQueueSize(0),
+    _sendQueueWaiters(0),
+    _outstandingMessageBytes(0),
+    _fragmentSize(0),
+    _fragmentedMessagesMax(0),
+    _peerFragments(false),
+    _sendSupportFlags(false),
+    _nextFragmentId(1),
+    _streamChunkSize(0),
+    _streamWindowSize(0),
+    _peerStreams(false),
     _readStream(_instance.get(), Ice::currentProtocolEncoding),
     _readHeader(false),
     _writeStream(_instance.get(), Ice::currentProtocolEncoding),
@@ -2268,6 +2498,29 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
         compressionLevel = 9;
     }
 
+    int compressionMinSize = properties->getPropertyAsIntWithDefault("Ice.Compression.MinSize", 100);
+    const_cast<size_t&>(_compressionMinSize) = static_cast<size_t>(compressionMinSize < 0 ? 0 : compressionMinSize);
+
+    //
+    // Fragments are only sent over stream connections, the first fragment
+    // must at least contain the header of the fragmented message.
+    //
+    int fragmentSize = properties->getPropertyAsIntWithDefault("Ice.FragmentSize", 0);
+    if(fragmentSize > 0 && !endpoint->datagram())
+    {
+        const_cast<size_t&>(_fragmentSize) = static_cast<size_t>(max(fragmentSize, 1024));
+    }
+    const_cast<size_t&>(_fragmentedMessagesMax) =
+        static_cast<size_t>(max(properties->getPropertyAsIntWithDefault("Ice.FragmentedMessagesMax", 16), 1));
+
+    //
+    // The window of a received stream is the amount of data buffered
+    // before the application reads it, it must allow a full chunk.
+    //
+    const_cast<Int&>(_streamChunkSize) = max(properties->getPropertyAsIntWithDefault("Ice.StreamChunkSize", 65536), 1024);
+    const_cast<Int&>(_streamWindowSize) = max(properties->getPropertyAsIntWithDefault("Ice.StreamWindowSize", 1048576),
+                                              2 * _streamChunkSize);
+
     if(adapter)
     {
         _servantManager = adapter->getServantManager();
@@ -2292,11 +2545,11 @@ Ice::ConnectionI::create(const CommunicatorPtr& communicator,
                                              endpoint, adapter));
     if(adapter)
     {
-        const_cast<ThreadPoolPtr&>(conn->_threadPool) = adapter->getThreadPool();
+        const_cast<ThreadPoolPtr&>(conn->_threadPool) = adapter->getThreadPool()->getShard();
     }
     else
     {
-        const_cast<ThreadPoolPtr&>(conn->_threadPool) = conn->_instance->clientThreadPool();
+        const_cast<ThreadPoolPtr&>(conn->_threadPool) = conn->_instance->clientThreadPool()->getShard();
     }
     conn->_threadPool->initialize(conn);
     return conn;
@@ -2461,6 +2714,18 @@ Ice::ConnectionI::setState(State state)
 
                 _batchRequestQueue->destroy(*_exception);
 
+                //
+                // Application threads might be blocked reading the streams
+                // received on this connection.
+                //
+                for(map<StreamKey, StreamReaderPtr>::const_iterator p = _inStreams.begin(); p != _inStreams.end();
+                    ++p)
+                {
+                    p->second->failed(*_exception);
+                }
+                _inStreams.clear();
+                _outStreams.clear();
+
                 //
                 // Don't need to close now for connections so only close the transceiver
                 // if the selector request it.
@@ -2536,6 +2801,12 @@ Ice::ConnectionI::setState(State state)
 
     notifyAll();
 
+    if(_state == StateActive && _sendSupportFlags)
+    {
+        _sendSupportFlags = false;
+        sendSupportFlags();
+    }
+
     if(_state == StateClosing && _dispatchCount == 0)
     {
         try
@@ -2625,6 +2896,34 @@ Ice::ConnectionI::sendHeartbeatNow()
     }
 }
 
+void
+Ice::ConnectionI::sendSupportFlags()
+{
+    assert(_state == StateActive && !_endpoint->datagram());
+
+    OutputStream os(_instance.get(), Ice::currentProtocolEncoding);
+    os.write(magic[0]);
+    os.write(magic[1]);
+    os.write(magic[2]);
+    os.write(magic[3]);
+    os.write(currentProtocol);
+    os.write(currentProtocolEncoding);
+    os.write(validateConnectionMsg);
+    os.write(static_cast<Byte>(fragmentSupportFlag | streamSupportFlag)); // Compression status: fragments and streams accepted.
+    os.write(headerSize); // Message size.
+    os.i = os.b.begin();
+    try
+    {
+        OutgoingMessage message(&os, false);
+        sendMessage(message);
+    }
+    catch(const LocalException& ex)
+    {
+        setState(StateClosed, ex);
+        assert(_exception);
+    }
+}
+
 bool
 Ice::ConnectionI::initialize(SocketOperation operation)
 {
@@ -2661,7 +2960,18 @@ Ice::ConnectionI::validate(SocketOperation operation)
                 _writeStream.write(currentProtocol);
                 _writeStream.write(currentProtocolEncoding);
                 _writeStream.write(validateConnectionMsg);
-                _writeStream.write(static_cast<Byte>(0)); // Compression status (always zero for validate connection).
+                //
+                // The compression status of the validate connection message offers the
+                // configured codec to the peer and advertises the support for fragments
+                // and streams, it's ignored by older Ice versions.
+                //
+                Byte compress = static_cast<Byte>(_instance->compressionCodec() | fragmentSupportFlag |
+                                                  streamSupportFlag);
+                if(_fragmentSize > 0)
+                {
+                    compress = static_cast<Byte>(compress | fragmentRequestFlag);
+                }
+                _writeStream.write(compress);
                 _writeStream.write(headerSize); // Message size.
                 _writeStream.i = _writeStream.b.begin();
                 traceSend(_writeStream, _logger, _traceLevels);
@@ -2743,7 +3053,7 @@ Ice::ConnectionI::validate(SocketOperation operation)
                 throw ConnectionNotValidatedException(__FILE__, __LINE__);
             }
             Byte compress;
-            _readStream.read(compress); // Ignore compression status for validate connection.
+            _readStream.read(compress); // The codec offered by the server, if any.
             Int size;
             _readStream.read(size);
             if(size != headerSize)
@@ -2752,6 +3062,23 @@ Ice::ConnectionI::validate(SocketOperation operation)
             }
             traceRecv(_readStream, _logger, _traceLevels);
 
+            //
+            // Accept the codec offered by the server if it's also the configured codec.
+            //
+            Byte codec = static_cast<Byte>(compress & ~(fragmentSupportFlag | fragmentRequestFlag | streamSupportFlag));
+            if(codec != 0 && codec == static_cast<Byte>(_instance->compressionCodec()))
+            {
+                _compressor = createCompressor(_instance->compressionCodec(), _compressionLevel);
+            }
+
+            //
+            // If the server wants to send fragments or accepts streams, tell it that
+            // we accept them once the connection is activated.
+            //
+            _peerFragments = (compress & fragmentSupportFlag) != 0;
+            _peerStreams = (compress & streamSupportFlag) != 0;
+            _sendSupportFlags = (compress & (fragmentRequestFlag | streamSupportFlag)) != 0;
+
             _validated = true;
         }
     }
@@ -2799,6 +3126,12 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
     assert(!_writeStream.b.empty() && _writeStream.i == _writeStream.b.end());
     try
     {
+        //
+        // With gather writes, writing a message can also write the messages
+        // queued after it. These are notified here as well once written, op
+        // is set if the socket isn't writable anymore.
+        //
+        SocketOperation op = SocketOperationNone;
         while(true)
         {
             //
@@ -2813,6 +3146,7 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
                     callbacks.push_back(*message);
                 }
             }
+            dequeued(*message);
             _sendStreams.pop_front();
 
             //
@@ -2836,56 +3170,20 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
             }
 
             //
-            // Otherwise, prepare the next message stream for writing.
+            // Otherwise, prepare the next message stream for writing. The
+            // message might already be prepared and partially or fully
+            // written if it was included in a previous gather write. The
+            // next fragment of a fragmented message is cut now.
             //
-            message = &_sendStreams.front();
-            assert(!message->stream->i);
-#ifdef ICE_HAS_BZIP2
-            if(message->compress && message->stream->b.size() >= 100) // Only compress messages > 100 bytes.
+            if(_sendStreams.front().fragmentId)
             {
-                //
-                // Message compressed. Request compressed response, if any.
-                //
-                message->stream->b[9] = 2;
-
-                //
-                // Do compression.
-                //
-                OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
-                doCompress(*message->stream, stream);
-
-                traceSend(*message->stream, _logger, _traceLevels);
-
-                message->adopt(&stream); // Adopt the compressed stream.
-                message->stream->i = message->stream->b.begin();
+                cutFragment(_sendStreams.begin());
             }
-            else
+            message = &_sendStreams.front();
+            if(!message->stream->i)
             {
-#endif
-                if(message->compress)
-                {
-                    //
-                    // Message not compressed. Request compressed response, if any.
-                    //
-                    message->stream->b[9] = 1;
-                }
-
-                //
-                // No compression, just fill in the message size.
-                //
-                Int sz = static_cast<Int>(message->stream->b.size());
-                const Byte* p = reinterpret_cast<const Byte*>(&sz);
-#ifdef ICE_BIG_ENDIAN
-                reverse_copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
-#else
-                copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
-#endif
-                message->stream->i = message->stream->b.begin();
-                traceSend(*message->stream, _logger, _traceLevels);
-
-#ifdef ICE_HAS_BZIP2
+                prepareMessage(*message);
             }
-#endif
             _writeStream.swap(*message->stream);
 
             //
@@ -2898,8 +3196,16 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
             assert(_writeStream.i);
             if(_writeStream.i != _writeStream.b.end())
             {
-                SocketOperation op = write(_writeStream);
                 if(op)
+                {
+                    return op; // The last write blocked.
+                }
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
+                op = write(_writeStream);
+#else
+                op = gatherWrite();
+#endif
+                if(op && _writeStream.i != _writeStream.b.end())
                 {
                     return op;
                 }
@@ -2917,7 +3223,7 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
         if(_state == StateClosing && _shutdownInitiated)
         {
             setState(StateClosingPending);
-            SocketOperation op = _transceiver->closing(true, *_exception);
+            op = _transceiver->closing(true, *_exception);
             if(op)
             {
                 return op;
@@ -2931,73 +3237,28 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
     return SocketOperationNone;
 }
 
-AsyncStatus
-Ice::ConnectionI::sendMessage(OutgoingMessage& message)
+void
+Ice::ConnectionI::prepareMessage(OutgoingMessage& message)
 {
-    assert(_state < StateClosed);
-
-    message.stream->i = 0; // Reset the message stream iterator before starting sending the message.
-
-    if(!_sendStreams.empty())
-    {
-        _sendStreams.push_back(message);
-        _sendStreams.back().adopt(0);
-        return AsyncStatusQueued;
-    }
-
-    //
-    // Attempt to send the message without blocking. If the send blocks, we register
-    // the connection with the selector thread.
-    //
-
-    message.stream->i = message.stream->b.begin();
-    SocketOperation op;
+    assert(!message.stream->i);
 #ifdef ICE_HAS_BZIP2
-    if(message.compress && message.stream->b.size() >= 100) // Only compress messages larger than 100 bytes.
+    if(message.compress && message.stream->b.size() >= _compressionMinSize) // Only compress large enough messages.
     {
         //
         // Message compressed. Request compressed response, if any.
         //
-        message.stream->b[9] = 2;
+        message.stream->b[9] = static_cast<Byte>((message.stream->b[9] & streamFlag) | (_compressor ? 4 : 2));
 
         //
         // Do compression.
         //
         OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
         doCompress(*message.stream, stream);
-        stream.i = stream.b.begin();
 
         traceSend(*message.stream, _logger, _traceLevels);
 
-        //
-        // Send the message without blocking.
-        //
-        if(_observer)
-        {
-            _observer.startWrite(stream);
-        }
-        op = write(stream);
-        if(!op)
-        {
-            if(_observer)
-            {
-                _observer.finishWrite(stream);
-            }
-
-            AsyncStatus status = AsyncStatusSent;
-            if(message.sent())
-            {
-                status = static_cast<AsyncStatus>(status | AsyncStatusInvokeSentCallback);
-            }
-            if(_acmLastActivity != IceUtil::Time())
-            {
-                _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
-            }
-            return status;
-        }
-
-        _sendStreams.push_back(message);
-        _sendStreams.back().adopt(&stream);
+        message.adopt(&stream); // Adopt the compressed stream.
+        message.stream->i = message.stream->b.begin();
     }
     else
     {
@@ -3007,7 +3268,7 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
             //
             // Message not compressed. Request compressed response, if any.
             //
-            message.stream->b[9] = 1;
+            message.stream->b[9] = static_cast<Byte>((message.stream->b[9] & streamFlag) | (_compressor ? 3 : 1));
         }
 
         //
@@ -3021,131 +3282,684 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
         copy(p, p + sizeof(Int), message.stream->b.begin() + 10);
 #endif
         message.stream->i = message.stream->b.begin();
-
         traceSend(*message.stream, _logger, _traceLevels);
 
-        //
-        // Send the message without blocking.
-        //
-        if(_observer)
+#ifdef ICE_HAS_BZIP2
+    }
+#endif
+}
+
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+SocketOperation
+Ice::ConnectionI::gatherWrite()
+{
+    //
+    // Write the current message along with the messages queued after it
+    // with a single gather write if the transceiver supports it. The number
+    // of bytes submitted is bounded by the transceiver gather write size.
+    //
+    // Datagram connections are always implicitly validated.
+    //
+    size_t maxSize = _transceiver->getGatherWriteSize();
+    if(maxSize == 0 || (!_validated && !_endpoint->datagram()) || _sendStreams.size() < 2)
+    {
+        return write(_writeStream);
+    }
+
+    _gatherBuffers.clear();
+    _gatherBuffers.push_back(&_writeStream);
+    size_t size = static_cast<size_t>(_writeStream.b.end() - _writeStream.i);
+    for(size_t n = 1; n < _sendStreams.size() && size < maxSize && _gatherBuffers.size() < 64; ++n)
+    {
+        if(_sendStreams[n].fragmentId)
         {
-            _observer.startWrite(*message.stream);
+            cutFragment(_sendStreams.begin() + n); // Invalidates the iterators of the send streams.
         }
-        op = write(*message.stream);
-        if(!op)
+        OutgoingMessage& message = _sendStreams[n];
+        if(!message.stream->i)
         {
-            if(_observer)
-            {
-                _observer.finishWrite(*message.stream);
-            }
-            AsyncStatus status = AsyncStatusSent;
-            if(message.sent())
-            {
-                status = static_cast<AsyncStatus>(status | AsyncStatusInvokeSentCallback);
-            }
-            if(_acmLastActivity != IceUtil::Time())
-            {
-                _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
-            }
-            return status;
+            prepareMessage(message);
         }
+        _gatherBuffers.push_back(message.stream);
+        size += static_cast<size_t>(message.stream->b.end() - message.stream->i);
+    }
 
-        _sendStreams.push_back(message);
-        _sendStreams.back().adopt(0); // Adopt the stream.
-#ifdef ICE_HAS_BZIP2
+    Buffer::Container::iterator start = _writeStream.i;
+    SocketOperation op = _transceiver->writev(_gatherBuffers);
+
+    size_t remaining = 0;
+    for(vector<Buffer*>::const_iterator p = _gatherBuffers.begin(); p != _gatherBuffers.end(); ++p)
+    {
+        remaining += static_cast<size_t>((*p)->b.end() - (*p)->i);
+    }
+    size_t sent = size - remaining;
+
+    //
+    // The bytes written for the current message are reported to the observer
+    // by finishWrite. The bytes written for the following messages must be
+    // reported here, they won't be accounted for once these messages become
+    // the current message.
+    //
+    size_t sentAhead = sent - static_cast<size_t>(_writeStream.i - start);
+    if(_observer && sentAhead > 0)
+    {
+        _observer->sentBytes(static_cast<int>(sentAhead));
+    }
+
+    if(_instance->traceLevels()->network >= 3 && sent > 0)
+    {
+        Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
+        out << "sent " << sent << " of " << size << " bytes via " << _endpoint->protocol()
+            << " (" << _gatherBuffers.size() << " messages)\n" << toString();
     }
+    return op;
+}
 #endif
 
+AsyncStatus
+Ice::ConnectionI::sendMessage(OutgoingMessage& message)
+{
+    assert(_state < StateClosed);
+
+    message.stream->i = 0; // Reset the message stream iterator before starting sending the message.
+
+    if(_peerFragments && _fragmentSize > 0 && message.stream->b.size() > _fragmentSize)
+    {
+        return sendFragments(message);
+    }
+
+    if(!_sendStreams.empty())
+    {
+        deque<OutgoingMessage>::iterator p = _sendStreams.insert(findSendPosition(message.priority, message.fragment),
+                                                                 message);
+        p->adopt(0);
+        queued(*p);
+        return AsyncStatusQueued;
+    }
+
+    //
+    // Attempt to send the message without blocking. If the send blocks, we register
+    // the connection with the selector thread.
+    //
+
+    prepareMessage(message);
+
+    //
+    // Send the message without blocking.
+    //
+    if(_observer)
+    {
+        _observer.startWrite(*message.stream);
+    }
+    SocketOperation op = write(*message.stream);
+    if(!op)
+    {
+        if(_observer)
+        {
+            _observer.finishWrite(*message.stream);
+        }
+        AsyncStatus status = AsyncStatusSent;
+        if(message.sent())
+        {
+            status = static_cast<AsyncStatus>(status | AsyncStatusInvokeSentCallback);
+        }
+        if(_acmLastActivity != IceUtil::Time())
+        {
+            _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        }
+        return status;
+    }
+
+    _sendStreams.push_back(message);
+    _sendStreams.back().adopt(0); // Adopt the stream, unless the compressed stream is already adopted.
+
+    queued(_sendStreams.back());
     _writeStream.swap(*_sendStreams.back().stream);
     scheduleTimeout(op);
     _threadPool->_register(ICE_SHARED_FROM_THIS, op);
     return AsyncStatusQueued;
 }
 
-#ifdef ICE_HAS_BZIP2
-static string
-getBZ2Error(int bzError)
+AsyncStatus
+Ice::ConnectionI::sendFragments(OutgoingMessage& message)
+{
+    //
+    // Prepare the message as if it was sent in one piece and queue it as a
+    // whole. Its fragments are cut from its bytes when they're about to be
+    // sent, see cutFragment. Only the last fragment carries the request.
+    //
+    prepareMessage(message);
+
+    bool sending = !_sendStreams.empty();
+    deque<OutgoingMessage>::iterator p = _sendStreams.insert(findSendPosition(message.priority, true), message);
+    p->adopt(0);
+    p->fragment = true;
+    p->fragmentId = _nextFragmentId++;
+    if(_nextFragmentId <= 0)
+    {
+        _nextFragmentId = 1;
+    }
+    queued(*p);
+
+    //
+    // If no message was being sent, start sending the first fragment once
+    // the connection is writable.
+    //
+    if(!sending)
+    {
+        cutFragment(_sendStreams.begin());
+        _writeStream.swap(*_sendStreams.front().stream);
+        scheduleTimeout(SocketOperationWrite);
+        _threadPool->_register(ICE_SHARED_FROM_THIS, SocketOperationWrite);
+    }
+    return AsyncStatusQueued;
+}
+
+void
+Ice::ConnectionI::cutFragment(deque<OutgoingMessage>::iterator p)
 {
-    if(bzError == BZ_RUN_OK)
+    //
+    // Queue the header of the next fragment of the given fragmented message
+    // before it, followed by a slice of the message bytes. The slice refers
+    // to the bytes of the message, which remains queued after its last
+    // slice with nothing left to write. It's notified as sent once all its
+    // fragments are sent.
+    //
+    assert(p->fragmentId != 0);
+    Buffer::Container& b = p->stream->b;
+    size_t offset = p->fragmentOffset;
+    size_t length = min(_fragmentSize, b.size() - offset);
+    bool last = offset + length == b.size();
+    Int id = p->fragmentId;
+    int priority = p->priority;
+
+    OutputStream os(_instance.get(), Ice::currentProtocolEncoding);
+    os.writeBlob(fragmentHdr, sizeof(fragmentHdr));
+    Int sz = static_cast<Int>(sizeof(fragmentHdr) + length);
+    const Byte* q = reinterpret_cast<const Byte*>(&sz);
+#ifdef ICE_BIG_ENDIAN
+    reverse_copy(q, q + sizeof(Int), os.b.begin() + 10);
+#else
+    copy(q, q + sizeof(Int), os.b.begin() + 10);
+#endif
+    q = reinterpret_cast<const Byte*>(&id);
+#ifdef ICE_BIG_ENDIAN
+    reverse_copy(q, q + sizeof(Int), os.b.begin() + headerSize);
+#else
+    copy(q, q + sizeof(Int), os.b.begin() + headerSize);
+#endif
+    os.i = os.b.begin();
+    traceSend(os, _logger, _traceLevels);
+
+    OutputStream* slice = new OutputStream(_instance.get(), Ice::currentProtocolEncoding);
+    Buffer::Container bytes(b.begin() + offset, b.begin() + offset + length);
+    slice->b.swap(bytes);
+    slice->i = slice->b.begin();
+
+    dequeued(*p);
+    p->fragmentOffset = offset + length;
+    if(last)
+    {
+        p->fragmentId = 0;
+        p->stream->i = b.end();
+    }
+    queued(*p);
+
+    OutgoingMessage header(&os, false);
+    header.priority = priority;
+    header.fragment = true;
+    p = _sendStreams.insert(p, header);
+    p->adopt(&os);
+    queued(*p);
+
+    OutgoingMessage message(slice, false);
+    message.adopted = true;
+    message.priority = priority;
+    message.fragment = true;
+    message.slice = true;
+    p = _sendStreams.insert(p + 1, message);
+    queued(*p);
+}
+
+deque<Ice::ConnectionI::OutgoingMessage>::iterator
+Ice::ConnectionI::findSendPosition(int priority, bool fragment)
+{
+    //
+    // Messages are sent by decreasing priority and in order for a given
+    // priority, except that a message is sent before the fragments queued
+    // with the same priority: small messages aren't delayed until all the
+    // fragments of a large message are sent. A message is never queued
+    // before the message being sent, before a message partially sent by a
+    // gather write or before the slice of a fragment. This includes a
+    // fragmented message whose fragments are all cut, it has nothing left
+    // to write. Once closing, messages are sent in order, the close
+    // connection message must be sent last.
+    //
+    deque<OutgoingMessage>::iterator p = _sendStreams.end();
+    if(_state >= StateClosing)
     {
-        return ": BZ_RUN_OK";
+        return p;
     }
-    else if(bzError == BZ_FLUSH_OK)
+    while(p != _sendStreams.begin() && p - 1 != _sendStreams.begin())
     {
-        return ": BZ_FLUSH_OK";
+        const OutgoingMessage& previous = *(p - 1);
+        if(previous.slice || (previous.stream->i && previous.stream->i != previous.stream->b.begin()))
+        {
+            break;
+        }
+        if(previous.priority > priority || (previous.priority == priority && (fragment || !previous.fragment)))
+        {
+            break;
+        }
+        --p;
     }
-    else if(bzError == BZ_FINISH_OK)
+    return p;
+}
+
+void
+Ice::ConnectionI::queued(OutgoingMessage& message)
+{
+    message.queued = message.stream->b.size() - message.fragmentOffset;
+    _sendQueueSize += message.queued;
+    if(message.requestId == 0)
     {
-        return ": BZ_FINISH_OK";
+        _outstandingMessageBytes.fetch_add(static_cast<int>(message.queued));
     }
-    else if(bzError == BZ_STREAM_END)
+    _observer.queuedBytes(static_cast<Int>(message.queued));
+}
+
+void
+Ice::ConnectionI::dequeued(const OutgoingMessage& message)
+{
+    assert(_sendQueueSize >= message.queued);
+    _sendQueueSize -= message.queued;
+    if(message.requestId == 0)
     {
-        return ": BZ_STREAM_END";
+        _outstandingMessageBytes.fetch_sub(static_cast<int>(message.queued));
     }
-    else if(bzError == BZ_CONFIG_ERROR)
+    _observer.queuedBytes(-static_cast<Int>(message.queued));
+    if(_sendQueueWaiters > 0 && _sendQueueSize < _sendQueueMax)
     {
-        return ": BZ_CONFIG_ERROR";
+        notifyAll();
     }
-    else if(bzError == BZ_SEQUENCE_ERROR)
+}
+
+bool
+Ice::ConnectionI::addFragment(InputStream& stream)
+{
+    if(_endpoint->datagram())
     {
-        return ": BZ_SEQUENCE_ERROR";
+        throw UnknownMessageException(__FILE__, __LINE__);
     }
-    else if(bzError == BZ_PARAM_ERROR)
+
+    Int id;
+    stream.read(id);
+
+    map<Int, vector<Byte> >::iterator p = _fragments.find(id);
+    if(p == _fragments.end())
     {
-        return ": BZ_PARAM_ERROR";
+        //
+        // The first fragment starts with the header of the fragmented message.
+        //
+        if(stream.b.end() - stream.i < headerSize)
+        {
+            throw IllegalMessageSizeException(__FILE__, __LINE__);
+        }
+        const Byte* m = stream.i;
+        if(m[0] != magic[0] || m[1] != magic[1] || m[2] != magic[2] || m[3] != magic[3])
+        {
+            BadMagicException ex(__FILE__, __LINE__);
+            ex.badMagic = Ice::ByteSeq(&m[0], &m[0] + sizeof(magic));
+            throw ex;
+        }
+
+        //
+        // A peer only interleaves the fragments of messages with distinct
+        // priorities, it shouldn't need to send many fragmented messages at a
+        // time. Each message being reassembled can use up to the maximum
+        // message size.
+        //
+        if(_fragments.size() >= _fragmentedMessagesMax)
+        {
+            throw ProtocolException(__FILE__, __LINE__, "too many fragmented messages");
+        }
+        p = _fragments.insert(make_pair(id, vector<Byte>())).first;
     }
-    else if(bzError == BZ_MEM_ERROR)
+
+    vector<Byte>& message = p->second;
+    message.insert(message.end(), stream.i, stream.b.end());
+
+    Int size;
+    Byte* q = reinterpret_cast<Byte*>(&size);
+#ifdef ICE_BIG_ENDIAN
+    reverse_copy(message.begin() + 10, message.begin() + headerSize, q);
+#else
+    copy(message.begin() + 10, message.begin() + headerSize, q);
+#endif
+    if(size < headerSize || message[8] == fragmentMsg || message.size() > static_cast<size_t>(size))
     {
-        return ": BZ_MEM_ERROR";
+        throw IllegalMessageSizeException(__FILE__, __LINE__);
     }
-    else if(bzError == BZ_DATA_ERROR)
+    if(size > static_cast<Int>(_messageSizeMax))
     {
-        return ": BZ_DATA_ERROR";
+        Ex::throwMemoryLimitException(__FILE__, __LINE__, size, _messageSizeMax);
     }
-    else if(bzError == BZ_DATA_ERROR_MAGIC)
+    if(message.size() < static_cast<size_t>(size))
     {
-        return ": BZ_DATA_ERROR_MAGIC";
+        return false;
     }
-    else if(bzError == BZ_IO_ERROR)
+
+    stream.b.resize(message.size());
+    copy(message.begin(), message.end(), stream.b.begin());
+    stream.i = stream.b.begin();
+    _fragments.erase(p);
+    return true;
+}
+
+void
+Ice::ConnectionI::sendStreamCredit(Int requestId, bool reply, Int credit)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    if(_state < StateClosingPending && _inStreams.find(StreamKey(requestId, reply)) != _inStreams.end())
     {
-        return ": BZ_IO_ERROR";
+        queueStreamCredit(requestId, reply, 0, credit);
     }
-    else if(bzError == BZ_UNEXPECTED_EOF)
+}
+
+void
+Ice::ConnectionI::closeStream(Int requestId, bool reply)
+{
+    //
+    // This is called when the application releases the source of a
+    // stream, possibly with the mutex locked. The stream is aborted
+    // from a thread pool thread.
+    //
+    try
     {
-        return ": BZ_UNEXPECTED_EOF";
+        _threadPool->dispatch(new StreamCall(ICE_SHARED_FROM_THIS, requestId, reply, true));
     }
-    else if(bzError == BZ_OUTBUFF_FULL)
+    catch(const LocalException&)
     {
-        return ": BZ_OUTBUFF_FULL";
+        // Ignore, the communicator is destroyed and the connection closed.
+    }
+}
+
+void
+Ice::ConnectionI::abortStream(Int requestId, bool reply)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    map<StreamKey, StreamReaderPtr>::iterator p = _inStreams.find(StreamKey(requestId, reply));
+    if(p != _inStreams.end())
+    {
+        _inStreams.erase(p);
+        if(_state < StateClosingPending)
+        {
+            queueStreamCredit(requestId, reply, streamAbortFlag, 0);
+        }
+    }
+}
+
+void
+Ice::ConnectionI::rejectInStream(Int requestId, bool reply)
+{
+    map<StreamKey, StreamReaderPtr>::iterator p = _inStreams.find(StreamKey(requestId, reply));
+    if(p != _inStreams.end())
+    {
+        MarshalException ex(__FILE__, __LINE__);
+        ex.reason = "too many streamed sequences";
+        p->second->failed(ex);
+        _inStreams.erase(p);
+        if(_state < StateClosingPending)
+        {
+            queueStreamCredit(requestId, reply, streamAbortFlag, 0);
+        }
+    }
+}
+
+void
+Ice::ConnectionI::pumpStream(Int requestId, bool reply)
+{
+    const StreamKey key(requestId, reply);
+    while(true)
+    {
+        ByteSourcePtr source;
+        Int maxSize;
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+            map<StreamKey, OutStream>::iterator p = _outStreams.find(key);
+            while(p != _outStreams.end() && p->second.credit <= 0 && _state < StateClosingPending)
+            {
+                wait(); // Wait for the peer to grant credits.
+                p = _outStreams.find(key);
+            }
+            if(p == _outStreams.end() || _state >= StateClosingPending)
+            {
+                return; // Aborted by the peer or the connection is closed.
+            }
+            source = p->second.source;
+            maxSize = min(p->second.credit, _streamChunkSize);
+        }
+
+        //
+        // The source is read without the mutex locked, it might block.
+        //
+        vector<Byte> data;
+        bool more = false;
+        string error;
+        try
+        {
+            more = source->read(data, maxSize);
+        }
+        catch(const std::exception& ex)
+        {
+            error = ex.what();
+        }
+        catch(...)
+        {
+            error = "unknown c++ exception";
+        }
+
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        map<StreamKey, OutStream>::iterator p = _outStreams.find(key);
+        if(p == _outStreams.end() || _state >= StateClosingPending)
+        {
+            return;
+        }
+
+        if(!error.empty())
+        {
+            if(_warn)
+            {
+                Warning out(_logger);
+                out << "exception raised by the source of a streamed sequence:\n" << error << '\n' << _desc;
+            }
+            queueStreamChunk(requestId, reply, streamAbortFlag, vector<Byte>(), p->second.priority);
+            _outStreams.erase(p);
+            return;
+        }
+
+        if(!data.empty())
+        {
+            queueStreamChunk(requestId, reply, 0, data, p->second.priority);
+            p->second.credit -= static_cast<Int>(data.size());
+        }
+
+        if(!more)
+        {
+            queueStreamChunk(requestId, reply, streamEndFlag, vector<Byte>(), p->second.priority);
+            _outStreams.erase(p);
+            return;
+        }
+    }
+}
+
+void
+Ice::ConnectionI::queueStreamChunk(Int requestId, bool reply, Byte flags, const vector<Byte>& data, int priority)
+{
+    OutputStream os(_instance.get(), Ice::currentProtocolEncoding);
+    os.writeBlob(streamChunkHdr, sizeof(streamChunkHdr));
+    os.rewrite(requestId, headerSize);
+    os.b[headerSize + sizeof(Int)] = static_cast<Byte>(flags | (reply ? streamReplyFlag : 0));
+    os.writeBlob(data);
+    try
+    {
+        //
+        // Chunks are queued like fragments, the messages queued later
+        // with the same priority are sent first.
+        //
+        OutgoingMessage message(&os, false);
+        message.priority = priority;
+        message.fragment = true;
+        sendMessage(message);
+    }
+    catch(const LocalException& ex)
+    {
+        setState(StateClosed, ex);
+    }
+}
+
+void
+Ice::ConnectionI::queueStreamCredit(Int requestId, bool reply, Byte flags, Int credit)
+{
+    OutputStream os(_instance.get(), Ice::currentProtocolEncoding);
+    os.writeBlob(streamCreditHdr, sizeof(streamCreditHdr));
+    os.rewrite(requestId, headerSize);
+    os.b[headerSize + sizeof(Int)] = static_cast<Byte>(flags | (reply ? streamReplyFlag : 0));
+    os.write(credit);
+    try
+    {
+        OutgoingMessage message(&os, false);
+        sendMessage(message);
+    }
+    catch(const LocalException& ex)
+    {
+        setState(StateClosed, ex);
+    }
+}
+
+void
+Ice::ConnectionI::addOutStream(Int requestId, bool reply, const ByteSourcePtr& source, int priority)
+{
+    //
+    // The chunks are sent by a dedicated thread once the peer grants
+    // credits, reading the source might block.
+    //
+    OutStream stream;
+    stream.source = source;
+    stream.credit = 0;
+    stream.priority = priority;
+    _outStreams[StreamKey(requestId, reply)] = stream;
+    if(!startStreamCall(_instance, new StreamCall(ICE_SHARED_FROM_THIS, requestId, reply, false)))
+    {
+        _outStreams.erase(StreamKey(requestId, reply));
+        queueStreamChunk(requestId, reply, streamAbortFlag, vector<Byte>(), priority);
+    }
+}
+
+
+void
+Ice::ConnectionI::abortOutStream(Int requestId)
+{
+    map<StreamKey, OutStream>::iterator p = _outStreams.find(StreamKey(requestId, false));
+    if(p != _outStreams.end())
+    {
+        int priority = p->second.priority;
+        _outStreams.erase(p);
+        queueStreamChunk(requestId, false, streamAbortFlag, vector<Byte>(), priority);
+        notifyAll(); // Notify the thread pumping the stream.
+    }
+}
+
+void
+Ice::ConnectionI::addInStream(InputStream& stream, Int requestId, bool reply)
+{
+    StreamReaderPtr reader = new IceInternal::StreamReader(ICE_SHARED_FROM_THIS, requestId, reply, _streamWindowSize);
+    _inStreams[StreamKey(requestId, reply)] = reader;
+    stream.setStreamedSource(IceInternal::StreamReader::createSource(reader));
+    queueStreamCredit(requestId, reply, 0, _streamWindowSize);
+}
+
+void
+Ice::ConnectionI::parseStreamMessage(InputStream& stream, Byte messageType)
+{
+    if(_endpoint->datagram())
+    {
+        throw UnknownMessageException(__FILE__, __LINE__);
+    }
+
+    Int requestId;
+    stream.read(requestId);
+    Byte flags;
+    stream.read(flags);
+    const StreamKey key(requestId, (flags & streamReplyFlag) != 0);
+
+    //
+    // Messages for unknown streams are ignored, the stream might have
+    // been aborted by this side of the connection.
+    //
+    if(messageType == streamChunkMsg)
+    {
+        map<StreamKey, StreamReaderPtr>::iterator p = _inStreams.find(key);
+        if(p != _inStreams.end())
+        {
+            if(flags & streamAbortFlag)
+            {
+                MarshalException ex(__FILE__, __LINE__);
+                ex.reason = "streamed sequence aborted by the sender";
+                p->second->failed(ex);
+                _inStreams.erase(p);
+            }
+            else
+            {
+                p->second->received(stream.i, stream.b.end(), (flags & streamEndFlag) != 0);
+                if(flags & streamEndFlag)
+                {
+                    _inStreams.erase(p);
+                }
+            }
+        }
     }
     else
     {
-        return "";
+        Int credit;
+        stream.read(credit);
+        map<StreamKey, OutStream>::iterator p = _outStreams.find(key);
+        if(p != _outStreams.end())
+        {
+            if(flags & streamAbortFlag)
+            {
+                _outStreams.erase(p);
+                notifyAll(); // Notify the thread pumping the stream.
+            }
+            else if(credit > 0)
+            {
+                p->second.credit += credit;
+                notifyAll(); // Notify the thread pumping the stream.
+            }
+        }
     }
 }
 
+#ifdef ICE_HAS_BZIP2
 void
 Ice::ConnectionI::doCompress(OutputStream& uncompressed, OutputStream& compressed)
 {
     const Byte* p;
 
+    if(!_compressor && !_bzip2Compressor)
+    {
+        _bzip2Compressor = createCompressor(CompressionCodecBZip2, _compressionLevel);
+    }
+    Compressor* compressor = _compressor ? _compressor.get() : _bzip2Compressor.get();
+
     //
     // Compress the message body, but not the header.
     //
-    unsigned int uncompressedLen = static_cast<unsigned int>(uncompressed.b.size() - headerSize);
-    unsigned int compressedLen = static_cast<unsigned int>(uncompressedLen * 1.01 + 600);
-    compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
-    int bzError = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
-                                           &compressedLen,
-                                           reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
-                                           uncompressedLen,
-                                           _compressionLevel, 0, 0);
-    if(bzError != BZ_OK)
-    {
-        CompressionException ex(__FILE__, __LINE__);
-        ex.reason = "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError);
-        throw ex;
-    }
+    size_t uncompressedLen = uncompressed.b.size() - headerSize;
+    compressed.b.resize(headerSize + sizeof(Int) + compressor->compressBound(uncompressedLen));
+    size_t compressedLen = compressor->compress(&uncompressed.b[0] + headerSize, uncompressedLen,
+                                                &compressed.b[0] + headerSize + sizeof(Int),
+                                                compressed.b.size() - headerSize - sizeof(Int));
     compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
 
     //
@@ -3180,8 +3994,26 @@ Ice::ConnectionI::doCompress(OutputStream& uncompressed, OutputStream& compresse
 }
 
 void
-Ice::ConnectionI::doUncompress(InputStream& compressed, InputStream& uncompressed)
+Ice::ConnectionI::doUncompress(InputStream& compressed, InputStream& uncompressed, Byte compress)
 {
+    Compressor* compressor;
+    if(compress == 4)
+    {
+        //
+        // Compressed with the negotiated codec.
+        //
+        compressor = _compressor.get();
+    }
+    else
+    {
+        if(!_bzip2Compressor)
+        {
+            _bzip2Compressor = createCompressor(CompressionCodecBZip2, _compressionLevel);
+        }
+        compressor = _bzip2Compressor.get();
+    }
+    assert(compressor);
+
     Int uncompressedSize;
     compressed.i = compressed.b.begin() + headerSize;
     compressed.read(uncompressedSize);
@@ -3196,26 +4028,17 @@ Ice::ConnectionI::doUncompress(InputStream& compressed, InputStream& uncompresse
     }
     uncompressed.resize(uncompressedSize);
 
-    unsigned int uncompressedLen = uncompressedSize - headerSize;
-    unsigned int compressedLen = static_cast<unsigned int>(compressed.b.size() - headerSize - sizeof(Int));
-    int bzError = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
-                                             &uncompressedLen,
-                                             reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
-                                             compressedLen,
-                                             0, 0);
-    if(bzError != BZ_OK)
-    {
-        CompressionException ex(__FILE__, __LINE__);
-        ex.reason = "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError);
-        throw ex;
-    }
+    compressor->uncompress(&compressed.b[0] + headerSize + sizeof(Int),
+                           compressed.b.size() - headerSize - sizeof(Int),
+                           &uncompressed.b[0] + headerSize,
+                           static_cast<size_t>(uncompressedSize - headerSize));
 
     copy(compressed.b.begin(), compressed.b.begin() + headerSize, uncompressed.b.begin());
 }
 #endif
 
 SocketOperation
-Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& requestId, Byte& compress,
+Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& requestId, Byte& compress, bool& streamed,
                                ServantManagerPtr& servantManager, ObjectAdapterPtr& adapter,
                                OutgoingAsyncBasePtr& outAsync, ICE_HEARTBEAT_CALLBACK& heartbeatCallback,
                                int& dispatchCount)
@@ -3250,11 +4073,52 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
         stream.read(messageType);
         stream.read(compress);
 
-        if(compress == 2)
+        if(messageType == fragmentMsg)
+        {
+            //
+            // Parse the fragmented message once all its fragments are received.
+            //
+            traceRecv(stream, _logger, _traceLevels);
+            stream.i = stream.b.begin() + headerSize;
+            if(!addFragment(stream))
+            {
+                return _state == StateHolding ? SocketOperationNone : SocketOperationRead;
+            }
+            stream.i = stream.b.begin() + 8;
+            stream.read(messageType);
+            stream.read(compress);
+        }
+
+        //
+        // The streamed sequence of a request or reply with the stream flag
+        // is received with stream chunk messages.
+        //
+        if((messageType == requestMsg || messageType == replyMsg) && (compress & streamFlag))
+        {
+            streamed = !_endpoint->datagram();
+            compress = static_cast<Byte>(compress & ~streamFlag);
+        }
+
+        if((compress == 3 || compress == 4) && !_compressor)
+        {
+            //
+            // The peer accepted the codec offered with the validate
+            // connection message, use it from now on.
+            //
+            if(_instance->compressionCodec() == CompressionCodecBZip2 || _endpoint->datagram())
+            {
+                ProtocolException ex(__FILE__, __LINE__);
+                ex.reason = "received message with unexpected compression status";
+                throw ex;
+            }
+            _compressor = createCompressor(_instance->compressionCodec(), _compressionLevel);
+        }
+
+        if(compress == 2 || compress == 4)
         {
 #ifdef ICE_HAS_BZIP2
             InputStream ustream(_instance.get(), Ice::currentProtocolEncoding);
-            doUncompress(stream, ustream);
+            doUncompress(stream, ustream, compress);
             stream.b.swap(ustream.b);
 #else
             FeatureNotSupportedException ex(__FILE__, __LINE__);
@@ -3305,6 +4169,10 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
                 {
                     traceRecv(stream, _logger, _traceLevels);
                     stream.read(requestId);
+                    if(streamed && requestId != 0)
+                    {
+                        addInStream(stream, requestId, false);
+                    }
                     invokeNum = 1;
                     servantManager = _servantManager;
                     adapter = _adapter;
@@ -3342,37 +4210,15 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
 
                 stream.read(requestId);
 
-                map<Int, OutgoingAsyncBasePtr>::iterator q = _asyncRequests.end();
-
-                if(_asyncRequestsHint != _asyncRequests.end())
-                {
-                    if(_asyncRequestsHint->first == requestId)
-                    {
-                        q = _asyncRequestsHint;
-                    }
-                }
-
-                if(q == _asyncRequests.end())
-                {
-                    q = _asyncRequests.find(requestId);
-                }
-
-                if(q != _asyncRequests.end())
+                outAsync = _asyncRequests.remove(requestId);
+                if(outAsync)
                 {
-                    outAsync = q->second;
-
-                    if(q == _asyncRequestsHint)
-                    {
-                        _asyncRequests.erase(q++);
-                        _asyncRequestsHint = q;
-                    }
-                    else
+                    stream.swap(*outAsync->getIs());
+                    if(streamed)
                     {
-                        _asyncRequests.erase(q);
+                        addInStream(*outAsync->getIs(), requestId, true);
                     }
 
-                    stream.swap(*outAsync->getIs());
-
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
                     //
                     // If we just received the reply of a request which isn't acknowledge as
@@ -3405,14 +4251,35 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
 #endif
                     notifyAll(); // Notify threads blocked in close(false)
                 }
+                else if(streamed)
+                {
+                    queueStreamCredit(requestId, true, streamAbortFlag, 0);
+                }
+
+                break;
+            }
 
+            case streamChunkMsg:
+            case streamCreditMsg:
+            {
+                traceRecv(stream, _logger, _traceLevels);
+                parseStreamMessage(stream, messageType);
                 break;
             }
 
             case validateConnectionMsg:
             {
                 traceRecv(stream, _logger, _traceLevels);
-                if(_heartbeatCallback)
+                if(compress & (fragmentSupportFlag | streamSupportFlag))
+                {
+                    //
+                    // The peer accepts the fragments requested by our validate
+                    // connection message or streams, this isn't a heartbeat.
+                    //
+                    _peerFragments = (compress & fragmentSupportFlag) && !_endpoint->datagram();
+                    _peerStreams = (compress & streamSupportFlag) && !_endpoint->datagram();
+                }
+                else if(_heartbeatCallback)
                 {
                     heartbeatCallback = _heartbeatCallback;
                     ++dispatchCount;
@@ -11,6 +11,7 @@
 #define ICE_CONNECTION_I_H
 
 #include <IceUtil/Mutex.h>
+#include <IceUtil/Atomic.h>
 #include <IceUtil/Monitor.h>
 #include <IceUtil/Time.h>
 #include <IceUtil/StopWatch.h>
@@ -40,14 +41,18 @@
 #include <Ice/ACM.h>
 #include <Ice/OutputStream.h>
 #include <Ice/InputStream.h>
+#include <Ice/Compressor.h>
+#include <Ice/StreamReaderF.h>
+#include <Ice/RequestTable.h>
 
 #include <deque>
 
-#if !defined(ICE_OS_UWP)
-#    ifndef ICE_HAS_BZIP2
-#        define ICE_HAS_BZIP2
-#    endif
-#endif
+namespace IceInternal
+{
+
+class ConnectionObserverI;
+
+}
 
 namespace Ice
 {
@@ -74,11 +79,21 @@ class ConnectionI : public Connection,
         void finishWrite(const IceInternal::Buffer&);
 
         void attach(const Ice::Instrumentation::ConnectionObserverPtr&);
+        void detach();
+
+        void queuedBytes(Ice::Int);
 
     private:
 
         Ice::Byte* _readStreamPos;
         Ice::Byte* _writeStreamPos;
+
+        //
+        // The queued bytes are only reported to the metrics observer,
+        // they are moved to the new observer when it's replaced.
+        //
+        IceInternal::ConnectionObserverI* _metricsObserver;
+        Ice::Int _queuedBytes;
     };
 
 public:
@@ -93,7 +108,8 @@ public:
     struct OutgoingMessage
     {
         OutgoingMessage(Ice::OutputStream* str, bool comp) :
-            stream(str), compress(comp), requestId(0), adopted(false)
+            stream(str), compress(comp), requestId(0), adopted(false), priority(0), fragment(false), fragmentId(0),
+            fragmentOffset(0), slice(false), queued(0)
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
             , isSent(false), invokeSent(false), receivedReply(false)
 #endif
@@ -102,7 +118,8 @@ public:
 
         OutgoingMessage(const IceInternal::OutgoingAsyncBasePtr& o, Ice::OutputStream* str,
                         bool comp, int rid) :
-            stream(str), outAsync(o), compress(comp), requestId(rid), adopted(false)
+            stream(str), outAsync(o), compress(comp), requestId(rid), adopted(false), priority(0), fragment(false),
+            fragmentId(0), fragmentOffset(0), slice(false), queued(0)
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
             , isSent(false), invokeSent(false), receivedReply(false)
 #endif
@@ -119,6 +136,12 @@ public:
         bool compress;
         int requestId;
         bool adopted;
+        int priority;
+        bool fragment;
+        Ice::Int fragmentId; // The ID of a fragmented message whose last fragment isn't cut yet.
+        size_t fragmentOffset; // The offset of the bytes of a fragmented message which aren't cut yet.
+        bool slice; // A slice of a fragmented message, it must follow its fragment header.
+        size_t queued; // The size accounted for in the send queue size.
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
         bool isSent;
         bool invokeSent;
@@ -160,8 +183,11 @@ public:
     virtual void close(ConnectionClose); // From Connection.
 
     bool isActiveOrHolding() const;
+    bool isInitializing() const;
     bool isFinished() const;
 
+    size_t getOutstandingBytes() const;
+
     virtual void throwException() const; // From Connection. Throws the connection exception if destroyed.
 
     void waitUntilHolding() const;
@@ -171,7 +197,8 @@ public:
 
     void monitor(const IceUtil::Time&, const IceInternal::ACMConfig&);
 
-    IceInternal::AsyncStatus sendAsyncRequest(const IceInternal::OutgoingAsyncBasePtr&, bool, bool, int);
+    IceInternal::AsyncStatus sendAsyncRequest(const IceInternal::OutgoingAsyncBasePtr&, bool, bool, int, int);
+    void checkSendQueue(int, bool);
 
     IceInternal::BatchRequestQueuePtr getBatchRequestQueue() const;
 
@@ -259,6 +286,17 @@ public:
 
     void closeCallback(const ICE_CLOSE_CALLBACK&);
 
+    //
+    // Streamed sequences: the reader of a received stream grants credits
+    // to the sender and closes the stream once the application no longer
+    // reads it, pumpStream() sends the chunks of a stream for the credits
+    // granted by the peer. It runs on a dedicated thread for each stream.
+    //
+    void sendStreamCredit(Int, bool, Int);
+    void closeStream(Int, bool);
+    void abortStream(Int, bool);
+    void pumpStream(Int, bool);
+
     virtual ~ConnectionI();
 
 private:
@@ -292,18 +330,33 @@ private:
 
     void initiateShutdown();
     void sendHeartbeatNow();
+    void sendSupportFlags();
 
     bool initialize(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
     bool validate(IceInternal::SocketOperation = IceInternal::SocketOperationNone);
     IceInternal::SocketOperation sendNextMessage(std::vector<OutgoingMessage>&);
     IceInternal::AsyncStatus sendMessage(OutgoingMessage&);
+    IceInternal::AsyncStatus sendFragments(OutgoingMessage&);
+    void cutFragment(std::deque<OutgoingMessage>::iterator);
+    std::deque<OutgoingMessage>::iterator findSendPosition(int, bool);
+    void queued(OutgoingMessage&);
+    void dequeued(const OutgoingMessage&);
+    void prepareMessage(OutgoingMessage&);
+    bool addFragment(Ice::InputStream&);
+    void queueStreamChunk(Int, bool, Byte, const std::vector<Byte>&, int);
+    void queueStreamCredit(Int, bool, Byte, Int);
+    void addOutStream(Int, bool, const Ice::ByteSourcePtr&, int);
+    void abortOutStream(Int);
+    void addInStream(Ice::InputStream&, Int, bool);
+    void rejectInStream(Int, bool);
+    void parseStreamMessage(Ice::InputStream&, Byte);
 
 #ifdef ICE_HAS_BZIP2
     void doCompress(Ice::OutputStream&, Ice::OutputStream&);
-    void doUncompress(Ice::InputStream&, Ice::InputStream&);
+    void doUncompress(Ice::InputStream&, Ice::InputStream&, Ice::Byte);
 #endif
 
-    IceInternal::SocketOperation parseMessage(Ice::InputStream&, Int&, Int&, Byte&,
+    IceInternal::SocketOperation parseMessage(Ice::InputStream&, Int&, Int&, Byte&, bool&,
                                               IceInternal::ServantManagerPtr&, ObjectAdapterPtr&,
                                               IceInternal::OutgoingAsyncBasePtr&, ICE_HEARTBEAT_CALLBACK&, int&);
 
@@ -318,6 +371,9 @@ private:
 
     IceInternal::SocketOperation read(IceInternal::Buffer&);
     IceInternal::SocketOperation write(IceInternal::Buffer&);
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+    IceInternal::SocketOperation gatherWrite();
+#endif
 
     void reap();
 
@@ -361,11 +417,16 @@ private:
     IceUtil::Time _acmLastActivity;
 
     const int _compressionLevel;
+    const size_t _compressionMinSize;
 
-    Int _nextRequestId;
+    //
+    // The compressor of the codec negotiated with the peer, bzip2 is
+    // used if no codec was negotiated.
+    //
+    IceInternal::CompressorPtr _compressor;
+    IceInternal::CompressorPtr _bzip2Compressor;
 
-    std::map<Int, IceInternal::OutgoingAsyncBasePtr> _asyncRequests;
-    std::map<Int, IceInternal::OutgoingAsyncBasePtr>::iterator _asyncRequestsHint;
+    IceInternal::RequestTable _asyncRequests;
 
     IceInternal::UniquePtr<LocalException> _exception;
 
@@ -374,9 +435,61 @@ private:
 
     std::deque<OutgoingMessage> _sendStreams;
 
+    //
+    // The size of the messages in _sendStreams. New invocations block or
+    // fail while it's above Ice.Connection.SendQueueMax, depending on
+    // Ice.Connection.SendQueuePolicy. Asynchronous invocations and thread
+    // pool threads never block.
+    //
+    const size_t _sendQueueMax;
+    const bool _sendQueueThrow;
+    size_t _sendQueueSize;
+    int _sendQueueWaiters;
+
+    //
+    // The size of the messages in _sendStreams which aren't requests
+    // waiting for a reply, see getOutstandingBytes.
+    //
+    IceUtilInternal::Atomic _outstandingMessageBytes;
+
+    //
+    // Messages larger than the fragment size are sent as fragments if the
+    // peer supports them. The fragments received from the peer are
+    // reassembled in _fragments until the fragmented message is complete,
+    // at most _fragmentedMessagesMax messages are reassembled at a time.
+    //
+    const size_t _fragmentSize;
+    const size_t _fragmentedMessagesMax;
+    bool _peerFragments;
+    bool _sendSupportFlags;
+    Int _nextFragmentId;
+    std::map<Int, std::vector<Byte> > _fragments;
+
+    //
+    // The streamed sequences sent and received with stream chunk
+    // messages if the peer supports streams. A stream is identified by
+    // the ID of its request and whether it's sent with the reply.
+    //
+    struct OutStream
+    {
+        Ice::ByteSourcePtr source;
+        Int credit;
+        int priority;
+    };
+    typedef std::pair<Int, bool> StreamKey;
+
+    const Int _streamChunkSize;
+    const Int _streamWindowSize;
+    bool _peerStreams;
+    std::map<StreamKey, OutStream> _outStreams;
+    std::map<StreamKey, IceInternal::StreamReaderPtr> _inStreams;
+
     Ice::InputStream _readStream;
     bool _readHeader;
     Ice::OutputStream _writeStream;
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+    std::vector<IceInternal::Buffer*> _gatherBuffers;
+#endif
 
     Observer _observer;
 
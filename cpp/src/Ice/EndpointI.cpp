@@ -96,6 +96,12 @@ IceInternal::EndpointI::initWithOptions(vector<string>& args)
     args = unknown;
 }
 
+Ice::Int
+IceInternal::EndpointI::reusePort() const
+{
+    return 0;
+}
+
 bool
 IceInternal::EndpointI::checkOption(const string&, const string&, const string&)
 {
@@ -127,6 +127,12 @@ public:
     //
     virtual AcceptorPtr acceptor(const std::string&) const = 0;
 
+    //
+    // Return the number of acceptors listening with SO_REUSEPORT on
+    // this endpoint, or 0 if SO_REUSEPORT isn't used.
+    //
+    virtual Ice::Int reusePort() const;
+
     //
     // Expand endpoint out in to separate endpoints for each local
     // host if listening on INADDR_ANY on server side.
@@ -19,6 +19,8 @@ namespace IceInternal
 class EndpointI;
 class TcpEndpointI;
 class UdpEndpointI;
+class UnixEndpointI;
+class ShmEndpoint;
 class WSEndpoint;
 class EndpointI_connectors;
 
@@ -27,6 +29,8 @@ class EndpointI_connectors;
 using EndpointIPtr = ::std::shared_ptr<EndpointI>;
 using TcpEndpointIPtr = ::std::shared_ptr<TcpEndpointI>;
 using UdpEndpointIPtr = ::std::shared_ptr<UdpEndpointI>;
+using UnixEndpointIPtr = ::std::shared_ptr<UnixEndpointI>;
+using ShmEndpointPtr = ::std::shared_ptr<ShmEndpoint>;
 using WSEndpointPtr = ::std::shared_ptr<WSEndpoint>;
 using EndpointI_connectorsPtr = ::std::shared_ptr<EndpointI_connectors>;
 
@@ -41,6 +45,12 @@ typedef Handle<TcpEndpointI> TcpEndpointIPtr;
 ICE_API IceUtil::Shared* upCast(UdpEndpointI*);
 typedef Handle<UdpEndpointI> UdpEndpointIPtr;
 
+ICE_API IceUtil::Shared* upCast(UnixEndpointI*);
+typedef Handle<UnixEndpointI> UnixEndpointIPtr;
+
+ICE_API IceUtil::Shared* upCast(ShmEndpoint*);
+typedef Handle<ShmEndpoint> ShmEndpointPtr;
+
 ICE_API IceUtil::Shared* upCast(WSEndpoint*);
 typedef Handle<WSEndpoint> WSEndpointPtr;
 
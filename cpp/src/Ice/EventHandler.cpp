@@ -26,6 +26,7 @@ IceInternal::EventHandler::EventHandler() :
     _finish(false),
 #else
     _disabled(SocketOperationNone),
+    _pollRequest(0),
 #endif
     _ready(SocketOperationNone),
     _registered(SocketOperationNone)
@@ -69,6 +69,7 @@ protected:
     bool _finish;
 #else
     SocketOperation _disabled;
+    IceUtil::Int64 _pollRequest; // The pending poll request of the io_uring selector or 0
 #endif
     SocketOperation _ready;
     SocketOperation _registered;
@@ -519,6 +519,13 @@ Ice::InvocationCanceledException::ice_print(ostream& out) const
     out << ":\ninvocation canceled";
 }
 
+void
+Ice::SendQueueFullException::ice_print(ostream& out) const
+{
+    Exception::ice_print(out);
+    out << ":\nconnection send queue is full";
+}
+
 void
 Ice::ProtocolException::ice_print(ostream& out) const
 {
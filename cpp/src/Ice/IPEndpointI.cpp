@@ -489,26 +489,52 @@ IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance, Input
 #ifndef ICE_OS_UWP
 
 IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& instance) :
-    IceUtil::Thread("Ice.HostResolver"),
     _instance(instance),
     _protocol(instance->protocolSupport()),
     _preferIPv6(instance->preferIPv6()),
+    _parallelConnect(instance->parallelConnect()),
+    _cacheTTL(IceUtil::Time::seconds(
+                  instance->initializationData().properties->getPropertyAsInt("Ice.HostResolver.CacheTTL"))),
+    _negativeCacheTTL(IceUtil::Time::seconds(
+                          instance->initializationData().properties->getPropertyAsInt(
+                              "Ice.HostResolver.NegativeCacheTTL"))),
     _destroyed(false)
 {
     __setNoDelete(true);
     try
     {
-        updateObserver();
-        bool hasPriority = _instance->initializationData().properties->getProperty("Ice.ThreadPriority") != "";
-        int priority = _instance->initializationData().properties->getPropertyAsInt("Ice.ThreadPriority");
-        if(hasPriority)
+        PropertiesPtr properties = _instance->initializationData().properties;
+        int size = properties->getPropertyAsIntWithDefault("Ice.HostResolver.Threads", 1);
+        if(size < 1)
         {
-            start(0, priority);
+            Warning out(_instance->initializationData().logger);
+            out << "Ice.HostResolver.Threads < 1; Size adjusted to 1";
+            size = 1;
         }
-        else
+
+        bool hasPriority = properties->getProperty("Ice.ThreadPriority") != "";
+        int priority = properties->getPropertyAsInt("Ice.ThreadPriority");
+        for(int i = 0; i < size; ++i)
         {
-            start();
+            ostringstream name;
+            name << "Ice.HostResolver";
+            if(size > 1)
+            {
+                name << '-' << i;
+            }
+
+            HelperThreadPtr thread = new HelperThread(this, name.str());
+            if(hasPriority)
+            {
+                thread->start(0, priority);
+            }
+            else
+            {
+                thread->start();
+            }
+            _threads.push_back(thread);
         }
+        updateObserver();
     }
     catch(const IceUtil::Exception& ex)
     {
@@ -516,6 +542,9 @@ IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& insta
             Ice::Error out(_instance->initializationData().logger);
             out << "cannot create thread for enpoint host resolver:\n" << ex;
         }
+        destroy();
+        joinWithAllThreads();
+        __setNoDelete(false);
         throw;
     }
     __setNoDelete(false);
@@ -526,8 +555,8 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
                                            const IPEndpointIPtr& endpoint, const EndpointI_connectorsPtr& callback)
 {
     //
-    // Try to get the addresses without DNS lookup. If this doesn't work, we queue a resolve
-    // entry and the thread will take care of getting the endpoint addresses.
+    // Try to get the addresses without DNS lookup or from the cache. If this doesn't work, we queue a resolve
+    // entry and a resolver thread will take care of getting the endpoint addresses.
     //
     NetworkProxyPtr networkProxy = _instance->networkProxy();
     if(!networkProxy)
@@ -537,9 +566,24 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
             vector<Address> addrs = getAddresses(host, port, _protocol, selType, _preferIPv6, false);
             if(!addrs.empty())
             {
+                if(_parallelConnect)
+                {
+                    interleaveAddresses(addrs);
+                }
                 callback->connectors(endpoint->connectors(addrs, 0));
                 return;
             }
+
+            bool cached;
+            {
+                Lock sync(*this);
+                cached = findCachedAddresses(HostKey(host, _protocol), addrs);
+            }
+            if(cached)
+            {
+                callback->connectors(endpoint->connectors(sortedAddresses(addrs, port, selType, _protocol), 0));
+                return;
+            }
         }
         catch(const Ice::LocalException& ex)
         {
@@ -578,11 +622,35 @@ IceInternal::EndpointHostResolver::destroy()
     Lock sync(*this);
     assert(!_destroyed);
     _destroyed = true;
-    notify();
+    notifyAll();
 }
 
 void
-IceInternal::EndpointHostResolver::run()
+IceInternal::EndpointHostResolver::joinWithAllThreads()
+{
+    //
+    // No mutex locking, this is only called on shutdown once the
+    // resolver is destroyed.
+    //
+    for(vector<HelperThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+    _threads.clear();
+}
+
+void
+IceInternal::EndpointHostResolver::updateObserver()
+{
+    Lock sync(*this);
+    for(vector<HelperThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->updateObserver();
+    }
+}
+
+void
+IceInternal::EndpointHostResolver::run(const HelperThreadPtr& thread)
 {
     while(true)
     {
@@ -602,7 +670,7 @@ IceInternal::EndpointHostResolver::run()
 
             r = _queue.front();
             _queue.pop_front();
-            threadObserver = _observer.get();
+            threadObserver = thread->_observer.get();
         }
 
         if(threadObserver)
@@ -610,6 +678,8 @@ IceInternal::EndpointHostResolver::run()
             threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateIdle), ICE_ENUM(ThreadState, ThreadStateInUseForOther));
         }
 
+        vector<ResolveEntry> entries;
+        entries.push_back(r);
         try
         {
             NetworkProxyPtr networkProxy = _instance->networkProxy();
@@ -623,37 +693,95 @@ IceInternal::EndpointHostResolver::run()
                 }
             }
 
-            vector<Address> addresses = getAddresses(r.host, r.port, protocol, r.selType, _preferIPv6, true);
-            if(r.observer)
+            //
+            // If another thread is already looking up the host, the entry
+            // waits for the result of this lookup.
+            //
+            const HostKey key(r.host, protocol);
+            vector<Address> addresses;
+            bool lookup = false;
             {
-                r.observer->detach();
-                r.observer = 0;
+                Lock sync(*this);
+                if(!findCachedAddresses(key, addresses))
+                {
+                    map<HostKey, vector<ResolveEntry> >::iterator p = _lookups.find(key);
+                    if(p != _lookups.end())
+                    {
+                        p->second.push_back(r);
+                        entries.clear();
+                    }
+                    else
+                    {
+                        _lookups.insert(make_pair(key, vector<ResolveEntry>()));
+                        lookup = true;
+                    }
+                }
             }
 
-            r.callback->connectors(r.endpoint->connectors(addresses, networkProxy));
-
-            if(threadObserver)
+            if(lookup)
             {
-                threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateInUseForOther), ICE_ENUM(ThreadState, ThreadStateIdle));
+                try
+                {
+                    addresses = getAddresses(r.host, 0, protocol, Ice::ICE_ENUM(EndpointSelectionType, Ordered),
+                                             _preferIPv6, true);
+                }
+                catch(const Ice::LocalException& ex)
+                {
+                    const Ice::DNSException* dnsEx = dynamic_cast<const Ice::DNSException*>(&ex);
+                    Lock sync(*this);
+                    if(dnsEx)
+                    {
+                        cacheAddresses(key, vector<Address>(), dnsEx->error);
+                    }
+                    map<HostKey, vector<ResolveEntry> >::iterator p = _lookups.find(key);
+                    entries.insert(entries.end(), p->second.begin(), p->second.end());
+                    _lookups.erase(p);
+                    throw;
+                }
+
+                Lock sync(*this);
+                cacheAddresses(key, addresses, 0);
+                map<HostKey, vector<ResolveEntry> >::iterator p = _lookups.find(key);
+                entries.insert(entries.end(), p->second.begin(), p->second.end());
+                _lookups.erase(p);
             }
 
+            for(vector<ResolveEntry>::const_iterator p = entries.begin(); p != entries.end(); ++p)
+            {
+                if(p->observer)
+                {
+                    p->observer->detach();
+                }
+                p->callback->connectors(p->endpoint->connectors(sortedAddresses(addresses, p->port, p->selType,
+                                                                                protocol),
+                                                                networkProxy));
+            }
         }
         catch(const Ice::LocalException& ex)
         {
-            if(threadObserver)
+            for(vector<ResolveEntry>::const_iterator p = entries.begin(); p != entries.end(); ++p)
             {
-                threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateInUseForOther), ICE_ENUM(ThreadState, ThreadStateIdle));
-            }
-            if(r.observer)
-            {
-                r.observer->failed(ex.ice_id());
-                r.observer->detach();
+                if(p->observer)
+                {
+                    p->observer->failed(ex.ice_id());
+                    p->observer->detach();
+                }
+                p->callback->exception(ex);
             }
-            r.callback->exception(ex);
+        }
+
+        if(threadObserver)
+        {
+            threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateInUseForOther), ICE_ENUM(ThreadState, ThreadStateIdle));
         }
     }
 
-    for(deque<ResolveEntry>::const_iterator p = _queue.begin(); p != _queue.end(); ++p)
+    deque<ResolveEntry> queue;
+    {
+        Lock sync(*this);
+        queue.swap(_queue);
+    }
+    for(deque<ResolveEntry>::const_iterator p = queue.begin(); p != queue.end(); ++p)
     {
         Ice::CommunicatorDestroyedException ex(__FILE__, __LINE__);
         if(p->observer)
@@ -663,22 +791,115 @@ IceInternal::EndpointHostResolver::run()
         }
         p->callback->exception(ex);
     }
-    _queue.clear();
 
-    if(_observer)
+    if(thread->_observer)
+    {
+        thread->_observer.detach();
+    }
+}
+
+vector<Address>
+IceInternal::EndpointHostResolver::sortedAddresses(const vector<Address>& addrs, int port,
+                                                   Ice::EndpointSelectionType selType, ProtocolSupport protocol) const
+{
+    vector<Address> result = addrs;
+    for(vector<Address>::iterator p = result.begin(); p != result.end(); ++p)
+    {
+        setPort(*p, port);
+    }
+    sortAddresses(result, protocol, selType, _preferIPv6);
+    if(_parallelConnect)
+    {
+        interleaveAddresses(result);
+    }
+    return result;
+}
+
+bool
+IceInternal::EndpointHostResolver::findCachedAddresses(const HostKey& key, vector<Address>& addrs)
+{
+    // Must be called with the mutex locked.
+
+    map<HostKey, CacheEntry>::iterator p = _cache.find(key);
+    if(p == _cache.end())
+    {
+        return false;
+    }
+
+    if(p->second.expiration <= IceUtil::Time::now(IceUtil::Time::Monotonic))
     {
-        _observer.detach();
+        _cache.erase(p);
+        return false;
+    }
+
+    if(p->second.addresses.empty())
+    {
+        Ice::DNSException ex(__FILE__, __LINE__);
+        ex.error = p->second.error;
+        ex.host = key.first;
+        throw ex;
     }
+    addrs = p->second.addresses;
+    return true;
 }
 
 void
-IceInternal::EndpointHostResolver::updateObserver()
+IceInternal::EndpointHostResolver::cacheAddresses(const HostKey& key, const vector<Address>& addrs, Ice::Int error)
 {
-    Lock sync(*this);
-    const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
+    // Must be called with the mutex locked.
+
+    const IceUtil::Time ttl = addrs.empty() ? _negativeCacheTTL : _cacheTTL;
+    if(ttl <= IceUtil::Time())
+    {
+        return;
+    }
+
+    //
+    // Remove the expired entries, the cache only grows with the number
+    // of hosts looked up within the TTL.
+    //
+    const IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(map<HostKey, CacheEntry>::iterator p = _cache.begin(); p != _cache.end();)
+    {
+        if(p->second.expiration <= now)
+        {
+            _cache.erase(p++);
+        }
+        else
+        {
+            ++p;
+        }
+    }
+
+    CacheEntry& entry = _cache[key];
+    entry.addresses = addrs;
+    entry.error = error;
+    entry.expiration = now + ttl;
+}
+
+IceInternal::EndpointHostResolver::HelperThread::HelperThread(const EndpointHostResolverPtr& resolver,
+                                                              const string& name) :
+    IceUtil::Thread(name),
+    _resolver(resolver)
+{
+}
+
+void
+IceInternal::EndpointHostResolver::HelperThread::run()
+{
+    _resolver->run(this);
+}
+
+void
+IceInternal::EndpointHostResolver::HelperThread::updateObserver()
+{
+    // Must be called with the resolver mutex locked.
+
+    const CommunicatorObserverPtr& obsv = _resolver->_instance->initializationData().observer;
     if(obsv)
     {
-        _observer.attach(obsv->getThreadObserver("Communicator", name(), ICE_ENUM(ThreadState, ThreadStateIdle), _observer.get()));
+        _observer.attach(obsv->getThreadObserver("Communicator", name(), ICE_ENUM(ThreadState, ThreadStateIdle),
+                                                 _observer.get()));
     }
 }
 
@@ -714,7 +935,7 @@ IceInternal::EndpointHostResolver::destroy()
 }
 
 void
-IceInternal::EndpointHostResolver::run()
+IceInternal::EndpointHostResolver::joinWithAllThreads()
 {
 }
 
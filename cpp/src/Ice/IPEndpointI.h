@@ -22,6 +22,7 @@
 
 #ifndef ICE_OS_UWP
 #   include <deque>
+#   include <map>
 #endif
 
 namespace IceInternal
@@ -109,7 +110,7 @@ private:
 };
 
 #ifndef ICE_OS_UWP
-class ICE_API EndpointHostResolver : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+class ICE_API EndpointHostResolver : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 #else
 class ICE_API EndpointHostResolver : public IceUtil::Shared
 #endif
@@ -121,13 +122,32 @@ public:
     void resolve(const std::string&, int, Ice::EndpointSelectionType, const IPEndpointIPtr&,
                  const EndpointI_connectorsPtr&);
     void destroy();
+    void joinWithAllThreads();
 
-    virtual void run();
     void updateObserver();
 
 private:
 
 #ifndef ICE_OS_UWP
+    class HelperThread : public IceUtil::Thread
+    {
+    public:
+
+        HelperThread(const EndpointHostResolverPtr&, const std::string&);
+        virtual void run();
+
+        void updateObserver();
+
+    private:
+
+        friend class EndpointHostResolver;
+
+        const EndpointHostResolverPtr _resolver;
+        ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+    };
+    typedef IceUtil::Handle<HelperThread> HelperThreadPtr;
+    friend class HelperThread;
+
     struct ResolveEntry
     {
         std::string host;
@@ -138,12 +158,41 @@ private:
         Ice::Instrumentation::ObserverPtr observer;
     };
 
+    //
+    // The addresses of a host, sorted with the Ordered endpoint
+    // selection and without port. The addresses of a failed lookup are
+    // empty.
+    //
+    struct CacheEntry
+    {
+        std::vector<Address> addresses;
+        Ice::Int error;
+        IceUtil::Time expiration;
+    };
+    typedef std::pair<std::string, ProtocolSupport> HostKey;
+
+    void run(const HelperThreadPtr&);
+    std::vector<Address> sortedAddresses(const std::vector<Address>&, int, Ice::EndpointSelectionType,
+                                         ProtocolSupport) const;
+    bool findCachedAddresses(const HostKey&, std::vector<Address>&);
+    void cacheAddresses(const HostKey&, const std::vector<Address>&, Ice::Int);
+
     const InstancePtr _instance;
     const IceInternal::ProtocolSupport _protocol;
     const bool _preferIPv6;
+    const bool _parallelConnect;
+    const IceUtil::Time _cacheTTL;
+    const IceUtil::Time _negativeCacheTTL;
     bool _destroyed;
     std::deque<ResolveEntry> _queue;
-    ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+    std::vector<HelperThreadPtr> _threads;
+
+    //
+    // The lookups in progress, with the entries waiting for the result
+    // of each lookup.
+    //
+    std::map<HostKey, std::vector<ResolveEntry> > _lookups;
+    std::map<HostKey, CacheEntry> _cache;
 #else
     const InstancePtr _instance;
 #endif
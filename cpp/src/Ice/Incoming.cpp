@@ -562,7 +562,8 @@ IceInternal::IncomingBase::handleException(const string& msg, bool amd)
 IceInternal::Incoming::Incoming(Instance* instance, ResponseHandler* responseHandler, Ice::Connection* connection,
                                 const ObjectAdapterPtr& adapter, bool response, Byte compress, Int requestId) :
     IncomingBase(instance, responseHandler, connection, adapter, response, compress, requestId),
-    _inParamPos(0)
+    _inParamPos(0),
+    _directParams(0)
 {
 }
 
@@ -607,10 +608,47 @@ IceInternal::Incoming::startOver()
         _os.clear();
         _os.b.clear();
 
+        //
+        // Also reset the sequence size checks, the parameters are
+        // read again.
+        //
+        _is->clear();
         _is->i = _inParamPos;
     }
 }
 
+void
+IceInternal::Incoming::setDirectParams(DirectParams* params)
+{
+    //
+    // The request doesn't include the parameters encapsulation, the
+    // response is encoded with the encoding of the invocation.
+    //
+    _directParams = params;
+    _current.encoding = params->_encoding;
+}
+
+void
+IceInternal::Incoming::readDirectParams()
+{
+    //
+    // The dispatch needs the encoded parameters (blobject, AMD servant,
+    // ...): marshal them as the proxy would have.
+    //
+    OutputStream os(_is->instance(), currentProtocolEncoding);
+    os.startEncapsulation(_directParams->_encoding, ICE_ENUM(FormatType, DefaultFormat));
+    _directParams->write(&os);
+    os.endEncapsulation();
+    _directParams = 0;
+
+    _directStream.reset(new InputStream(os.instance(), currentProtocolEncoding, os, true));
+    _is = _directStream.get();
+    if(_inParamPos != 0)
+    {
+        _inParamPos = _is->i;
+    }
+}
+
 void
 IceInternal::Incoming::invoke(const ServantManagerPtr& servantManager, InputStream* stream)
 {
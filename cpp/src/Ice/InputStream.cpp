@@ -24,6 +24,7 @@
 #include <Ice/LoggerUtil.h>
 #include <Ice/SlicedData.h>
 #include <Ice/StringConverter.h>
+#include <Ice/StreamReader.h>
 #include <iterator>
 
 #ifndef ICE_UNALIGNED
@@ -168,6 +169,8 @@ Ice::InputStream::initialize(Instance* instance, const EncodingVersion& encoding
 #endif
     _traceSlicing = _instance->traceLevels()->slicing > 0;
     _classGraphDepthMax = _instance->classGraphDepthMax();
+
+    b.setPool(_instance->bufferPool());
 }
 
 void
@@ -197,6 +200,8 @@ Ice::InputStream::clear()
         delete oldEncaps;
     }
 
+    _streamedSource = 0;
+
     _startSeq = -1;
     _sliceValues = true;
 }
@@ -283,6 +288,7 @@ Ice::InputStream::swap(InputStream& other)
     std::swap(_traceSlicing, other._traceSlicing);
     std::swap(_classGraphDepthMax, other._classGraphDepthMax);
     std::swap(_closure, other._closure);
+    std::swap(_streamedSource, other._streamedSource);
     std::swap(_sliceValues, other._sliceValues);
 
     //
@@ -463,6 +469,28 @@ Ice::InputStream::read(pair<const Byte*, const Byte*>& v)
     }
 }
 
+void
+Ice::InputStream::read(ByteSourcePtr& v)
+{
+    pair<const Byte*, const Byte*> p;
+    read(p);
+    if(_streamedSource)
+    {
+        v = _streamedSource;
+        _streamedSource = 0;
+    }
+    else
+    {
+        v = ICE_MAKE_SHARED(MemoryByteSource, p.first, p.second);
+    }
+}
+
+void
+Ice::InputStream::setStreamedSource(const ByteSourcePtr& source)
+{
+    _streamedSource = source;
+}
+
 void
 Ice::InputStream::read(vector<bool>& v)
 {
@@ -29,8 +29,12 @@
 #include <Ice/EndpointFactoryManager.h>
 #include <Ice/IPEndpointI.h> // For EndpointHostResolver
 #include <Ice/WSEndpoint.h>
+#include <Ice/ShmEndpoint.h>
 #include <Ice/RequestHandlerFactory.h>
 #include <Ice/RetryQueue.h>
+#include <Ice/StreamThreadPool.h>
+#include <Ice/BufferPool.h>
+#include <Ice/Compressor.h>
 #include <Ice/DynamicLibrary.h>
 #include <Ice/PluginManagerI.h>
 #include <Ice/Initialize.h>
@@ -52,6 +56,7 @@
 #include <IceUtil/Mutex.h>
 #include <IceUtil/MutexPtrLock.h>
 #include <IceUtil/Atomic.h>
+#include <IceUtil/TimerWheel.h>
 
 #include <stdio.h>
 #include <list>
@@ -190,29 +195,22 @@ private:
 
 
 //
-// Timer specialization which supports the thread observer
+// The thread observer of the timer threads
 //
-class Timer : public IceUtil::Timer
+class TimerObserver : public IceUtil::Shared
 {
 public:
 
-    Timer(int priority) :
-        IceUtil::Timer(priority),
-        _hasObserver(0)
-    {
-    }
-
-    Timer() :
+    TimerObserver() :
         _hasObserver(0)
     {
     }
 
     void updateObserver(const Ice::Instrumentation::CommunicatorObserverPtr&);
+    void runTimerTask(const IceUtil::TimerTaskPtr&);
 
 private:
 
-    virtual void runTimerTask(const IceUtil::TimerTaskPtr&);
-
     IceUtil::Mutex _mutex;
     //
     // TODO: Replace by std::atomic<bool> when it becomes widely
@@ -222,10 +220,66 @@ private:
     ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
 };
 
+//
+// Timer specializations which support the thread observer
+//
+class Timer : public IceUtil::Timer
+{
+public:
+
+    Timer(const TimerObserverPtr& observer, int priority) :
+        IceUtil::Timer(priority),
+        _observer(observer)
+    {
+    }
+
+    Timer(const TimerObserverPtr& observer) :
+        _observer(observer)
+    {
+    }
+
+private:
+
+    virtual void
+    runTimerTask(const IceUtil::TimerTaskPtr& task)
+    {
+        _observer->runTimerTask(task);
+    }
+
+    const TimerObserverPtr _observer;
+};
+
+class TimerWheel : public IceUtil::TimerWheel
+{
+public:
+
+    TimerWheel(const TimerObserverPtr& observer, const IceUtil::Time& tick, int threadCount, int priority) :
+        IceUtil::TimerWheel(tick, threadCount, priority),
+        _observer(observer)
+    {
+    }
+
+    TimerWheel(const TimerObserverPtr& observer, const IceUtil::Time& tick, int threadCount) :
+        IceUtil::TimerWheel(tick, threadCount),
+        _observer(observer)
+    {
+    }
+
+private:
+
+    virtual void
+    runTimerTask(const IceUtil::TimerTaskPtr& task)
+    {
+        _observer->runTimerTask(task);
+    }
+
+    const TimerObserverPtr _observer;
+};
+
 }
 
 void
-Timer::updateObserver(const Ice::Instrumentation::CommunicatorObserverPtr& obsv)
+TimerObserver::updateObserver(const Ice::Instrumentation::CommunicatorObserverPtr& obsv)
 {
     IceUtil::Mutex::Lock sync(_mutex);
     assert(obsv);
@@ -237,7 +291,7 @@ Timer::updateObserver(const Ice::Instrumentation::CommunicatorObserverPtr& obsv)
 }
 
 void
-Timer::runTimerTask(const IceUtil::TimerTaskPtr& task)
+TimerObserver::runTimerTask(const IceUtil::TimerTaskPtr& task)
 {
     if(_hasObserver != 0)
     {
@@ -426,6 +480,18 @@ IceInternal::Instance::preferIPv6() const
     return _preferIPv6;
 }
 
+bool
+IceInternal::Instance::parallelConnect() const
+{
+    return _parallelConnect;
+}
+
+int
+IceInternal::Instance::parallelConnectDelay() const
+{
+    return _parallelConnectDelay;
+}
+
 NetworkProxyPtr
 IceInternal::Instance::networkProxy() const
 {
@@ -497,6 +563,20 @@ IceInternal::Instance::retryQueue()
     return _retryQueue;
 }
 
+StreamThreadPoolPtr
+IceInternal::Instance::streamThreadPool()
+{
+    Lock sync(*this);
+
+    if(_state == StateDestroyed)
+    {
+        throw CommunicatorDestroyedException(__FILE__, __LINE__);
+    }
+
+    assert(_streamThreadPool);
+    return _streamThreadPool;
+}
+
 IceUtil::TimerPtr
 IceInternal::Instance::timer()
 {
@@ -951,6 +1031,9 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
     _classGraphDepthMax(0),
     _collectObjects(false),
     _toStringMode(ICE_ENUM(ToStringMode, Unicode)),
+    _compressionCodec(CompressionCodecBZip2),
+    _sendQueueMax(0),
+    _sendQueueThrow(false),
     _implicitContext(0),
     _stringConverter(Ice::getProcessStringConverter()),
     _wstringConverter(Ice::getProcessWstringConverter()),
@@ -1205,6 +1288,53 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
 
         const_cast<bool&>(_collectObjects) = _initData.properties->getPropertyAsInt("Ice.CollectObjects") > 0;
 
+        {
+            Int num = _initData.properties->getPropertyAsInt("Ice.BufferPool.MaxBytes");
+            if(num > 0)
+            {
+                const_cast<BufferPoolPtr&>(_bufferPool) = new BufferPool(static_cast<size_t>(num));
+            }
+        }
+
+        {
+            string codec = _initData.properties->getPropertyWithDefault("Ice.Compression.Codec", "bzip2");
+            CompressionCodec c;
+            if(!stringToCompressionCodec(codec, c))
+            {
+                Warning out(_initData.logger);
+                out << "Ice.Compression.Codec: unknown codec `" << codec << "'; using bzip2";
+            }
+            else if(!createCompressor(c, 1))
+            {
+                Warning out(_initData.logger);
+                out << "Ice.Compression.Codec: " << codec << " is not supported by this build; using bzip2";
+            }
+            else
+            {
+                const_cast<CompressionCodec&>(_compressionCodec) = c;
+            }
+        }
+
+        {
+            Int num = _initData.properties->getPropertyAsInt("Ice.Connection.SendQueueMax");
+            if(num > 0)
+            {
+                // Property is in kilobytes, convert in bytes.
+                const_cast<size_t&>(_sendQueueMax) = static_cast<size_t>(min(num, 0x7fffffff / 1024)) * 1024;
+            }
+
+            string policy = _initData.properties->getPropertyWithDefault("Ice.Connection.SendQueuePolicy", "Block");
+            if(policy == "Throw")
+            {
+                const_cast<bool&>(_sendQueueThrow) = true;
+            }
+            else if(policy != "Block")
+            {
+                throw InitializationException(__FILE__, __LINE__,
+                                              "The value for Ice.Connection.SendQueuePolicy must be Block or Throw");
+            }
+        }
+
         string toStringModeStr = _initData.properties->getPropertyWithDefault("Ice.ToStringMode", "Unicode");
         if(toStringModeStr == "ASCII")
         {
@@ -1258,6 +1388,10 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
         }
         _preferIPv6 = _initData.properties->getPropertyAsInt("Ice.PreferIPv6Address") > 0;
 
+        _parallelConnect = _initData.properties->getPropertyAsInt("Ice.ParallelConnect") > 0;
+        _parallelConnectDelay = max(_initData.properties->getPropertyAsIntWithDefault("Ice.ParallelConnect.Delay", 250),
+                                    0);
+
         _networkProxy = IceInternal::createNetworkProxy(_initData.properties, _protocolSupport);
 
         _endpointFactoryManager = new EndpointFactoryManager(this);
@@ -1279,6 +1413,8 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
 
         _retryQueue = new RetryQueue(this);
 
+        _streamThreadPool = new StreamThreadPool(this);
+
         __setNoDelete(false);
     }
     catch(...)
@@ -1305,6 +1441,7 @@ IceInternal::Instance::~Instance()
     assert(!_serverThreadPool);
     assert(!_endpointHostResolver);
     assert(!_retryQueue);
+    assert(!_streamThreadPool);
     assert(!_timer);
     assert(!_routerManager);
     assert(!_locatorManager);
@@ -1362,6 +1499,18 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
         _endpointFactoryManager->add(new WSEndpointFactory(instance, sslFactory->clone(instance, 0)));
     }
 
+#ifdef ICE_USE_SHM_TRANSPORT
+    //
+    // Add the shm endpoint factory if the Unix domain socket factory is installed.
+    //
+    EndpointFactoryPtr unixFactory = _endpointFactoryManager->get(UnixEndpointType);
+    if(unixFactory)
+    {
+        ProtocolInstancePtr instance = new ProtocolInstance(communicator, ShmEndpointType, "shm", false);
+        _endpointFactoryManager->add(new ShmEndpointFactory(instance, unixFactory->clone(instance, 0)));
+    }
+#endif
+
     //
     // Reset _stringConverter and _wstringConverter, in case a plugin changed them
     //
@@ -1431,6 +1580,10 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
         {
             CommunicatorObserverIPtr observer = ICE_MAKE_SHARED(CommunicatorObserverI, _initData);
             _initData.observer = observer;
+            if(_bufferPool)
+            {
+                observer->setBufferPool(_bufferPool);
+            }
             _adminFacets.insert(make_pair(metricsFacetName, observer->getFacet()));
 
             //
@@ -1464,13 +1617,43 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
     {
         bool hasPriority = _initData.properties->getProperty("Ice.ThreadPriority") != "";
         int priority = _initData.properties->getPropertyAsInt("Ice.ThreadPriority");
-        if(hasPriority)
+        _timerObserver = new TimerObserver;
+        if(_initData.properties->getPropertyAsInt("Ice.TimerWheel") > 0)
+        {
+            //
+            // The timing wheel trades precision for O(1) scheduling, its
+            // tick defaults to 10ms.
+            //
+            int tick = _initData.properties->getPropertyAsIntWithDefault("Ice.TimerWheel.Tick", 10);
+            if(tick < 1)
+            {
+                Warning out(_initData.logger);
+                out << "Ice.TimerWheel.Tick < 1; Tick adjusted to 1";
+                tick = 1;
+            }
+            int threadCount = _initData.properties->getPropertyAsIntWithDefault("Ice.TimerWheel.Threads", 1);
+            if(threadCount < 1)
+            {
+                Warning out(_initData.logger);
+                out << "Ice.TimerWheel.Threads < 1; Threads adjusted to 1";
+                threadCount = 1;
+            }
+            if(hasPriority)
+            {
+                _timer = new TimerWheel(_timerObserver, IceUtil::Time::milliSeconds(tick), threadCount, priority);
+            }
+            else
+            {
+                _timer = new TimerWheel(_timerObserver, IceUtil::Time::milliSeconds(tick), threadCount);
+            }
+        }
+        else if(hasPriority)
         {
-            _timer = new Timer(priority);
+            _timer = new Timer(_timerObserver, priority);
         }
         else
         {
-            _timer = new Timer;
+            _timer = new Timer(_timerObserver);
         }
     }
     catch(const IceUtil::Exception& ex)
@@ -1623,6 +1806,11 @@ IceInternal::Instance::destroy()
         _retryQueue->destroy(); // Must be called before destroying thread pools.
     }
 
+    if(_streamThreadPool)
+    {
+        _streamThreadPool->destroy(); // Joins the threads of the streams, the connections are finished.
+    }
+
     if(_initData.observer)
     {
         CommunicatorObserverIPtr observer = ICE_DYNAMIC_CAST(CommunicatorObserverI, _initData.observer);
@@ -1678,7 +1866,7 @@ IceInternal::Instance::destroy()
 #ifndef ICE_OS_UWP
     if(_endpointHostResolver)
     {
-        _endpointHostResolver->getThreadControl().join();
+        _endpointHostResolver->joinWithAllThreads();
     }
 #endif
 
@@ -1729,11 +1917,13 @@ IceInternal::Instance::destroy()
         _objectAdapterFactory = 0;
         _outgoingConnectionFactory = 0;
         _retryQueue = 0;
+        _streamThreadPool = 0;
 
         _serverThreadPool = 0;
         _clientThreadPool = 0;
         _endpointHostResolver = 0;
         _timer = 0;
+        _timerObserver = 0;
 
         _referenceFactory = 0;
         _requestHandlerFactory = 0;
@@ -1786,9 +1976,9 @@ IceInternal::Instance::updateThreadObservers()
         {
             _endpointHostResolver->updateObserver();
         }
-        if(_timer)
+        if(_timerObserver)
         {
-            _timer->updateObserver(_initData.observer);
+            _timerObserver->updateObserver(_initData.observer);
         }
     }
     catch(const Ice::CommunicatorDestroyedException&)
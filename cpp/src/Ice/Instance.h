@@ -33,6 +33,9 @@
 #include <Ice/EndpointFactoryManagerF.h>
 #include <Ice/IPEndpointIF.h>
 #include <Ice/RetryQueueF.h>
+#include <Ice/StreamThreadPoolF.h>
+#include <Ice/BufferPoolF.h>
+#include <Ice/CompressorF.h>
 #include <Ice/DynamicLibraryF.h>
 #include <Ice/PluginF.h>
 #include <Ice/NetworkF.h>
@@ -53,8 +56,8 @@ class CommunicatorI;
 namespace IceInternal
 {
 
-class Timer;
-typedef IceUtil::Handle<Timer> TimerPtr;
+class TimerObserver;
+typedef IceUtil::Handle<TimerObserver> TimerObserverPtr;
 
 class MetricsAdminI;
 ICE_DEFINE_PTR(MetricsAdminIPtr, MetricsAdminI);
@@ -97,11 +100,14 @@ public:
     ObjectAdapterFactoryPtr objectAdapterFactory() const;
     ProtocolSupport protocolSupport() const;
     bool preferIPv6() const;
+    bool parallelConnect() const;
+    int parallelConnectDelay() const;
     NetworkProxyPtr networkProxy() const;
     ThreadPoolPtr clientThreadPool();
     ThreadPoolPtr serverThreadPool();
     EndpointHostResolverPtr endpointHostResolver();
     RetryQueuePtr retryQueue();
+    StreamThreadPoolPtr streamThreadPool();
     IceUtil::TimerPtr timer();
     EndpointFactoryManagerPtr endpointFactoryManager() const;
     DynamicLibraryListPtr dynamicLibraryList() const;
@@ -111,6 +117,10 @@ public:
     size_t classGraphDepthMax() const { return _classGraphDepthMax; }
     bool collectObjects() const { return _collectObjects; }
     Ice::ToStringMode toStringMode() const { return _toStringMode; }
+    BufferPool* bufferPool() const { return _bufferPool.get(); }
+    CompressionCodec compressionCodec() const { return _compressionCodec; }
+    size_t sendQueueMax() const { return _sendQueueMax; }
+    bool sendQueueThrow() const { return _sendQueueThrow; }
     const ACMConfig& clientACM() const;
     const ACMConfig& serverACM() const;
 
@@ -180,6 +190,10 @@ private:
     const size_t _classGraphDepthMax; // Immutable, not reset by destroy().
     const bool _collectObjects; // Immutable, not reset by destroy().
     const Ice::ToStringMode _toStringMode; // Immutable, not reset by destroy()
+    const BufferPoolPtr _bufferPool; // Immutable, not reset by destroy().
+    const CompressionCodec _compressionCodec; // Immutable, not reset by destroy().
+    const size_t _sendQueueMax; // Immutable, not reset by destroy().
+    const bool _sendQueueThrow; // Immutable, not reset by destroy().
     ACMConfig _clientACM;
     ACMConfig _serverACM;
     RouterManagerPtr _routerManager;
@@ -191,12 +205,16 @@ private:
     ObjectAdapterFactoryPtr _objectAdapterFactory;
     ProtocolSupport _protocolSupport;
     bool _preferIPv6;
+    bool _parallelConnect;
+    int _parallelConnectDelay;
     NetworkProxyPtr _networkProxy;
     ThreadPoolPtr _clientThreadPool;
     ThreadPoolPtr _serverThreadPool;
     EndpointHostResolverPtr _endpointHostResolver;
     RetryQueuePtr _retryQueue;
-    TimerPtr _timer;
+    StreamThreadPoolPtr _streamThreadPool;
+    IceUtil::TimerPtr _timer;
+    TimerObserverPtr _timerObserver;
     EndpointFactoryManagerPtr _endpointFactoryManager;
     DynamicLibraryListPtr _dynamicLibraryList;
     Ice::PluginManagerPtr _pluginManager;
@@ -72,6 +72,20 @@ struct ThreadStateChanged
     ThreadState newState;
 };
 
+struct QueuedBytesAdded
+{
+    QueuedBytesAdded(Int num) : num(num)
+    {
+    }
+
+    void operator()(const ConnectionMetricsPtr& v)
+    {
+        v->queuedBytes = (v->queuedBytes ? *v->queuedBytes : 0) + num;
+    }
+
+    Int num;
+};
+
 IPConnectionInfo*
 getIPConnectionInfo(const ConnectionInfoPtr& info)
 {
@@ -772,6 +786,96 @@ private:
 
 EndpointHelper::Attributes EndpointHelper::attributes;
 
+class BufferPoolHelper : public MetricsHelperT<BufferPoolMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<BufferPoolHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &BufferPoolHelper::getId);
+            add("id", &BufferPoolHelper::getId);
+        }
+    };
+    static Attributes attributes;
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    string
+    getId() const
+    {
+        return "Communicator";
+    }
+};
+
+BufferPoolHelper::Attributes BufferPoolHelper::attributes;
+
+struct BufferAllocated
+{
+    BufferAllocated(bool cached, Int cachedBytes) : cached(cached), cachedBytes(cachedBytes)
+    {
+    }
+
+    void operator()(const BufferPoolMetricsPtr& v)
+    {
+        ++v->allocations;
+        if(cached)
+        {
+            ++v->hits;
+        }
+        v->cachedBytes = cachedBytes;
+    }
+
+    bool cached;
+    Int cachedBytes;
+};
+
+struct BufferCached
+{
+    BufferCached(Int cachedBytes) : cachedBytes(cachedBytes)
+    {
+    }
+
+    void operator()(const BufferPoolMetricsPtr& v)
+    {
+        v->cachedBytes = cachedBytes;
+    }
+
+    Int cachedBytes;
+};
+
+class BufferPoolUpdater : public Updater
+{
+public:
+
+    BufferPoolUpdater(ObserverFactoryT<BufferPoolObserverI>* factory, const BufferPoolPtr& pool) :
+        _factory(factory), _pool(pool)
+    {
+    }
+
+    virtual void update()
+    {
+        BufferPoolObserverIPtr old = _pool->getObserver();
+        BufferPoolObserverIPtr observer = _factory->getObserver(BufferPoolHelper(), old);
+        if(observer && observer != old)
+        {
+            observer->attach();
+        }
+        _pool->setObserver(observer);
+    }
+
+private:
+
+    ObserverFactoryT<BufferPoolObserverI>* const _factory;
+    const BufferPoolPtr _pool;
+};
+
 }
 
 void
@@ -794,6 +898,12 @@ ConnectionObserverI::receivedBytes(Int num)
     }
 }
 
+void
+ConnectionObserverI::queuedBytes(Int num)
+{
+    forEach(QueuedBytesAdded(num));
+}
+
 void
 ThreadObserverI::stateChanged(ThreadState oldState, ThreadState newState)
 {
@@ -865,6 +975,18 @@ InvocationObserverI::userException()
     }
 }
 
+void
+BufferPoolObserverI::allocated(bool cached, Int cachedBytes)
+{
+    forEach(BufferAllocated(cached, cachedBytes));
+}
+
+void
+BufferPoolObserverI::cached(Int cachedBytes)
+{
+    forEach(BufferCached(cachedBytes));
+}
+
 RemoteObserverPtr
 InvocationObserverI::getRemoteObserver(const ConnectionInfoPtr& connection,
                                        const EndpointPtr& endpoint,
@@ -916,7 +1038,8 @@ CommunicatorObserverI::CommunicatorObserverI(const InitializationData& initData)
     _invocations(_metrics, "Invocation"),
     _threads(_metrics, "Thread"),
     _connects(_metrics, "ConnectionEstablishment"),
-    _endpointLookups(_metrics, "EndpointLookup")
+    _endpointLookups(_metrics, "EndpointLookup"),
+    _bufferPools(_metrics, "BufferPool")
 {
     _invocations.registerSubMap<RemoteMetrics>("Remote", &InvocationMetrics::remotes);
     _invocations.registerSubMap<CollocatedMetrics>("Collocated", &InvocationMetrics::collocated);
@@ -1086,6 +1209,15 @@ CommunicatorObserverI::getFacet() const
     return _metrics;
 }
 
+void
+CommunicatorObserverI::setBufferPool(const BufferPoolPtr& pool)
+{
+    assert(!_bufferPool);
+    _bufferPool = pool;
+    _bufferPools.setUpdater(ICE_MAKE_SHARED(BufferPoolUpdater, &_bufferPools, pool));
+    _bufferPools.update();
+}
+
 void
 CommunicatorObserverI::destroy()
 {
@@ -1095,6 +1227,19 @@ CommunicatorObserverI::destroy()
     _threads.destroy();
     _connects.destroy();
     _endpointLookups.destroy();
+    _bufferPools.destroy();
+
+    if(_bufferPool)
+    {
+        _bufferPools.setUpdater(ICE_NULLPTR);
+        BufferPoolObserverIPtr observer = _bufferPool->getObserver();
+        if(observer)
+        {
+            observer->detach();
+            _bufferPool->setObserver(ICE_NULLPTR);
+        }
+        _bufferPool = ICE_NULLPTR;
+    }
 
     _metrics->destroy();
 }
@@ -12,6 +12,7 @@
 
 #include <Ice/MetricsObserverI.h>
 #include <Ice/Connection.h>
+#include <Ice/BufferPool.h>
 
 namespace IceInternal
 {
@@ -158,6 +159,13 @@ public:
 
     virtual void sentBytes(Ice::Int);
     virtual void receivedBytes(Ice::Int);
+
+    //
+    // Not part of the Instrumentation::ConnectionObserver interface, the
+    // connection reports the size of its send queue to the metrics
+    // observer directly.
+    //
+    void queuedBytes(Ice::Int);
 };
 
 class ThreadObserverI : public ObserverWithDelegateT<IceMX::ThreadMetrics, Ice::Instrumentation::ThreadObserver>
@@ -209,6 +217,14 @@ public:
 
 typedef ObserverWithDelegateT<IceMX::Metrics, Ice::Instrumentation::Observer> ObserverI;
 
+class BufferPoolObserverI : public IceMX::ObserverT<IceMX::BufferPoolMetrics>
+{
+public:
+
+    void allocated(bool, Ice::Int);
+    void cached(Ice::Int);
+};
+
 class ICE_API CommunicatorObserverI : public Ice::Instrumentation::CommunicatorObserver
 {
 public:
@@ -240,6 +256,8 @@ public:
 
     const IceInternal::MetricsAdminIPtr& getFacet() const;
 
+    void setBufferPool(const IceInternal::BufferPoolPtr&);
+
     void destroy();
 
 private:
@@ -253,6 +271,8 @@ private:
     ObserverFactoryWithDelegateT<ThreadObserverI> _threads;
     ObserverFactoryWithDelegateT<ObserverI> _connects;
     ObserverFactoryWithDelegateT<ObserverI> _endpointLookups;
+    IceMX::ObserverFactoryT<BufferPoolObserverI> _bufferPools;
+    IceInternal::BufferPoolPtr _bufferPool;
 };
 ICE_DEFINE_PTR(CommunicatorObserverIPtr, CommunicatorObserverI);
 
@@ -17,8 +17,23 @@ ifeq ($(DEFAULT_MUTEX_PROTOCOL), PrioInherit)
     Ice_cppflags        += -DICE_PRIO_INHERIT
 endif
 
+ifeq ($(USE_IO_URING),yes)
+    Ice_cppflags        += -DICE_USE_IO_URING
+endif
+
 Ice_sliceflags		:= --include-dir Ice
 Ice_libs		:= bz2
+
+ifeq ($(USE_LZ4),yes)
+    Ice_cppflags        += -DICE_USE_LZ4
+    Ice_libs            += lz4
+endif
+
+ifeq ($(USE_ZSTD),yes)
+    Ice_cppflags        += -DICE_USE_ZSTD
+    Ice_libs            += zstd
+endif
+
 Ice_extra_sources       := $(wildcard src/IceUtil/*.cpp)
 Ice_excludes		= src/Ice/DLLMain.cpp
 
@@ -26,7 +41,7 @@ ifeq ($(os),Darwin)
 Ice_excludes            += src/IceUtil/ConvertUTF.cpp src/IceUtil/Unicode.cpp
 endif
 
-Ice[iphoneos]_excludes			:= $(wildcard $(addprefix $(currentdir)/,Tcp*.cpp))
+Ice[iphoneos]_excludes			:= $(wildcard $(addprefix $(currentdir)/,Tcp*.cpp Unix*.cpp Shm*.cpp))
 Ice[iphoneos]_extra_sources 		:= $(wildcard $(addprefix $(currentdir)/ios/,*.cpp *.mm))
 Ice[iphonesimulator]_excludes		= $(Ice[iphoneos]_excludes)
 Ice[iphonesimulator]_extra_sources	= $(Ice[iphoneos]_extra_sources)
@@ -29,6 +29,7 @@
 #include <Ice/Buffer.h>
 #include <IceUtil/Random.h>
 #include <functional>
+#include <cstddef>
 
 #if defined(ICE_OS_UWP)
 #   include <IceUtil/InputUtil.h>
@@ -125,28 +126,6 @@ struct RandomNumberGenerator : public std::unary_function<ptrdiff_t, ptrdiff_t>
     }
 };
 
-void
-sortAddresses(vector<Address>& addrs, ProtocolSupport protocol, Ice::EndpointSelectionType selType, bool preferIPv6)
-{
-    if(selType == Ice::ICE_ENUM(EndpointSelectionType, Random))
-    {
-        RandomNumberGenerator rng;
-        random_shuffle(addrs.begin(), addrs.end(), rng);
-    }
-
-    if(protocol == EnableBoth)
-    {
-        if(preferIPv6)
-        {
-            stable_partition(addrs.begin(), addrs.end(), AddressIsIPv6());
-        }
-        else
-        {
-            stable_partition(addrs.begin(), addrs.end(), not1(AddressIsIPv6()));
-        }
-    }
-}
-
 void
 setTcpNoDelay(SOCKET fd)
 {
@@ -227,6 +206,12 @@ createSocketImpl(bool udp, int family)
     {
         fd = socket(family, SOCK_DGRAM, IPPROTO_UDP);
     }
+#ifdef ICE_USE_UNIX_SOCKETS
+    else if(family == AF_UNIX)
+    {
+        fd = socket(family, SOCK_STREAM, 0);
+    }
+#endif
     else
     {
         fd = socket(family, SOCK_STREAM, IPPROTO_TCP);
@@ -239,7 +224,11 @@ createSocketImpl(bool udp, int family)
         throw ex;
     }
 
+#ifdef ICE_USE_UNIX_SOCKETS
+    if(!udp && family != AF_UNIX)
+#else
     if(!udp)
+#endif
     {
         setTcpNoDelay(fd);
         setKeepAlive(fd);
@@ -790,6 +779,24 @@ getAddressStorageSize(const Address& addr)
     {
         size = sizeof(sockaddr_in6);
     }
+#ifdef ICE_USE_UNIX_SOCKETS
+    else if(addr.saStorage.ss_family == AF_UNIX)
+    {
+        if(addr.saUn.sun_path[0] == '\0' && addr.saUn.sun_path[1] != '\0')
+        {
+            //
+            // The name of an abstract socket isn't null-terminated, its
+            // length is given by the size of the address.
+            //
+            size = static_cast<int>(offsetof(sockaddr_un, sun_path) + 1 +
+                                    strnlen(addr.saUn.sun_path + 1, sizeof(addr.saUn.sun_path) - 1));
+        }
+        else
+        {
+            size = sizeof(sockaddr_un);
+        }
+    }
+#endif
     return size;
 }
 
@@ -807,6 +814,28 @@ NativeInfo::~NativeInfo()
     // Out of line to avoid weak vtable
 }
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+RingInfo::RingInfo(size_t size) :
+    enabled(false),
+    readBuffer(size),
+    readBegin(0),
+    readEnd(0),
+    readEof(false),
+    readError(0),
+    readMore(true),
+    reading(false),
+    readRequest(0),
+    writeSize(0),
+    writeCompleted(false),
+    writeResult(0),
+    writeRequest(0)
+{
+    //
+    // The write buffer is only allocated if a write request is needed.
+    //
+}
+#endif
+
 void
 NativeInfo::setReadyCallback(const ReadyCallbackPtr& callback)
 {
@@ -1163,6 +1192,63 @@ IceInternal::getAddresses(const string& host, int port, ProtocolSupport protocol
     sortAddresses(result, protocol, selType, preferIPv6);
     return result;
 }
+
+void
+IceInternal::sortAddresses(vector<Address>& addrs, ProtocolSupport protocol, Ice::EndpointSelectionType selType,
+                           bool preferIPv6)
+{
+    if(selType == Ice::ICE_ENUM(EndpointSelectionType, Random))
+    {
+        RandomNumberGenerator rng;
+        random_shuffle(addrs.begin(), addrs.end(), rng);
+    }
+
+    if(protocol == EnableBoth)
+    {
+        if(preferIPv6)
+        {
+            stable_partition(addrs.begin(), addrs.end(), AddressIsIPv6());
+        }
+        else
+        {
+            stable_partition(addrs.begin(), addrs.end(), not1(AddressIsIPv6()));
+        }
+    }
+}
+
+void
+IceInternal::interleaveAddresses(vector<Address>& addrs)
+{
+    //
+    // Alternate between the address families, starting with the family
+    // of the first (preferred) address. Connecting in parallel to the
+    // addresses of both families doesn't get stuck on a broken family.
+    //
+    if(addrs.empty())
+    {
+        return;
+    }
+
+    vector<Address> first;
+    vector<Address> second;
+    for(vector<Address>::const_iterator p = addrs.begin(); p != addrs.end(); ++p)
+    {
+        (p->saStorage.ss_family == addrs.front().saStorage.ss_family ? first : second).push_back(*p);
+    }
+
+    addrs.clear();
+    for(size_t i = 0; i < first.size() || i < second.size(); ++i)
+    {
+        if(i < first.size())
+        {
+            addrs.push_back(first[i]);
+        }
+        if(i < second.size())
+        {
+            addrs.push_back(second[i]);
+        }
+    }
+}
 #endif
 
 #ifdef ICE_OS_UWP
@@ -1272,6 +1358,20 @@ IceInternal::compareAddress(const Address& addr1, const Address& addr2)
             return 1;
         }
     }
+#ifdef ICE_USE_UNIX_SOCKETS
+    else if(addr1.saStorage.ss_family == AF_UNIX)
+    {
+        int res = memcmp(addr1.saUn.sun_path, addr2.saUn.sun_path, sizeof(addr1.saUn.sun_path));
+        if(res < 0)
+        {
+            return -1;
+        }
+        else if(res > 0)
+        {
+            return 1;
+        }
+    }
+#endif
     else
     {
         if(addr1.saIn6.sin6_port < addr2.saIn6.sin6_port)
@@ -1436,6 +1536,13 @@ IceInternal::closeSocket(SOCKET fd)
 string
 IceInternal::addrToString(const Address& addr)
 {
+#ifdef ICE_USE_UNIX_SOCKETS
+    if(addr.saStorage.ss_family == AF_UNIX)
+    {
+        string path = unixAddrToString(addr);
+        return path.empty() ? "<unnamed>" : path;
+    }
+#endif
     ostringstream s;
     s << inetAddrToString(addr) << ':' << getPort(addr);
     return s.str();
@@ -2221,6 +2328,48 @@ IceInternal::setReuseAddress(SOCKET fd, bool reuse)
 }
 #endif
 
+#if defined(SO_REUSEPORT) && !defined(ICE_OS_UWP)
+void
+IceInternal::setReusePort(SOCKET fd, bool reuse)
+{
+    int flag = reuse ? 1 : 0;
+    if(setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<char*>(&flag), int(sizeof(int))) == SOCKET_ERROR)
+    {
+        closeSocketNoThrow(fd);
+        SocketException ex(__FILE__, __LINE__);
+        ex.error = getSocketErrno();
+        throw ex;
+    }
+}
+#else
+void
+IceInternal::setReusePort(SOCKET, bool)
+{
+    //
+    // Not supported, the --reuseport endpoint option is rejected on
+    // platforms without SO_REUSEPORT.
+    //
+}
+#endif
+
+#if defined(SO_BUSY_POLL) && !defined(ICE_OS_UWP)
+bool
+IceInternal::setBusyPoll(SOCKET fd, int micros)
+{
+    //
+    // Enabling busy polling might require the CAP_NET_ADMIN capability,
+    // failures are reported to the caller rather than raised.
+    //
+    return setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, reinterpret_cast<char*>(&micros), int(sizeof(int))) != SOCKET_ERROR;
+}
+#else
+bool
+IceInternal::setBusyPoll(SOCKET, int)
+{
+    return false;
+}
+#endif
+
 
 #ifdef ICE_OS_UWP
 namespace
@@ -2703,8 +2852,11 @@ IceInternal::doAccept(SOCKET fd)
     int ret;
 #endif
 
+    Address addr;
+    socklen_t len = static_cast<socklen_t>(sizeof(sockaddr_storage));
+
 repeatAccept:
-    if((ret = ::accept(fd, 0, 0)) == INVALID_SOCKET)
+    if((ret = ::accept(fd, &addr.sa, &len)) == INVALID_SOCKET)
     {
         if(acceptInterrupted())
         {
@@ -2716,6 +2868,13 @@ repeatAccept:
         throw ex;
     }
 
+#ifdef ICE_USE_UNIX_SOCKETS
+    if(addr.saStorage.ss_family == AF_UNIX)
+    {
+        return ret;
+    }
+#endif
+
     setTcpNoDelay(ret);
     setKeepAlive(ret);
     return ret;
@@ -3070,3 +3229,72 @@ IceInternal::isIpAddress(const string& name)
     return inet_pton(AF_INET, name.c_str(), &addr) > 0 || inet_pton(AF_INET6, name.c_str(), &addr6) > 0;
 #endif
 }
+
+#ifdef ICE_USE_UNIX_SOCKETS
+
+Address
+IceInternal::getUnixAddress(const string& path)
+{
+    assert(!path.empty() && path.size() < sizeof(sockaddr_un().sun_path));
+
+    Address addr;
+    addr.saUn.sun_family = AF_UNIX;
+    if(path[0] == '@')
+    {
+        //
+        // Linux abstract namespace: the name starts with a null byte
+        // instead of the '@' used in the stringified endpoint.
+        //
+        memcpy(addr.saUn.sun_path + 1, path.c_str() + 1, path.size() - 1);
+    }
+    else
+    {
+        memcpy(addr.saUn.sun_path, path.c_str(), path.size());
+    }
+    return addr;
+}
+
+string
+IceInternal::unixAddrToString(const Address& addr)
+{
+    assert(addr.saStorage.ss_family == AF_UNIX);
+    const size_t maxSize = sizeof(addr.saUn.sun_path);
+    if(addr.saUn.sun_path[0] == '\0')
+    {
+        size_t size = strnlen(addr.saUn.sun_path + 1, maxSize - 1);
+        return size == 0 ? string() : "@" + string(addr.saUn.sun_path + 1, size);
+    }
+    return string(addr.saUn.sun_path, strnlen(addr.saUn.sun_path, maxSize));
+}
+
+bool
+IceInternal::getPeerCredentials(SOCKET fd, int& pid, int& uid, int& gid)
+{
+#if defined(__linux)
+    ucred cred;
+    socklen_t len = static_cast<socklen_t>(sizeof(cred));
+    if(getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) == SOCKET_ERROR)
+    {
+        return false;
+    }
+    pid = static_cast<int>(cred.pid);
+    uid = static_cast<int>(cred.uid);
+    gid = static_cast<int>(cred.gid);
+    return true;
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__FreeBSD_kernel__)
+    uid_t u;
+    gid_t g;
+    if(getpeereid(fd, &u, &g) == SOCKET_ERROR)
+    {
+        return false;
+    }
+    pid = -1; // Not provided by getpeereid
+    uid = static_cast<int>(u);
+    gid = static_cast<int>(g);
+    return true;
+#else
+    return false;
+#endif
+}
+
+#endif
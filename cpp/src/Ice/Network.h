@@ -16,6 +16,7 @@
 
 #include <Ice/Config.h>
 
+#include <IceUtil/Mutex.h>
 #include <Ice/NetworkF.h>
 #include <Ice/NetworkProxyF.h>
 #include <Ice/PropertiesF.h> // For setTcpBufSize
@@ -60,6 +61,15 @@ typedef int ssize_t;
 #   define ICE_USE_POLL 1
 #endif
 
+#if !defined(_WIN32) && !defined(ICE_USE_CFSTREAM) && !defined(ICE_NO_UNIX_SOCKETS)
+#   define ICE_USE_UNIX_SOCKETS 1
+#   include <sys/un.h>
+#endif
+
+#if defined(ICE_USE_UNIX_SOCKETS) && defined(__linux) && !defined(ICE_NO_SHM_TRANSPORT)
+#   define ICE_USE_SHM_TRANSPORT 1
+#endif
+
 #if defined(_WIN32) || defined(__osf__)
 typedef int socklen_t;
 #endif
@@ -133,6 +143,9 @@ union Address
     sockaddr sa;
     sockaddr_in saIn;
     sockaddr_in6 saIn6;
+#ifdef ICE_USE_UNIX_SOCKETS
+    sockaddr_un saUn;
+#endif
     sockaddr_storage saStorage;
 };
 #endif
@@ -185,6 +198,42 @@ struct ICE_API AsyncInfo
 };
 
 delegate void SocketOperationCompletedHandler(int);
+#else
+//
+// RingInfo holds the buffers of the native infos which are read and
+// written with io_uring read and write requests by the io_uring selector
+// backend (see NativeInfo::setRingInfo). The buffers are owned by the
+// selector while a request is pending. All the members are protected by
+// the mutex.
+//
+struct ICE_API RingInfo : public IceUtil::Shared
+{
+    RingInfo(size_t);
+
+    IceUtil::Mutex mutex;
+
+    //
+    // Set by the transceiver once the socket is connected, the selector
+    // only issues read and write requests once it's set.
+    //
+    bool enabled;
+
+    std::vector<char> readBuffer;
+    size_t readBegin; // Received data not consumed yet by the transceiver
+    size_t readEnd;
+    bool readEof;
+    int readError;
+    bool readMore; // Whether or not more data might be available on the socket
+    bool reading; // The transceiver reads from the socket, no read request must be issued
+    IceUtil::Int64 readRequest; // The pending read request or 0
+
+    std::vector<char> writeBuffer;
+    size_t writeSize; // Data to send with the next write request
+    bool writeCompleted;
+    ssize_t writeResult; // Number of bytes sent by the completed write request or -errno
+    IceUtil::Int64 writeRequest; // The pending write request or 0
+};
+typedef IceUtil::Handle<RingInfo> RingInfoPtr;
 #endif
 
 class ICE_API ReadyCallback : public virtual ::IceUtil::Shared
@@ -195,6 +244,7 @@ public:
 
 
     virtual void ready(SocketOperation, bool) = 0;
+    virtual void suspend(SocketOperation, bool) = 0;
 };
 typedef IceUtil::Handle<ReadyCallback> ReadyCallbackPtr;
 
@@ -206,7 +256,7 @@ public:
 
     NativeInfo(SOCKET socketFd = INVALID_SOCKET) : _fd(socketFd)
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
-        , _newFd(INVALID_SOCKET)
+        , _newFd(INVALID_SOCKET), _ringIOSupported(false), _writeReadyOnInput(false)
 #endif
     {
     }
@@ -224,6 +274,17 @@ public:
         _readyCallback->ready(operation, value);
     }
 
+    //
+    // Suspends the polling of the socket for the given operation. This is
+    // used by transceivers that perform an operation from another thread,
+    // the completion is then signaled with ready().
+    //
+    void suspend(SocketOperation operation, bool value)
+    {
+        assert(_readyCallback);
+        _readyCallback->suspend(operation, value);
+    }
+
     //
     // This is implemented by transceiver and acceptor implementations.
     //
@@ -240,6 +301,49 @@ public:
 #else
     bool newFd();
     void setNewFd(SOCKET);
+
+    //
+    // With the io_uring selector backend, the selector reads and writes
+    // the socket of the native infos which support it with read and write
+    // requests (see RingInfo). Transports which use the socket without
+    // going through the native info must disable it.
+    //
+    bool ringIOSupported() const
+    {
+        return _ringIOSupported;
+    }
+
+    void disableRingIO()
+    {
+        _ringIOSupported = false;
+    }
+
+    const RingInfoPtr& getRingInfo() const
+    {
+        return _ringInfo;
+    }
+
+    void setRingInfo(const RingInfoPtr& info)
+    {
+        _ringInfo = info;
+    }
+
+    //
+    // Transports which signal write readiness with input on the socket
+    // (the socket itself is always writable) set this flag. The epoll and
+    // io_uring selectors then poll for input while the handler is
+    // registered for write and report the handler ready for write when
+    // input is available.
+    //
+    bool writeReadyOnInput() const
+    {
+        return _writeReadyOnInput;
+    }
+
+    void setWriteReadyOnInput(bool value)
+    {
+        _writeReadyOnInput = value;
+    }
 #endif
 
 protected:
@@ -255,6 +359,9 @@ protected:
     SocketOperationCompletedHandler^ _completedHandler;
 #else
     SOCKET _newFd;
+    bool _ringIOSupported;
+    bool _writeReadyOnInput;
+    RingInfoPtr _ringInfo;
 #endif
 };
 typedef IceUtil::Handle<NativeInfo> NativeInfoPtr;
@@ -304,10 +411,15 @@ ICE_API void setMcastGroup(SOCKET, const Address&, const std::string&);
 ICE_API void setMcastInterface(SOCKET, const std::string&, const Address&);
 ICE_API void setMcastTtl(SOCKET, int, const Address&);
 ICE_API void setReuseAddress(SOCKET, bool);
+ICE_API void setReusePort(SOCKET, bool);
+ICE_API bool setBusyPoll(SOCKET, int);
 ICE_API Address doBind(SOCKET, const Address&, const std::string& intf = "");
 ICE_API void doListen(SOCKET, int);
 
 #ifndef ICE_OS_UWP
+ICE_API void sortAddresses(std::vector<Address>&, ProtocolSupport, Ice::EndpointSelectionType, bool);
+ICE_API void interleaveAddresses(std::vector<Address>&);
+
 ICE_API bool interrupted();
 ICE_API bool acceptInterrupted();
 ICE_API bool noBuffers();
@@ -371,6 +483,13 @@ ICE_API void doFinishConnectAsync(SOCKET, AsyncInfo&);
 
 ICE_API bool isIpAddress(const std::string&);
 
+#ifdef ICE_USE_UNIX_SOCKETS
+ICE_API bool isUnixPathValid(const std::string&);
+ICE_API Address getUnixAddress(const std::string&);
+ICE_API std::string unixAddrToString(const Address&);
+ICE_API bool getPeerCredentials(SOCKET, int&, int&, int&);
+#endif
+
 }
 
 #endif
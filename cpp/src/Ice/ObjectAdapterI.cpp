@@ -1037,12 +1037,13 @@ Ice::ObjectAdapterI::initialize(const RouterPrxPtr& router)
         int threadPoolSize = properties->getPropertyAsInt(_name + ".ThreadPool.Size");
         int threadPoolSizeMax = properties->getPropertyAsInt(_name + ".ThreadPool.SizeMax");
         bool hasPriority = properties->getProperty(_name + ".ThreadPool.ThreadPriority") != "";
+        int threadPoolShards = properties->getPropertyAsInt(_name + ".ThreadPool.Shards");
 
         //
         // Create the per-adapter thread pool, if necessary. This is done before the creation of the incoming
         // connection factory as the thread pool is needed during creation for the call to incFdsInUse.
         //
-        if(threadPoolSize > 0 || threadPoolSizeMax > 0 || hasPriority)
+        if(threadPoolSize > 0 || threadPoolSizeMax > 0 || threadPoolShards > 1 || hasPriority)
         {
             _threadPool = new ThreadPool(_instance, _name + ".ThreadPool", 0);
         }
@@ -1105,6 +1106,19 @@ Ice::ObjectAdapterI::initialize(const RouterPrxPtr& router)
                 IncomingConnectionFactoryPtr factory = ICE_MAKE_SHARED(IncomingConnectionFactory, _instance, *p, ICE_SHARED_FROM_THIS);
                  factory->initialize();
                 _incomingConnectionFactories.push_back(factory);
+
+                //
+                // With the --reuseport option, additional acceptors listen on the
+                // factory endpoint (which has the effective port if the port was
+                // 0) and the kernel load-balances the connections over them.
+                //
+                for(Int i = 1; i < factory->endpoint()->reusePort(); ++i)
+                {
+                    IncomingConnectionFactoryPtr f = ICE_MAKE_SHARED(IncomingConnectionFactory, _instance,
+                                                                     factory->endpoint(), ICE_SHARED_FROM_THIS);
+                    f->initialize();
+                    factory->addReusePortFactory(f);
+                }
             }
 
             if(endpoints.empty())
@@ -1459,6 +1473,7 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "Locator.EncodingVersion",
         "Locator.EndpointSelection",
         "Locator.ConnectionCached",
+        "Locator.ConnectionStripes",
         "Locator.PreferSecure",
         "Locator.CollocationOptimized",
         "Locator.Router",
@@ -1469,23 +1484,32 @@ Ice::ObjectAdapterI::filterProperties(StringSeq& unknownProps)
         "Router.EncodingVersion",
         "Router.EndpointSelection",
         "Router.ConnectionCached",
+        "Router.ConnectionStripes",
         "Router.PreferSecure",
         "Router.CollocationOptimized",
         "Router.Locator",
         "Router.Locator.EndpointSelection",
         "Router.Locator.ConnectionCached",
+        "Router.Locator.ConnectionStripes",
         "Router.Locator.PreferSecure",
         "Router.Locator.CollocationOptimized",
         "Router.Locator.LocatorCacheTimeout",
         "Router.Locator.InvocationTimeout",
+        "Router.Locator.Priority",
         "Router.LocatorCacheTimeout",
         "Router.InvocationTimeout",
+        "Router.Priority",
         "ProxyOptions",
+        "ThreadPool.Backend",
+        "ThreadPool.BusyPoll",
+        "ThreadPool.CpuAffinity",
         "ThreadPool.Size",
         "ThreadPool.SizeMax",
         "ThreadPool.SizeWarn",
+        "ThreadPool.SpinMicros",
         "ThreadPool.StackSize",
         "ThreadPool.Serialize",
+        "ThreadPool.Shards",
         "ThreadPool.ThreadPriority"
     };
 
@@ -43,6 +43,11 @@ OutgoingAsyncCompletionCallback::~OutgoingAsyncCompletionCallback()
     // Out of line to avoid weak vtable
 }
 
+DirectParams::~DirectParams()
+{
+    // Out of line to avoid weak vtable
+}
+
 bool
 OutgoingAsyncBase::sent()
 {
@@ -611,6 +616,16 @@ ProxyOutgoingAsyncBase::exception(const Exception& exc)
     // NOTE: at this point, synchronization isn't needed, no other threads should be
     // calling on the callback.
     //
+    //
+    // Once sent, the source of a streamed sequence might be partially
+    // read. The request can only be retried if the server closed the
+    // connection gracefully, it's not dispatched in this case.
+    //
+    if(_sent && _os.getStreamedSource() && !dynamic_cast<const CloseConnectionException*>(&exc))
+    {
+        return exceptionImpl(exc);
+    }
+
     try
     {
         //
@@ -741,6 +756,20 @@ ProxyOutgoingAsyncBase::invokeImpl(bool userThread)
             {
                 _sent = false;
                 _handler = _proxy->_getRequestHandler();
+                if(userThread && _instance->sendQueueMax() > 0 && sendsMessage())
+                {
+                    //
+                    // Only new invocations wait for, or fail on, a full send
+                    // queue. Retries and the requests queued while connecting
+                    // are sent by Ice threads which might be needed to send it.
+                    // Asynchronous invocations never wait.
+                    //
+                    ConnectionIPtr connection = _handler->getConnection();
+                    if(connection)
+                    {
+                        connection->checkSendQueue(_proxy->_getReference()->getInvocationTimeout(), synchronous());
+                    }
+                }
                 AsyncStatus status = _handler->sendAsyncRequest(ICE_SHARED_FROM_THIS);
                 if(status & AsyncStatusSent)
                 {
@@ -837,6 +866,18 @@ ProxyOutgoingAsyncBase::responseImpl(bool ok)
     return OutgoingAsyncBase::responseImpl(ok);
 }
 
+bool
+ProxyOutgoingAsyncBase::sendsMessage() const
+{
+    return true;
+}
+
+bool
+ProxyOutgoingAsyncBase::synchronous() const
+{
+    return false;
+}
+
 void
 ProxyOutgoingAsyncBase::runTimerTask()
 {
@@ -853,7 +894,10 @@ ProxyOutgoingAsyncBase::runTimerTask()
 OutgoingAsync::OutgoingAsync(const ObjectPrxPtr& prx, bool synchronous) :
     ProxyOutgoingAsyncBase(prx),
     _encoding(getCompatibleEncoding(prx->_getReference()->getEncoding())),
-    _synchronous(synchronous)
+    _synchronous(synchronous),
+    _directParams(0),
+    _hasDirectParams(false),
+    _directDispatch(false)
 {
 }
 
@@ -939,6 +983,12 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
     }
 }
 
+bool
+OutgoingAsync::synchronous() const
+{
+    return _synchronous;
+}
+
 bool
 OutgoingAsync::sent()
 {
@@ -1093,13 +1143,36 @@ OutgoingAsync::response()
 AsyncStatus
 OutgoingAsync::invokeRemote(const ConnectionIPtr& connection, bool compress, bool response)
 {
+    if(_hasDirectParams)
+    {
+        _directDispatch = false;
+        writeDirectParams();
+    }
     _cachedConnection = connection;
-    return connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, compress, response, 0);
+    return connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, compress, response, 0,
+                                         _proxy->_getReference()->getPriority());
 }
 
 AsyncStatus
 OutgoingAsync::invokeCollocated(CollocatedRequestHandler* handler)
 {
+    if(_hasDirectParams)
+    {
+        //
+        // Only the first attempt of the invocation can pass the parameters
+        // by reference to the servant, the request must be dispatched from
+        // the invoking thread. Otherwise, the parameters are marshaled.
+        //
+        if(_directDispatch)
+        {
+            _directDispatch = false;
+            if(_synchronous && handler->canDispatchDirectly())
+            {
+                return handler->invokeAsyncRequest(this, 0, true, _directParams);
+            }
+        }
+        writeDirectParams();
+    }
     return handler->invokeAsyncRequest(this, 0, _synchronous);
 }
 
@@ -1124,6 +1197,16 @@ void
 OutgoingAsync::invoke(const string& operation)
 {
     const Reference::Mode mode = _proxy->_getReference()->getMode();
+
+    //
+    // Only the streamed sequence of a twoway request is sent after the
+    // request, the request must be kept until the peer reads it.
+    //
+    if(mode != Reference::ModeTwoway)
+    {
+        _os.inlineStreamedSource();
+    }
+
     if(mode == Reference::ModeBatchOneway || mode == Reference::ModeBatchDatagram)
     {
         _sentSynchronously = true;
@@ -1140,6 +1223,55 @@ OutgoingAsync::invoke(const string& operation)
     invokeImpl(true); // userThread = true
 }
 
+void
+OutgoingAsync::invoke(const string& operation, DirectParams& params)
+{
+    //
+    // Only twoway requests can be dispatched with the parameters passed
+    // by reference, the parameters of other requests are marshaled now.
+    //
+    params._encoding = _encoding;
+    _directParams = &params;
+    if(_proxy->_getReference()->getMode() != Reference::ModeTwoway)
+    {
+        writeDirectParams();
+        invoke(operation);
+        return;
+    }
+
+    //
+    // Otherwise, marshaling is deferred until the request is sent. It
+    // must be done before returning unless the request is completed: the
+    // caller's parameters might be gone by the time a retry or a request
+    // waiting for its connection is sent.
+    //
+    _hasDirectParams = true;
+    _directDispatch = true;
+    invoke(operation);
+    writeDirectParams();
+}
+
+void
+OutgoingAsync::writeDirectParams()
+{
+    Lock sync(_m);
+    if(_directParams)
+    {
+#ifdef ICE_CPP11_MAPPING
+        if(!_directParams->_completed)
+#else
+        if(!(_state & Done))
+#endif
+        {
+            _directParams->_completed = false;
+            _os.startEncapsulation(_encoding, ICE_ENUM(FormatType, DefaultFormat)); // No classes
+            _directParams->write(&_os);
+            _os.endEncapsulation();
+        }
+        _directParams = 0;
+    }
+}
+
 #ifdef ICE_CPP11_MAPPING
 void
 OutgoingAsync::invoke(const string& operation,
@@ -1169,6 +1301,28 @@ OutgoingAsync::invoke(const string& operation,
     }
 }
 
+void
+OutgoingAsync::invoke(const string& operation,
+                      Ice::OperationMode mode,
+                      Ice::FormatType,
+                      const Ice::Context& context,
+                      DirectParams& params)
+{
+    //
+    // The format isn't used, the parameters of operations using classes
+    // are never passed by reference.
+    //
+    try
+    {
+        prepare(operation, mode, context);
+        invoke(operation, params);
+    }
+    catch(const Ice::Exception& ex)
+    {
+        abort(ex);
+    }
+}
+
 void
 OutgoingAsync::throwUserException()
 {
@@ -75,6 +75,8 @@ private:
 Ice::OutputStream::OutputStream() :
     _instance(0),
     _closure(0),
+    _streamedPos(0),
+    _streamedEncapsPos(0),
     _encoding(currentEncoding),
     _format(ICE_ENUM(FormatType, CompactFormat)),
     _currentEncaps(0)
@@ -83,6 +85,8 @@ Ice::OutputStream::OutputStream() :
 
 Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator) :
     _closure(0),
+    _streamedPos(0),
+    _streamedEncapsPos(0),
     _currentEncaps(0)
 {
     initialize(communicator);
@@ -90,6 +94,8 @@ Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator) :
 
 Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator, const EncodingVersion& encoding) :
     _closure(0),
+    _streamedPos(0),
+    _streamedEncapsPos(0),
     _currentEncaps(0)
 {
     initialize(communicator, encoding);
@@ -99,6 +105,8 @@ Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator, const Encod
                                 const pair<const Byte*, const Byte*>& buf) :
     Buffer(buf.first, buf.second),
     _closure(0),
+    _streamedPos(0),
+    _streamedEncapsPos(0),
     _currentEncaps(0)
 {
     initialize(communicator, encoding);
@@ -107,6 +115,8 @@ Ice::OutputStream::OutputStream(const CommunicatorPtr& communicator, const Encod
 
 Ice::OutputStream::OutputStream(Instance* instance, const EncodingVersion& encoding) :
     _closure(0),
+    _streamedPos(0),
+    _streamedEncapsPos(0),
     _currentEncaps(0)
 {
     initialize(instance, encoding);
@@ -136,6 +146,8 @@ Ice::OutputStream::initialize(Instance* instance, const EncodingVersion& encodin
     _encoding = encoding;
 
     _format = _instance->defaultsAndOverrides()->defaultFormat;
+
+    b.setPool(_instance->bufferPool());
 }
 
 void
@@ -147,6 +159,8 @@ Ice::OutputStream::clear()
         _currentEncaps = _currentEncaps->previous;
         delete oldEncaps;
     }
+
+    _streamedSource = 0;
 }
 
 void
@@ -176,6 +190,9 @@ Ice::OutputStream::swap(OutputStream& other)
 
     std::swap(_instance, other._instance);
     std::swap(_closure, other._closure);
+    std::swap(_streamedSource, other._streamedSource);
+    std::swap(_streamedPos, other._streamedPos);
+    std::swap(_streamedEncapsPos, other._streamedEncapsPos);
     std::swap(_encoding, other._encoding);
     std::swap(_format, other._format);
 
@@ -253,6 +270,92 @@ Ice::OutputStream::writeBlob(const vector<Byte>& v)
     }
 }
 
+void
+Ice::OutputStream::write(const ByteSourcePtr& v)
+{
+    if(v && _streamedSource)
+    {
+        MarshalException ex(__FILE__, __LINE__);
+        ex.reason = "only one streamed sequence can be sent with a request or reply";
+        throw ex;
+    }
+
+    if(v)
+    {
+        //
+        // The encapsulation size must be updated if the data is inlined,
+        // the encapsulation of a streamed sequence always starts before
+        // the sequence.
+        //
+        _streamedSource = v;
+        _streamedPos = b.size();
+        _streamedEncapsPos = _currentEncaps ? _currentEncaps->start : _streamedPos;
+    }
+    writeSize(0);
+}
+
+void
+Ice::OutputStream::inlineStreamedSource()
+{
+    if(!_streamedSource)
+    {
+        return;
+    }
+
+    ByteSourcePtr source = _streamedSource;
+    _streamedSource = 0;
+
+    vector<Byte> data;
+    try
+    {
+        vector<Byte> chunk;
+        while(source->read(chunk, 65536))
+        {
+            data.insert(data.end(), chunk.begin(), chunk.end());
+        }
+    }
+    catch(const Ice::LocalException&)
+    {
+        throw;
+    }
+    catch(const std::exception& ex)
+    {
+        MarshalException e(__FILE__, __LINE__);
+        e.reason = string("exception raised by the source of a streamed sequence:\n") + ex.what();
+        throw e;
+    }
+    catch(...)
+    {
+        MarshalException e(__FILE__, __LINE__);
+        e.reason = "unknown exception raised by the source of a streamed sequence";
+        throw e;
+    }
+
+    //
+    // Replace the empty sequence with the data, the size of a sequence
+    // larger than 254 bytes takes 4 additional bytes.
+    //
+    const Int sz = static_cast<Int>(data.size());
+    const size_type grow = data.size() + (sz > 254 ? 4 : 0);
+    const size_type end = b.size();
+    b.resize(end + grow);
+    copy_backward(b.begin() + _streamedPos + 1, b.begin() + end, b.end());
+    copy(data.begin(), data.end(), b.begin() + _streamedPos + (sz > 254 ? 5 : 1));
+    rewriteSize(sz, b.begin() + _streamedPos);
+
+    if(_streamedEncapsPos < _streamedPos)
+    {
+        Int encapsSize;
+        Byte* p = reinterpret_cast<Byte*>(&encapsSize);
+#ifdef ICE_BIG_ENDIAN
+        reverse_copy(b.begin() + _streamedEncapsPos, b.begin() + _streamedEncapsPos + sizeof(Int), p);
+#else
+        copy(b.begin() + _streamedEncapsPos, b.begin() + _streamedEncapsPos + sizeof(Int), p);
+#endif
+        rewrite(encapsSize + static_cast<Int>(grow), _streamedEncapsPos);
+    }
+}
+
 void
 Ice::OutputStream::write(const Byte* begin, const Byte* end)
 {
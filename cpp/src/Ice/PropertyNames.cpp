@@ -36,9 +36,11 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.Endpoints", false, 0),
     IceInternal::Property("Ice.Admin.Locator.EndpointSelection", false, 0),
     IceInternal::Property("Ice.Admin.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("Ice.Admin.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("Ice.Admin.Locator.PreferSecure", false, 0),
     IceInternal::Property("Ice.Admin.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Ice.Admin.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("Ice.Admin.Locator.Priority", false, 0),
     IceInternal::Property("Ice.Admin.Locator.Locator", false, 0),
     IceInternal::Property("Ice.Admin.Locator.Router", false, 0),
     IceInternal::Property("Ice.Admin.Locator.CollocationOptimized", false, 0),
@@ -48,9 +50,11 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ReplicaGroupId", false, 0),
     IceInternal::Property("Ice.Admin.Router.EndpointSelection", false, 0),
     IceInternal::Property("Ice.Admin.Router.ConnectionCached", false, 0),
+    IceInternal::Property("Ice.Admin.Router.ConnectionStripes", false, 0),
     IceInternal::Property("Ice.Admin.Router.PreferSecure", false, 0),
     IceInternal::Property("Ice.Admin.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Ice.Admin.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("Ice.Admin.Router.Priority", false, 0),
     IceInternal::Property("Ice.Admin.Router.Locator", false, 0),
     IceInternal::Property("Ice.Admin.Router.Router", false, 0),
     IceInternal::Property("Ice.Admin.Router.CollocationOptimized", false, 0),
@@ -64,6 +68,11 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.Backend", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.Shards", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("Ice.Admin.MessageSizeMax", false, 0),
     IceInternal::Property("Ice.Admin.DelayCreation", false, 0),
     IceInternal::Property("Ice.Admin.Enabled", false, 0),
@@ -76,11 +85,16 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.BackgroundLocatorCacheUpdates", false, 0),
     IceInternal::Property("Ice.BatchAutoFlush", true, 0),
     IceInternal::Property("Ice.BatchAutoFlushSize", false, 0),
+    IceInternal::Property("Ice.BufferPool.MaxBytes", false, 0),
     IceInternal::Property("Ice.ChangeUser", false, 0),
     IceInternal::Property("Ice.ClassGraphDepthMax", false, 0),
     IceInternal::Property("Ice.ClientAccessPolicyProtocol", false, 0),
+    IceInternal::Property("Ice.Compression.Codec", false, 0),
     IceInternal::Property("Ice.Compression.Level", false, 0),
+    IceInternal::Property("Ice.Compression.MinSize", false, 0),
     IceInternal::Property("Ice.CollectObjects", false, 0),
+    IceInternal::Property("Ice.Connection.SendQueueMax", false, 0),
+    IceInternal::Property("Ice.Connection.SendQueuePolicy", false, 0),
     IceInternal::Property("Ice.Config", false, 0),
     IceInternal::Property("Ice.ConsoleListener", false, 0),
     IceInternal::Property("Ice.Default.CollocationOptimized", false, 0),
@@ -89,9 +103,11 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Default.Host", false, 0),
     IceInternal::Property("Ice.Default.Locator.EndpointSelection", false, 0),
     IceInternal::Property("Ice.Default.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("Ice.Default.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("Ice.Default.Locator.PreferSecure", false, 0),
     IceInternal::Property("Ice.Default.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Ice.Default.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("Ice.Default.Locator.Priority", false, 0),
     IceInternal::Property("Ice.Default.Locator.Locator", false, 0),
     IceInternal::Property("Ice.Default.Locator.Router", false, 0),
     IceInternal::Property("Ice.Default.Locator.CollocationOptimized", false, 0),
@@ -104,9 +120,11 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Default.Protocol", false, 0),
     IceInternal::Property("Ice.Default.Router.EndpointSelection", false, 0),
     IceInternal::Property("Ice.Default.Router.ConnectionCached", false, 0),
+    IceInternal::Property("Ice.Default.Router.ConnectionStripes", false, 0),
     IceInternal::Property("Ice.Default.Router.PreferSecure", false, 0),
     IceInternal::Property("Ice.Default.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Ice.Default.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("Ice.Default.Router.Priority", false, 0),
     IceInternal::Property("Ice.Default.Router.Locator", false, 0),
     IceInternal::Property("Ice.Default.Router.Router", false, 0),
     IceInternal::Property("Ice.Default.Router.CollocationOptimized", false, 0),
@@ -117,8 +135,13 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Default.Timeout", false, 0),
     IceInternal::Property("Ice.EventLog.Source", false, 0),
     IceInternal::Property("Ice.FactoryAssemblies", false, 0),
+    IceInternal::Property("Ice.FragmentSize", false, 0),
+    IceInternal::Property("Ice.FragmentedMessagesMax", false, 0),
     IceInternal::Property("Ice.HTTPProxyHost", false, 0),
     IceInternal::Property("Ice.HTTPProxyPort", false, 0),
+    IceInternal::Property("Ice.HostResolver.CacheTTL", false, 0),
+    IceInternal::Property("Ice.HostResolver.NegativeCacheTTL", false, 0),
+    IceInternal::Property("Ice.HostResolver.Threads", false, 0),
     IceInternal::Property("Ice.ImplicitContext", false, 0),
     IceInternal::Property("Ice.InitPlugins", false, 0),
     IceInternal::Property("Ice.IPv4", false, 0),
@@ -135,6 +158,8 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Override.Timeout", false, 0),
     IceInternal::Property("Ice.Override.Secure", false, 0),
     IceInternal::Property("Ice.Package.*", false, 0),
+    IceInternal::Property("Ice.ParallelConnect", false, 0),
+    IceInternal::Property("Ice.ParallelConnect.Delay", false, 0),
     IceInternal::Property("Ice.Plugin.*", false, 0),
     IceInternal::Property("Ice.PluginLoadOrder", false, 0),
     IceInternal::Property("Ice.PreferIPv6Address", false, 0),
@@ -145,10 +170,14 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ProgramName", false, 0),
     IceInternal::Property("Ice.RetryIntervals", false, 0),
     IceInternal::Property("Ice.ServerIdleTime", false, 0),
+    IceInternal::Property("Ice.Shm.RingSize", false, 0),
     IceInternal::Property("Ice.SOCKSProxyHost", false, 0),
     IceInternal::Property("Ice.SOCKSProxyPort", false, 0),
     IceInternal::Property("Ice.StdErr", false, 0),
     IceInternal::Property("Ice.StdOut", false, 0),
+    IceInternal::Property("Ice.StreamChunkSize", false, 0),
+    IceInternal::Property("Ice.StreamThreadPool.SizeMax", false, 0),
+    IceInternal::Property("Ice.StreamWindowSize", false, 0),
     IceInternal::Property("Ice.SyslogFacility", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.Size", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.SizeMax", false, 0),
@@ -157,6 +186,11 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Client.Serialize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.Backend", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.Shards", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.CpuAffinity", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.SpinMicros", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.BusyPoll", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Size", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.SizeMax", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.SizeWarn", false, 0),
@@ -164,7 +198,15 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Server.Serialize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.Backend", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.Shards", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.CpuAffinity", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.SpinMicros", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.BusyPoll", false, 0),
     IceInternal::Property("Ice.ThreadPriority", false, 0),
+    IceInternal::Property("Ice.TimerWheel", false, 0),
+    IceInternal::Property("Ice.TimerWheel.Threads", false, 0),
+    IceInternal::Property("Ice.TimerWheel.Tick", false, 0),
     IceInternal::Property("Ice.ToStringMode", false, 0),
     IceInternal::Property("Ice.Trace.Admin.Properties", false, 0),
     IceInternal::Property("Ice.Trace.Admin.Logger", false, 0),
@@ -174,6 +216,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Trace.Retry", false, 0),
     IceInternal::Property("Ice.Trace.Slicing", false, 0),
     IceInternal::Property("Ice.Trace.ThreadPool", false, 0),
+    IceInternal::Property("Ice.UDP.BatchSize", false, 0),
     IceInternal::Property("Ice.UDP.RcvSize", false, 0),
     IceInternal::Property("Ice.UDP.SndSize", false, 0),
     IceInternal::Property("Ice.TCP.Backlog", false, 0),
@@ -221,9 +264,11 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.Endpoints", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Locator.Priority", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.Router", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.CollocationOptimized", false, 0),
@@ -233,9 +278,11 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.ReplicaGroupId", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Router.Priority", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.Router", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.CollocationOptimized", false, 0),
@@ -249,6 +296,11 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.MessageSizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ACM.Heartbeat", false, 0),
@@ -258,9 +310,11 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.Endpoints", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Locator.Priority", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.Router", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.CollocationOptimized", false, 0),
@@ -270,9 +324,11 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.ReplicaGroupId", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Router.Priority", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.Router", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.CollocationOptimized", false, 0),
@@ -286,6 +342,11 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceDiscovery.Reply.MessageSizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ACM.Heartbeat", false, 0),
@@ -295,9 +356,11 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.Endpoints", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Locator.Priority", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.Router", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.CollocationOptimized", false, 0),
@@ -307,9 +370,11 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.ReplicaGroupId", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Router.Priority", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.Router", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.CollocationOptimized", false, 0),
@@ -323,6 +388,11 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceDiscovery.Locator.MessageSizeMax", false, 0),
     IceInternal::Property("IceDiscovery.Lookup", false, 0),
     IceInternal::Property("IceDiscovery.Timeout", false, 0),
@@ -348,9 +418,11 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.Endpoints", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Locator.Priority", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.Locator", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.CollocationOptimized", false, 0),
@@ -360,9 +432,11 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.ReplicaGroupId", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.PreferSecure", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Router.Priority", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.Locator", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.CollocationOptimized", false, 0),
@@ -376,6 +450,11 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.MessageSizeMax", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ACM.Heartbeat", false, 0),
@@ -385,9 +464,11 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.Endpoints", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Locator.Priority", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.Locator", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.CollocationOptimized", false, 0),
@@ -397,9 +478,11 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.ReplicaGroupId", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.PreferSecure", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Router.Priority", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.Locator", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.CollocationOptimized", false, 0),
@@ -413,6 +496,11 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.MessageSizeMax", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Lookup", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Timeout", false, 0),
@@ -457,9 +545,11 @@ const IceInternal::Property IceBoxAdminPropsData[] =
 {
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.EndpointSelection", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.ConnectionCached", false, 0),
+    IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.ConnectionStripes", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.PreferSecure", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.InvocationTimeout", false, 0),
+    IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.Priority", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.Locator", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.Router", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.CollocationOptimized", false, 0),
@@ -492,9 +582,11 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Endpoints", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.Priority", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.Locator", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.CollocationOptimized", false, 0),
@@ -504,9 +596,11 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.Priority", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.Locator", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.CollocationOptimized", false, 0),
@@ -520,6 +614,11 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.MessageSizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ACM.Timeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ACM.Heartbeat", false, 0),
@@ -529,9 +628,11 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Endpoints", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.Priority", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.Locator", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.CollocationOptimized", false, 0),
@@ -541,9 +642,11 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.Priority", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.Locator", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.CollocationOptimized", false, 0),
@@ -557,6 +660,11 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.MessageSizeMax", false, 0),
     IceInternal::Property("IceGridAdmin.Trace.Observers", false, 0),
     IceInternal::Property("IceGridAdmin.Trace.SaveToRegistry", false, 0),
@@ -576,9 +684,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.Endpoints", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Locator.Priority", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.CollocationOptimized", false, 0),
@@ -588,9 +698,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Router.Priority", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.Router", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.CollocationOptimized", false, 0),
@@ -604,6 +716,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.InstanceName", false, 0),
     IceInternal::Property("IceGrid.Node.ACM.Timeout", false, 0),
@@ -614,9 +731,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Node.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Node.Locator.Priority", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.CollocationOptimized", false, 0),
@@ -626,9 +745,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Node.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Node.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Node.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Node.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Node.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Node.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Node.Router.Priority", false, 0),
     IceInternal::Property("IceGrid.Node.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Node.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Node.Router.CollocationOptimized", false, 0),
@@ -642,6 +763,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceGrid.Node.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Node.AllowRunningServersAsRoot", false, 0),
     IceInternal::Property("IceGrid.Node.AllowEndpointsOverride", false, 0),
@@ -663,9 +789,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.UserAccounts", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Node.UserAccountMapper.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Node.UserAccountMapper.Priority", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.Locator", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.Router", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.CollocationOptimized", false, 0),
@@ -675,9 +803,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminCryptPasswords", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.CollocationOptimized", false, 0),
@@ -692,9 +822,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.CollocationOptimized", false, 0),
@@ -704,9 +836,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.CollocationOptimized", false, 0),
@@ -720,12 +854,19 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.CollocationOptimized", false, 0),
@@ -739,9 +880,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Locator.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.CollocationOptimized", false, 0),
@@ -751,9 +894,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Router.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.CollocationOptimized", false, 0),
@@ -767,6 +912,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.CryptPasswords", false, 0),
     IceInternal::Property("IceGrid.Registry.DefaultTemplates", false, 0),
@@ -778,9 +928,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Locator.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.CollocationOptimized", false, 0),
@@ -790,9 +942,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Router.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.CollocationOptimized", false, 0),
@@ -806,6 +960,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Enabled", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Address", false, 0),
@@ -820,9 +979,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Locator.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.CollocationOptimized", false, 0),
@@ -832,9 +993,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Router.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.CollocationOptimized", false, 0),
@@ -848,15 +1011,22 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.MapSize", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.Path", false, 0),
     IceInternal::Property("IceGrid.Registry.NodeSessionTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.PermissionsVerifier.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.PermissionsVerifier.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.CollocationOptimized", false, 0),
@@ -874,9 +1044,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Locator.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.CollocationOptimized", false, 0),
@@ -886,9 +1058,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Router.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.CollocationOptimized", false, 0),
@@ -902,6 +1076,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionFilters", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ACM.Timeout", false, 0),
@@ -912,9 +1091,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.Endpoints", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Locator.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.CollocationOptimized", false, 0),
@@ -924,9 +1105,11 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.ReplicaGroupId", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Router.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.CollocationOptimized", false, 0),
@@ -940,13 +1123,20 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.MessageSizeMax", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.ConnectionCached", false, 0),
+    IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.ConnectionStripes", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.Priority", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.CollocationOptimized", false, 0),
@@ -982,9 +1172,11 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.Endpoints", false, 0),
     IceInternal::Property("IcePatch2.Locator.EndpointSelection", false, 0),
     IceInternal::Property("IcePatch2.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("IcePatch2.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("IcePatch2.Locator.PreferSecure", false, 0),
     IceInternal::Property("IcePatch2.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IcePatch2.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IcePatch2.Locator.Priority", false, 0),
     IceInternal::Property("IcePatch2.Locator.Locator", false, 0),
     IceInternal::Property("IcePatch2.Locator.Router", false, 0),
     IceInternal::Property("IcePatch2.Locator.CollocationOptimized", false, 0),
@@ -994,9 +1186,11 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.ReplicaGroupId", false, 0),
     IceInternal::Property("IcePatch2.Router.EndpointSelection", false, 0),
     IceInternal::Property("IcePatch2.Router.ConnectionCached", false, 0),
+    IceInternal::Property("IcePatch2.Router.ConnectionStripes", false, 0),
     IceInternal::Property("IcePatch2.Router.PreferSecure", false, 0),
     IceInternal::Property("IcePatch2.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IcePatch2.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IcePatch2.Router.Priority", false, 0),
     IceInternal::Property("IcePatch2.Router.Locator", false, 0),
     IceInternal::Property("IcePatch2.Router.Router", false, 0),
     IceInternal::Property("IcePatch2.Router.CollocationOptimized", false, 0),
@@ -1010,6 +1204,11 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.ThreadPool.Serialize", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.Backend", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.Shards", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("IcePatch2.MessageSizeMax", false, 0),
     IceInternal::Property("IcePatch2.Directory", false, 0),
     IceInternal::Property("IcePatch2.InstanceName", false, 0),
@@ -1051,7 +1250,9 @@ const IceInternal::Property IceSSLPropsData[] =
     IceInternal::Property("IceSSL.EntropyDaemon", false, 0),
     IceInternal::Property("IceSSL.FindCert", false, 0),
     IceInternal::Property("IceSSL.FindCert.*", true, 0),
+    IceInternal::Property("IceSSL.HandshakeThreads", false, 0),
     IceInternal::Property("IceSSL.InitOpenSSL", false, 0),
+    IceInternal::Property("IceSSL.KernelTLS", false, 0),
     IceInternal::Property("IceSSL.KeyFile", true, 0),
     IceInternal::Property("IceSSL.Keychain", false, 0),
     IceInternal::Property("IceSSL.KeychainPassword", false, 0),
@@ -1066,7 +1267,12 @@ const IceInternal::Property IceSSLPropsData[] =
     IceInternal::Property("IceSSL.ProtocolVersionMin", false, 0),
     IceInternal::Property("IceSSL.Random", false, 0),
     IceInternal::Property("IceSSL.SchannelStrongCrypto", false, 0),
+    IceInternal::Property("IceSSL.SessionCache.Size", false, 0),
+    IceInternal::Property("IceSSL.SessionIdContext", false, 0),
+    IceInternal::Property("IceSSL.SessionTicketKeyFile", false, 0),
+    IceInternal::Property("IceSSL.SessionTicketLifetime", false, 0),
     IceInternal::Property("IceSSL.Trace.Security", false, 0),
+    IceInternal::Property("IceSSL.TrustCache.Size", false, 0),
     IceInternal::Property("IceSSL.TrustOnly", false, 0),
     IceInternal::Property("IceSSL.TrustOnly.Client", false, 0),
     IceInternal::Property("IceSSL.TrustOnly.Server", false, 0),
@@ -1115,9 +1321,11 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.Endpoints", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.EndpointSelection", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("Glacier2.Client.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.Client.Locator.Priority", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.Locator", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.Router", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.CollocationOptimized", false, 0),
@@ -1127,9 +1335,11 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.ReplicaGroupId", false, 0),
     IceInternal::Property("Glacier2.Client.Router.EndpointSelection", false, 0),
     IceInternal::Property("Glacier2.Client.Router.ConnectionCached", false, 0),
+    IceInternal::Property("Glacier2.Client.Router.ConnectionStripes", false, 0),
     IceInternal::Property("Glacier2.Client.Router.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.Client.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.Client.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.Client.Router.Priority", false, 0),
     IceInternal::Property("Glacier2.Client.Router.Locator", false, 0),
     IceInternal::Property("Glacier2.Client.Router.Router", false, 0),
     IceInternal::Property("Glacier2.Client.Router.CollocationOptimized", false, 0),
@@ -1143,6 +1353,11 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.Backend", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.Shards", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("Glacier2.Client.MessageSizeMax", false, 0),
     IceInternal::Property("Glacier2.Client.AlwaysBatch", false, 0),
     IceInternal::Property("Glacier2.Client.Buffered", false, 0),
@@ -1162,9 +1377,11 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.InstanceName", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.ConnectionCached", false, 0),
+    IceInternal::Property("Glacier2.PermissionsVerifier.ConnectionStripes", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.PermissionsVerifier.Priority", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.Locator", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.Router", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.CollocationOptimized", false, 0),
@@ -1173,9 +1390,11 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.ReturnClientProxy", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.EndpointSelection", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.ConnectionCached", false, 0),
+    IceInternal::Property("Glacier2.SSLPermissionsVerifier.ConnectionStripes", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.SSLPermissionsVerifier.Priority", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.Locator", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.Router", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.CollocationOptimized", false, 0),
@@ -1190,9 +1409,11 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.Endpoints", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.EndpointSelection", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.ConnectionCached", false, 0),
+    IceInternal::Property("Glacier2.Server.Locator.ConnectionStripes", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.Server.Locator.Priority", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.Locator", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.Router", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.CollocationOptimized", false, 0),
@@ -1202,9 +1423,11 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.ReplicaGroupId", false, 0),
     IceInternal::Property("Glacier2.Server.Router.EndpointSelection", false, 0),
     IceInternal::Property("Glacier2.Server.Router.ConnectionCached", false, 0),
+    IceInternal::Property("Glacier2.Server.Router.ConnectionStripes", false, 0),
     IceInternal::Property("Glacier2.Server.Router.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.Server.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.Server.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.Server.Router.Priority", false, 0),
     IceInternal::Property("Glacier2.Server.Router.Locator", false, 0),
     IceInternal::Property("Glacier2.Server.Router.Router", false, 0),
     IceInternal::Property("Glacier2.Server.Router.CollocationOptimized", false, 0),
@@ -1218,6 +1441,11 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.ThreadPool.Serialize", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadPriority", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.Backend", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.Shards", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.CpuAffinity", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.SpinMicros", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.BusyPoll", false, 0),
     IceInternal::Property("Glacier2.Server.MessageSizeMax", false, 0),
     IceInternal::Property("Glacier2.Server.AlwaysBatch", false, 0),
     IceInternal::Property("Glacier2.Server.Buffered", false, 0),
@@ -1227,9 +1455,11 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.Trace.Request", false, 0),
     IceInternal::Property("Glacier2.SessionManager.EndpointSelection", false, 0),
     IceInternal::Property("Glacier2.SessionManager.ConnectionCached", false, 0),
+    IceInternal::Property("Glacier2.SessionManager.ConnectionStripes", false, 0),
     IceInternal::Property("Glacier2.SessionManager.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.SessionManager.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.SessionManager.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.SessionManager.Priority", false, 0),
     IceInternal::Property("Glacier2.SessionManager.Locator", false, 0),
     IceInternal::Property("Glacier2.SessionManager.Router", false, 0),
     IceInternal::Property("Glacier2.SessionManager.CollocationOptimized", false, 0),
@@ -1237,9 +1467,11 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.SessionManager", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.EndpointSelection", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.ConnectionCached", false, 0),
+    IceInternal::Property("Glacier2.SSLSessionManager.ConnectionStripes", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.SSLSessionManager.Priority", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.Locator", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.Router", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.CollocationOptimized", false, 0),
@@ -62,6 +62,56 @@ const Ice::Byte replyHdr[] =
     0, 0, 0, 0 // Message size (placeholder)
 };
 
+const Ice::Byte fragmentHdr[] =
+{
+    magic[0],
+    magic[1],
+    magic[2],
+    magic[3],
+    protocolMajor,
+    protocolMinor,
+    protocolEncodingMajor,
+    protocolEncodingMinor,
+    fragmentMsg,
+    0, // Compression status
+    0, 0, 0, 0, // Message size (placeholder)
+    0, 0, 0, 0 // Fragmented message id (placeholder)
+};
+
+const Ice::Byte streamChunkHdr[] =
+{
+    magic[0],
+    magic[1],
+    magic[2],
+    magic[3],
+    protocolMajor,
+    protocolMinor,
+    protocolEncodingMajor,
+    protocolEncodingMinor,
+    streamChunkMsg,
+    0, // Compression status
+    0, 0, 0, 0, // Message size (placeholder)
+    0, 0, 0, 0, // Request id (placeholder)
+    0 // Stream flags (placeholder)
+};
+
+const Ice::Byte streamCreditHdr[] =
+{
+    magic[0],
+    magic[1],
+    magic[2],
+    magic[3],
+    protocolMajor,
+    protocolMinor,
+    protocolEncodingMajor,
+    protocolEncodingMinor,
+    streamCreditMsg,
+    0, // Compression status
+    0, 0, 0, 0, // Message size (placeholder)
+    0, 0, 0, 0, // Request id (placeholder)
+    0 // Stream flags (placeholder)
+};
+
 void
 stringToMajorMinor(const std::string& str, Ice::Byte& major, Ice::Byte& minor)
 {
@@ -121,6 +121,12 @@ IceInternal::ProtocolInstance::messageSizeMax() const
     return _instance->messageSizeMax();
 }
 
+BufferPool*
+IceInternal::ProtocolInstance::bufferPool() const
+{
+    return _instance->bufferPool();
+}
+
 void
 IceInternal::ProtocolInstance::resolve(const string& host, int port, EndpointSelectionType type,
                                        const IPEndpointIPtr& endpt, const EndpointI_connectorsPtr& cb) const
@@ -73,6 +73,7 @@ public:
     const Ice::EncodingVersion& defaultEncoding() const;
     NetworkProxyPtr networkProxy() const;
     size_t messageSizeMax() const;
+    BufferPool* bufferPool() const;
     int defaultTimeout() const;
 
     void resolve(const std::string&, int, Ice::EndpointSelectionType, const IPEndpointIPtr&,
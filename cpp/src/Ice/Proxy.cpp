@@ -86,7 +86,8 @@ ProxyFlushBatchAsync::invokeRemote(const ConnectionIPtr& connection, bool compre
         }
     }
     _cachedConnection = connection;
-    return connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, compress, false, _batchRequestNum);
+    return connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, compress, false, _batchRequestNum,
+                                         _proxy->_getReference()->getPriority());
 }
 
 AsyncStatus
@@ -147,6 +148,12 @@ ProxyGetConnection::getConnection() const
     return _cachedConnection;
 }
 
+bool
+ProxyGetConnection::sendsMessage() const
+{
+    return false;
+}
+
 void
 ProxyGetConnection::invoke(const string& operation)
 {
@@ -887,6 +894,33 @@ ICE_OBJECT_PRX::ice_connectionCached(bool newCache) const
     }
 }
 
+Int
+ICE_OBJECT_PRX::ice_getConnectionStripes() const
+{
+    return _reference->getConnectionStripes();
+}
+
+ObjectPrxPtr
+ICE_OBJECT_PRX::ice_connectionStripes(Int newStripes) const
+{
+    if(newStripes < 1)
+    {
+        ostringstream s;
+        s << "invalid value passed to ice_connectionStripes: " << newStripes;
+        throw IceUtil::IllegalArgumentException(__FILE__, __LINE__, s.str());
+    }
+    if(newStripes == _reference->getConnectionStripes())
+    {
+        return CONST_POINTER_CAST_OBJECT_PRX;
+    }
+    else
+    {
+        ObjectPrxPtr proxy = _newInstance();
+        proxy->setup(_reference->changeConnectionStripes(newStripes));
+        return proxy;
+    }
+}
+
 EndpointSelectionType
 ICE_OBJECT_PRX::ice_getEndpointSelection() const
 {
@@ -1073,6 +1107,27 @@ ICE_OBJECT_PRX::ice_invocationTimeout(Int newTimeout) const
     }
 }
 
+Int
+ICE_OBJECT_PRX::ice_getPriority() const
+{
+    return _reference->getPriority();
+}
+
+ObjectPrxPtr
+ICE_OBJECT_PRX::ice_priority(Int newPriority) const
+{
+    if(newPriority == _reference->getPriority())
+    {
+        return CONST_POINTER_CAST_OBJECT_PRX;
+    }
+    else
+    {
+        ObjectPrxPtr proxy = _newInstance();
+        proxy->setup(_reference->changePriority(newPriority));
+        return proxy;
+    }
+}
+
 ObjectPrxPtr
 ICE_OBJECT_PRX::ice_twoway() const
 {
@@ -1327,7 +1382,7 @@ ICE_OBJECT_PRX::_handleException(const Exception& ex,
 ICE_OBJECT_PRX::_getRequestHandler()
 {
     RequestHandlerPtr handler;
-    if(_reference->getCacheConnection())
+    if(_reference->getCacheRequestHandler())
     {
         IceUtil::Mutex::Lock sync(_mutex);
         if(_requestHandler)
@@ -1352,7 +1407,7 @@ ICE_OBJECT_PRX::_getBatchRequestQueue()
 ::IceInternal::RequestHandlerPtr
 ICE_OBJECT_PRX::_setRequestHandler(const ::IceInternal::RequestHandlerPtr& handler)
 {
-    if(_reference->getCacheConnection())
+    if(_reference->getCacheRequestHandler())
     {
         IceUtil::Mutex::Lock sync(_mutex);
         if(!_requestHandler)
@@ -1368,7 +1423,7 @@ void
 ICE_OBJECT_PRX::_updateRequestHandler(const ::IceInternal::RequestHandlerPtr& previous,
                                               const ::IceInternal::RequestHandlerPtr& handler)
 {
-    if(_reference->getCacheConnection() && previous)
+    if(_reference->getCacheRequestHandler() && previous)
     {
         IceUtil::Mutex::Lock sync(_mutex);
         if(_requestHandler && _requestHandler.get() != handler.get())
@@ -219,6 +219,15 @@ IceInternal::ProxyFactory::checkRetryAfterException(const LocalException& ex, co
         ex.ice_throw();
     }
 
+    //
+    // Don't retry if the send queue of the connection is full, the
+    // application is responsible for slowing down.
+    //
+    if(dynamic_cast<const SendQueueFullException*>(&ex))
+    {
+        ex.ice_throw();
+    }
+
     ++cnt;
     assert(cnt > 0);
 
@@ -149,6 +149,18 @@ IceInternal::Reference::changeInvocationTimeout(int invocationTimeout) const
     return r;
 }
 
+ReferencePtr
+IceInternal::Reference::changePriority(int priority) const
+{
+    if(_priority == priority)
+    {
+        return ReferencePtr(const_cast<Reference*>(this));
+    }
+    ReferencePtr r = _instance->referenceFactory()->copy(this);
+    r->_priority = priority;
+    return r;
+}
+
 ReferencePtr
 IceInternal::Reference::changeEncoding(const Ice::EncodingVersion& encoding) const
 {
@@ -402,6 +414,11 @@ IceInternal::Reference::operator==(const Reference& r) const
     {
         return false;
     }
+
+    if(_priority != r._priority)
+    {
+        return false;
+    }
     return true;
 }
 
@@ -504,6 +521,15 @@ IceInternal::Reference::operator<(const Reference& r) const
         return false;
     }
 
+    if(_priority < r._priority)
+    {
+        return true;
+    }
+    else if(r._priority < _priority)
+    {
+        return false;
+    }
+
     return false;
 }
 
@@ -538,6 +564,7 @@ IceInternal::Reference::Reference(const InstancePtr& instance,
                                   const ProtocolVersion& protocol,
                                   const EncodingVersion& encoding,
                                   int invocationTimeout,
+                                  int priority,
                                   const Ice::Context& ctx) :
     _hashInitialized(false),
     _instance(instance),
@@ -550,6 +577,7 @@ IceInternal::Reference::Reference(const InstancePtr& instance,
     _protocol(protocol),
     _encoding(encoding),
     _invocationTimeout(invocationTimeout),
+    _priority(priority),
     _overrideCompress(false),
     _compress(false)
 {
@@ -567,6 +595,7 @@ IceInternal::Reference::Reference(const Reference& r) :
     _protocol(r._protocol),
     _encoding(r._encoding),
     _invocationTimeout(r._invocationTimeout),
+    _priority(r._priority),
     _overrideCompress(r._overrideCompress),
     _compress(r._compress)
 {
@@ -592,6 +621,7 @@ IceInternal::Reference::hashInit() const
     hashAdd(h, _encoding.major);
     hashAdd(h, _encoding.minor);
     hashAdd(h, _invocationTimeout);
+    hashAdd(h, _priority);
     return h;
 }
 
@@ -605,7 +635,7 @@ IceInternal::FixedReference::FixedReference(const InstancePtr& instance,
                                             bool secure,
                                             const EncodingVersion& encoding,
                                             const ConnectionIPtr& fixedConnection) :
-    Reference(instance, communicator, id, facet, mode, secure, Ice::Protocol_1_0, encoding, -1, Ice::Context()),
+    Reference(instance, communicator, id, facet, mode, secure, Ice::Protocol_1_0, encoding, -1, 0, Ice::Context()),
     _fixedConnection(fixedConnection)
 {
 }
@@ -634,6 +664,12 @@ IceInternal::FixedReference::getCacheConnection() const
     return true;
 }
 
+int
+IceInternal::FixedReference::getConnectionStripes() const
+{
+    return 1;
+}
+
 bool
 IceInternal::FixedReference::getPreferSecure() const
 {
@@ -700,6 +736,13 @@ IceInternal::FixedReference::changeCacheConnection(bool) const
     return 0; // Keep the compiler happy.
 }
 
+ReferencePtr
+IceInternal::FixedReference::changeConnectionStripes(int) const
+{
+    throw FixedProxyException(__FILE__, __LINE__);
+    return 0; // Keep the compiler happy.
+}
+
 ReferencePtr
 IceInternal::FixedReference::changePreferSecure(bool) const
 {
@@ -898,18 +941,21 @@ IceInternal::RoutableReference::RoutableReference(const InstancePtr& instance,
                                                   const RouterInfoPtr& routerInfo,
                                                   bool collocationOptimized,
                                                   bool cacheConnection,
+                                                  int connectionStripes,
                                                   bool preferSecure,
                                                   EndpointSelectionType endpointSelection,
                                                   int locatorCacheTimeout,
                                                   int invocationTimeout,
+                                                  int priority,
                                                   const Ice::Context& ctx) :
-    Reference(instance, communicator, id, facet, mode, secure, protocol, encoding, invocationTimeout, ctx),
+    Reference(instance, communicator, id, facet, mode, secure, protocol, encoding, invocationTimeout, priority, ctx),
     _endpoints(endpoints),
     _adapterId(adapterId),
     _locatorInfo(locatorInfo),
     _routerInfo(routerInfo),
     _collocationOptimized(collocationOptimized),
     _cacheConnection(cacheConnection),
+    _connectionStripes(connectionStripes),
     _preferSecure(preferSecure),
     _endpointSelection(endpointSelection),
     _locatorCacheTimeout(locatorCacheTimeout),
@@ -955,6 +1001,12 @@ IceInternal::RoutableReference::getCacheConnection() const
     return _cacheConnection;
 }
 
+int
+IceInternal::RoutableReference::getConnectionStripes() const
+{
+    return _connectionStripes;
+}
+
 bool
 IceInternal::RoutableReference::getPreferSecure() const
 {
@@ -1088,6 +1140,18 @@ IceInternal::RoutableReference::changeCacheConnection(bool newCache) const
     return r;
 }
 
+ReferencePtr
+IceInternal::RoutableReference::changeConnectionStripes(int newStripes) const
+{
+    if(newStripes == _connectionStripes)
+    {
+        return RoutableReferencePtr(const_cast<RoutableReference*>(this));
+    }
+    RoutableReferencePtr r = RoutableReferencePtr::dynamicCast(getInstance()->referenceFactory()->copy(this));
+    r->_connectionStripes = newStripes;
+    return r;
+}
+
 ReferencePtr
 IceInternal::RoutableReference::changePreferSecure(bool newPreferSecure) const
 {
@@ -1261,6 +1325,11 @@ IceInternal::RoutableReference::toProperty(const string& prefix) const
     properties[prefix] = toString();
     properties[prefix + ".CollocationOptimized"] = _collocationOptimized ? "1" : "0";
     properties[prefix + ".ConnectionCached"] = _cacheConnection ? "1" : "0";
+    {
+        ostringstream s;
+        s << _connectionStripes;
+        properties[prefix + ".ConnectionStripes"] = s.str();
+    }
     properties[prefix + ".PreferSecure"] = _preferSecure ? "1" : "0";
     properties[prefix + ".EndpointSelection"] = _endpointSelection == ICE_ENUM(EndpointSelectionType, Random) ? "Random" : "Ordered";
     {
@@ -1273,6 +1342,11 @@ IceInternal::RoutableReference::toProperty(const string& prefix) const
         s << getInvocationTimeout();
         properties[prefix + ".InvocationTimeout"] = s.str();
     }
+    {
+        ostringstream s;
+        s << getPriority();
+        properties[prefix + ".Priority"] = s.str();
+    }
     if(_routerInfo)
     {
         PropertyDict routerProperties = _routerInfo->getRouter()->_getReference()->toProperty(prefix + ".Router");
@@ -1330,6 +1404,10 @@ IceInternal::RoutableReference::operator==(const Reference& r) const
     {
         return false;
     }
+    if(_connectionStripes != rhs->_connectionStripes)
+    {
+        return false;
+    }
     if(_endpointSelection != rhs->_endpointSelection)
     {
         return false;
@@ -1422,6 +1500,14 @@ IceInternal::RoutableReference::operator<(const Reference& r) const
     {
         return false;
     }
+    if(_connectionStripes < rhs->_connectionStripes)
+    {
+        return true;
+    }
+    else if(rhs->_connectionStripes < _connectionStripes)
+    {
+        return false;
+    }
     if(_endpointSelection < rhs->_endpointSelection)
     {
         return true;
@@ -1741,7 +1827,8 @@ IceInternal::RoutableReference::createConnection(const vector<EndpointIPtr>& all
         // Get an existing connection or create one if there's no
         // existing connection to one of the given endpoints.
         //
-        factory->create(endpoints, false, getEndpointSelection(), new CB1(_routerInfo, callback));
+        factory->create(endpoints, false, getEndpointSelection(), _connectionStripes,
+                        new CB1(_routerInfo, callback));
         return;
     }
     else
@@ -1784,7 +1871,8 @@ IceInternal::RoutableReference::createConnection(const vector<EndpointIPtr>& all
                 endpoint.push_back(_endpoints[_i]);
 
                 OutgoingConnectionFactoryPtr factory = _reference->getInstance()->outgoingConnectionFactory();
-                factory->create(endpoint, more, _reference->getEndpointSelection(), this);
+                factory->create(endpoint, more, _reference->getEndpointSelection(),
+                                _reference->getConnectionStripes(), this);
             }
 
             CB2(const RoutableReferencePtr& reference, const vector<EndpointIPtr>& endpoints,
@@ -1816,7 +1904,8 @@ IceInternal::RoutableReference::createConnection(const vector<EndpointIPtr>& all
         vector<EndpointIPtr> endpt;
         endpt.push_back(endpoints[0]);
         RoutableReference* self = const_cast<RoutableReference*>(this);
-        factory->create(endpt, true, getEndpointSelection(), new CB2(self, endpoints, callback));
+        factory->create(endpt, true, getEndpointSelection(), _connectionStripes,
+                        new CB2(self, endpoints, callback));
         return;
     }
 }
@@ -1846,6 +1935,7 @@ IceInternal::RoutableReference::RoutableReference(const RoutableReference& r) :
     _routerInfo(r._routerInfo),
     _collocationOptimized(r._collocationOptimized),
     _cacheConnection(r._cacheConnection),
+    _connectionStripes(r._connectionStripes),
     _preferSecure(r._preferSecure),
     _endpointSelection(r._endpointSelection),
     _locatorCacheTimeout(r._locatorCacheTimeout),
@@ -72,6 +72,7 @@ public:
     const InstancePtr& getInstance() const { return _instance; }
     const SharedContextPtr& getContext() const { return _context; }
     int getInvocationTimeout() const { return _invocationTimeout; }
+    int getPriority() const { return _priority; }
 
     Ice::CommunicatorPtr getCommunicator() const;
 
@@ -82,11 +83,22 @@ public:
     virtual RouterInfoPtr getRouterInfo() const { return 0; }
     virtual bool getCollocationOptimized() const = 0;
     virtual bool getCacheConnection() const = 0;
+    virtual int getConnectionStripes() const = 0;
     virtual bool getPreferSecure() const = 0;
     virtual Ice::EndpointSelectionType getEndpointSelection() const = 0;
     virtual int getLocatorCacheTimeout() const = 0;
     virtual std::string getConnectionId() const = 0;
 
+    //
+    // The request handler is only cached if the connection is cached
+    // and there's a single connection stripe, otherwise the connection
+    // is selected for each invocation.
+    //
+    bool getCacheRequestHandler() const
+    {
+        return getCacheConnection() && getConnectionStripes() == 1;
+    }
+
     //
     // The change* methods (here and in derived classes) create
     // a new reference based on the existing one, with the
@@ -98,6 +110,7 @@ public:
     ReferencePtr changeIdentity(const Ice::Identity&) const;
     ReferencePtr changeFacet(const std::string&) const;
     ReferencePtr changeInvocationTimeout(int) const;
+    ReferencePtr changePriority(int) const;
     virtual ReferencePtr changeEncoding(const Ice::EncodingVersion&) const;
     virtual ReferencePtr changeCompress(bool) const;
 
@@ -108,6 +121,7 @@ public:
     virtual ReferencePtr changeCollocationOptimized(bool) const = 0;
     virtual ReferencePtr changeLocatorCacheTimeout(int) const = 0;
     virtual ReferencePtr changeCacheConnection(bool) const = 0;
+    virtual ReferencePtr changeConnectionStripes(int) const = 0;
     virtual ReferencePtr changePreferSecure(bool) const = 0;
     virtual ReferencePtr changeEndpointSelection(Ice::EndpointSelectionType) const = 0;
 
@@ -153,7 +167,7 @@ public:
 protected:
 
     Reference(const InstancePtr&, const Ice::CommunicatorPtr&, const Ice::Identity&, const std::string&, Mode, bool,
-              const Ice::ProtocolVersion&, const Ice::EncodingVersion&, int, const Ice::Context& ctx);
+              const Ice::ProtocolVersion&, const Ice::EncodingVersion&, int, int, const Ice::Context& ctx);
     Reference(const Reference&);
 
     virtual Ice::Int hashInit() const;
@@ -174,6 +188,7 @@ private:
     Ice::ProtocolVersion _protocol;
     Ice::EncodingVersion _encoding;
     int _invocationTimeout;
+    int _priority;
 
 protected:
 
@@ -192,6 +207,7 @@ public:
     virtual std::string getAdapterId() const;
     virtual bool getCollocationOptimized() const;
     virtual bool getCacheConnection() const;
+    virtual int getConnectionStripes() const;
     virtual bool getPreferSecure() const;
     virtual Ice::EndpointSelectionType getEndpointSelection() const;
     virtual int getLocatorCacheTimeout() const;
@@ -203,6 +219,7 @@ public:
     virtual ReferencePtr changeRouter(const Ice::RouterPrxPtr&) const;
     virtual ReferencePtr changeCollocationOptimized(bool) const;
     virtual ReferencePtr changeCacheConnection(bool) const;
+    virtual ReferencePtr changeConnectionStripes(int) const;
     virtual ReferencePtr changePreferSecure(bool) const;
     virtual ReferencePtr changeEndpointSelection(Ice::EndpointSelectionType) const;
     virtual ReferencePtr changeLocatorCacheTimeout(int) const;
@@ -237,8 +254,8 @@ public:
 
     RoutableReference(const InstancePtr&, const Ice::CommunicatorPtr&, const Ice::Identity&, const std::string&, Mode,
                       bool, const Ice::ProtocolVersion&, const Ice::EncodingVersion&, const std::vector<EndpointIPtr>&,
-                      const std::string&, const LocatorInfoPtr&, const RouterInfoPtr&, bool, bool, bool,
-                      Ice::EndpointSelectionType, int, int, const Ice::Context&);
+                      const std::string&, const LocatorInfoPtr&, const RouterInfoPtr&, bool, bool, int, bool,
+                      Ice::EndpointSelectionType, int, int, int, const Ice::Context&);
 
     virtual std::vector<EndpointIPtr> getEndpoints() const;
     virtual std::string getAdapterId() const;
@@ -246,6 +263,7 @@ public:
     virtual RouterInfoPtr getRouterInfo() const;
     virtual bool getCollocationOptimized() const;
     virtual bool getCacheConnection() const;
+    virtual int getConnectionStripes() const;
     virtual bool getPreferSecure() const;
     virtual Ice::EndpointSelectionType getEndpointSelection() const;
     virtual int getLocatorCacheTimeout() const;
@@ -259,6 +277,7 @@ public:
     virtual ReferencePtr changeRouter(const Ice::RouterPrxPtr&) const;
     virtual ReferencePtr changeCollocationOptimized(bool) const;
     virtual ReferencePtr changeCacheConnection(bool) const;
+    virtual ReferencePtr changeConnectionStripes(int) const;
     virtual ReferencePtr changePreferSecure(bool) const;
     virtual ReferencePtr changeEndpointSelection(Ice::EndpointSelectionType) const;
     virtual ReferencePtr changeLocatorCacheTimeout(int) const;
@@ -304,6 +323,7 @@ private:
     RouterInfoPtr _routerInfo; // Null if no router is used.
     bool _collocationOptimized;
     bool _cacheConnection;
+    int _connectionStripes;
     bool _preferSecure;
     Ice::EndpointSelectionType _endpointSelection;
     int _locatorCacheTimeout;
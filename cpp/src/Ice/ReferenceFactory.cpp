@@ -710,9 +710,11 @@ IceInternal::ReferenceFactory::checkForUnknownProperties(const string& prefix)
     {
         "EndpointSelection",
         "ConnectionCached",
+        "ConnectionStripes",
         "PreferSecure",
         "LocatorCacheTimeout",
         "InvocationTimeout",
+        "Priority",
         "Locator",
         "Router",
         "CollocationOptimized",
@@ -793,10 +795,12 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
     RouterInfoPtr routerInfo = _instance->routerManager()->get(_defaultRouter);
     bool collocationOptimized = defaultsAndOverrides->defaultCollocationOptimization;
     bool cacheConnection = true;
+    int connectionStripes = 1;
     bool preferSecure = defaultsAndOverrides->defaultPreferSecure;
     Ice::EndpointSelectionType endpointSelection = defaultsAndOverrides->defaultEndpointSelection;
     int locatorCacheTimeout = defaultsAndOverrides->defaultLocatorCacheTimeout;
     int invocationTimeout = defaultsAndOverrides->defaultInvocationTimeout;
+    int priority = 0;
     Ice::Context ctx;
 
     //
@@ -848,6 +852,21 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
         property = propertyPrefix + ".ConnectionCached";
         cacheConnection = properties->getPropertyAsIntWithDefault(property, cacheConnection) > 0;
 
+        property = propertyPrefix + ".ConnectionStripes";
+        string value = properties->getProperty(property);
+        if(!value.empty())
+        {
+            connectionStripes = properties->getPropertyAsIntWithDefault(property, connectionStripes);
+            if(connectionStripes < 1)
+            {
+                connectionStripes = 1;
+
+                Warning out(_instance->initializationData().logger);
+                out << "invalid value for " << property << "`" << properties->getProperty(property) << "'"
+                    << ": defaulting to 1";
+            }
+        }
+
         property = propertyPrefix + ".PreferSecure";
         preferSecure = properties->getPropertyAsIntWithDefault(property, preferSecure) > 0;
 
@@ -872,7 +891,7 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
         }
 
         property = propertyPrefix + ".LocatorCacheTimeout";
-        string value = properties->getProperty(property);
+        value = properties->getProperty(property);
         if(!value.empty())
         {
             locatorCacheTimeout = properties->getPropertyAsIntWithDefault(property, locatorCacheTimeout);
@@ -901,6 +920,9 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
             }
         }
 
+        property = propertyPrefix + ".Priority";
+        priority = properties->getPropertyAsIntWithDefault(property, priority);
+
         property = propertyPrefix + ".Context.";
         PropertyDict contexts = properties->getPropertiesForPrefix(property);
         for(PropertyDict::const_iterator p = contexts.begin(); p != contexts.end(); ++p)
@@ -926,9 +948,11 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
                                  routerInfo,
                                  collocationOptimized,
                                  cacheConnection,
+                                 connectionStripes,
                                  preferSecure,
                                  endpointSelection,
                                  locatorCacheTimeout,
                                  invocationTimeout,
+                                 priority,
                                  ctx);
 }
@@ -10,12 +10,16 @@
 #include <Ice/RegisterPluginsInit.h>
 #include <Ice/CommunicatorF.h>
 #include <Ice/Initialize.h>
+#include <Ice/Network.h> // For ICE_USE_UNIX_SOCKETS
 
 extern "C"
 {
 
 Ice::Plugin* createIceUDP(const Ice::CommunicatorPtr&, const std::string&, const Ice::StringSeq&);
 Ice::Plugin* createIceTCP(const Ice::CommunicatorPtr&, const std::string&, const Ice::StringSeq&);
+#ifdef ICE_USE_UNIX_SOCKETS
+Ice::Plugin* createIceUnix(const Ice::CommunicatorPtr&, const std::string&, const Ice::StringSeq&);
+#endif
 
 };
 
@@ -23,4 +27,7 @@ IceInternal::RegisterPluginsInit::RegisterPluginsInit()
 {
     Ice::registerPluginFactory("IceUDP", createIceUDP, true);
     Ice::registerPluginFactory("IceTCP", createIceTCP, true);
+#ifdef ICE_USE_UNIX_SOCKETS
+    Ice::registerPluginFactory("IceUnix", createIceUnix, true);
+#endif
 }
@@ -36,7 +36,7 @@ IceInternal::RequestHandlerFactory::getRequestHandler(const RoutableReferencePtr
 
     ConnectRequestHandlerPtr handler;
     bool connect = false;
-    if(ref->getCacheConnection())
+    if(ref->getCacheRequestHandler())
     {
         Lock sync(*this);
         map<ReferencePtr, ConnectRequestHandlerPtr>::iterator p = _handlers.find(ref);
@@ -70,7 +70,7 @@ IceInternal::RequestHandlerFactory::getRequestHandler(const RoutableReferencePtr
 void
 IceInternal::RequestHandlerFactory::removeRequestHandler(const ReferencePtr& ref, const RequestHandlerPtr& handler)
 {
-    if(ref->getCacheConnection())
+    if(ref->getCacheRequestHandler())
     {
         Lock sync(*this);
         map<ReferencePtr, ConnectRequestHandlerPtr>::iterator p = _handlers.find(ref);
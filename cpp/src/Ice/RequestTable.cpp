@@ -0,0 +1,167 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/RequestTable.h>
+#include <Ice/OutgoingAsync.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+namespace
+{
+
+const size_t initialSize = 16;
+
+}
+
+IceInternal::RequestTable::RequestTable() :
+    _mask(0),
+    _size(0),
+    _bytes(0),
+    _nextRequestId(1)
+{
+}
+
+Int
+IceInternal::RequestTable::add(const OutgoingAsyncBasePtr& outAsync, size_t bytes)
+{
+    if(_size >= _slots.size() / 2)
+    {
+        grow();
+    }
+
+    while(true)
+    {
+        Int requestId = _nextRequestId++;
+        if(requestId <= 0)
+        {
+            _nextRequestId = 1;
+            requestId = _nextRequestId++;
+        }
+
+        Slot& slot = _slots[static_cast<size_t>(requestId) & _mask];
+        if(slot.requestId == 0)
+        {
+            slot.requestId = requestId;
+            slot.outAsync = outAsync;
+            slot.bytes = static_cast<int>(bytes);
+            _bytes.fetch_add(slot.bytes);
+            ++_size;
+            return requestId;
+        }
+    }
+}
+
+OutgoingAsyncBasePtr
+IceInternal::RequestTable::remove(Int requestId)
+{
+    OutgoingAsyncBasePtr outAsync;
+    if(_size > 0 && requestId > 0)
+    {
+        Slot& slot = _slots[static_cast<size_t>(requestId) & _mask];
+        if(slot.requestId == requestId)
+        {
+            slot.requestId = 0;
+            swap(outAsync, slot.outAsync);
+            _bytes.fetch_sub(slot.bytes);
+            --_size;
+
+            if(_slots.size() > initialSize && _size == _slots.size() / 8)
+            {
+                shrink();
+            }
+        }
+    }
+    return outAsync;
+}
+
+Int
+IceInternal::RequestTable::find(const OutgoingAsyncBasePtr& outAsync) const
+{
+    if(_size > 0)
+    {
+        for(vector<Slot>::const_iterator p = _slots.begin(); p != _slots.end(); ++p)
+        {
+            if(p->requestId != 0 && p->outAsync == outAsync)
+            {
+                return p->requestId;
+            }
+        }
+    }
+    return 0;
+}
+
+void
+IceInternal::RequestTable::clear()
+{
+    for(vector<Slot>::iterator p = _slots.begin(); _size > 0 && p != _slots.end(); ++p)
+    {
+        if(p->requestId != 0)
+        {
+            p->requestId = 0;
+            p->outAsync = 0;
+            _bytes.fetch_sub(p->bytes);
+            --_size;
+        }
+    }
+    assert(_size == 0);
+    assert(_bytes.load() == 0);
+}
+
+void
+IceInternal::RequestTable::grow()
+{
+    //
+    // The slot of a request in the new table is given by one more bit of
+    // its ID, two requests from distinct slots can't collide.
+    //
+    vector<Slot> slots(_slots.empty() ? initialSize : _slots.size() * 2);
+    const size_t mask = slots.size() - 1;
+    for(vector<Slot>::iterator p = _slots.begin(); p != _slots.end(); ++p)
+    {
+        if(p->requestId != 0)
+        {
+            Slot& slot = slots[static_cast<size_t>(p->requestId) & mask];
+            assert(slot.requestId == 0);
+            slot.requestId = p->requestId;
+            slot.bytes = p->bytes;
+            swap(slot.outAsync, p->outAsync);
+        }
+    }
+    _slots.swap(slots);
+    _mask = mask;
+}
+
+void
+IceInternal::RequestTable::shrink()
+{
+    //
+    // The slot of a request in the new table is given by one less bit of
+    // its ID, two requests whose slots only differ by this bit collide.
+    // The table isn't shrunk in this case, it's shrunk once it's sparse
+    // again.
+    //
+    vector<Slot> slots(_slots.size() / 2);
+    const size_t mask = slots.size() - 1;
+    for(vector<Slot>::const_iterator p = _slots.begin(); p != _slots.end(); ++p)
+    {
+        if(p->requestId != 0)
+        {
+            Slot& slot = slots[static_cast<size_t>(p->requestId) & mask];
+            if(slot.requestId != 0)
+            {
+                return;
+            }
+            slot = *p;
+        }
+    }
+    _slots.swap(slots);
+    _mask = mask;
+}
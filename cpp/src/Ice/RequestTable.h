@@ -0,0 +1,163 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_REQUEST_TABLE_H
+#define ICE_REQUEST_TABLE_H
+
+#include <Ice/OutgoingAsyncF.h>
+#include <IceUtil/Atomic.h>
+
+#include <vector>
+
+namespace IceInternal
+{
+
+//
+// The table of the requests waiting for a reply on a connection, it
+// also allocates the request IDs.
+//
+// The table is an array of slots whose size is a power of two. The low
+// bits of a request ID are the index of the slot of the request and the
+// high bits a generation tag: IDs are still allocated sequentially but
+// those whose slot is in use are skipped. Adding, finding and removing
+// a request are therefore O(1) and don't allocate memory, except when
+// the table grows. The table is kept at most half full so that few IDs
+// are skipped. It shrinks once it's sparse, so that finding a request
+// by scanning the table isn't slowed down by a past burst of requests.
+// An ID isn't reused before the 31-bit counter wraps.
+//
+// The table also keeps the total size of its requests, it can be read
+// without the connection lock.
+//
+class RequestTable
+{
+    struct Slot
+    {
+        Slot() : requestId(0), bytes(0)
+        {
+        }
+
+        Ice::Int requestId;
+        OutgoingAsyncBasePtr outAsync;
+        int bytes;
+    };
+
+public:
+
+    class const_iterator
+    {
+    public:
+
+        const_iterator(const std::vector<Slot>& slots, size_t index) : _slots(&slots), _index(index)
+        {
+            skip();
+        }
+
+        Ice::Int requestId() const
+        {
+            return (*_slots)[_index].requestId;
+        }
+
+        const OutgoingAsyncBasePtr& outAsync() const
+        {
+            return (*_slots)[_index].outAsync;
+        }
+
+        const_iterator& operator++()
+        {
+            ++_index;
+            skip();
+            return *this;
+        }
+
+        bool operator==(const const_iterator& rhs) const
+        {
+            return _index == rhs._index;
+        }
+
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return _index != rhs._index;
+        }
+
+    private:
+
+        void skip()
+        {
+            while(_index < _slots->size() && (*_slots)[_index].requestId == 0)
+            {
+                ++_index;
+            }
+        }
+
+        const std::vector<Slot>* _slots;
+        size_t _index;
+    };
+
+    RequestTable();
+
+    //
+    // Allocates a request ID for the given request of the given size.
+    //
+    Ice::Int add(const OutgoingAsyncBasePtr&, size_t);
+
+    //
+    // Removes and returns the request with the given ID, returns null
+    // if there's no such request.
+    //
+    OutgoingAsyncBasePtr remove(Ice::Int);
+
+    //
+    // Returns the ID of the given request, or 0 if it's not in the
+    // table. This scans the table.
+    //
+    Ice::Int find(const OutgoingAsyncBasePtr&) const;
+
+    void clear();
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    size_t bytes() const
+    {
+        return static_cast<size_t>(_bytes.load());
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(_slots, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(_slots, _slots.size());
+    }
+
+private:
+
+    void grow();
+    void shrink();
+
+    std::vector<Slot> _slots;
+    size_t _mask;
+    size_t _size;
+    IceUtilInternal::Atomic _bytes;
+    Ice::Int _nextRequestId;
+};
+
+}
+
+#endif
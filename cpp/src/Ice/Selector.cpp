@@ -19,6 +19,12 @@
 #   include <CoreFoundation/CFStream.h>
 #endif
 
+#if defined(ICE_USE_IO_URING)
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <signal.h>
+#endif
+
 using namespace std;
 using namespace IceInternal;
 
@@ -26,6 +32,46 @@ using namespace IceInternal;
 namespace
 {
 struct timespec zeroTimeout = { 0, 0 };
+}
+#elif defined(ICE_USE_IO_URING)
+namespace
+{
+
+//
+// User data of the submission queue entries which don't correspond to
+// the poll request of an event handler.
+//
+const IceUtil::Int64 ignoreUserData = 0;
+const IceUtil::Int64 interruptUserData = 1;
+
+//
+// Size of the buffers used to read and write stream sockets with read
+// and write requests.
+//
+const size_t ringBufferSize = 64 * 1024;
+
+//
+// The user data of a request is the index of its slot and the generation
+// of the slot (see Selector::addRequest).
+//
+IceUtil::Int64
+requestUserData(size_t index, unsigned int generation)
+{
+    return (static_cast<IceUtil::Int64>(generation) << 32) | static_cast<IceUtil::Int64>(index);
+}
+
+int
+ioUringSetup(unsigned int entries, struct io_uring_params* params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int
+ioUringEnter(int fd, unsigned int toSubmit, unsigned int minComplete, unsigned int flags, void* arg, size_t argSize)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+}
+
 }
 #endif
 
@@ -241,6 +287,14 @@ Selector::completed(EventHandler* handler, SocketOperation op)
 #elif defined(ICE_USE_KQUEUE) || defined(ICE_USE_EPOLL) || defined(ICE_USE_SELECT) || defined(ICE_USE_POLL)
 
 Selector::Selector(const InstancePtr& instance) : _instance(instance), _interrupted(false)
+#if defined(ICE_USE_IO_URING)
+    , _ioUring(false),
+    _ring(0),
+    _ringSize(0),
+    _sqes(0),
+    _sqesSize(0),
+    _interruptArmed(false)
+#endif
 {
     SOCKET fds[2];
     createPipe(fds);
@@ -249,6 +303,7 @@ Selector::Selector(const InstancePtr& instance) : _instance(instance), _interrup
     _selecting = false;
 
 #if defined(ICE_USE_EPOLL)
+    _spinMicros = 0;
     _events.resize(256);
     _queueFd = epoll_create(1);
     if(_queueFd < 0)
@@ -302,9 +357,241 @@ Selector::~Selector()
 {
 }
 
+#if defined(ICE_USE_IO_URING)
+bool
+Selector::setupIoUring()
+{
+    assert(!_ioUring);
+
+    //
+    // A registered socket can have a poll request, a read request and a
+    // write request pending, the completion queue is sized accordingly. If
+    // it overflows nevertheless, the kernel keeps the completions until
+    // they're flushed (see reapCompletions).
+    //
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = static_cast<unsigned int>(_events.size()) * 16;
+    int fd = ioUringSetup(static_cast<unsigned int>(_events.size()), &params);
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    //
+    // We wait for completions with a timeout using the extended arguments
+    // of io_uring_enter, this requires Linux 5.11 (which also provides the
+    // single mmap for the submission and completion queue rings and never
+    // drops completions).
+    //
+    if(!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_SINGLE_MMAP) ||
+       !(params.features & IORING_FEAT_NODROP))
+    {
+        closeSocketNoThrow(fd);
+        return false;
+    }
+
+    size_t ringSize = max(params.sq_off.array + params.sq_entries * sizeof(unsigned int),
+                          params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+    void* ring = mmap(0, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if(ring == MAP_FAILED)
+    {
+        closeSocketNoThrow(fd);
+        return false;
+    }
+
+    size_t sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(0, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if(sqes == MAP_FAILED)
+    {
+        munmap(ring, ringSize);
+        closeSocketNoThrow(fd);
+        return false;
+    }
+
+    char* base = static_cast<char*>(ring);
+    _ring = ring;
+    _ringSize = ringSize;
+    _sqes = static_cast<struct io_uring_sqe*>(sqes);
+    _sqesSize = sqesSize;
+    _sqHead = reinterpret_cast<unsigned int*>(base + params.sq_off.head);
+    _sqTail = reinterpret_cast<unsigned int*>(base + params.sq_off.tail);
+    _sqFlags = reinterpret_cast<unsigned int*>(base + params.sq_off.flags);
+    _sqMask = *reinterpret_cast<unsigned int*>(base + params.sq_off.ring_mask);
+    _sqEntries = params.sq_entries;
+    _cqHead = reinterpret_cast<unsigned int*>(base + params.cq_off.head);
+    _cqTail = reinterpret_cast<unsigned int*>(base + params.cq_off.tail);
+    _cqMask = *reinterpret_cast<unsigned int*>(base + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<struct io_uring_cqe*>(base + params.cq_off.cqes);
+
+    //
+    // Submission queue entries are always used in order, the indirection
+    // array is therefore set once for all.
+    //
+    unsigned int* array = reinterpret_cast<unsigned int*>(base + params.sq_off.array);
+    for(unsigned int i = 0; i < params.sq_entries; ++i)
+    {
+        array[i] = i;
+    }
+
+    //
+    // The epoll file descriptor is no longer needed, the io_uring file
+    // descriptor replaces it.
+    //
+    closeSocketNoThrow(_queueFd);
+    _queueFd = fd;
+    _ioUring = true;
+    _completions.reserve(params.cq_entries);
+    _ringCompletions.reserve(params.cq_entries);
+
+    IceUtil::Mutex::Lock sync(_ringMutex);
+    struct io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = _fdIntrRead;
+    sqe->poll32_events = POLLIN;
+    sqe->user_data = interruptUserData;
+    pushSqe();
+    _interruptArmed = true;
+    return true;
+}
+
+void
+Selector::initialize(EventHandler* handler)
+{
+    //
+    // The sockets of the native infos which support it are read and written
+    // with read and write requests using the buffers of the ring info.
+    //
+    NativeInfoPtr nativeInfo = handler->getNativeInfo();
+    if(_ioUring && nativeInfo && nativeInfo->ringIOSupported())
+    {
+        nativeInfo->setRingInfo(new RingInfo(ringBufferSize));
+    }
+}
+#endif
+
+#if defined(ICE_USE_EPOLL)
+void
+Selector::setSpinMicros(int spinMicros)
+{
+    _spinMicros = spinMicros;
+}
+
+int
+Selector::epollWait(int timeout)
+{
+    //
+    // Busy-poll the epoll instance for up to the spin time before blocking,
+    // this avoids the wake up latency of a blocking epoll_wait call when
+    // events are received shortly after the select.
+    //
+    if(_spinMicros > 0 && timeout != 0)
+    {
+        IceUtil::Time deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) +
+            IceUtil::Time::microSeconds(_spinMicros);
+        do
+        {
+            int count = epoll_wait(_queueFd, &_events[0], _events.size(), 0);
+            if(count != 0)
+            {
+                return count;
+            }
+        }
+        while(IceUtil::Time::now(IceUtil::Time::Monotonic) < deadline);
+    }
+    return epoll_wait(_queueFd, &_events[0], _events.size(), timeout);
+}
+
+SocketOperation
+Selector::pollOperations(const NativeInfoPtr& nativeInfo, SocketOperation status)
+{
+    //
+    // The native infos which signal write readiness with input are polled
+    // for input instead of output.
+    //
+    if((status & SocketOperationWrite) && nativeInfo->writeReadyOnInput())
+    {
+        return static_cast<SocketOperation>((status & ~SocketOperationWrite) | SocketOperationRead);
+    }
+    return status;
+}
+
+SocketOperation
+Selector::readyOperations(EventHandler* handler, SocketOperation status)
+{
+    //
+    // Input on a native info which signals write readiness with input
+    // makes the handler ready for the operations it's registered for.
+    //
+    SocketOperation registered = static_cast<SocketOperation>(handler->_registered & ~handler->_disabled);
+    if((status & SocketOperationRead) && !(status & SocketOperationWrite) && (registered & SocketOperationWrite))
+    {
+        NativeInfoPtr nativeInfo = handler->getNativeInfo();
+        if(nativeInfo && nativeInfo->writeReadyOnInput())
+        {
+            return static_cast<SocketOperation>(registered & (SocketOperationRead | SocketOperationWrite));
+        }
+    }
+    return status;
+}
+#endif
+
 void
 Selector::destroy()
 {
+#if defined(ICE_USE_IO_URING)
+    if(_ioUring)
+    {
+        //
+        // Cancel the read and write requests which are still pending and wait
+        // for their completion, the kernel must no longer access the buffers
+        // of the ring infos once the requests are released.
+        //
+        IceUtil::Mutex::Lock sync(_ringMutex);
+        size_t pending = 0;
+        for(size_t i = 0; i < _requests.size(); ++i)
+        {
+            if(_requests[i].pending && _requests[i].info)
+            {
+                cancelRequest(requestUserData(i, _requests[i].generation));
+                ++pending;
+            }
+        }
+        submit();
+
+        IceUtil::Time timeout = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::seconds(5);
+        while(pending > 0 && IceUtil::Time::now(IceUtil::Time::Monotonic) < timeout)
+        {
+            struct __kernel_timespec ts;
+            ts.tv_sec = 0;
+            ts.tv_nsec = 100 * 1000000;
+            struct io_uring_getevents_arg arg;
+            memset(&arg, 0, sizeof(arg));
+            arg.sigmask_sz = _NSIG / 8;
+            arg.ts = reinterpret_cast<__u64>(&ts);
+            ioUringEnter(_queueFd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+            reapCompletions();
+            for(vector<pair<IceUtil::Int64, int> >::const_iterator p = _completions.begin(); p != _completions.end();
+                ++p)
+            {
+                RingRequest* request = findRequest(p->first);
+                if(request && request->info)
+                {
+                    --pending;
+                }
+                if(request)
+                {
+                    removeRequest(p->first);
+                }
+            }
+            _completions.clear();
+        }
+
+        munmap(_sqes, _sqesSize);
+        munmap(_ring, _ringSize);
+    }
+#endif
 #if defined(ICE_USE_KQUEUE) || defined(ICE_USE_EPOLL)
     try
     {
@@ -375,10 +662,18 @@ Selector::enable(EventHandler* handler, SocketOperation status)
 
     if(handler->_registered & status)
     {
+#if defined(ICE_USE_IO_URING)
+        if(_ioUring)
+        {
+            updatePoll(handler);
+            return;
+        }
+#endif
 #if defined(ICE_USE_EPOLL)
         SOCKET fd = nativeInfo->fd();
         SocketOperation previous = static_cast<SocketOperation>(handler->_registered & ~(handler->_disabled | status));
-        SocketOperation newStatus = static_cast<SocketOperation>(handler->_registered & ~handler->_disabled);
+        SocketOperation newStatus = pollOperations(nativeInfo, static_cast<SocketOperation>(handler->_registered &
+                                                                                            ~handler->_disabled));
         epoll_event event;
         memset(&event, 0, sizeof(epoll_event));
         event.data.ptr = handler;
@@ -423,9 +718,17 @@ Selector::disable(EventHandler* handler, SocketOperation status)
 
     if(handler->_registered & status)
     {
+#if defined(ICE_USE_IO_URING)
+        if(_ioUring)
+        {
+            updatePoll(handler);
+            return;
+        }
+#endif
 #if defined(ICE_USE_EPOLL)
         SOCKET fd = nativeInfo->fd();
-        SocketOperation newStatus = static_cast<SocketOperation>(handler->_registered & ~handler->_disabled);
+        SocketOperation newStatus = pollOperations(nativeInfo, static_cast<SocketOperation>(handler->_registered &
+                                                                                            ~handler->_disabled));
         epoll_event event;
         memset(&event, 0, sizeof(epoll_event));
         event.data.ptr = handler;
@@ -473,6 +776,18 @@ Selector::finish(EventHandler* handler, bool closeNow)
         //
         updateSelector();
     }
+#elif defined(ICE_USE_IO_URING)
+    if(closeNow && _ioUring)
+    {
+        //
+        // Submit the removal of the poll request and the cancellation of the
+        // read and write requests now, the requests otherwise hold a reference
+        // on the file which would delay the close of the socket until the next
+        // select.
+        //
+        IceUtil::Mutex::Lock sync(_ringMutex);
+        submit();
+    }
 #elif !defined(ICE_USE_EPOLL)
     if(!_changes.empty())
     {
@@ -486,6 +801,17 @@ Selector::finish(EventHandler* handler, bool closeNow)
 void
 Selector::ready(EventHandler* handler, SocketOperation status, bool value)
 {
+#if defined(ICE_USE_IO_URING)
+    if(_ioUring && !value)
+    {
+        //
+        // The transceiver consumed the data received by the last read request
+        // or prepared data for a write request, issue the new request.
+        //
+        updatePoll(handler);
+    }
+#endif
+
     if(((handler->_ready & status) != 0) == value)
     {
         return; // Nothing to do if ready state already correctly set.
@@ -561,7 +887,19 @@ Selector::startSelect()
         _interrupted = false;
     }
 
-#if !defined(ICE_USE_EPOLL)
+#if defined(ICE_USE_IO_URING)
+    if(_ioUring && !_interruptArmed)
+    {
+        IceUtil::Mutex::Lock sync(_ringMutex);
+        struct io_uring_sqe* sqe = getSqe();
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = _fdIntrRead;
+        sqe->poll32_events = POLLIN;
+        sqe->user_data = interruptUserData;
+        pushSqe();
+        _interruptArmed = true;
+    }
+#elif !defined(ICE_USE_EPOLL)
     if(!_changes.empty())
     {
         updateSelector();
@@ -583,6 +921,155 @@ Selector::finishSelect(vector<pair<EventHandler*, SocketOperation> >& handlers)
 
     assert(handlers.empty());
 
+#if defined(ICE_USE_IO_URING)
+    if(_ioUring)
+    {
+        //
+        // Resolve the completions to their requests and release the slots of
+        // the requests with the ring mutex locked, the handlers might update
+        // the requests concurrently.
+        //
+        {
+            IceUtil::Mutex::Lock sync(_ringMutex);
+            for(vector<pair<IceUtil::Int64, int> >::const_iterator p = _completions.begin(); p != _completions.end();
+                ++p)
+            {
+                if(p->first == interruptUserData)
+                {
+                    _interruptArmed = false;
+                    continue;
+                }
+
+                RingRequest* request = findRequest(p->first);
+                if(!request)
+                {
+                    continue; // Completion of a poll removal or of a poll request which was removed.
+                }
+
+                RingCompletion completion = { request->info, request->handler, request->operation, p->second };
+                if(!request->info)
+                {
+                    request->handler->_pollRequest = 0;
+                }
+                removeRequest(p->first);
+                _ringCompletions.push_back(completion);
+            }
+            _completions.clear();
+        }
+
+        //
+        // Store the results of the read and write requests first, the handlers
+        // are marked as ready and added by the loop below.
+        //
+        for(vector<RingCompletion>::const_iterator p = _ringCompletions.begin(); p != _ringCompletions.end(); ++p)
+        {
+            if(!p->info)
+            {
+                continue; // Completion of a poll request.
+            }
+
+            bool canceled = p->result == -ECANCELED;
+            {
+                IceUtil::Mutex::Lock sync(p->info->mutex);
+                if(p->operation == SocketOperationRead)
+                {
+                    p->info->readRequest = 0;
+                    if(p->result > 0)
+                    {
+                        p->info->readBegin = 0;
+                        p->info->readEnd = static_cast<size_t>(p->result);
+                        p->info->readMore = p->info->readEnd == p->info->readBuffer.size();
+                    }
+                    else if(p->result == 0)
+                    {
+                        p->info->readEof = true;
+                    }
+                    else if(!canceled)
+                    {
+                        p->info->readError = -p->result;
+                    }
+                }
+                else
+                {
+                    p->info->writeRequest = 0;
+                    if(!canceled)
+                    {
+                        p->info->writeCompleted = true;
+                        p->info->writeResult = p->result;
+                        p->info->writeSize = 0;
+                    }
+                }
+            }
+
+            if(!p->handler)
+            {
+                continue; // The handler is no longer registered for the operation.
+            }
+            else if(canceled)
+            {
+                //
+                // The handler registered again for the operation while the request
+                // was being canceled, issue a new request.
+                //
+                updatePoll(p->handler);
+            }
+            else
+            {
+                //
+                // The handler remains ready until the transceiver consumes the
+                // result of the request, like with a level-triggered poll.
+                //
+                ready(p->handler, p->operation, true);
+            }
+        }
+
+        for(vector<RingCompletion>::const_iterator p = _ringCompletions.begin(); p != _ringCompletions.end(); ++p)
+        {
+            if(p->info)
+            {
+                continue;
+            }
+
+            EventHandler* handler = p->handler;
+            SocketOperation status;
+            if(p->result < 0)
+            {
+                //
+                // The poll request failed, report the handler as ready so that the error
+                // is raised by the next read or write.
+                //
+                status = static_cast<SocketOperation>(SocketOperationRead | SocketOperationWrite);
+            }
+            else
+            {
+                status = static_cast<SocketOperation>(((p->result & (POLLIN | POLLERR | POLLHUP)) ?
+                                                       SocketOperationRead : SocketOperationNone) |
+                                                      ((p->result & (POLLOUT | POLLERR)) ?
+                                                       SocketOperationWrite : SocketOperationNone));
+                status = readyOperations(handler, status);
+            }
+
+            //
+            // Poll requests are one-shot, re-arm the poll request. It will be submitted
+            // with the next select.
+            //
+            updatePoll(handler);
+
+            map<EventHandlerPtr, SocketOperation>::iterator r = _readyHandlers.find(ICE_GET_SHARED_FROM_THIS(handler));
+            if(r != _readyHandlers.end()) // Handler will be added by the loop below
+            {
+                r->second = status;
+            }
+            else
+            {
+                handlers.push_back(make_pair(handler, status));
+            }
+        }
+        _ringCompletions.clear();
+        _count = 0; // No epoll events to process.
+    }
+#endif
+
 #if defined(ICE_USE_POLL) || defined(ICE_USE_SELECT)
     if(_interrupted) // Interrupted, we have to process the interrupt before returning any handlers
     {
@@ -605,6 +1092,10 @@ Selector::finishSelect(vector<pair<EventHandler*, SocketOperation> >& handlers)
                                                  SocketOperationRead : SocketOperationNone) |
                                                 ((ev.events & (EPOLLOUT | EPOLLERR)) ?
                                                  SocketOperationWrite : SocketOperationNone));
+        if(p.first)
+        {
+            p.second = readyOperations(p.first, p.second);
+        }
 #elif defined(ICE_USE_KQUEUE)
         struct kevent& ev = _events[i];
         if(ev.flags & EV_ERROR)
@@ -713,8 +1204,17 @@ Selector::select(int timeout)
 
     while(true)
     {
-#if defined(ICE_USE_EPOLL)
-        _count = epoll_wait(_queueFd, &_events[0], _events.size(), timeout);
+#if defined(ICE_USE_IO_URING)
+        if(_ioUring)
+        {
+            _count = ioUringWait(timeout);
+        }
+        else
+        {
+            _count = epollWait(timeout);
+        }
+#elif defined(ICE_USE_EPOLL)
+        _count = epollWait(timeout);
 #elif defined(ICE_USE_KQUEUE)
         assert(!_events.empty());
         if(timeout >= 0)
@@ -910,6 +1410,14 @@ Selector::updateSelector()
 void
 Selector::updateSelectorForEventHandler(EventHandler* handler, SocketOperation remove, SocketOperation add)
 {
+#if defined(ICE_USE_IO_URING)
+    if(_ioUring)
+    {
+        updatePoll(handler);
+        checkReady(handler);
+        return;
+    }
+#endif
 #if defined(ICE_USE_EPOLL)
     SocketOperation previous = handler->_registered;
     previous = static_cast<SocketOperation>(previous & ~add);
@@ -925,8 +1433,9 @@ Selector::updateSelectorForEventHandler(EventHandler* handler, SocketOperation r
         status = static_cast<SocketOperation>(status & ~handler->_disabled);
         previous = static_cast<SocketOperation>(previous & ~handler->_disabled);
     }
-    event.events |= status & SocketOperationRead ? EPOLLIN : 0;
-    event.events |= status & SocketOperationWrite ? EPOLLOUT : 0;
+    SocketOperation polled = pollOperations(handler->getNativeInfo(), status);
+    event.events |= polled & SocketOperationRead ? EPOLLIN : 0;
+    event.events |= polled & SocketOperationWrite ? EPOLLOUT : 0;
     int op;
     if(!previous && status)
     {
@@ -989,6 +1498,387 @@ Selector::updateSelectorForEventHandler(EventHandler* handler, SocketOperation r
     checkReady(handler);
 }
 
+#if defined(ICE_USE_IO_URING)
+int
+Selector::ioUringWait(int timeout)
+{
+    while(true)
+    {
+        //
+        // Submit the queued requests and wait for completions with a single
+        // system call. The kernel consumes the submission queue in order,
+        // requests queued meanwhile by other threads are submitted by their
+        // own submit() call or by the next wait.
+        //
+        unsigned int toSubmit;
+        {
+            IceUtil::Mutex::Lock sync(_ringMutex);
+            toSubmit = *_sqTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+            if(!_completions.empty())
+            {
+                timeout = 0; // Completions were reaped by getSqe(), don't wait.
+            }
+        }
+
+        struct __kernel_timespec ts;
+        struct io_uring_getevents_arg arg;
+        memset(&arg, 0, sizeof(arg));
+        arg.sigmask_sz = _NSIG / 8;
+        if(timeout > 0)
+        {
+            ts.tv_sec = timeout / 1000;
+            ts.tv_nsec = (timeout % 1000) * 1000000;
+            arg.ts = reinterpret_cast<__u64>(&ts);
+        }
+        int ret = ioUringEnter(_queueFd, toSubmit, timeout == 0 ? 0 : 1,
+                               IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+        int error = ret == SOCKET_ERROR ? getSocketErrno() : 0;
+        if(error != 0 && error != ETIME && error != EBUSY)
+        {
+            return SOCKET_ERROR;
+        }
+
+        IceUtil::Mutex::Lock sync(_ringMutex);
+        reapCompletions();
+        if(!_completions.empty() || timeout == 0 || error == ETIME)
+        {
+            return static_cast<int>(_completions.size());
+        }
+
+        //
+        // The submission was refused because the completion queue overflowed
+        // (the overflowed completions are now flushed) or all the completions
+        // were reaped by getSqe(), try again.
+        //
+    }
+}
+
+void
+Selector::reapCompletions()
+{
+    while(true)
+    {
+        unsigned int head = *_cqHead;
+        unsigned int tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+        for(; head != tail; ++head)
+        {
+            const struct io_uring_cqe& cqe = _cqes[head & _cqMask];
+            if(cqe.user_data != static_cast<__u64>(ignoreUserData))
+            {
+                _completions.push_back(make_pair(static_cast<IceUtil::Int64>(cqe.user_data), cqe.res));
+            }
+        }
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+
+        //
+        // If the completion queue overflowed, the kernel keeps the overflowed
+        // completions until they're flushed to the completion queue by an
+        // io_uring_enter call with IORING_ENTER_GETEVENTS.
+        //
+        if(!(__atomic_load_n(_sqFlags, __ATOMIC_ACQUIRE) & IORING_SQ_CQ_OVERFLOW))
+        {
+            break;
+        }
+        while(ioUringEnter(_queueFd, 0, 0, IORING_ENTER_GETEVENTS, 0, 0) == SOCKET_ERROR && interrupted())
+        {
+        }
+    }
+}
+
+struct io_uring_sqe*
+Selector::getSqe()
+{
+    unsigned int tail = *_sqTail;
+    if(tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) == _sqEntries)
+    {
+        //
+        // The submission queue is full, submit the queued entries now. If the
+        // kernel refuses them because the completion queue overflowed, reap
+        // the completions (they're processed with the next select) and try
+        // again.
+        //
+        submit();
+        if(tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) == _sqEntries)
+        {
+            reapCompletions();
+            wakeup();
+            submit();
+            if(tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) == _sqEntries)
+            {
+                Ice::SocketException ex(__FILE__, __LINE__);
+                ex.error = EBUSY;
+                throw ex;
+            }
+        }
+    }
+
+    struct io_uring_sqe* sqe = &_sqes[tail & _sqMask];
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    return sqe;
+}
+
+void
+Selector::pushSqe()
+{
+    __atomic_store_n(_sqTail, *_sqTail + 1, __ATOMIC_RELEASE);
+    if(_selecting)
+    {
+        //
+        // A thread is waiting for completions, the entry must be submitted
+        // now. Otherwise, it's submitted by the next select.
+        //
+        submit();
+    }
+}
+
+void
+Selector::submit()
+{
+    while(true)
+    {
+        unsigned int toSubmit = *_sqTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        if(toSubmit == 0)
+        {
+            return;
+        }
+
+        int ret = ioUringEnter(_queueFd, toSubmit, 0, 0, 0, 0);
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            if(errno == EBUSY || errno == EAGAIN)
+            {
+                //
+                // The completion queue overflowed or the kernel is short of
+                // resources, the entries remain queued and are submitted by
+                // the next select once the completions are reaped.
+                //
+                return;
+            }
+
+            Ice::SocketException ex(__FILE__, __LINE__);
+            ex.error = getSocketErrno();
+            throw ex;
+        }
+        else if(ret == 0)
+        {
+            return;
+        }
+    }
+}
+
+void
+Selector::cancelRequest(IceUtil::Int64 id)
+{
+    struct io_uring_sqe* sqe = getSqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = static_cast<__u64>(id);
+    sqe->user_data = ignoreUserData;
+    pushSqe();
+}
+
+void
+Selector::updatePoll(EventHandler* handler)
+{
+    SocketOperation status = static_cast<SocketOperation>(handler->_registered & ~handler->_disabled &
+                                                          (SocketOperationRead | SocketOperationWrite));
+    NativeInfoPtr nativeInfo = handler->getNativeInfo();
+    if(!nativeInfo || nativeInfo->fd() == INVALID_SOCKET)
+    {
+        status = SocketOperationNone;
+    }
+
+    bool buffered = false;
+    {
+        IceUtil::Mutex::Lock sync(_ringMutex);
+
+        //
+        // The operations which aren't performed with read or write requests
+        // are polled.
+        //
+        SocketOperation polled = status;
+        if(nativeInfo && nativeInfo->getRingInfo())
+        {
+            polled = updateRingRequests(handler, nativeInfo->getRingInfo(), status, buffered);
+        }
+        else if(nativeInfo)
+        {
+            polled = pollOperations(nativeInfo, status);
+        }
+
+        if(handler->_pollRequest && findRequest(handler->_pollRequest)->operation != polled)
+        {
+            //
+            // Remove the poll request. The completions of the removal and of the
+            // removed poll request are ignored by finishSelect.
+            //
+            struct io_uring_sqe* sqe = getSqe();
+            sqe->opcode = IORING_OP_POLL_REMOVE;
+            sqe->fd = -1;
+            sqe->addr = static_cast<__u64>(handler->_pollRequest);
+            sqe->user_data = ignoreUserData;
+            pushSqe();
+            removeRequest(handler->_pollRequest);
+            handler->_pollRequest = 0;
+        }
+
+        if(polled && !handler->_pollRequest)
+        {
+            struct io_uring_sqe* sqe = getSqe();
+            IceUtil::Int64 id = addRequest(handler, 0, polled);
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->fd = nativeInfo->fd();
+            sqe->poll32_events = (polled & SocketOperationRead ? POLLIN : 0) |
+                (polled & SocketOperationWrite ? POLLOUT : 0);
+            sqe->user_data = static_cast<__u64>(id);
+            pushSqe();
+            handler->_pollRequest = id;
+        }
+    }
+
+    if(buffered)
+    {
+        //
+        // Data was received while the handler wasn't registered for read.
+        //
+        ready(handler, SocketOperationRead, true);
+    }
+}
+
+SocketOperation
+Selector::updateRingRequests(EventHandler* handler, const RingInfoPtr& info, SocketOperation status, bool& buffered)
+{
+    IceUtil::Mutex::Lock sync(info->mutex);
+    if(!info->enabled)
+    {
+        return status; // The socket isn't connected yet, it's polled.
+    }
+
+    SocketOperation polled = SocketOperationNone;
+    if(status & SocketOperationRead)
+    {
+        if(info->readRequest)
+        {
+            findRequest(info->readRequest)->handler = handler;
+        }
+        else if(info->readBegin != info->readEnd || info->readEof || info->readError)
+        {
+            buffered = true;
+        }
+        else if(!info->reading)
+        {
+            struct io_uring_sqe* sqe = getSqe();
+            IceUtil::Int64 id = addRequest(handler, info, SocketOperationRead);
+            sqe->opcode = IORING_OP_RECV;
+            sqe->fd = handler->getNativeInfo()->fd();
+            sqe->addr = reinterpret_cast<__u64>(&info->readBuffer[0]);
+            sqe->len = static_cast<__u32>(info->readBuffer.size());
+            sqe->user_data = static_cast<__u64>(id);
+            pushSqe();
+            info->readRequest = id;
+        }
+    }
+    else if(info->readRequest && findRequest(info->readRequest)->handler)
+    {
+        cancelRequest(info->readRequest);
+        findRequest(info->readRequest)->handler = 0;
+    }
+
+    if(status & SocketOperationWrite)
+    {
+        if(info->writeRequest)
+        {
+            findRequest(info->writeRequest)->handler = handler;
+        }
+        else if(info->writeSize > 0)
+        {
+            struct io_uring_sqe* sqe = getSqe();
+            IceUtil::Int64 id = addRequest(handler, info, SocketOperationWrite);
+            sqe->opcode = IORING_OP_SEND;
+            sqe->fd = handler->getNativeInfo()->fd();
+            sqe->addr = reinterpret_cast<__u64>(&info->writeBuffer[0]);
+            sqe->len = static_cast<__u32>(info->writeSize);
+            sqe->msg_flags = MSG_NOSIGNAL;
+            sqe->user_data = static_cast<__u64>(id);
+            pushSqe();
+            info->writeRequest = id;
+        }
+        else if(!info->writeCompleted)
+        {
+            polled = SocketOperationWrite; // No data to send with a write request, poll for writability.
+        }
+    }
+    else if(info->writeRequest && findRequest(info->writeRequest)->handler)
+    {
+        cancelRequest(info->writeRequest);
+        findRequest(info->writeRequest)->handler = 0;
+    }
+    return polled;
+}
+
+IceUtil::Int64
+Selector::addRequest(EventHandler* handler, const RingInfoPtr& info, SocketOperation operation)
+{
+    if(_freeRequests.empty())
+    {
+        RingRequest request;
+        request.handler = 0;
+        request.operation = SocketOperationNone;
+        request.generation = 1;
+        request.pending = false;
+        _requests.push_back(request);
+        _freeRequests.push_back(static_cast<unsigned int>(_requests.size() - 1));
+    }
+
+    unsigned int index = _freeRequests.back();
+    _freeRequests.pop_back();
+    RingRequest& request = _requests[index];
+    assert(!request.pending);
+    request.info = info;
+    request.handler = handler;
+    request.operation = operation;
+    request.pending = true;
+    return requestUserData(index, request.generation);
+}
+
+Selector::RingRequest*
+Selector::findRequest(IceUtil::Int64 id)
+{
+    size_t index = static_cast<size_t>(id & 0xFFFFFFFF);
+    if(index >= _requests.size() || !_requests[index].pending ||
+       _requests[index].generation != static_cast<unsigned int>(id >> 32))
+    {
+        return 0;
+    }
+    return &_requests[index];
+}
+
+void
+Selector::removeRequest(IceUtil::Int64 id)
+{
+    RingRequest* request = findRequest(id);
+    assert(request);
+    request->info = 0;
+    request->handler = 0;
+    request->pending = false;
+
+    //
+    // The generation 0 is never used, the user data of a request never
+    // matches the user data reserved for the interrupt.
+    //
+    if(++request->generation == 0)
+    {
+        request->generation = 1;
+    }
+    _freeRequests.push_back(static_cast<unsigned int>(id & 0xFFFFFFFF));
+}
+#endif
+
 #elif defined(ICE_USE_CFSTREAM)
 
 namespace
@@ -21,6 +21,15 @@
 
 #if defined(ICE_USE_EPOLL)
 #   include <sys/epoll.h>
+#   if defined(ICE_USE_IO_URING)
+#       include <linux/io_uring.h>
+//
+// The io_uring backend requires the Linux 5.11 kernel headers.
+//
+#       if !defined(IORING_FEAT_EXT_ARG) || !defined(IORING_SQ_CQ_OVERFLOW)
+#           undef ICE_USE_IO_URING
+#       endif
+#   endif
 #elif defined(ICE_USE_KQUEUE)
 #   include <sys/event.h>
 #elif defined(ICE_USE_IOCP)
@@ -119,12 +128,22 @@ public:
     Selector(const InstancePtr&);
     ~Selector();
 
+#if defined(ICE_USE_IO_URING)
+    bool setupIoUring();
+#endif
+#if defined(ICE_USE_EPOLL)
+    void setSpinMicros(int);
+#endif
     void destroy();
 
+#if defined(ICE_USE_IO_URING)
+    void initialize(EventHandler*);
+#else
     void initialize(EventHandler*)
     {
         // Nothing to do
     }
+#endif
     void update(EventHandler*, SocketOperation, SocketOperation);
     void enable(EventHandler*, SocketOperation);
     void disable(EventHandler*, SocketOperation);
@@ -142,6 +161,25 @@ private:
     void checkReady(EventHandler*);
     void updateSelector();
     void updateSelectorForEventHandler(EventHandler*, SocketOperation, SocketOperation);
+#if defined(ICE_USE_EPOLL)
+    int epollWait(int);
+    static SocketOperation pollOperations(const NativeInfoPtr&, SocketOperation);
+    static SocketOperation readyOperations(EventHandler*, SocketOperation);
+#endif
+#if defined(ICE_USE_IO_URING)
+    int ioUringWait(int);
+    void reapCompletions();
+    struct io_uring_sqe* getSqe();
+    void pushSqe();
+    void submit();
+    void updatePoll(EventHandler*);
+    SocketOperation updateRingRequests(EventHandler*, const RingInfoPtr&, SocketOperation, bool&);
+    void cancelRequest(IceUtil::Int64);
+    struct RingRequest;
+    IceUtil::Int64 addRequest(EventHandler*, const RingInfoPtr&, SocketOperation);
+    RingRequest* findRequest(IceUtil::Int64);
+    void removeRequest(IceUtil::Int64);
+#endif
 
     const InstancePtr _instance;
 
@@ -156,6 +194,66 @@ private:
 #if defined(ICE_USE_EPOLL)
     std::vector<struct epoll_event> _events;
     int _queueFd;
+    int _spinMicros; // Time to spin with non-blocking epoll_wait calls before blocking.
+#   if defined(ICE_USE_IO_URING)
+    //
+    // When the io_uring backend is enabled, _queueFd is the io_uring
+    // file descriptor. Stream sockets are read and written with read and
+    // write requests (see RingInfo), the readiness of other sockets is
+    // monitored with one-shot poll requests that are re-armed after each
+    // completion. Requests are batched into the submission queue and
+    // submitted along with the wait for completions.
+    //
+    // The pending requests are kept in a table of slots. The user data
+    // of a request is the index of its slot in the low 32 bits and the
+    // generation of the slot in the high bits. The generation changes
+    // when the slot is released, the completion of a request which is no
+    // longer tracked (such as a removed poll request) is ignored. Released
+    // slots are reused, issuing a request doesn't allocate memory unless
+    // the table grows.
+    //
+    // The submission and completion queues, the request table and the
+    // poll requests of the handlers are only accessed with _ringMutex
+    // locked. The thread pool lock protects the other members.
+    //
+    struct RingRequest
+    {
+        RingInfoPtr info; // Null for a poll request
+        EventHandler* handler; // Null if the handler is no longer registered for the operation
+        SocketOperation operation; // The polled operations for a poll request
+        unsigned int generation;
+        bool pending;
+    };
+
+    struct RingCompletion
+    {
+        RingInfoPtr info;
+        EventHandler* handler;
+        SocketOperation operation;
+        int result;
+    };
+
+    bool _ioUring;
+    IceUtil::Mutex _ringMutex;
+    void* _ring;
+    size_t _ringSize;
+    struct io_uring_sqe* _sqes;
+    size_t _sqesSize;
+    unsigned int* _sqHead;
+    unsigned int* _sqTail;
+    unsigned int* _sqFlags;
+    unsigned int _sqMask;
+    unsigned int _sqEntries;
+    unsigned int* _cqHead;
+    unsigned int* _cqTail;
+    unsigned int _cqMask;
+    struct io_uring_cqe* _cqes;
+    bool _interruptArmed;
+    std::vector<RingRequest> _requests;
+    std::vector<unsigned int> _freeRequests;
+    std::vector<std::pair<IceUtil::Int64, int> > _completions;
+    std::vector<RingCompletion> _ringCompletions;
+#   endif
 #elif defined(ICE_USE_KQUEUE)
     std::vector<struct kevent> _events;
     std::vector<struct kevent> _changes;
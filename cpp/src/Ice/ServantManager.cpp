@@ -13,6 +13,7 @@
 #include <Ice/LoggerUtil.h>
 #include <Ice/Instance.h>
 #include <Ice/StringUtil.h>
+#include <IceUtil/Thread.h>
 
 using namespace std;
 using namespace Ice;
@@ -20,54 +21,253 @@ using namespace IceInternal;
 
 ICE_API IceUtil::Shared* IceInternal::upCast(ServantManager* p) { return p; }
 
-void
-IceInternal::ServantManager::addServant(const ObjectPtr& object, const Identity& ident, const string& facet)
+namespace
 {
-    IceUtil::Mutex::Lock sync(*this);
 
-    assert(_instance); // Must not be called after destruction.
+//
+// The facets of an identity, shared by the copies of its node.
+//
+struct ServantFacets : public IceUtil::Shared
+{
+    ServantFacets(const FacetMap& f) : facets(f)
+    {
+    }
+
+    const FacetMap facets;
+};
+typedef IceUtil::Handle<ServantFacets> ServantFacetsPtr;
+
+//
+// A node of the servant tree, a treap ordered by identity and by
+// priority. The nodes are immutable once they're part of a published
+// snapshot, an update copies the nodes on the path to the modified
+// identity and shares the others with the previous snapshot.
+//
+struct ServantNode;
+typedef IceUtil::Handle<ServantNode> ServantNodePtr;
+
+struct ServantNode : public IceUtil::Shared
+{
+    ServantNode(const Identity& i, const ServantFacetsPtr& f, unsigned int p) : ident(i), facets(f), priority(p)
+    {
+    }
 
-    ServantMapMap::iterator p = _servantMapMapHint;
+    const Identity ident;
+    const ServantFacetsPtr facets;
+    const unsigned int priority;
+    ServantNodePtr left;
+    ServantNodePtr right;
+};
 
-    if(p == _servantMapMap.end() || p->first != ident)
+//
+// Merges two trees, the identities of the first tree are lower than the
+// identities of the second tree.
+//
+ServantNodePtr
+mergeServants(const ServantNodePtr& lower, const ServantNodePtr& greater)
+{
+    if(!lower)
+    {
+        return greater;
+    }
+    else if(!greater)
+    {
+        return lower;
+    }
+    else if(lower->priority > greater->priority)
     {
-        p = _servantMapMap.find(ident);
+        ServantNodePtr copy = new ServantNode(*lower);
+        copy->right = mergeServants(lower->right, greater);
+        return copy;
     }
+    else
+    {
+        ServantNodePtr copy = new ServantNode(*greater);
+        copy->left = mergeServants(lower, greater->left);
+        return copy;
+    }
+}
 
-    if(p == _servantMapMap.end())
+//
+// Returns a copy of the tree with the facets of the given identity
+// replaced, the identity is removed if the facet map is empty. Only the
+// nodes on the path to the identity are copied. A child with a greater
+// priority than its parent is always a new node, it can be rotated.
+//
+ServantNodePtr
+setServants(const ServantNodePtr& node, const Identity& ident, const FacetMap& facets, unsigned int priority)
+{
+    if(!node)
+    {
+        if(facets.empty())
+        {
+            return 0;
+        }
+        return new ServantNode(ident, new ServantFacets(facets), priority);
+    }
+    else if(ident < node->ident)
+    {
+        ServantNodePtr copy = new ServantNode(*node);
+        copy->left = setServants(node->left, ident, facets, priority);
+        if(copy->left && copy->left->priority > copy->priority)
+        {
+            ServantNodePtr left = copy->left;
+            copy->left = left->right;
+            left->right = copy;
+            return left;
+        }
+        return copy;
+    }
+    else if(node->ident < ident)
+    {
+        ServantNodePtr copy = new ServantNode(*node);
+        copy->right = setServants(node->right, ident, facets, priority);
+        if(copy->right && copy->right->priority > copy->priority)
+        {
+            ServantNodePtr right = copy->right;
+            copy->right = right->left;
+            right->left = copy;
+            return right;
+        }
+        return copy;
+    }
+    else if(facets.empty())
     {
-        p = _servantMapMap.insert(_servantMapMapHint, pair<const Identity, FacetMap>(ident, FacetMap()));
+        return mergeServants(node->left, node->right);
     }
     else
     {
-        if(p->second.find(facet) != p->second.end())
+        ServantNodePtr copy = new ServantNode(ident, new ServantFacets(facets), node->priority);
+        copy->left = node->left;
+        copy->right = node->right;
+        return copy;
+    }
+}
+
+}
+
+struct IceInternal::ServantManager::Snapshot : public IceUtil::Shared
+{
+    const FacetMap*
+    findFacets(const Identity& ident) const
+    {
+        const ServantNode* node = servants.get();
+        while(node)
+        {
+            if(ident < node->ident)
+            {
+                node = node->left.get();
+            }
+            else if(node->ident < ident)
+            {
+                node = node->right.get();
+            }
+            else
+            {
+                return &node->facets->facets;
+            }
+        }
+        return 0;
+    }
+
+    ServantNodePtr servants;
+    DefaultServantMap defaultServants;
+    LocatorMap locators;
+};
+
+//
+// Counts the calling thread as a reader of the current epoch for the
+// duration of a lookup and provides the current snapshot. The snapshot
+// can't be released until the reader is done.
+//
+class IceInternal::ServantManager::ReadGuard : public IceUtil::noncopyable
+{
+public:
+
+    ReadGuard(const ServantManager& manager)
+    {
+        ReaderCount& readers = manager._readers[IceUtilInternal::getThreadIdHash() % ReaderShards];
+        while(true)
         {
-            AlreadyRegisteredException ex(__FILE__, __LINE__);
-            ex.kindOfObject = "servant";
-            ToStringMode toStringMode = _instance->toStringMode();
-            ex.id = Ice::identityToString(ident, toStringMode);
-            if(!facet.empty())
+            //
+            // If the epoch changed before we were counted, the update which
+            // changed it might not have seen us, count us in the new epoch.
+            //
+            int epoch = manager._epoch.load();
+            _count = &readers.count[epoch & 1];
+            ++*_count;
+            if(manager._epoch.load() == epoch)
             {
-                ex.id += " -f " + escapeString(facet, "", toStringMode);
+                break;
             }
-            throw ex;
+            --*_count;
+        }
+        _snapshot = manager._snapshots[manager._current.load()].snapshot.get();
+    }
+
+    ~ReadGuard()
+    {
+        --*_count;
+    }
+
+    const Snapshot*
+    operator->() const
+    {
+        return _snapshot;
+    }
+
+private:
+
+    IceUtilInternal::Atomic* _count;
+    const Snapshot* _snapshot;
+};
+
+void
+IceInternal::ServantManager::addServant(const ObjectPtr& object, const Identity& ident, const string& facet)
+{
+    vector<SnapshotPtr> released; // Released once *this is unlocked
+
+    IceUtil::Mutex::Lock sync(*this);
+
+    assert(_instance); // Must not be called after destruction.
+
+    const FacetMap* facets = current().findFacets(ident);
+    if(facets && facets->find(facet) != facets->end())
+    {
+        AlreadyRegisteredException ex(__FILE__, __LINE__);
+        ex.kindOfObject = "servant";
+        ToStringMode toStringMode = _instance->toStringMode();
+        ex.id = Ice::identityToString(ident, toStringMode);
+        if(!facet.empty())
+        {
+            ex.id += " -f " + escapeString(facet, "", toStringMode);
         }
+        throw ex;
     }
 
-    _servantMapMapHint = p;
+    FacetMap newFacets;
+    if(facets)
+    {
+        newFacets = *facets;
+    }
+    newFacets.insert(pair<const string, ObjectPtr>(facet, object));
 
-    p->second.insert(pair<const string, ObjectPtr>(facet, object));
+    SnapshotPtr snapshot = new Snapshot(current());
+    _priority = _priority * 1103515245 + 12345;
+    snapshot->servants = setServants(snapshot->servants, ident, newFacets, _priority);
+    publish(snapshot, released);
 }
 
 void
 IceInternal::ServantManager::addDefaultServant(const ObjectPtr& object, const string& category)
 {
+    vector<SnapshotPtr> released; // Released once *this is unlocked
+
     IceUtil::Mutex::Lock sync(*this);
 
     assert(_instance); // Must not be called after destruction.
 
-    DefaultServantMap::iterator p = _defaultServantMap.find(category);
-    if(p != _defaultServantMap.end())
+    if(current().defaultServants.find(category) != current().defaultServants.end())
     {
         AlreadyRegisteredException ex(__FILE__, __LINE__);
         ex.kindOfObject = "default servant";
@@ -75,7 +275,9 @@ IceInternal::ServantManager::addDefaultServant(const ObjectPtr& object, const st
         throw ex;
     }
 
-    _defaultServantMap.insert(pair<const string, ObjectPtr>(category, object));
+    SnapshotPtr snapshot = new Snapshot(current());
+    snapshot->defaultServants.insert(pair<const string, ObjectPtr>(category, object));
+    publish(snapshot, released);
 }
 
 ObjectPtr
@@ -87,20 +289,16 @@ IceInternal::ServantManager::removeServant(const Identity& ident, const string&
     // destructor, with an internal Ice mutex locked.
     //
     ObjectPtr servant = 0;
+    vector<SnapshotPtr> released;
 
     IceUtil::Mutex::Lock sync(*this);
 
     assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-    FacetMap::iterator q;
-
-    if(p == _servantMapMap.end() || p->first != ident)
-    {
-        p = _servantMapMap.find(ident);
-    }
+    const FacetMap* facets = current().findFacets(ident);
+    FacetMap::const_iterator q;
 
-    if(p == _servantMapMap.end() || (q = p->second.find(facet)) == p->second.end())
+    if(!facets || (q = facets->find(facet)) == facets->end())
     {
         NotRegisteredException ex(__FILE__, __LINE__);
         ex.kindOfObject = "servant";
@@ -114,20 +312,14 @@ IceInternal::ServantManager::removeServant(const Identity& ident, const string&
     }
 
     servant = q->second;
-    p->second.erase(q);
 
-    if(p->second.empty())
-    {
-        if(p == _servantMapMapHint)
-        {
-            _servantMapMap.erase(p++);
-            _servantMapMapHint = p;
-        }
-        else
-        {
-            _servantMapMap.erase(p);
-        }
-    }
+    FacetMap newFacets = *facets;
+    newFacets.erase(facet);
+
+    SnapshotPtr snapshot = new Snapshot(current());
+    _priority = _priority * 1103515245 + 12345;
+    snapshot->servants = setServants(snapshot->servants, ident, newFacets, _priority);
+    publish(snapshot, released);
     return servant;
 }
 
@@ -140,13 +332,14 @@ IceInternal::ServantManager::removeDefaultServant(const string& category)
     // destructor, with an internal Ice mutex locked.
     //
     ObjectPtr servant = 0;
+    vector<SnapshotPtr> released;
 
     IceUtil::Mutex::Lock sync(*this);
 
     assert(_instance); // Must not be called after destruction.
 
-    DefaultServantMap::iterator p = _defaultServantMap.find(category);
-    if(p == _defaultServantMap.end())
+    DefaultServantMap::const_iterator p = current().defaultServants.find(category);
+    if(p == current().defaultServants.end())
     {
         NotRegisteredException ex(__FILE__, __LINE__);
         ex.kindOfObject = "default servant";
@@ -155,26 +348,25 @@ IceInternal::ServantManager::removeDefaultServant(const string& category)
     }
 
     servant = p->second;
-    _defaultServantMap.erase(p);
 
+    SnapshotPtr snapshot = new Snapshot(current());
+    snapshot->defaultServants.erase(category);
+    publish(snapshot, released);
     return servant;
 }
 
 FacetMap
 IceInternal::ServantManager::removeAllFacets(const Identity& ident)
 {
+    FacetMap result;
+    vector<SnapshotPtr> released;
+
     IceUtil::Mutex::Lock sync(*this);
 
     assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-
-    if(p == _servantMapMap.end() || p->first != ident)
-    {
-        p = _servantMapMap.find(ident);
-    }
-
-    if(p == _servantMapMap.end())
+    const FacetMap* facets = current().findFacets(ident);
+    if(!facets)
     {
         NotRegisteredException ex(__FILE__, __LINE__);
         ex.kindOfObject = "servant";
@@ -182,51 +374,34 @@ IceInternal::ServantManager::removeAllFacets(const Identity& ident)
         throw ex;
     }
 
-    FacetMap result = p->second;
-
-    if(p == _servantMapMapHint)
-    {
-        _servantMapMap.erase(p++);
-        _servantMapMapHint = p;
-    }
-    else
-    {
-        _servantMapMap.erase(p);
-    }
+    result = *facets;
 
+    SnapshotPtr snapshot = new Snapshot(current());
+    snapshot->servants = setServants(snapshot->servants, ident, FacetMap(), 0);
+    publish(snapshot, released);
     return result;
 }
 
 ObjectPtr
 IceInternal::ServantManager::findServant(const Identity& ident, const string& facet) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     //
-    // This assert is not valid if the adapter dispatch incoming
-    // requests from bidir connections. This method might be called if
-    // requests are received over the bidir connection after the
-    // adapter was deactivated.
+    // This method might be called after destruction if the adapter
+    // dispatch incoming requests from bidir connections, the maps are
+    // empty in this case.
     //
-    //assert(_instance); // Must not be called after destruction.
+    ReadGuard snapshot(*this);
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-    FacetMap::iterator q;
-
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
-
-    if(p == servantMapMap.end() || p->first != ident)
-    {
-        p = servantMapMap.find(ident);
-    }
+    const FacetMap* facets = snapshot->findFacets(ident);
+    FacetMap::const_iterator q;
 
-    if(p == servantMapMap.end() || (q = p->second.find(facet)) == p->second.end())
+    if(!facets || (q = facets->find(facet)) == facets->end())
     {
-        DefaultServantMap::const_iterator p = _defaultServantMap.find(ident.category);
-        if(p == _defaultServantMap.end())
+        DefaultServantMap::const_iterator p = snapshot->defaultServants.find(ident.category);
+        if(p == snapshot->defaultServants.end())
         {
-            p = _defaultServantMap.find("");
-            if(p == _defaultServantMap.end())
+            p = snapshot->defaultServants.find("");
+            if(p == snapshot->defaultServants.end())
             {
                 return 0;
             }
@@ -242,7 +417,6 @@ IceInternal::ServantManager::findServant(const Identity& ident, const string& fa
     }
     else
     {
-        _servantMapMapHint = p;
         return q->second;
     }
 }
@@ -250,10 +424,10 @@ IceInternal::ServantManager::findServant(const Identity& ident, const string& fa
 ObjectPtr
 IceInternal::ServantManager::findDefaultServant(const string& category) const
 {
-    IceUtil::Mutex::Lock sync(*this);
+    ReadGuard snapshot(*this);
 
-    DefaultServantMap::const_iterator p = _defaultServantMap.find(category);
-    if(p == _defaultServantMap.end())
+    DefaultServantMap::const_iterator p = snapshot->defaultServants.find(category);
+    if(p == snapshot->defaultServants.end())
     {
         return 0;
     }
@@ -266,59 +440,37 @@ IceInternal::ServantManager::findDefaultServant(const string& category) const
 FacetMap
 IceInternal::ServantManager::findAllFacets(const Identity& ident) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
-    assert(_instance); // Must not be called after destruction.
-
-    ServantMapMap::iterator p = _servantMapMapHint;
-
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
+    ReadGuard snapshot(*this);
 
-    if(p == servantMapMap.end() || p->first != ident)
-    {
-        p = servantMapMap.find(ident);
-    }
-
-    if(p == servantMapMap.end())
+    const FacetMap* facets = snapshot->findFacets(ident);
+    if(!facets)
     {
         return FacetMap();
     }
     else
     {
-        _servantMapMapHint = p;
-        return p->second;
+        return *facets;
     }
 }
 
 bool
 IceInternal::ServantManager::hasServant(const Identity& ident) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     //
-    // This assert is not valid if the adapter dispatch incoming
-    // requests from bidir connections. This method might be called if
-    // requests are received over the bidir connection after the
-    // adapter was deactivated.
+    // This method might be called after destruction if the adapter
+    // dispatch incoming requests from bidir connections, the maps are
+    // empty in this case.
     //
-    //assert(_instance); // Must not be called after destruction.
-
-    ServantMapMap::iterator p = _servantMapMapHint;
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
+    ReadGuard snapshot(*this);
 
-    if(p == servantMapMap.end() || p->first != ident)
-    {
-        p = servantMapMap.find(ident);
-    }
-
-    if(p == servantMapMap.end())
+    const FacetMap* facets = snapshot->findFacets(ident);
+    if(!facets)
     {
         return false;
     }
     else
     {
-        _servantMapMapHint = p;
-        assert(!p->second.empty());
+        assert(!facets->empty());
         return true;
     }
 }
@@ -326,12 +478,13 @@ IceInternal::ServantManager::hasServant(const Identity& ident) const
 void
 IceInternal::ServantManager::addServantLocator(const ServantLocatorPtr& locator, const string& category)
 {
+    vector<SnapshotPtr> released; // Released once *this is unlocked
+
     IceUtil::Mutex::Lock sync(*this);
 
     assert(_instance); // Must not be called after destruction.
 
-    if((_locatorMapHint != _locatorMap.end() && _locatorMapHint->first == category)
-       || _locatorMap.find(category) != _locatorMap.end())
+    if(current().locators.find(category) != current().locators.end())
     {
         AlreadyRegisteredException ex(__FILE__, __LINE__);
         ex.kindOfObject = "servant locator";
@@ -339,31 +492,23 @@ IceInternal::ServantManager::addServantLocator(const ServantLocatorPtr& locator,
         throw ex;
     }
 
-    _locatorMapHint = _locatorMap.insert(_locatorMapHint, pair<const string, ServantLocatorPtr>(category, locator));
+    SnapshotPtr snapshot = new Snapshot(current());
+    snapshot->locators.insert(pair<const string, ServantLocatorPtr>(category, locator));
+    publish(snapshot, released);
 }
 
 ServantLocatorPtr
 IceInternal::ServantManager::removeServantLocator(const string& category)
 {
+    ServantLocatorPtr locator;
+    vector<SnapshotPtr> released;
+
     IceUtil::Mutex::Lock sync(*this);
 
     assert(_instance); // Must not be called after destruction.
 
-    map<string, ServantLocatorPtr>::iterator p = _locatorMap.end();
-    if(_locatorMapHint != p)
-    {
-        if(_locatorMapHint->first == category)
-        {
-            p = _locatorMapHint;
-        }
-    }
-
-    if(p == _locatorMap.end())
-    {
-        p = _locatorMap.find(category);
-    }
-
-    if(p == _locatorMap.end())
+    LocatorMap::const_iterator p = current().locators.find(category);
+    if(p == current().locators.end())
     {
         NotRegisteredException ex(__FILE__, __LINE__);
         ex.kindOfObject = "servant locator";
@@ -371,45 +516,27 @@ IceInternal::ServantManager::removeServantLocator(const string& category)
         throw ex;
     }
 
-    ServantLocatorPtr locator = p->second;
-    _locatorMap.erase(p);
-    _locatorMapHint = _locatorMap.begin();
+    locator = p->second;
+
+    SnapshotPtr snapshot = new Snapshot(current());
+    snapshot->locators.erase(category);
+    publish(snapshot, released);
     return locator;
 }
 
 ServantLocatorPtr
 IceInternal::ServantManager::findServantLocator(const string& category) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     //
-    // This assert is not valid if the adapter dispatch incoming
-    // requests from bidir connections. This method might be called if
-    // requests are received over the bidir connection after the
-    // adapter was deactivated.
+    // This method might be called after destruction if the adapter
+    // dispatch incoming requests from bidir connections, the maps are
+    // empty in this case.
     //
-    //assert(_instance); // Must not be called after destruction.
-
-    map<string, ServantLocatorPtr>& locatorMap =
-        const_cast<map<string, ServantLocatorPtr>&>(_locatorMap);
-
-    map<string, ServantLocatorPtr>::iterator p = locatorMap.end();
-    if(_locatorMapHint != locatorMap.end())
-    {
-        if(_locatorMapHint->first == category)
-        {
-            p = _locatorMapHint;
-        }
-    }
-
-    if(p == locatorMap.end())
-    {
-        p = locatorMap.find(category);
-    }
+    ReadGuard snapshot(*this);
 
-    if(p != locatorMap.end())
+    LocatorMap::const_iterator p = snapshot->locators.find(category);
+    if(p != snapshot->locators.end())
     {
-        _locatorMapHint = p;
         return p->second;
     }
     else
@@ -421,9 +548,17 @@ IceInternal::ServantManager::findServantLocator(const string& category) const
 IceInternal::ServantManager::ServantManager(const InstancePtr& instance, const string& adapterName)
     : _instance(instance),
       _adapterName(adapterName),
-      _servantMapMapHint(_servantMapMap.end()),
-      _locatorMapHint(_locatorMap.end())
+      _priority(1)
 {
+    _snapshots[0].snapshot = new Snapshot();
+    _snapshots[0].state = SnapshotCurrent;
+    _current.exchange(0);
+    _epoch.exchange(0);
+    for(int i = 0; i < ReaderShards; ++i)
+    {
+        _readers[i].count[0].exchange(0);
+        _readers[i].count[1].exchange(0);
+    }
 }
 
 IceInternal::ServantManager::~ServantManager()
@@ -439,9 +574,8 @@ IceInternal::ServantManager::~ServantManager()
 void
 IceInternal::ServantManager::destroy()
 {
-    ServantMapMap servantMapMap;
-    DefaultServantMap defaultServantMap;
-    map<string, ServantLocatorPtr> locatorMap;
+    SnapshotPtr snapshot;
+    vector<SnapshotPtr> released;
     Ice::LoggerPtr logger;
 
     {
@@ -456,18 +590,28 @@ IceInternal::ServantManager::destroy()
 
         logger = _instance->initializationData().logger;
 
-        servantMapMap.swap(_servantMapMap);
-        _servantMapMapHint = _servantMapMap.end();
-
-        defaultServantMap.swap(_defaultServantMap);
+        snapshot = _snapshots[_current.load()].snapshot;
+        publish(new Snapshot(), released);
 
-        locatorMap.swap(_locatorMap);
-        _locatorMapHint = _locatorMap.end();
+        //
+        // Wait for the lookups which might still use the replaced snapshots
+        // to release the servants now rather than with the destruction of
+        // the ServantManager. Lookups don't block, this doesn't take long.
+        //
+        while(true)
+        {
+            reclaim(released);
+            if(!hasRetired())
+            {
+                break;
+            }
+            IceUtil::ThreadControl::yield();
+        }
 
         _instance = 0;
     }
 
-    for(map<string, ServantLocatorPtr>::const_iterator p = locatorMap.begin(); p != locatorMap.end(); ++p)
+    for(LocatorMap::const_iterator p = snapshot->locators.begin(); p != snapshot->locators.end(); ++p)
     {
         try
         {
@@ -491,11 +635,102 @@ IceInternal::ServantManager::destroy()
     }
 
     //
-    // We clear the maps outside the synchronization as we don't want to
-    // hold any internal Ice mutex while running user code (such as servant
+    // We release the snapshots outside the synchronization as we don't want
+    // to hold any internal Ice mutex while running user code (such as servant
     // or servant locator destructors).
     //
-    servantMapMap.clear();
-    locatorMap.clear();
-    defaultServantMap.clear();
+    released.clear();
+    snapshot = 0;
+}
+
+void
+IceInternal::ServantManager::publish(const SnapshotPtr& snapshot, vector<SnapshotPtr>& released)
+{
+    //
+    // Must be called with *this locked.
+    //
+    int slot = -1;
+    while(true)
+    {
+        reclaim(released);
+        for(int i = 0; i < SnapshotSlots; ++i)
+        {
+            if(!_snapshots[i].snapshot)
+            {
+                slot = i;
+                break;
+            }
+        }
+        if(slot >= 0)
+        {
+            break;
+        }
+
+        //
+        // All the slots are used by snapshots which might still be read,
+        // this only occurs with many updates in a row. Lookups don't block,
+        // their snapshots are released shortly.
+        //
+        IceUtil::ThreadControl::yield();
+    }
+
+    _snapshots[slot].snapshot = snapshot;
+    _snapshots[slot].state = SnapshotCurrent;
+    _snapshots[_current.exchange(slot)].state = SnapshotRetired;
+}
+
+void
+IceInternal::ServantManager::reclaim(vector<SnapshotPtr>& released)
+{
+    //
+    // Must be called with *this locked. The epoch can change once the
+    // lookups of the previous epoch, which use the same counters as the
+    // next epoch, are done. The snapshots replaced before the current
+    // epoch can then be released: the lookups which started before the
+    // current epoch are done and the others can't see them.
+    //
+    int epoch = _epoch.load();
+    for(int i = 0; i < ReaderShards; ++i)
+    {
+        if(_readers[i].count[(epoch + 1) & 1].load() > 0)
+        {
+            return;
+        }
+    }
+
+    for(int i = 0; i < SnapshotSlots; ++i)
+    {
+        if(_snapshots[i].snapshot && _snapshots[i].state == SnapshotExpired)
+        {
+            released.push_back(_snapshots[i].snapshot);
+            _snapshots[i].snapshot = 0;
+        }
+        else if(_snapshots[i].snapshot && _snapshots[i].state == SnapshotRetired)
+        {
+            _snapshots[i].state = SnapshotExpired;
+        }
+    }
+    ++_epoch;
+}
+
+bool
+IceInternal::ServantManager::hasRetired() const
+{
+    for(int i = 0; i < SnapshotSlots; ++i)
+    {
+        if(_snapshots[i].snapshot && _snapshots[i].state != SnapshotCurrent)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+const IceInternal::ServantManager::Snapshot&
+IceInternal::ServantManager::current() const
+{
+    //
+    // Must be called with *this locked.
+    //
+    return *_snapshots[_current.load()].snapshot;
 }
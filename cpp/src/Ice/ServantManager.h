@@ -12,6 +12,7 @@
 
 #include <IceUtil/Shared.h>
 #include <IceUtil/Mutex.h>
+#include <IceUtil/Atomic.h>
 #include <Ice/ServantManagerF.h>
 #include <Ice/InstanceF.h>
 #include <Ice/ServantLocatorF.h>
@@ -53,20 +54,63 @@ private:
     void destroy();
     friend class Ice::ObjectAdapterI;
 
+    //
+    // Lookups occur for every dispatched request and don't lock any mutex:
+    // they read the current snapshot of the maps, which is immutable.
+    // Updates are serialized with the ServantManager mutex, they publish
+    // a new snapshot which shares the unmodified nodes of the servant tree
+    // with the previous snapshot. A replaced snapshot is released once the
+    // lookups which started before its replacement are done, the readers
+    // are counted per epoch in counters selected with the thread ID.
+    //
+    struct Snapshot;
+    typedef IceUtil::Handle<Snapshot> SnapshotPtr;
+
+    class ReadGuard;
+    friend class ReadGuard;
+
+    void publish(const SnapshotPtr&, std::vector<SnapshotPtr>&);
+    void reclaim(std::vector<SnapshotPtr>&);
+    bool hasRetired() const;
+    const Snapshot& current() const;
+
+    enum
+    {
+        ReaderShards = 16,
+        SnapshotSlots = 8
+    };
+
+    struct ReaderCount
+    {
+        IceUtilInternal::Atomic count[2]; // The lookups of the even and odd epochs
+        char pad[64]; // Keep the counters on separate cache lines
+    };
+
+    enum SnapshotState
+    {
+        SnapshotCurrent,
+        SnapshotRetired, // Replaced during the current epoch
+        SnapshotExpired // Replaced during a previous epoch, released with the next epoch change
+    };
+
+    struct SnapshotSlot
+    {
+        SnapshotPtr snapshot; // Null for a free slot
+        SnapshotState state;
+    };
+
     InstancePtr _instance;
 
     const std::string _adapterName;
 
-    typedef std::map<Ice::Identity, Ice::FacetMap> ServantMapMap;
     typedef std::map<std::string, Ice::ObjectPtr> DefaultServantMap;
+    typedef std::map<std::string, Ice::ServantLocatorPtr> LocatorMap;
 
-    ServantMapMap _servantMapMap;
-    mutable ServantMapMap::iterator _servantMapMapHint;
-
-    DefaultServantMap _defaultServantMap;
-
-    std::map<std::string, Ice::ServantLocatorPtr> _locatorMap;
-    mutable std::map<std::string, Ice::ServantLocatorPtr>::iterator _locatorMapHint;
+    SnapshotSlot _snapshots[SnapshotSlots];
+    IceUtilInternal::Atomic _current; // The slot of the current snapshot
+    IceUtilInternal::Atomic _epoch;
+    mutable ReaderCount _readers[ReaderShards];
+    unsigned int _priority; // The priority of the next servant tree node
 };
 
 }
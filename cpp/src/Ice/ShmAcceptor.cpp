@@ -0,0 +1,80 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/ShmAcceptor.h>
+
+#ifdef ICE_USE_SHM_TRANSPORT
+
+#include <Ice/ShmTransceiver.h>
+#include <Ice/ShmEndpoint.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceInternal::NativeInfoPtr
+IceInternal::ShmAcceptor::getNativeInfo()
+{
+    return _delegate->getNativeInfo();
+}
+
+void
+IceInternal::ShmAcceptor::close()
+{
+    _delegate->close();
+}
+
+EndpointIPtr
+IceInternal::ShmAcceptor::listen()
+{
+    _endpoint = _endpoint->endpoint(_delegate->listen());
+    return _endpoint;
+}
+
+IceInternal::TransceiverPtr
+IceInternal::ShmAcceptor::accept()
+{
+    //
+    // The shared memory segment is received in ShmTransceiver::initialize,
+    // since accept must not block.
+    //
+    return new ShmTransceiver(_instance, _delegate->accept(), true);
+}
+
+string
+IceInternal::ShmAcceptor::protocol() const
+{
+    return _delegate->protocol();
+}
+
+string
+IceInternal::ShmAcceptor::toString() const
+{
+    return _delegate->toString();
+}
+
+string
+IceInternal::ShmAcceptor::toDetailedString() const
+{
+    return _delegate->toDetailedString();
+}
+
+IceInternal::ShmAcceptor::ShmAcceptor(const ShmEndpointPtr& endpoint, const ProtocolInstancePtr& instance,
+                                      const AcceptorPtr& del) :
+    _endpoint(endpoint),
+    _instance(instance),
+    _delegate(del)
+{
+}
+
+IceInternal::ShmAcceptor::~ShmAcceptor()
+{
+}
+
+#endif
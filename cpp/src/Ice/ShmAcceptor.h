@@ -0,0 +1,53 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_SHM_ACCEPTOR_H
+#define ICE_SHM_ACCEPTOR_H
+
+#include <Ice/TransceiverF.h>
+#include <Ice/Acceptor.h>
+#include <Ice/Network.h> // For ICE_USE_SHM_TRANSPORT
+#include <Ice/ProtocolInstance.h>
+
+#ifdef ICE_USE_SHM_TRANSPORT
+
+namespace IceInternal
+{
+
+class ShmEndpoint;
+
+class ShmAcceptor : public Acceptor, public NativeInfo
+{
+public:
+
+    virtual NativeInfoPtr getNativeInfo();
+
+    virtual void close();
+    virtual EndpointIPtr listen();
+    virtual TransceiverPtr accept();
+    virtual std::string protocol() const;
+    virtual std::string toString() const;
+    virtual std::string toDetailedString() const;
+
+private:
+
+    ShmAcceptor(const ShmEndpointPtr&, const ProtocolInstancePtr&, const AcceptorPtr&);
+    virtual ~ShmAcceptor();
+    friend class ShmEndpoint;
+
+    ShmEndpointPtr _endpoint;
+    const ProtocolInstancePtr _instance;
+    const AcceptorPtr _delegate;
+};
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,81 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/ShmConnector.h>
+
+#ifdef ICE_USE_SHM_TRANSPORT
+
+#include <Ice/ShmTransceiver.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceInternal::TransceiverPtr
+IceInternal::ShmConnector::connect()
+{
+    return new ShmTransceiver(_instance, _delegate->connect(), false);
+}
+
+Short
+IceInternal::ShmConnector::type() const
+{
+    return _delegate->type();
+}
+
+string
+IceInternal::ShmConnector::toString() const
+{
+    return _delegate->toString();
+}
+
+bool
+IceInternal::ShmConnector::operator==(const Connector& r) const
+{
+    const ShmConnector* p = dynamic_cast<const ShmConnector*>(&r);
+    if(!p)
+    {
+        return false;
+    }
+
+    if(this == p)
+    {
+        return true;
+    }
+
+    return *_delegate == *p->_delegate;
+}
+
+bool
+IceInternal::ShmConnector::operator<(const Connector& r) const
+{
+    const ShmConnector* p = dynamic_cast<const ShmConnector*>(&r);
+    if(!p)
+    {
+        return type() < r.type();
+    }
+
+    if(this == p)
+    {
+        return false;
+    }
+
+    return *_delegate < *p->_delegate;
+}
+
+IceInternal::ShmConnector::ShmConnector(const ProtocolInstancePtr& instance, const ConnectorPtr& del) :
+    _instance(instance), _delegate(del)
+{
+}
+
+IceInternal::ShmConnector::~ShmConnector()
+{
+}
+
+#endif
@@ -0,0 +1,48 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_SHM_CONNECTOR_H
+#define ICE_SHM_CONNECTOR_H
+
+#include <Ice/TransceiverF.h>
+#include <Ice/Connector.h>
+#include <Ice/ProtocolInstance.h>
+#include <Ice/Network.h> // For ICE_USE_SHM_TRANSPORT
+
+#ifdef ICE_USE_SHM_TRANSPORT
+
+namespace IceInternal
+{
+
+class ShmConnector : public Connector
+{
+public:
+
+    virtual TransceiverPtr connect();
+
+    virtual Ice::Short type() const;
+    virtual std::string toString() const;
+
+    virtual bool operator==(const Connector&) const;
+    virtual bool operator<(const Connector&) const;
+
+    ShmConnector(const ProtocolInstancePtr&, const ConnectorPtr&);
+    virtual ~ShmConnector();
+
+private:
+
+    const ProtocolInstancePtr _instance;
+    const ConnectorPtr _delegate;
+};
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,316 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/ShmEndpoint.h>
+
+#ifdef ICE_USE_SHM_TRANSPORT
+
+#include <Ice/ShmAcceptor.h>
+#include <Ice/ShmConnector.h>
+#include <Ice/OutputStream.h>
+#include <Ice/InputStream.h>
+#include <Ice/LocalException.h>
+#include <Ice/Comparable.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+#ifndef ICE_CPP11_MAPPING
+IceUtil::Shared* IceInternal::upCast(ShmEndpoint* p) { return p; }
+#endif
+
+IceInternal::ShmEndpoint::ShmEndpoint(const ProtocolInstancePtr& instance, const EndpointIPtr& del) :
+    _instance(instance), _delegate(del)
+{
+}
+
+Ice::EndpointInfoPtr
+IceInternal::ShmEndpoint::getInfo() const
+{
+    ShmEndpointInfoPtr info = ICE_MAKE_SHARED(InfoI<Ice::ShmEndpointInfo>, ICE_SHARED_FROM_CONST_THIS(ShmEndpoint));
+    info->underlying = _delegate->getInfo();
+    info->compress = info->underlying->compress;
+    info->timeout = info->underlying->timeout;
+    return info;
+}
+
+Ice::Short
+IceInternal::ShmEndpoint::type() const
+{
+    return _delegate->type();
+}
+
+const string&
+IceInternal::ShmEndpoint::protocol() const
+{
+    return _delegate->protocol();
+}
+
+void
+IceInternal::ShmEndpoint::streamWriteImpl(OutputStream* s) const
+{
+    _delegate->streamWriteImpl(s);
+}
+
+Int
+IceInternal::ShmEndpoint::timeout() const
+{
+    return _delegate->timeout();
+}
+
+EndpointIPtr
+IceInternal::ShmEndpoint::timeout(Int timeout) const
+{
+    if(timeout == _delegate->timeout())
+    {
+        return ICE_SHARED_FROM_CONST_THIS(ShmEndpoint);
+    }
+    else
+    {
+        return ICE_MAKE_SHARED(ShmEndpoint, _instance, _delegate->timeout(timeout));
+    }
+}
+
+const string&
+IceInternal::ShmEndpoint::connectionId() const
+{
+    return _delegate->connectionId();
+}
+
+EndpointIPtr
+IceInternal::ShmEndpoint::connectionId(const string& connectionId) const
+{
+    if(connectionId == _delegate->connectionId())
+    {
+        return ICE_SHARED_FROM_CONST_THIS(ShmEndpoint);
+    }
+    else
+    {
+        return ICE_MAKE_SHARED(ShmEndpoint, _instance, _delegate->connectionId(connectionId));
+    }
+}
+
+bool
+IceInternal::ShmEndpoint::compress() const
+{
+    return _delegate->compress();
+}
+
+EndpointIPtr
+IceInternal::ShmEndpoint::compress(bool compress) const
+{
+    if(compress == _delegate->compress())
+    {
+        return ICE_SHARED_FROM_CONST_THIS(ShmEndpoint);
+    }
+    else
+    {
+        return ICE_MAKE_SHARED(ShmEndpoint, _instance, _delegate->compress(compress));
+    }
+}
+
+bool
+IceInternal::ShmEndpoint::datagram() const
+{
+    return false;
+}
+
+bool
+IceInternal::ShmEndpoint::secure() const
+{
+    return _delegate->secure();
+}
+
+TransceiverPtr
+IceInternal::ShmEndpoint::transceiver() const
+{
+    return 0;
+}
+
+void
+IceInternal::ShmEndpoint::connectors_async(Ice::EndpointSelectionType selType,
+                                           const EndpointI_connectorsPtr& callback) const
+{
+    class CallbackI : public EndpointI_connectors
+    {
+    public:
+
+        CallbackI(const EndpointI_connectorsPtr& callback, const ProtocolInstancePtr& instance) :
+            _callback(callback), _instance(instance)
+        {
+        }
+
+        virtual void connectors(const vector<ConnectorPtr>& c)
+        {
+            vector<ConnectorPtr> connectors = c;
+            for(vector<ConnectorPtr>::iterator p = connectors.begin(); p != connectors.end(); ++p)
+            {
+                *p = new ShmConnector(_instance, *p);
+            }
+            _callback->connectors(connectors);
+        }
+
+        virtual void exception(const Ice::LocalException& ex)
+        {
+            _callback->exception(ex);
+        }
+
+    private:
+
+        const EndpointI_connectorsPtr _callback;
+        const ProtocolInstancePtr _instance;
+    };
+
+    _delegate->connectors_async(selType, ICE_MAKE_SHARED(CallbackI, callback, _instance));
+}
+
+AcceptorPtr
+IceInternal::ShmEndpoint::acceptor(const string& adapterName) const
+{
+    AcceptorPtr delAcc = _delegate->acceptor(adapterName);
+    return new ShmAcceptor(ICE_SHARED_FROM_CONST_THIS(ShmEndpoint), _instance, delAcc);
+}
+
+ShmEndpointPtr
+IceInternal::ShmEndpoint::endpoint(const EndpointIPtr& delEndp) const
+{
+    return ICE_MAKE_SHARED(ShmEndpoint, _instance, delEndp);
+}
+
+vector<EndpointIPtr>
+IceInternal::ShmEndpoint::expand() const
+{
+    vector<EndpointIPtr> endps = _delegate->expand();
+    for(vector<EndpointIPtr>::iterator p = endps.begin(); p != endps.end(); ++p)
+    {
+        *p = p->get() == _delegate.get() ? ICE_SHARED_FROM_CONST_THIS(ShmEndpoint) :
+                                           ICE_MAKE_SHARED(ShmEndpoint, _instance, *p);
+    }
+    return endps;
+}
+
+bool
+IceInternal::ShmEndpoint::equivalent(const EndpointIPtr& endpoint) const
+{
+    const ShmEndpoint* shmEndpoint = dynamic_cast<const ShmEndpoint*>(endpoint.get());
+    if(!shmEndpoint)
+    {
+        return false;
+    }
+    return _delegate->equivalent(shmEndpoint->_delegate);
+}
+
+Ice::Int
+IceInternal::ShmEndpoint::hash() const
+{
+    return _delegate->hash();
+}
+
+string
+IceInternal::ShmEndpoint::options() const
+{
+    return _delegate->options();
+}
+
+bool
+#ifdef ICE_CPP11_MAPPING
+IceInternal::ShmEndpoint::operator==(const Endpoint& r) const
+#else
+IceInternal::ShmEndpoint::operator==(const Ice::LocalObject& r) const
+#endif
+{
+    const ShmEndpoint* p = dynamic_cast<const ShmEndpoint*>(&r);
+    if(!p)
+    {
+        return false;
+    }
+
+    if(this == p)
+    {
+        return true;
+    }
+
+    return Ice::targetEqualTo(_delegate, p->_delegate);
+}
+
+bool
+#ifdef ICE_CPP11_MAPPING
+IceInternal::ShmEndpoint::operator<(const Endpoint& r) const
+#else
+IceInternal::ShmEndpoint::operator<(const Ice::LocalObject& r) const
+#endif
+{
+    const ShmEndpoint* p = dynamic_cast<const ShmEndpoint*>(&r);
+    if(!p)
+    {
+        const EndpointI* e = dynamic_cast<const EndpointI*>(&r);
+        if(!e)
+        {
+            return false;
+        }
+        return type() < e->type();
+    }
+
+    if(this == p)
+    {
+        return false;
+    }
+
+    return Ice::targetLess(_delegate, p->_delegate);
+}
+
+IceInternal::ShmEndpointFactory::ShmEndpointFactory(const ProtocolInstancePtr& instance,
+                                                    const EndpointFactoryPtr& del) :
+    _instance(instance), _delegate(del)
+{
+}
+
+IceInternal::ShmEndpointFactory::~ShmEndpointFactory()
+{
+}
+
+Short
+IceInternal::ShmEndpointFactory::type() const
+{
+    return _instance->type();
+}
+
+string
+IceInternal::ShmEndpointFactory::protocol() const
+{
+    return _instance->protocol();
+}
+
+EndpointIPtr
+IceInternal::ShmEndpointFactory::create(vector<string>& args, bool oaEndpoint) const
+{
+    return ICE_MAKE_SHARED(ShmEndpoint, _instance, _delegate->create(args, oaEndpoint));
+}
+
+EndpointIPtr
+IceInternal::ShmEndpointFactory::read(InputStream* s) const
+{
+    return ICE_MAKE_SHARED(ShmEndpoint, _instance, _delegate->read(s));
+}
+
+void
+IceInternal::ShmEndpointFactory::destroy()
+{
+    _delegate->destroy();
+    _instance = 0;
+}
+
+EndpointFactoryPtr
+IceInternal::ShmEndpointFactory::clone(const ProtocolInstancePtr& instance, const EndpointFactoryPtr& delegate) const
+{
+    return new ShmEndpointFactory(instance, delegate);
+}
+
+#endif
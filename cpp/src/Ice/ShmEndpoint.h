@@ -0,0 +1,106 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_SHM_ENDPOINT_H
+#define ICE_SHM_ENDPOINT_H
+
+#include <Ice/EndpointI.h>
+#include <Ice/EndpointFactory.h>
+#include <Ice/Endpoint.h>
+#include <Ice/ProtocolInstance.h>
+#include <Ice/Network.h> // For ICE_USE_SHM_TRANSPORT
+
+#ifdef ICE_USE_SHM_TRANSPORT
+
+namespace IceInternal
+{
+
+//
+// The shm endpoint wraps a Unix domain socket endpoint. The socket is
+// used to set up the connection and to signal the peer, the messages
+// are exchanged through ring buffers in a shared memory segment.
+//
+class ShmEndpoint : public EndpointI
+#ifdef ICE_CPP11_MAPPING
+                  , public std::enable_shared_from_this<ShmEndpoint>
+#endif
+{
+public:
+
+    ShmEndpoint(const ProtocolInstancePtr&, const EndpointIPtr&);
+
+    virtual void streamWriteImpl(Ice::OutputStream*) const;
+
+    virtual Ice::EndpointInfoPtr getInfo() const;
+    virtual Ice::Short type() const;
+    virtual const std::string& protocol() const;
+
+    virtual Ice::Int timeout() const;
+    virtual EndpointIPtr timeout(Ice::Int) const;
+    virtual const std::string& connectionId() const;
+    virtual EndpointIPtr connectionId(const ::std::string&) const;
+    virtual bool compress() const;
+    virtual EndpointIPtr compress(bool) const;
+    virtual bool datagram() const;
+    virtual bool secure() const;
+
+    virtual TransceiverPtr transceiver() const;
+    virtual void connectors_async(Ice::EndpointSelectionType, const EndpointI_connectorsPtr&) const;
+    virtual AcceptorPtr acceptor(const std::string&) const;
+
+    virtual std::vector<EndpointIPtr> expand() const;
+    virtual bool equivalent(const EndpointIPtr&) const;
+    virtual ::Ice::Int hash() const;
+    virtual std::string options() const;
+
+    ShmEndpointPtr endpoint(const EndpointIPtr&) const;
+
+#ifdef ICE_CPP11_MAPPING
+    virtual bool operator==(const Ice::Endpoint&) const;
+    virtual bool operator<(const Ice::Endpoint&) const;
+#else
+    virtual bool operator==(const Ice::LocalObject&) const;
+    virtual bool operator<(const Ice::LocalObject&) const;
+#endif
+
+private:
+
+    //
+    // All members are const, because endpoints are immutable.
+    //
+    const ProtocolInstancePtr _instance;
+    const EndpointIPtr _delegate;
+};
+
+class ShmEndpointFactory : public EndpointFactory
+{
+public:
+
+    ShmEndpointFactory(const ProtocolInstancePtr&, const EndpointFactoryPtr&);
+    virtual ~ShmEndpointFactory();
+
+    virtual Ice::Short type() const;
+    virtual std::string protocol() const;
+    virtual EndpointIPtr create(std::vector<std::string>&, bool) const;
+    virtual EndpointIPtr read(Ice::InputStream*) const;
+    virtual void destroy();
+
+    virtual EndpointFactoryPtr clone(const ProtocolInstancePtr&, const EndpointFactoryPtr&) const;
+
+private:
+
+    ProtocolInstancePtr _instance;
+    const EndpointFactoryPtr _delegate;
+};
+
+}
+
+#endif
+
+#endif
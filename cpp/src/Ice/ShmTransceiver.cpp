@@ -0,0 +1,957 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/ShmTransceiver.h>
+
+#ifdef ICE_USE_SHM_TRANSPORT
+
+#include <Ice/Connection.h>
+#include <Ice/LocalException.h>
+#include <Ice/Properties.h>
+#include <Ice/LoggerUtil.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#ifndef MFD_CLOEXEC
+#   define MFD_CLOEXEC 0x0001U
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+namespace IceInternal
+{
+
+//
+// The header of a ring buffer. The consumer owns the head and the
+// producer owns the tail, each on its own cache line. A side sets its
+// waiting flag before waiting for the peer, the peer clears it and
+// writes a byte on the socket once it made progress.
+//
+struct ShmRingHeader
+{
+    Ice::Long head;
+    char pad1[64 - sizeof(Ice::Long)];
+    Ice::Long tail;
+    char pad2[64 - sizeof(Ice::Long)];
+    Ice::Int readerWaiting;
+    Ice::Int writerWaiting;
+    char pad3[64 - 2 * sizeof(Ice::Int)];
+};
+
+}
+
+namespace
+{
+
+const Ice::Int handshakeMagic = 0x49636553; // "IceS"
+const Ice::Int handshakeVersion = 1;
+
+const size_t minRingSize = 4096;
+const size_t maxRingSize = 256 * 1024 * 1024;
+
+//
+// Each record starts with a header aligned on 8 bytes. The payload of
+// data records follows the header, the payload of spill records is
+// stored in a separate segment whose descriptor is sent on the socket
+// before the record is published.
+//
+struct RecordHeader
+{
+    Ice::Int size;
+    Ice::Int kind;
+};
+
+const size_t recordHeaderSize = sizeof(RecordHeader);
+const Ice::Int recordData = 0;
+const Ice::Int recordSpill = 1;
+
+const int maxDescriptors = 16;
+
+inline size_t
+align(size_t size)
+{
+    return (size + recordHeaderSize - 1) & ~(recordHeaderSize - 1);
+}
+
+inline Ice::Long
+loadAcquire(const Ice::Long* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+inline void
+storeRelease(Ice::Long* p, Ice::Long value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+//
+// Announce that we're about to wait for the peer. The fence orders the
+// flag store before the caller checks the ring again, the peer fences
+// between updating the ring and checking the flag, so either we see the
+// update or the peer sees the flag.
+//
+inline void
+setWaiting(Ice::Int* flag)
+{
+    __atomic_store_n(flag, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+inline bool
+clearWaiting(Ice::Int* flag)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    return __atomic_load_n(flag, __ATOMIC_RELAXED) && __atomic_exchange_n(flag, 0, __ATOMIC_ACQ_REL);
+}
+
+size_t
+getRingSize(const PropertiesPtr& properties)
+{
+    size_t size = static_cast<size_t>(max(properties->getPropertyAsIntWithDefault("Ice.Shm.RingSize", 1024 * 1024), 0));
+    size_t ringSize = minRingSize;
+    while(ringSize < size && ringSize < maxRingSize)
+    {
+        ringSize *= 2;
+    }
+    return ringSize;
+}
+
+int
+createMemoryFile(size_t size)
+{
+    int fd = static_cast<int>(syscall(__NR_memfd_create, "ice-shm", MFD_CLOEXEC));
+    if(fd < 0)
+    {
+        throw SyscallException(__FILE__, __LINE__, getSystemErrno());
+    }
+    if(ftruncate(fd, static_cast<off_t>(size)) < 0)
+    {
+        int error = getSystemErrno();
+        ::close(fd);
+        throw SyscallException(__FILE__, __LINE__, error);
+    }
+    return fd;
+}
+
+void
+copyToRing(Ice::Byte* ring, size_t ringSize, Ice::Long pos, const Ice::Byte* src, size_t size)
+{
+    size_t offset = static_cast<size_t>(pos) & (ringSize - 1);
+    size_t first = min(size, ringSize - offset);
+    memcpy(ring + offset, src, first);
+    memcpy(ring, src + first, size - first);
+}
+
+void
+copyFromRing(Ice::Byte* dest, const Ice::Byte* ring, size_t ringSize, Ice::Long pos, size_t size)
+{
+    size_t offset = static_cast<size_t>(pos) & (ringSize - 1);
+    size_t first = min(size, ringSize - offset);
+    memcpy(dest, ring + offset, first);
+    memcpy(dest + first, ring, size - first);
+}
+
+//
+// Returns the payload size of the next record for a packet of the given
+// size, or 0 if the ring doesn't have enough space.
+//
+size_t
+getPayloadSize(size_t available, size_t packetSize, size_t ringSize)
+{
+    if(available < recordHeaderSize)
+    {
+        return 0;
+    }
+    else if(packetSize > ringSize / 2)
+    {
+        return packetSize; // Spilled
+    }
+    return min(packetSize, (available - recordHeaderSize) & ~(recordHeaderSize - 1));
+}
+
+}
+
+NativeInfoPtr
+IceInternal::ShmTransceiver::getNativeInfo()
+{
+    return _delegate->getNativeInfo();
+}
+
+SocketOperation
+IceInternal::ShmTransceiver::initialize(Buffer& readBuffer, Buffer& writeBuffer)
+{
+    if(_state == StateInitializeDelegate)
+    {
+        SocketOperation op = _delegate->initialize(readBuffer, writeBuffer);
+        if(op != SocketOperationNone)
+        {
+            return op;
+        }
+
+        _fd = _delegate->getNativeInfo()->fd();
+        _state = StateHandshake;
+        if(!_incoming)
+        {
+            createSegment();
+        }
+    }
+
+    if(_state == StateHandshake)
+    {
+        if(_incoming ? !receiveSegment() : !sendSegment())
+        {
+            return _incoming ? SocketOperationRead : SocketOperationWrite;
+        }
+        _state = StateOpened;
+
+        //
+        // A writer waiting for ring space is woken up by the reader with a
+        // byte on the socket, which is always writable otherwise.
+        //
+        _delegate->getNativeInfo()->setWriteReadyOnInput(true);
+
+        if(_instance->traceLevel() >= 1)
+        {
+            Trace out(_instance->logger(), _instance->traceCategory());
+            out << "mapped " << _ringSize << " bytes ring buffers for " << protocol() << " connection\n" << toString();
+        }
+    }
+    return SocketOperationNone;
+}
+
+SocketOperation
+IceInternal::ShmTransceiver::closing(bool initiator, const Ice::LocalException& ex)
+{
+    return _delegate->closing(initiator, ex);
+}
+
+void
+IceInternal::ShmTransceiver::close()
+{
+    if(_segment)
+    {
+        munmap(_segment, _segmentSize);
+        _segment = 0;
+        _inHeader = _outHeader = 0;
+        _inData = _outData = 0;
+    }
+    if(_segmentFd >= 0)
+    {
+        ::close(_segmentFd);
+        _segmentFd = -1;
+    }
+    if(_spillData)
+    {
+        munmap(_spillData, _spillSize);
+        _spillData = 0;
+    }
+    if(_spillOutFd >= 0)
+    {
+        ::close(_spillOutFd);
+        _spillOutFd = -1;
+    }
+    for(deque<int>::const_iterator p = _descriptors.begin(); p != _descriptors.end(); ++p)
+    {
+        ::close(*p);
+    }
+    _descriptors.clear();
+    _state = StateClosed;
+    _delegate->close();
+}
+
+SocketOperation
+IceInternal::ShmTransceiver::write(Buffer& buf)
+{
+    if(buf.i == buf.b.end())
+    {
+        return SocketOperationNone;
+    }
+    assert(_state == StateOpened);
+
+    if(_writeWaiting)
+    {
+        //
+        // We're called because of input on the socket. Drain it, the
+        // connection might not be reading. If the peer published records
+        // meanwhile, the wake up byte for the reader might be drained as
+        // well so make sure the records are read.
+        //
+        _writeWaiting = false;
+        receive();
+        if(_peerClosed)
+        {
+            throw ConnectionLostException(__FILE__, __LINE__, 0);
+        }
+        if(_spillData || _recordSize > 0 || loadAcquire(&_inHeader->tail) != _inHeader->head)
+        {
+            _delegate->getNativeInfo()->ready(SocketOperationRead, true);
+        }
+    }
+
+    bool published = false;
+    while(buf.i != buf.b.end())
+    {
+        size_t packetSize = static_cast<size_t>(buf.b.end() - buf.i);
+        bool spill = packetSize > _ringSize / 2;
+        size_t size = getPayloadSize(writeAvailable(), packetSize, _ringSize);
+        if(size == 0 || (spill && !writeSpill(&*buf.i, size)))
+        {
+            //
+            // The ring (or the socket for spill descriptors) is full, wake
+            // up the reader if it's waiting for the records published so
+            // far and wait for the reader to consume some data. The reader
+            // wakes us up by making the socket readable.
+            //
+            if(published)
+            {
+                notifyReader();
+                published = false;
+            }
+            setWaiting(&_outHeader->writerWaiting);
+            size = getPayloadSize(writeAvailable(), packetSize, _ringSize);
+            if(size == 0 || (spill && !writeSpill(&*buf.i, size)))
+            {
+                _writeWaiting = true;
+                return SocketOperationWrite;
+            }
+        }
+
+        Ice::Long tail = _outHeader->tail;
+        RecordHeader* header = reinterpret_cast<RecordHeader*>(_outData + (static_cast<size_t>(tail) & (_ringSize - 1)));
+        header->size = static_cast<Ice::Int>(size);
+        if(spill)
+        {
+            header->kind = recordSpill;
+            tail += recordHeaderSize;
+        }
+        else
+        {
+            copyToRing(_outData, _ringSize, tail + recordHeaderSize, &*buf.i, size);
+            header->kind = recordData;
+            tail += recordHeaderSize + align(size);
+        }
+        storeRelease(&_outHeader->tail, tail);
+        buf.i += size;
+        published = true;
+    }
+
+    if(published)
+    {
+        notifyReader();
+    }
+    return SocketOperationNone;
+}
+
+SocketOperation
+IceInternal::ShmTransceiver::read(Buffer& buf)
+{
+    //
+    // The connection calls read with an empty buffer while it's being
+    // initialized.
+    //
+    if(buf.i == buf.b.end())
+    {
+        return SocketOperationNone;
+    }
+    assert(_state == StateOpened);
+
+    SocketOperation op = SocketOperationNone;
+    bool consumed = false;
+    while(buf.i != buf.b.end())
+    {
+        if(_spillData)
+        {
+            readSpill(buf);
+            continue;
+        }
+
+        Ice::Long head = _inHeader->head;
+        if(_recordSize > 0)
+        {
+            size_t size = min(_recordSize, static_cast<size_t>(buf.b.end() - buf.i));
+            copyFromRing(&*buf.i, _inData, _ringSize, head, size);
+            buf.i += size;
+            head += size;
+            _recordSize -= size;
+            if(_recordSize == 0)
+            {
+                head += _recordPadding;
+            }
+            storeRelease(&_inHeader->head, head);
+            consumed = true;
+            continue;
+        }
+
+        if(loadAcquire(&_inHeader->tail) == head)
+        {
+            //
+            // The ring is empty, drain the socket to detect the closure
+            // of the connection and announce that we're waiting before
+            // checking the ring again.
+            //
+            receive();
+            setWaiting(&_inHeader->readerWaiting);
+            if(loadAcquire(&_inHeader->tail) == head)
+            {
+                if(_peerClosed)
+                {
+                    throw ConnectionLostException(__FILE__, __LINE__, 0);
+                }
+                op = SocketOperationRead;
+                break;
+            }
+            continue;
+        }
+
+        const RecordHeader* header =
+            reinterpret_cast<const RecordHeader*>(_inData + (static_cast<size_t>(head) & (_ringSize - 1)));
+        size_t size = static_cast<size_t>(header->size);
+        if(header->kind == recordData && header->size > 0 && size <= _ringSize / 2)
+        {
+            _recordSize = size;
+            _recordPadding = align(size) - size;
+        }
+        else if(header->kind == recordSpill && header->size > 0)
+        {
+            if(_descriptors.empty())
+            {
+                receive();
+                if(_descriptors.empty())
+                {
+                    throw ProtocolException(__FILE__, __LINE__, "missing shared memory spill segment");
+                }
+            }
+            int fd = _descriptors.front();
+            _descriptors.pop_front();
+            mapSpill(fd, size);
+        }
+        else
+        {
+            throw ProtocolException(__FILE__, __LINE__, "invalid shared memory record");
+        }
+        storeRelease(&_inHeader->head, head + recordHeaderSize);
+        consumed = true;
+    }
+
+    if(consumed)
+    {
+        notifyWriter();
+    }
+
+    //
+    // If we return with data left in the ring, notify the selector that
+    // reading is possible without waiting for the socket. Otherwise, the
+    // writer must wake us up when it publishes the next record.
+    //
+    bool ready = false;
+    if(op == SocketOperationNone)
+    {
+        ready = _spillData || _recordSize > 0 || loadAcquire(&_inHeader->tail) != _inHeader->head;
+        if(!ready)
+        {
+            setWaiting(&_inHeader->readerWaiting);
+            ready = loadAcquire(&_inHeader->tail) != _inHeader->head;
+        }
+    }
+    _delegate->getNativeInfo()->ready(SocketOperationRead, ready);
+    return op;
+}
+
+string
+IceInternal::ShmTransceiver::protocol() const
+{
+    return _instance->protocol();
+}
+
+string
+IceInternal::ShmTransceiver::toString() const
+{
+    return _delegate->toString();
+}
+
+string
+IceInternal::ShmTransceiver::toDetailedString() const
+{
+    return _delegate->toDetailedString();
+}
+
+Ice::ConnectionInfoPtr
+IceInternal::ShmTransceiver::getInfo() const
+{
+    ShmConnectionInfoPtr info = ICE_MAKE_SHARED(ShmConnectionInfo);
+    info->underlying = _delegate->getInfo();
+    info->ringSize = static_cast<Ice::Int>(_ringSize);
+    return info;
+}
+
+void
+IceInternal::ShmTransceiver::checkSendSize(const Buffer& buf)
+{
+    _delegate->checkSendSize(buf);
+}
+
+void
+IceInternal::ShmTransceiver::setBufferSize(int rcvSize, int sndSize)
+{
+    _delegate->setBufferSize(rcvSize, sndSize);
+}
+
+IceInternal::ShmTransceiver::ShmTransceiver(const ProtocolInstancePtr& instance, const TransceiverPtr& del,
+                                            bool incoming) :
+    _instance(instance),
+    _delegate(del),
+    _incoming(incoming),
+    _state(StateInitializeDelegate),
+    _fd(INVALID_SOCKET),
+    _ringSize(incoming ? 0 : getRingSize(instance->properties())),
+    _segment(0),
+    _segmentSize(0),
+    _segmentFd(-1),
+    _inHeader(0),
+    _inData(0),
+    _outHeader(0),
+    _outData(0),
+    _handshakePos(0),
+    _recordSize(0),
+    _recordPadding(0),
+    _spillData(0),
+    _spillSize(0),
+    _spillPos(0),
+    _spillOutFd(-1),
+    _spillOutSize(0),
+    _peerClosed(false),
+    _writeWaiting(false)
+{
+    //
+    // The handshake and the notifications use the socket directly.
+    //
+    _delegate->getNativeInfo()->disableRingIO();
+}
+
+IceInternal::ShmTransceiver::~ShmTransceiver()
+{
+    assert(!_segment);
+}
+
+void
+IceInternal::ShmTransceiver::createSegment()
+{
+    _segmentSize = 2 * (sizeof(ShmRingHeader) + _ringSize);
+    _segmentFd = createMemoryFile(_segmentSize);
+    mapSegment(_segmentFd);
+
+    //
+    // Both sides start out waiting for data, the first record published
+    // on each ring wakes up the reader.
+    //
+    _inHeader->readerWaiting = 1;
+    _outHeader->readerWaiting = 1;
+}
+
+void
+IceInternal::ShmTransceiver::mapSegment(int fd)
+{
+    _segment = mmap(0, _segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if(_segment == MAP_FAILED)
+    {
+        _segment = 0;
+        throw SyscallException(__FILE__, __LINE__, getSystemErrno());
+    }
+
+    //
+    // The segment holds the headers of both rings followed by their data.
+    // The first ring carries the data sent by the connector side.
+    //
+    ShmRingHeader* headers = reinterpret_cast<ShmRingHeader*>(_segment);
+    Ice::Byte* data = reinterpret_cast<Ice::Byte*>(headers + 2);
+    _outHeader = _incoming ? headers + 1 : headers;
+    _outData = _incoming ? data + _ringSize : data;
+    _inHeader = _incoming ? headers : headers + 1;
+    _inData = _incoming ? data : data + _ringSize;
+}
+
+bool
+IceInternal::ShmTransceiver::sendSegment()
+{
+    //
+    // The handshake is sent with a single message, it's small enough
+    // to never be split on a newly connected socket.
+    //
+    _handshake[0] = handshakeMagic;
+    _handshake[1] = handshakeVersion;
+    _handshake[2] = static_cast<Ice::Int>(_ringSize);
+
+    iovec iov;
+    iov.iov_base = _handshake;
+    iov.iov_len = sizeof(_handshake);
+
+    union
+    {
+        cmsghdr header;
+        char data[CMSG_SPACE(sizeof(int))];
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.data;
+    msg.msg_controllen = sizeof(control.data);
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &_segmentFd, sizeof(int));
+
+    while(true)
+    {
+        ssize_t ret = ::sendmsg(_fd, &msg, MSG_NOSIGNAL);
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            if(wouldBlock())
+            {
+                return false;
+            }
+            if(connectionLost())
+            {
+                throw ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+        else if(static_cast<size_t>(ret) != sizeof(_handshake))
+        {
+            throw ProtocolException(__FILE__, __LINE__, "incomplete shared memory handshake");
+        }
+        break;
+    }
+
+    //
+    // The peer has its own reference to the segment now.
+    //
+    ::close(_segmentFd);
+    _segmentFd = -1;
+    _handshakePos = sizeof(_handshake);
+    return true;
+}
+
+bool
+IceInternal::ShmTransceiver::receiveSegment()
+{
+    receive();
+    if(_handshakePos < sizeof(_handshake))
+    {
+        if(_peerClosed)
+        {
+            throw ConnectionLostException(__FILE__, __LINE__, 0);
+        }
+        return false;
+    }
+
+    if(_handshake[0] != handshakeMagic || _handshake[1] != handshakeVersion)
+    {
+        throw ProtocolException(__FILE__, __LINE__, "invalid shared memory handshake");
+    }
+
+    size_t ringSize = static_cast<size_t>(_handshake[2]);
+    if(_handshake[2] <= 0 || ringSize < minRingSize || ringSize > maxRingSize || (ringSize & (ringSize - 1)) != 0)
+    {
+        throw ProtocolException(__FILE__, __LINE__, "invalid shared memory ring size");
+    }
+    if(_descriptors.empty())
+    {
+        throw ProtocolException(__FILE__, __LINE__, "missing shared memory segment");
+    }
+
+    _ringSize = ringSize;
+    _segmentSize = 2 * (sizeof(ShmRingHeader) + _ringSize);
+    _segmentFd = _descriptors.front();
+    _descriptors.pop_front();
+
+    //
+    // Make sure the segment is as large as announced, accessing pages
+    // beyond the end of the file would raise SIGBUS.
+    //
+    struct stat st;
+    if(fstat(_segmentFd, &st) < 0)
+    {
+        throw SyscallException(__FILE__, __LINE__, getSystemErrno());
+    }
+    if(static_cast<size_t>(st.st_size) < _segmentSize)
+    {
+        throw ProtocolException(__FILE__, __LINE__, "invalid shared memory segment");
+    }
+
+    mapSegment(_segmentFd);
+    ::close(_segmentFd);
+    _segmentFd = -1;
+    return true;
+}
+
+void
+IceInternal::ShmTransceiver::receive()
+{
+    while(true)
+    {
+        char data[256];
+        iovec iov;
+        iov.iov_base = data;
+        iov.iov_len = sizeof(data);
+
+        union
+        {
+            cmsghdr header;
+            char data[CMSG_SPACE(maxDescriptors * sizeof(int))];
+        } control;
+
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control.data;
+        msg.msg_controllen = sizeof(control.data);
+
+        ssize_t ret = ::recvmsg(_fd, &msg, MSG_CMSG_CLOEXEC);
+        if(ret == 0)
+        {
+            _peerClosed = true;
+            return;
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+            if(wouldBlock())
+            {
+                return;
+            }
+            if(connectionLost())
+            {
+                throw ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            throw SocketException(__FILE__, __LINE__, getSocketErrno());
+        }
+
+        bool descriptors = false;
+        for(cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+        {
+            if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+            {
+                size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                for(size_t i = 0; i < count; ++i)
+                {
+                    int fd;
+                    memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+                    _descriptors.push_back(fd);
+                }
+                descriptors = true;
+            }
+        }
+        if(msg.msg_flags & MSG_CTRUNC)
+        {
+            throw ProtocolException(__FILE__, __LINE__, "too many shared memory segments");
+        }
+
+        //
+        // Besides the handshake, the data carries no information: these
+        // are wake up bytes and the bytes sent with spill descriptors.
+        //
+        if(_handshakePos < sizeof(_handshake))
+        {
+            size_t size = min(sizeof(_handshake) - _handshakePos, static_cast<size_t>(ret));
+            memcpy(reinterpret_cast<char*>(_handshake) + _handshakePos, data, size);
+            _handshakePos += size;
+        }
+
+        //
+        // A short read without descriptors means the socket is drained,
+        // otherwise reading stopped at a message carrying descriptors.
+        //
+        if(!descriptors && static_cast<size_t>(ret) < sizeof(data))
+        {
+            return;
+        }
+    }
+}
+
+void
+IceInternal::ShmTransceiver::notify()
+{
+    //
+    // Errors are ignored: the socket can't be full since the peer waits
+    // for a single byte and the closure of the connection is detected
+    // by reading.
+    //
+    Ice::Byte b = 0;
+    while(::send(_fd, &b, 1, MSG_NOSIGNAL) == SOCKET_ERROR && interrupted())
+    {
+    }
+}
+
+void
+IceInternal::ShmTransceiver::notifyReader()
+{
+    if(clearWaiting(&_outHeader->readerWaiting))
+    {
+        notify();
+    }
+}
+
+void
+IceInternal::ShmTransceiver::notifyWriter()
+{
+    if(clearWaiting(&_inHeader->writerWaiting))
+    {
+        notify();
+    }
+}
+
+size_t
+IceInternal::ShmTransceiver::writeAvailable() const
+{
+    return _ringSize - static_cast<size_t>(_outHeader->tail - loadAcquire(&_outHeader->head));
+}
+
+bool
+IceInternal::ShmTransceiver::writeSpill(const Ice::Byte* data, size_t size)
+{
+    //
+    // The payload is copied to a new segment mapped in our address space,
+    // the reader maps it as well and copies it to its buffer. The segment
+    // is kept until its descriptor is sent, it's not written again if the
+    // socket is full.
+    //
+    if(_spillOutFd < 0)
+    {
+        int fd = createMemoryFile(size);
+        void* segment = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(segment == MAP_FAILED)
+        {
+            int error = getSystemErrno();
+            ::close(fd);
+            throw SyscallException(__FILE__, __LINE__, error);
+        }
+        memcpy(segment, data, size);
+        munmap(segment, size);
+        _spillOutFd = fd;
+        _spillOutSize = size;
+    }
+    assert(_spillOutSize == size);
+
+    Ice::Byte b = 0;
+    iovec iov;
+    iov.iov_base = &b;
+    iov.iov_len = 1;
+
+    union
+    {
+        cmsghdr header;
+        char data[CMSG_SPACE(sizeof(int))];
+    } control;
+    memset(&control, 0, sizeof(control));
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.data;
+    msg.msg_controllen = sizeof(control.data);
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &_spillOutFd, sizeof(int));
+
+    //
+    // The descriptor must be queued on the socket before the record is
+    // published. The socket fills up if the reader lags behind by many
+    // spilled messages, the caller then waits for the reader to catch up.
+    //
+    while(::sendmsg(_fd, &msg, MSG_NOSIGNAL) == SOCKET_ERROR)
+    {
+        if(interrupted())
+        {
+            continue;
+        }
+        if(wouldBlock())
+        {
+            return false;
+        }
+        if(connectionLost())
+        {
+            throw ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+        }
+        throw SocketException(__FILE__, __LINE__, getSocketErrno());
+    }
+
+    ::close(_spillOutFd);
+    _spillOutFd = -1;
+    return true;
+}
+
+void
+IceInternal::ShmTransceiver::mapSpill(int fd, size_t size)
+{
+    //
+    // Make sure the segment is as large as announced, accessing pages
+    // beyond the end of the file would raise SIGBUS.
+    //
+    struct stat st;
+    if(fstat(fd, &st) < 0)
+    {
+        int error = getSystemErrno();
+        ::close(fd);
+        throw SyscallException(__FILE__, __LINE__, error);
+    }
+    if(static_cast<size_t>(st.st_size) < size)
+    {
+        ::close(fd);
+        throw ProtocolException(__FILE__, __LINE__, "truncated shared memory spill segment");
+    }
+
+    void* segment = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+    int error = getSystemErrno();
+    ::close(fd);
+    if(segment == MAP_FAILED)
+    {
+        throw SyscallException(__FILE__, __LINE__, error);
+    }
+    _spillData = reinterpret_cast<Ice::Byte*>(segment);
+    _spillSize = size;
+    _spillPos = 0;
+}
+
+void
+IceInternal::ShmTransceiver::readSpill(Buffer& buf)
+{
+    size_t size = min(_spillSize - _spillPos, static_cast<size_t>(buf.b.end() - buf.i));
+    memcpy(&*buf.i, _spillData + _spillPos, size);
+    buf.i += size;
+    _spillPos += size;
+    if(_spillPos == _spillSize)
+    {
+        munmap(_spillData, _spillSize);
+        _spillData = 0;
+    }
+}
+
+#endif
@@ -0,0 +1,123 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_SHM_TRANSCEIVER_H
+#define ICE_SHM_TRANSCEIVER_H
+
+#include <Ice/ProtocolInstance.h>
+#include <Ice/Transceiver.h>
+#include <Ice/Network.h> // For ICE_USE_SHM_TRANSPORT
+#include <Ice/Buffer.h>
+
+#ifdef ICE_USE_SHM_TRANSPORT
+
+#include <deque>
+
+namespace IceInternal
+{
+
+struct ShmRingHeader;
+
+//
+// The connector side creates a shared memory segment holding one
+// single-producer/single-consumer ring buffer for each direction and
+// passes its descriptor to the acceptor side over the Unix domain
+// socket. Afterwards, the socket is only used to wake up a peer which
+// announced that it is waiting for data or for ring space, to pass the
+// descriptors of the spill segments used for messages too large for
+// the ring, and to detect the closure of the connection. Since a writer
+// is woken up with input on the socket, the selector polls the socket
+// for input when the connection waits to write.
+//
+class ShmTransceiver : public Transceiver
+{
+public:
+
+    virtual NativeInfoPtr getNativeInfo();
+
+    virtual SocketOperation initialize(Buffer&, Buffer&);
+    virtual SocketOperation closing(bool, const Ice::LocalException&);
+    virtual void close();
+    virtual SocketOperation write(Buffer&);
+    virtual SocketOperation read(Buffer&);
+    virtual std::string protocol() const;
+    virtual std::string toString() const;
+    virtual std::string toDetailedString() const;
+    virtual Ice::ConnectionInfoPtr getInfo() const;
+    virtual void checkSendSize(const Buffer&);
+    virtual void setBufferSize(int rcvSize, int sndSize);
+
+private:
+
+    ShmTransceiver(const ProtocolInstancePtr&, const TransceiverPtr&, bool);
+    virtual ~ShmTransceiver();
+
+    void createSegment();
+    void mapSegment(int);
+    bool sendSegment();
+    bool receiveSegment();
+
+    void receive();
+    void notify();
+    void notifyReader();
+    void notifyWriter();
+    size_t writeAvailable() const;
+    bool writeSpill(const Ice::Byte*, size_t);
+    void mapSpill(int, size_t);
+    void readSpill(Buffer&);
+
+    friend class ShmConnector;
+    friend class ShmAcceptor;
+
+    enum State
+    {
+        StateInitializeDelegate,
+        StateHandshake,
+        StateOpened,
+        StateClosed
+    };
+
+    const ProtocolInstancePtr _instance;
+    const TransceiverPtr _delegate;
+    const bool _incoming;
+
+    State _state;
+    SOCKET _fd;
+    size_t _ringSize;
+
+    void* _segment;
+    size_t _segmentSize;
+    int _segmentFd;
+    ShmRingHeader* _inHeader;
+    Ice::Byte* _inData;
+    ShmRingHeader* _outHeader;
+    Ice::Byte* _outData;
+
+    Ice::Int _handshake[3];
+    size_t _handshakePos;
+
+    std::deque<int> _descriptors;
+    size_t _recordSize;
+    size_t _recordPadding;
+    Ice::Byte* _spillData;
+    size_t _spillSize;
+    size_t _spillPos;
+
+    int _spillOutFd; // Spill segment whose descriptor couldn't be sent yet.
+    size_t _spillOutSize;
+
+    bool _peerClosed;
+    bool _writeWaiting;
+};
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,201 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/StreamReader.h>
+#include <Ice/ConnectionI.h>
+#include <Ice/LocalException.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(StreamReader* p) { return p; }
+
+Ice::ByteSource::~ByteSource()
+{
+    // Out of line to avoid weak vtable
+}
+
+namespace
+{
+
+//
+// The byte source given to the application, the stream is closed once
+// the application releases it.
+//
+class StreamReaderSource : public ByteSource
+{
+public:
+
+    StreamReaderSource(const StreamReaderPtr& reader) : _reader(reader)
+    {
+    }
+
+    virtual ~StreamReaderSource()
+    {
+        _reader->close();
+    }
+
+    virtual bool read(vector<Byte>& data, Int maxSize)
+    {
+        return _reader->read(data, maxSize);
+    }
+
+private:
+
+    const StreamReaderPtr _reader;
+};
+
+}
+
+IceInternal::MemoryByteSource::MemoryByteSource(const Byte* begin, const Byte* end) :
+    _data(begin, end),
+    _pos(0)
+{
+}
+
+bool
+IceInternal::MemoryByteSource::read(vector<Byte>& data, Int maxSize)
+{
+    size_t sz = min(static_cast<size_t>(max(maxSize, 1)), _data.size() - _pos);
+    data.assign(_data.begin() + _pos, _data.begin() + _pos + sz);
+    _pos += sz;
+    return sz > 0;
+}
+
+IceInternal::StreamReader::StreamReader(const ConnectionIPtr& connection, Int requestId, bool reply, Int window) :
+    _connection(connection),
+    _requestId(requestId),
+    _reply(reply),
+    _window(window),
+    _offset(0),
+    _credit(window),
+    _consumed(0),
+    _finished(false)
+{
+}
+
+IceInternal::StreamReader::~StreamReader()
+{
+    // Out of line to avoid weak vtable
+}
+
+void
+IceInternal::StreamReader::received(const Byte* begin, const Byte* end, bool last)
+{
+    Lock sync(*this);
+
+    //
+    // The chunks sent before the sender is told that the stream is closed
+    // are ignored, they must still fit in the credits.
+    //
+    if(end - begin > _credit)
+    {
+        throw ProtocolException(__FILE__, __LINE__, "streamed sequence chunk exceeds the credits granted to the sender");
+    }
+    _credit -= static_cast<Int>(end - begin);
+
+    if(_finished)
+    {
+        return;
+    }
+    if(begin != end)
+    {
+        _chunks.push_back(vector<Byte>(begin, end));
+    }
+    _finished = last;
+    notifyAll();
+}
+
+void
+IceInternal::StreamReader::failed(const LocalException& ex)
+{
+    Lock sync(*this);
+    if(_finished)
+    {
+        return;
+    }
+    _chunks.clear();
+    ICE_SET_EXCEPTION_FROM_CLONE(_exception, ex.ice_clone());
+    _finished = true;
+    notifyAll();
+}
+
+bool
+IceInternal::StreamReader::read(vector<Byte>& data, Int maxSize)
+{
+    Int credit = 0;
+    {
+        Lock sync(*this);
+        while(_chunks.empty() && !_finished)
+        {
+            wait();
+        }
+
+        if(_chunks.empty())
+        {
+            data.clear();
+            if(_exception)
+            {
+                _exception->ice_throw();
+            }
+            return false;
+        }
+
+        const vector<Byte>& chunk = _chunks.front();
+        size_t sz = min(static_cast<size_t>(max(maxSize, 1)), chunk.size() - _offset);
+        data.assign(chunk.begin() + _offset, chunk.begin() + _offset + sz);
+        _offset += sz;
+        if(_offset == chunk.size())
+        {
+            _chunks.pop_front();
+            _offset = 0;
+        }
+
+        //
+        // Grant new credits once half of the window is consumed, the
+        // sender doesn't need more credits once the stream is finished.
+        //
+        _consumed += static_cast<Int>(sz);
+        if(_consumed >= _window / 2 && !_finished)
+        {
+            credit = _consumed;
+            _credit += credit;
+            _consumed = 0;
+        }
+    }
+
+    if(credit > 0)
+    {
+        _connection->sendStreamCredit(_requestId, _reply, credit);
+    }
+    return true;
+}
+
+void
+IceInternal::StreamReader::close()
+{
+    {
+        Lock sync(*this);
+        if(_finished)
+        {
+            return;
+        }
+        _chunks.clear();
+        _finished = true;
+        notifyAll();
+    }
+    _connection->closeStream(_requestId, _reply);
+}
+
+ByteSourcePtr
+IceInternal::StreamReader::createSource(const StreamReaderPtr& reader)
+{
+    return ICE_MAKE_SHARED(StreamReaderSource, reader);
+}
@@ -0,0 +1,102 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_STREAM_READER_H
+#define ICE_STREAM_READER_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Mutex.h>
+#include <Ice/StreamReaderF.h>
+#include <Ice/ConnectionIF.h>
+#include <Ice/ByteSource.h>
+#include <Ice/UniquePtr.h>
+
+#include <deque>
+
+namespace Ice
+{
+
+class LocalException;
+
+}
+
+namespace IceInternal
+{
+
+//
+// The byte source of a streamed sequence marshaled in a message, it's
+// used when the sequence wasn't sent with stream chunk messages.
+//
+class MemoryByteSource : public Ice::ByteSource
+{
+public:
+
+    MemoryByteSource(const Ice::Byte*, const Ice::Byte*);
+
+    virtual bool read(std::vector<Ice::Byte>&, Ice::Int);
+
+private:
+
+    const std::vector<Ice::Byte> _data;
+    size_t _pos;
+};
+
+//
+// The reader of a streamed sequence received with stream chunk
+// messages. The connection queues the chunks with received() and the
+// application reads them with read(), which grants new credits to the
+// sender once half of the window is consumed. The sender must not send
+// more than the credits granted, received() raises ProtocolException
+// otherwise and the connection is closed.
+//
+class StreamReader : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    StreamReader(const Ice::ConnectionIPtr&, Ice::Int, bool, Ice::Int);
+    virtual ~StreamReader();
+
+    //
+    // Called by the connection with its mutex locked.
+    //
+    void received(const Ice::Byte*, const Ice::Byte*, bool);
+    void failed(const Ice::LocalException&);
+
+    bool read(std::vector<Ice::Byte>&, Ice::Int);
+
+    //
+    // Called once the application no longer reads the stream, the
+    // sender is told to stop sending if the stream isn't finished.
+    //
+    void close();
+
+    //
+    // Returns the byte source given to the application.
+    //
+    static Ice::ByteSourcePtr createSource(const StreamReaderPtr&);
+
+private:
+
+    const Ice::ConnectionIPtr _connection;
+    const Ice::Int _requestId;
+    const bool _reply;
+    const Ice::Int _window;
+
+    std::deque<std::vector<Ice::Byte> > _chunks;
+    size_t _offset;
+    Ice::Int _credit;
+    Ice::Int _consumed;
+    bool _finished;
+    IceInternal::UniquePtr<Ice::LocalException> _exception;
+};
+
+}
+
+#endif
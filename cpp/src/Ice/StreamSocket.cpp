@@ -11,8 +11,37 @@
 #include <Ice/NetworkProxy.h>
 #include <Ice/ProtocolInstance.h>
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+#   include <limits.h> // For IOV_MAX
+#endif
+
 using namespace IceInternal;
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+namespace
+{
+
+void
+throwSocketException(int error)
+{
+    errno = error;
+    if(connectionLost())
+    {
+        Ice::ConnectionLostException ex(__FILE__, __LINE__);
+        ex.error = error;
+        throw ex;
+    }
+    else
+    {
+        Ice::SocketException ex(__FILE__, __LINE__);
+        ex.error = error;
+        throw ex;
+    }
+}
+
+}
+#endif
+
 #if defined(ICE_OS_UWP)
 
 #include <Ice/Properties.h>
@@ -174,6 +203,9 @@ void
 StreamSocket::setBufferSize(int rcvSize, int sndSize)
 {
     setTcpBufSize(_fd, rcvSize, sndSize, _instance);
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+    _maxSendPacketSize = std::max(512, IceInternal::getSendBufferSize(_fd));
+#endif
 }
 
 SocketOperation
@@ -197,6 +229,12 @@ StreamSocket::read(Buffer& buf)
             }
         }
     }
+#if !defined(ICE_USE_IOCP)
+    if(_ringInfo && _state == StateConnected)
+    {
+        return ringRead(buf);
+    }
+#endif
     buf.i += read(reinterpret_cast<char*>(&*buf.i), buf.b.end() - buf.i);
 #endif
     return buf.i != buf.b.end() ? SocketOperationRead : SocketOperationNone;
@@ -223,6 +261,12 @@ StreamSocket::write(Buffer& buf)
             }
         }
     }
+#if !defined(ICE_USE_IOCP)
+    if(_ringInfo && _state == StateConnected)
+    {
+        return ringWrite(buf);
+    }
+#endif
     buf.i += write(reinterpret_cast<const char*>(&*buf.i), buf.b.end() - buf.i);
 #endif
     return buf.i != buf.b.end() ? SocketOperationWrite : SocketOperationNone;
@@ -368,6 +412,272 @@ StreamSocket::write(const char* buf, size_t length)
 }
 #endif
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+size_t
+StreamSocket::getGatherWriteSize() const
+{
+    //
+    // Gather writes are only used once the socket is connected, the proxy
+    // handshake (if any) writes a single buffer at a time.
+    //
+    return _state == StateConnected ? _maxSendPacketSize : 0;
+}
+
+SocketOperation
+StreamSocket::writev(std::vector<Buffer*>& bufs)
+{
+    assert(_fd != INVALID_SOCKET);
+    assert(_state == StateConnected);
+
+    std::vector<Buffer*>::iterator first = bufs.begin();
+    while(first != bufs.end() && (*first)->i == (*first)->b.end())
+    {
+        ++first;
+    }
+    if(_ringInfo && first != bufs.end() && !ringWriteCompleted(**first))
+    {
+        return SocketOperationWrite;
+    }
+
+    while(true)
+    {
+        while(first != bufs.end() && (*first)->i == (*first)->b.end())
+        {
+            ++first;
+        }
+        if(first == bufs.end())
+        {
+            return SocketOperationNone;
+        }
+
+        _iov.clear();
+        for(std::vector<Buffer*>::iterator p = first; p != bufs.end() && _iov.size() < IOV_MAX; ++p)
+        {
+            struct iovec iov;
+            iov.iov_base = &*(*p)->i;
+            iov.iov_len = static_cast<size_t>((*p)->b.end() - (*p)->i);
+            if(iov.iov_len > 0)
+            {
+                _iov.push_back(iov);
+            }
+        }
+
+        ssize_t ret = ::writev(_fd, &_iov[0], static_cast<int>(_iov.size()));
+        if(ret == 0)
+        {
+            Ice::ConnectionLostException ex(__FILE__, __LINE__);
+            ex.error = 0;
+            throw ex;
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            if(wouldBlock())
+            {
+                if(_ringInfo)
+                {
+                    //
+                    // Only the first buffer is sent with the write request,
+                    // it's the only one which can't be re-ordered by the
+                    // caller until it's completely sent.
+                    //
+                    ringWritePrepare(**first);
+                }
+                return SocketOperationWrite;
+            }
+
+            if(connectionLost())
+            {
+                Ice::ConnectionLostException ex(__FILE__, __LINE__);
+                ex.error = getSocketErrno();
+                throw ex;
+            }
+            else
+            {
+                Ice::SocketException ex(__FILE__, __LINE__);
+                ex.error = getSocketErrno();
+                throw ex;
+            }
+        }
+
+        //
+        // Advance the buffers, the write might have completed in the
+        // middle of a buffer.
+        //
+        size_t sent = static_cast<size_t>(ret);
+        for(std::vector<Buffer*>::iterator p = first; sent > 0; ++p)
+        {
+            assert(p != bufs.end());
+            size_t length = std::min(sent, static_cast<size_t>((*p)->b.end() - (*p)->i));
+            (*p)->i += length;
+            sent -= length;
+        }
+    }
+}
+#endif
+
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+SocketOperation
+StreamSocket::ringRead(Buffer& buf)
+{
+    //
+    // With the io_uring backend, the data is received by the selector with
+    // read requests into the ring buffer. The socket is only read directly
+    // if the last read request filled the ring buffer and more data is
+    // needed, it's likely available and is read directly into the buffer.
+    //
+    bool readMore;
+    {
+        IceUtil::Mutex::Lock sync(_ringInfo->mutex);
+        _ringInfo->enabled = true;
+        if(_ringInfo->readRequest)
+        {
+            return buf.i != buf.b.end() ? SocketOperationRead : SocketOperationNone;
+        }
+
+        size_t length = std::min(static_cast<size_t>(buf.b.end() - buf.i), _ringInfo->readEnd - _ringInfo->readBegin);
+        if(length > 0)
+        {
+            memcpy(&*buf.i, &_ringInfo->readBuffer[_ringInfo->readBegin], length);
+            buf.i += length;
+            _ringInfo->readBegin += length;
+        }
+        else if(buf.i != buf.b.end())
+        {
+            if(_ringInfo->readEof)
+            {
+                Ice::ConnectionLostException ex(__FILE__, __LINE__);
+                ex.error = 0;
+                throw ex;
+            }
+            else if(_ringInfo->readError)
+            {
+                throwSocketException(_ringInfo->readError);
+            }
+        }
+
+        readMore = _ringInfo->readBegin == _ringInfo->readEnd && _ringInfo->readMore && buf.i != buf.b.end();
+        _ringInfo->reading = readMore;
+    }
+
+    if(readMore)
+    {
+        ssize_t ret;
+        try
+        {
+            ret = read(reinterpret_cast<char*>(&*buf.i), buf.b.end() - buf.i);
+        }
+        catch(const Ice::LocalException&)
+        {
+            IceUtil::Mutex::Lock sync(_ringInfo->mutex);
+            _ringInfo->reading = false;
+            throw;
+        }
+        buf.i += ret;
+
+        IceUtil::Mutex::Lock sync(_ringInfo->mutex);
+        _ringInfo->reading = false;
+        _ringInfo->readMore = buf.i == buf.b.end();
+    }
+
+    //
+    // Notify the selector if data is still buffered, otherwise it issues
+    // a new read request.
+    //
+    bool buffered;
+    {
+        IceUtil::Mutex::Lock sync(_ringInfo->mutex);
+        buffered = _ringInfo->readBegin != _ringInfo->readEnd;
+    }
+    ready(SocketOperationRead, buffered);
+    return buf.i != buf.b.end() ? SocketOperationRead : SocketOperationNone;
+}
+
+SocketOperation
+StreamSocket::ringWrite(Buffer& buf)
+{
+    if(!ringWriteCompleted(buf))
+    {
+        return SocketOperationWrite;
+    }
+
+    if(buf.i != buf.b.end())
+    {
+        buf.i += write(reinterpret_cast<const char*>(&*buf.i), buf.b.end() - buf.i);
+        if(buf.i != buf.b.end())
+        {
+            ringWritePrepare(buf);
+            return SocketOperationWrite;
+        }
+    }
+    return SocketOperationNone;
+}
+
+bool
+StreamSocket::ringWriteCompleted(Buffer& buf)
+{
+    ssize_t result;
+    {
+        IceUtil::Mutex::Lock sync(_ringInfo->mutex);
+        _ringInfo->enabled = true;
+        if(_ringInfo->writeRequest)
+        {
+            return false; // The write request is still pending.
+        }
+        else if(!_ringInfo->writeCompleted)
+        {
+            return true;
+        }
+        _ringInfo->writeCompleted = false;
+        result = _ringInfo->writeResult;
+    }
+
+    //
+    // The result of the write request is consumed, the selector no longer
+    // reports the socket as ready for write.
+    //
+    ready(SocketOperationWrite, false);
+    if(result < 0)
+    {
+        throwSocketException(static_cast<int>(-result));
+    }
+    else if(result == 0)
+    {
+        Ice::ConnectionLostException ex(__FILE__, __LINE__);
+        ex.error = 0;
+        throw ex;
+    }
+    assert(result <= buf.b.end() - buf.i);
+    buf.i += result;
+    return true;
+}
+
+void
+StreamSocket::ringWritePrepare(Buffer& buf)
+{
+    //
+    // The socket buffer is full, the remaining data is sent by the selector
+    // with a write request. The data is copied to the ring buffer, the
+    // buffer of the caller might be released before the request completes
+    // if the connection is closed.
+    //
+    {
+        IceUtil::Mutex::Lock sync(_ringInfo->mutex);
+        if(_ringInfo->writeBuffer.empty())
+        {
+            _ringInfo->writeBuffer.resize(_ringInfo->readBuffer.size());
+        }
+        _ringInfo->writeSize = std::min(static_cast<size_t>(buf.b.end() - buf.i), _ringInfo->writeBuffer.size());
+        memcpy(&_ringInfo->writeBuffer[0], &*buf.i, _ringInfo->writeSize);
+    }
+    ready(SocketOperationWrite, false);
+}
+#endif
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
 AsyncInfo*
 StreamSocket::getAsyncInfo(SocketOperation op)
@@ -687,6 +997,19 @@ StreamSocket::init()
 
     _maxSendPacketSize = std::max(static_cast<unsigned int>(512), s->Control->OutboundBufferSizeInBytes / 2);
     _maxRecvPacketSize = _instance->properties()->getPropertyAsIntWithDefault("Ice.TCP.RcvSize", 128 * 1024);
+#else
+    //
+    // Used to bound the number of bytes submitted with a single gather
+    // write, there's no point in submitting more than the socket buffer
+    // can take.
+    //
+    _maxSendPacketSize = std::max(512, IceInternal::getSendBufferSize(_fd));
+
+    //
+    // All the reads and writes go through the stream socket, it can be read
+    // and written with io_uring requests once connected.
+    //
+    _ringIOSupported = true;
 #endif
 }
 
@@ -15,6 +15,10 @@
 #include <Ice/Buffer.h>
 #include <Ice/ProtocolInstanceF.h>
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+#   include <sys/uio.h>
+#endif
+
 namespace IceInternal
 {
 
@@ -41,6 +45,11 @@ public:
     ssize_t write(const char*, size_t);
 #endif
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+    size_t getGatherWriteSize() const;
+    SocketOperation writev(std::vector<Buffer*>&);
+#endif
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
     AsyncInfo* getAsyncInfo(SocketOperation);
 #endif
@@ -59,6 +68,13 @@ private:
 
     void init();
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+    SocketOperation ringRead(Buffer&);
+    SocketOperation ringWrite(Buffer&);
+    bool ringWriteCompleted(Buffer&);
+    void ringWritePrepare(Buffer&);
+#endif
+
     enum State
     {
         StateNeedConnect,
@@ -83,6 +99,9 @@ private:
     size_t _maxRecvPacketSize;
     AsyncInfo _read;
     AsyncInfo _write;
+#else
+    size_t _maxSendPacketSize;
+    std::vector<struct iovec> _iov;
 #endif
 
 #if defined(ICE_OS_UWP)
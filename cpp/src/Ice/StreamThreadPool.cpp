@@ -0,0 +1,145 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/StreamThreadPool.h>
+#include <Ice/Instance.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/Properties.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(StreamThreadPool* p) { return p; }
+
+namespace IceInternal
+{
+
+class StreamThread : public IceUtil::Thread
+{
+public:
+
+    StreamThread(const StreamThreadPoolPtr& threadPool, const string& name) :
+        IceUtil::Thread(name),
+        _threadPool(threadPool)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _threadPool->run();
+    }
+
+private:
+
+    const StreamThreadPoolPtr _threadPool;
+};
+
+}
+
+IceInternal::StreamThreadPool::StreamThreadPool(const InstancePtr& instance) :
+    _instance(instance),
+    _sizeMax(max(instance->initializationData().properties->getPropertyAsIntWithDefault(
+                     "Ice.StreamThreadPool.SizeMax", 32), 1)),
+    _destroyed(false),
+    _idle(0)
+{
+}
+
+bool
+IceInternal::StreamThreadPool::execute(const DispatchWorkItemPtr& workItem)
+{
+    Lock sync(*this);
+    if(_destroyed)
+    {
+        return false;
+    }
+
+    if(_idle <= static_cast<int>(_workItems.size()))
+    {
+        if(static_cast<int>(_threads.size()) >= _sizeMax)
+        {
+            return false;
+        }
+
+        try
+        {
+            ostringstream name;
+            name << "Ice.StreamThreadPool-" << _threads.size();
+            IceUtil::ThreadPtr thread = new StreamThread(this, name.str());
+            thread->start();
+            _threads.push_back(thread);
+            ++_idle;
+        }
+        catch(const IceUtil::Exception& ex)
+        {
+            Error out(_instance->initializationData().logger);
+            out << "cannot create thread for streamed sequence:\n" << ex;
+            return false;
+        }
+    }
+
+    _workItems.push_back(workItem);
+    notify();
+    return true;
+}
+
+void
+IceInternal::StreamThreadPool::destroy()
+{
+    //
+    // The connections are finished when this is called, the dispatches
+    // are done and the sources aren't pumped anymore, unless a source
+    // provided by the application blocks.
+    //
+    vector<IceUtil::ThreadPtr> threads;
+    {
+        Lock sync(*this);
+        _destroyed = true;
+        _threads.swap(threads);
+        notifyAll();
+    }
+
+    for(vector<IceUtil::ThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+
+    Lock sync(*this);
+    _workItems.clear();
+}
+
+void
+IceInternal::StreamThreadPool::run()
+{
+    while(true)
+    {
+        DispatchWorkItemPtr workItem;
+        {
+            Lock sync(*this);
+            while(!_destroyed && _workItems.empty())
+            {
+                wait();
+            }
+            if(_workItems.empty())
+            {
+                return;
+            }
+            workItem = _workItems.front();
+            _workItems.pop_front();
+            --_idle;
+        }
+
+        workItem->run();
+
+        Lock sync(*this);
+        ++_idle;
+    }
+}
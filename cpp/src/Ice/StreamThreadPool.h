@@ -0,0 +1,56 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef ICE_STREAM_THREAD_POOL_H
+#define ICE_STREAM_THREAD_POOL_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Thread.h>
+#include <Ice/StreamThreadPoolF.h>
+#include <Ice/InstanceF.h>
+#include <Ice/ThreadPool.h>
+
+#include <deque>
+
+namespace IceInternal
+{
+
+//
+// Runs the dispatch of the messages with a streamed sequence and pumps
+// the sources of the streamed sequences. This work might block, it
+// doesn't run on the Ice thread pools. The threads are created on demand
+// up to Ice.StreamThreadPool.SizeMax, once they're all busy new work is
+// rejected. The threads are joined when the communicator is destroyed.
+//
+class StreamThreadPool : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    StreamThreadPool(const InstancePtr&);
+
+    bool execute(const DispatchWorkItemPtr&);
+    void destroy();
+
+private:
+
+    void run();
+    friend class StreamThread;
+
+    const InstancePtr _instance;
+    const int _sizeMax;
+    bool _destroyed;
+    int _idle;
+    std::deque<DispatchWorkItemPtr> _workItems;
+    std::vector<IceUtil::ThreadPtr> _threads;
+};
+
+}
+
+#endif
@@ -350,6 +350,18 @@ IceInternal::TcpAcceptor::TcpAcceptor(const TcpEndpointIPtr& endpoint,
     //
     setReuseAddress(_fd, true);
 #endif
+
+    //
+    // With SO_REUSEPORT, several acceptors can listen on the same
+    // address and port, the kernel load-balances incoming connections
+    // over these acceptors.
+    //
+#ifndef ICE_OS_UWP
+    if(_endpoint->reusePort() > 0)
+    {
+        setReusePort(_fd, true);
+    }
+#endif
 }
 
 IceInternal::TcpAcceptor::~TcpAcceptor()
@@ -39,24 +39,27 @@ createIceTCP(const CommunicatorPtr& c, const string&, const StringSeq&)
 
 IceInternal::TcpEndpointI::TcpEndpointI(const ProtocolInstancePtr& instance, const string& host, Int port,
                                         const Address& sourceAddr, Int timeout, const string& connectionId,
-                                        bool compress) :
+                                        bool compress, Int reusePort) :
     IPEndpointI(instance, host, port, sourceAddr, connectionId),
     _timeout(timeout),
-    _compress(compress)
+    _compress(compress),
+    _reusePort(reusePort)
 {
 }
 
 IceInternal::TcpEndpointI::TcpEndpointI(const ProtocolInstancePtr& instance) :
     IPEndpointI(instance),
     _timeout(instance->defaultTimeout()),
-    _compress(false)
+    _compress(false),
+    _reusePort(0)
 {
 }
 
 IceInternal::TcpEndpointI::TcpEndpointI(const ProtocolInstancePtr& instance, InputStream* s) :
     IPEndpointI(instance, s),
     _timeout(-1),
-    _compress(false)
+    _compress(false),
+    _reusePort(0)
 {
     s->read(const_cast<Int&>(_timeout));
     s->read(const_cast<bool&>(_compress));
@@ -93,7 +96,8 @@ IceInternal::TcpEndpointI::timeout(Int timeout) const
     }
     else
     {
-        return ICE_MAKE_SHARED(TcpEndpointI, _instance, _host, _port, _sourceAddr, timeout, _connectionId, _compress);
+        return ICE_MAKE_SHARED(TcpEndpointI, _instance, _host, _port, _sourceAddr, timeout, _connectionId, _compress,
+                               _reusePort);
     }
 }
 
@@ -112,7 +116,8 @@ IceInternal::TcpEndpointI::compress(bool compress) const
     }
     else
     {
-        return ICE_MAKE_SHARED(TcpEndpointI, _instance, _host, _port, _sourceAddr, _timeout, _connectionId, compress);
+        return ICE_MAKE_SHARED(TcpEndpointI, _instance, _host, _port, _sourceAddr, _timeout, _connectionId, compress,
+                               _reusePort);
     }
 }
 
@@ -138,7 +143,26 @@ TcpEndpointIPtr
 IceInternal::TcpEndpointI::endpoint(const TcpAcceptorPtr& acceptor) const
 {
     return ICE_MAKE_SHARED(TcpEndpointI, _instance, _host, acceptor->effectivePort(), _sourceAddr, _timeout, _connectionId,
-                            _compress);
+                            _compress, _reusePort);
+}
+
+Int
+IceInternal::TcpEndpointI::reusePort() const
+{
+    return _reusePort;
+}
+
+void
+IceInternal::TcpEndpointI::initWithOptions(vector<string>& args, bool oaEndpoint)
+{
+    IPEndpointI::initWithOptions(args, oaEndpoint);
+
+    if(_reusePort > 0 && !oaEndpoint)
+    {
+        EndpointParseException ex(__FILE__, __LINE__);
+        ex.str = "`--reuseport' not valid for proxy endpoint `" + toString() + "'";
+        throw ex;
+    }
 }
 
 string
@@ -275,6 +299,31 @@ IceInternal::TcpEndpointI::checkOption(const string& option, const string& argum
         return true;
     }
 
+    if(option == "--reuseport")
+    {
+#if defined(SO_REUSEPORT) && !defined(ICE_OS_UWP)
+        if(argument.empty())
+        {
+            EndpointParseException ex(__FILE__, __LINE__);
+            ex.str = "no argument provided for --reuseport option in endpoint " + endpoint;
+            throw ex;
+        }
+
+        istringstream p(argument);
+        if(!(p >> const_cast<Int&>(_reusePort)) || !p.eof() || _reusePort < 1)
+        {
+            EndpointParseException ex(__FILE__, __LINE__);
+            ex.str = "invalid acceptor count value `" + argument + "' in endpoint " + endpoint;
+            throw ex;
+        }
+        return true;
+#else
+        EndpointParseException ex(__FILE__, __LINE__);
+        ex.str = "--reuseport option not supported on this platform in endpoint " + endpoint;
+        throw ex;
+#endif
+    }
+
     switch(option[1])
     {
     case 't':
@@ -331,7 +380,7 @@ IceInternal::TcpEndpointI::createConnector(const Address& address, const Network
 IPEndpointIPtr
 IceInternal::TcpEndpointI::createEndpoint(const string& host, int port, const string& connectionId) const
 {
-    return ICE_MAKE_SHARED(TcpEndpointI, _instance, host, port, _sourceAddr, _timeout, connectionId, _compress);
+    return ICE_MAKE_SHARED(TcpEndpointI, _instance, host, port, _sourceAddr, _timeout, connectionId, _compress, 0);
 }
 
 IceInternal::TcpEndpointFactory::TcpEndpointFactory(const ProtocolInstancePtr& instance) : _instance(instance)
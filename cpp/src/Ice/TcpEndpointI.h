@@ -23,7 +23,7 @@ class TcpEndpointI : public IPEndpointI
 public:
 
     TcpEndpointI(const ProtocolInstancePtr&, const std::string&, Ice::Int, const Address&, Ice::Int, const std::string&,
-                 bool);
+                 bool, Ice::Int);
     TcpEndpointI(const ProtocolInstancePtr&);
     TcpEndpointI(const ProtocolInstancePtr&, Ice::InputStream*);
 
@@ -39,6 +39,7 @@ public:
 
     virtual TransceiverPtr transceiver() const;
     virtual AcceptorPtr acceptor(const std::string&) const;
+    virtual Ice::Int reusePort() const;
     virtual std::string options() const;
 
 #ifdef ICE_CPP11_MAPPING
@@ -52,6 +53,8 @@ public:
 
     using IPEndpointI::connectionId;
 
+    virtual void initWithOptions(std::vector<std::string>&, bool);
+
 protected:
 
     virtual void hashInit(Ice::Int&) const;
@@ -68,6 +71,12 @@ private:
     //
     const Ice::Int _timeout;
     const bool _compress;
+
+    //
+    // The number of SO_REUSEPORT acceptors is only used to listen for
+    // connections, it's not marshaled nor part of the stringified endpoint.
+    //
+    const Ice::Int _reusePort;
 };
 
 class TcpEndpointFactory : public EndpointFactory
@@ -56,6 +56,20 @@ IceInternal::TcpTransceiver::read(Buffer& buf)
     return _stream->read(buf);
 }
 
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+size_t
+IceInternal::TcpTransceiver::getGatherWriteSize()
+{
+    return _stream->getGatherWriteSize();
+}
+
+SocketOperation
+IceInternal::TcpTransceiver::writev(vector<Buffer*>& bufs)
+{
+    return _stream->writev(bufs);
+}
+#endif
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
 bool
 IceInternal::TcpTransceiver::startWrite(Buffer& buf)
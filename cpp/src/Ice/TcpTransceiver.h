@@ -38,6 +38,9 @@ public:
     virtual void finishWrite(Buffer&);
     virtual void startRead(Buffer&);
     virtual void finishRead(Buffer&);
+#else
+    virtual size_t getGatherWriteSize();
+    virtual SocketOperation writev(std::vector<Buffer*>&);
 #endif
     virtual std::string protocol() const;
     virtual std::string toString() const;
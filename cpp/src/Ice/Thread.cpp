@@ -806,3 +806,16 @@ IceUtil::Thread::name() const
 }
 
 #endif
+
+size_t
+IceUtilInternal::getThreadIdHash()
+{
+    IceUtil::ThreadControl::ID id = IceUtil::ThreadControl().id();
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(&id);
+    size_t h = 0;
+    for(size_t i = 0; i < sizeof(id); ++i)
+    {
+        h = h * 31 + p[i];
+    }
+    return h ^ (h >> 7);
+}
@@ -17,6 +17,8 @@
 #include <Ice/ObjectAdapterFactory.h>
 #include <Ice/Properties.h>
 #include <Ice/TraceLevels.h>
+#include <IceUtil/StringUtil.h>
+#include <IceUtil/MutexPtrLock.h>
 
 #if defined(ICE_OS_UWP)
 #   include <Ice/StringConverter.h>
@@ -32,6 +34,78 @@ ICE_API IceUtil::Shared* IceInternal::upCast(ThreadPool* p) { return p; }
 namespace
 {
 
+//
+// The thread pool threads set this thread-specific key to their thread
+// pool, see ThreadPool::isThreadPoolThread(). The key is created by the
+// first thread pool, see createThreadPoolKey().
+//
+#ifdef _WIN32
+DWORD threadPoolKey;
+#else
+pthread_key_t threadPoolKey;
+#endif
+bool threadPoolKeyCreated = false;
+IceUtil::Mutex* threadPoolKeyMutex = 0;
+
+class Init
+{
+public:
+
+    Init()
+    {
+        threadPoolKeyMutex = new IceUtil::Mutex;
+    }
+
+    ~Init()
+    {
+        if(threadPoolKeyCreated)
+        {
+#ifdef _WIN32
+            TlsFree(threadPoolKey);
+#else
+            pthread_key_delete(threadPoolKey);
+#endif
+        }
+        delete threadPoolKeyMutex;
+        threadPoolKeyMutex = 0;
+    }
+};
+
+Init init;
+
+void
+createThreadPoolKey()
+{
+    IceUtilInternal::MutexPtrLock<IceUtil::Mutex> lock(threadPoolKeyMutex);
+    if(!threadPoolKeyCreated)
+    {
+#ifdef _WIN32
+        threadPoolKey = TlsAlloc();
+        if(threadPoolKey == TLS_OUT_OF_INDEXES)
+        {
+            throw IceUtil::ThreadSyscallException(__FILE__, __LINE__, GetLastError());
+        }
+#else
+        int err = pthread_key_create(&threadPoolKey, 0);
+        if(err != 0)
+        {
+            throw IceUtil::ThreadSyscallException(__FILE__, __LINE__, err);
+        }
+#endif
+        threadPoolKeyCreated = true;
+    }
+}
+
+void
+setThreadPool(ThreadPool* pool)
+{
+#ifdef _WIN32
+    TlsSetValue(threadPoolKey, pool);
+#else
+    pthread_setspecific(threadPoolKey, pool);
+#endif
+}
+
 class ShutdownWorkItem : public ThreadPoolWorkItem
 {
 public:
@@ -115,6 +189,50 @@ class ThreadPoolDestroyedException
 {
 };
 
+#if defined(__linux) && !defined(ICE_OS_UWP)
+//
+// Parses a list of CPU numbers or ranges of CPU numbers such as "0-3".
+//
+bool
+parseCpuList(const StringSeq& values, vector<int>& cpus)
+{
+    for(StringSeq::const_iterator p = values.begin(); p != values.end(); ++p)
+    {
+        string::size_type pos = p->find('-');
+        int first;
+        int last;
+        istringstream first_is(p->substr(0, pos));
+        if(!(first_is >> first) || !first_is.eof())
+        {
+            return false;
+        }
+        if(pos != string::npos)
+        {
+            istringstream last_is(p->substr(pos + 1));
+            if(!(last_is >> last) || !last_is.eof())
+            {
+                return false;
+            }
+        }
+        else
+        {
+            last = first;
+        }
+
+        if(first < 0 || last < first || last >= CPU_SETSIZE)
+        {
+            return false;
+        }
+
+        for(int i = first; i <= last; ++i)
+        {
+            cpus.push_back(i);
+        }
+    }
+    return true;
+}
+#endif
+
 }
 
 Ice::DispatcherCall::~DispatcherCall()
@@ -265,13 +383,22 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
     _serverIdleTime(timeout),
     _threadIdleTime(0),
     _stackSize(0),
+    _spinMicros(0),
+    _busyPoll(false),
+    _parent(0),
+    _shard(0),
+    _shardCount(1),
+    _idle(false),
     _inUse(0),
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
     _inUseIO(0),
+    _spinning(0),
     _nextHandler(_handlers.end()),
 #endif
     _promote(true)
 {
+    createThreadPoolKey();
+
     PropertiesPtr properties = _instance->initializationData().properties;
 #ifndef ICE_OS_UWP
 #   ifdef _WIN32
@@ -346,6 +473,103 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
     _selector.setup(_sizeIO);
 #endif
 
+    int shards = properties->getPropertyAsIntWithDefault(_prefix + ".Shards", 1);
+    if(shards < 1)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".Shards < 1; Shards adjusted to 1";
+        shards = 1;
+    }
+    _shardCount = shards;
+
+    //
+    // With a sharded thread pool, the threads of each shard are bound to
+    // a single CPU from the list, otherwise the threads are bound to all
+    // the CPUs from the list.
+    //
+    vector<int> cpus;
+    string affinity = properties->getProperty(_prefix + ".CpuAffinity");
+    if(!affinity.empty())
+    {
+#if defined(__linux) && !defined(ICE_OS_UWP)
+        if(!parseCpuList(properties->getPropertyAsList(_prefix + ".CpuAffinity"), cpus))
+        {
+            Warning out(_instance->initializationData().logger);
+            out << _prefix << ".CpuAffinity: invalid CPU list `" << affinity << "'; CPU affinity not set";
+            cpus.clear();
+            affinity = "";
+        }
+#else
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".CpuAffinity: not supported on this platform";
+        affinity = "";
+#endif
+    }
+    if(_shardCount > 1 && !cpus.empty())
+    {
+        _cpus.push_back(cpus.front());
+    }
+    else
+    {
+        _cpus = cpus;
+    }
+
+    string backend = properties->getProperty(_prefix + ".Backend");
+    if(backend == "io_uring")
+    {
+#if defined(ICE_USE_IO_URING)
+        if(!_selector.setupIoUring())
+        {
+            Warning out(_instance->initializationData().logger);
+            out << "unable to initialize io_uring for `" << _prefix << "'; using the default backend";
+            backend = "";
+        }
+#else
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".Backend: io_uring is not supported by this build; using the default backend";
+        backend = "";
+#endif
+    }
+    else if(!backend.empty() && backend != "default")
+    {
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".Backend: unknown backend `" << backend << "'; using the default backend";
+        backend = "";
+    }
+    _backend = backend;
+
+    //
+    // With SpinMicros, idle threads spin for the given time before blocking,
+    // this reduces latency at the expense of CPU usage.
+    //
+    int spinMicros = properties->getPropertyAsInt(_prefix + ".SpinMicros");
+    if(spinMicros < 0)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".SpinMicros < 0; SpinMicros adjusted to 0";
+        spinMicros = 0;
+    }
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
+    if(spinMicros > 0)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".SpinMicros: not supported on this platform";
+        spinMicros = 0;
+    }
+#endif
+    const_cast<int&>(_spinMicros) = spinMicros;
+#if defined(ICE_USE_EPOLL)
+    _selector.setSpinMicros(spinMicros);
+#endif
+
+    _busyPoll = properties->getPropertyAsInt(_prefix + ".BusyPoll") > 0;
+    if(_busyPoll && _spinMicros == 0)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".BusyPoll: requires " << _prefix << ".SpinMicros to be set";
+        _busyPoll = false;
+    }
+
 #if defined(__APPLE__)
     //
     // We use a default stack size of 1MB on macOS and the new C++11 mapping to allow transmitting
@@ -380,23 +604,40 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
         Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
         out << "creating " << _prefix << ": Size = " << _size << ", SizeMax = " << _sizeMax << ", SizeWarn = "
             << _sizeWarn;
+        if(_shardCount > 1)
+        {
+            out << ", Shards = " << _shardCount;
+        }
+        if(!affinity.empty())
+        {
+            out << ", CpuAffinity = " << affinity;
+        }
+        if(!backend.empty())
+        {
+            out << ", Backend = " << backend;
+        }
+        if(_spinMicros > 0)
+        {
+            out << ", SpinMicros = " << _spinMicros;
+        }
     }
 
     __setNoDelete(true);
     try
     {
-        for(int i = 0 ; i < _size ; ++i)
+        createThreads();
+
+        for(int i = 1; i < _shardCount; ++i)
         {
-            EventHandlerThreadPtr thread = new EventHandlerThread(this, nextThreadId());
-            if(_hasPriority)
+            vector<int> shardCpus;
+            if(!cpus.empty())
             {
-                thread->start(_stackSize, _priority);
+                shardCpus.push_back(cpus[i % cpus.size()]);
             }
-            else
-            {
-                thread->start(_stackSize);
-            }
-            _threads.insert(thread);
+            ThreadPoolPtr shard = new ThreadPool(this, i, shardCpus);
+
+            Lock sync(*this);
+            _shards.push_back(shard);
         }
     }
     catch(const IceUtil::Exception& ex)
@@ -419,39 +660,166 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
     __setNoDelete(false);
 }
 
+IceInternal::ThreadPool::ThreadPool(ThreadPool* parent, int shard, const vector<int>& cpus) :
+    _instance(parent->_instance),
+    _dispatcher(parent->_dispatcher),
+    _destroyed(false),
+    _prefix(parent->_prefix),
+    _selector(parent->_instance),
+    _nextThreadId(0),
+    _size(parent->_size),
+    _sizeIO(parent->_sizeIO),
+    _sizeMax(parent->_sizeMax),
+    _sizeWarn(parent->_sizeWarn),
+    _serialize(parent->_serialize),
+    _hasPriority(parent->_hasPriority),
+    _priority(parent->_priority),
+    _serverIdleTime(parent->_serverIdleTime),
+    _threadIdleTime(parent->_threadIdleTime),
+    _stackSize(parent->_stackSize),
+    _spinMicros(parent->_spinMicros),
+    _busyPoll(parent->_busyPoll),
+    _backend(parent->_backend),
+    _parent(parent),
+    _shard(shard),
+    _shardCount(parent->_shardCount),
+    _cpus(cpus),
+    _idle(false),
+    _inUse(0),
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+    _inUseIO(0),
+    _spinning(0),
+    _nextHandler(_handlers.end()),
+#endif
+    _promote(true)
+{
+#ifdef ICE_USE_IOCP
+    _selector.setup(_sizeIO);
+#endif
+
+#if defined(ICE_USE_IO_URING)
+    if(_backend == "io_uring" && !_selector.setupIoUring())
+    {
+        Warning out(_instance->initializationData().logger);
+        out << "unable to initialize io_uring for shard " << _shard << " of `" << _prefix
+            << "'; using the default backend";
+    }
+#endif
+
+#if defined(ICE_USE_EPOLL)
+    _selector.setSpinMicros(_spinMicros);
+#endif
+
+    _workQueue = ICE_MAKE_SHARED(ThreadPoolWorkQueue, *this);
+    _selector.initialize(_workQueue.get());
+
+    __setNoDelete(true);
+    try
+    {
+        createThreads();
+    }
+    catch(...)
+    {
+        destroy();
+        joinWithAllThreads();
+        __setNoDelete(false);
+        throw;
+    }
+    __setNoDelete(false);
+}
+
 IceInternal::ThreadPool::~ThreadPool()
 {
     assert(_destroyed);
 }
 
+bool
+IceInternal::ThreadPool::isThreadPoolThread()
+{
+    //
+    // The thread pool key is created before any connection can call this.
+    //
+#ifdef _WIN32
+    return TlsGetValue(threadPoolKey) != 0;
+#else
+    return pthread_getspecific(threadPoolKey) != 0;
+#endif
+}
+
 void
 IceInternal::ThreadPool::destroy()
 {
-    Lock sync(*this);
-    if(_destroyed)
     {
-        return;
+        Lock sync(*this);
+        if(_destroyed)
+        {
+            return;
+        }
+        _destroyed = true;
+        _workQueue->destroy();
+    }
+
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        (*p)->destroy();
     }
-    _destroyed = true;
-    _workQueue->destroy();
 }
 
 void
 IceInternal::ThreadPool::updateObservers()
 {
-    Lock sync(*this);
-    for(set<EventHandlerThreadPtr>::iterator p = _threads.begin(); p != _threads.end(); ++p)
     {
-        (*p)->updateObserver();
+        Lock sync(*this);
+        for(set<EventHandlerThreadPtr>::iterator p = _threads.begin(); p != _threads.end(); ++p)
+        {
+            (*p)->updateObserver();
+        }
+    }
+
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        (*p)->updateObservers();
     }
 }
 
+ThreadPoolPtr
+IceInternal::ThreadPool::getShard()
+{
+    //
+    // Pick the shard which currently manages the fewest event handlers.
+    //
+    ThreadPoolPtr shard = this;
+    int load = _load.load();
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        int shardLoad = (*p)->_load.load();
+        if(shardLoad < load)
+        {
+            shard = *p;
+            load = shardLoad;
+        }
+    }
+    return shard;
+}
+
 void
 IceInternal::ThreadPool::initialize(const EventHandlerPtr& handler)
 {
     Lock sync(*this);
     assert(!_destroyed);
     _selector.initialize(handler.get());
+    ++_load;
+
+    if(_busyPoll)
+    {
+        NativeInfoPtr info = handler->getNativeInfo();
+        if(info && info->fd() != INVALID_SOCKET && !setBusyPoll(info->fd(), _spinMicros))
+        {
+            Warning out(_instance->initializationData().logger);
+            out << "unable to enable busy polling for `" << _prefix << "':\n" << IceUtilInternal::lastErrorToString();
+            _busyPoll = false; // Only warn once.
+        }
+    }
 
     class ReadyCallbackI : public ReadyCallback
     {
@@ -468,6 +836,12 @@ IceInternal::ThreadPool::initialize(const EventHandlerPtr& handler)
             _threadPool->ready(_handler, op, value);
         }
 
+        virtual void
+        suspend(SocketOperation op, bool value)
+        {
+            _threadPool->suspend(_handler, op, value);
+        }
+
     private:
 
         const ThreadPoolPtr _threadPool;
@@ -501,6 +875,7 @@ IceInternal::ThreadPool::finish(const EventHandlerPtr& handler, bool closeNow)
 {
     Lock sync(*this);
     assert(!_destroyed);
+    --_load;
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
     closeNow = _selector.finish(handler.get(), closeNow); // This must be called before!
     _workQueue->queue(new FinishedWorkItem(handler, !closeNow));
@@ -531,6 +906,35 @@ IceInternal::ThreadPool::ready(const EventHandlerPtr& handler, SocketOperation o
     _selector.ready(handler.get(), op, value);
 }
 
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
+void
+IceInternal::ThreadPool::suspend(const EventHandlerPtr&, SocketOperation, bool)
+{
+    //
+    // Operations are only started by the transceivers with IOCP and UWP,
+    // there's no polling to suspend.
+    //
+}
+#else
+void
+IceInternal::ThreadPool::suspend(const EventHandlerPtr& handler, SocketOperation op, bool value)
+{
+    Lock sync(*this);
+    if(_destroyed)
+    {
+        return;
+    }
+    if(value)
+    {
+        _selector.disable(handler.get(), op);
+    }
+    else
+    {
+        _selector.enable(handler.get(), op);
+    }
+}
+#endif
+
 void
 IceInternal::ThreadPool::dispatchFromThisThread(const DispatchWorkItemPtr& workItem)
 {
@@ -598,6 +1002,11 @@ IceInternal::ThreadPool::joinWithAllThreads()
         (*p)->getThreadControl().join();
     }
     _selector.destroy();
+
+    for(vector<ThreadPoolPtr>::const_iterator p = _shards.begin(); p != _shards.end(); ++p)
+    {
+        (*p)->joinWithAllThreads();
+    }
 }
 
 string
@@ -644,10 +1053,26 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
             }
             catch(const SelectorTimeoutException&)
             {
-                Lock sync(*this);
-                if(!_destroyed && _inUse == 0)
                 {
-                    _workQueue->queue(new ShutdownWorkItem(_instance)); // Select timed-out.
+                    Lock sync(*this);
+                    if(_destroyed || _inUse > 0)
+                    {
+                        continue;
+                    }
+                    _idle = true;
+                }
+
+                //
+                // With a sharded thread pool, the server is only idle once
+                // all the shards are idle.
+                //
+                if(isIdle())
+                {
+                    Lock sync(*this);
+                    if(!_destroyed)
+                    {
+                        _workQueue->queue(new ShutdownWorkItem(_instance)); // Select timed-out.
+                    }
                 }
                 continue;
             }
@@ -659,6 +1084,7 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
             {
                 if(select)
                 {
+                    _idle = false;
                     _selector.finishSelect(_handlers);
                     _nextHandler = _handlers.begin();
                     select = false;
@@ -820,10 +1246,22 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
             }
             catch(const SelectorTimeoutException&)
             {
-                Lock sync(*this);
-                if(!_destroyed)
                 {
-                    _workQueue->queue(new ShutdownWorkItem(_instance));
+                    Lock sync(*this);
+                    if(_destroyed)
+                    {
+                        continue;
+                    }
+                    _idle = true;
+                }
+
+                if(isIdle())
+                {
+                    Lock sync(*this);
+                    if(!_destroyed)
+                    {
+                        _workQueue->queue(new ShutdownWorkItem(_instance));
+                    }
                 }
                 continue;
             }
@@ -831,6 +1269,7 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
 
         {
             IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+            _idle = false;
             thread->setState(ICE_ENUM(ThreadState, ThreadStateInUseForIO));
         }
 
@@ -912,7 +1351,7 @@ IceInternal::ThreadPool::ioCompleted(ThreadPoolCurrent& current)
         }
         else if(_promote && (_nextHandler != _handlers.end() || _inUseIO == 0))
         {
-            notify();
+            notifyFollower();
         }
 #endif
 
@@ -1077,11 +1516,27 @@ IceInternal::ThreadPool::promoteFollower(ThreadPoolCurrent& current)
     _promote = true;
     if(_inUseIO < _sizeIO && (_nextHandler != _handlers.end() || _inUseIO == 0))
     {
-        notify();
+        notifyFollower();
     }
     current._leader = false;
 }
 
+void
+IceInternal::ThreadPool::notifyFollower()
+{
+    //
+    // Must be called with the thread pool mutex locked. The spinning
+    // followers see the notification without being woken up, they update
+    // _spinning with the mutex locked and check whether they're promoted
+    // before waiting on the monitor.
+    //
+    ++_wakeups;
+    if(_spinning == 0)
+    {
+        notify();
+    }
+}
+
 bool
 IceInternal::ThreadPool::followerWait(ThreadPoolCurrent& current)
 {
@@ -1098,6 +1553,35 @@ IceInternal::ThreadPool::followerWait(ThreadPoolCurrent& current)
     current.stream.clear();
     current.stream.b.clear();
 
+    //
+    // With SpinMicros, spin until the follower is promoted or the spin time
+    // elapsed before waiting on the monitor. The mutex is released while
+    // spinning and reacquired with a spinning lock. The leader doesn't
+    // notify the monitor while followers spin, the hand-off doesn't require
+    // a system call to wake up the follower.
+    //
+    if(_spinMicros > 0)
+    {
+        IceUtil::Time deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) +
+            IceUtil::Time::microSeconds(_spinMicros);
+        ++_spinning;
+        while((!_promote || _inUseIO == _sizeIO || (_nextHandler == _handlers.end() && _inUseIO > 0)) &&
+              IceUtil::Time::now(IceUtil::Time::Monotonic) < deadline)
+        {
+            int wakeups = _wakeups.load();
+            unlock();
+            while(_wakeups.load() == wakeups && IceUtil::Time::now(IceUtil::Time::Monotonic) < deadline)
+            {
+                IceUtil::ThreadControl::yield();
+            }
+            while(!tryLock())
+            {
+                IceUtil::ThreadControl::yield();
+            }
+        }
+        --_spinning;
+    }
+
     //
     // Wait to be promoted and for all the IO threads to be done.
     //
@@ -1133,11 +1617,86 @@ IceInternal::ThreadPool::followerWait(ThreadPoolCurrent& current)
 }
 #endif
 
+void
+IceInternal::ThreadPool::createThreads()
+{
+    for(int i = 0 ; i < _size ; ++i)
+    {
+        EventHandlerThreadPtr thread = new EventHandlerThread(this, nextThreadId());
+        if(_hasPriority)
+        {
+            thread->start(_stackSize, _priority);
+        }
+        else
+        {
+            thread->start(_stackSize);
+        }
+        _threads.insert(thread);
+    }
+}
+
+void
+IceInternal::ThreadPool::setAffinity(const string& name)
+{
+#if defined(__linux) && !defined(ICE_OS_UWP)
+    if(_cpus.empty())
+    {
+        return;
+    }
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for(vector<int>::const_iterator p = _cpus.begin(); p != _cpus.end(); ++p)
+    {
+        CPU_SET(*p, &cpuset);
+    }
+
+    int rs = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if(rs != 0)
+    {
+        Warning out(_instance->initializationData().logger);
+        out << "unable to set the CPU affinity of thread `" << name << "':\n" << IceUtilInternal::errorToString(rs);
+    }
+#else
+    (void)name;
+#endif
+}
+
+bool
+IceInternal::ThreadPool::isIdle()
+{
+    ThreadPool* root = _parent ? _parent : this;
+    vector<ThreadPoolPtr> shards;
+    {
+        Lock sync(*root);
+        if(!root->_idle || root->_inUse > 0)
+        {
+            return false;
+        }
+        shards = root->_shards;
+    }
+
+    for(vector<ThreadPoolPtr>::const_iterator p = shards.begin(); p != shards.end(); ++p)
+    {
+        Lock sync(**p);
+        if(!(*p)->_idle || (*p)->_inUse > 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 string
 IceInternal::ThreadPool::nextThreadId()
 {
     ostringstream os;
-    os << _prefix << "-" << _nextThreadId++;
+    os << _prefix << "-";
+    if(_shardCount > 1)
+    {
+        os << _shard << "-";
+    }
+    os << _nextThreadId++;
     return os.str();
 }
 
@@ -1177,6 +1736,9 @@ IceInternal::ThreadPool::EventHandlerThread::setState(Ice::Instrumentation::Thre
 void
 IceInternal::ThreadPool::EventHandlerThread::run()
 {
+    _pool->setAffinity(name());
+    setThreadPool(_pool.get());
+
 #ifdef ICE_CPP11_MAPPING
     if(_pool->_instance->initializationData().threadStart)
 #else
@@ -1246,6 +1808,7 @@ IceInternal::ThreadPool::EventHandlerThread::run()
         }
     }
 
+    setThreadPool(0);
     _pool = 0; // Break cyclic dependency.
 }
 
@@ -14,6 +14,7 @@
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
 #include <IceUtil/Thread.h>
+#include <IceUtil/Atomic.h>
 
 #include <Ice/Config.h>
 #include <Ice/Dispatcher.h>
@@ -91,10 +92,21 @@ public:
     ThreadPool(const InstancePtr&, const std::string&, int);
     virtual ~ThreadPool();
 
+    //
+    // Returns true if the calling thread is a thread pool thread.
+    //
+    static bool isThreadPoolThread();
+
     void destroy();
 
     void updateObservers();
 
+    //
+    // Returns the thread pool shard which should manage a new
+    // connection, this thread pool if it isn't sharded.
+    //
+    ThreadPoolPtr getShard();
+
     void initialize(const EventHandlerPtr&);
     void _register(const EventHandlerPtr& handler, SocketOperation status)
     {
@@ -107,6 +119,7 @@ public:
     }
     bool finish(const EventHandlerPtr&, bool);
     void ready(const EventHandlerPtr&, SocketOperation, bool);
+    void suspend(const EventHandlerPtr&, SocketOperation, bool);
 
     void dispatchFromThisThread(const DispatchWorkItemPtr&);
     void dispatch(const DispatchWorkItemPtr&);
@@ -117,6 +130,12 @@ public:
 
 private:
 
+    ThreadPool(ThreadPool*, int, const std::vector<int>&);
+
+    void createThreads();
+    void setAffinity(const std::string&);
+    bool isIdle();
+
     void run(const EventHandlerThreadPtr&);
 
     bool ioCompleted(ThreadPoolCurrent&);
@@ -127,6 +146,7 @@ private:
 #else
     void promoteFollower(ThreadPoolCurrent&);
     bool followerWait(ThreadPoolCurrent&);
+    void notifyFollower();
 #endif
 
     std::string nextThreadId();
@@ -157,11 +177,24 @@ private:
     const int _serverIdleTime;
     const int _threadIdleTime;
     const size_t _stackSize;
+    const int _spinMicros;
+    bool _busyPoll;
+    std::string _backend;
+
+    ThreadPool* const _parent; // The first shard if this is another shard of a sharded thread pool.
+    const int _shard;
+    int _shardCount;
+    std::vector<ThreadPoolPtr> _shards; // The other shards if this is the first shard.
+    std::vector<int> _cpus; // The CPUs the threads of this thread pool or shard are bound to.
+    IceUtilInternal::Atomic _load; // Number of event handlers managed by this thread pool.
+    IceUtilInternal::Atomic _wakeups; // Number of follower notifications, used by spinning followers.
+    bool _idle;
 
     std::set<EventHandlerThreadPtr> _threads; // All threads, running or not.
     int _inUse; // Number of threads that are currently in use.
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
     int _inUseIO; // Number of threads that are currently performing IO.
+    int _spinning; // Number of followers spinning in followerWait(), they don't need to be notified.
     std::vector<std::pair<EventHandler*, SocketOperation> > _handlers;
     std::vector<std::pair<EventHandler*, SocketOperation> >::const_iterator _nextHandler;
 #endif
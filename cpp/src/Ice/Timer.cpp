@@ -38,6 +38,12 @@ Timer::Timer(int priority) :
     __setNoDelete(false);
 }
 
+Timer::Timer(NoThread) :
+    Thread("IceUtil timer thread"),
+    _destroyed(false)
+{
+}
+
 void
 Timer::destroy()
 {
@@ -0,0 +1,711 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <IceUtil/TimerWheel.h>
+#include <IceUtil/Exception.h>
+#include <Ice/ConsoleUtil.h>
+
+using namespace std;
+using namespace IceUtil;
+using namespace IceInternal;
+
+namespace
+{
+
+//
+// The level 0 of the wheel has one slot per tick, each slot of the
+// upper levels covers all the slots of the level below.
+//
+const int level0Bits = 8;
+const size_t level0Size = 1 << level0Bits;
+const int levelBits = 6;
+const size_t levelSize = 1 << levelBits;
+const int levels = 4; // Upper levels
+const Int64 maxTicks = (static_cast<Int64>(1) << (level0Bits + levels * levelBits)) - 1;
+
+const size_t initialBuckets = 64;
+
+template<typename L> inline void
+initList(L& list)
+{
+    list.prev = &list;
+    list.next = &list;
+}
+
+template<typename L> inline bool
+isEmpty(const L& list)
+{
+    return list.next == &list;
+}
+
+template<typename L> inline void
+pushBack(L& list, L* link)
+{
+    link->prev = list.prev;
+    link->next = &list;
+    list.prev->next = link;
+    list.prev = link;
+}
+
+template<typename L> inline void
+unlink(L* link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = 0;
+    link->next = 0;
+}
+
+inline size_t
+hashTask(const TimerTask* task)
+{
+    size_t h = reinterpret_cast<size_t>(task);
+    return h ^ (h >> 7) ^ (h >> 17);
+}
+
+}
+
+struct TimerWheel::Entry : public TimerWheel::Link
+{
+    enum State
+    {
+        Scheduled,
+        Ready,
+        Running
+    };
+
+    TimerTaskPtr task;
+    IceUtil::Time delay; // The delay of a repeated task, 0 otherwise.
+    Int64 expires;
+    State state;
+    bool canceled;
+    Entry* hashNext;
+};
+
+class TimerWheel::WheelThread : public IceUtil::Thread
+{
+public:
+
+    WheelThread(const TimerWheelPtr& timer) :
+        Thread("IceUtil timer wheel thread"),
+        _timer(timer)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _timer->runThread();
+        _timer = 0;
+    }
+
+private:
+
+    TimerWheelPtr _timer;
+};
+
+TimerWheel::TimerWheel(const IceUtil::Time& tick, int threadCount) :
+    Timer(NoThread()),
+    _start(IceUtil::Time::now(IceUtil::Time::Monotonic)),
+    _tick(max(tick.toMicroSeconds(), static_cast<Int64>(1))),
+    _slots(level0Size + levels * levelSize),
+    _scheduled(0),
+    _currentTick(0),
+    _wakeUpTick(-1),
+    _ticking(false),
+    _idle(0),
+    _entries(0),
+    _free(0)
+{
+    start(threadCount, false, 0);
+}
+
+TimerWheel::TimerWheel(const IceUtil::Time& tick, int threadCount, int priority) :
+    Timer(NoThread()),
+    _start(IceUtil::Time::now(IceUtil::Time::Monotonic)),
+    _tick(max(tick.toMicroSeconds(), static_cast<Int64>(1))),
+    _slots(level0Size + levels * levelSize),
+    _scheduled(0),
+    _currentTick(0),
+    _wakeUpTick(-1),
+    _ticking(false),
+    _idle(0),
+    _entries(0),
+    _free(0)
+{
+    start(threadCount, true, priority);
+}
+
+TimerWheel::~TimerWheel()
+{
+    for(vector<Entry*>::const_iterator p = _buckets.begin(); p != _buckets.end(); ++p)
+    {
+        Entry* entry = *p;
+        while(entry)
+        {
+            Entry* next = entry->hashNext;
+            delete entry;
+            entry = next;
+        }
+    }
+    while(_free)
+    {
+        Entry* next = _free->hashNext;
+        delete _free;
+        _free = next;
+    }
+}
+
+void
+TimerWheel::destroy()
+{
+    vector<ThreadPtr> threads;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_destroyed)
+        {
+            return;
+        }
+        _destroyed = true;
+
+        //
+        // Entries being run are released by their thread.
+        //
+        for(vector<Entry*>::const_iterator p = _buckets.begin(); p != _buckets.end(); ++p)
+        {
+            Entry* entry = *p;
+            while(entry)
+            {
+                Entry* next = entry->hashNext;
+                if(entry->state == Entry::Running)
+                {
+                    entry->canceled = true;
+                }
+                else
+                {
+                    delete entry;
+                }
+                entry = next;
+            }
+        }
+        _buckets.clear();
+        _entries = 0;
+        while(_free)
+        {
+            Entry* next = _free->hashNext;
+            delete _free;
+            _free = next;
+        }
+        for(vector<Link>::iterator p = _slots.begin(); p != _slots.end(); ++p)
+        {
+            initList(*p);
+        }
+        initList(_ready);
+        _scheduled = 0;
+
+        _tickCond.broadcast();
+        _readyCond.broadcast();
+        threads.swap(_threads);
+    }
+
+    for(vector<ThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        if((*p)->getThreadControl() == ThreadControl())
+        {
+            (*p)->getThreadControl().detach();
+        }
+        else
+        {
+            (*p)->getThreadControl().join();
+        }
+    }
+}
+
+void
+TimerWheel::schedule(const TimerTaskPtr& task, const IceUtil::Time& delay)
+{
+    add(task, delay, false);
+}
+
+void
+TimerWheel::scheduleRepeated(const TimerTaskPtr& task, const IceUtil::Time& delay)
+{
+    add(task, delay, true);
+}
+
+bool
+TimerWheel::cancel(const TimerTaskPtr& task)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    if(_destroyed)
+    {
+        return false;
+    }
+
+    Entry* entry = find(task.get());
+    if(!entry)
+    {
+        return false;
+    }
+    erase(task.get());
+
+    if(entry->state == Entry::Running)
+    {
+        //
+        // A repeated task being run, it's released by its thread.
+        //
+        entry->canceled = true;
+    }
+    else
+    {
+        if(entry->state == Entry::Scheduled)
+        {
+            --_scheduled;
+        }
+        unlink(static_cast<Link*>(entry));
+        freeEntry(entry);
+    }
+    return true;
+}
+
+void
+TimerWheel::start(int threadCount, bool hasPriority, int priority)
+{
+    for(vector<Link>::iterator p = _slots.begin(); p != _slots.end(); ++p)
+    {
+        initList(*p);
+    }
+    initList(_ready);
+
+    __setNoDelete(true);
+    try
+    {
+        for(int i = 0; i < max(threadCount, 1); ++i)
+        {
+            ThreadPtr thread = new WheelThread(this);
+            if(hasPriority)
+            {
+                thread->start(0, priority);
+            }
+            else
+            {
+                thread->start();
+            }
+            _threads.push_back(thread);
+        }
+    }
+    catch(...)
+    {
+        destroy();
+        __setNoDelete(false);
+        throw;
+    }
+    __setNoDelete(false);
+}
+
+void
+TimerWheel::add(const TimerTaskPtr& task, const IceUtil::Time& delay, bool repeated)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    if(_destroyed)
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "timer destroyed");
+    }
+
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    if(delay > IceUtil::Time() && now + delay < now)
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "invalid delay");
+    }
+
+    if(find(task.get()))
+    {
+        throw IllegalArgumentException(__FILE__, __LINE__, "task is already schedulded");
+    }
+
+    if(_entries >= _buckets.size())
+    {
+        rehash();
+    }
+    Entry* entry = newEntry();
+    entry->task = task;
+    entry->delay = repeated ? delay : IceUtil::Time();
+    Entry*& bucket = _buckets[hashTask(task.get()) & (_buckets.size() - 1)];
+    entry->hashNext = bucket;
+    bucket = entry;
+    ++_entries;
+
+    insert(entry, now, delay);
+}
+
+void
+TimerWheel::insert(Entry* entry, const IceUtil::Time& now, const IceUtil::Time& delay)
+{
+    if(delay > IceUtil::Time())
+    {
+        const Int64 nowTick = (now - _start).toMicroSeconds() / _tick;
+        if(_scheduled == 0 && _currentTick < nowTick)
+        {
+            //
+            // The ticks elapsed while the wheel was empty don't need to
+            // be processed.
+            //
+            _currentTick = nowTick;
+        }
+
+        //
+        // Round up to the next tick, a task never runs before its time.
+        //
+        entry->expires = ((now + delay - _start).toMicroSeconds() + _tick - 1) / _tick;
+        if(entry->expires >= _currentTick)
+        {
+            place(entry);
+            if(_ticking && (_wakeUpTick < 0 || entry->expires < _wakeUpTick))
+            {
+                _tickCond.signal();
+            }
+            return;
+        }
+    }
+
+    entry->state = Entry::Ready;
+    pushBack(_ready, static_cast<Link*>(entry));
+    if(_idle > 0)
+    {
+        _readyCond.signal();
+    }
+    else if(_ticking)
+    {
+        _tickCond.signal();
+    }
+}
+
+void
+TimerWheel::place(Entry* entry)
+{
+    assert(entry->expires >= _currentTick);
+    const Int64 ticks = min(entry->expires - _currentTick, maxTicks);
+    const Int64 expires = _currentTick + ticks;
+
+    Link* slot;
+    if(ticks < static_cast<Int64>(level0Size))
+    {
+        slot = &_slots[static_cast<size_t>(expires) & (level0Size - 1)];
+    }
+    else
+    {
+        int level = 1;
+        while(ticks >= (static_cast<Int64>(1) << (level0Bits + level * levelBits)))
+        {
+            ++level;
+        }
+        size_t index = static_cast<size_t>(expires >> (level0Bits + (level - 1) * levelBits)) & (levelSize - 1);
+        slot = &_slots[level0Size + (level - 1) * levelSize + index];
+    }
+
+    entry->state = Entry::Scheduled;
+    pushBack(*slot, static_cast<Link*>(entry));
+    ++_scheduled;
+}
+
+void
+TimerWheel::advance(Int64 nowTick)
+{
+    if(_scheduled == 0)
+    {
+        _currentTick = max(_currentTick, nowTick + 1);
+        return;
+    }
+
+    while(_currentTick <= nowTick)
+    {
+        const size_t index = static_cast<size_t>(_currentTick) & (level0Size - 1);
+        if(index == 0)
+        {
+            //
+            // Move the tasks of the upper levels which expire during the
+            // next rotation of the level below.
+            //
+            for(int level = 1; level <= levels; ++level)
+            {
+                size_t i = static_cast<size_t>(_currentTick >> (level0Bits + (level - 1) * levelBits)) &
+                    (levelSize - 1);
+                cascade(level, i);
+                if(i != 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        //
+        // All the tasks of the tick are made ready at once.
+        //
+        Link& slot = _slots[index];
+        while(!isEmpty(slot))
+        {
+            Entry* entry = static_cast<Entry*>(slot.next);
+            unlink(static_cast<Link*>(entry));
+            --_scheduled;
+            if(entry->expires > _currentTick)
+            {
+                place(entry); // The delay exceeded the wheel range.
+            }
+            else
+            {
+                entry->state = Entry::Ready;
+                pushBack(_ready, static_cast<Link*>(entry));
+            }
+        }
+        ++_currentTick;
+    }
+}
+
+void
+TimerWheel::cascade(int level, size_t index)
+{
+    Link& slot = _slots[level0Size + (level - 1) * levelSize + index];
+    if(isEmpty(slot))
+    {
+        return;
+    }
+
+    Link entries;
+    initList(entries);
+    while(!isEmpty(slot))
+    {
+        Link* link = slot.next;
+        unlink(link);
+        pushBack(entries, link);
+        --_scheduled;
+    }
+    while(!isEmpty(entries))
+    {
+        Entry* entry = static_cast<Entry*>(entries.next);
+        unlink(static_cast<Link*>(entry));
+        place(entry);
+    }
+}
+
+Int64
+TimerWheel::nextTick() const
+{
+    if(_scheduled == 0)
+    {
+        return -1;
+    }
+
+    //
+    // Wake up for the next non-empty slot of the level 0, or for the
+    // next cascade.
+    //
+    const size_t index = static_cast<size_t>(_currentTick) & (level0Size - 1);
+    for(size_t i = index; i < level0Size; ++i)
+    {
+        if(!isEmpty(_slots[i]))
+        {
+            return _currentTick + static_cast<Int64>(i - index);
+        }
+    }
+    return _currentTick + static_cast<Int64>(level0Size - index);
+}
+
+void
+TimerWheel::runThread()
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    while(!_destroyed)
+    {
+        if(!isEmpty(_ready))
+        {
+            Entry* entry = static_cast<Entry*>(_ready.next);
+            unlink(static_cast<Link*>(entry));
+            if(entry->delay == IceUtil::Time())
+            {
+                erase(entry->task.get());
+            }
+            entry->state = Entry::Running;
+            TimerTaskPtr task = entry->task;
+
+            sync.release();
+            runTask(task);
+            sync.acquire();
+
+            if(_destroyed)
+            {
+                delete entry;
+                break;
+            }
+            else if(entry->delay == IceUtil::Time() || entry->canceled)
+            {
+                freeEntry(entry);
+            }
+            else
+            {
+                insert(entry, IceUtil::Time::now(IceUtil::Time::Monotonic), entry->delay);
+            }
+        }
+        else if(!_ticking)
+        {
+            //
+            // This thread advances the wheel until tasks are ready, the
+            // other threads wait for ready tasks.
+            //
+            _ticking = true;
+            IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            advance((now - _start).toMicroSeconds() / _tick);
+            if(isEmpty(_ready))
+            {
+                _wakeUpTick = nextTick();
+                if(_wakeUpTick < 0)
+                {
+                    _tickCond.wait(sync);
+                }
+                else
+                {
+                    IceUtil::Time timeout = _start + IceUtil::Time::microSeconds(_wakeUpTick * _tick) - now;
+                    if(timeout > IceUtil::Time())
+                    {
+                        _tickCond.timedWait(sync, timeout);
+                    }
+                }
+                _wakeUpTick = -1;
+            }
+            _ticking = false;
+
+            if(_idle > 0)
+            {
+                //
+                // Another thread advances the wheel while this one runs
+                // the ready tasks.
+                //
+                if(!isEmpty(_ready) && _ready.next != _ready.prev)
+                {
+                    _readyCond.broadcast();
+                }
+                else
+                {
+                    _readyCond.signal();
+                }
+            }
+        }
+        else
+        {
+            ++_idle;
+            _readyCond.wait(sync);
+            --_idle;
+        }
+    }
+}
+
+void
+TimerWheel::runTask(const TimerTaskPtr& task)
+{
+    try
+    {
+        runTimerTask(task);
+    }
+    catch(const IceUtil::Exception& e)
+    {
+        consoleErr << "IceUtil::TimerWheel::run(): uncaught exception:\n" << e.what();
+#ifdef __GNUC__
+        consoleErr << "\n" << e.ice_stackTrace();
+#endif
+        consoleErr << endl;
+    }
+    catch(const std::exception& e)
+    {
+        consoleErr << "IceUtil::TimerWheel::run(): uncaught exception:\n" << e.what() << endl;
+    }
+    catch(...)
+    {
+        consoleErr << "IceUtil::TimerWheel::run(): uncaught exception" << endl;
+    }
+}
+
+TimerWheel::Entry*
+TimerWheel::find(const TimerTask* task) const
+{
+    if(_buckets.empty())
+    {
+        return 0;
+    }
+
+    Entry* entry = _buckets[hashTask(task) & (_buckets.size() - 1)];
+    while(entry && entry->task.get() != task)
+    {
+        entry = entry->hashNext;
+    }
+    return entry;
+}
+
+void
+TimerWheel::erase(const TimerTask* task)
+{
+    Entry** entry = &_buckets[hashTask(task) & (_buckets.size() - 1)];
+    while(*entry)
+    {
+        if((*entry)->task.get() == task)
+        {
+            *entry = (*entry)->hashNext;
+            --_entries;
+            return;
+        }
+        entry = &(*entry)->hashNext;
+    }
+    assert(false);
+}
+
+void
+TimerWheel::rehash()
+{
+    vector<Entry*> buckets(_buckets.empty() ? initialBuckets : _buckets.size() * 2, static_cast<Entry*>(0));
+    for(vector<Entry*>::const_iterator p = _buckets.begin(); p != _buckets.end(); ++p)
+    {
+        Entry* entry = *p;
+        while(entry)
+        {
+            Entry* next = entry->hashNext;
+            Entry*& bucket = buckets[hashTask(entry->task.get()) & (buckets.size() - 1)];
+            entry->hashNext = bucket;
+            bucket = entry;
+            entry = next;
+        }
+    }
+    _buckets.swap(buckets);
+}
+
+TimerWheel::Entry*
+TimerWheel::newEntry()
+{
+    Entry* entry;
+    if(_free)
+    {
+        entry = _free;
+        _free = entry->hashNext;
+    }
+    else
+    {
+        entry = new Entry;
+    }
+    entry->prev = 0;
+    entry->next = 0;
+    entry->expires = 0;
+    entry->canceled = false;
+    entry->hashNext = 0;
+    return entry;
+}
+
+void
+TimerWheel::freeEntry(Entry* entry)
+{
+    entry->task = 0;
+    entry->hashNext = _free;
+    _free = entry;
+}
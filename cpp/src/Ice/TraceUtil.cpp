@@ -20,6 +20,7 @@
 #include <Ice/InputStream.h>
 #include <Ice/Protocol.h>
 #include <Ice/ReplyStatus.h>
+#include <Ice/Compressor.h>
 #include <set>
 
 using namespace std;
@@ -67,6 +68,12 @@ getMessageTypeAsString(Byte type)
             return "close connection";
         case validateConnectionMsg:
             return "validate connection";
+        case fragmentMsg:
+            return "fragment";
+        case streamChunkMsg:
+            return "stream chunk";
+        case streamCreditMsg:
+            return "stream credit";
         default:
             return "unknown";
     }
@@ -159,30 +166,83 @@ printHeader(ostream& s, InputStream& stream)
     stream.read(compress);
     s << "\ncompression status = "  << static_cast<int>(compress) << ' ';
 
-    switch(compress)
+    if(type == validateConnectionMsg && compress != 0)
     {
-        case 0:
+        //
+        // The compression status of a validate connection message is the codec offered to the peer,
+        // along with the fragment and stream flags.
+        //
+        Byte codec = static_cast<Byte>(compress & ~(fragmentSupportFlag | fragmentRequestFlag | streamSupportFlag));
+        if(codec <= CompressionCodecZstd)
         {
-            s << "(not compressed; do not compress response, if any)";
-            break;
+            s << "(not compressed";
+            if(codec != 0)
+            {
+                s << "; offer " << compressionCodecToString(static_cast<CompressionCodec>(codec)) << " codec";
+            }
+            if(compress & fragmentSupportFlag)
+            {
+                s << "; accept fragments";
+            }
+            if(compress & fragmentRequestFlag)
+            {
+                s << "; send fragments";
+            }
+            if(compress & streamSupportFlag)
+            {
+                s << "; accept streams";
+            }
+            s << ")";
         }
-
-        case 1:
+        else
         {
-            s << "(not compressed; compress response, if any)";
-            break;
+            s << "(unknown)";
         }
-
-        case 2:
+    }
+    else
+    {
+        const bool streamed = (type == requestMsg || type == replyMsg) && (compress & streamFlag);
+        switch(streamed ? static_cast<Byte>(compress & ~streamFlag) : compress)
         {
-            s << "(compressed; compress response, if any)";
-            break;
+            case 0:
+            {
+                s << "(not compressed; do not compress response, if any)";
+                break;
+            }
+
+            case 1:
+            {
+                s << "(not compressed; compress response, if any)";
+                break;
+            }
+
+            case 2:
+            {
+                s << "(compressed; compress response, if any)";
+                break;
+            }
+
+            case 3:
+            {
+                s << "(not compressed; compress response with negotiated codec, if any)";
+                break;
+            }
+
+            case 4:
+            {
+                s << "(compressed with negotiated codec; compress response, if any)";
+                break;
+            }
+
+            default:
+            {
+                s << "(unknown)";
+                break;
+            }
         }
-
-        default:
+        if(streamed)
         {
-            s << "(unknown)";
-            break;
+            s << "\nstreamed parameter = chunks follow";
         }
     }
 
@@ -366,6 +426,44 @@ printMessage(ostream& s, InputStream& stream)
         break;
     }
 
+    case fragmentMsg:
+    {
+        Int id;
+        stream.read(id);
+        s << "\nfragmented message id = " << id;
+        break;
+    }
+
+    case streamChunkMsg:
+    case streamCreditMsg:
+    {
+        Int requestId;
+        stream.read(requestId);
+        s << "\nrequest id = " << requestId;
+        Byte flags;
+        stream.read(flags);
+        s << "\nstream = " << ((flags & streamReplyFlag) ? "reply" : "request");
+        if(flags & streamEndFlag)
+        {
+            s << " (end)";
+        }
+        if(flags & streamAbortFlag)
+        {
+            s << " (abort)";
+        }
+        if(type == streamChunkMsg)
+        {
+            s << "\nchunk size = " << (stream.b.end() - stream.i);
+        }
+        else
+        {
+            Int credit;
+            stream.read(credit);
+            s << "\ncredit = " << credit;
+        }
+        break;
+    }
+
     default:
     {
         break;
@@ -22,3 +22,25 @@ IceInternal::Transceiver::bind()
     return 0;
 }
 
+
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+size_t
+IceInternal::Transceiver::getGatherWriteSize()
+{
+    return 0;
+}
+
+SocketOperation
+IceInternal::Transceiver::writev(vector<Buffer*>& bufs)
+{
+    for(vector<Buffer*>::iterator p = bufs.begin(); p != bufs.end(); ++p)
+    {
+        SocketOperation op = write(**p);
+        if(op)
+        {
+            return op;
+        }
+    }
+    return SocketOperationNone;
+}
+#endif
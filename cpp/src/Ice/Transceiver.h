@@ -39,6 +39,14 @@ public:
     virtual void finishWrite(Buffer&) = 0;
     virtual void startRead(Buffer&) = 0;
     virtual void finishRead(Buffer&) = 0;
+#else
+    //
+    // Transceivers supporting gather writes return the maximum number of
+    // bytes to submit with a single writev() call. The default returns 0
+    // and the connection writes queued messages one at a time.
+    //
+    virtual size_t getGatherWriteSize();
+    virtual SocketOperation writev(std::vector<Buffer*>&);
 #endif
 
     virtual std::string protocol() const = 0;
@@ -116,6 +116,10 @@ IceInternal::UdpTransceiver::close()
     }
     _received.clear();
 #endif
+#ifdef ICE_USE_MMSG
+    _readBatchIndex = 0;
+    _readBatchCount = 0;
+#endif
 
     assert(_fd != INVALID_SOCKET);
     SOCKET fd = _fd;
@@ -267,6 +271,17 @@ IceInternal::UdpTransceiver::read(Buffer& buf)
     assert(buf.i == buf.b.begin());
     assert(_fd != INVALID_SOCKET);
 
+#   ifdef ICE_USE_MMSG
+    //
+    // If the socket must be connected to the peer of the first datagram,
+    // datagrams are received one at a time until it's connected.
+    //
+    if(_readBatch && _state != StateNeedConnect)
+    {
+        return readBatch(buf);
+    }
+#   endif
+
     const int packetSize = min(_maxPacketSize, _rcvSize - _udpOverhead);
     buf.b.resize(packetSize);
     buf.i = buf.b.begin();
@@ -888,9 +903,18 @@ IceInternal::UdpTransceiver::UdpTransceiver(const ProtocolInstancePtr& instance,
 #elif defined(ICE_OS_UWP)
     , _readPending(false)
 #endif
+#ifdef ICE_USE_MMSG
+    , _batchSize(1),
+    _readBatch(0),
+    _readBatchIndex(0),
+    _readBatchCount(0)
+#endif
 {
     _fd = createSocket(true, _addr);
     setBufSize(-1, -1);
+#ifdef ICE_USE_MMSG
+    setBatchSize();
+#endif
     setBlock(_fd, false);
 
 #ifndef ICE_OS_UWP
@@ -970,9 +994,18 @@ IceInternal::UdpTransceiver::UdpTransceiver(const UdpEndpointIPtr& endpoint, con
     , _read(SocketOperationRead),
     _write(SocketOperationWrite)
 #endif
+#ifdef ICE_USE_MMSG
+    , _batchSize(1),
+    _readBatch(0),
+    _readBatchIndex(0),
+    _readBatchCount(0)
+#endif
 {
     _fd = createServerSocket(true, _addr, instance->protocolSupport());
     setBufSize(-1, -1);
+#ifdef ICE_USE_MMSG
+    setBatchSize();
+#endif
     setBlock(_fd, false);
 
 #ifndef ICE_OS_UWP
@@ -1002,6 +1035,9 @@ IceInternal::UdpTransceiver::UdpTransceiver(const UdpEndpointIPtr& endpoint, con
 IceInternal::UdpTransceiver::~UdpTransceiver()
 {
     assert(_fd == INVALID_SOCKET);
+#ifdef ICE_USE_MMSG
+    delete[] _readBatch;
+#endif
 }
 
 //
@@ -1112,6 +1148,200 @@ IceInternal::UdpTransceiver::setBufSize(int rcvSize, int sndSize)
     }
 }
 
+#ifdef ICE_USE_MMSG
+void
+IceInternal::UdpTransceiver::setBatchSize()
+{
+    //
+    // The kernel limits the number of messages of a single recvmmsg
+    // or sendmmsg call to UIO_MAXIOV.
+    //
+    const int maxBatchSize = 1024;
+
+    int batchSize = _instance->properties()->getPropertyAsIntWithDefault("Ice.UDP.BatchSize", 1);
+    if(batchSize < 1 || batchSize > maxBatchSize)
+    {
+        int adjusted = batchSize < 1 ? 1 : maxBatchSize;
+        Warning out(_instance->logger());
+        out << "Invalid Ice.UDP.BatchSize value of " << batchSize << " adjusted to " << adjusted;
+        batchSize = adjusted;
+    }
+
+    _batchSize = batchSize;
+    if(_batchSize > 1)
+    {
+        _readBatch = new Buffer::Container[_batchSize];
+        for(int i = 0; i < _batchSize; ++i)
+        {
+            _readBatch[i].setPool(_instance->bufferPool());
+        }
+        _readBatchAddrs.resize(_batchSize);
+        _readMsgs.resize(_batchSize);
+        _readIovecs.resize(_batchSize);
+        _writeMsgs.resize(_batchSize);
+        _writeIovecs.resize(_batchSize);
+    }
+}
+
+SocketOperation
+IceInternal::UdpTransceiver::readBatch(Buffer& buf)
+{
+    if(_readBatchIndex == _readBatchCount)
+    {
+        //
+        // Receive as many datagrams as available, up to the batch size.
+        //
+        const int packetSize = min(_maxPacketSize, _rcvSize - _udpOverhead);
+        for(int i = 0; i < _batchSize; ++i)
+        {
+            _readBatch[i].resize(packetSize);
+            _readIovecs[i].iov_base = _readBatch[i].begin();
+            _readIovecs[i].iov_len = static_cast<size_t>(packetSize);
+
+            memset(&_readMsgs[i], 0, sizeof(struct mmsghdr));
+            _readMsgs[i].msg_hdr.msg_iov = &_readIovecs[i];
+            _readMsgs[i].msg_hdr.msg_iovlen = 1;
+            if(_state != StateConnected)
+            {
+                assert(_incoming);
+                memset(&_readBatchAddrs[i].saStorage, 0, sizeof(sockaddr_storage));
+                _readMsgs[i].msg_hdr.msg_name = &_readBatchAddrs[i].saStorage;
+                _readMsgs[i].msg_hdr.msg_namelen = static_cast<socklen_t>(sizeof(sockaddr_storage));
+            }
+        }
+
+    repeat:
+
+        int ret = ::recvmmsg(_fd, &_readMsgs[0], static_cast<unsigned int>(_batchSize), 0, 0);
+        if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                goto repeat;
+            }
+
+            if(wouldBlock())
+            {
+                return SocketOperationRead;
+            }
+
+            if(connectionLost())
+            {
+                ConnectionLostException ex(__FILE__, __LINE__);
+                ex.error = getSocketErrno();
+                throw ex;
+            }
+            else
+            {
+                SocketException ex(__FILE__, __LINE__);
+                ex.error = getSocketErrno();
+                throw ex;
+            }
+        }
+
+        _readBatchIndex = 0;
+        _readBatchCount = ret;
+
+        //
+        // Notify the thread pool that more datagrams can be read without
+        // waiting for the socket to be ready for read.
+        //
+        if(_readBatchCount > 1)
+        {
+            ready(SocketOperationRead, true);
+        }
+    }
+
+    //
+    // Hand over the next datagram. The buffer of the caller replaces the
+    // datagram buffer in the batch, it's re-used for the next recvmmsg
+    // call. A truncated datagram fills the whole buffer, it's detected at
+    // the connection level when the Ice message size is checked.
+    //
+    const int i = _readBatchIndex++;
+    buf.b.swap(_readBatch[i]);
+    buf.b.resize(_readMsgs[i].msg_len);
+    buf.i = buf.b.end();
+    if(_state != StateConnected)
+    {
+        _peerAddr = _readBatchAddrs[i];
+    }
+
+    if(_readBatchIndex == _readBatchCount && _readBatchCount > 1)
+    {
+        ready(SocketOperationRead, false);
+    }
+    return SocketOperationNone;
+}
+
+size_t
+IceInternal::UdpTransceiver::getGatherWriteSize()
+{
+    //
+    // Queued datagrams are only sent with sendmmsg if the socket is
+    // connected, a server socket sends to the peer of the last
+    // received datagram.
+    //
+    if(_batchSize > 1 && _state == StateConnected)
+    {
+        return static_cast<size_t>(_sndSize);
+    }
+    return 0;
+}
+
+SocketOperation
+IceInternal::UdpTransceiver::writev(vector<Buffer*>& bufs)
+{
+    assert(_fd != INVALID_SOCKET && _state == StateConnected);
+
+    const int count = min(static_cast<int>(bufs.size()), _batchSize);
+    for(int i = 0; i < count; ++i)
+    {
+        Buffer& buf = *bufs[i];
+        assert(buf.i == buf.b.begin());
+        _writeIovecs[i].iov_base = buf.b.begin();
+        _writeIovecs[i].iov_len = buf.b.size();
+
+        memset(&_writeMsgs[i], 0, sizeof(struct mmsghdr));
+        _writeMsgs[i].msg_hdr.msg_iov = &_writeIovecs[i];
+        _writeMsgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+repeat:
+
+    int ret = ::sendmmsg(_fd, &_writeMsgs[0], static_cast<unsigned int>(count), 0);
+    if(ret == SOCKET_ERROR)
+    {
+        if(interrupted())
+        {
+            goto repeat;
+        }
+
+        if(wouldBlock())
+        {
+            return SocketOperationWrite;
+        }
+
+        SocketException ex(__FILE__, __LINE__);
+        ex.error = getSocketErrno();
+        throw ex;
+    }
+
+    for(int i = 0; i < ret; ++i)
+    {
+        assert(_writeMsgs[i].msg_len == bufs[i]->b.size());
+        bufs[i]->i = bufs[i]->b.end();
+    }
+
+    //
+    // If not all the datagrams were sent, wait for the socket to be ready
+    // for write. The error of a failed datagram, if any, is reported by
+    // the next call.
+    //
+    return ret < count ? SocketOperationWrite : SocketOperationNone;
+}
+#endif
+
 #ifdef ICE_OS_UWP
 void
 IceInternal::UdpTransceiver::appendMessage(DatagramSocketMessageReceivedEventArgs^ args)
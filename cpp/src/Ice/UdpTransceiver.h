@@ -15,11 +15,16 @@
 #include <Ice/ProtocolInstanceF.h>
 #include <Ice/Transceiver.h>
 #include <Ice/Network.h>
+#include <Ice/Buffer.h>
 
 #ifdef ICE_OS_UWP
 #   include <deque>
 #endif
 
+#if defined(__linux) && !defined(ICE_NO_MMSG)
+#   define ICE_USE_MMSG 1
+#endif
+
 namespace IceInternal
 {
 
@@ -53,6 +58,10 @@ public:
     virtual void finishWrite(Buffer&);
     virtual void startRead(Buffer&);
     virtual void finishRead(Buffer&);
+#endif
+#ifdef ICE_USE_MMSG
+    virtual size_t getGatherWriteSize();
+    virtual SocketOperation writev(std::vector<Buffer*>&);
 #endif
     virtual std::string protocol() const;
     virtual std::string toString() const;
@@ -72,6 +81,10 @@ private:
     virtual ~UdpTransceiver();
 
     void setBufSize(int, int);
+#ifdef ICE_USE_MMSG
+    void setBatchSize();
+    SocketOperation readBatch(Buffer&);
+#endif
 
 #ifdef ICE_OS_UWP
     void appendMessage(Windows::Networking::Sockets::DatagramSocketMessageReceivedEventArgs^);
@@ -110,6 +123,23 @@ private:
     bool _readPending;
     std::deque<Windows::Networking::Sockets::DatagramSocketMessageReceivedEventArgs^> _received;
 #endif
+
+#ifdef ICE_USE_MMSG
+    //
+    // With Ice.UDP.BatchSize > 1, datagrams are received with recvmmsg
+    // into the read batch buffers and handed over one at a time by
+    // read(). Queued datagrams are sent with sendmmsg.
+    //
+    int _batchSize;
+    Buffer::Container* _readBatch;
+    std::vector<Address> _readBatchAddrs;
+    std::vector<struct mmsghdr> _readMsgs;
+    std::vector<struct iovec> _readIovecs;
+    int _readBatchIndex;
+    int _readBatchCount;
+    std::vector<struct mmsghdr> _writeMsgs;
+    std::vector<struct iovec> _writeIovecs;
+#endif
 };
 
 }
@@ -0,0 +1,189 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/UnixAcceptor.h>
+
+#ifdef ICE_USE_UNIX_SOCKETS
+
+#include <Ice/UnixTransceiver.h>
+#include <Ice/UnixEndpointI.h>
+#include <Ice/ProtocolInstance.h>
+#include <Ice/LocalException.h>
+#include <Ice/Properties.h>
+#include <Ice/StreamSocket.h>
+
+//
+// Use the system default for the listen() backlog or 511 if not defined.
+//
+#ifndef SOMAXCONN
+#  define SOMAXCONN 511
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(UnixAcceptor* p) { return p; }
+
+namespace
+{
+
+//
+// Remove the socket file left over by a process which didn't close its
+// acceptor (e.g.: a server that crashed). The file is only removed if
+// nobody accepts connections on it anymore.
+//
+void
+removeStaleSocket(const string& path)
+{
+    struct stat st;
+    if(stat(path.c_str(), &st) != 0 || !S_ISSOCK(st.st_mode))
+    {
+        return;
+    }
+
+    SOCKET fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd == INVALID_SOCKET)
+    {
+        return;
+    }
+
+    //
+    // Use a non-blocking connect, it fails with EAGAIN instead of
+    // blocking if the backlog of a live acceptor is full.
+    //
+    bool refused = false;
+    try
+    {
+        setBlock(fd, false);
+        Address addr = getUnixAddress(path);
+        if(::connect(fd, &addr.sa, static_cast<socklen_t>(sizeof(sockaddr_un))) == SOCKET_ERROR)
+        {
+            refused = connectionRefused();
+        }
+        closeSocketNoThrow(fd);
+    }
+    catch(const Ice::LocalException&)
+    {
+        // setBlock closes the socket if it fails.
+    }
+
+    if(refused)
+    {
+        unlink(path.c_str());
+    }
+}
+
+}
+
+NativeInfoPtr
+IceInternal::UnixAcceptor::getNativeInfo()
+{
+    return this;
+}
+
+void
+IceInternal::UnixAcceptor::close()
+{
+    if(_fd != INVALID_SOCKET)
+    {
+        closeSocketNoThrow(_fd);
+        _fd = INVALID_SOCKET;
+    }
+
+    if(_bound)
+    {
+        struct stat st;
+        if(stat(_path.c_str(), &st) == 0 && st.st_dev == _dev && st.st_ino == _ino)
+        {
+            unlink(_path.c_str());
+        }
+        _bound = false;
+    }
+}
+
+EndpointIPtr
+IceInternal::UnixAcceptor::listen()
+{
+    const bool abstract = _path[0] == '@';
+    if(!abstract)
+    {
+        removeStaleSocket(_path);
+    }
+
+    try
+    {
+        doBind(_fd, _addr);
+        if(!abstract)
+        {
+            struct stat st;
+            if(stat(_path.c_str(), &st) == 0)
+            {
+                _bound = true;
+                _dev = st.st_dev;
+                _ino = st.st_ino;
+            }
+        }
+        doListen(_fd, _backlog);
+    }
+    catch(...)
+    {
+        _fd = INVALID_SOCKET;
+        close();
+        throw;
+    }
+    return _endpoint;
+}
+
+TransceiverPtr
+IceInternal::UnixAcceptor::accept()
+{
+    return new UnixTransceiver(_instance, new StreamSocket(_instance, doAccept(_fd)));
+}
+
+string
+IceInternal::UnixAcceptor::protocol() const
+{
+    return _instance->protocol();
+}
+
+string
+IceInternal::UnixAcceptor::toString() const
+{
+    return _path;
+}
+
+string
+IceInternal::UnixAcceptor::toDetailedString() const
+{
+    return "local address = " + toString();
+}
+
+IceInternal::UnixAcceptor::UnixAcceptor(const UnixEndpointIPtr& endpoint, const ProtocolInstancePtr& instance,
+                                        const string& path) :
+    _endpoint(endpoint),
+    _instance(instance),
+    _path(path),
+    _addr(getUnixAddress(path)),
+    _bound(false),
+    _dev(0),
+    _ino(0)
+{
+    _backlog = instance->properties()->getPropertyAsIntWithDefault("Ice.TCP.Backlog", SOMAXCONN);
+
+    _fd = createSocket(false, _addr);
+    setBlock(_fd, false);
+}
+
+IceInternal::UnixAcceptor::~UnixAcceptor()
+{
+    assert(_fd == INVALID_SOCKET);
+}
+
+#endif
@@ -0,0 +1,111 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/UnixConnector.h>
+
+#ifdef ICE_USE_UNIX_SOCKETS
+
+#include <Ice/UnixTransceiver.h>
+#include <Ice/UnixEndpointI.h>
+#include <Ice/ProtocolInstance.h>
+#include <Ice/StreamSocket.h>
+#include <Ice/Exception.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+TransceiverPtr
+IceInternal::UnixConnector::connect()
+{
+    return new UnixTransceiver(_instance, new StreamSocket(_instance, ICE_NULLPTR, _addr, Address()));
+}
+
+Short
+IceInternal::UnixConnector::type() const
+{
+    return _instance->type();
+}
+
+string
+IceInternal::UnixConnector::toString() const
+{
+    return addrToString(_addr);
+}
+
+bool
+IceInternal::UnixConnector::operator==(const Connector& r) const
+{
+    const UnixConnector* p = dynamic_cast<const UnixConnector*>(&r);
+    if(!p)
+    {
+        return false;
+    }
+
+    if(compareAddress(_addr, p->_addr) != 0)
+    {
+        return false;
+    }
+
+    if(_timeout != p->_timeout)
+    {
+        return false;
+    }
+
+    if(_connectionId != p->_connectionId)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool
+IceInternal::UnixConnector::operator<(const Connector& r) const
+{
+    const UnixConnector* p = dynamic_cast<const UnixConnector*>(&r);
+    if(!p)
+    {
+        return type() < r.type();
+    }
+
+    if(_timeout < p->_timeout)
+    {
+        return true;
+    }
+    else if(p->_timeout < _timeout)
+    {
+        return false;
+    }
+
+    if(_connectionId < p->_connectionId)
+    {
+        return true;
+    }
+    else if(p->_connectionId < _connectionId)
+    {
+        return false;
+    }
+    return compareAddress(_addr, p->_addr) < 0;
+}
+
+IceInternal::UnixConnector::UnixConnector(const ProtocolInstancePtr& instance, const Address& addr, Ice::Int timeout,
+                                          const string& connectionId) :
+    _instance(instance),
+    _addr(addr),
+    _timeout(timeout),
+    _connectionId(connectionId)
+{
+}
+
+IceInternal::UnixConnector::~UnixConnector()
+{
+}
+
+#endif
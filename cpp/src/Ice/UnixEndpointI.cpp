@@ -0,0 +1,540 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/UnixEndpointI.h>
+
+#ifdef ICE_USE_UNIX_SOCKETS
+
+#include <Ice/UnixAcceptor.h>
+#include <Ice/UnixConnector.h>
+#include <Ice/OutputStream.h>
+#include <Ice/InputStream.h>
+#include <Ice/LocalException.h>
+#include <Ice/ProtocolInstance.h>
+#include <Ice/HashUtil.h>
+#include <IceUtil/StringUtil.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+#ifndef ICE_CPP11_MAPPING
+IceUtil::Shared* IceInternal::upCast(UnixEndpointI* p) { return p; }
+#endif
+
+extern "C"
+{
+
+Plugin*
+createIceUnix(const CommunicatorPtr& c, const string&, const StringSeq&)
+{
+    return new EndpointFactoryPlugin(c, new UnixEndpointFactory(new ProtocolInstance(c, UnixEndpointType, "unix",
+                                                                                     false)));
+}
+
+}
+
+IceInternal::UnixEndpointI::UnixEndpointI(const ProtocolInstancePtr& instance, const string& path, Int timeout,
+                                          const string& connectionId, bool compress) :
+    _instance(instance),
+    _path(path),
+    _timeout(timeout),
+    _connectionId(connectionId),
+    _compress(compress),
+    _hashValue(0)
+{
+    hashInit();
+}
+
+IceInternal::UnixEndpointI::UnixEndpointI(const ProtocolInstancePtr& instance) :
+    _instance(instance),
+    _timeout(instance->defaultTimeout()),
+    _compress(false),
+    _hashValue(0)
+{
+}
+
+IceInternal::UnixEndpointI::UnixEndpointI(const ProtocolInstancePtr& instance, InputStream* s) :
+    _instance(instance),
+    _timeout(-1),
+    _compress(false),
+    _hashValue(0)
+{
+    s->read(const_cast<string&>(_path), false);
+    s->read(const_cast<Int&>(_timeout));
+    s->read(const_cast<bool&>(_compress));
+    hashInit();
+}
+
+void
+IceInternal::UnixEndpointI::streamWriteImpl(OutputStream* s) const
+{
+    s->write(_path, false);
+    s->write(_timeout);
+    s->write(_compress);
+}
+
+EndpointInfoPtr
+IceInternal::UnixEndpointI::getInfo() const
+{
+    UnixEndpointInfoPtr info = ICE_MAKE_SHARED(InfoI<Ice::UnixEndpointInfo>, ICE_SHARED_FROM_CONST_THIS(UnixEndpointI));
+    info->path = _path;
+    return info;
+}
+
+Short
+IceInternal::UnixEndpointI::type() const
+{
+    return _instance->type();
+}
+
+const string&
+IceInternal::UnixEndpointI::protocol() const
+{
+    return _instance->protocol();
+}
+
+Int
+IceInternal::UnixEndpointI::timeout() const
+{
+    return _timeout;
+}
+
+EndpointIPtr
+IceInternal::UnixEndpointI::timeout(Int timeout) const
+{
+    if(timeout == _timeout)
+    {
+        return ICE_SHARED_FROM_CONST_THIS(UnixEndpointI);
+    }
+    else
+    {
+        return ICE_MAKE_SHARED(UnixEndpointI, _instance, _path, timeout, _connectionId, _compress);
+    }
+}
+
+const string&
+IceInternal::UnixEndpointI::connectionId() const
+{
+    return _connectionId;
+}
+
+EndpointIPtr
+IceInternal::UnixEndpointI::connectionId(const string& connectionId) const
+{
+    if(connectionId == _connectionId)
+    {
+        return ICE_SHARED_FROM_CONST_THIS(UnixEndpointI);
+    }
+    else
+    {
+        return ICE_MAKE_SHARED(UnixEndpointI, _instance, _path, _timeout, connectionId, _compress);
+    }
+}
+
+bool
+IceInternal::UnixEndpointI::compress() const
+{
+    return _compress;
+}
+
+EndpointIPtr
+IceInternal::UnixEndpointI::compress(bool compress) const
+{
+    if(compress == _compress)
+    {
+        return ICE_SHARED_FROM_CONST_THIS(UnixEndpointI);
+    }
+    else
+    {
+        return ICE_MAKE_SHARED(UnixEndpointI, _instance, _path, _timeout, _connectionId, compress);
+    }
+}
+
+bool
+IceInternal::UnixEndpointI::datagram() const
+{
+    return false;
+}
+
+bool
+IceInternal::UnixEndpointI::secure() const
+{
+    return _instance->secure();
+}
+
+TransceiverPtr
+IceInternal::UnixEndpointI::transceiver() const
+{
+    return ICE_NULLPTR;
+}
+
+void
+IceInternal::UnixEndpointI::connectors_async(EndpointSelectionType, const EndpointI_connectorsPtr& cb) const
+{
+    //
+    // There's no name resolution with Unix domain sockets, the path
+    // is the address.
+    //
+    vector<ConnectorPtr> connectors;
+    connectors.push_back(new UnixConnector(_instance, getUnixAddress(_path), _timeout, _connectionId));
+    cb->connectors(connectors);
+}
+
+AcceptorPtr
+IceInternal::UnixEndpointI::acceptor(const string&) const
+{
+    return new UnixAcceptor(ICE_SHARED_FROM_CONST_THIS(UnixEndpointI), _instance, _path);
+}
+
+vector<EndpointIPtr>
+IceInternal::UnixEndpointI::expand() const
+{
+    //
+    // Nothing to do here.
+    //
+    vector<EndpointIPtr> endps;
+    endps.push_back(ICE_SHARED_FROM_CONST_THIS(UnixEndpointI));
+    return endps;
+}
+
+bool
+IceInternal::UnixEndpointI::equivalent(const EndpointIPtr& endpoint) const
+{
+    const UnixEndpointI* unixEndpointI = dynamic_cast<const UnixEndpointI*>(endpoint.get());
+    if(!unixEndpointI)
+    {
+        return false;
+    }
+    return unixEndpointI->type() == type() && unixEndpointI->_path == _path;
+}
+
+Int
+IceInternal::UnixEndpointI::hash() const
+{
+    return _hashValue;
+}
+
+string
+IceInternal::UnixEndpointI::options() const
+{
+    //
+    // WARNING: Certain features, such as proxy validation in Glacier2,
+    // depend on the format of proxy strings. Changes to toString() and
+    // methods called to generate parts of the reference string could break
+    // these features. Please review for all features that depend on the
+    // format of proxyToString() before changing this and related code.
+    //
+    ostringstream s;
+
+    if(!_path.empty())
+    {
+        s << " -p ";
+        bool addQuote = _path.find_first_of(": \t\n\r") != string::npos;
+        if(addQuote)
+        {
+            s << "\"";
+        }
+        s << _path;
+        if(addQuote)
+        {
+            s << "\"";
+        }
+    }
+
+    if(_timeout == -1)
+    {
+        s << " -t infinite";
+    }
+    else
+    {
+        s << " -t " << _timeout;
+    }
+
+    if(_compress)
+    {
+        s << " -z";
+    }
+
+    return s.str();
+}
+
+bool
+#ifdef ICE_CPP11_MAPPING
+IceInternal::UnixEndpointI::operator==(const Endpoint& r) const
+#else
+IceInternal::UnixEndpointI::operator==(const LocalObject& r) const
+#endif
+{
+    const UnixEndpointI* p = dynamic_cast<const UnixEndpointI*>(&r);
+    if(!p)
+    {
+        return false;
+    }
+
+    if(this == p)
+    {
+        return true;
+    }
+
+    if(_path != p->_path)
+    {
+        return false;
+    }
+
+    if(_connectionId != p->_connectionId)
+    {
+        return false;
+    }
+
+    if(_timeout != p->_timeout)
+    {
+        return false;
+    }
+
+    if(_compress != p->_compress)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool
+#ifdef ICE_CPP11_MAPPING
+IceInternal::UnixEndpointI::operator<(const Endpoint& r) const
+#else
+IceInternal::UnixEndpointI::operator<(const LocalObject& r) const
+#endif
+{
+    const UnixEndpointI* p = dynamic_cast<const UnixEndpointI*>(&r);
+    if(!p)
+    {
+        const EndpointI* e = dynamic_cast<const EndpointI*>(&r);
+        if(!e)
+        {
+            return false;
+        }
+        return type() < e->type();
+    }
+
+    if(this == p)
+    {
+        return false;
+    }
+
+    if(_path < p->_path)
+    {
+        return true;
+    }
+    else if(p->_path < _path)
+    {
+        return false;
+    }
+
+    if(_connectionId < p->_connectionId)
+    {
+        return true;
+    }
+    else if(p->_connectionId < _connectionId)
+    {
+        return false;
+    }
+
+    if(_timeout < p->_timeout)
+    {
+        return true;
+    }
+    else if(p->_timeout < _timeout)
+    {
+        return false;
+    }
+
+    if(!_compress && p->_compress)
+    {
+        return true;
+    }
+    else if(p->_compress < _compress)
+    {
+        return false;
+    }
+
+    return false;
+}
+
+const string&
+IceInternal::UnixEndpointI::path() const
+{
+    return _path;
+}
+
+void
+IceInternal::UnixEndpointI::initWithOptions(vector<string>& args, bool)
+{
+    EndpointI::initWithOptions(args);
+
+    if(_path.empty())
+    {
+        EndpointParseException ex(__FILE__, __LINE__);
+        ex.str = "a path must be specified using the -p option in endpoint `" + toString() + "'";
+        throw ex;
+    }
+
+    hashInit();
+}
+
+bool
+IceInternal::UnixEndpointI::checkOption(const string& option, const string& argument, const string& endpoint)
+{
+    switch(option[1])
+    {
+    case 'p':
+    {
+        string arg = IceUtilInternal::trim(argument);
+        if(arg.empty())
+        {
+            EndpointParseException ex(__FILE__, __LINE__);
+            ex.str = "no argument provided for -p option in endpoint " + endpoint;
+            throw ex;
+        }
+
+        //
+        // The path must fit in sockaddr_un with its terminating null
+        // byte (or the leading null byte for abstract sockets).
+        //
+        if(arg.size() >= sizeof(sockaddr_un().sun_path))
+        {
+            EndpointParseException ex(__FILE__, __LINE__);
+            ex.str = "path `" + arg + "' is too long in endpoint " + endpoint;
+            throw ex;
+        }
+
+        if(arg[0] == '@')
+        {
+#if defined(__linux)
+            if(arg.size() == 1)
+            {
+                EndpointParseException ex(__FILE__, __LINE__);
+                ex.str = "empty abstract socket name in endpoint " + endpoint;
+                throw ex;
+            }
+#else
+            EndpointParseException ex(__FILE__, __LINE__);
+            ex.str = "abstract socket names are not supported on this platform in endpoint " + endpoint;
+            throw ex;
+#endif
+        }
+        const_cast<string&>(_path) = arg;
+        return true;
+    }
+
+    case 't':
+    {
+        if(argument.empty())
+        {
+            EndpointParseException ex(__FILE__, __LINE__);
+            ex.str = "no argument provided for -t option in endpoint " + endpoint;
+            throw ex;
+        }
+
+        if(argument == "infinite")
+        {
+            const_cast<Int&>(_timeout) = -1;
+        }
+        else
+        {
+            istringstream t(argument);
+            if(!(t >> const_cast<Int&>(_timeout)) || !t.eof() || _timeout < 1)
+            {
+                EndpointParseException ex(__FILE__, __LINE__);
+                ex.str = "invalid timeout value `" + argument + "' in endpoint " + endpoint;
+                throw ex;
+            }
+        }
+        return true;
+    }
+
+    case 'z':
+    {
+        if(!argument.empty())
+        {
+            EndpointParseException ex(__FILE__, __LINE__);
+            ex.str = "unexpected argument `" + argument + "' provided for -z option in " + endpoint;
+            throw ex;
+        }
+        const_cast<bool&>(_compress) = true;
+        return true;
+    }
+
+    default:
+    {
+        return false;
+    }
+    }
+}
+
+void
+IceInternal::UnixEndpointI::hashInit()
+{
+    Int h = 5381;
+    hashAdd(h, type());
+    hashAdd(h, _path);
+    hashAdd(h, _timeout);
+    hashAdd(h, _connectionId);
+    hashAdd(h, _compress);
+    const_cast<Int&>(_hashValue) = h;
+}
+
+IceInternal::UnixEndpointFactory::UnixEndpointFactory(const ProtocolInstancePtr& instance) : _instance(instance)
+{
+}
+
+IceInternal::UnixEndpointFactory::~UnixEndpointFactory()
+{
+}
+
+Short
+IceInternal::UnixEndpointFactory::type() const
+{
+    return _instance->type();
+}
+
+string
+IceInternal::UnixEndpointFactory::protocol() const
+{
+    return _instance->protocol();
+}
+
+EndpointIPtr
+IceInternal::UnixEndpointFactory::create(vector<string>& args, bool oaEndpoint) const
+{
+    UnixEndpointIPtr endpt = ICE_MAKE_SHARED(UnixEndpointI, _instance);
+    endpt->initWithOptions(args, oaEndpoint);
+    return endpt;
+}
+
+EndpointIPtr
+IceInternal::UnixEndpointFactory::read(InputStream* s) const
+{
+    return ICE_MAKE_SHARED(UnixEndpointI, _instance, s);
+}
+
+void
+IceInternal::UnixEndpointFactory::destroy()
+{
+    _instance = 0;
+}
+
+EndpointFactoryPtr
+IceInternal::UnixEndpointFactory::clone(const ProtocolInstancePtr& instance, const EndpointFactoryPtr&) const
+{
+    return new UnixEndpointFactory(instance);
+}
+
+#endif
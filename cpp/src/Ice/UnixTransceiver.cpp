@@ -0,0 +1,136 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/UnixTransceiver.h>
+
+#ifdef ICE_USE_UNIX_SOCKETS
+
+#include <Ice/Connection.h>
+#include <Ice/ProtocolInstance.h>
+#include <Ice/Buffer.h>
+#include <Ice/LocalException.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+NativeInfoPtr
+IceInternal::UnixTransceiver::getNativeInfo()
+{
+    return _stream;
+}
+
+SocketOperation
+IceInternal::UnixTransceiver::initialize(Buffer& readBuffer, Buffer& writeBuffer)
+{
+    return _stream->connect(readBuffer, writeBuffer);
+}
+
+SocketOperation
+IceInternal::UnixTransceiver::closing(bool initiator, const Ice::LocalException&)
+{
+    // If we are initiating the connection closure, wait for the peer
+    // to close the connection. Otherwise, close immediately.
+    return initiator ? SocketOperationRead : SocketOperationNone;
+}
+
+void
+IceInternal::UnixTransceiver::close()
+{
+    _stream->close();
+}
+
+SocketOperation
+IceInternal::UnixTransceiver::write(Buffer& buf)
+{
+    return _stream->write(buf);
+}
+
+SocketOperation
+IceInternal::UnixTransceiver::read(Buffer& buf)
+{
+    return _stream->read(buf);
+}
+
+size_t
+IceInternal::UnixTransceiver::getGatherWriteSize()
+{
+    return _stream->getGatherWriteSize();
+}
+
+SocketOperation
+IceInternal::UnixTransceiver::writev(vector<Buffer*>& bufs)
+{
+    return _stream->writev(bufs);
+}
+
+string
+IceInternal::UnixTransceiver::protocol() const
+{
+    return _instance->protocol();
+}
+
+string
+IceInternal::UnixTransceiver::toString() const
+{
+    return _stream->toString();
+}
+
+string
+IceInternal::UnixTransceiver::toDetailedString() const
+{
+    return toString();
+}
+
+Ice::ConnectionInfoPtr
+IceInternal::UnixTransceiver::getInfo() const
+{
+    UnixConnectionInfoPtr info = ICE_MAKE_SHARED(UnixConnectionInfo);
+    if(_stream->fd() != INVALID_SOCKET)
+    {
+        //
+        // The accepted socket is bound to the path, the connected
+        // socket is unnamed and its peer is bound to the path.
+        //
+        Address addr;
+        fdToLocalAddress(_stream->fd(), addr);
+        info->path = unixAddrToString(addr);
+        if(info->path.empty() && fdToRemoteAddress(_stream->fd(), addr))
+        {
+            info->path = unixAddrToString(addr);
+        }
+        getPeerCredentials(_stream->fd(), info->peerPid, info->peerUid, info->peerGid);
+        info->rcvSize = getRecvBufferSize(_stream->fd());
+        info->sndSize = getSendBufferSize(_stream->fd());
+    }
+    return info;
+}
+
+void
+IceInternal::UnixTransceiver::checkSendSize(const Buffer&)
+{
+}
+
+void
+IceInternal::UnixTransceiver::setBufferSize(int rcvSize, int sndSize)
+{
+    _stream->setBufferSize(rcvSize, sndSize);
+}
+
+IceInternal::UnixTransceiver::UnixTransceiver(const ProtocolInstancePtr& instance, const StreamSocketPtr& stream) :
+    _instance(instance),
+    _stream(stream)
+{
+}
+
+IceInternal::UnixTransceiver::~UnixTransceiver()
+{
+}
+
+#endif
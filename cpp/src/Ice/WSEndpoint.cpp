@@ -225,6 +225,12 @@ IceInternal::WSEndpoint::acceptor(const string& adapterName) const
     return new WSAcceptor(ICE_SHARED_FROM_CONST_THIS(WSEndpoint), _instance, delAcc);
 }
 
+Ice::Int
+IceInternal::WSEndpoint::reusePort() const
+{
+    return _delegate->reusePort();
+}
+
 WSEndpointPtr
 IceInternal::WSEndpoint::endpoint(const EndpointIPtr& delEndp) const
 {
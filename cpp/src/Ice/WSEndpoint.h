@@ -49,6 +49,7 @@ public:
     virtual TransceiverPtr transceiver() const;
     virtual void connectors_async(Ice::EndpointSelectionType, const EndpointI_connectorsPtr&) const;
     virtual AcceptorPtr acceptor(const std::string&) const;
+    virtual Ice::Int reusePort() const;
 
     virtual std::vector<EndpointIPtr> expand() const;
     virtual bool equivalent(const EndpointIPtr&) const;
@@ -200,6 +200,12 @@ IceSSL::EndpointI::acceptor(const string& adapterName) const
     return new AcceptorI(ICE_SHARED_FROM_CONST_THIS(EndpointI), _instance, _delegate->acceptor(adapterName), adapterName);
 }
 
+Ice::Int
+IceSSL::EndpointI::reusePort() const
+{
+    return _delegate->reusePort();
+}
+
 EndpointIPtr
 IceSSL::EndpointI::endpoint(const IceInternal::EndpointIPtr& delEndp) const
 {
@@ -25,11 +25,23 @@
 #include <IceUtil/Mutex.h>
 #include <IceUtil/MutexPtrLock.h>
 #include <IceUtil/FileUtil.h>
+#include <IceUtil/Thread.h>
+
+#include <deque>
 
 #include <openssl/rand.h>
+#include <openssl/sha.h>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 #include <openssl/pkcs12.h>
+#ifdef ICESSL_SESSION_RESUMPTION
+#  include <openssl/evp.h>
+#  if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#    include <openssl/core_names.h>
+#  else
+#    include <openssl/hmac.h>
+#  endif
+#endif
 
 using namespace std;
 using namespace Ice;
@@ -137,6 +149,72 @@ IceSSL_opensslDHCallback(SSL* ssl, int /*isExport*/, int keyLength)
 }
 #endif
 
+#ifdef ICESSL_SESSION_RESUMPTION
+//
+// OpenSSL new session callback, called when the client receives a session
+// that can later be resumed.
+//
+int
+IceSSL_opensslNewSessionCallback(SSL* ssl, SSL_SESSION* session)
+{
+    OpenSSL::TransceiverI* p = reinterpret_cast<OpenSSL::TransceiverI*>(SSL_get_ex_data(ssl, 0));
+    return p->newSession(session);
+}
+
+//
+// OpenSSL session ticket key callback, sets up the cipher and HMAC keys used
+// to encrypt or decrypt a session ticket.
+//
+#  if OPENSSL_VERSION_NUMBER >= 0x30000000L
+int
+IceSSL_opensslTicketKeyCallback(SSL* ssl, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* ctx,
+                                EVP_MAC_CTX* hctx, int enc)
+#  else
+int
+IceSSL_opensslTicketKeyCallback(SSL* ssl, unsigned char* name, unsigned char* iv, EVP_CIPHER_CTX* ctx,
+                                HMAC_CTX* hctx, int enc)
+#  endif
+{
+    OpenSSL::SSLEngine* p = reinterpret_cast<OpenSSL::SSLEngine*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), 0));
+    if(enc == 1 && RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc())) <= 0)
+    {
+        return -1;
+    }
+
+    unsigned char aesKey[32];
+    unsigned char hmacKey[32];
+    int ret = p->sessionTicketKey(name, enc == 1, aesKey, hmacKey);
+    if(ret > 0)
+    {
+        bool ok;
+        if(enc == 1)
+        {
+            ok = EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), 0, aesKey, iv) == 1;
+        }
+        else
+        {
+            ok = EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), 0, aesKey, iv) == 1;
+        }
+#  if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        OSSL_PARAM params[3];
+        params[0] = OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, hmacKey, sizeof(hmacKey));
+        params[1] = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, const_cast<char*>("SHA256"), 0);
+        params[2] = OSSL_PARAM_construct_end();
+        ok = ok && EVP_MAC_CTX_set_params(hctx, params) == 1;
+#  else
+        ok = ok && HMAC_Init_ex(hctx, hmacKey, static_cast<int>(sizeof(hmacKey)), EVP_sha256(), 0) == 1;
+#  endif
+        if(!ok)
+        {
+            ret = -1;
+        }
+    }
+    OPENSSL_cleanse(aesKey, sizeof(aesKey));
+    OPENSSL_cleanse(hmacKey, sizeof(hmacKey));
+    return ret;
+}
+#endif
+
 }
 
 namespace
@@ -189,6 +267,21 @@ passwordError()
             reason == PKCS12_R_MAC_VERIFY_FAILURE);
 }
 
+#ifdef ICESSL_SESSION_RESUMPTION
+template<typename T> bool
+generateTicketKey(T& key)
+{
+    if(RAND_bytes(key.name, static_cast<int>(sizeof(key.name))) <= 0 ||
+       RAND_bytes(key.aesKey, static_cast<int>(sizeof(key.aesKey))) <= 0 ||
+       RAND_bytes(key.hmacKey, static_cast<int>(sizeof(key.hmacKey))) <= 0)
+    {
+        return false;
+    }
+    key.created = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    return true;
+}
+#endif
+
 }
 
 IceUtil::Shared*
@@ -197,9 +290,152 @@ OpenSSL::upCast(OpenSSL::SSLEngine* p)
     return p;
 }
 
+namespace IceSSL
+{
+
+namespace OpenSSL
+{
+
+//
+// The handshake thread pool performs the TLS handshakes instead of the
+// Ice thread pools, the expensive handshake operations then don't delay
+// the processing of the messages of the established connections.
+//
+class HandshakeThreadPool : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    HandshakeThreadPool(int);
+
+    void queue(const TransceiverIPtr&);
+    void destroy();
+    void run();
+
+private:
+
+    bool _destroyed;
+    deque<TransceiverIPtr> _queue;
+    vector<IceUtil::ThreadPtr> _threads;
+};
+
+}
+
+}
+
+#ifndef ICE_USE_IOCP
+namespace
+{
+
+class HandshakeThread : public IceUtil::Thread
+{
+public:
+
+    HandshakeThread(const OpenSSL::HandshakeThreadPoolPtr& threadPool, const string& name) :
+        IceUtil::Thread(name),
+        _threadPool(threadPool)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _threadPool->run();
+    }
+
+private:
+
+    const OpenSSL::HandshakeThreadPoolPtr _threadPool;
+};
+
+}
+
+OpenSSL::HandshakeThreadPool::HandshakeThreadPool(int size) :
+    _destroyed(false)
+{
+    try
+    {
+        for(int i = 0; i < size; ++i)
+        {
+            ostringstream name;
+            name << "IceSSL.HandshakeThread-" << i;
+            IceUtil::ThreadPtr thread = new HandshakeThread(this, name.str());
+            thread->start();
+            _threads.push_back(thread);
+        }
+    }
+    catch(const IceUtil::Exception&)
+    {
+        destroy();
+        throw;
+    }
+}
+
+void
+OpenSSL::HandshakeThreadPool::queue(const TransceiverIPtr& transceiver)
+{
+    Lock sync(*this);
+    if(_destroyed)
+    {
+        throw CommunicatorDestroyedException(__FILE__, __LINE__);
+    }
+    _queue.push_back(transceiver);
+    notify();
+}
+
+void
+OpenSSL::HandshakeThreadPool::destroy()
+{
+    vector<IceUtil::ThreadPtr> threads;
+    {
+        Lock sync(*this);
+        _destroyed = true;
+        _threads.swap(threads);
+        notifyAll();
+    }
+
+    for(vector<IceUtil::ThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+
+    Lock sync(*this);
+    _queue.clear();
+}
+
+void
+OpenSSL::HandshakeThreadPool::run()
+{
+    while(true)
+    {
+        TransceiverIPtr transceiver;
+        {
+            Lock sync(*this);
+            while(!_destroyed && _queue.empty())
+            {
+                wait();
+            }
+            if(_destroyed)
+            {
+                return;
+            }
+            transceiver = _queue.front();
+            _queue.pop_front();
+        }
+        transceiver->runHandshake();
+    }
+}
+#endif
+
 OpenSSL::SSLEngine::SSLEngine(const CommunicatorPtr& communicator) :
     IceSSL::SSLEngine(communicator),
-    _ctx(0)
+    _ctx(0),
+    _kernelTLS(false)
+#ifdef ICESSL_SESSION_RESUMPTION
+    , _sessionCacheSize(0),
+    _sessionTicketLifetime(0),
+    _previousTicketKey(false),
+    _ticketKeyFile(false)
+#endif
 {
     __setNoDelete(true);
 
@@ -394,6 +630,78 @@ OpenSSL::SSLEngine::initialize()
         const int protocols =
                 parseProtocols(properties->getPropertyAsListWithDefault(propPrefix + "Protocols", defaultProtocols));
 
+        //
+        // KernelTLS enables kernel TLS offload for the connections. It's only
+        // used if supported by the kernel and the negotiated cipher, the
+        // connections fall back to user space encryption otherwise.
+        //
+        _kernelTLS = properties->getPropertyAsInt(propPrefix + "KernelTLS") > 0;
+#if !defined(SSL_OP_ENABLE_KTLS) || defined(OPENSSL_NO_KTLS)
+        if(_kernelTLS)
+        {
+            getLogger()->warning("IceSSL: kernel TLS is not supported by this OpenSSL version, ignoring IceSSL.KernelTLS");
+            _kernelTLS = false;
+        }
+#endif
+
+        //
+        // SessionCache.Size sets the maximum number of sessions cached by clients
+        // for resumption, SessionTicketLifetime sets the lifetime in seconds of the
+        // session tickets issued by servers and of the keys used to encrypt them.
+        // SessionTicketKeyFile provides the keys instead, so that the servers which
+        // share the file accept each other's tickets.
+        //
+        int sessionCacheSize = properties->getPropertyAsInt(propPrefix + "SessionCache.Size");
+        int sessionTicketLifetime = properties->getPropertyAsInt(propPrefix + "SessionTicketLifetime");
+        string sessionTicketKeyFile = properties->getProperty(propPrefix + "SessionTicketKeyFile");
+#ifdef ICESSL_SESSION_RESUMPTION
+        _sessionCacheSize = max(sessionCacheSize, 0);
+        _sessionTicketLifetime = max(sessionTicketLifetime, 0);
+        if(!sessionTicketKeyFile.empty())
+        {
+            string resolved;
+            const string defaultDir = properties->getProperty(propPrefix + "DefaultDir");
+            if(!checkPath(sessionTicketKeyFile, defaultDir, false, resolved))
+            {
+                throw PluginInitializationException(__FILE__, __LINE__,
+                                                    "IceSSL: session ticket key file not found:\n" +
+                                                    sessionTicketKeyFile);
+            }
+
+            //
+            // The file contains one or two keys of 80 bytes, each key is made of
+            // the key name (16 bytes), the HMAC key (32 bytes) and the AES key (32
+            // bytes). The first key encrypts the new tickets, the second key is
+            // only used to decrypt tickets, this allows to roll over the keys.
+            //
+            const size_t keySize = 80;
+            vector<char> buffer;
+            readFile(resolved, buffer);
+            if(buffer.size() != keySize && buffer.size() != keySize * 2)
+            {
+                OPENSSL_cleanse(&buffer[0], buffer.size());
+                throw PluginInitializationException(__FILE__, __LINE__,
+                                                    "IceSSL: invalid session ticket key file `" + resolved +
+                                                    "': the file must contain 80 or 160 bytes");
+            }
+            for(size_t i = 0; i < buffer.size() / keySize; ++i)
+            {
+                const char* key = &buffer[i * keySize];
+                memcpy(_ticketKeys[i].name, key, 16);
+                memcpy(_ticketKeys[i].hmacKey, key + 16, 32);
+                memcpy(_ticketKeys[i].aesKey, key + 48, 32);
+            }
+            _previousTicketKey = buffer.size() == keySize * 2;
+            _ticketKeyFile = true;
+            OPENSSL_cleanse(&buffer[0], buffer.size());
+        }
+#else
+        if(sessionCacheSize > 0 || sessionTicketLifetime > 0 || !sessionTicketKeyFile.empty())
+        {
+            getLogger()->warning("IceSSL: TLS session resumption is not supported by this OpenSSL version");
+        }
+#endif
+
         //
         // Create an SSL context if the application hasn't supplied one.
         //
@@ -815,15 +1123,59 @@ OpenSSL::SSLEngine::initialize()
         // error "session id context uninitialized" and the client receives
         // "SSLHandshakeException: Remote host closed connection during handshake".
         //
-        SSL_CTX_set_session_cache_mode(_ctx, SSL_SESS_CACHE_OFF);
+        // The server never caches sessions, resumption relies on session tickets.
+        // Clients store the sessions in our own cache through the new session
+        // callback if IceSSL.SessionCache.Size is set.
+        //
+#ifdef ICESSL_SESSION_RESUMPTION
+        if(_sessionCacheSize > 0)
+        {
+            SSL_CTX_set_session_cache_mode(_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+            SSL_CTX_sess_set_new_cb(_ctx, IceSSL_opensslNewSessionCallback);
+        }
+        else
+#endif
+        {
+            SSL_CTX_set_session_cache_mode(_ctx, SSL_SESS_CACHE_OFF);
+        }
 
         //
-        // Although we disable session caching, we still need to set a session ID
-        // context (ICE-5103). The value can be anything; here we just use the
-        // pointer to this SharedInstance object.
+        // We need to set a session ID context even if session caching is
+        // disabled (ICE-5103). Sessions are only resumed with the same context,
+        // it's the SHA-256 hash of IceSSL.SessionIdContext so that it's the same
+        // for all the processes configured with the same value.
+        //
+        string sessionIdContext = properties->getPropertyWithDefault(propPrefix + "SessionIdContext", "IceSSL");
+        unsigned char sessionIdContextHash[SHA256_DIGEST_LENGTH];
+        SHA256(reinterpret_cast<const unsigned char*>(sessionIdContext.data()), sessionIdContext.size(),
+               sessionIdContextHash);
+        SSL_CTX_set_session_id_context(_ctx, sessionIdContextHash,
+                                       static_cast<unsigned int>(sizeof(sessionIdContextHash)));
+
+#ifdef ICESSL_SESSION_RESUMPTION
         //
-        SSL_CTX_set_session_id_context(_ctx, reinterpret_cast<unsigned char*>(this),
-                                        static_cast<unsigned int>(sizeof(this)));
+        // Encrypt the session tickets with our own keys. The generated keys are
+        // rotated once their lifetime expires, the keys from the key file are
+        // used until the process is restarted.
+        //
+        if(_sessionTicketLifetime > 0 || _ticketKeyFile)
+        {
+            if(!_ticketKeyFile && !generateTicketKey(_ticketKeys[0]))
+            {
+                throw PluginInitializationException(__FILE__, __LINE__,
+                                                    "IceSSL: unable to generate session ticket key:\n" + sslErrors());
+            }
+            if(_sessionTicketLifetime > 0)
+            {
+                SSL_CTX_set_timeout(_ctx, _sessionTicketLifetime);
+            }
+#  if OPENSSL_VERSION_NUMBER >= 0x30000000L
+            SSL_CTX_set_tlsext_ticket_key_evp_cb(_ctx, IceSSL_opensslTicketKeyCallback);
+#  else
+            SSL_CTX_set_tlsext_ticket_key_cb(_ctx, IceSSL_opensslTicketKeyCallback);
+#  endif
+        }
+#endif
 
         //
         // Select protocols.
@@ -863,6 +1215,20 @@ OpenSSL::SSLEngine::initialize()
             SSL_free(ssl);
             getLogger()->trace(securityTraceCategory(), os.str());
         }
+
+        //
+        // HandshakeThreads sets the number of threads of the handshake thread pool.
+        // If not set, the handshakes are performed by the Ice thread pool threads.
+        //
+        int handshakeThreads = properties->getPropertyAsInt(propPrefix + "HandshakeThreads");
+        if(handshakeThreads > 0)
+        {
+#ifdef ICE_USE_IOCP
+            getLogger()->warning("IceSSL: IceSSL.HandshakeThreads is not supported on this platform");
+#else
+            _handshakeThreadPool = new HandshakeThreadPool(handshakeThreads);
+#endif
+        }
     }
     catch(...)
     {
@@ -896,15 +1262,194 @@ OpenSSL::SSLEngine::context() const
     return _ctx;
 }
 
+bool
+OpenSSL::SSLEngine::kernelTLS() const
+{
+    return _kernelTLS;
+}
+
+bool
+OpenSSL::SSLEngine::handshakeThreadPool() const
+{
+    return _handshakeThreadPool;
+}
+
+#ifndef ICE_USE_IOCP
+void
+OpenSSL::SSLEngine::queueHandshake(TransceiverI* transceiver)
+{
+    assert(_handshakeThreadPool);
+    _handshakeThreadPool->queue(transceiver);
+}
+#endif
+
 string
 OpenSSL::SSLEngine::sslErrors() const
 {
     return getSslErrors(securityTraceLevel() >= 1);
 }
 
+#ifdef ICESSL_SESSION_RESUMPTION
+bool
+OpenSSL::SSLEngine::sessionCache() const
+{
+    return _sessionCacheSize > 0;
+}
+
+SSL_SESSION*
+OpenSSL::SSLEngine::getSession(const string& key)
+{
+    IceUtil::Mutex::Lock sync(_sessionMutex);
+    map<string, SessionList::iterator>::iterator p = _sessionMap.find(key);
+    if(p == _sessionMap.end())
+    {
+        return 0;
+    }
+
+    SessionList::iterator q = p->second;
+    SSL_SESSION* session = q->second;
+    if(SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session) < static_cast<long>(time(0)))
+    {
+        SSL_SESSION_free(session);
+        _sessions.erase(q);
+        _sessionMap.erase(p);
+        return 0;
+    }
+
+#  ifdef TLS1_3_VERSION
+    //
+    // TLS 1.3 tickets should only be used once, the server sends new tickets
+    // with each resumed connection.
+    //
+    if(SSL_SESSION_get_protocol_version(session) == TLS1_3_VERSION)
+    {
+        _sessions.erase(q);
+        _sessionMap.erase(p);
+        return session;
+    }
+#  endif
+
+    _sessions.splice(_sessions.begin(), _sessions, q);
+    SSL_SESSION_up_ref(session);
+    return session;
+}
+
+void
+OpenSSL::SSLEngine::addSession(const string& key, SSL_SESSION* session)
+{
+    IceUtil::Mutex::Lock sync(_sessionMutex);
+    map<string, SessionList::iterator>::iterator p = _sessionMap.find(key);
+    if(p != _sessionMap.end())
+    {
+        SSL_SESSION_free(p->second->second);
+        p->second->second = session;
+        _sessions.splice(_sessions.begin(), _sessions, p->second);
+        return;
+    }
+
+    _sessions.push_front(make_pair(key, session));
+    _sessionMap.insert(make_pair(key, _sessions.begin()));
+    if(static_cast<int>(_sessionMap.size()) > _sessionCacheSize)
+    {
+        SSL_SESSION_free(_sessions.back().second);
+        _sessionMap.erase(_sessions.back().first);
+        _sessions.pop_back();
+    }
+}
+
+void
+OpenSSL::SSLEngine::removeSession(const string& key)
+{
+    IceUtil::Mutex::Lock sync(_sessionMutex);
+    map<string, SessionList::iterator>::iterator p = _sessionMap.find(key);
+    if(p != _sessionMap.end())
+    {
+        SSL_SESSION_free(p->second->second);
+        _sessions.erase(p->second);
+        _sessionMap.erase(p);
+    }
+}
+
+int
+OpenSSL::SSLEngine::sessionTicketKey(unsigned char* name, bool encrypt, unsigned char* aesKey,
+                                     unsigned char* hmacKey)
+{
+    IceUtil::Mutex::Lock sync(_sessionMutex);
+
+    //
+    // Rotate the generated keys if the current key expired. The previous key is
+    // kept to decrypt the tickets issued before the rotation.
+    //
+    IceUtil::Time lifetime = IceUtil::Time::seconds(_sessionTicketLifetime);
+    IceUtil::Time age = IceUtil::Time::now(IceUtil::Time::Monotonic) - _ticketKeys[0].created;
+    if(!_ticketKeyFile && age >= lifetime)
+    {
+        SessionTicketKey key;
+        if(!generateTicketKey(key))
+        {
+            return -1;
+        }
+        _ticketKeys[1] = _ticketKeys[0];
+        _ticketKeys[0] = key;
+        _previousTicketKey = age < lifetime * 2;
+        OPENSSL_cleanse(&key, sizeof(key));
+    }
+
+    const SessionTicketKey* key = 0;
+    if(encrypt)
+    {
+        memcpy(name, _ticketKeys[0].name, sizeof(_ticketKeys[0].name));
+        key = &_ticketKeys[0];
+    }
+    else if(memcmp(name, _ticketKeys[0].name, sizeof(_ticketKeys[0].name)) == 0)
+    {
+        key = &_ticketKeys[0];
+    }
+    else if(_previousTicketKey && memcmp(name, _ticketKeys[1].name, sizeof(_ticketKeys[1].name)) == 0)
+    {
+        key = &_ticketKeys[1];
+    }
+    else
+    {
+        return 0; // Unknown or expired key, perform a full handshake.
+    }
+
+    memcpy(aesKey, key->aesKey, sizeof(key->aesKey));
+    memcpy(hmacKey, key->hmacKey, sizeof(key->hmacKey));
+
+    //
+    // Ask OpenSSL to issue a new ticket when a ticket is decrypted, this renews
+    // the tickets encrypted with the previous key and provides a fresh ticket to
+    // TLS 1.3 clients which don't use the same ticket twice.
+    //
+    return encrypt ? 1 : 2;
+}
+#endif
+
 void
 OpenSSL::SSLEngine::destroy()
 {
+#ifndef ICE_USE_IOCP
+    if(_handshakeThreadPool)
+    {
+        _handshakeThreadPool->destroy();
+        _handshakeThreadPool = 0;
+    }
+#endif
+
+#ifdef ICESSL_SESSION_RESUMPTION
+    {
+        IceUtil::Mutex::Lock sync(_sessionMutex);
+        for(SessionList::iterator p = _sessions.begin(); p != _sessions.end(); ++p)
+        {
+            SSL_SESSION_free(p->second);
+        }
+        _sessions.clear();
+        _sessionMap.clear();
+        OPENSSL_cleanse(_ticketKeys, sizeof(_ticketKeys));
+    }
+#endif
+
     if(_ctx)
     {
         SSL_CTX_free(_ctx);
@@ -12,9 +12,14 @@
 
 #include <IceSSL/SSLEngine.h>
 #include <IceSSL/InstanceF.h>
+#include <IceSSL/OpenSSLEngineF.h>
 #include <IceSSL/OpenSSLUtil.h>
 
 #include <Ice/BuiltinSequences.h>
+#include <IceUtil/Time.h>
+
+#include <list>
+#include <map>
 
 namespace IceSSL
 {
@@ -22,6 +27,10 @@ namespace IceSSL
 namespace OpenSSL
 {
 
+class TransceiverI;
+class HandshakeThreadPool;
+typedef IceUtil::Handle<HandshakeThreadPool> HandshakeThreadPoolPtr;
+
 class SSLEngine : public IceSSL::SSLEngine
 {
 public:
@@ -42,6 +51,17 @@ public:
     SSL_CTX* context() const;
     void context(SSL_CTX*);
     std::string sslErrors() const;
+    bool kernelTLS() const;
+    bool handshakeThreadPool() const;
+    void queueHandshake(TransceiverI*);
+
+#ifdef ICESSL_SESSION_RESUMPTION
+    bool sessionCache() const;
+    SSL_SESSION* getSession(const std::string&);
+    void addSession(const std::string&, SSL_SESSION*);
+    void removeSession(const std::string&);
+    int sessionTicketKey(unsigned char*, bool, unsigned char*, unsigned char*);
+#endif
 
 private:
 
@@ -51,6 +71,36 @@ private:
     int parseProtocols(const Ice::StringSeq&) const;
 
     SSL_CTX* _ctx;
+    bool _kernelTLS;
+    HandshakeThreadPoolPtr _handshakeThreadPool;
+
+#ifdef ICESSL_SESSION_RESUMPTION
+    //
+    // Client-side session cache, the sessions are keyed by the host and port
+    // of the server and evicted in least recently used order.
+    //
+    typedef std::list<std::pair<std::string, SSL_SESSION*> > SessionList;
+    IceUtil::Mutex _sessionMutex;
+    int _sessionCacheSize;
+    SessionList _sessions;
+    std::map<std::string, SessionList::iterator> _sessionMap;
+
+    //
+    // Server-side session ticket keys. The current key encrypts the new tickets,
+    // the previous key is still accepted to decrypt tickets until it expires.
+    //
+    struct SessionTicketKey
+    {
+        unsigned char name[16];
+        unsigned char aesKey[32];
+        unsigned char hmacKey[32];
+        IceUtil::Time created;
+    };
+    int _sessionTicketLifetime;
+    SessionTicketKey _ticketKeys[2];
+    bool _previousTicketKey;
+    bool _ticketKeyFile;
+#endif
 
 #ifndef OPENSSL_NO_DH
     IceSSL::OpenSSL::DHParamsPtr _dhParams;
@@ -15,6 +15,14 @@
 
 #include <IceSSL/OpenSSL.h>
 
+//
+// TLS session resumption relies on the session reference counting and
+// accessors introduced with OpenSSL 1.1.0.
+//
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L && !defined(LIBRESSL_VERSION_NUMBER)
+#  define ICESSL_SESSION_RESUMPTION 1
+#endif
+
 namespace IceSSL
 {
 
@@ -146,11 +146,46 @@ OpenSSL::TransceiverI::initialize(IceInternal::Buffer& readBuffer, IceInternal::
         }
         SSL_set_bio(_ssl, bio, bio);
 
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+        //
+        // OpenSSL enables kernel TLS once the handshake completes if the
+        // kernel supports it for the negotiated cipher.
+        //
+        if(_engine->kernelTLS())
+        {
+            SSL_set_options(_ssl, SSL_OP_ENABLE_KTLS);
+        }
+#endif
+
         //
         // Store a pointer to ourself for use in OpenSSL callbacks.
         //
         SSL_set_ex_data(_ssl, 0, this);
 
+#ifdef ICESSL_SESSION_RESUMPTION
+        //
+        // Try to resume the last session established with this server. The
+        // sessions are cached by host and port.
+        //
+        if(!_incoming && _engine->sessionCache())
+        {
+            Ice::IPConnectionInfoPtr info = ICE_DYNAMIC_CAST(Ice::IPConnectionInfo, _delegate->getInfo());
+            if(info)
+            {
+                ostringstream os;
+                os << _host << ':' << info->remotePort;
+                _sessionKey = os.str();
+
+                SSL_SESSION* session = _engine->getSession(_sessionKey);
+                if(session)
+                {
+                    SSL_set_session(_ssl, session);
+                    SSL_SESSION_free(session);
+                }
+            }
+        }
+#endif
+
         //
         // Determine whether a certificate is required from the peer.
         //
@@ -195,10 +230,53 @@ OpenSSL::TransceiverI::initialize(IceInternal::Buffer& readBuffer, IceInternal::
         }
     }
 
+#ifndef ICE_USE_IOCP
+    if(_engine->handshakeThreadPool())
+    {
+        //
+        // The handshake is performed by the handshake thread pool. We suspend the
+        // polling of the socket while a handshake step is running, the thread pool
+        // signals the completion of the step with the read ready status.
+        //
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_handshakeMonitor);
+        switch(_handshakeState)
+        {
+            case HandshakeQueued:
+            case HandshakeRunning:
+            {
+                return IceInternal::SocketOperationRead;
+            }
+            case HandshakeCompleted:
+            {
+                _handshakeState = HandshakeIdle;
+                _delegate->getNativeInfo()->ready(IceInternal::SocketOperationRead, false);
+                if(_handshakeException.get())
+                {
+                    _handshakeException->ice_throw();
+                }
+                return _handshakeOperation;
+            }
+            case HandshakeIdle:
+            {
+                _handshakeState = HandshakeQueued;
+                _delegate->getNativeInfo()->suspend(IceInternal::SocketOperationRead, true);
+                _engine->queueHandshake(this);
+                return IceInternal::SocketOperationRead;
+            }
+        }
+    }
+#endif
+
+    return handshake();
+}
+
+IceInternal::SocketOperation
+OpenSSL::TransceiverI::handshake()
+{
     while(!SSL_is_init_finished(_ssl))
     {
         //
-        // Only one thread calls initialize(), so synchronization is not necessary here.
+        // Only one thread calls handshake(), so synchronization is not necessary here.
         //
 
         //
@@ -298,6 +376,12 @@ OpenSSL::TransceiverI::initialize(IceInternal::Buffer& readBuffer, IceInternal::
             }
             case SSL_ERROR_SSL:
             {
+#ifdef ICESSL_SESSION_RESUMPTION
+                if(!_sessionKey.empty())
+                {
+                    _engine->removeSession(_sessionKey);
+                }
+#endif
                 ostringstream ostr;
                 ostr << "SSL error occurred for new " << (_incoming ? "incoming" : "outgoing")
                      << " connection:\nremote address = " << _delegate->toString() << "\n" << _engine->sslErrors();
@@ -310,6 +394,19 @@ OpenSSL::TransceiverI::initialize(IceInternal::Buffer& readBuffer, IceInternal::
     }
 
     long result = SSL_get_verify_result(_ssl);
+#ifdef ICESSL_SESSION_RESUMPTION
+    _resumed = SSL_session_reused(_ssl) != 0;
+    if(_resumed && result == X509_V_OK)
+    {
+        //
+        // OpenSSL doesn't verify the peer certificates again when a session is
+        // resumed. We verify the certificate chain stored with the session to
+        // initialize the native certs with the verified chain, the trust manager
+        // and the application can then check them as for a full handshake.
+        //
+        result = verifyResumedSession();
+    }
+#endif
     if(result != X509_V_OK)
     {
         if(_engine->getVerifyPeer() == 0)
@@ -343,6 +440,14 @@ OpenSSL::TransceiverI::initialize(IceInternal::Buffer& readBuffer, IceInternal::
     _cipher = SSL_get_cipher_name(_ssl); // Nothing needs to be free'd.
     _engine->verifyPeer(_host, ICE_DYNAMIC_CAST(ConnectionInfo, getInfo()), toString());
 
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+    if(_engine->kernelTLS())
+    {
+        _kernelTLSSend = BIO_get_ktls_send(SSL_get_wbio(_ssl)) > 0;
+        _kernelTLSRecv = BIO_get_ktls_recv(SSL_get_rbio(_ssl)) > 0;
+    }
+#endif
+
     if(_engine->securityTraceLevel() >= 1)
     {
         Trace out(_instance->logger(), _instance->traceCategory());
@@ -363,6 +468,12 @@ OpenSSL::TransceiverI::initialize(IceInternal::Buffer& readBuffer, IceInternal::
             out << "bits = " << SSL_CIPHER_get_bits(cipher, 0) << "\n";
             out << "protocol = " << SSL_get_version(_ssl) << "\n";
         }
+        if(_engine->kernelTLS())
+        {
+            out << "kernel TLS send = " << (_kernelTLSSend ? "enabled" : "disabled") << "\n";
+            out << "kernel TLS receive = " << (_kernelTLSRecv ? "enabled" : "disabled") << "\n";
+        }
+        out << "session resumed = " << (_resumed ? "yes" : "no") << "\n";
         out << IceInternal::fdToString(SSL_get_fd(_ssl));
     }
 
@@ -380,6 +491,21 @@ OpenSSL::TransceiverI::closing(bool initiator, const Ice::LocalException&)
 void
 OpenSSL::TransceiverI::close()
 {
+#ifndef ICE_USE_IOCP
+    {
+        //
+        // Wait for the completion of the handshake step if it's running, a
+        // queued step is canceled.
+        //
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_handshakeMonitor);
+        _handshakeClosed = true;
+        while(_handshakeState == HandshakeRunning)
+        {
+            _handshakeMonitor.wait();
+        }
+    }
+#endif
+
     if(_ssl)
     {
         int err = SSL_shutdown(_ssl);
@@ -430,6 +556,15 @@ OpenSSL::TransceiverI::write(IceInternal::Buffer& buf)
         return IceInternal::SocketOperationNone;
     }
 
+    //
+    // With kernel TLS, the kernel encrypts the data written to the socket
+    // and the message is written with the plain stream socket.
+    //
+    if(_kernelTLSSend)
+    {
+        return _delegate->write(buf);
+    }
+
     //
     // It's impossible for packetSize to be more than an Int.
     //
@@ -568,6 +703,11 @@ OpenSSL::TransceiverI::read(IceInternal::Buffer& buf)
     // necessary to fill the requested data and that the sender sends
     // Ice messages in individual SSL records.
     //
+    // If kernel TLS is enabled for receive, the records are decrypted by
+    // the kernel but they are still read with SSL_read: OpenSSL handles
+    // the TLS control records (alerts, post-handshake messages) that the
+    // plain stream socket can't read.
+    //
 
     if(buf.i == buf.b.end())
     {
@@ -752,6 +892,25 @@ OpenSSL::TransceiverI::finishRead(IceInternal::Buffer& buffer)
         assert(n == static_cast<int>(_readBuffer.b.size()));
     }
 }
+#else
+
+size_t
+OpenSSL::TransceiverI::getGatherWriteSize()
+{
+    //
+    // Gather writes are only supported with kernel TLS, SSL_write
+    // encrypts one buffer at a time.
+    //
+    return _kernelTLSSend ? _delegate->getGatherWriteSize() : 0;
+}
+
+IceInternal::SocketOperation
+OpenSSL::TransceiverI::writev(vector<IceInternal::Buffer*>& bufs)
+{
+    assert(_kernelTLSSend);
+    return _delegate->writev(bufs);
+}
+
 #endif
 
 string
@@ -782,6 +941,7 @@ OpenSSL::TransceiverI::getInfo() const
     info->cipher = _cipher;
     info->certs = _certs;
     info->verified = _verified;
+    info->resumed = _resumed;
     return info;
 }
 
@@ -842,6 +1002,104 @@ OpenSSL::TransceiverI::verifyCallback(int ok, X509_STORE_CTX* c)
     return 1;
 }
 
+#ifdef ICESSL_SESSION_RESUMPTION
+long
+OpenSSL::TransceiverI::verifyResumedSession()
+{
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    X509* peer = SSL_get1_peer_certificate(_ssl);
+#else
+    X509* peer = SSL_get_peer_certificate(_ssl);
+#endif
+    if(!peer)
+    {
+        return X509_V_OK; // The peer didn't provide a certificate.
+    }
+
+    long result = X509_V_ERR_UNSPECIFIED;
+    X509_STORE_CTX* ctx = X509_STORE_CTX_new();
+    if(ctx && X509_STORE_CTX_init(ctx, SSL_CTX_get_cert_store(_engine->context()), peer,
+                                  SSL_get_peer_cert_chain(_ssl)))
+    {
+        X509_STORE_CTX_set_default(ctx, _incoming ? "ssl_client" : "ssl_server");
+        X509_VERIFY_PARAM_set1(X509_STORE_CTX_get0_param(ctx), SSL_get0_param(_ssl));
+        result = X509_verify_cert(ctx) > 0 ? X509_V_OK : X509_STORE_CTX_get_error(ctx);
+
+        STACK_OF(X509)* chain = X509_STORE_CTX_get1_chain(ctx);
+        if(chain != 0)
+        {
+            _certs.clear();
+            for(int i = 0; i < sk_X509_num(chain); ++i)
+            {
+                _certs.push_back(OpenSSL::Certificate::create(X509_dup(sk_X509_value(chain, i))));
+            }
+            sk_X509_pop_free(chain, X509_free);
+        }
+    }
+    X509_STORE_CTX_free(ctx);
+    X509_free(peer);
+    return result;
+}
+#endif
+
+#ifndef ICE_USE_IOCP
+void
+OpenSSL::TransceiverI::runHandshake()
+{
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_handshakeMonitor);
+        if(_handshakeClosed)
+        {
+            _handshakeState = HandshakeIdle;
+            return;
+        }
+        _handshakeState = HandshakeRunning;
+    }
+
+    IceInternal::SocketOperation op = IceInternal::SocketOperationNone;
+    IceInternal::UniquePtr<Ice::LocalException> exception;
+    try
+    {
+        op = handshake();
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        ICE_SET_EXCEPTION_FROM_CLONE(exception, ex.ice_clone());
+    }
+    catch(const std::exception& ex)
+    {
+        SecurityException e(__FILE__, __LINE__);
+        e.reason = string("IceSSL: unexpected exception during handshake:\n") + ex.what();
+        ICE_SET_EXCEPTION_FROM_CLONE(exception, e.ice_clone());
+    }
+
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_handshakeMonitor);
+    _handshakeState = HandshakeCompleted;
+    _handshakeOperation = op;
+    _handshakeException.reset(exception.release());
+    if(!_handshakeClosed)
+    {
+        IceInternal::NativeInfoPtr info = _delegate->getNativeInfo();
+        info->suspend(IceInternal::SocketOperationRead, false);
+        info->ready(IceInternal::SocketOperationRead, true);
+    }
+    _handshakeMonitor.notifyAll();
+}
+#endif
+
+#ifdef ICESSL_SESSION_RESUMPTION
+int
+OpenSSL::TransceiverI::newSession(SSL_SESSION* session)
+{
+    if(_sessionKey.empty())
+    {
+        return 0;
+    }
+    _engine->addSession(_sessionKey, session);
+    return 1; // The engine took ownership of the session.
+}
+#endif
+
 OpenSSL::TransceiverI::TransceiverI(const InstancePtr& instance,
                                     const IceInternal::TransceiverPtr& delegate,
                                     const string& hostOrAdapterName,
@@ -854,7 +1112,15 @@ OpenSSL::TransceiverI::TransceiverI(const InstancePtr& instance,
     _delegate(delegate),
     _connected(false),
     _verified(false),
+    _kernelTLSSend(false),
+    _kernelTLSRecv(false),
+    _resumed(false),
     _ssl(0)
+#ifndef ICE_USE_IOCP
+    , _handshakeState(HandshakeIdle),
+    _handshakeOperation(IceInternal::SocketOperationNone),
+    _handshakeClosed(false)
+#endif
 #ifdef ICE_USE_IOCP
     , _iocpBio(0),
     _sentBytes(0),
@@ -862,6 +1128,12 @@ OpenSSL::TransceiverI::TransceiverI(const InstancePtr& instance,
     _maxRecvPacketSize(0)
 #endif
 {
+#ifndef ICE_USE_IOCP
+    //
+    // OpenSSL reads and writes the socket directly with a socket BIO.
+    //
+    _delegate->getNativeInfo()->disableRingIO();
+#endif
 }
 
 OpenSSL::TransceiverI::~TransceiverI()
@@ -20,9 +20,12 @@
 #include <Ice/Network.h>
 #include <Ice/StreamSocket.h>
 #include <Ice/WSTransceiver.h>
+#include <Ice/UniquePtr.h>
+#include <IceUtil/Monitor.h>
 
 typedef struct ssl_st SSL;
 typedef struct bio_st BIO;
+typedef struct ssl_session_st SSL_SESSION;
 
 namespace IceSSL
 {
@@ -46,6 +49,9 @@ public:
     virtual void finishWrite(IceInternal::Buffer&);
     virtual void startRead(IceInternal::Buffer&);
     virtual void finishRead(IceInternal::Buffer&);
+#else
+    virtual size_t getGatherWriteSize();
+    virtual IceInternal::SocketOperation writev(std::vector<IceInternal::Buffer*>&);
 #endif
     virtual std::string protocol() const;
     virtual std::string toString() const;
@@ -55,6 +61,10 @@ public:
     virtual void setBufferSize(int rcvSize, int sndSize);
 
     int verifyCallback(int , X509_STORE_CTX*);
+    int newSession(SSL_SESSION*);
+#ifndef ICE_USE_IOCP
+    void runHandshake();
+#endif
 
 private:
 
@@ -65,6 +75,10 @@ private:
     bool receive();
     bool send();
 #endif
+    IceInternal::SocketOperation handshake();
+#ifdef ICESSL_SESSION_RESUMPTION
+    long verifyResumedSession();
+#endif
 
     friend class IceSSL::OpenSSL::SSLEngine;
 
@@ -78,6 +92,10 @@ private:
     std::string _cipher;
     std::vector<IceSSL::CertificatePtr> _certs;
     bool _verified;
+    bool _kernelTLSSend;
+    bool _kernelTLSRecv;
+    bool _resumed;
+    std::string _sessionKey;
 
     SSL* _ssl;
 #ifdef ICE_USE_IOCP
@@ -87,6 +105,22 @@ private:
     int _sentBytes;
     size_t _maxSendPacketSize;
     size_t _maxRecvPacketSize; 
+#else
+    //
+    // State of the handshake step performed by the handshake thread pool.
+    //
+    enum HandshakeState
+    {
+        HandshakeIdle,
+        HandshakeQueued,
+        HandshakeRunning,
+        HandshakeCompleted
+    };
+    IceUtil::Monitor<IceUtil::Mutex> _handshakeMonitor;
+    HandshakeState _handshakeState;
+    IceInternal::SocketOperation _handshakeOperation;
+    IceInternal::UniquePtr<Ice::LocalException> _handshakeException;
+    bool _handshakeClosed;
 #endif
 };
 typedef IceUtil::Handle<TransceiverI> TransceiverIPtr;
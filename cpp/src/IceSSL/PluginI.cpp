@@ -11,6 +11,7 @@
 #include <IceSSL/Instance.h>
 #include <IceSSL/SSLEngine.h>
 #include <IceSSL/EndpointI.h>
+#include <IceSSL/TrustManager.h>
 
 #include <Ice/ProtocolPluginFacade.h>
 #include <Ice/ProtocolInstance.h>
@@ -80,11 +81,13 @@ void
 PluginI::initialize()
 {
     _engine->initialize();
+    _engine->getTrustManager()->initialize();
 }
 
 void
 PluginI::destroy()
 {
+    _engine->getTrustManager()->destroy();
     _engine->destroy();
     _engine = 0;
 }
@@ -131,6 +134,12 @@ PluginI::setPasswordPrompt(const PasswordPromptPtr& prompt)
 }
 #endif
 
+void
+PluginI::getTrustCacheStatistics(Ice::Long& hits, Ice::Long& misses) const
+{
+    _engine->getTrustManager()->getCacheStatistics(hits, misses);
+}
+
 extern "C"
 {
 
@@ -41,6 +41,9 @@ public:
 
     virtual CertificatePtr load(const std::string&) const = 0;
     virtual CertificatePtr decode(const std::string&) const = 0;
+
+    virtual void getTrustCacheStatistics(Ice::Long&, Ice::Long&) const;
+
 protected:
 
     SSLEnginePtr _engine;
@@ -746,6 +746,16 @@ SChannel::TransceiverI::initialize(IceInternal::Buffer& readBuffer, IceInternal:
                                 IceUtilInternal::lastErrorToString());
     }
 
+    //
+    // SChannel caches the client sessions, check whether the handshake
+    // reconnected a cached session.
+    //
+    SecPkgContext_SessionInfo sessionInfo;
+    if(QueryContextAttributes(&_ssl, SECPKG_ATTR_SESSION_INFO, &sessionInfo) == SEC_E_OK)
+    {
+        _resumed = (sessionInfo.dwFlags & SSL_SESSION_RECONNECT) != 0;
+    }
+
     _engine->verifyPeer(_host, ICE_DYNAMIC_CAST(ConnectionInfo, getInfo()), toString());
     _state = StateHandshakeComplete;
 
@@ -996,6 +1006,7 @@ SChannel::TransceiverI::getInfo() const
     info->cipher = _cipher;
     info->certs = _certs;
     info->verified = _verified;
+    info->resumed = _resumed;
     return info;
 }
 
@@ -1024,7 +1035,8 @@ SChannel::TransceiverI::TransceiverI(const InstancePtr& instance,
     _bufferedW(0),
     _sslInitialized(false),
     _credentialsInitialized(false),
-    _verified(false)
+    _verified(false),
+    _resumed(false)
 {
 }
 
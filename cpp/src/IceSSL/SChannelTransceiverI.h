@@ -121,6 +121,7 @@ private:
     std::string _cipher;
     std::vector<IceSSL::CertificatePtr> _certs;
     bool _verified;
+    bool _resumed;
 };
 typedef IceUtil::Handle<TransceiverI> TransceiverIPtr;
 
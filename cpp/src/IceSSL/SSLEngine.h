@@ -32,6 +32,7 @@ public:
 
     Ice::CommunicatorPtr communicator() const { return _communicator; }
     Ice::LoggerPtr getLogger() const { return _logger; };
+    TrustManagerPtr getTrustManager() const { return _trustManager; }
 
     void setCertificateVerifier(const CertificateVerifierPtr&);
     void setPasswordPrompt(const PasswordPromptPtr&);
@@ -533,6 +533,7 @@ IceSSL::SecureTransport::TransceiverI::getInfo() const
     info->cipher = _cipher;
     info->certs = _certs;
     info->verified = _verified;
+    info->resumed = false; // No peer ID is set, Secure Transport doesn't resume sessions.
     return info;
 }
 
@@ -17,49 +17,122 @@
 #include <Ice/Logger.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/Network.h>
+#include <Ice/SHA1.h>
 
 using namespace std;
 using namespace IceSSL;
 
 IceUtil::Shared* IceSSL::upCast(IceSSL::TrustManager* p) { return p; }
 
+namespace
+{
+
+#ifndef ICE_CPP11_MAPPING
+class UpdateCallbackI : public Ice::PropertiesAdminUpdateCallback
+{
+public:
+
+    UpdateCallbackI(const TrustManagerPtr& trustManager) : _trustManager(trustManager)
+    {
+    }
+
+    virtual void
+    updated(const Ice::PropertyDict& changes)
+    {
+        _trustManager->updated(changes);
+    }
+
+private:
+
+    const TrustManagerPtr _trustManager;
+};
+#endif
+
+}
+
 TrustManager::TrustManager(const Ice::CommunicatorPtr& communicator) :
-    _communicator(communicator)
+    _communicator(communicator),
+    _cacheSize(static_cast<size_t>(max(communicator->getProperties()->getPropertyAsInt("IceSSL.TrustCache.Size"), 0))),
+    _cacheGeneration(0),
+    _cacheHits(0),
+    _cacheMisses(0)
 {
     Ice::PropertiesPtr properties = communicator->getProperties();
     _traceLevel = properties->getPropertyAsInt("IceSSL.Trace.Security");
-    string key;
-    try
+    load(properties);
+}
+
+void
+TrustManager::initialize()
+{
+    //
+    // Reload the trust rules and flush the cache when the IceSSL.TrustOnly
+    // properties are updated through the Properties admin facet.
+    //
+    Ice::NativePropertiesAdminPtr admin =
+        ICE_DYNAMIC_CAST(Ice::NativePropertiesAdmin, _communicator->findAdminFacet("Properties"));
+    if(admin)
     {
-        key = "IceSSL.TrustOnly";
-        parse(properties->getProperty(key), _rejectAll, _acceptAll);
-        key = "IceSSL.TrustOnly.Client";
-        parse(properties->getProperty(key), _rejectClient, _acceptClient);
-        key = "IceSSL.TrustOnly.Server";
-        parse(properties->getProperty(key), _rejectAllServer, _acceptAllServer);
-        Ice::PropertyDict dict = properties->getPropertiesForPrefix("IceSSL.TrustOnly.Server.");
-        for(Ice::PropertyDict::const_iterator p = dict.begin(); p != dict.end(); ++p)
+#ifdef ICE_CPP11_MAPPING
+        TrustManagerPtr self = this;
+        _removeUpdateCallback = admin->addUpdateCallback([self](const Ice::PropertyDict& changes)
+                                                         {
+                                                             self->updated(changes);
+                                                         });
+#else
+        _propertiesAdmin = admin;
+        _updateCallback = new UpdateCallbackI(this);
+        _propertiesAdmin->addUpdateCallback(_updateCallback);
+#endif
+    }
+}
+
+void
+TrustManager::destroy()
+{
+#ifdef ICE_CPP11_MAPPING
+    if(_removeUpdateCallback)
+    {
+        _removeUpdateCallback();
+        _removeUpdateCallback = nullptr;
+    }
+#else
+    if(_propertiesAdmin)
+    {
+        _propertiesAdmin->removeUpdateCallback(_updateCallback);
+        _propertiesAdmin = 0;
+        _updateCallback = 0;
+    }
+#endif
+}
+
+void
+TrustManager::updated(const Ice::PropertyDict& changes)
+{
+    for(Ice::PropertyDict::const_iterator p = changes.begin(); p != changes.end(); ++p)
+    {
+        if(p->first.find("IceSSL.TrustOnly") == 0)
         {
-            string name = p->first.substr(string("IceSSL.TrustOnly.Server.").size());
-            key = p->first;
-            list<DistinguishedName> reject, accept;
-            parse(p->second, reject, accept);
-            if(!reject.empty())
+            try
             {
-                _rejectServer[name] = reject;
+                load(_communicator->getProperties());
             }
-            if(!accept.empty())
+            catch(const Ice::PluginInitializationException& ex)
             {
-                _acceptServer[name] = accept;
+                Ice::Warning out(_communicator->getLogger());
+                out << "trust manager rules not updated:\n" << ex.reason;
             }
+            return;
         }
     }
-    catch(const ParseException& e)
-    {
-        Ice::PluginInitializationException ex(__FILE__, __LINE__);
-        ex.reason = "IceSSL: invalid property " + key  + ":\n" + e.reason;
-        throw ex;
-    }
+}
+
+void
+TrustManager::getCacheStatistics(Ice::Long& hits, Ice::Long& misses) const
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    hits = _cacheHits;
+    misses = _cacheMisses;
 }
 
 bool
@@ -67,6 +140,8 @@ TrustManager::verify(const ConnectionInfoPtr& info, const std::string& desc)
 {
     list<list<DistinguishedName> > reject, accept;
 
+    IceUtil::Mutex::Lock sync(_mutex);
+
     if(_rejectAll.size() > 0)
     {
         reject.push_back(_rejectAll);
@@ -134,77 +209,131 @@ TrustManager::verify(const ConnectionInfoPtr& info, const std::string& desc)
     //
     if(info->certs.size() != 0)
     {
-        DistinguishedName subject = info->certs[0]->getSubjectDN();
-        if(_traceLevel > 0)
+        //
+        // The rules are evaluated without holding the lock. If they are
+        // updated in the meantime, the cache is flushed and the result
+        // isn't cached.
+        //
+        int generation = _cacheGeneration;
+        sync.release();
+
+        string key;
+        if(_cacheSize > 0)
         {
-            Ice::Trace trace(_communicator->getLogger(), "Security");
-            if(info->incoming)
-            {
-                trace << "trust manager evaluating client:\n" << "subject = " << string(subject) << '\n'
-                      << "adapter = " << info->adapterName << '\n';
-            }
-            else
-            {
-                trace << "trust manager evaluating server:\n" << "subject = " << string(subject) << '\n';
-            }
-            trace << desc;
+            key = cacheKey(info);
         }
 
-        //
-        // Fail if we match anything in the reject set.
-        //
-        for(list<list<DistinguishedName> >::const_iterator p = reject.begin(); p != reject.end(); ++p)
+        if(!key.empty())
         {
-            if(_traceLevel > 1)
+            sync.acquire();
+            map<string, CacheList::iterator>::iterator p = _cacheMap.find(key);
+            if(p != _cacheMap.end())
             {
-                Ice::Trace trace(_communicator->getLogger(), "Security");
-                trace << "trust manager rejecting PDNs:\n";
-                for(list<DistinguishedName>::const_iterator r = p->begin(); r != p->end(); ++r)
+                _cache.splice(_cache.begin(), _cache, p->second);
+                ++_cacheHits;
+                const CacheEntry& entry = *p->second;
+                if(_traceLevel > 0)
                 {
-                    if(r != p->begin())
-                    {
-                        trace << ';';
-                    }
-                    trace << string(*r);
+                    Ice::Trace trace(_communicator->getLogger(), "Security");
+                    trace << "trust manager " << (entry.trusted ? "accepted" : "rejected") << " cached "
+                          << (info->incoming ? "client" : "server") << ":\n" << "subject = "
+                          << string(entry.subject) << '\n';
+                    trace << desc;
                 }
+                return entry.trusted;
             }
-            if(match(*p, subject))
+            ++_cacheMisses;
+            sync.release();
+        }
+
+        DistinguishedName subject = info->certs[0]->getSubjectDN();
+        bool trusted = evaluate(reject, accept, subject, info, desc);
+
+        if(!key.empty())
+        {
+            sync.acquire();
+            if(generation == _cacheGeneration)
             {
-                return false;
+                addCached(key, subject, trusted);
             }
         }
+        return trusted;
+    }
 
-        //
-        // Succeed if we match anything in the accept set.
-        //
-        for(list<list<DistinguishedName> >::const_iterator p = accept.begin(); p != accept.end(); ++p)
+    return false;
+}
+
+bool
+TrustManager::evaluate(const list<list<DistinguishedName> >& reject, const list<list<DistinguishedName> >& accept,
+                       const DistinguishedName& subject, const ConnectionInfoPtr& info, const string& desc) const
+{
+    if(_traceLevel > 0)
+    {
+        Ice::Trace trace(_communicator->getLogger(), "Security");
+        if(info->incoming)
         {
-            if(_traceLevel > 1)
+            trace << "trust manager evaluating client:\n" << "subject = " << string(subject) << '\n'
+                  << "adapter = " << info->adapterName << '\n';
+        }
+        else
+        {
+            trace << "trust manager evaluating server:\n" << "subject = " << string(subject) << '\n';
+        }
+        trace << desc;
+    }
+
+    //
+    // Fail if we match anything in the reject set.
+    //
+    for(list<list<DistinguishedName> >::const_iterator p = reject.begin(); p != reject.end(); ++p)
+    {
+        if(_traceLevel > 1)
+        {
+            Ice::Trace trace(_communicator->getLogger(), "Security");
+            trace << "trust manager rejecting PDNs:\n";
+            for(list<DistinguishedName>::const_iterator r = p->begin(); r != p->end(); ++r)
             {
-                Ice::Trace trace(_communicator->getLogger(), "Security");
-                trace << "trust manager accepting PDNs:\n";
-                for(list<DistinguishedName>::const_iterator r = p->begin(); r != p->end(); ++r)
+                if(r != p->begin())
                 {
-                    if(r != p->begin())
-                    {
-                        trace << ';';
-                    }
-                    trace << string(*r);
+                    trace << ';';
                 }
+                trace << string(*r);
             }
-            if(match(*p, subject))
+        }
+        if(match(*p, subject))
+        {
+            return false;
+        }
+    }
+
+    //
+    // Succeed if we match anything in the accept set.
+    //
+    for(list<list<DistinguishedName> >::const_iterator p = accept.begin(); p != accept.end(); ++p)
+    {
+        if(_traceLevel > 1)
+        {
+            Ice::Trace trace(_communicator->getLogger(), "Security");
+            trace << "trust manager accepting PDNs:\n";
+            for(list<DistinguishedName>::const_iterator r = p->begin(); r != p->end(); ++r)
             {
-                return true;
+                if(r != p->begin())
+                {
+                    trace << ';';
+                }
+                trace << string(*r);
             }
         }
-
-        //
-        // At this point we accept the connection if there are no explicit accept rules.
-        //
-        return accept.empty();
+        if(match(*p, subject))
+        {
+            return true;
+        }
     }
 
-    return false;
+    //
+    // At this point we accept the connection if there are no explicit accept rules.
+    //
+    return accept.empty();
 }
 
 bool
@@ -240,3 +369,114 @@ TrustManager::parse(const string& value, list<DistinguishedName>& reject, list<D
         }
     }
 }
+
+void
+TrustManager::load(const Ice::PropertiesPtr& properties)
+{
+    list<DistinguishedName> rejectAll, rejectClient, rejectAllServer;
+    map<string, list<DistinguishedName> > rejectServer;
+    list<DistinguishedName> acceptAll, acceptClient, acceptAllServer;
+    map<string, list<DistinguishedName> > acceptServer;
+
+    string key;
+    try
+    {
+        key = "IceSSL.TrustOnly";
+        parse(properties->getProperty(key), rejectAll, acceptAll);
+        key = "IceSSL.TrustOnly.Client";
+        parse(properties->getProperty(key), rejectClient, acceptClient);
+        key = "IceSSL.TrustOnly.Server";
+        parse(properties->getProperty(key), rejectAllServer, acceptAllServer);
+        Ice::PropertyDict dict = properties->getPropertiesForPrefix("IceSSL.TrustOnly.Server.");
+        for(Ice::PropertyDict::const_iterator p = dict.begin(); p != dict.end(); ++p)
+        {
+            string name = p->first.substr(string("IceSSL.TrustOnly.Server.").size());
+            key = p->first;
+            list<DistinguishedName> reject, accept;
+            parse(p->second, reject, accept);
+            if(!reject.empty())
+            {
+                rejectServer[name] = reject;
+            }
+            if(!accept.empty())
+            {
+                acceptServer[name] = accept;
+            }
+        }
+    }
+    catch(const ParseException& e)
+    {
+        Ice::PluginInitializationException ex(__FILE__, __LINE__);
+        ex.reason = "IceSSL: invalid property " + key  + ":\n" + e.reason;
+        throw ex;
+    }
+
+    IceUtil::Mutex::Lock sync(_mutex);
+    _rejectAll.swap(rejectAll);
+    _rejectClient.swap(rejectClient);
+    _rejectAllServer.swap(rejectAllServer);
+    _rejectServer.swap(rejectServer);
+    _acceptAll.swap(acceptAll);
+    _acceptClient.swap(acceptClient);
+    _acceptAllServer.swap(acceptAllServer);
+    _acceptServer.swap(acceptServer);
+
+    //
+    // Flush the cached decisions, they were made with the previous rules.
+    //
+    _cache.clear();
+    _cacheMap.clear();
+    ++_cacheGeneration;
+}
+
+string
+TrustManager::cacheKey(const ConnectionInfoPtr& info) const
+{
+    //
+    // The key is the SHA-1 fingerprint of the peer certificate followed by
+    // the connection direction and, for incoming connections, the adapter
+    // name since the IceSSL.TrustOnly.Server.<adapter> rules depend on it.
+    //
+    vector<unsigned char> fingerprint;
+    try
+    {
+        string pem = info->certs[0]->encode();
+        IceInternal::sha1(reinterpret_cast<const unsigned char*>(pem.data()), pem.size(), fingerprint);
+    }
+    catch(const CertificateEncodingException&)
+    {
+        return string();
+    }
+
+    string key(fingerprint.begin(), fingerprint.end());
+    if(info->incoming)
+    {
+        key += 's';
+        key += info->adapterName;
+    }
+    else
+    {
+        key += 'c';
+    }
+    return key;
+}
+
+void
+TrustManager::addCached(const string& key, const DistinguishedName& subject, bool trusted)
+{
+    //
+    // Must be called with _mutex locked.
+    //
+    if(_cacheMap.find(key) != _cacheMap.end())
+    {
+        return;
+    }
+
+    _cache.push_front(CacheEntry(key, subject, trusted));
+    _cacheMap[key] = _cache.begin();
+    while(_cache.size() > _cacheSize)
+    {
+        _cacheMap.erase(_cache.back().key);
+        _cache.pop_back();
+    }
+}
@@ -11,6 +11,9 @@
 #define ICESSL_TRUST_MANAGER_H
 
 #include <Ice/CommunicatorF.h>
+#include <Ice/PropertiesF.h>
+#include <Ice/NativePropertiesAdmin.h>
+#include <IceUtil/Mutex.h>
 #include <IceSSL/TrustManagerF.h>
 #include <IceSSL/Plugin.h>
 #include <IceSSL/RFC2253.h>
@@ -25,16 +28,65 @@ public:
 
     TrustManager(const Ice::CommunicatorPtr&);
 
+    void initialize();
+    void destroy();
+
     bool verify(const ConnectionInfoPtr&, const std::string&);
 
+    //
+    // Called when properties are updated through the Properties admin facet.
+    //
+    void updated(const Ice::PropertyDict&);
+
+    void getCacheStatistics(Ice::Long&, Ice::Long&) const;
+
 private:
 
     bool match(const std::list< DistinguishedName> &, const DistinguishedName&) const;
     void parse(const std::string&, std::list<DistinguishedName>&, std::list<DistinguishedName>&) const;
+    void load(const Ice::PropertiesPtr&);
+
+    bool evaluate(const std::list<std::list<DistinguishedName> >&, const std::list<std::list<DistinguishedName> >&,
+                  const DistinguishedName&, const ConnectionInfoPtr&, const std::string&) const;
+
+    std::string cacheKey(const ConnectionInfoPtr&) const;
+    void addCached(const std::string&, const DistinguishedName&, bool);
 
     const Ice::CommunicatorPtr _communicator;
     int _traceLevel;
 
+    //
+    // The trust decisions are cached by certificate fingerprint, connection
+    // direction and adapter name. The most recently used entry is at the
+    // front of the list.
+    //
+    struct CacheEntry
+    {
+        CacheEntry(const std::string& k, const DistinguishedName& s, bool t) : key(k), subject(s), trusted(t)
+        {
+        }
+
+        std::string key;
+        DistinguishedName subject;
+        bool trusted;
+    };
+    typedef std::list<CacheEntry> CacheList;
+
+    mutable IceUtil::Mutex _mutex;
+    const size_t _cacheSize;
+    int _cacheGeneration;
+    CacheList _cache;
+    std::map<std::string, CacheList::iterator> _cacheMap;
+    Ice::Long _cacheHits;
+    Ice::Long _cacheMisses;
+
+#ifdef ICE_CPP11_MAPPING
+    std::function<void()> _removeUpdateCallback;
+#else
+    Ice::PropertiesAdminUpdateCallbackPtr _updateCallback;
+    Ice::NativePropertiesAdminPtr _propertiesAdmin;
+#endif
+
     std::list<DistinguishedName> _rejectAll;
     std::list<DistinguishedName> _rejectClient;
     std::list<DistinguishedName> _rejectAllServer;
@@ -349,6 +349,7 @@ UWP::TransceiverI::getInfo() const
 {
     ConnectionInfoPtr info = ICE_MAKE_SHARED(ConnectionInfo);
     info->verified = _verified;
+    info->resumed = false; // StreamSocket doesn't report whether the TLS session was resumed.
     info->adapterName = _adapterName;
     info->incoming = _incoming;
     info->underlying = _delegate->getInfo();
@@ -517,6 +517,7 @@ ServiceI::validateProperties(const string& name, const PropertiesPtr& properties
         "TopicManager.Proxy",
         "TopicManager.Proxy.EndpointSelection",
         "TopicManager.Proxy.ConnectionCached",
+        "TopicManager.Proxy.ConnectionStripes",
         "TopicManager.Proxy.PreferSecure",
         "TopicManager.Proxy.LocatorCacheTimeout",
         "TopicManager.Proxy.Locator",
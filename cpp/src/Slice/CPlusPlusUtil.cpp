@@ -1692,6 +1692,8 @@ Slice::findMetaData(const StringList& metaData, int typeCtx)
             // cpp:view-type: is returned
             // If the form is cpp:range[:<...>], cpp:array or cpp:class,
             // the return value is % followed by the string after cpp:.
+            // If the form is cpp:stream, the byte source type of streamed
+            // sequences is returned.
             //
             // The priority of the metadata is as follows:
             // 1: array, range (C++98 only), view-type for "view" parameters
@@ -1719,6 +1721,10 @@ Slice::findMetaData(const StringList& metaData, int typeCtx)
                     return str.substr(pos + 1);
                 }
             }
+            else if(str.substr(prefix.size()) == "stream")
+            {
+                return "::Ice::ByteSourcePtr";
+            }
             else if(typeCtx & (TypeContextInParam | TypeContextAMIPrivateEnd))
             {
                 string ss = str.substr(prefix.size());
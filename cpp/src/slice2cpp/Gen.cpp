@@ -376,12 +376,96 @@ condString(bool ok, const string& str)
     return ok ? str : "";
 }
 
+void
+writeCharSwitch(IceUtilInternal::Output& out, const string& var, const vector<pair<string, string> >& cases)
+{
+    assert(!cases.empty());
+    if(cases.size() == 1)
+    {
+        out << nl << "if(" << var << " == \"" << cases.front().first << "\")";
+        out << sb;
+        out << nl << cases.front().second;
+        out << eb;
+        return;
+    }
+
+    //
+    // All the strings have the same length, switch on the character
+    // position which best distinguishes them.
+    //
+    string::size_type length = cases.front().first.size();
+    string::size_type pos = 0;
+    size_t maxCount = 0;
+    for(string::size_type i = 0; i < length; ++i)
+    {
+        set<char> chars;
+        for(vector<pair<string, string> >::const_iterator p = cases.begin(); p != cases.end(); ++p)
+        {
+            chars.insert(p->first[i]);
+        }
+        if(chars.size() > maxCount)
+        {
+            maxCount = chars.size();
+            pos = i;
+        }
+    }
+    assert(maxCount > 1);
+
+    map<char, vector<pair<string, string> > > groups;
+    for(vector<pair<string, string> >::const_iterator p = cases.begin(); p != cases.end(); ++p)
+    {
+        groups[p->first[pos]].push_back(*p);
+    }
+
+    out << nl << "switch(" << var << '[' << pos << "])";
+    out << sb;
+    for(map<char, vector<pair<string, string> > >::const_iterator p = groups.begin(); p != groups.end(); ++p)
+    {
+        out << nl << "case '" << p->first << "':";
+        out << sb;
+        writeCharSwitch(out, var, p->second);
+        out << nl << "break;";
+        out << eb;
+    }
+    out << eb;
+}
+
+//
+// Writes a switch on the length of the string variable and then on the
+// characters which distinguish the given strings, followed by a single
+// comparison with the candidate string. The statement associated with the
+// matching string is executed, if there's no match the code following the
+// switch is executed.
+//
+void
+writeStringSwitch(IceUtilInternal::Output& out, const string& var, const map<string, string>& cases)
+{
+    map<string::size_type, vector<pair<string, string> > > groups;
+    for(map<string, string>::const_iterator p = cases.begin(); p != cases.end(); ++p)
+    {
+        groups[p->first.size()].push_back(*p);
+    }
+
+    out << nl << "switch(" << var << ".size())";
+    out << sb;
+    for(map<string::size_type, vector<pair<string, string> > >::const_iterator p = groups.begin(); p != groups.end();
+        ++p)
+    {
+        out << nl << "case " << p->first << ':';
+        out << sb;
+        writeCharSwitch(out, var, p->second);
+        out << nl << "break;";
+        out << eb;
+    }
+    out << eb;
+}
+
 }
 
 Slice::Gen::Gen(const string& base, const string& headerExtension, const string& sourceExtension,
                 const vector<string>& extraHeaders, const string& include,
                 const vector<string>& includePaths, const string& dllExport, const string& dir,
-                bool implCpp98, bool implCpp11, bool checksum, bool ice) :
+                bool implCpp98, bool implCpp11, bool checksum, bool ice, bool binarySearchDispatch) :
     _base(base),
     _headerExtension(headerExtension),
     _implHeaderExtension(headerExtension),
@@ -394,7 +478,8 @@ Slice::Gen::Gen(const string& base, const string& headerExtension, const string&
     _implCpp98(implCpp98),
     _implCpp11(implCpp11),
     _checksum(checksum),
-    _ice(ice)
+    _ice(ice),
+    _binarySearchDispatch(binarySearchDispatch)
 {
     for(vector<string>::iterator p = _includePaths.begin(); p != _includePaths.end(); ++p)
     {
@@ -750,7 +835,7 @@ Slice::Gen::generate(const UnitPtr& p)
     {
         normalizeMetaData(p, true);
 
-        Cpp11DeclVisitor declVisitor(H, C, _dllExport);
+        Cpp11DeclVisitor declVisitor(H, C, _dllExport, _binarySearchDispatch);
         p->visit(&declVisitor, false);
 
         Cpp11TypesVisitor typesVisitor(H, C, _dllExport);
@@ -759,7 +844,7 @@ Slice::Gen::generate(const UnitPtr& p)
         Cpp11LocalObjectVisitor localObjectVisitor(H, C, _dllExport);
         p->visit(&localObjectVisitor, false);
 
-        Cpp11InterfaceVisitor interfaceVisitor(H, C, _dllExport);
+        Cpp11InterfaceVisitor interfaceVisitor(H, C, _dllExport, _binarySearchDispatch);
         p->visit(&interfaceVisitor, false);
 
         Cpp11ValueVisitor valueVisitor(H, C, _dllExport);
@@ -837,7 +922,7 @@ Slice::Gen::generate(const UnitPtr& p)
         ProxyVisitor proxyVisitor(H, C, _dllExport);
         p->visit(&proxyVisitor, false);
 
-        ObjectVisitor objectVisitor(H, C, _dllExport);
+        ObjectVisitor objectVisitor(H, C, _dllExport, _binarySearchDispatch);
         p->visit(&objectVisitor, false);
 
         StreamVisitor streamVisitor(H, C, _dllExport);
@@ -1838,6 +1923,234 @@ usePrivateEnd(const OperationPtr& p)
     return retSEnd != retSPrivateEnd || outDeclsEnd != outDeclsPrivateEnd;
 }
 
+bool
+hasArrayMetaData(const StringList& metaData)
+{
+    for(StringList::const_iterator q = metaData.begin(); q != metaData.end(); ++q)
+    {
+        if(q->find("cpp:array") == 0 || q->find("cpp:range") == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+usesProxies(const TypePtr& type)
+{
+    BuiltinPtr builtin = BuiltinPtr::dynamicCast(type);
+    if(builtin)
+    {
+        return builtin->kind() == Builtin::KindObjectProxy;
+    }
+
+    if(ProxyPtr::dynamicCast(type))
+    {
+        return true;
+    }
+
+    SequencePtr seq = SequencePtr::dynamicCast(type);
+    if(seq)
+    {
+        return usesProxies(seq->type());
+    }
+
+    DictionaryPtr dict = DictionaryPtr::dynamicCast(type);
+    if(dict)
+    {
+        return usesProxies(dict->keyType()) || usesProxies(dict->valueType());
+    }
+
+    StructPtr st = StructPtr::dynamicCast(type);
+    if(st)
+    {
+        DataMemberList members = st->dataMembers();
+        for(DataMemberList::const_iterator q = members.begin(); q != members.end(); ++q)
+        {
+            if(usesProxies((*q)->type()))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//
+// Check if the synchronous invocation of the operation can pass its
+// parameters by reference to the servant of a collocated object. The
+// parameters are always marshaled for AMD operations and if the proxy
+// and servant don't use the same C++ types (optionals, cpp:array and
+// cpp:range). Classes and proxies are also marshaled: the servant gets
+// a copy of the graph and unmarshaled proxies don't keep the local
+// settings of the caller's proxies (locator, invocation timeout, ...).
+// With the C++11 mapping, servants returning a marshaled result also
+// use the marshaled path.
+//
+bool
+useDirectParams(const OperationPtr& p, bool cpp11 = false)
+{
+    ClassDefPtr cl = ClassDefPtr::dynamicCast(p->container());
+    if(cl->isLocal() || cl->hasMetaData("amd") || p->hasMetaData("amd"))
+    {
+        return false;
+    }
+
+    if(cpp11 && p->hasMarshaledResult())
+    {
+        return false;
+    }
+
+    TypePtr ret = p->returnType();
+    if(p->returnIsOptional() || p->sendsClasses(true) || p->returnsClasses(true) ||
+       hasArrayMetaData(p->getMetaData()) || (ret && usesProxies(ret)))
+    {
+        return false;
+    }
+
+    ParamDeclList paramList = p->parameters();
+    for(ParamDeclList::const_iterator q = paramList.begin(); q != paramList.end(); ++q)
+    {
+        if((*q)->optional() || hasArrayMetaData((*q)->getMetaData()) || usesProxies((*q)->type()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// Strings, sequences and dictionaries are swapped to avoid copying
+// the results of a direct invocation.
+//
+void
+writeDirectResult(Output& out, const TypePtr& type, const string& target, const string& source)
+{
+    BuiltinPtr builtin = BuiltinPtr::dynamicCast(type);
+    if((builtin && builtin->kind() == Builtin::KindString) || SequencePtr::dynamicCast(type) ||
+       DictionaryPtr::dynamicCast(type))
+    {
+        out << nl << "::std::swap(" << target << ", " << source << ");";
+    }
+    else
+    {
+        out << nl << target << " = " << source << ';';
+    }
+}
+
+//
+// Writes the class holding the parameters of a synchronous invocation:
+// the generated dispatch code passes the in parameters to the servant
+// and stores the results if the request is dispatched directly, see
+// IceInternal::DirectParams.
+//
+void
+writeDirectParamsClass(Output& out, const OperationPtr& p, const ParamDeclList& inParams,
+                       const ParamDeclList& outParams, int typeContext)
+{
+    string directName = "iceDirect" + p->flattenedScope() + p->name();
+    TypePtr ret = p->returnType();
+
+    out << sp << nl << "namespace" << nl << "{";
+    out << sp << nl << "class " << directName << " : public ::IceInternal::DirectParams";
+    out << sb;
+    out.dec();
+    out << nl << "public:";
+    out.inc();
+
+    vector<string> ctorParams;
+    vector<string> initializers;
+    for(ParamDeclList::const_iterator q = inParams.begin(); q != inParams.end(); ++q)
+    {
+        string paramName = fixKwd(paramPrefix + (*q)->name());
+        ctorParams.push_back(inputTypeToString((*q)->type(), false, (*q)->getMetaData(), typeContext) + ' ' +
+                             paramName);
+        initializers.push_back(paramName + "(" + paramName + ")");
+    }
+    for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+    {
+        initializers.push_back(fixKwd(paramPrefix + (*q)->name()) + "()");
+    }
+    if(ret)
+    {
+        initializers.push_back("ret()");
+    }
+
+    out << sp << nl << directName << spar << ctorParams << epar;
+    if(!initializers.empty())
+    {
+        out << " :";
+        out.inc();
+        out << nl;
+        for(vector<string>::const_iterator q = initializers.begin(); q != initializers.end(); ++q)
+        {
+            if(q != initializers.begin())
+            {
+                out << ", ";
+            }
+            out << *q;
+        }
+        out.dec();
+    }
+    out << sb;
+    out << eb;
+
+    out << sp << nl << "virtual void write(::Ice::OutputStream*" << (inParams.empty() ? "" : " ostr") << ") const";
+    out << sb;
+    writeMarshalCode(out, inParams, 0, true, (typeContext & TypeContextCpp11) | TypeContextInParam);
+    out << eb;
+
+    out << sp;
+    for(ParamDeclList::const_iterator q = inParams.begin(); q != inParams.end(); ++q)
+    {
+        out << nl << inputTypeToString((*q)->type(), false, (*q)->getMetaData(), typeContext) << ' '
+            << fixKwd(paramPrefix + (*q)->name()) << ';';
+    }
+    for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+    {
+        out << nl << typeToString((*q)->type(), (*q)->getMetaData(), typeContext) << ' '
+            << fixKwd(paramPrefix + (*q)->name()) << ';';
+    }
+    if(ret)
+    {
+        out << nl << typeToString(ret, p->getMetaData(), typeContext) << " ret;";
+    }
+    out << eb << ';';
+    out << sp << nl << "}";
+}
+
+void
+writeUserExceptionHandlers(Output& out, const OperationPtr& p)
+{
+    out << nl << "try";
+    out << sb;
+    out << nl << "result->throwUserException();";
+    out << eb;
+    //
+    // Generate a catch block for each legal user exception.
+    //
+    ExceptionList throws = p->throws();
+    throws.sort();
+    throws.unique();
+#if defined(__SUNPRO_CC)
+    throws.sort(derivedToBaseCompare);
+#else
+    throws.sort(Slice::DerivedToBaseCompare());
+#endif
+    for(ExceptionList::const_iterator i = throws.begin(); i != throws.end(); ++i)
+    {
+        out << nl << "catch(const " << fixKwd((*i)->scoped()) << "&)";
+        out << sb;
+        out << nl << "throw;";
+        out << eb;
+    }
+    out << nl << "catch(const ::Ice::UserException& ex)";
+    out << sb;
+    out << nl << "throw ::Ice::UnknownUserException(__FILE__, __LINE__, ex.ice_id());";
+    out << eb;
+}
+
 }
 
 void
@@ -1943,6 +2256,8 @@ Slice::Gen::ProxyVisitor::visitOperation(const OperationPtr& p)
 
     string thisPointer = fixKwd(scope.substr(0, scope.size() - 2)) + "*";
 
+    bool direct = useDirectParams(p);
+
     string deprecateSymbol = getDeprecateSymbol(p, cl);
     H << sp << nl << deprecateSymbol << _dllMemberExport << retS << ' ' << fixKwd(name) << spar << paramsDecl
       << "const ::Ice::Context& context = ::Ice::noExplicitContext" << epar;
@@ -1951,8 +2266,15 @@ Slice::Gen::ProxyVisitor::visitOperation(const OperationPtr& p)
     {
         H << "return ";
     }
-    H << "end_" << name << spar << outParamNamesAMI << "_iceI_begin_" + name << spar << argsAMI;
-    H << "context" << "::IceInternal::dummyCallback" << "0" << "true" << epar << epar << ';';
+    if(direct)
+    {
+        H << "_iceI_" << name << spar << args << "context" << epar << ';';
+    }
+    else
+    {
+        H << "end_" << name << spar << outParamNamesAMI << "_iceI_begin_" + name << spar << argsAMI;
+        H << "context" << "::IceInternal::dummyCallback" << "0" << "true" << epar << epar << ';';
+    }
     H << eb;
 
     H << sp << nl << "::Ice::AsyncResultPtr begin_" << name << spar << paramsDeclAMI
@@ -2004,6 +2326,11 @@ Slice::Gen::ProxyVisitor::visitOperation(const OperationPtr& p)
     H << nl;
     H << nl << "private:";
     H.inc();
+    if(direct)
+    {
+        H << sp << nl << _dllMemberExport << retS << " _iceI_" << name << spar << params << "const ::Ice::Context&"
+          << epar << ';';
+    }
     H << sp << nl << _dllMemberExport << "::Ice::AsyncResultPtr _iceI_begin_" << name << spar
       << paramsAMI << "const ::Ice::Context&"
       << "const ::IceInternal::CallbackBasePtr&"
@@ -2014,6 +2341,11 @@ Slice::Gen::ProxyVisitor::visitOperation(const OperationPtr& p)
     H << nl << "public:";
     H.inc();
 
+    if(direct)
+    {
+        writeDirectInvocation(p, inParams, outParams, paramsDecl, argsAMI);
+    }
+
     C << sp << nl << "::Ice::AsyncResultPtr" << nl << "IceProxy" << scope << "_iceI_begin_" << name << spar << paramsDeclAMI
       << "const ::Ice::Context& context" << "const ::IceInternal::CallbackBasePtr& del"
       << "const ::Ice::LocalObjectPtr& cookie" << "bool sync" << epar;
@@ -2066,33 +2398,7 @@ Slice::Gen::ProxyVisitor::visitOperation(const OperationPtr& p)
         writeAllocateCode(C, ParamDeclList(), p, true, _useWstring | TypeContextAMIEnd);
         C << nl << "if(!result->waitForResponse())";
         C << sb;
-        C << nl << "try";
-        C << sb;
-        C << nl << "result->throwUserException();";
-        C << eb;
-        //
-        // Generate a catch block for each legal user exception.
-        //
-        ExceptionList throws = p->throws();
-        throws.sort();
-        throws.unique();
-#if defined(__SUNPRO_CC)
-        throws.sort(derivedToBaseCompare);
-#else
-        throws.sort(Slice::DerivedToBaseCompare());
-#endif
-        for(ExceptionList::const_iterator i = throws.begin(); i != throws.end(); ++i)
-        {
-            string scoped = (*i)->scoped();
-            C << nl << "catch(const " << fixKwd((*i)->scoped()) << "&)";
-            C << sb;
-            C << nl << "throw;";
-            C << eb;
-        }
-        C << nl << "catch(const ::Ice::UserException& ex)";
-        C << sb;
-        C << nl << "throw ::Ice::UnknownUserException(__FILE__, __LINE__, ex.ice_id());";
-        C << eb;
+        writeUserExceptionHandlers(C, p);
         C << eb;
         if(ret || !outParams.empty())
         {
@@ -2129,33 +2435,7 @@ Slice::Gen::ProxyVisitor::visitOperation(const OperationPtr& p)
         C << nl << "::Ice::AsyncResult::check(result, this, " << flatName << ");";
         C << nl << "if(!result->waitForResponse())";
         C << sb;
-        C << nl << "try";
-        C << sb;
-        C << nl << "result->throwUserException();";
-        C << eb;
-        //
-        // Generate a catch block for each legal user exception.
-        //
-        ExceptionList throws = p->throws();
-        throws.sort();
-        throws.unique();
-#if defined(__SUNPRO_CC)
-        throws.sort(derivedToBaseCompare);
-#else
-        throws.sort(Slice::DerivedToBaseCompare());
-#endif
-        for(ExceptionList::const_iterator i = throws.begin(); i != throws.end(); ++i)
-        {
-            string scoped = (*i)->scoped();
-            C << nl << "catch(const " << fixKwd((*i)->scoped()) << "&)";
-            C << sb;
-            C << nl << "throw;";
-            C << eb;
-        }
-        C << nl << "catch(const ::Ice::UserException& ex)";
-        C << sb;
-        C << nl << "throw ::Ice::UnknownUserException(__FILE__, __LINE__, ex.ice_id());";
-        C << eb;
+        writeUserExceptionHandlers(C, p);
         C << eb;
 
         if(ret || !outParams.empty())
@@ -2176,6 +2456,88 @@ Slice::Gen::ProxyVisitor::visitOperation(const OperationPtr& p)
     }
 }
 
+void
+Slice::Gen::ProxyVisitor::writeDirectInvocation(const OperationPtr& p, const ParamDeclList& inParams,
+                                                const ParamDeclList& outParams, const vector<string>& paramsDecl,
+                                                const vector<string>& inArgs)
+{
+    string name = p->name();
+    string flatName = "iceC" + p->flattenedScope() + p->name() + "_name";
+    string directName = "iceDirect" + p->flattenedScope() + p->name();
+    string scope = fixKwd(p->scope());
+    TypePtr ret = p->returnType();
+    string retS = returnTypeToString(ret, false, p->getMetaData(), _useWstring | TypeContextAMIEnd);
+
+    writeDirectParamsClass(C, p, inParams, outParams, _useWstring);
+
+    C << sp << nl << retS << nl << "IceProxy" << scope << "_iceI_" << name << spar << paramsDecl
+      << "const ::Ice::Context& context" << epar;
+    C << sb;
+    if(p->returnsData())
+    {
+        C << nl << "_checkTwowayOnly(" << flatName << ", true);";
+    }
+    C << nl << directName << " direct";
+    if(!inArgs.empty())
+    {
+        C << spar << inArgs << epar;
+    }
+    C << ';';
+    C << nl << "::IceInternal::OutgoingAsyncPtr result = new ::IceInternal::CallbackOutgoing(this, " << flatName
+      << ", ::IceInternal::dummyCallback, 0, true);";
+    C << nl << "try";
+    C << sb;
+    C << nl << "result->prepare(" << flatName << ", " << operationModeToString(p->sendMode()) << ", context);";
+    C << nl << "result->invoke(" << flatName << ", direct);";
+    C << eb;
+    C << nl << "catch(const ::Ice::Exception& ex)";
+    C << sb;
+    C << nl << "result->abort(ex);";
+    C << eb;
+    if(p->returnsData())
+    {
+        writeAllocateCode(C, ParamDeclList(), p, true, _useWstring | TypeContextAMIEnd);
+        C << nl << "if(!result->waitForResponse())";
+        C << sb;
+        writeUserExceptionHandlers(C, p);
+        C << eb;
+        if(ret || !outParams.empty())
+        {
+            C << nl << "if(direct.isCompleted())";
+            C << sb;
+            for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+            {
+                string paramName = fixKwd(paramPrefix + (*q)->name());
+                writeDirectResult(C, (*q)->type(), paramName, "direct." + paramName);
+            }
+            if(ret)
+            {
+                writeDirectResult(C, ret, "ret", "direct.ret");
+            }
+            C << eb;
+            C << nl << "else";
+            C << sb;
+            C << nl << "::Ice::InputStream* istr = result->startReadParams();";
+            writeUnmarshalCode(C, outParams, p, true, _useWstring | TypeContextAMIEnd);
+            C << nl << "result->endReadParams();";
+            C << eb;
+        }
+        else
+        {
+            C << nl << "result->readEmptyParams();";
+        }
+        if(ret)
+        {
+            C << nl << "return ret;";
+        }
+    }
+    else
+    {
+        C << nl << "_end(result, " << flatName << ");";
+    }
+    C << eb;
+}
+
 Slice::Gen::ObjectDeclVisitor::ObjectDeclVisitor(Output& h, Output& c, const string& dllExport) :
     H(h), C(c), _dllExport(dllExport)
 {
@@ -2245,8 +2607,9 @@ Slice::Gen::ObjectDeclVisitor::visitOperation(const OperationPtr& p)
     }
 }
 
-Slice::Gen::ObjectVisitor::ObjectVisitor(Output& h, Output& c, const string& dllExport) :
-    H(h), C(c), _dllExport(dllExport), _doneStaticSymbol(false), _useWstring(false)
+Slice::Gen::ObjectVisitor::ObjectVisitor(Output& h, Output& c, const string& dllExport, bool binarySearchDispatch) :
+    H(h), C(c), _dllExport(dllExport), _doneStaticSymbol(false), _useWstring(false),
+    _binarySearchDispatch(binarySearchDispatch)
 {
 }
 
@@ -2490,7 +2853,20 @@ Slice::Gen::ObjectVisitor::visitClassDefStart(const ClassDefPtr& p)
         C << nl << "bool" << nl << scoped.substr(2)
           << "::ice_isA(const ::std::string& s, const ::Ice::Current&) const";
         C << sb;
-        C << nl << "return ::std::binary_search(" << flatName << ", " << flatName << " + " << ids.size() << ", s);";
+        if(_binarySearchDispatch)
+        {
+            C << nl << "return ::std::binary_search(" << flatName << ", " << flatName << " + " << ids.size() << ", s);";
+        }
+        else
+        {
+            map<string, string> cases;
+            for(StringList::const_iterator r = ids.begin(); r != ids.end(); ++r)
+            {
+                cases[*r] = "return true;";
+            }
+            writeStringSwitch(C, "s", cases);
+            C << nl << "return false;";
+        }
         C << eb;
 
         C << sp;
@@ -2573,52 +2949,69 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
             H << nl << "virtual bool _iceDispatch(::IceInternal::Incoming&, const ::Ice::Current&);";
 
             string flatName = "iceC" + p->flattenedScope() + p->name() + "_all";
-            C << sp << nl << "namespace";
-            C << nl << "{";
-            C << nl << "const ::std::string " << flatName << "[] =";
-            C << sb;
-
-            for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
+            if(_binarySearchDispatch)
             {
-                C << nl << '"' << *q << '"';
-                if(++q != allOpNames.end())
+                C << sp << nl << "namespace";
+                C << nl << "{";
+                C << nl << "const ::std::string " << flatName << "[] =";
+                C << sb;
+
+                for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
                 {
-                    C << ',';
+                    C << nl << '"' << *q << '"';
+                    if(++q != allOpNames.end())
+                    {
+                        C << ',';
+                    }
                 }
+                C << eb << ';';
+                C << sp << nl << "}";
             }
-            C << eb << ';';
-            C << sp << nl << "}";
             C << sp;
             C << nl << "bool";
             C << nl << scoped.substr(2) << "::_iceDispatch(::IceInternal::Incoming& in, const ::Ice::Current& current)";
             C << sb;
 
-            C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-              << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
-              << ", current.operation);";
-            C << nl << "if(r.first == r.second)";
-            C << sb;
-            C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, "
-              << "current.facet, current.operation);";
-            C << eb;
-            C << sp;
-            C << nl << "switch(r.first - " << flatName << ')';
-            C << sb;
-            int i = 0;
-            for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
+            if(_binarySearchDispatch)
             {
-                C << nl << "case " << i++ << ':';
+                C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
+                  << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
+                  << ", current.operation);";
+                C << nl << "if(r.first == r.second)";
                 C << sb;
-                C << nl << "return _iceD_" << *q << "(in, current);";
+                C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, "
+                  << "current.facet, current.operation);";
+                C << eb;
+                C << sp;
+                C << nl << "switch(r.first - " << flatName << ')';
+                C << sb;
+                int i = 0;
+                for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
+                {
+                    C << nl << "case " << i++ << ':';
+                    C << sb;
+                    C << nl << "return _iceD_" << *q << "(in, current);";
+                    C << eb;
+                }
+                C << nl << "default:";
+                C << sb;
+                C << nl << "assert(false);";
+                C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, "
+                  << "current.facet, current.operation);";
+                C << eb;
                 C << eb;
             }
-            C << nl << "default:";
-            C << sb;
-            C << nl << "assert(false);";
-            C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, "
-              << "current.facet, current.operation);";
-            C << eb;
-            C << eb;
+            else
+            {
+                map<string, string> cases;
+                for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
+                {
+                    cases[*q] = "return _iceD_" + *q + "(in, current);";
+                }
+                writeStringSwitch(C, "current.operation", cases);
+                C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, "
+                  << "current.facet, current.operation);";
+            }
             C << eb;
 
             //
@@ -2642,31 +3035,34 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
 
                 string opAttrFlatName = "iceC" + p->flattenedScope() + p->name() + "_operationAttributes";
 
-                C << sp << nl << "namespace";
-                C << nl << "{";
-                C << nl << "const int " << opAttrFlatName << "[] = ";
-                C << sb;
-
-                for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
+                if(_binarySearchDispatch)
                 {
-                    int attributes = 0;
-                    string opName = *q;
-                    map<string, int>::iterator it = attributesMap.find(opName);
-                    if(it != attributesMap.end())
-                    {
-                        attributes = it->second;
-                    }
-                    C << nl << attributes;
+                    C << sp << nl << "namespace";
+                    C << nl << "{";
+                    C << nl << "const int " << opAttrFlatName << "[] = ";
+                    C << sb;
 
-                    if(++q != allOpNames.end())
+                    for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
                     {
-                        C << ',';
+                        int attributes = 0;
+                        string opName = *q;
+                        map<string, int>::iterator it = attributesMap.find(opName);
+                        if(it != attributesMap.end())
+                        {
+                            attributes = it->second;
+                        }
+                        C << nl << attributes;
+
+                        if(++q != allOpNames.end())
+                        {
+                            C << ',';
+                        }
+                        C << " // " << opName;
                     }
-                    C << " // " << opName;
-                }
 
-                C << eb << ';';
-                C << sp << nl << "}";
+                    C << eb << ';';
+                    C << sp << nl << "}";
+                }
 
                 C << sp;
 
@@ -2674,15 +3070,31 @@ Slice::Gen::ObjectVisitor::visitClassDefEnd(const ClassDefPtr& p)
                   << "::ice_operationAttributes(const ::std::string& opName) const";
                 C << sb;
 
-                C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-                  << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
-                  << ", opName);";
-                C << nl << "if(r.first == r.second)";
-                C << sb;
-                C << nl << "return -1;";
-                C << eb;
+                if(_binarySearchDispatch)
+                {
+                    C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
+                      << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
+                      << ", opName);";
+                    C << nl << "if(r.first == r.second)";
+                    C << sb;
+                    C << nl << "return -1;";
+                    C << eb;
 
-                C << nl << "return " << opAttrFlatName << "[r.first - " << flatName << "];";
+                    C << nl << "return " << opAttrFlatName << "[r.first - " << flatName << "];";
+                }
+                else
+                {
+                    map<string, string> cases;
+                    for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
+                    {
+                        map<string, int>::iterator it = attributesMap.find(*q);
+                        ostringstream os;
+                        os << "return " << (it != attributesMap.end() ? it->second : 0) << ';';
+                        cases[*q] = os.str();
+                    }
+                    writeStringSwitch(C, "opName", cases);
+                    C << nl << "return -1;";
+                }
                 C << eb;
             }
         }
@@ -3038,6 +3450,46 @@ Slice::Gen::ObjectVisitor::visitOperation(const OperationPtr& p)
         C << sb;
         C << nl << "_iceCheckMode(" << operationModeToString(p->mode()) << ", current.mode);";
 
+        if(useDirectParams(p))
+        {
+            //
+            // Collocated request dispatched from the invoking thread, the
+            // parameters aren't marshaled.
+            //
+            string directName = "iceDirect" + p->flattenedScope() + p->name();
+            string directArgs = "(";
+            for(ParamDeclList::const_iterator q = paramList.begin(); q != paramList.end(); ++q)
+            {
+                string param = fixKwd(string(paramPrefix) + (*q)->name());
+                directArgs += ((*q)->isOutParam() ? param : "direct->" + param) + ", ";
+            }
+            directArgs += "current)";
+
+            C << nl << directName << "* direct = dynamic_cast<" << directName << "*>(inS.getDirectParams());";
+            C << nl << "if(direct)";
+            C << sb;
+            writeAllocateCode(C, outParams, 0, true, _useWstring, "ret");
+            C << nl;
+            if(ret)
+            {
+                C << retS << " ret = ";
+            }
+            C << "this->" << fixKwd(name) << directArgs << ';';
+            for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+            {
+                string param = fixKwd(string(paramPrefix) + (*q)->name());
+                writeDirectResult(C, (*q)->type(), "direct->" + param, param);
+            }
+            if(ret)
+            {
+                writeDirectResult(C, ret, "direct->ret", "ret");
+            }
+            C << nl << "direct->completed();";
+            C << nl << "inS.writeEmptyParams();";
+            C << nl << "return false;";
+            C << eb;
+        }
+
         if(!inParams.empty())
         {
             C << nl << "::Ice::InputStream* istr = inS.startReadParams();";
@@ -4671,7 +5123,7 @@ Slice::Gen::MetaDataVisitor::visitOperation(const OperationPtr& p)
         {
             string s = *q++;
             if(s.find("cpp:type:") == 0 || s.find("cpp:view-type:") == 0 ||
-               s.find("cpp:range") == 0 || s == "cpp:array")
+               s.find("cpp:range") == 0 || s == "cpp:array" || s == "cpp:stream")
             {
                 dc->warning(InvalidMetaData, p->file(), p->line(),
                             "ignoring invalid metadata `" + s + "' for operation with void return type");
@@ -4693,6 +5145,48 @@ Slice::Gen::MetaDataVisitor::visitOperation(const OperationPtr& p)
         metaData = validate((*q)->type(), (*q)->getMetaData(), p->file(), (*q)->line(), true);
         (*q)->setMetaData(metaData);
     }
+
+    //
+    // A request or reply carries at most one streamed sequence, the
+    // streamed sequences of local and optional parameters are ignored.
+    //
+    bool inStream = false;
+    bool outStream = false;
+    if(returnType && p->hasMetaData("cpp:stream"))
+    {
+        if(cl->isLocal() || p->returnIsOptional())
+        {
+            dc->warning(InvalidMetaData, p->file(), p->line(), "ignoring metadata `cpp:stream' for " +
+                        string(cl->isLocal() ? "local operation" : "optional return value"));
+            metaData = p->getMetaData();
+            metaData.remove("cpp:stream");
+            p->setMetaData(metaData);
+        }
+        else
+        {
+            outStream = true;
+        }
+    }
+    for(ParamDeclList::iterator q = params.begin(); q != params.end(); ++q)
+    {
+        if((*q)->hasMetaData("cpp:stream"))
+        {
+            bool& streamed = (*q)->isOutParam() ? outStream : inStream;
+            if(cl->isLocal() || (*q)->optional() || streamed)
+            {
+                dc->warning(InvalidMetaData, p->file(), (*q)->line(), "ignoring metadata `cpp:stream' for " +
+                            string(cl->isLocal() ? "local operation" :
+                                   ((*q)->optional() ? "optional parameter" : "second streamed parameter")));
+                metaData = (*q)->getMetaData();
+                metaData.remove("cpp:stream");
+                (*q)->setMetaData(metaData);
+            }
+            else
+            {
+                streamed = true;
+            }
+        }
+    }
 }
 
 void
@@ -4797,6 +5291,15 @@ Slice::Gen::MetaDataVisitor::validate(const SyntaxTreeBasePtr& cont, const Strin
                 {
                     continue;
                 }
+
+                //
+                // Only byte sequence parameters can be streamed.
+                //
+                BuiltinPtr builtin = BuiltinPtr::dynamicCast(SequencePtr::dynamicCast(cont)->type());
+                if(operation && ss == "stream" && builtin && builtin->kind() == Builtin::KindByte)
+                {
+                    continue;
+                }
             }
             if(DictionaryPtr::dynamicCast(cont) && (ss.find("type:") == 0 || ss.find("view-type:") == 0))
             {
@@ -5000,6 +5503,7 @@ Slice::Gen::NormalizeMetaDataVisitor::normalize(const StringList& metaData)
         "ice_print",
         "range",
         "scoped",
+        "stream",
         "type:",
         "unscoped",
         "view-type:",
@@ -5157,8 +5661,9 @@ Slice::Gen::getSourceExt(const string& file, const UnitPtr& unit)
 }
 
 // C++11 visitors
-Slice::Gen::Cpp11DeclVisitor::Cpp11DeclVisitor(Output& h, Output& c, const string& dllExport) :
-    H(h), C(c), _dllExport(dllExport)
+Slice::Gen::Cpp11DeclVisitor::Cpp11DeclVisitor(Output& h, Output& c, const string& dllExport,
+                                               bool binarySearchDispatch) :
+    H(h), C(c), _dllExport(dllExport), _binarySearchDispatch(binarySearchDispatch)
 {
 }
 
@@ -5263,26 +5768,30 @@ Slice::Gen::Cpp11DeclVisitor::visitClassDefStart(const ClassDefPtr& p)
         }
         C << eb << ';';
 
-        StringList allOpNames;
-        transform(allOps.begin(), allOps.end(), back_inserter(allOpNames), ::IceUtil::constMemFun(&Contained::name));
-        allOpNames.push_back("ice_id");
-        allOpNames.push_back("ice_ids");
-        allOpNames.push_back("ice_isA");
-        allOpNames.push_back("ice_ping");
-        allOpNames.sort();
-        allOpNames.unique();
-
-        C << nl << "const ::std::string iceC" << p->flattenedScope() << p->name() << "_ops[] =";
-        C << sb;
-        for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
+        if(_binarySearchDispatch)
         {
-            C << nl << '"' << *q << '"';
-            if(++q != allOpNames.end())
+            StringList allOpNames;
+            transform(allOps.begin(), allOps.end(), back_inserter(allOpNames),
+                      ::IceUtil::constMemFun(&Contained::name));
+            allOpNames.push_back("ice_id");
+            allOpNames.push_back("ice_ids");
+            allOpNames.push_back("ice_isA");
+            allOpNames.push_back("ice_ping");
+            allOpNames.sort();
+            allOpNames.unique();
+
+            C << nl << "const ::std::string iceC" << p->flattenedScope() << p->name() << "_ops[] =";
+            C << sb;
+            for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end();)
             {
-                C << ',';
+                C << nl << '"' << *q << '"';
+                if(++q != allOpNames.end())
+                {
+                    C << ',';
+                }
             }
+            C << eb << ';';
         }
-        C << eb << ';';
     }
 
     return true;
@@ -5932,50 +6441,65 @@ Slice::Gen::Cpp11ProxyVisitor::visitOperation(const OperationPtr& p)
 
     string deprecateSymbol = getDeprecateSymbol(p, cl);
 
+    bool direct = useDirectParams(p, true);
+
     //
     // Synchronous operation
     //
-    H << sp << nl << deprecateSymbol << retS << ' ' << fixKwd(name) << spar << paramsDecl;
-    H << "const ::Ice::Context& context = Ice::noExplicitContext" << epar;
-    H << sb;
-    H << nl;
-    if(futureOutParams.size() == 1)
+    if(direct)
     {
-        if(ret)
+        //
+        // Implemented in the .cpp file with the parameters passed by
+        // reference to the servant of a collocated object.
+        //
+        H << sp << nl << deprecateSymbol << _dllMemberExport << retS << ' ' << fixKwd(name) << spar << paramsDecl;
+        H << "const ::Ice::Context& context = Ice::noExplicitContext" << epar << ';';
+        writeDirectInvocation(p, inParams, outParams, paramsDecl, futureT, returnValueS);
+    }
+    else
+    {
+        H << sp << nl << deprecateSymbol << retS << ' ' << fixKwd(name) << spar << paramsDecl;
+        H << "const ::Ice::Context& context = Ice::noExplicitContext" << epar;
+        H << sb;
+        H << nl;
+        if(futureOutParams.size() == 1)
         {
-            H << "return ";
+            if(ret)
+            {
+                H << "return ";
+            }
+            else
+            {
+                H << paramPrefix << (*outParams.begin())->name() << " = ";
+            }
         }
-        else
+        else if(futureOutParams.size() > 1)
         {
-            H << paramPrefix << (*outParams.begin())->name() << " = ";
+            H << "auto result = ";
         }
-    }
-    else if(futureOutParams.size() > 1)
-    {
-        H << "auto result = ";
-    }
 
-    H << "_makePromiseOutgoing<" << futureT << ">";
+        H << "_makePromiseOutgoing<" << futureT << ">";
 
-    H << spar << "true, this" << string("&" + scoped + "_iceI_" + name);
-    for(ParamDeclList::const_iterator q = inParams.begin(); q != inParams.end(); ++q)
-    {
-        H << fixKwd(paramPrefix + (*q)->name());
-    }
-    H << "context" << epar << ".get();";
-    if(futureOutParams.size() > 1)
-    {
-        for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+        H << spar << "true, this" << string("&" + scoped + "_iceI_" + name);
+        for(ParamDeclList::const_iterator q = inParams.begin(); q != inParams.end(); ++q)
         {
-            H << nl << paramPrefix << (*q)->name() << " = ";
-            H << condMove(isMovable((*q)->type()), "result." + fixKwd((*q)->name())) + ";";
+            H << fixKwd(paramPrefix + (*q)->name());
         }
-        if(ret)
+        H << "context" << epar << ".get();";
+        if(futureOutParams.size() > 1)
         {
-            H << nl << "return " + condMove(isMovable(ret), "result." + returnValueS) + ";";
+            for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+            {
+                H << nl << paramPrefix << (*q)->name() << " = ";
+                H << condMove(isMovable((*q)->type()), "result." + fixKwd((*q)->name())) + ";";
+            }
+            if(ret)
+            {
+                H << nl << "return " + condMove(isMovable(ret), "result." + returnValueS) + ";";
+            }
         }
+        H << eb;
     }
-    H << eb;
 
     //
     // Promise based asynchronous operation
@@ -6254,6 +6778,125 @@ Slice::Gen::Cpp11ProxyVisitor::visitOperation(const OperationPtr& p)
     C << ");" << eb;
 }
 
+void
+Slice::Gen::Cpp11ProxyVisitor::writeDirectInvocation(const OperationPtr& p, const ParamDeclList& inParams,
+                                                     const ParamDeclList& outParams, const vector<string>& paramsDecl,
+                                                     const string& futureT, const string& returnValueS)
+{
+    string name = p->name();
+    string flatName = "iceC" + p->flattenedScope() + p->name() + "_name";
+    string directName = "iceDirect" + p->flattenedScope() + p->name();
+    ClassDefPtr cl = ClassDefPtr::dynamicCast(p->container());
+    string scoped = fixKwd(cl->scope() + cl->name() + "Prx" + "::").substr(2);
+    TypePtr ret = p->returnType();
+    string retS = returnTypeToString(ret, false, p->getMetaData(), _useWstring | TypeContextCpp11);
+    size_t results = outParams.size() + (ret ? 1 : 0);
+
+    //
+    // The DirectParams class is generated with the dispatch code, see
+    // Cpp11InterfaceVisitor::visitOperation.
+    //
+    C << sp << nl << retS << nl << scoped << fixKwd(name) << spar << paramsDecl << "const ::Ice::Context& context"
+      << epar;
+    C << sb;
+    if(p->returnsData())
+    {
+        C << nl << "_checkTwowayOnly(" << flatName << ");";
+    }
+    C << nl << directName << " direct";
+    if(!inParams.empty())
+    {
+        C << spar;
+        for(ParamDeclList::const_iterator q = inParams.begin(); q != inParams.end(); ++q)
+        {
+            C << fixKwd(paramPrefix + (*q)->name());
+        }
+        C << epar;
+    }
+    C << ';';
+    C << nl << "auto outAsync = ::std::make_shared<::IceInternal::PromiseOutgoing<::std::promise<" << futureT << ">, "
+      << futureT << ">>(shared_from_this(), true);";
+    C << nl << "outAsync->invoke(" << flatName << ", ";
+    C << operationModeToString(p->sendMode(), true) << ", " << opFormatTypeToString(p, true) << ", context, direct,";
+    C.inc();
+    C << nl;
+    throwUserExceptionLambda(C, p->throws());
+    if(results > 0)
+    {
+        //
+        // The results are moved from the direct parameters if the servant
+        // was called directly, otherwise they're unmarshaled.
+        //
+        C << "," << nl << "[&direct](::Ice::InputStream* istr)";
+        C << sb;
+        C << nl << "if(direct.isCompleted())";
+        C << sb;
+        if(results > 1)
+        {
+            C << nl << futureT << " v;";
+            for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+            {
+                C << nl << "v." << fixKwd((*q)->name()) << " = "
+                  << condMove(isMovable((*q)->type()), "direct." + fixKwd(paramPrefix + (*q)->name())) << ';';
+            }
+            if(ret)
+            {
+                C << nl << "v." << returnValueS << " = " << condMove(isMovable(ret), "direct.ret") << ';';
+            }
+            C << nl << "return v;";
+        }
+        else if(ret)
+        {
+            C << nl << "return " << condMove(isMovable(ret), "direct.ret") << ';';
+        }
+        else
+        {
+            C << nl << "return " << condMove(isMovable(outParams.front()->type()),
+                                             "direct." + fixKwd(paramPrefix + outParams.front()->name())) << ';';
+        }
+        C << eb;
+        if(results > 1)
+        {
+            C << nl << futureT << " v;";
+            writeUnmarshalCode(C, outParams, p, false, _useWstring | TypeContextCpp11, "", returnValueS, "v");
+            C << nl << "return v;";
+        }
+        else
+        {
+            writeAllocateCode(C, outParams, p, true, _useWstring | TypeContextCpp11);
+            writeUnmarshalCode(C, outParams, p, true, _useWstring | TypeContextCpp11);
+            C << nl << "return " << (ret ? string("ret") : fixKwd(paramPrefix + outParams.front()->name())) << ';';
+        }
+        C << eb;
+    }
+    C.dec();
+    C << ");";
+
+    if(results == 0)
+    {
+        C << nl << "outAsync->getFuture().get();";
+    }
+    else if(results == 1)
+    {
+        C << nl << (ret ? string("return ") : fixKwd(paramPrefix + outParams.front()->name()) + " = ")
+          << "outAsync->getFuture().get();";
+    }
+    else
+    {
+        C << nl << "auto result = outAsync->getFuture().get();";
+        for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+        {
+            C << nl << fixKwd(paramPrefix + (*q)->name()) << " = "
+              << condMove(isMovable((*q)->type()), "result." + fixKwd((*q)->name())) << ';';
+        }
+        if(ret)
+        {
+            C << nl << "return " << condMove(isMovable(ret), "result." + returnValueS) << ';';
+        }
+    }
+    C << eb;
+}
+
 void
 Slice::Gen::Cpp11TypesVisitor::visitEnum(const EnumPtr& p)
 {
@@ -6723,8 +7366,10 @@ Slice::Gen::Cpp11LocalObjectVisitor::visitOperation(const OperationPtr& p)
 
 Slice::Gen::Cpp11InterfaceVisitor::Cpp11InterfaceVisitor(::IceUtilInternal::Output& h,
                                                          ::IceUtilInternal::Output& c,
-                                                         const std::string& dllExport) :
-    Cpp11ObjectVisitor(h, c, dllExport)
+                                                         const std::string& dllExport,
+                                                         bool binarySearchDispatch) :
+    Cpp11ObjectVisitor(h, c, dllExport),
+    _binarySearchDispatch(binarySearchDispatch)
 {
 }
 
@@ -6837,7 +7482,20 @@ Slice::Gen::Cpp11InterfaceVisitor::visitClassDefStart(const ClassDefPtr& p)
     C << sp;
     C << nl << "bool" << nl << scoped.substr(2) << "::ice_isA(::std::string s, const ::Ice::Current&) const";
     C << sb;
-    C << nl << "return ::std::binary_search(" << flatName << ", " << flatName << " + " << ids.size() << ", s);";
+    if(_binarySearchDispatch)
+    {
+        C << nl << "return ::std::binary_search(" << flatName << ", " << flatName << " + " << ids.size() << ", s);";
+    }
+    else
+    {
+        map<string, string> cases;
+        for(StringList::const_iterator r = ids.begin(); r != ids.end(); ++r)
+        {
+            cases[*r] = "return true;";
+        }
+        writeStringSwitch(C, "s", cases);
+        C << nl << "return false;";
+    }
     C << eb;
 
     C << sp;
@@ -6901,29 +7559,43 @@ Slice::Gen::Cpp11InterfaceVisitor::visitClassDefEnd(const ClassDefPtr& p)
         C << nl << scoped.substr(2) << "::_iceDispatch(::IceInternal::Incoming& in, const ::Ice::Current& current)";
         C << sb;
 
-        C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
-          << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size() << ", current.operation);";
-        C << nl << "if(r.first == r.second)";
-        C << sb;
-        C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);";
-        C << eb;
-        C << sp;
-        C << nl << "switch(r.first - " << flatName << ')';
-        C << sb;
-        int i = 0;
-        for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
+        if(_binarySearchDispatch)
         {
-            C << nl << "case " << i++ << ':';
+            C << nl << "::std::pair<const ::std::string*, const ::std::string*> r = "
+              << "::std::equal_range(" << flatName << ", " << flatName << " + " << allOpNames.size()
+              << ", current.operation);";
+            C << nl << "if(r.first == r.second)";
+            C << sb;
+            C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);";
+            C << eb;
+            C << sp;
+            C << nl << "switch(r.first - " << flatName << ')';
             C << sb;
-            C << nl << "return _iceD_" << *q << "(in, current);";
+            int i = 0;
+            for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
+            {
+                C << nl << "case " << i++ << ':';
+                C << sb;
+                C << nl << "return _iceD_" << *q << "(in, current);";
+                C << eb;
+            }
+            C << nl << "default:";
+            C << sb;
+            C << nl << "assert(false);";
+            C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);";
+            C << eb;
             C << eb;
         }
-        C << nl << "default:";
-        C << sb;
-        C << nl << "assert(false);";
-        C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);";
-        C << eb;
-        C << eb;
+        else
+        {
+            map<string, string> cases;
+            for(StringList::const_iterator q = allOpNames.begin(); q != allOpNames.end(); ++q)
+            {
+                cases[*q] = "return _iceD_" + *q + "(in, current);";
+            }
+            writeStringSwitch(C, "current.operation", cases);
+            C << nl << "throw ::Ice::OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);";
+        }
         C << eb;
     }
 
@@ -7078,6 +7750,16 @@ Slice::Gen::Cpp11InterfaceVisitor::visitOperation(const OperationPtr& p)
     H << nl << deprecateSymbol << "virtual " << retS << ' ' << opName << spar << params << epar << isConst << " = 0;";
     H << nl << "bool _iceD_" << name << "(::IceInternal::Incoming&, const ::Ice::Current&)" << isConst << ';';
 
+    //
+    // The class holding the parameters of synchronous invocations, it's
+    // also used by the proxy generated by Cpp11ProxyVisitor.
+    //
+    bool direct = useDirectParams(p, true);
+    if(direct)
+    {
+        writeDirectParamsClass(C, p, inParams, outParams, _useWstring | TypeContextCpp11);
+    }
+
     C << sp;
     C << nl << "bool";
     C << nl << scope.substr(2);
@@ -7085,6 +7767,46 @@ Slice::Gen::Cpp11InterfaceVisitor::visitOperation(const OperationPtr& p)
     C << sb;
     C << nl << "_iceCheckMode(" << operationModeToString(p->mode(), true) << ", current.mode);";
 
+    if(direct)
+    {
+        //
+        // Collocated request dispatched from the invoking thread, the
+        // parameters aren't marshaled.
+        //
+        string directName = "iceDirect" + p->flattenedScope() + p->name();
+        vector<string> directArgs;
+        for(ParamDeclList::const_iterator q = paramList.begin(); q != paramList.end(); ++q)
+        {
+            string param = fixKwd(string(paramPrefix) + (*q)->name());
+            directArgs.push_back((*q)->isOutParam() ? param : "direct->" + param);
+        }
+        directArgs.push_back("current");
+
+        C << nl << "auto direct = dynamic_cast<" << directName << "*>(inS.getDirectParams());";
+        C << nl << "if(direct)";
+        C << sb;
+        writeAllocateCode(C, outParams, 0, true, _useWstring | TypeContextCpp11);
+        C << nl;
+        if(ret)
+        {
+            C << retS << " ret = ";
+        }
+        C << "this->" << opName << spar << directArgs << epar << ';';
+        for(ParamDeclList::const_iterator q = outParams.begin(); q != outParams.end(); ++q)
+        {
+            string param = fixKwd(string(paramPrefix) + (*q)->name());
+            C << nl << "direct->" << param << " = " << condMove(isMovable((*q)->type()), param) << ';';
+        }
+        if(ret)
+        {
+            C << nl << "direct->ret = " << condMove(isMovable(ret), "ret") << ';';
+        }
+        C << nl << "direct->completed();";
+        C << nl << "inS.writeEmptyParams();";
+        C << nl << "return false;";
+        C << eb;
+    }
+
     if(!inParams.empty())
     {
         C << nl << "auto istr = inS.startReadParams();";
@@ -31,6 +31,7 @@ public:
         bool,
         bool,
         bool,
+        bool,
         bool);
     ~Gen();
 
@@ -77,6 +78,7 @@ private:
     bool _implCpp11;
     bool _checksum;
     bool _ice;
+    bool _binarySearchDispatch;
 
     class TypesVisitor : private ::IceUtil::noncopyable, public ParserVisitor
     {
@@ -145,6 +147,9 @@ private:
 
     private:
 
+        void writeDirectInvocation(const OperationPtr&, const ParamDeclList&, const ParamDeclList&,
+                                   const std::vector<std::string>&, const std::vector<std::string>&);
+
         ::IceUtilInternal::Output& H;
         ::IceUtilInternal::Output& C;
 
@@ -178,7 +183,7 @@ private:
     {
     public:
 
-        ObjectVisitor(::IceUtilInternal::Output&, ::IceUtilInternal::Output&, const std::string&);
+        ObjectVisitor(::IceUtilInternal::Output&, ::IceUtilInternal::Output&, const std::string&, bool);
 
         virtual bool visitModuleStart(const ModulePtr&);
         virtual void visitModuleEnd(const ModulePtr&);
@@ -205,6 +210,7 @@ private:
         bool _doneStaticSymbol;
         int _useWstring;
         std::list<int> _useWstringHist;
+        bool _binarySearchDispatch;
     };
 
     class AsyncCallbackVisitor : private ::IceUtil::noncopyable, public ParserVisitor
@@ -355,7 +361,7 @@ private:
     {
     public:
 
-        Cpp11DeclVisitor(::IceUtilInternal::Output&, ::IceUtilInternal::Output&, const std::string&);
+        Cpp11DeclVisitor(::IceUtilInternal::Output&, ::IceUtilInternal::Output&, const std::string&, bool);
 
         virtual bool visitUnitStart(const UnitPtr&);
         virtual void visitUnitEnd(const UnitPtr&);
@@ -372,6 +378,7 @@ private:
         ::IceUtilInternal::Output& C;
 
         std::string _dllExport;
+        bool _binarySearchDispatch;
     };
 
     class Cpp11TypesVisitor : private ::IceUtil::noncopyable, public ParserVisitor
@@ -424,6 +431,9 @@ private:
 
     private:
 
+        void writeDirectInvocation(const OperationPtr&, const ParamDeclList&, const ParamDeclList&,
+                                   const std::vector<std::string>&, const std::string&, const std::string&);
+
         ::IceUtilInternal::Output& H;
         ::IceUtilInternal::Output& C;
 
@@ -476,7 +486,7 @@ private:
     {
     public:
 
-        Cpp11InterfaceVisitor(::IceUtilInternal::Output&, ::IceUtilInternal::Output&, const std::string&);
+        Cpp11InterfaceVisitor(::IceUtilInternal::Output&, ::IceUtilInternal::Output&, const std::string&, bool);
 
         virtual bool visitModuleStart(const ModulePtr&);
         virtual void visitModuleEnd(const ModulePtr&);
@@ -486,6 +496,10 @@ private:
         virtual bool visitStructStart(const StructPtr&);
         virtual void visitOperation(const OperationPtr&);
         void emitUpcall(const ClassDefPtr&, const std::string&);
+
+    private:
+
+        bool _binarySearchDispatch;
     };
 
     class Cpp11ValueVisitor : private ::IceUtil::noncopyable, public Cpp11ObjectVisitor
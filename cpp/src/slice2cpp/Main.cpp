@@ -82,6 +82,8 @@ usage(const string& n)
         "--impl-c++11             Generate sample implementations for C++11 mapping.\n"
         "--impl-c++98             Generate sample implementations for C++98 mapping.\n"
         "--checksum               Generate checksums for Slice definitions.\n"
+        "--binary-search-dispatch Dispatch operations with a binary search over the\n"
+        "                         operation names instead of a switch.\n"
         "--dll-export SYMBOL      Use SYMBOL for DLL exports\n"
         "                         deprecated: use instead [[\"cpp:dll-export:SYMBOL\"]] metadata.\n"
         "--ice                    Allow reserved Ice prefix in Slice identifiers\n"
@@ -117,6 +119,7 @@ compile(const vector<string>& argv)
     opts.addOpt("", "ice");
     opts.addOpt("", "underscore");
     opts.addOpt("", "checksum");
+    opts.addOpt("", "binary-search-dispatch");
 
     bool validate = find(argv.begin(), argv.end(), "--validate") != argv.end();
     vector<string> args;
@@ -197,6 +200,8 @@ compile(const vector<string>& argv)
 
     bool checksum = opts.isSet("checksum");
 
+    bool binarySearchDispatch = opts.isSet("binary-search-dispatch");
+
     if(args.empty())
     {
         consoleErr << argv[0] << ": error: no input file" << endl;
@@ -340,7 +345,8 @@ compile(const vector<string>& argv)
                     try
                     {
                         Gen gen(icecpp->getBaseName(), headerExtension, sourceExtension, extraHeaders, include,
-                                includePaths, dllExport, output, implCpp98, implCpp11, checksum, ice);
+                                includePaths, dllExport, output, implCpp98, implCpp11, checksum, ice,
+                                binarySearchDispatch);
                         gen.generate(u);
                     }
                     catch(const Slice::FileException& ex)
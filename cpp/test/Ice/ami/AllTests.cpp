@@ -2181,6 +2181,54 @@ allTests(const Ice::CommunicatorPtr& communicator, bool collocated)
         }
         cout << "ok" << endl;
 
+        cout << "testing many outstanding requests... " << flush;
+        {
+            if(p->ice_getConnection())
+            {
+                //
+                // Cancel some of the requests waiting for a reply, their
+                // replies must be ignored once the adapter is resumed.
+                //
+                const int count = 10000;
+                vector<shared_ptr<promise<void>>> promises;
+                testController->holdAdapter();
+                for(int i = 0; i < count; ++i)
+                {
+                    auto promise = make_shared<std::promise<void>>();
+                    auto cancel = p->opAsync(
+                        [promise]()
+                        {
+                            promise->set_value();
+                        },
+                        [promise](exception_ptr ex)
+                        {
+                            promise->set_exception(ex);
+                        });
+                    if(i % 3 == 0)
+                    {
+                        cancel();
+                    }
+                    promises.push_back(promise);
+                }
+                testController->resumeAdapter();
+
+                for(int i = 0; i < count; ++i)
+                {
+                    try
+                    {
+                        promises[i]->get_future().get();
+                        test(i % 3 != 0);
+                    }
+                    catch(const Ice::InvocationCanceledException&)
+                    {
+                        test(i % 3 == 0);
+                    }
+                }
+                test(p->opWithResult() == 15);
+            }
+        }
+        cout << "ok" << endl;
+
         if(p->ice_getConnection() && protocol != "bt" && p->supportsAMD())
         {
             cout << "testing graceful close connection with wait... " << flush;
@@ -3879,6 +3927,45 @@ allTests(const Ice::CommunicatorPtr& communicator, bool collocated)
     }
     cout << "ok" << endl;
 
+    cout << "testing many outstanding requests... " << flush;
+    {
+        if(p->ice_getConnection())
+        {
+            //
+            // Cancel some of the requests waiting for a reply, their
+            // replies must be ignored once the adapter is resumed.
+            //
+            const int count = 10000;
+            vector<Ice::AsyncResultPtr> results;
+            testController->holdAdapter();
+            for(int i = 0; i < count; ++i)
+            {
+                Ice::AsyncResultPtr r = p->begin_op();
+                if(i % 3 == 0)
+                {
+                    r->cancel();
+                }
+                results.push_back(r);
+            }
+            testController->resumeAdapter();
+
+            for(int i = 0; i < count; ++i)
+            {
+                try
+                {
+                    p->end_op(results[i]);
+                    test(i % 3 != 0);
+                }
+                catch(const Ice::InvocationCanceledException&)
+                {
+                    test(i % 3 == 0);
+                }
+            }
+            test(p->opWithResult() == 15);
+        }
+    }
+    cout << "ok" << endl;
+
     if(p->ice_getConnection() && protocol != "bt")
     {
         cout << "testing graceful close connection with wait... " << flush;
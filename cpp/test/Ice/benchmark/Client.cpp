@@ -0,0 +1,565 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <IceUtil/Timer.h>
+#include <IceUtil/TimerWheel.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+#include <algorithm>
+
+DEFINE_TEST("client")
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+const int repetitions = 20000;
+
+//
+// The client and the server use the same socket file paths.
+//
+string
+getSocketPath(const string& name)
+{
+    const char* tmpdir = getenv("TMPDIR");
+    return string(tmpdir && *tmpdir ? tmpdir : "/tmp") + "/ice-benchmark-" + name + ".sock";
+}
+
+BenchmarkPrxPtr
+createProxy(const Ice::CommunicatorPtr& communicator, int num)
+{
+    return ICE_UNCHECKED_CAST(BenchmarkPrx, communicator->stringToProxy("benchmark:" +
+                                                                        getTestEndpoint(communicator, num)));
+}
+
+//
+// Calls ping on the given proxies in turn.
+//
+class InvokeThread : public IceUtil::Thread
+{
+public:
+
+    InvokeThread(const vector<BenchmarkPrxPtr>& proxies, int invocations) :
+        _proxies(proxies),
+        _invocations(invocations)
+    {
+        _proxies[0]->ice_ping(); // Establish the connection.
+    }
+
+    virtual void
+    run()
+    {
+        try
+        {
+            for(int i = 0; i < _invocations; ++i)
+            {
+                _proxies[i % _proxies.size()]->ping();
+            }
+        }
+        catch(const Ice::Exception& ex)
+        {
+            cerr << ex << endl;
+        }
+    }
+
+private:
+
+    const vector<BenchmarkPrxPtr> _proxies;
+    const int _invocations;
+};
+typedef IceUtil::Handle<InvokeThread> InvokeThreadPtr;
+
+//
+// Runs the threads and returns the number of requests per second.
+//
+int
+measureThreads(const vector<InvokeThreadPtr>& threads, int invocations)
+{
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(vector<InvokeThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->start();
+    }
+    for(vector<InvokeThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+    IceUtil::Time t = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+    return static_cast<int>(threads.size() * invocations / t.toSecondsDouble());
+}
+
+void
+measureRequests(const string& name, const BenchmarkPrxPtr& proxy)
+{
+    cout << "benchmarking " << name << "... " << flush;
+
+    proxy->ice_ping(); // Establish the connection.
+    IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(int i = 0; i < repetitions; ++i)
+    {
+        proxy->ping();
+    }
+    IceUtil::Time twoway = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+
+    BenchmarkPrxPtr oneway = ICE_UNCHECKED_CAST(BenchmarkPrx, proxy->ice_oneway());
+    start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    for(int i = 0; i < repetitions; ++i)
+    {
+        oneway->ping();
+    }
+    proxy->ping(); // Wait for the oneway requests to be dispatched.
+    IceUtil::Time onewayTime = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+
+    cout << static_cast<int>(repetitions / twoway.toSecondsDouble()) << " twoway/s, "
+         << static_cast<int>(repetitions / onewayTime.toSecondsDouble()) << " oneway/s" << endl;
+}
+
+//
+// Compares the default selector with the io_uring selector, on both sides
+// of the connection. If io_uring isn't available, the thread pools fall
+// back to the default selector.
+//
+void
+backend(const Ice::CommunicatorPtr& communicator)
+{
+    measureRequests("default backend", createProxy(communicator, 1));
+
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.ThreadPool.Client.Backend", "io_uring");
+    Ice::CommunicatorHolder ich(initData);
+    measureRequests("io_uring backend", createProxy(ich.communicator(), 2));
+}
+
+Ice::ByteSeq
+createCompressibleData(size_t size)
+{
+    string text = "The quick brown fox jumps over the lazy dog. ";
+    Ice::ByteSeq seq(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(text[i % text.size()] + (i / 4096) % 4);
+    }
+    return seq;
+}
+
+//
+// Compares the compression codecs, the LZ4 and Zstandard codecs are only
+// used if both peers are configured with the codec. The codecs which
+// aren't supported by the build fall back to bzip2.
+//
+void
+compression(const Ice::CommunicatorPtr& communicator)
+{
+    const string codecs[] = { "bzip2", "lz4", "zstd" };
+    const int endpoints[] = { 0, 3, 4 };
+    const int invocations = 20;
+
+    Ice::ByteSeq seq = createCompressibleData(512 * 1024);
+    for(int i = 0; i < 3; ++i)
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.Compression.Codec", codecs[i]);
+        Ice::CommunicatorHolder ich(initData);
+        BenchmarkPrxPtr proxy = createProxy(ich.communicator(), endpoints[i])->ice_compress(true);
+
+        cout << "benchmarking " << codecs[i] << " codec... " << flush;
+        proxy->ice_ping(); // Establish the connection.
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        for(int j = 0; j < invocations; ++j)
+        {
+            proxy->echo(seq);
+        }
+        IceUtil::Time t = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+        cout << static_cast<int>(invocations / t.toSecondsDouble()) << " MB/s" << endl;
+    }
+}
+
+//
+// Measures the servant lookups with concurrent dispatches, each thread
+// uses its own connection and calls the servants in turn.
+//
+void
+servants(const Ice::CommunicatorPtr& communicator)
+{
+    const int servantCount = 100;
+    const int invocations = 5000;
+
+    for(int threadCount = 1; threadCount <= 8; threadCount *= 2)
+    {
+        cout << "benchmarking servant lookups with " << threadCount << " thread(s)... " << flush;
+
+        vector<InvokeThreadPtr> threads;
+        for(int i = 0; i < threadCount; ++i)
+        {
+            ostringstream connectionId;
+            connectionId << "thread-" << i;
+            BenchmarkPrxPtr proxy = createProxy(communicator, 5)->ice_connectionId(connectionId.str());
+            vector<BenchmarkPrxPtr> proxies;
+            for(int j = 0; j < servantCount; ++j)
+            {
+                ostringstream os;
+                os << "servant-" << (j * 7 + i) % servantCount;
+                proxies.push_back(ICE_UNCHECKED_CAST(BenchmarkPrx,
+                                                     proxy->ice_identity(Ice::stringToIdentity(os.str()))));
+            }
+            threads.push_back(new InvokeThread(proxies, invocations));
+        }
+        cout << measureThreads(threads, invocations) << " requests/s" << endl;
+    }
+}
+
+//
+// Compares a thread pool with one shard with a thread pool with four
+// shards, each thread uses its own connection.
+//
+void
+shards(const Ice::CommunicatorPtr& communicator)
+{
+    const int shardCounts[] = { 1, 4 };
+    const int invocations = 5000;
+
+    for(int i = 0; i < 2; ++i)
+    {
+        for(int threadCount = 1; threadCount <= 8; threadCount *= 2)
+        {
+            cout << "benchmarking " << shardCounts[i] << " shard(s) with " << threadCount << " thread(s)... " << flush;
+
+            vector<InvokeThreadPtr> threads;
+            for(int j = 0; j < threadCount; ++j)
+            {
+                ostringstream os;
+                os << "connection-" << j;
+                vector<BenchmarkPrxPtr> proxies;
+                proxies.push_back(createProxy(communicator, 6 + i)->ice_connectionId(os.str()));
+                threads.push_back(new InvokeThread(proxies, invocations));
+            }
+            cout << measureThreads(threads, invocations) << " requests/s" << endl;
+        }
+    }
+}
+
+//
+// Opens and closes connections in a loop, each connection is used for a
+// single request.
+//
+class ConnectThread : public IceUtil::Thread
+{
+public:
+
+    ConnectThread(const BenchmarkPrxPtr& proxy, int index, int connections) :
+        _proxy(proxy),
+        _index(index),
+        _connections(connections)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        try
+        {
+            for(int i = 0; i < _connections; ++i)
+            {
+                ostringstream os;
+                os << "connection-" << _index << "-" << i;
+                BenchmarkPrxPtr proxy = _proxy->ice_connectionId(os.str());
+                proxy->ping();
+                proxy->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+            }
+        }
+        catch(const Ice::Exception& ex)
+        {
+            cerr << ex << endl;
+        }
+    }
+
+private:
+
+    const BenchmarkPrxPtr _proxy;
+    const int _index;
+    const int _connections;
+};
+typedef IceUtil::Handle<ConnectThread> ConnectThreadPtr;
+
+//
+// Compares the connection establishment rate of an adapter with one
+// acceptor with an adapter with four acceptors on the same port.
+//
+void
+acceptors(const Ice::CommunicatorPtr& communicator)
+{
+    const int acceptorCounts[] = { 1, 4 };
+    const int threadCount = 8;
+    const int connections = 100;
+
+    for(int i = 0; i < 2; ++i)
+    {
+        cout << "benchmarking connection establishment with " << acceptorCounts[i] << " acceptor(s)... " << flush;
+
+        vector<ConnectThreadPtr> threads;
+        for(int j = 0; j < threadCount; ++j)
+        {
+            threads.push_back(new ConnectThread(createProxy(communicator, 8 + i), j, connections));
+        }
+
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        for(vector<ConnectThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+        {
+            (*p)->start();
+        }
+        for(vector<ConnectThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+        {
+            (*p)->getThreadControl().join();
+        }
+        IceUtil::Time t = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+        cout << static_cast<int>(threadCount * connections / t.toSecondsDouble()) << " connections/s" << endl;
+    }
+}
+
+//
+// Compares the twoway latency percentiles with and without spinning
+// thread pools, on both sides of the connection. The thread pools with
+// four threads hand off the leadership to a follower for every request.
+//
+void
+spin(const Ice::CommunicatorPtr& communicator)
+{
+    const string spinMicros[] = { "0", "50" };
+    const string sizes[] = { "1", "4" };
+    const int endpoints[] = { 10, 11, 13, 14 };
+    const int samples = 20000;
+
+    for(int i = 0; i < 4; ++i)
+    {
+        const string& size = sizes[i / 2];
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ThreadPool.Client.Size", size);
+        initData.properties->setProperty("Ice.ThreadPool.Client.SpinMicros", spinMicros[i % 2]);
+        Ice::CommunicatorHolder ich(initData);
+        BenchmarkPrxPtr proxy = createProxy(ich.communicator(), endpoints[i]);
+
+        cout << "benchmarking twoway latency with " << size << " thread(s) and SpinMicros = " << spinMicros[i % 2]
+             << "... " << flush;
+
+        //
+        // Warm up the connection before the measurements.
+        //
+        for(int j = 0; j < 1000; ++j)
+        {
+            proxy->ping();
+        }
+
+        vector<IceUtil::Int64> latencies;
+        latencies.reserve(samples);
+        for(int j = 0; j < samples; ++j)
+        {
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            proxy->ping();
+            latencies.push_back((IceUtil::Time::now(IceUtil::Time::Monotonic) - start).toMicroSeconds());
+        }
+        sort(latencies.begin(), latencies.end());
+
+        cout << "p50 = " << latencies[samples / 2] << "us, p99 = " << latencies[samples * 99 / 100]
+             << "us, p99.9 = " << latencies[samples * 999 / 1000] << "us" << endl;
+    }
+}
+
+//
+// Compares scheduling and canceling tasks with the timer and the timer
+// wheel. The delays don't expire during the benchmark, as connection
+// timeouts.
+//
+class NoopTask : public IceUtil::TimerTask
+{
+public:
+
+    virtual void
+    runTimerTask()
+    {
+    }
+};
+
+void
+timer(const Ice::CommunicatorPtr&)
+{
+    const string names[] = { "timer", "timer wheel" };
+    const int count = 100000;
+
+    vector<IceUtil::TimerTaskPtr> tasks;
+    for(int i = 0; i < count; ++i)
+    {
+        tasks.push_back(ICE_MAKE_SHARED(NoopTask));
+    }
+
+    for(int i = 0; i < 2; ++i)
+    {
+        cout << "benchmarking " << names[i] << " schedule/cancel... " << flush;
+
+        IceUtil::TimerPtr timer;
+        if(i == 0)
+        {
+            timer = new IceUtil::Timer();
+        }
+        else
+        {
+            timer = new IceUtil::TimerWheel(IceUtil::Time::milliSeconds(10), 1);
+        }
+
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        for(int j = 0; j < count; ++j)
+        {
+            timer->schedule(tasks[j], IceUtil::Time::seconds(60 + j % 600));
+        }
+        IceUtil::Time schedule = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+
+        start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        for(int j = 0; j < count; ++j)
+        {
+            test(timer->cancel(tasks[j]));
+        }
+        IceUtil::Time cancel = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+        timer->destroy();
+
+        cout << static_cast<int>(count / schedule.toSecondsDouble()) << " schedule/s, "
+             << static_cast<int>(count / cancel.toSecondsDouble()) << " cancel/s" << endl;
+    }
+}
+
+//
+// Compares unix domain sockets with TCP over the loopback interface.
+//
+void
+unixSockets(const Ice::CommunicatorPtr& communicator)
+{
+#ifdef _WIN32
+    cout << "unix domain sockets aren't supported on this platform" << endl;
+#else
+    measureRequests("tcp", ICE_UNCHECKED_CAST(BenchmarkPrx, communicator->stringToProxy(
+                                                  "benchmark:" + getTestEndpoint(communicator, 12, "tcp"))));
+    measureRequests("unix", ICE_UNCHECKED_CAST(BenchmarkPrx, communicator->stringToProxy(
+                                                   "benchmark:unix -p " + getSocketPath("unix"))));
+#endif
+}
+
+//
+// Compares the shared memory transport with unix domain sockets.
+//
+void
+shm(const Ice::CommunicatorPtr& communicator)
+{
+#if !defined(__linux)
+    cout << "the shared memory transport isn't supported on this platform" << endl;
+#else
+    const string transports[] = { "unix", "shm" };
+    const int invocations = 500;
+
+    Ice::ByteSeq seq(256 * 1024);
+    for(size_t i = 0; i < seq.size(); ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(i * 31);
+    }
+
+    for(int i = 0; i < 2; ++i)
+    {
+        BenchmarkPrxPtr proxy = ICE_UNCHECKED_CAST(BenchmarkPrx, communicator->stringToProxy(
+                                                       "benchmark:" + transports[i] + " -p " +
+                                                       getSocketPath(transports[i])));
+        measureRequests(transports[i], proxy);
+
+        cout << "benchmarking " << transports[i] << " 256KB echo... " << flush;
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        for(int j = 0; j < invocations; ++j)
+        {
+            proxy->echo(seq);
+        }
+        IceUtil::Time t = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+        cout << static_cast<int>(invocations / t.toSecondsDouble()) << " requests/s" << endl;
+    }
+#endif
+}
+
+struct BenchmarkEntry
+{
+    const char* name;
+    void (*run)(const Ice::CommunicatorPtr&);
+};
+
+const BenchmarkEntry benchmarks[] =
+{
+    { "acceptors", acceptors },
+    { "backend", backend },
+    { "compression", compression },
+    { "servants", servants },
+    { "shards", shards },
+    { "shm", shm },
+    { "spin", spin },
+    { "timer", timer },
+    { "unix", unixSockets }
+};
+const size_t benchmarkCount = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+}
+
+int
+run(int argc, char** argv, const Ice::CommunicatorPtr& communicator)
+{
+    vector<string> names(argv + 1, argv + argc);
+    for(vector<string>::const_iterator p = names.begin(); p != names.end(); ++p)
+    {
+        size_t i = 0;
+        while(i < benchmarkCount && *p != benchmarks[i].name)
+        {
+            ++i;
+        }
+        if(i == benchmarkCount)
+        {
+            cerr << argv[0] << ": unknown benchmark `" << *p << "'" << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    for(size_t i = 0; i < benchmarkCount; ++i)
+    {
+        if(names.empty() || find(names.begin(), names.end(), benchmarks[i].name) != names.end())
+        {
+            benchmarks[i].run(communicator);
+        }
+    }
+
+    createProxy(communicator, 0)->shutdown();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL(false);
+#endif
+
+    try
+    {
+        Ice::InitializationData initData = getTestInitData(argc, argv);
+        Ice::CommunicatorHolder ich(argc, argv, initData);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,101 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("collocated")
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+const int invocations = 20000;
+
+}
+
+//
+// Compares collocated invocations which pass the parameters to the
+// servant without marshaling them with collocated invocations of a
+// marshaled request.
+//
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    communicator->getProperties()->setProperty("BenchmarkAdapter.Endpoints", getTestEndpoint(communicator, 0));
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("BenchmarkAdapter");
+    adapter->add(ICE_MAKE_SHARED(BenchmarkI), Ice::stringToIdentity("benchmark"));
+    adapter->activate();
+
+    BenchmarkPrxPtr proxy =
+        ICE_UNCHECKED_CAST(BenchmarkPrx, adapter->createProxy(Ice::stringToIdentity("benchmark")));
+
+    Ice::ByteSeq seq(64 * 1024);
+    for(size_t i = 0; i < seq.size(); ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(i * 31);
+    }
+
+    cout << "benchmarking collocated 64KB echo... " << flush;
+    {
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        for(int i = 0; i < invocations; ++i)
+        {
+            proxy->echo(seq);
+        }
+        IceUtil::Time t = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+        cout << static_cast<int>(invocations / t.toSecondsDouble()) << " requests/s" << endl;
+    }
+
+    cout << "benchmarking collocated 64KB echo with marshaling... " << flush;
+    {
+        Ice::OutputStream out(communicator);
+        out.startEncapsulation();
+        out.write(seq);
+        out.endEncapsulation();
+        vector<Ice::Byte> inEncaps;
+        out.finished(inEncaps);
+        vector<Ice::Byte> outEncaps;
+
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        for(int i = 0; i < invocations; ++i)
+        {
+            proxy->ice_invoke("echo", Ice::ICE_ENUM(OperationMode, Normal), inEncaps, outEncaps);
+        }
+        IceUtil::Time t = IceUtil::Time::now(IceUtil::Time::Monotonic) - start;
+        cout << static_cast<int>(invocations / t.toSecondsDouble()) << " requests/s" << endl;
+    }
+
+    adapter->destroy();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL(false);
+#endif
+
+    try
+    {
+        Ice::InitializationData initData = getTestInitData(argc, argv);
+        Ice::CommunicatorHolder ich(argc, argv, initData);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
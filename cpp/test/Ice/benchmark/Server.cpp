@@ -0,0 +1,164 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("server")
+
+using namespace std;
+
+namespace
+{
+
+const int servantCount = 100;
+
+//
+// The client and the server use the same socket file paths.
+//
+string
+getSocketPath(const string& name)
+{
+    const char* tmpdir = getenv("TMPDIR");
+    return string(tmpdir && *tmpdir ? tmpdir : "/tmp") + "/ice-benchmark-" + name + ".sock";
+}
+
+Ice::CommunicatorPtr
+createCommunicator(const Ice::CommunicatorPtr& communicator, const string& name, const string& value)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty(name, value);
+    return Ice::initialize(initData);
+}
+
+void
+createAdapter(const Ice::CommunicatorPtr& communicator, const string& name, const string& endpoints)
+{
+    communicator->getProperties()->setProperty(name + ".Endpoints", endpoints);
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter(name);
+    adapter->add(ICE_MAKE_SHARED(BenchmarkI), Ice::stringToIdentity("benchmark"));
+    adapter->activate();
+}
+
+}
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // Each adapter is configured for one of the variants measured by
+    // the client, see Client.cpp.
+    //
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    properties->setProperty("BackendAdapter.ThreadPool.Size", "1");
+    properties->setProperty("IoUringAdapter.ThreadPool.Size", "1");
+    properties->setProperty("IoUringAdapter.ThreadPool.Backend", "io_uring");
+
+    createAdapter(communicator, "BenchmarkAdapter", getTestEndpoint(communicator, 0));
+    createAdapter(communicator, "BackendAdapter", getTestEndpoint(communicator, 1));
+    createAdapter(communicator, "IoUringAdapter", getTestEndpoint(communicator, 2));
+
+    //
+    // The servant lookups are dispatched by several threads.
+    //
+    properties->setProperty("ServantAdapter.Endpoints", getTestEndpoint(communicator, 5));
+    properties->setProperty("ServantAdapter.ThreadPool.Size", "8");
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("ServantAdapter");
+    for(int i = 0; i < servantCount; ++i)
+    {
+        ostringstream os;
+        os << "servant-" << i;
+        adapter->add(ICE_MAKE_SHARED(BenchmarkI), Ice::stringToIdentity(os.str()));
+    }
+    adapter->activate();
+
+    //
+    // Thread pools with one and four shards.
+    //
+    properties->setProperty("ShardAdapter1.ThreadPool.Size", "2");
+    properties->setProperty("ShardAdapter1.ThreadPool.Shards", "1");
+    properties->setProperty("ShardAdapter4.ThreadPool.Size", "2");
+    properties->setProperty("ShardAdapter4.ThreadPool.Shards", "4");
+    createAdapter(communicator, "ShardAdapter1", getTestEndpoint(communicator, 6));
+    createAdapter(communicator, "ShardAdapter4", getTestEndpoint(communicator, 7));
+
+    //
+    // Adapters with one and four acceptors listening on the same port.
+    //
+    createAdapter(communicator, "AcceptorAdapter1", getTestEndpoint(communicator, 8) + " --reuseport 1");
+    createAdapter(communicator, "AcceptorAdapter4", getTestEndpoint(communicator, 9) + " --reuseport 4");
+
+    //
+    // Thread pools with and without spinning. With four threads, the leader
+    // hands off to a follower for every request.
+    //
+    properties->setProperty("SpinAdapter0.ThreadPool.Size", "1");
+    properties->setProperty("SpinAdapter0.ThreadPool.SpinMicros", "0");
+    properties->setProperty("SpinAdapter50.ThreadPool.Size", "1");
+    properties->setProperty("SpinAdapter50.ThreadPool.SpinMicros", "50");
+    properties->setProperty("SpinAdapter0x4.ThreadPool.Size", "4");
+    properties->setProperty("SpinAdapter0x4.ThreadPool.SpinMicros", "0");
+    properties->setProperty("SpinAdapter50x4.ThreadPool.Size", "4");
+    properties->setProperty("SpinAdapter50x4.ThreadPool.SpinMicros", "50");
+    createAdapter(communicator, "SpinAdapter0", getTestEndpoint(communicator, 10));
+    createAdapter(communicator, "SpinAdapter50", getTestEndpoint(communicator, 11));
+    createAdapter(communicator, "SpinAdapter0x4", getTestEndpoint(communicator, 13));
+    createAdapter(communicator, "SpinAdapter50x4", getTestEndpoint(communicator, 14));
+
+#ifndef _WIN32
+    //
+    // Unix domain sockets compared with TCP over the loopback interface.
+    //
+    createAdapter(communicator, "TcpAdapter", getTestEndpoint(communicator, 12, "tcp"));
+    createAdapter(communicator, "UnixAdapter", "unix -p " + getSocketPath("unix"));
+#endif
+#if defined(__linux)
+    createAdapter(communicator, "ShmAdapter", "shm -p " + getSocketPath("shm"));
+#endif
+
+    //
+    // The compression codec is configured per communicator.
+    //
+    vector<Ice::CommunicatorPtr> communicators;
+    communicators.push_back(createCommunicator(communicator, "Ice.Compression.Codec", "lz4"));
+    createAdapter(communicators.back(), "CompressionAdapter", getTestEndpoint(communicator, 3));
+    communicators.push_back(createCommunicator(communicator, "Ice.Compression.Codec", "zstd"));
+    createAdapter(communicators.back(), "CompressionAdapter", getTestEndpoint(communicator, 4));
+
+    TEST_READY
+    communicator->waitForShutdown();
+
+    for(vector<Ice::CommunicatorPtr>::const_iterator p = communicators.begin(); p != communicators.end(); ++p)
+    {
+        (*p)->destroy();
+    }
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL(false);
+#endif
+
+    try
+    {
+        Ice::InitializationData initData = getTestInitData(argc, argv);
+        Ice::CommunicatorHolder ich(argc, argv, initData);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,28 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+void
+BenchmarkI::ping(const Ice::Current&)
+{
+}
+
+Ice::ByteSeq
+BenchmarkI::echo(ICE_IN(Ice::ByteSeq) seq, const Ice::Current&)
+{
+    return seq;
+}
+
+void
+BenchmarkI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,21 @@
+# **********************************************************************
+#
+# Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+#
+# This is a benchmark, it isn't run by the test driver. Start the server
+# and then the client with the names of the benchmarks to run (all the
+# benchmarks are run if no names are given), for example:
+#
+#   server &
+#   client backend
+#
+# The client shuts down the server once the benchmarks are done. The
+# collocated invocations are measured by the collocated program, which
+# doesn't need the server.
+#
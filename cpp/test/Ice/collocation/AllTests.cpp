@@ -0,0 +1,163 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+Ice::ByteSeq
+createPayload(size_t size)
+{
+    Ice::ByteSeq seq(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(i * 31);
+    }
+    return seq;
+}
+
+void
+testOperations(const TestIntfPrxPtr& proxy)
+{
+    Ice::ByteSeq seq = createPayload(1024);
+    test(proxy->echo(seq) == seq);
+    test(proxy->echo(Ice::ByteSeq()).empty());
+
+    Ice::StringSeq strings;
+    strings.push_back("a");
+    strings.push_back("bc");
+    strings.push_back("def");
+    Ice::Int count;
+    StringIntDict lengths;
+    lengths["stale"] = 0;
+    test(proxy->join(strings, ", ", count, lengths) == "a, bc, def");
+    test(count == 3);
+    test(lengths.size() == 3);
+    test(lengths["a"] == 1 && lengths["bc"] == 2 && lengths["def"] == 3);
+
+    Point p;
+    p.x = 1;
+    p.y = 2;
+    Point r = proxy->move(p, 10, 20);
+    test(r.x == 11 && r.y == 22);
+
+    try
+    {
+        proxy->fail("failure");
+        test(false);
+    }
+    catch(const TestFailure& ex)
+    {
+        test(ex.reason == "failure");
+    }
+
+    DataPtr d = ICE_MAKE_SHARED(Data);
+    d->name = "data";
+    test(proxy->echoData(d)->name == "data");
+
+    test(proxy->echoOptional(IceUtil::Optional<Ice::Int>(5)) == 5);
+    test(!proxy->echoOptional(IceUtil::None));
+}
+
+}
+
+void
+allTests(const Ice::ObjectAdapterPtr& adapter)
+{
+    TestIntfIPtr servant = ICE_DYNAMIC_CAST(TestIntfI, adapter->find(Ice::stringToIdentity("test")));
+    InterceptorIPtr interceptor = ICE_DYNAMIC_CAST(InterceptorI, adapter->find(Ice::stringToIdentity("interceptor")));
+
+    TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx, adapter->createProxy(Ice::stringToIdentity("test")));
+    Ice::ByteSeq seq = createPayload(100);
+
+    cout << "testing collocated invocations... " << flush;
+    {
+        testOperations(proxy);
+#ifndef ICE_CPP11_MAPPING
+        //
+        // The parameters are passed to the servant without being
+        // marshaled.
+        //
+        test(proxy->echo(seq) == seq);
+        test(servant->getLastParam() == &seq);
+#endif
+    }
+    cout << "ok" << endl;
+
+    cout << "testing collocated invocations with marshaled parameters... " << flush;
+    {
+        //
+        // Requests with an invocation timeout are dispatched by the
+        // thread pool.
+        //
+        TestIntfPrxPtr timeout = proxy->ice_invocationTimeout(10000);
+        testOperations(timeout);
+        test(timeout->echo(seq) == seq);
+        test(servant->getLastParam() != &seq);
+
+        TestIntfPrxPtr oneway = proxy->ice_oneway();
+        Ice::Int count = proxy->count();
+        oneway->sink(seq);
+        while(proxy->count() != count + 1)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
+        test(servant->getLastParam() != &seq);
+
+#ifdef ICE_CPP11_MAPPING
+        test(proxy->echoAsync(seq).get() == seq);
+#else
+        test(proxy->end_echo(proxy->begin_echo(seq)) == seq);
+#endif
+        test(servant->getLastParam() != &seq);
+
+        TestIntfPrxPtr blobject =
+            ICE_UNCHECKED_CAST(TestIntfPrx, adapter->createProxy(Ice::stringToIdentity("blobject")));
+        test(blobject->echo(seq) == seq);
+        try
+        {
+            blobject->count();
+            test(false);
+        }
+        catch(const Ice::OperationNotExistException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing dispatch interceptors and servant locators... " << flush;
+    {
+        TestIntfPrxPtr intercepted =
+            ICE_UNCHECKED_CAST(TestIntfPrx, adapter->createProxy(Ice::stringToIdentity("interceptor")));
+        testOperations(intercepted);
+        int dispatchCount = interceptor->getDispatchCount();
+        test(intercepted->echo(seq) == seq);
+        test(interceptor->getDispatchCount() == dispatchCount + 2);
+        testOperations(intercepted->ice_invocationTimeout(10000));
+
+        TestIntfPrxPtr located =
+            ICE_UNCHECKED_CAST(TestIntfPrx, adapter->createProxy(Ice::stringToIdentity("locator/test")));
+        testOperations(located);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing non-collocated invocations... " << flush;
+    {
+        testOperations(proxy->ice_collocationOptimized(false));
+    }
+    cout << "ok" << endl;
+
+    adapter->destroy();
+}
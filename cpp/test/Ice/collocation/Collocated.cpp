@@ -0,0 +1,63 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("collocated")
+
+using namespace std;
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints", getTestEndpoint(communicator, 0));
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    TestIntfIPtr servant = ICE_MAKE_SHARED(TestIntfI);
+    adapter->add(servant, Ice::stringToIdentity("test"));
+    adapter->add(ICE_MAKE_SHARED(InterceptorI, servant), Ice::stringToIdentity("interceptor"));
+    adapter->add(ICE_MAKE_SHARED(BlobjectI), Ice::stringToIdentity("blobject"));
+    adapter->addServantLocator(ICE_MAKE_SHARED(ServantLocatorI, servant), "locator");
+    adapter->activate();
+
+    void allTests(const Ice::ObjectAdapterPtr&);
+    allTests(adapter);
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL(false);
+#endif
+
+    int status;
+    Ice::CommunicatorPtr communicator;
+
+    try
+    {
+        Ice::InitializationData initData = getTestInitData(argc, argv);
+        communicator = Ice::initialize(argc, argv, initData);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        communicator->destroy();
+    }
+
+    return status;
+}
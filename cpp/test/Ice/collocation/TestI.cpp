@@ -0,0 +1,161 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+using namespace Test;
+
+TestIntfI::TestIntfI() :
+    _count(0),
+    _lastParam(0)
+{
+}
+
+Ice::ByteSeq
+TestIntfI::echo(ICE_IN(Ice::ByteSeq) seq, const Ice::Current&)
+{
+    _lastParam = &seq;
+    return seq;
+}
+
+string
+TestIntfI::join(ICE_IN(Ice::StringSeq) seq, ICE_IN(string) separator, Ice::Int& count, StringIntDict& lengths,
+                const Ice::Current&)
+{
+    _lastParam = &seq;
+    string result;
+    for(Ice::StringSeq::const_iterator p = seq.begin(); p != seq.end(); ++p)
+    {
+        if(p != seq.begin())
+        {
+            result += separator;
+        }
+        result += *p;
+        lengths[*p] = static_cast<Ice::Int>(p->size());
+    }
+    count = static_cast<Ice::Int>(seq.size());
+    return result;
+}
+
+Point
+TestIntfI::move(ICE_IN(Point) p, Ice::Int dx, Ice::Int dy, const Ice::Current&)
+{
+    Point result = p;
+    result.x += dx;
+    result.y += dy;
+    return result;
+}
+
+Ice::Int
+TestIntfI::count(const Ice::Current&)
+{
+    return _count;
+}
+
+void
+TestIntfI::sink(ICE_IN(Ice::ByteSeq) seq, const Ice::Current&)
+{
+    _lastParam = &seq;
+    ++_count;
+}
+
+void
+TestIntfI::fail(ICE_IN(string) reason, const Ice::Current&)
+{
+    throw TestFailure(reason);
+}
+
+DataPtr
+TestIntfI::echoData(ICE_IN(DataPtr) d, const Ice::Current&)
+{
+    return d;
+}
+
+IceUtil::Optional<Ice::Int>
+TestIntfI::echoOptional(ICE_IN(IceUtil::Optional<Ice::Int>) v, const Ice::Current&)
+{
+    return v;
+}
+
+const void*
+TestIntfI::getLastParam() const
+{
+    return _lastParam;
+}
+
+bool
+BlobjectI::ice_invoke(const vector<Ice::Byte>& inEncaps, vector<Ice::Byte>& outEncaps, const Ice::Current& current)
+{
+    //
+    // The encoded in parameters of echo are also its encoded results.
+    //
+    if(current.operation == "echo")
+    {
+        outEncaps = inEncaps;
+        return true;
+    }
+    throw Ice::OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);
+}
+
+InterceptorI::InterceptorI(const Ice::ObjectPtr& servant) :
+    _servant(servant),
+    _dispatchCount(0)
+{
+}
+
+bool
+InterceptorI::dispatch(Ice::Request& request)
+{
+    //
+    // Dispatch each request twice, the second dispatch must see the
+    // same parameters as the first one.
+    //
+    _servant->ice_dispatch(request);
+    _dispatchCount += 2;
+    return _servant->ice_dispatch(request);
+}
+
+int
+InterceptorI::getDispatchCount() const
+{
+    return _dispatchCount;
+}
+
+ServantLocatorI::ServantLocatorI(const Ice::ObjectPtr& servant) :
+    _servant(servant)
+{
+}
+
+#ifdef ICE_CPP11_MAPPING
+shared_ptr<Ice::Object>
+ServantLocatorI::locate(const Ice::Current&, shared_ptr<void>&)
+#else
+Ice::ObjectPtr
+ServantLocatorI::locate(const Ice::Current&, Ice::LocalObjectPtr&)
+#endif
+{
+    return _servant;
+}
+
+#ifdef ICE_CPP11_MAPPING
+void
+ServantLocatorI::finished(const Ice::Current&, const Ice::ObjectPtr&, const shared_ptr<void>&)
+#else
+void
+ServantLocatorI::finished(const Ice::Current&, const Ice::ObjectPtr&, const Ice::LocalObjectPtr&)
+#endif
+{
+}
+
+void
+ServantLocatorI::deactivate(const string&)
+{
+}
@@ -0,0 +1,89 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    TestIntfI();
+
+    virtual Ice::ByteSeq echo(ICE_IN(Ice::ByteSeq), const Ice::Current&);
+    virtual std::string join(ICE_IN(Ice::StringSeq), ICE_IN(std::string), Ice::Int&, Test::StringIntDict&,
+                             const Ice::Current&);
+    virtual Test::Point move(ICE_IN(Test::Point), Ice::Int, Ice::Int, const Ice::Current&);
+    virtual Ice::Int count(const Ice::Current&);
+    virtual void sink(ICE_IN(Ice::ByteSeq), const Ice::Current&);
+    virtual void fail(ICE_IN(std::string), const Ice::Current&);
+    virtual Test::DataPtr echoData(ICE_IN(Test::DataPtr), const Ice::Current&);
+    virtual IceUtil::Optional<Ice::Int> echoOptional(ICE_IN(IceUtil::Optional<Ice::Int>), const Ice::Current&);
+
+    //
+    // The address of the sequence received by the last echo, join or
+    // sink call, it's the address of the caller's sequence if the
+    // parameters weren't marshaled.
+    //
+    const void* getLastParam() const;
+
+private:
+
+    Ice::Int _count;
+    const void* _lastParam;
+};
+ICE_DEFINE_PTR(TestIntfIPtr, TestIntfI);
+
+class BlobjectI : public Ice::Blobject
+{
+public:
+
+    virtual bool ice_invoke(const std::vector<Ice::Byte>&, std::vector<Ice::Byte>&, const Ice::Current&);
+};
+
+class InterceptorI : public Ice::DispatchInterceptor
+{
+public:
+
+    InterceptorI(const Ice::ObjectPtr&);
+
+    virtual bool dispatch(Ice::Request&);
+
+    int getDispatchCount() const;
+
+private:
+
+    const Ice::ObjectPtr _servant;
+    int _dispatchCount;
+};
+ICE_DEFINE_PTR(InterceptorIPtr, InterceptorI);
+
+class ServantLocatorI : public Ice::ServantLocator
+{
+public:
+
+    ServantLocatorI(const Ice::ObjectPtr&);
+
+#ifdef ICE_CPP11_MAPPING
+    virtual std::shared_ptr<Ice::Object> locate(const Ice::Current&, std::shared_ptr<void>&);
+    virtual void finished(const Ice::Current&, const Ice::ObjectPtr&, const std::shared_ptr<void>&);
+#else
+    virtual Ice::ObjectPtr locate(const Ice::Current&, Ice::LocalObjectPtr&);
+    virtual void finished(const Ice::Current&, const Ice::ObjectPtr&, const Ice::LocalObjectPtr&);
+#endif
+    virtual void deactivate(const std::string&);
+
+private:
+
+    const Ice::ObjectPtr _servant;
+};
+
+#endif
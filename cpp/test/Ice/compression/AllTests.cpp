@@ -0,0 +1,219 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Random.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+
+namespace
+{
+
+class LoggerI : public Ice::Logger,
+                private IceUtil::Mutex
+#ifdef ICE_CPP11_MAPPING
+              , public std::enable_shared_from_this<LoggerI>
+#endif
+{
+public:
+
+    virtual void
+    print(const string&)
+    {
+    }
+
+    virtual void
+    trace(const string&, const string& message)
+    {
+        Lock sync(*this);
+        _messages.push_back(message);
+    }
+
+    virtual void
+    warning(const string& message)
+    {
+        Lock sync(*this);
+        _messages.push_back("warning: " + message);
+    }
+
+    virtual void
+    error(const string& message)
+    {
+        Lock sync(*this);
+        _messages.push_back("error: " + message);
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return ICE_SHARED_FROM_THIS;
+    }
+
+    bool
+    contains(const string& str)
+    {
+        Lock sync(*this);
+        for(vector<string>::const_iterator p = _messages.begin(); p != _messages.end(); ++p)
+        {
+            if(p->find(str) != string::npos)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void
+    clear()
+    {
+        Lock sync(*this);
+        _messages.clear();
+    }
+
+private:
+
+    vector<string> _messages;
+};
+ICE_DEFINE_PTR(LoggerIPtr, LoggerI);
+
+Ice::CommunicatorPtr
+createCommunicator(const Ice::CommunicatorPtr& communicator, const string& codec, const LoggerIPtr& logger)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.Compression.Codec", codec);
+    initData.properties->setProperty("Ice.Override.Compress", "");
+    initData.properties->setProperty("Ice.Trace.Protocol", "1");
+    initData.logger = logger;
+    return Ice::initialize(initData);
+}
+
+bool
+isSupported(const Ice::CommunicatorPtr& communicator, const string& codec)
+{
+    LoggerIPtr logger = ICE_MAKE_SHARED(LoggerI);
+    createCommunicator(communicator, codec, logger)->destroy();
+    return !logger->contains("not supported");
+}
+
+Ice::ByteSeq
+createData(size_t size)
+{
+    string text = "The quick brown fox jumps over the lazy dog. ";
+    Ice::ByteSeq seq(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(text[i % text.size()] + (i / 4096) % 4);
+    }
+    return seq;
+}
+
+void
+testEcho(const Test::EchoPrxPtr& echo, const LoggerIPtr& logger, const string& requestStatus,
+         const string& replyStatus)
+{
+    logger->clear();
+    Ice::ByteSeq seq = createData(64 * 1024);
+    test(echo->echoBytes(seq) == seq);
+    test(logger->contains("sending request \nmessage type = 0 (request)\ncompression status = " + requestStatus));
+    test(logger->contains("received reply \nmessage type = 2 (reply)\ncompression status = " + replyStatus));
+
+    for(size_t size = 1; size < 512 * 1024; size *= 4)
+    {
+        seq = createData(size);
+        test(echo->echoBytes(seq) == seq);
+    }
+
+    //
+    // Incompressible data.
+    //
+    seq.resize(32 * 1024);
+    for(size_t i = 0; i < seq.size(); ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(IceUtilInternal::random(256));
+    }
+    test(echo->echoBytes(seq) == seq);
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    const string codecs[] = { "bzip2", "lz4", "zstd" };
+    const int codecCount = static_cast<int>(sizeof(codecs) / sizeof(codecs[0]));
+
+    for(int i = 0; i < codecCount; ++i)
+    {
+        if(!isSupported(communicator, codecs[i]))
+        {
+            cout << "skipping " << codecs[i] << " codec (not supported by this build)" << endl;
+            continue;
+        }
+
+        cout << "testing " << codecs[i] << " codec... " << flush;
+        for(int j = 0; j < codecCount; ++j)
+        {
+            if(i != j && !isSupported(communicator, codecs[j]))
+            {
+                continue;
+            }
+
+            LoggerIPtr logger = ICE_MAKE_SHARED(LoggerI);
+            Ice::CommunicatorPtr client = createCommunicator(communicator, codecs[i], logger);
+            Test::EchoPrxPtr echo = ICE_UNCHECKED_CAST(Test::EchoPrx,
+                                                       client->stringToProxy("test:" +
+                                                                             getTestEndpoint(communicator, j)));
+            echo = echo->ice_compress(true);
+
+            //
+            // The LZ4 and Zstandard codecs are only used if both peers are
+            // configured with the same codec, bzip2 is used otherwise.
+            //
+            if(i == j && i != 0)
+            {
+                testEcho(echo, logger, "4", "4");
+            }
+            else
+            {
+                testEcho(echo, logger, "2", "2");
+            }
+
+            //
+            // Messages smaller than Ice.Compression.MinSize aren't compressed.
+            //
+            logger->clear();
+            echo->ice_ping();
+            test(logger->contains("compression status = " + string(i == j && i != 0 ? "3" : "1")));
+
+            //
+            // Without compression, the compression status is zero.
+            //
+            logger->clear();
+            test(echo->ice_compress(false)->echoBytes(createData(1024)).size() == 1024);
+            test(logger->contains("sending request \nmessage type = 0 (request)\ncompression status = 0"));
+
+            client->destroy();
+        }
+        cout << "ok" << endl;
+    }
+
+    Test::EchoPrxPtr echo = ICE_UNCHECKED_CAST(Test::EchoPrx,
+                                               communicator->stringToProxy("test:" +
+                                                                           getTestEndpoint(communicator, 0)));
+    echo->shutdown();
+}
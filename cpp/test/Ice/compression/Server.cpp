@@ -0,0 +1,142 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("server")
+
+using namespace std;
+
+namespace
+{
+
+//
+// The client skips the codecs which aren't supported by the build, the
+// logger ignores the warnings about them.
+//
+class LoggerI : public Ice::Logger
+#ifdef ICE_CPP11_MAPPING
+              , public std::enable_shared_from_this<LoggerI>
+#endif
+{
+public:
+
+    LoggerI(const Ice::LoggerPtr& logger) : _logger(logger)
+    {
+    }
+
+    virtual void
+    print(const string& message)
+    {
+        _logger->print(message);
+    }
+
+    virtual void
+    trace(const string& category, const string& message)
+    {
+        _logger->trace(category, message);
+    }
+
+    virtual void
+    warning(const string& message)
+    {
+        if(message.find("is not supported by this build") == string::npos)
+        {
+            _logger->warning(message);
+        }
+    }
+
+    virtual void
+    error(const string& message)
+    {
+        _logger->error(message);
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return _logger->getPrefix();
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return ICE_SHARED_FROM_THIS;
+    }
+
+private:
+
+    const Ice::LoggerPtr _logger;
+};
+
+void
+createAdapter(const Ice::CommunicatorPtr& communicator, const string& endpoints)
+{
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints", endpoints);
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(EchoI), Ice::stringToIdentity("test"));
+    adapter->activate();
+}
+
+}
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // The codec is configured with a communicator property, the bzip2
+    // adapter is hosted by the main communicator and the LZ4 and Zstandard
+    // adapters by their own communicator.
+    //
+    const string codecs[] = { "lz4", "zstd" };
+    vector<Ice::CommunicatorPtr> communicators;
+    createAdapter(communicator, getTestEndpoint(communicator, 0));
+    for(int i = 0; i < 2; ++i)
+    {
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.Compression.Codec", codecs[i]);
+        initData.logger = ICE_MAKE_SHARED(LoggerI, communicator->getLogger());
+        communicators.push_back(Ice::initialize(initData));
+        createAdapter(communicators.back(), getTestEndpoint(communicator, i + 1));
+    }
+
+    TEST_READY
+    communicator->waitForShutdown();
+
+    for(vector<Ice::CommunicatorPtr>::const_iterator p = communicators.begin(); p != communicators.end(); ++p)
+    {
+        (*p)->destroy();
+    }
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL(false);
+#endif
+
+    try
+    {
+        Ice::InitializationData initData = getTestInitData(argc, argv);
+        initData.properties->setProperty("Ice.Compression.Codec", "bzip2");
+        initData.properties->setProperty("Ice.Warn.Connections", "0");
+        Ice::CommunicatorHolder ich(argc, argv, initData);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,23 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+Ice::ByteSeq
+EchoI::echoBytes(ICE_IN(Ice::ByteSeq) seq, const Ice::Current&)
+{
+    return seq;
+}
+
+void
+EchoI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,140 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+#include <set>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+TestIntfPrxPtr
+createProxy(const Ice::CommunicatorPtr& communicator, int stripes)
+{
+    string ref = "test:" + getTestEndpoint(communicator, 0);
+    return ICE_UNCHECKED_CAST(TestIntfPrx, communicator->stringToProxy(ref))->ice_connectionStripes(stripes);
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    TestIntfControllerPrxPtr controller =
+        ICE_UNCHECKED_CAST(TestIntfControllerPrx,
+                           communicator->stringToProxy("testController:" + getTestEndpoint(communicator, 1)));
+
+    cout << "testing connection stripes... " << flush;
+    {
+        Ice::CommunicatorPtr client = Ice::initialize(initData);
+        TestIntfPrxPtr proxy = createProxy(client, 3);
+        test(proxy->ice_getConnectionStripes() == 3);
+
+        set<Ice::ConnectionPtr> connections;
+        for(int i = 0; i < 10; ++i)
+        {
+            connections.insert(proxy->ice_getConnection());
+        }
+        test(connections.size() == 3);
+        for(int i = 0; i < 10; ++i)
+        {
+            proxy->sendBytes(Ice::ByteSeq(1024));
+        }
+        for(set<Ice::ConnectionPtr>::const_iterator p = connections.begin(); p != connections.end(); ++p)
+        {
+            test(Ice::targetEqualTo((*p)->getEndpoint(), (*connections.begin())->getEndpoint()));
+        }
+
+        //
+        // Proxies with fewer stripes use the existing connections.
+        //
+        test(connections.find(createProxy(client, 2)->ice_getConnection()) != connections.end());
+        test(connections.find(createProxy(client, 1)->ice_getConnection()) != connections.end());
+
+        //
+        // A closed stripe is replaced by a new connection.
+        //
+        Ice::ConnectionPtr connection = *connections.begin();
+        connection->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+        connections.erase(connection);
+        for(int i = 0; i < 10; ++i)
+        {
+            connections.insert(proxy->ice_getConnection());
+        }
+        test(connections.size() == 3);
+        test(connections.find(connection) == connections.end());
+
+        //
+        // Oneway proxies share the stripes.
+        //
+        TestIntfPrxPtr oneway = proxy->ice_oneway();
+        for(int i = 0; i < 10; ++i)
+        {
+            oneway->sendBytes(Ice::ByteSeq(1024));
+            test(connections.find(oneway->ice_getConnection()) != connections.end());
+        }
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing connection stripe selection... " << flush;
+    {
+        Ice::CommunicatorPtr client = Ice::initialize(initData);
+        TestIntfPrxPtr proxy = createProxy(client, 2);
+        Ice::ConnectionPtr connection1 = proxy->ice_getConnection();
+        Ice::ConnectionPtr connection2 = proxy->ice_getConnection();
+        test(connection1 != connection2);
+
+        //
+        // While the server holds the requests, the stripe with the
+        // outstanding request isn't selected.
+        //
+        controller->holdAdapter();
+        Ice::ByteSeq seq(512 * 1024);
+#ifdef ICE_CPP11_MAPPING
+        auto f1 = proxy->sendBytesAsync(seq);
+#else
+        Ice::AsyncResultPtr r1 = proxy->begin_sendBytes(seq);
+#endif
+        Ice::ConnectionPtr connection = proxy->ice_getConnection();
+        test(connection == connection1 || connection == connection2);
+#ifndef ICE_CPP11_MAPPING
+        test(connection != r1->getConnection());
+#endif
+        for(int i = 0; i < 5; ++i)
+        {
+            test(proxy->ice_getConnection() == connection);
+        }
+
+#ifdef ICE_CPP11_MAPPING
+        auto f2 = proxy->sendBytesAsync(seq);
+#else
+        Ice::AsyncResultPtr r2 = proxy->begin_sendBytes(seq);
+#endif
+        controller->resumeAdapter();
+#ifdef ICE_CPP11_MAPPING
+        f1.get();
+        f2.get();
+#else
+        proxy->end_sendBytes(r1);
+        proxy->end_sendBytes(r2);
+#endif
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    createProxy(communicator, 1)->shutdown();
+}
@@ -1091,6 +1091,32 @@ allTests(const Ice::CommunicatorPtr& communicator)
         test(false);
     }
 
+    //
+    // Operation names which only differ from an existing operation
+    // by a single character.
+    //
+    const string wrongOperations[] = { "shutdowN", "throwAasB", "throwCasD", "ice_pinG", "Shutdown" };
+    for(size_t i = 0; i < sizeof(wrongOperations) / sizeof(wrongOperations[0]); ++i)
+    {
+        try
+        {
+            Ice::ByteSeq inEncaps, outEncaps;
+            thrower->ice_invoke(wrongOperations[i], Ice::ICE_ENUM(OperationMode, Normal), inEncaps, outEncaps);
+            test(false);
+        }
+        catch(const Ice::OperationNotExistException& ex)
+        {
+            test(ex.operation == wrongOperations[i]);
+        }
+        catch(...)
+        {
+            test(false);
+        }
+    }
+    test(thrower->ice_isA("::Test::Thrower"));
+    test(!thrower->ice_isA("::Test::Throwes"));
+    test(!thrower->ice_isA("::Ice::Objec"));
+
     cout << "ok" << endl;
 
     cout << "catching unknown local exception... " << flush;
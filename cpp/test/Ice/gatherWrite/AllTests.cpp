@@ -0,0 +1,251 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+#ifdef ICE_CPP11_MAPPING
+typedef future<void> SendResult;
+typedef future<bool> FlushResult;
+#else
+typedef Ice::AsyncResultPtr SendResult;
+typedef Ice::AsyncResultPtr FlushResult;
+#endif
+
+//
+// Fills the payload with a pattern which depends on the request ID, the
+// server checks it (see TestIntfI::send).
+//
+Ice::ByteSeq
+createPayload(int id, size_t size)
+{
+    Ice::ByteSeq seq(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(id * 7 + static_cast<int>(i));
+    }
+    return seq;
+}
+
+//
+// Most requests are small, every tenth request is large enough to span
+// several writes.
+//
+size_t
+payloadSize(int id)
+{
+    return id % 10 == 0 ? 100 * 1024 + static_cast<size_t>(id) : 1 + static_cast<size_t>(id * 37) % 2000;
+}
+
+SendResult
+beginSend(const TestIntfPrxPtr& proxy, int id, size_t size)
+{
+#ifdef ICE_CPP11_MAPPING
+    return proxy->sendAsync(id, createPayload(id, size));
+#else
+    return proxy->begin_send(id, createPayload(id, size));
+#endif
+}
+
+void
+endSend(const TestIntfPrxPtr& proxy, SendResult& result)
+{
+#ifdef ICE_CPP11_MAPPING
+    result.get();
+#else
+    proxy->end_send(result);
+#endif
+}
+
+FlushResult
+beginFlush(const TestIntfPrxPtr& proxy)
+{
+#ifdef ICE_CPP11_MAPPING
+    return proxy->ice_flushBatchRequestsAsync();
+#else
+    return proxy->begin_ice_flushBatchRequests();
+#endif
+}
+
+void
+endFlush(const TestIntfPrxPtr& proxy, FlushResult& result)
+{
+#ifdef ICE_CPP11_MAPPING
+    result.get();
+#else
+    proxy->end_ice_flushBatchRequests(result);
+#endif
+}
+
+Ice::CommunicatorPtr
+createClient(const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // With a small send buffer, the gather writes end in the middle of a
+    // message.
+    //
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.TCP.SndSize", "16384");
+    return Ice::initialize(initData);
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    TestIntfControllerPrxPtr controller =
+        ICE_UNCHECKED_CAST(TestIntfControllerPrx,
+                           communicator->stringToProxy("testController:" + getTestEndpoint(communicator, 1)));
+
+    cout << "testing queued oneway and batch requests... " << flush;
+    {
+        Ice::CommunicatorPtr client = createClient(communicator);
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+            client->stringToProxy("test:" + getTestEndpoint(client, 0)));
+        proxy->ice_ping();
+        Ice::ConnectionPtr connection = proxy->ice_getConnection();
+        TestIntfPrxPtr oneway = proxy->ice_oneway();
+        TestIntfPrxPtr batch = proxy->ice_batchOneway();
+
+        //
+        // Queue a large request followed by many small requests and batches
+        // while the adapter doesn't read from the connection. They're sent
+        // with gather writes once the adapter is activated.
+        //
+        controller->holdAdapter();
+        vector<SendResult> results;
+        vector<FlushResult> flushes;
+        int id = 0;
+        results.push_back(beginSend(oneway, id, 512 * 1024));
+        ++id;
+        for(int i = 0; i < 500; ++i)
+        {
+            if(i % 50 == 49)
+            {
+                for(int j = 0; j < 10; ++j)
+                {
+                    batch->send(id, createPayload(id, payloadSize(id)));
+                    ++id;
+                }
+                flushes.push_back(beginFlush(batch));
+            }
+            else
+            {
+                results.push_back(beginSend(oneway, id, payloadSize(id)));
+                ++id;
+            }
+        }
+        controller->resumeAdapter();
+
+        for(vector<SendResult>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            endSend(oneway, *p);
+        }
+        for(vector<FlushResult>::iterator p = flushes.begin(); p != flushes.end(); ++p)
+        {
+            endFlush(batch, *p);
+        }
+
+        //
+        // Every request is received once, in order and intact.
+        //
+        Ice::IntSeq received = proxy->getReceived();
+        test(static_cast<int>(received.size()) == id);
+        for(int i = 0; i < id; ++i)
+        {
+            test(received[i] == i);
+        }
+        test(proxy->ice_getConnection() == connection);
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing canceled requests... " << flush;
+    {
+        Ice::CommunicatorPtr client = createClient(communicator);
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+            client->stringToProxy("test:" + getTestEndpoint(client, 0)));
+        proxy->ice_ping();
+        Ice::ConnectionPtr connection = proxy->ice_getConnection();
+        TestIntfPrxPtr oneway = proxy->ice_oneway();
+
+        //
+        // The server dispatches the requests slowly, so that the connection
+        // is still sending the queued requests when the invocation timeouts
+        // of the twoway requests expire. Some of these requests are canceled
+        // while they're partially written.
+        //
+        proxy->setDelay(1);
+        controller->holdAdapter();
+        vector<pair<TestIntfPrxPtr, SendResult> > results;
+        int id = 0;
+        results.push_back(make_pair(oneway, beginSend(oneway, id, 512 * 1024)));
+        ++id;
+        for(int i = 0; i < 300; ++i)
+        {
+            TestIntfPrxPtr p = i % 3 == 0 ? proxy->ice_invocationTimeout(100 + i * 2) : oneway;
+            results.push_back(make_pair(p, beginSend(p, id, payloadSize(id))));
+            ++id;
+        }
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        controller->resumeAdapter();
+
+        int timeouts = 0;
+        for(vector<pair<TestIntfPrxPtr, SendResult> >::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            try
+            {
+                endSend(p->first, p->second);
+            }
+            catch(const Ice::InvocationTimeoutException&)
+            {
+                test(p->first != oneway);
+                ++timeouts;
+            }
+        }
+        test(timeouts > 0);
+
+        //
+        // The canceled requests which were already partially written are
+        // received, the others aren't. The other requests are received in
+        // order and intact.
+        //
+        proxy->setDelay(0);
+        Ice::IntSeq received = proxy->getReceived();
+        int last = -1;
+        int oneways = 0;
+        for(Ice::IntSeq::const_iterator p = received.begin(); p != received.end(); ++p)
+        {
+            test(*p > last);
+            if(*p % 3 != 1)
+            {
+                ++oneways;
+            }
+            last = *p;
+        }
+        test(oneways == 201);
+        test(proxy->ice_getConnection() == connection);
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                              communicator->stringToProxy("test:" + getTestEndpoint(communicator, 0)));
+    proxy->shutdown();
+}
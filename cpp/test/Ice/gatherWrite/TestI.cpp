@@ -0,0 +1,88 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestI.h>
+
+using namespace std;
+
+TestIntfI::TestIntfI() :
+    _delay(0)
+{
+}
+
+void
+TestIntfI::send(Ice::Int id, ICE_IN(Ice::ByteSeq) seq, const Ice::Current&)
+{
+    //
+    // The payload of a request is filled with a pattern which depends on
+    // the request ID (see createPayload in AllTests.cpp).
+    //
+    bool valid = true;
+    for(size_t i = 0; i < seq.size(); ++i)
+    {
+        if(seq[i] != static_cast<Ice::Byte>(id * 7 + static_cast<int>(i)))
+        {
+            valid = false;
+            break;
+        }
+    }
+
+    Ice::Int delay;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        _received.push_back(valid ? id : -1);
+        delay = _delay;
+    }
+
+    if(delay > 0)
+    {
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(delay));
+    }
+}
+
+Ice::IntSeq
+TestIntfI::getReceived(const Ice::Current&)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    Ice::IntSeq received;
+    received.swap(_received);
+    return received;
+}
+
+void
+TestIntfI::setDelay(Ice::Int delay, const Ice::Current&)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    _delay = delay;
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
+
+TestIntfControllerI::TestIntfControllerI(const Ice::ObjectAdapterPtr& adapter) : _adapter(adapter)
+{
+}
+
+void
+TestIntfControllerI::holdAdapter(const Ice::Current&)
+{
+    _adapter->hold();
+    _adapter->waitForHold();
+}
+
+void
+TestIntfControllerI::resumeAdapter(const Ice::Current&)
+{
+    _adapter->activate();
+}
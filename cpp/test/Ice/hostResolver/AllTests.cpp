@@ -0,0 +1,184 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <InstrumentationI.h>
+
+using namespace std;
+
+namespace
+{
+
+Ice::CommunicatorPtr
+createClient(const Ice::CommunicatorPtr& communicator, const CommunicatorObserverIPtr& observer, int cacheTTL,
+             int negativeCacheTTL, int threads)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.RetryIntervals", "-1");
+    ostringstream os;
+    os << cacheTTL;
+    initData.properties->setProperty("Ice.HostResolver.CacheTTL", os.str());
+    os.str("");
+    os << negativeCacheTTL;
+    initData.properties->setProperty("Ice.HostResolver.NegativeCacheTTL", os.str());
+    os.str("");
+    os << threads;
+    initData.properties->setProperty("Ice.HostResolver.Threads", os.str());
+    initData.observer = observer;
+    return Ice::initialize(initData);
+}
+
+//
+// Each connection id requires a new connection and therefore a new
+// lookup of the endpoint host.
+//
+Ice::ObjectPrxPtr
+createProxy(const Ice::CommunicatorPtr& communicator, const string& host, int id)
+{
+    ostringstream os;
+    os << "test:default -h " << host << " -p " << getTestPort(communicator->getProperties(), 0);
+    ostringstream connectionId;
+    connectionId << id;
+    return communicator->stringToProxy(os.str())->ice_connectionId(connectionId.str());
+}
+
+void
+testConnections(const Ice::CommunicatorPtr& client, int first, int count)
+{
+#ifdef ICE_CPP11_MAPPING
+    vector<future<Ice::ConnectionPtr> > results;
+    for(int i = first; i < first + count; ++i)
+    {
+        results.push_back(createProxy(client, "localhost", i)->ice_getConnectionAsync());
+    }
+    for(vector<future<Ice::ConnectionPtr> >::iterator p = results.begin(); p != results.end(); ++p)
+    {
+        test(p->get());
+    }
+#else
+    vector<pair<Ice::ObjectPrx, Ice::AsyncResultPtr> > results;
+    for(int i = first; i < first + count; ++i)
+    {
+        Ice::ObjectPrx proxy = createProxy(client, "localhost", i);
+        results.push_back(make_pair(proxy, proxy->begin_ice_getConnection()));
+    }
+    for(vector<pair<Ice::ObjectPrx, Ice::AsyncResultPtr> >::iterator p = results.begin(); p != results.end(); ++p)
+    {
+        test(p->first->end_ice_getConnection(p->second));
+    }
+#endif
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    Ice::CommunicatorPtr server = Ice::initialize(initData);
+    server->getProperties()->setProperty("TestAdapter.Endpoints", getTestEndpoint(server, 0));
+    Ice::ObjectAdapterPtr adapter = server->createObjectAdapter("TestAdapter");
+    adapter->activate();
+
+    cout << "testing endpoint lookups... " << flush;
+    {
+        CommunicatorObserverIPtr observer = ICE_MAKE_SHARED(CommunicatorObserverI);
+        Ice::CommunicatorPtr client = createClient(communicator, observer, 0, 0, 1);
+        for(int i = 0; i < 5; ++i)
+        {
+            test(createProxy(client, "localhost", i)->ice_getConnection());
+        }
+        test(observer->getLookupCount() == 5);
+
+        //
+        // Numeric hosts don't require a lookup.
+        //
+        test(createProxy(client, getTestHost(client->getProperties()), 0)->ice_getConnection());
+        test(observer->getLookupCount() == 5);
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing endpoint lookup cache... " << flush;
+    {
+        CommunicatorObserverIPtr observer = ICE_MAKE_SHARED(CommunicatorObserverI);
+        Ice::CommunicatorPtr client = createClient(communicator, observer, 60, 0, 1);
+        for(int i = 0; i < 5; ++i)
+        {
+            test(createProxy(client, "localhost", i)->ice_getConnection());
+        }
+        test(observer->getLookupCount() == 1);
+        test(observer->getFailureCount() == 0);
+
+        //
+        // Failed lookups aren't cached without a negative TTL.
+        //
+        for(int i = 0; i < 2; ++i)
+        {
+            try
+            {
+                createProxy(client, "unknown.invalid", i)->ice_getConnection();
+                test(false);
+            }
+            catch(const Ice::DNSException&)
+            {
+            }
+        }
+        test(observer->getLookupCount() == 3);
+        test(observer->getFailureCount() == 2);
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing negative endpoint lookup cache... " << flush;
+    {
+        CommunicatorObserverIPtr observer = ICE_MAKE_SHARED(CommunicatorObserverI);
+        Ice::CommunicatorPtr client = createClient(communicator, observer, 0, 60, 1);
+        for(int i = 0; i < 5; ++i)
+        {
+            try
+            {
+                createProxy(client, "unknown.invalid", i)->ice_getConnection();
+                test(false);
+            }
+            catch(const Ice::DNSException& ex)
+            {
+                test(ex.host == "unknown.invalid");
+            }
+        }
+        test(observer->getLookupCount() == 1);
+        test(observer->getFailureCount() == 1);
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing concurrent endpoint lookups... " << flush;
+    {
+        CommunicatorObserverIPtr observer = ICE_MAKE_SHARED(CommunicatorObserverI);
+        Ice::CommunicatorPtr client = createClient(communicator, observer, 0, 0, 4);
+        testConnections(client, 0, 20);
+        test(observer->getFailureCount() == 0);
+        client->destroy();
+
+        observer = ICE_MAKE_SHARED(CommunicatorObserverI);
+        client = createClient(communicator, observer, 60, 0, 4);
+        testConnections(client, 0, 20);
+        test(observer->getFailureCount() == 0);
+        int count = observer->getLookupCount();
+        testConnections(client, 20, 20);
+        test(observer->getLookupCount() == count);
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    server->destroy();
+}
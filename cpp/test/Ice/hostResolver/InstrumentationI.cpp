@@ -0,0 +1,113 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <InstrumentationI.h>
+
+using namespace std;
+
+EndpointLookupObserverI::EndpointLookupObserverI() :
+    _lookupCount(0),
+    _failureCount(0)
+{
+}
+
+void
+EndpointLookupObserverI::attach()
+{
+    IceUtil::Mutex::Lock sync(*this);
+    ++_lookupCount;
+}
+
+void
+EndpointLookupObserverI::detach()
+{
+}
+
+void
+EndpointLookupObserverI::failed(const string&)
+{
+    IceUtil::Mutex::Lock sync(*this);
+    ++_failureCount;
+}
+
+int
+EndpointLookupObserverI::getLookupCount()
+{
+    IceUtil::Mutex::Lock sync(*this);
+    return _lookupCount;
+}
+
+int
+EndpointLookupObserverI::getFailureCount()
+{
+    IceUtil::Mutex::Lock sync(*this);
+    return _failureCount;
+}
+
+CommunicatorObserverI::CommunicatorObserverI() :
+    _endpointLookupObserver(ICE_MAKE_SHARED(EndpointLookupObserverI))
+{
+}
+
+Ice::Instrumentation::ObserverPtr
+CommunicatorObserverI::getConnectionEstablishmentObserver(const Ice::EndpointPtr&, const string&)
+{
+    return ICE_NULLPTR;
+}
+
+Ice::Instrumentation::ObserverPtr
+CommunicatorObserverI::getEndpointLookupObserver(const Ice::EndpointPtr&)
+{
+    return _endpointLookupObserver;
+}
+
+Ice::Instrumentation::ConnectionObserverPtr
+CommunicatorObserverI::getConnectionObserver(const Ice::ConnectionInfoPtr&, const Ice::EndpointPtr&,
+                                             Ice::Instrumentation::ConnectionState,
+                                             const Ice::Instrumentation::ConnectionObserverPtr&)
+{
+    return ICE_NULLPTR;
+}
+
+Ice::Instrumentation::ThreadObserverPtr
+CommunicatorObserverI::getThreadObserver(const string&, const string&, Ice::Instrumentation::ThreadState,
+                                         const Ice::Instrumentation::ThreadObserverPtr&)
+{
+    return ICE_NULLPTR;
+}
+
+Ice::Instrumentation::InvocationObserverPtr
+CommunicatorObserverI::getInvocationObserver(const Ice::ObjectPrxPtr&, const string&, const Ice::Context&)
+{
+    return ICE_NULLPTR;
+}
+
+Ice::Instrumentation::DispatchObserverPtr
+CommunicatorObserverI::getDispatchObserver(const Ice::Current&, Ice::Int)
+{
+    return ICE_NULLPTR;
+}
+
+void
+CommunicatorObserverI::setObserverUpdater(const Ice::Instrumentation::ObserverUpdaterPtr&)
+{
+}
+
+int
+CommunicatorObserverI::getLookupCount()
+{
+    return _endpointLookupObserver->getLookupCount();
+}
+
+int
+CommunicatorObserverI::getFailureCount()
+{
+    return _endpointLookupObserver->getFailureCount();
+}
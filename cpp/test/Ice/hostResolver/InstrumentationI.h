@@ -0,0 +1,73 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef INSTRUMENTATION_I_H
+#define INSTRUMENTATION_I_H
+
+#include <Ice/Instrumentation.h>
+#include <IceUtil/Mutex.h>
+
+class EndpointLookupObserverI : public Ice::Instrumentation::Observer, private IceUtil::Mutex
+{
+public:
+
+    EndpointLookupObserverI();
+
+    virtual void attach();
+    virtual void detach();
+    virtual void failed(const std::string&);
+
+    int getLookupCount();
+    int getFailureCount();
+
+private:
+
+    int _lookupCount;
+    int _failureCount;
+};
+ICE_DEFINE_PTR(EndpointLookupObserverIPtr, EndpointLookupObserverI);
+
+class CommunicatorObserverI : public Ice::Instrumentation::CommunicatorObserver
+{
+public:
+
+    CommunicatorObserverI();
+
+    virtual Ice::Instrumentation::ObserverPtr getConnectionEstablishmentObserver(const Ice::EndpointPtr&,
+                                                                                const std::string&);
+
+    virtual Ice::Instrumentation::ObserverPtr getEndpointLookupObserver(const Ice::EndpointPtr&);
+
+    virtual Ice::Instrumentation::ConnectionObserverPtr
+    getConnectionObserver(const Ice::ConnectionInfoPtr&, const Ice::EndpointPtr&,
+                          Ice::Instrumentation::ConnectionState,
+                          const Ice::Instrumentation::ConnectionObserverPtr&);
+
+    virtual Ice::Instrumentation::ThreadObserverPtr
+    getThreadObserver(const std::string&, const std::string&, Ice::Instrumentation::ThreadState,
+                      const Ice::Instrumentation::ThreadObserverPtr&);
+
+    virtual Ice::Instrumentation::InvocationObserverPtr getInvocationObserver(const Ice::ObjectPrxPtr&,
+                                                                              const std::string&,
+                                                                              const Ice::Context&);
+
+    virtual Ice::Instrumentation::DispatchObserverPtr getDispatchObserver(const Ice::Current&, Ice::Int);
+
+    virtual void setObserverUpdater(const Ice::Instrumentation::ObserverUpdaterPtr&);
+
+    int getLookupCount();
+    int getFailureCount();
+
+private:
+
+    const EndpointLookupObserverIPtr _endpointLookupObserver;
+};
+ICE_DEFINE_PTR(CommunicatorObserverIPtr, CommunicatorObserverI);
+
+#endif
@@ -1421,6 +1421,26 @@ allTests(const Ice::CommunicatorPtr& communicator, const CommunicatorObserverIPt
 
     cout << "ok" << endl;
 
+    cout << "testing buffer pool metrics... " << flush;
+
+    props["IceMX.Metrics.View.Map.BufferPool.GroupBy"] = "id";
+    updateProps(clientProps, serverProps, update.get(), props, "BufferPool");
+
+    Test::ByteSeq bs(1024);
+    for(int i = 0; i < 10; ++i)
+    {
+        metrics->opByteS(bs);
+    }
+
+    view = clientMetrics->getMetricsView("View", timestamp);
+    test(view["BufferPool"].size() == 1);
+    IceMX::BufferPoolMetricsPtr bm = ICE_DYNAMIC_CAST(IceMX::BufferPoolMetrics, view["BufferPool"][0]);
+    test(bm->id == "Communicator" && bm->current == 1);
+    test(bm->allocations >= 10 && bm->hits > 0 && bm->hits <= bm->allocations);
+    test(bm->cachedBytes > 0 && bm->cachedBytes <= 1024 * 1024);
+
+    cout << "ok" << endl;
+
     cout << "testing metrics view enable/disable..." << flush;
 
     Ice::StringSeq disabledViews;
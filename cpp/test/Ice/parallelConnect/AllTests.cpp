@@ -0,0 +1,175 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+Ice::CommunicatorPtr
+createClient(const Ice::CommunicatorPtr& communicator, int delay)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.ParallelConnect", "1");
+    ostringstream os;
+    os << delay;
+    initData.properties->setProperty("Ice.ParallelConnect.Delay", os.str());
+    return Ice::initialize(initData);
+}
+
+TestIntfPrxPtr
+createProxy(const Ice::CommunicatorPtr& communicator, int port1, int timeout1, int port2, int timeout2)
+{
+    ostringstream os;
+    os << "test:" << getTestEndpoint(communicator, port1) << " -t " << timeout1 << ":"
+       << getTestEndpoint(communicator, port2) << " -t " << timeout2;
+    return ICE_UNCHECKED_CAST(TestIntfPrx, communicator->stringToProxy(os.str()))->ice_endpointSelection(
+        Ice::ICE_ENUM(EndpointSelectionType, Ordered));
+}
+
+IceUtil::Time
+now()
+{
+    return IceUtil::Time::now(IceUtil::Time::Monotonic);
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // The server hosts the Held adapter on endpoint 1 and the Active1 and
+    // Active2 adapters on endpoints 2 and 3, nothing listens on the
+    // endpoints 4 and 5.
+    //
+    const int refused1 = 4;
+    const int refused2 = 5;
+
+    cout << "testing sequential connection establishment... " << flush;
+    {
+        TestIntfPrxPtr proxy = createProxy(communicator, 1, 1000, 2, 10000);
+        IceUtil::Time start = now();
+        test(proxy->getAdapterName() == "Active1");
+        test(now() - start >= IceUtil::Time::milliSeconds(900));
+        proxy->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+    }
+    cout << "ok" << endl;
+
+    cout << "testing parallel connection establishment... " << flush;
+    {
+        Ice::CommunicatorPtr client = createClient(communicator, 100);
+
+        //
+        // The second connector is tried after the delay, without
+        // waiting for the connect timeout of the first connector.
+        //
+        TestIntfPrxPtr proxy = createProxy(client, 1, 10000, 2, 10000);
+        IceUtil::Time start = now();
+        test(proxy->getAdapterName() == "Active1");
+        test(now() - start < IceUtil::Time::seconds(5));
+        test(createProxy(client, 1, 10000, 2, 10000)->ice_getConnection() == proxy->ice_getConnection());
+
+        //
+        // The first connector establishes its connection before the
+        // delay expires, the second connector isn't tried.
+        //
+        proxy = createProxy(client, 3, 10000, 2, 10000)->ice_connectionId("first");
+        test(proxy->getAdapterName() == "Active2");
+
+        //
+        // A refused connector doesn't wait for the delay.
+        //
+        proxy = createProxy(client, refused1, 10000, 3, 10000)->ice_connectionId("refused");
+        test(proxy->getAdapterName() == "Active2");
+        client->destroy();
+
+        //
+        // With a zero delay, all the connectors are tried at once.
+        //
+        client = createClient(communicator, 0);
+        test(createProxy(client, 1, 10000, 3, 10000)->getAdapterName() == "Active2");
+        client->destroy();
+
+        //
+        // With a large delay, the first connector which establishes its
+        // connection is used.
+        //
+        client = createClient(communicator, 100000);
+        start = now();
+        test(createProxy(client, 2, 10000, 1, 10000)->getAdapterName() == "Active1");
+        test(now() - start < IceUtil::Time::seconds(5));
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing parallel connection establishment failures... " << flush;
+    {
+        Ice::CommunicatorPtr client = createClient(communicator, 100);
+        try
+        {
+            createProxy(client, refused1, 10000, refused2, 10000)->ice_ping();
+            test(false);
+        }
+        catch(const Ice::ConnectFailedException&)
+        {
+        }
+
+        //
+        // The failure of the last connector to fail is reported.
+        //
+        try
+        {
+            createProxy(client, 1, 500, refused1, 10000)->ice_ping();
+            test(false);
+        }
+        catch(const Ice::ConnectTimeoutException&)
+        {
+        }
+
+        //
+        // Destroying the communicator interrupts the pending attempts.
+        //
+        TestIntfPrxPtr proxy = createProxy(client, 1, 60000, 1, 60000);
+#ifdef ICE_CPP11_MAPPING
+        auto f = proxy->ice_pingAsync();
+        client->destroy();
+        try
+        {
+            f.get();
+            test(false);
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+        }
+#else
+        Ice::AsyncResultPtr result = proxy->begin_ice_ping();
+        client->destroy();
+        try
+        {
+            proxy->end_ice_ping(result);
+            test(false);
+        }
+        catch(const Ice::CommunicatorDestroyedException&)
+        {
+        }
+#endif
+    }
+    cout << "ok" << endl;
+
+    TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                              communicator->stringToProxy("test:" + getTestEndpoint(communicator, 0)));
+    proxy->shutdown();
+}
@@ -0,0 +1,71 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("server")
+
+using namespace std;
+
+namespace
+{
+
+void
+createAdapter(const Ice::CommunicatorPtr& communicator, const string& name, int port, bool activate)
+{
+    communicator->getProperties()->setProperty(name + ".Endpoints", getTestEndpoint(communicator, port));
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter(name);
+    adapter->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("test"));
+    if(activate)
+    {
+        adapter->activate();
+    }
+}
+
+}
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    createAdapter(communicator, "TestAdapter", 0, true);
+
+    //
+    // The held adapter doesn't accept connections: connecting to its
+    // endpoint only fails once the connect timeout expires.
+    //
+    createAdapter(communicator, "Held", 1, false);
+    createAdapter(communicator, "Active1", 2, true);
+    createAdapter(communicator, "Active2", 3, true);
+
+    TEST_READY
+    communicator->waitForShutdown();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL(false);
+#endif
+
+    try
+    {
+        Ice::InitializationData initData = getTestInitData(argc, argv);
+        Ice::CommunicatorHolder ich(argc, argv, initData);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,222 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+#ifdef ICE_CPP11_MAPPING
+typedef future<void> RecordResult;
+#else
+typedef Ice::AsyncResultPtr RecordResult;
+#endif
+
+Ice::CommunicatorPtr
+createClient(const Ice::CommunicatorPtr& communicator, int fragmentSize, bool retry = true)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    ostringstream os;
+    os << fragmentSize;
+    initData.properties->setProperty("Ice.FragmentSize", os.str());
+    initData.properties->setProperty("Ice.TCP.SndSize", "65536");
+    if(!retry)
+    {
+        initData.properties->setProperty("Ice.RetryIntervals", "-1");
+    }
+    return Ice::initialize(initData);
+}
+
+//
+// Returns a payload which doesn't compress, the requests must stay large
+// when the tests run with compression.
+//
+Ice::ByteSeq
+createPayload(size_t size)
+{
+    Ice::ByteSeq seq(size);
+    unsigned int seed = 1;
+    for(size_t i = 0; i < size; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        seq[i] = static_cast<Ice::Byte>(seed >> 16);
+    }
+    return seq;
+}
+
+RecordResult
+beginRecord(const TestIntfPrxPtr& proxy, const string& name, const Ice::ByteSeq& seq)
+{
+#ifdef ICE_CPP11_MAPPING
+    return proxy->recordAsync(name, seq);
+#else
+    return proxy->begin_record(name, seq);
+#endif
+}
+
+void
+endRecord(const TestIntfPrxPtr& proxy, RecordResult& result)
+{
+#ifdef ICE_CPP11_MAPPING
+    result.get();
+#else
+    proxy->end_record(result);
+#endif
+}
+
+//
+// Queue a large request and two small requests, the second with a higher
+// priority, while the adapter doesn't read from the connection. Returns
+// the order in which the server dispatched the requests.
+//
+Ice::StringSeq
+sendRequests(const Ice::CommunicatorPtr& client, const TestIntfControllerPrxPtr& controller)
+{
+    TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+        client->stringToProxy("test:" + getTestEndpoint(client, 0)));
+    proxy->ice_ping();
+
+    controller->holdAdapter();
+    RecordResult large = beginRecord(proxy, "large", createPayload(3 * 1024 * 1024));
+    RecordResult low = beginRecord(proxy, "low", Ice::ByteSeq(1024));
+    TestIntfPrxPtr highProxy = proxy->ice_priority(1);
+    RecordResult high = beginRecord(highProxy, "high", Ice::ByteSeq(1024));
+    controller->resumeAdapter();
+
+    endRecord(proxy, large);
+    endRecord(proxy, low);
+    endRecord(highProxy, high);
+    return proxy->getRecords();
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // The server hosts the test adapter on endpoint 0 and an adapter which
+    // limits the number of fragmented messages on endpoint 1. The
+    // controllers of these adapters are hosted on endpoint 2.
+    //
+    TestIntfControllerPrxPtr controller =
+        ICE_UNCHECKED_CAST(TestIntfControllerPrx,
+                           communicator->stringToProxy("testController:" + getTestEndpoint(communicator, 2)));
+    TestIntfControllerPrxPtr limitedController =
+        ICE_UNCHECKED_CAST(TestIntfControllerPrx,
+                           communicator->stringToProxy("limitedController:" + getTestEndpoint(communicator, 2)));
+
+    cout << "testing proxy priority... " << flush;
+    {
+        Ice::ObjectPrxPtr base = communicator->stringToProxy("test:" + getTestEndpoint(communicator, 0));
+        test(base->ice_getPriority() == 0);
+        test(base->ice_priority(5)->ice_getPriority() == 5);
+        test(base->ice_priority(-5)->ice_getPriority() == -5);
+        test(base->ice_priority(0) == base);
+        test(base->ice_priority(1) != base);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing fragmented messages... " << flush;
+    {
+        const int fragmentSizes[] = { 0, 1024, 16 * 1024 };
+        for(size_t i = 0; i < sizeof(fragmentSizes) / sizeof(int); ++i)
+        {
+            Ice::CommunicatorPtr client = createClient(communicator, fragmentSizes[i]);
+            TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+                client->stringToProxy("test:" + getTestEndpoint(client, 0)));
+
+            const size_t sizes[] = { 0, 1000, 1024, 1025, 100 * 1024, 500 * 1024 + 7 };
+            for(size_t j = 0; j < sizeof(sizes) / sizeof(size_t); ++j)
+            {
+                Ice::ByteSeq seq(sizes[j]);
+                for(size_t k = 0; k < seq.size(); ++k)
+                {
+                    seq[k] = static_cast<Ice::Byte>(k);
+                }
+                test(proxy->echo(seq) == seq);
+                test(proxy->ice_priority(1)->echo(seq) == seq);
+            }
+            client->destroy();
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing priority lanes... " << flush;
+    {
+        //
+        // Without fragments, the high priority request is sent before the
+        // low priority request, but after the large request being sent.
+        //
+        Ice::CommunicatorPtr client = createClient(communicator, 0);
+        Ice::StringSeq records = sendRequests(client, controller);
+        test(records.size() == 3);
+        test(records[0] == "large" && records[1] == "high" && records[2] == "low");
+        client->destroy();
+
+        //
+        // With fragments, both small requests are sent before the large
+        // request completes.
+        //
+        client = createClient(communicator, 16 * 1024);
+        records = sendRequests(client, controller);
+        test(records.size() == 3);
+        test(records[0] == "high" && records[1] == "low" && records[2] == "large");
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing fragmented messages limit... " << flush;
+    {
+        //
+        // The high priority request is fragmented while the fragments of the
+        // large request are being sent, the server reassembles both at the
+        // same time. This exceeds its limit and it closes the connection.
+        //
+        Ice::CommunicatorPtr client = createClient(communicator, 16 * 1024, false);
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+            client->stringToProxy("test:" + getTestEndpoint(client, 1)));
+        proxy->ice_ping();
+
+        limitedController->holdAdapter();
+        RecordResult large = beginRecord(proxy, "large", createPayload(3 * 1024 * 1024));
+        TestIntfPrxPtr highProxy = proxy->ice_priority(1);
+        RecordResult high = beginRecord(highProxy, "high", createPayload(100 * 1024));
+        limitedController->resumeAdapter();
+
+        try
+        {
+            endRecord(proxy, large);
+            test(false);
+        }
+        catch(const Ice::ConnectionLostException&)
+        {
+        }
+        try
+        {
+            endRecord(highProxy, high);
+            test(false);
+        }
+        catch(const Ice::ConnectionLostException&)
+        {
+        }
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                              communicator->stringToProxy("test:" + getTestEndpoint(communicator, 0)));
+    proxy->shutdown();
+}
@@ -0,0 +1,84 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+DEFINE_TEST("server")
+
+using namespace std;
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints", getTestEndpoint(communicator, 0));
+    communicator->getProperties()->setProperty("ControllerAdapter.Endpoints", getTestEndpoint(communicator, 2));
+
+    //
+    // The test adapters use a single thread to dispatch the requests in
+    // the order in which they are received.
+    //
+    communicator->getProperties()->setProperty("TestAdapter.ThreadPool.Size", "1");
+
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    //
+    // The server closes the connection if the client sends more than one
+    // fragmented message at a time to this adapter.
+    //
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.FragmentedMessagesMax", "1");
+    initData.properties->setProperty("Ice.Warn.Connections", "0");
+    initData.properties->setProperty("TestAdapter.Endpoints", getTestEndpoint(communicator, 1));
+    Ice::CommunicatorHolder limited(initData);
+    Ice::ObjectAdapterPtr limitedAdapter = limited->createObjectAdapter("TestAdapter");
+    limitedAdapter->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("test"));
+    limitedAdapter->activate();
+
+    Ice::ObjectAdapterPtr adapter2 = communicator->createObjectAdapter("ControllerAdapter");
+    adapter2->add(ICE_MAKE_SHARED(TestIntfControllerI, adapter), Ice::stringToIdentity("testController"));
+    adapter2->add(ICE_MAKE_SHARED(TestIntfControllerI, limitedAdapter), Ice::stringToIdentity("limitedController"));
+    adapter2->activate();
+
+    TEST_READY
+    communicator->waitForShutdown();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL(false);
+#endif
+
+    try
+    {
+        Ice::InitializationData initData = getTestInitData(argc, argv);
+        initData.properties->setProperty("Ice.MessageSizeMax", "4096");
+        initData.properties->setProperty("Ice.FragmentSize", "1024");
+
+        //
+        // Small socket buffers ensure that the large requests sent to the
+        // held adapters stay queued with the client connection.
+        //
+        initData.properties->setProperty("Ice.TCP.RcvSize", "65536");
+        Ice::CommunicatorHolder ich(argc, argv, initData);
+        return run(argc, argv, ich.communicator());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,58 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+Ice::ByteSeq
+TestIntfI::echo(ICE_IN(Ice::ByteSeq) seq, const Ice::Current&)
+{
+    return seq;
+}
+
+void
+TestIntfI::record(ICE_IN(string) name, ICE_IN(Ice::ByteSeq), const Ice::Current&)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    _records.push_back(name);
+}
+
+Ice::StringSeq
+TestIntfI::getRecords(const Ice::Current&)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    Ice::StringSeq records;
+    records.swap(_records);
+    return records;
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
+
+TestIntfControllerI::TestIntfControllerI(const Ice::ObjectAdapterPtr& adapter) : _adapter(adapter)
+{
+}
+
+void
+TestIntfControllerI::holdAdapter(const Ice::Current&)
+{
+    _adapter->hold();
+    _adapter->waitForHold();
+}
+
+void
+TestIntfControllerI::resumeAdapter(const Ice::Current&)
+{
+    _adapter->activate();
+}
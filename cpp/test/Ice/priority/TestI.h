@@ -0,0 +1,48 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+#include <IceUtil/Mutex.h>
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    virtual Ice::ByteSeq echo(ICE_IN(Ice::ByteSeq), const Ice::Current&);
+
+    virtual void record(ICE_IN(std::string), ICE_IN(Ice::ByteSeq), const Ice::Current&);
+
+    virtual Ice::StringSeq getRecords(const Ice::Current&);
+
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    IceUtil::Mutex _mutex;
+    Ice::StringSeq _records;
+};
+
+class TestIntfControllerI : public Test::TestIntfController
+{
+public:
+
+    TestIntfControllerI(const Ice::ObjectAdapterPtr&);
+
+    virtual void holdAdapter(const Ice::Current&);
+    virtual void resumeAdapter(const Ice::Current&);
+
+private:
+
+    const Ice::ObjectAdapterPtr _adapter;
+};
+
+#endif
@@ -469,6 +469,13 @@ allTests(const Ice::CommunicatorPtr& communicator)
     test(!b1->ice_isConnectionCached());
     prop->setProperty(property, "");
 
+    property = propertyPrefix + ".ConnectionStripes";
+    test(b1->ice_getConnectionStripes() == 1);
+    prop->setProperty(property, "4");
+    b1 = communicator->propertyToProxy(propertyPrefix);
+    test(b1->ice_getConnectionStripes() == 4);
+    prop->setProperty(property, "");
+
     property = propertyPrefix + ".InvocationTimeout";
     test(b1->ice_getInvocationTimeout() == -1);
     prop->setProperty(property, "1000");
@@ -476,6 +483,13 @@ allTests(const Ice::CommunicatorPtr& communicator)
     test(b1->ice_getInvocationTimeout() == 1000);
     prop->setProperty(property, "");
 
+    property = propertyPrefix + ".Priority";
+    test(b1->ice_getPriority() == 0);
+    prop->setProperty(property, "2");
+    b1 = communicator->propertyToProxy(propertyPrefix);
+    test(b1->ice_getPriority() == 2);
+    prop->setProperty(property, "");
+
     property = propertyPrefix + ".EndpointSelection";
     test(b1->ice_getEndpointSelection() == Ice::ICE_ENUM(EndpointSelectionType, Random));
     prop->setProperty(property, "Random");
@@ -515,10 +529,12 @@ allTests(const Ice::CommunicatorPtr& communicator)
     b1 = communicator->stringToProxy("test");
     b1 = b1->ice_collocationOptimized(true);
     b1 = b1->ice_connectionCached(true);
+    b1 = b1->ice_connectionStripes(3);
     b1 = b1->ice_preferSecure(false);
     b1 = b1->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Ordered));
     b1 = b1->ice_locatorCacheTimeout(100);
     b1 = b1->ice_invocationTimeout(1234);
+    b1 = b1->ice_priority(2);
     Ice::EncodingVersion v = { 1, 0 };
     b1 = b1->ice_encodingVersion(v);
     Ice::ObjectPrxPtr router = communicator->stringToProxy("router");
@@ -541,32 +557,38 @@ allTests(const Ice::CommunicatorPtr& communicator)
     b1 = b1->ice_locator(ICE_UNCHECKED_CAST(Ice::LocatorPrx, locator));
 
     Ice::PropertyDict proxyProps = communicator->proxyToProperty(b1, "Test");
-    test(proxyProps.size() == 21);
+    test(proxyProps.size() == 27);
 
     test(proxyProps["Test"] == "test -t -e 1.0");
     test(proxyProps["Test.CollocationOptimized"] == "1");
     test(proxyProps["Test.ConnectionCached"] == "1");
+    test(proxyProps["Test.ConnectionStripes"] == "3");
     test(proxyProps["Test.PreferSecure"] == "0");
     test(proxyProps["Test.EndpointSelection"] == "Ordered");
     test(proxyProps["Test.LocatorCacheTimeout"] == "100");
     test(proxyProps["Test.InvocationTimeout"] == "1234");
+    test(proxyProps["Test.Priority"] == "2");
 
     test(proxyProps["Test.Locator"] == "locator -t -e " + Ice::encodingVersionToString(Ice::currentEncoding));
     // Locator collocation optimization is always disabled.
     //test(proxyProps["Test.Locator.CollocationOptimized"] == "1");
     test(proxyProps["Test.Locator.ConnectionCached"] == "0");
+    test(proxyProps["Test.Locator.ConnectionStripes"] == "1");
     test(proxyProps["Test.Locator.PreferSecure"] == "1");
     test(proxyProps["Test.Locator.EndpointSelection"] == "Random");
     test(proxyProps["Test.Locator.LocatorCacheTimeout"] == "300");
     test(proxyProps["Test.Locator.InvocationTimeout"] == "1500");
+    test(proxyProps["Test.Locator.Priority"] == "0");
 
     test(proxyProps["Test.Locator.Router"] == "router -t -e " + Ice::encodingVersionToString(Ice::currentEncoding));
     test(proxyProps["Test.Locator.Router.CollocationOptimized"] == "0");
     test(proxyProps["Test.Locator.Router.ConnectionCached"] == "1");
+    test(proxyProps["Test.Locator.Router.ConnectionStripes"] == "1");
     test(proxyProps["Test.Locator.Router.PreferSecure"] == "1");
     test(proxyProps["Test.Locator.Router.EndpointSelection"] == "Random");
     test(proxyProps["Test.Locator.Router.LocatorCacheTimeout"] == "200");
     test(proxyProps["Test.Locator.Router.InvocationTimeout"] == "1500");
+    test(proxyProps["Test.Locator.Router.Priority"] == "0");
 
     cout << "ok" << endl;
 
@@ -591,10 +613,20 @@ allTests(const Ice::CommunicatorPtr& communicator)
     test(!base->ice_collocationOptimized(false)->ice_isCollocationOptimized());
     test(base->ice_preferSecure(true)->ice_isPreferSecure());
     test(!base->ice_preferSecure(false)->ice_isPreferSecure());
+    test(base->ice_connectionStripes(4)->ice_getConnectionStripes() == 4);
     test(base->ice_encodingVersion(Ice::Encoding_1_0)->ice_getEncodingVersion() == Ice::Encoding_1_0);
     test(base->ice_encodingVersion(Ice::Encoding_1_1)->ice_getEncodingVersion() == Ice::Encoding_1_1);
     test(base->ice_encodingVersion(Ice::Encoding_1_0)->ice_getEncodingVersion() != Ice::Encoding_1_1);
 
+    try
+    {
+        base->ice_connectionStripes(0);
+        test(false);
+    }
+    catch(const IceUtil::IllegalArgumentException&)
+    {
+    }
+
     try
     {
         base->ice_timeout(0);
@@ -714,6 +746,11 @@ allTests(const Ice::CommunicatorPtr& communicator)
     test(Ice::targetLess(compObj->ice_connectionCached(false), compObj->ice_connectionCached(true)));
     test(Ice::targetGreaterEqual(compObj->ice_connectionCached(true), compObj->ice_connectionCached(false)));
 
+    test(Ice::targetEqualTo(compObj->ice_connectionStripes(2), compObj->ice_connectionStripes(2)));
+    test(Ice::targetNotEqualTo(compObj->ice_connectionStripes(1), compObj->ice_connectionStripes(2)));
+    test(Ice::targetLess(compObj->ice_connectionStripes(1), compObj->ice_connectionStripes(2)));
+    test(Ice::targetGreaterEqual(compObj->ice_connectionStripes(2), compObj->ice_connectionStripes(1)));
+
     test(Ice::targetEqualTo(compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Random)), compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Random))));
     test(Ice::targetNotEqualTo(compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Random)), compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Ordered))));
     test(Ice::targetLess(compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Random)), compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Ordered))));
@@ -802,6 +839,11 @@ allTests(const Ice::CommunicatorPtr& communicator)
     test(Ice::targetLess(compObj1->ice_invocationTimeout(10), compObj1->ice_invocationTimeout(20)));
     test(Ice::targetGreaterEqual(compObj1->ice_invocationTimeout(20), compObj1->ice_invocationTimeout(10)));
 
+    test(Ice::targetEqualTo(compObj1->ice_priority(2), compObj1->ice_priority(2)));
+    test(Ice::targetNotEqualTo(compObj1->ice_priority(1), compObj1->ice_priority(2)));
+    test(Ice::targetLess(compObj1->ice_priority(1), compObj1->ice_priority(2)));
+    test(Ice::targetGreaterEqual(compObj1->ice_priority(2), compObj1->ice_priority(1)));
+
     compObj1 = communicator->stringToProxy("foo:tcp -h 127.0.0.1 -p 1000");
     compObj2 = communicator->stringToProxy("foo@MyAdapter1");
     test(Ice::targetNotEqualTo(compObj1, compObj2));
@@ -884,6 +926,11 @@ allTests(const Ice::CommunicatorPtr& communicator)
     test(compObj->ice_connectionCached(false) < compObj->ice_connectionCached(true));
     test(!(compObj->ice_connectionCached(true) < compObj->ice_connectionCached(false)));
 
+    test(compObj->ice_connectionStripes(2) == compObj->ice_connectionStripes(2));
+    test(compObj->ice_connectionStripes(1) != compObj->ice_connectionStripes(2));
+    test(compObj->ice_connectionStripes(1) < compObj->ice_connectionStripes(2));
+    test(!(compObj->ice_connectionStripes(2) < compObj->ice_connectionStripes(1)));
+
     test(compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Random)) == compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Random)));
     test(compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Random)) != compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Ordered)));
     test(compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Random)) < compObj->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, Ordered)));
@@ -970,6 +1017,11 @@ allTests(const Ice::CommunicatorPtr& communicator)
     test(compObj1->ice_invocationTimeout(10) < compObj1->ice_invocationTimeout(20));
     test(!(compObj1->ice_invocationTimeout(20) < compObj1->ice_invocationTimeout(10)));
 
+    test(compObj1->ice_priority(2) == compObj1->ice_priority(2));
+    test(compObj1->ice_priority(1) != compObj1->ice_priority(2));
+    test(compObj1->ice_priority(1) < compObj1->ice_priority(2));
+    test(!(compObj1->ice_priority(2) < compObj1->ice_priority(1)));
+
     compObj1 = communicator->stringToProxy("foo:tcp -h 127.0.0.1 -p 1000");
     compObj2 = communicator->stringToProxy("foo@MyAdapter1");
     test(compObj1 != compObj2);
@@ -0,0 +1,182 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+const int threadCount = 8;
+const int connections = 100;
+
+int
+count(const Ice::StringSeq& messages, const string& str)
+{
+    int n = 0;
+    for(Ice::StringSeq::const_iterator p = messages.begin(); p != messages.end(); ++p)
+    {
+        if(p->find(str) != string::npos)
+        {
+            ++n;
+        }
+    }
+    return n;
+}
+
+//
+// Opens and closes connections in a loop to simulate a reconnect storm.
+//
+class ConnectThread : public IceUtil::Thread
+{
+public:
+
+    ConnectThread(const Ice::ObjectPrxPtr& proxy, int index) : _proxy(proxy), _index(index), _failed(false)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        try
+        {
+            for(int i = 0; i < connections; ++i)
+            {
+                ostringstream os;
+                os << "connection-" << _index << "-" << i;
+                TestIntfPrxPtr prx = ICE_UNCHECKED_CAST(TestIntfPrx, _proxy->ice_connectionId(os.str()));
+                prx->ping();
+                prx->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            cerr << ex.what() << endl;
+            _failed = true;
+        }
+    }
+
+    bool
+    failed() const
+    {
+        return _failed;
+    }
+
+private:
+
+    const Ice::ObjectPrxPtr _proxy;
+    const int _index;
+    bool _failed;
+};
+typedef IceUtil::Handle<ConnectThread> ConnectThreadPtr;
+
+bool
+connect(const Ice::ObjectPrxPtr& proxy, int threadCount)
+{
+    vector<ConnectThreadPtr> threads;
+    for(int i = 0; i < threadCount; ++i)
+    {
+        threads.push_back(new ConnectThread(proxy, i));
+    }
+
+    for(vector<ConnectThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->start();
+    }
+
+    bool failed = false;
+    for(vector<ConnectThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+        failed = failed || (*p)->failed();
+    }
+    return !failed;
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    RemoteCommunicatorFactoryPrxPtr factory =
+        ICE_UNCHECKED_CAST(RemoteCommunicatorFactoryPrx,
+                           communicator->stringToProxy("factory:" + getTestEndpoint(communicator, 0)));
+    const string endpoint = getTestEndpoint(communicator, 1);
+
+    cout << "testing --reuseport endpoint option parsing... " << flush;
+    {
+        try
+        {
+            communicator->createObjectAdapterWithEndpoints("BadAdapter1", endpoint + " --reuseport");
+            test(false);
+        }
+        catch(const Ice::EndpointParseException&)
+        {
+        }
+
+        try
+        {
+            communicator->createObjectAdapterWithEndpoints("BadAdapter2", endpoint + " --reuseport 0");
+            test(false);
+        }
+        catch(const Ice::EndpointParseException&)
+        {
+        }
+
+        try
+        {
+            communicator->stringToProxy("test:" + endpoint + " --reuseport 4");
+            test(false);
+        }
+        catch(const Ice::EndpointParseException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing adapter with multiple acceptors... " << flush;
+    {
+        Ice::PropertyDict props;
+        props["Ice.Trace.Network"] = "1";
+        props["TestAdapter.Endpoints"] = endpoint + " --reuseport 4";
+        RemoteCommunicatorPrxPtr server = factory->createCommunicator(props);
+
+        Ice::StringSeq messages = server->getLogMessages();
+        test(count(messages, "listening for ") == 4);
+        test(count(messages, "accepting ") == 4);
+
+        //
+        // The acceptors share the same endpoint and --reuseport isn't
+        // part of the published endpoints.
+        //
+        TestIntfPrxPtr obj = server->getTestIntf();
+        test(obj->ice_getEndpoints().size() == 1);
+        test(communicator->proxyToString(obj).find("reuseport") == string::npos);
+
+        Ice::ObjectPrxPtr base = communicator->stringToProxy("test:" + endpoint);
+        test(connect(base, threadCount));
+
+        server->hold();
+        test(count(server->getLogMessages(), "holding ") == 4);
+        server->activate();
+        test(connect(base, 1));
+
+        server->deactivate();
+        test(count(server->getLogMessages(), "stopping to accept ") == 4);
+        server->destroy();
+    }
+    cout << "ok" << endl;
+
+    factory->shutdown();
+}
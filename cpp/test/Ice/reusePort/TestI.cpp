@@ -0,0 +1,136 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+void
+TestIntfI::ping(const Ice::Current&)
+{
+}
+
+void
+LoggerI::print(const std::string&)
+{
+}
+
+void
+LoggerI::trace(const std::string&, const std::string& message)
+{
+    Lock sync(*this);
+    _messages.push_back(message);
+}
+
+void
+LoggerI::warning(const std::string& message)
+{
+    Lock sync(*this);
+    _messages.push_back("warning: " + message);
+}
+
+void
+LoggerI::error(const std::string& message)
+{
+    Lock sync(*this);
+    _messages.push_back("error: " + message);
+}
+
+std::string
+LoggerI::getPrefix()
+{
+    return "";
+}
+
+Ice::LoggerPtr
+LoggerI::cloneWithPrefix(const std::string&)
+{
+    return ICE_SHARED_FROM_THIS;
+}
+
+Ice::StringSeq
+LoggerI::getMessages()
+{
+    Lock sync(*this);
+    return _messages;
+}
+
+RemoteCommunicatorI::RemoteCommunicatorI(const Ice::ObjectAdapterPtr& adapter, const LoggerIPtr& logger) :
+    _adapter(adapter),
+    _logger(logger)
+{
+}
+
+Test::TestIntfPrxPtr
+RemoteCommunicatorI::getTestIntf(const Ice::Current&)
+{
+    return ICE_UNCHECKED_CAST(Test::TestIntfPrx, _adapter->createProxy(Ice::stringToIdentity("test")));
+}
+
+Ice::StringSeq
+RemoteCommunicatorI::getLogMessages(const Ice::Current&)
+{
+    return _logger->getMessages();
+}
+
+void
+RemoteCommunicatorI::hold(const Ice::Current&)
+{
+    _adapter->hold();
+    _adapter->waitForHold();
+}
+
+void
+RemoteCommunicatorI::activate(const Ice::Current&)
+{
+    _adapter->activate();
+}
+
+void
+RemoteCommunicatorI::deactivate(const Ice::Current&)
+{
+    _adapter->destroy();
+}
+
+void
+RemoteCommunicatorI::destroy(const Ice::Current& current)
+{
+    _adapter->getCommunicator()->destroy();
+    current.adapter->remove(current.id);
+}
+
+Test::RemoteCommunicatorPrxPtr
+RemoteCommunicatorFactoryI::createCommunicator(ICE_IN(Ice::PropertyDict) props, const Ice::Current& current)
+{
+    //
+    // The properties of the main communicator provide the protocol
+    // configuration.
+    //
+    Ice::InitializationData initData;
+    initData.properties = current.adapter->getCommunicator()->getProperties()->clone();
+    for(Ice::PropertyDict::const_iterator p = props.begin(); p != props.end(); ++p)
+    {
+        initData.properties->setProperty(p->first, p->second);
+    }
+    LoggerIPtr logger = ICE_MAKE_SHARED(LoggerI);
+    initData.logger = logger;
+    Ice::CommunicatorPtr communicator = Ice::initialize(initData);
+
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    Ice::ObjectPrxPtr proxy = current.adapter->addWithUUID(ICE_MAKE_SHARED(RemoteCommunicatorI, adapter, logger));
+    return ICE_UNCHECKED_CAST(Test::RemoteCommunicatorPrx, proxy);
+}
+
+void
+RemoteCommunicatorFactoryI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
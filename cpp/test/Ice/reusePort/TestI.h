@@ -0,0 +1,72 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    virtual void ping(const Ice::Current&);
+};
+
+class LoggerI : public Ice::Logger,
+                private IceUtil::Mutex
+#ifdef ICE_CPP11_MAPPING
+              , public std::enable_shared_from_this<LoggerI>
+#endif
+{
+public:
+
+    virtual void print(const std::string&);
+    virtual void trace(const std::string&, const std::string&);
+    virtual void warning(const std::string&);
+    virtual void error(const std::string&);
+    virtual std::string getPrefix();
+    virtual Ice::LoggerPtr cloneWithPrefix(const std::string&);
+
+    Ice::StringSeq getMessages();
+
+private:
+
+    Ice::StringSeq _messages;
+};
+ICE_DEFINE_PTR(LoggerIPtr, LoggerI);
+
+class RemoteCommunicatorI : public Test::RemoteCommunicator
+{
+public:
+
+    RemoteCommunicatorI(const Ice::ObjectAdapterPtr&, const LoggerIPtr&);
+
+    virtual Test::TestIntfPrxPtr getTestIntf(const Ice::Current&);
+    virtual Ice::StringSeq getLogMessages(const Ice::Current&);
+    virtual void hold(const Ice::Current&);
+    virtual void activate(const Ice::Current&);
+    virtual void deactivate(const Ice::Current&);
+    virtual void destroy(const Ice::Current&);
+
+private:
+
+    const Ice::ObjectAdapterPtr _adapter;
+    const LoggerIPtr _logger;
+};
+
+class RemoteCommunicatorFactoryI : public Test::RemoteCommunicatorFactory
+{
+public:
+
+    virtual Test::RemoteCommunicatorPrxPtr createCommunicator(ICE_IN(Ice::PropertyDict), const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+};
+
+#endif
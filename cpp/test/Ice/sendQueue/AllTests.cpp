@@ -0,0 +1,358 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+#ifdef ICE_CPP11_MAPPING
+typedef future<void> SendResult;
+#else
+typedef Ice::AsyncResultPtr SendResult;
+#endif
+
+const size_t requestSize = 16 * 1024;
+
+SendResult
+beginSend(const TestIntfPrxPtr& proxy)
+{
+#ifdef ICE_CPP11_MAPPING
+    return proxy->sendAsync(Ice::ByteSeq(requestSize));
+#else
+    return proxy->begin_send(Ice::ByteSeq(requestSize));
+#endif
+}
+
+bool
+isCompleted(SendResult& result)
+{
+#ifdef ICE_CPP11_MAPPING
+    return result.wait_for(chrono::seconds(0)) == future_status::ready;
+#else
+    return result->isCompleted();
+#endif
+}
+
+void
+endSend(const TestIntfPrxPtr& proxy, SendResult& result)
+{
+#ifdef ICE_CPP11_MAPPING
+    result.get();
+#else
+    proxy->end_send(result);
+#endif
+}
+
+Ice::CommunicatorPtr
+createClient(const Ice::CommunicatorPtr& communicator, const string& policy)
+{
+    //
+    // Small socket buffers ensure that the requests sent to the held
+    // adapter are queued with the client connection.
+    //
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.Connection.SendQueueMax", "64");
+    initData.properties->setProperty("Ice.Connection.SendQueuePolicy", policy);
+    initData.properties->setProperty("Ice.TCP.SndSize", "65536");
+    initData.properties->setProperty("Ice.Admin.Enabled", "1");
+    initData.properties->setProperty("Ice.Admin.Facets", "Metrics");
+    initData.properties->setProperty("IceMX.Metrics.View.Map.Connection.GroupBy", "none");
+    return Ice::initialize(initData);
+}
+
+Ice::Long
+getQueuedBytes(const Ice::CommunicatorPtr& client)
+{
+    IceMX::MetricsAdminPtr metrics = ICE_DYNAMIC_CAST(IceMX::MetricsAdmin, client->findAdminFacet("Metrics"));
+    test(metrics);
+    Ice::Long timestamp;
+    IceMX::MetricsView view = metrics->getMetricsView("View", timestamp, Ice::emptyCurrent);
+    test(view["Connection"].size() == 1);
+    IceUtil::Optional<Ice::Long> queuedBytes =
+        ICE_DYNAMIC_CAST(IceMX::ConnectionMetrics, view["Connection"][0])->queuedBytes;
+    return queuedBytes ? *queuedBytes : 0;
+}
+
+//
+// Sends synchronous requests, they block on a full send queue.
+//
+class SendThread : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    SendThread(const TestIntfPrxPtr& proxy, int count) : _proxy(proxy), _count(count), _sent(0)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        for(int i = 0; i < _count; ++i)
+        {
+            _proxy->send(Ice::ByteSeq(requestSize));
+            Lock sync(*this);
+            ++_sent;
+        }
+    }
+
+    int
+    sent()
+    {
+        Lock sync(*this);
+        return _sent;
+    }
+
+private:
+
+    const TestIntfPrxPtr _proxy;
+    const int _count;
+    int _sent;
+};
+typedef IceUtil::Handle<SendThread> SendThreadPtr;
+
+//
+// Sends a request from a thread pool thread when the connection is closed.
+//
+class CloseSend : public IceUtil::Monitor<IceUtil::Mutex>
+#ifndef ICE_CPP11_MAPPING
+                , public Ice::CloseCallback
+#endif
+{
+public:
+
+    CloseSend(const TestIntfPrxPtr& proxy) : _proxy(proxy), _sent(false)
+    {
+    }
+
+    virtual void
+    closed(const Ice::ConnectionPtr&)
+    {
+        SendResult result = beginSend(_proxy);
+        Lock sync(*this);
+#ifdef ICE_CPP11_MAPPING
+        _result = move(result);
+#else
+        _result = result;
+#endif
+        _sent = true;
+        notifyAll();
+    }
+
+    bool
+    waitSent()
+    {
+        Lock sync(*this);
+        if(!_sent)
+        {
+            timedWait(IceUtil::Time::seconds(10));
+        }
+        return _sent;
+    }
+
+    SendResult&
+    result()
+    {
+        return _result;
+    }
+
+private:
+
+    const TestIntfPrxPtr _proxy;
+    bool _sent;
+    SendResult _result;
+};
+ICE_DEFINE_PTR(CloseSendPtr, CloseSend);
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    TestIntfControllerPrxPtr controller =
+        ICE_UNCHECKED_CAST(TestIntfControllerPrx,
+                           communicator->stringToProxy("testController:" + getTestEndpoint(communicator, 1)));
+
+    cout << "testing Throw send queue policy... " << flush;
+    {
+        Ice::CommunicatorPtr client = createClient(communicator, "Throw");
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+            client->stringToProxy("test:" + getTestEndpoint(client, 0)));
+        proxy->ice_ping();
+        test(getQueuedBytes(client) == 0);
+
+        controller->holdAdapter();
+        vector<SendResult> results;
+        bool full = false;
+        while(!full && results.size() < 1000)
+        {
+            SendResult result = beginSend(proxy);
+            if(isCompleted(result))
+            {
+                try
+                {
+                    endSend(proxy, result);
+                    test(false);
+                }
+                catch(const Ice::SendQueueFullException&)
+                {
+                    full = true;
+                }
+            }
+            else
+            {
+#ifdef ICE_CPP11_MAPPING
+                results.push_back(move(result));
+#else
+                results.push_back(result);
+#endif
+            }
+        }
+        test(full);
+        test(getQueuedBytes(client) >= 64 * 1024);
+        test(getQueuedBytes(client) < 64 * 1024 + static_cast<Ice::Long>(2 * requestSize));
+
+        try
+        {
+            proxy->ice_ping();
+            test(false);
+        }
+        catch(const Ice::SendQueueFullException&)
+        {
+        }
+
+        //
+        // The connection isn't affected, the queued requests are sent once
+        // the adapter is activated.
+        //
+        controller->resumeAdapter();
+        for(vector<SendResult>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            endSend(proxy, *p);
+        }
+        proxy->ice_ping();
+        test(getQueuedBytes(client) == 0);
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing Block send queue policy... " << flush;
+    {
+        Ice::CommunicatorPtr client = createClient(communicator, "Block");
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+            client->stringToProxy("test:" + getTestEndpoint(client, 0)));
+        int count = proxy->getCount();
+
+        Ice::ConnectionPtr connection = proxy->ice_connectionId("other")->ice_getConnection();
+        CloseSendPtr closeSend = ICE_MAKE_SHARED(CloseSend, proxy);
+#ifdef ICE_CPP11_MAPPING
+        connection->setCloseCallback([closeSend](const Ice::ConnectionPtr& c) { closeSend->closed(c); });
+#else
+        connection->setCloseCallback(closeSend);
+#endif
+
+        //
+        // Asynchronous invocations don't block on the full send queue, they
+        // fail right away.
+        //
+        controller->holdAdapter();
+        vector<SendResult> results;
+        bool full = false;
+        while(!full && results.size() < 1000)
+        {
+            SendResult result = beginSend(proxy);
+            if(isCompleted(result))
+            {
+                try
+                {
+                    endSend(proxy, result);
+                    test(false);
+                }
+                catch(const Ice::SendQueueFullException&)
+                {
+                    //
+                    // The thread pool might still move some of the queued
+                    // requests to the socket buffers, the queue must remain
+                    // full for the synchronous invocations to block.
+                    //
+                    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+                    full = getQueuedBytes(client) >= 64 * 1024;
+                }
+            }
+            else
+            {
+#ifdef ICE_CPP11_MAPPING
+                results.push_back(move(result));
+#else
+                results.push_back(result);
+#endif
+            }
+        }
+        test(full);
+        test(getQueuedBytes(client) >= 64 * 1024);
+
+        //
+        // Synchronous invocations wait for the queue to drain.
+        //
+        SendThreadPtr thread = new SendThread(proxy, 10);
+        IceUtil::ThreadControl control = thread->start();
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+        test(thread->sent() == 0);
+
+        //
+        // The invocation timeout bounds the wait.
+        //
+        try
+        {
+            proxy->ice_invocationTimeout(100)->ice_ping();
+            test(false);
+        }
+        catch(const Ice::InvocationTimeoutException&)
+        {
+        }
+
+        //
+        // The close callback is called from a thread pool thread, its
+        // asynchronous invocation fails as well.
+        //
+        connection->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, Forcefully));
+        test(closeSend->waitSent());
+        try
+        {
+            endSend(proxy, closeSend->result());
+            test(false);
+        }
+        catch(const Ice::SendQueueFullException&)
+        {
+        }
+
+        controller->resumeAdapter();
+        for(vector<SendResult>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            endSend(proxy, *p);
+        }
+        control.join();
+        test(thread->sent() == 10);
+        test(proxy->getCount() == count + static_cast<int>(results.size()) + 10);
+        test(getQueuedBytes(client) == 0);
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                              communicator->stringToProxy("test:" + getTestEndpoint(communicator, 0)));
+    proxy->shutdown();
+}
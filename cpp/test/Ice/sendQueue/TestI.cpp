@@ -0,0 +1,55 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+TestIntfI::TestIntfI() :
+    _count(0)
+{
+}
+
+void
+TestIntfI::send(ICE_IN(Ice::ByteSeq), const Ice::Current&)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    ++_count;
+}
+
+Ice::Int
+TestIntfI::getCount(const Ice::Current&)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    return _count;
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
+
+TestIntfControllerI::TestIntfControllerI(const Ice::ObjectAdapterPtr& adapter) : _adapter(adapter)
+{
+}
+
+void
+TestIntfControllerI::holdAdapter(const Ice::Current&)
+{
+    _adapter->hold();
+    _adapter->waitForHold();
+}
+
+void
+TestIntfControllerI::resumeAdapter(const Ice::Current&)
+{
+    _adapter->activate();
+}
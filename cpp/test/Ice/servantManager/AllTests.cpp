@@ -0,0 +1,212 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+const int servantCount = 100;
+const int threadCount = 8;
+const int invocations = 5000;
+
+class InvokeThread : public IceUtil::Thread
+{
+public:
+
+    InvokeThread(const Ice::ObjectPrxPtr& base, int index) : _index(index), _failed(false)
+    {
+        //
+        // Each thread uses its own connection to spread the dispatch of
+        // the requests over the server thread pool threads.
+        //
+        ostringstream connectionId;
+        connectionId << "thread-" << _index;
+        Ice::ObjectPrxPtr prx = base->ice_connectionId(connectionId.str());
+        for(int i = 0; i < servantCount; ++i)
+        {
+            ostringstream os;
+            os << "servant-" << i;
+            _proxies.push_back(ICE_UNCHECKED_CAST(TestIntfPrx, prx->ice_identity(Ice::stringToIdentity(os.str()))));
+        }
+        _proxies[0]->ice_ping();
+    }
+
+    virtual void
+    run()
+    {
+        try
+        {
+            for(int i = 0; i < invocations; ++i)
+            {
+                int id = (i * 7 + _index) % servantCount;
+                test(_proxies[id]->getId() == id);
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            cerr << ex.what() << endl;
+            _failed = true;
+        }
+    }
+
+    bool
+    failed() const
+    {
+        return _failed;
+    }
+
+private:
+
+    const int _index;
+    bool _failed;
+    vector<TestIntfPrxPtr> _proxies;
+};
+typedef IceUtil::Handle<InvokeThread> InvokeThreadPtr;
+
+//
+// Adds and removes a servant in a loop through the controller and checks
+// that the updates are immediately visible to the requests dispatched by
+// the server.
+//
+class UpdateThread : public IceUtil::Thread, public IceUtil::Mutex
+{
+public:
+
+    UpdateThread(const ControllerPrxPtr& controller, const Ice::ObjectPrxPtr& base) :
+        _controller(controller),
+        _proxy(ICE_UNCHECKED_CAST(TestIntfPrx, base->ice_identity(Ice::stringToIdentity("transient")))),
+        _destroyed(false),
+        _failed(false),
+        _updates(0)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        try
+        {
+            while(true)
+            {
+                {
+                    IceUtil::Mutex::Lock sync(*this);
+                    if(_destroyed)
+                    {
+                        return;
+                    }
+                    ++_updates;
+                }
+
+                _controller->addServant("transient", -1);
+                test(_proxy->getId() == -1);
+
+                _controller->removeServant("transient");
+                try
+                {
+                    _proxy->getId();
+                    test(false);
+                }
+                catch(const Ice::ObjectNotExistException&)
+                {
+                }
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            cerr << ex.what() << endl;
+            IceUtil::Mutex::Lock sync(*this);
+            _failed = true;
+        }
+    }
+
+    void
+    destroy()
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        _destroyed = true;
+    }
+
+    bool
+    failed()
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        return _failed;
+    }
+
+    int
+    updates()
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        return _updates;
+    }
+
+private:
+
+    const ControllerPrxPtr _controller;
+    const TestIntfPrxPtr _proxy;
+    bool _destroyed;
+    bool _failed;
+    int _updates;
+};
+typedef IceUtil::Handle<UpdateThread> UpdateThreadPtr;
+
+bool
+invoke(const Ice::ObjectPrxPtr& base)
+{
+    vector<InvokeThreadPtr> threads;
+    for(int i = 0; i < threadCount; ++i)
+    {
+        threads.push_back(new InvokeThread(base, i));
+    }
+
+    for(vector<InvokeThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->start();
+    }
+
+    bool failed = false;
+    for(vector<InvokeThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+        failed = failed || (*p)->failed();
+    }
+    return !failed;
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    Ice::ObjectPrxPtr base = communicator->stringToProxy("servant-0:" + getTestEndpoint(communicator, 0));
+    ControllerPrxPtr controller = ICE_UNCHECKED_CAST(ControllerPrx,
+                                                     communicator->stringToProxy("controller:" +
+                                                                                 getTestEndpoint(communicator, 0)));
+
+    cout << "testing concurrent servant lookups and updates... " << flush;
+    {
+        UpdateThreadPtr updater = new UpdateThread(controller, base);
+        updater->start();
+        test(invoke(base));
+        updater->destroy();
+        updater->getThreadControl().join();
+        test(!updater->failed());
+        test(updater->updates() > 0);
+    }
+    cout << "ok" << endl;
+
+    controller->shutdown();
+}
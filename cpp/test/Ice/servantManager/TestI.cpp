@@ -0,0 +1,39 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+TestIntfI::TestIntfI(int id) : _id(id)
+{
+}
+
+int
+TestIntfI::getId(const Ice::Current&)
+{
+    return _id;
+}
+
+void
+ControllerI::addServant(ICE_IN(std::string) name, int id, const Ice::Current& current)
+{
+    current.adapter->add(ICE_MAKE_SHARED(TestIntfI, id), Ice::stringToIdentity(name));
+}
+
+void
+ControllerI::removeServant(ICE_IN(std::string) name, const Ice::Current& current)
+{
+    current.adapter->remove(Ice::stringToIdentity(name));
+}
+
+void
+ControllerI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
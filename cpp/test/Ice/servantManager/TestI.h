@@ -0,0 +1,37 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    TestIntfI(int);
+
+    virtual int getId(const Ice::Current&);
+
+private:
+
+    const int _id;
+};
+
+class ControllerI : public Test::Controller
+{
+public:
+
+    virtual void addServant(ICE_IN(std::string), int, const Ice::Current&);
+    virtual void removeServant(ICE_IN(std::string), const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+};
+
+#endif
@@ -0,0 +1,226 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+#if defined(__linux)
+#   include <unistd.h>
+#endif
+
+using namespace std;
+using namespace Test;
+
+#if defined(__linux)
+
+namespace
+{
+
+string
+getSocketPath(const string& name)
+{
+    const char* tmpdir = getenv("TMPDIR");
+    ostringstream os;
+    os << (tmpdir && *tmpdir ? tmpdir : "/tmp") << "/ice-shm-" << name << "-" << getpid() << ".sock";
+    return os.str();
+}
+
+Ice::ByteSeq
+createPayload(size_t size, int seed)
+{
+    Ice::ByteSeq seq(size);
+    for(size_t i = 0; i < size; ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(i * 31 + seed);
+    }
+    return seq;
+}
+
+}
+
+#endif
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    RemoteCommunicatorPrxPtr server =
+        ICE_UNCHECKED_CAST(RemoteCommunicatorPrx,
+                           communicator->stringToProxy("communicator:" + getTestEndpoint(communicator, 0)));
+
+#if !defined(__linux)
+    cout << "skipping shared memory transport tests (not supported on this platform)" << endl;
+#else
+    const string path = getSocketPath("test");
+    const string endpoint = "shm -p " + path;
+
+    cout << "testing shm endpoint parsing... " << flush;
+    {
+        Ice::ObjectPrxPtr base = communicator->stringToProxy("test:" + endpoint + " -t 10000 -z");
+        test(base->ice_toString() == "test -t -e 1.1:" + endpoint + " -t 10000 -z");
+        test(communicator->stringToProxy(base->ice_toString())->ice_getEndpoints()[0]->toString() ==
+             base->ice_getEndpoints()[0]->toString());
+
+        Ice::EndpointInfoPtr info = base->ice_getEndpoints()[0]->getInfo();
+        test(ICE_DYNAMIC_CAST(Ice::ShmEndpointInfo, info));
+        test(info->type() == Ice::ShmEndpointType);
+        test(info->timeout == 10000);
+        test(info->compress);
+        test(!info->datagram());
+        test(!info->secure());
+
+        Ice::UnixEndpointInfoPtr unixInfo = ICE_DYNAMIC_CAST(Ice::UnixEndpointInfo, info->underlying);
+        test(unixInfo);
+        test(unixInfo->path == path);
+        test(unixInfo->type() == Ice::ShmEndpointType);
+
+        try
+        {
+            communicator->stringToProxy("test:shm -t 1000");
+            test(false);
+        }
+        catch(const Ice::EndpointParseException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing shm endpoint... " << flush;
+    {
+        RemoteObjectAdapterPrxPtr adapter = server->createObjectAdapter("ShmAdapter", endpoint);
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" + endpoint));
+        proxy->ping();
+        test(adapter->getTestIntf()->ice_getEndpoints()[0]->getInfo()->type() == Ice::ShmEndpointType);
+
+        Ice::ShmConnectionInfoPtr info = ICE_DYNAMIC_CAST(Ice::ShmConnectionInfo, proxy->ice_getConnection()->getInfo());
+        test(info);
+        test(!info->incoming);
+        test(info->ringSize == 1024 * 1024);
+        Ice::UnixConnectionInfoPtr unixInfo = ICE_DYNAMIC_CAST(Ice::UnixConnectionInfo, info->underlying);
+        test(unixInfo && unixInfo->path == path);
+        test(unixInfo->peerPid == proxy->getPid());
+        test(proxy->getRingSize() == 1024 * 1024);
+
+        adapter->deactivate();
+        try
+        {
+            proxy->ice_connectionId("other")->ping();
+            test(false);
+        }
+        catch(const Ice::SocketException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    //
+    // Use a small ring to exercise wrapping around the end of the ring,
+    // waiting for ring space and spilling large messages.
+    //
+    communicator->getProperties()->setProperty("Ice.Shm.RingSize", "65536");
+
+    cout << "testing ring buffers... " << flush;
+    {
+        RemoteObjectAdapterPrxPtr adapter = server->createObjectAdapter("RingAdapter", endpoint);
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" + endpoint));
+        test(proxy->getRingSize() == 65536);
+
+        const size_t sizes[] = { 0, 1, 7, 8, 9, 1000, 12345, 30000 };
+        for(int i = 0; i < 20; ++i)
+        {
+            for(size_t j = 0; j < sizeof(sizes) / sizeof(sizes[0]); ++j)
+            {
+                Ice::ByteSeq seq = createPayload(sizes[j], i);
+                test(proxy->echo(seq) == seq);
+            }
+        }
+
+        //
+        // Oneway requests fill up the ring faster than the server
+        // consumes them, the client waits for ring space.
+        //
+        TestIntfPrxPtr oneway = proxy->ice_oneway();
+        Ice::ByteSeq seq = createPayload(20000, 0);
+        for(int i = 0; i < 200; ++i)
+        {
+            oneway->sink(seq);
+        }
+        proxy->ping();
+
+        adapter->deactivate();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing spill segments... " << flush;
+    {
+        RemoteObjectAdapterPrxPtr adapter = server->createObjectAdapter("SpillAdapter", endpoint);
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" + endpoint));
+
+        const size_t sizes[] = { 40000, 65536, 200000, 4 * 1024 * 1024 };
+        for(size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+        {
+            Ice::ByteSeq seq = createPayload(sizes[i], static_cast<int>(i));
+            test(proxy->echo(seq) == seq);
+        }
+
+        //
+        // Mix spilled messages with messages sent through the ring.
+        //
+        TestIntfPrxPtr oneway = proxy->ice_oneway();
+        Ice::ByteSeq small = createPayload(1000, 1);
+        Ice::ByteSeq large = createPayload(100000, 2);
+        for(int i = 0; i < 100; ++i)
+        {
+            oneway->sink(i % 2 ? small : large);
+        }
+        test(proxy->echo(small) == small);
+
+        //
+        // The server doesn't read while the adapter is on hold, the client
+        // waits for ring space and for the descriptors to be consumed. It's
+        // woken up by the server once the adapter is activated.
+        //
+        adapter->hold();
+#ifdef ICE_CPP11_MAPPING
+        vector<future<void>> results;
+        for(int i = 0; i < 50; ++i)
+        {
+            results.push_back(oneway->sinkAsync(i % 2 ? small : large));
+        }
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+        adapter->activate();
+        for(vector<future<void>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            p->get();
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < 50; ++i)
+        {
+            results.push_back(oneway->begin_sink(i % 2 ? small : large));
+        }
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(200));
+        adapter->activate();
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            oneway->end_sink(*p);
+        }
+#endif
+        test(proxy->echo(large) == large);
+
+        adapter->deactivate();
+    }
+    cout << "ok" << endl;
+
+    communicator->getProperties()->setProperty("Ice.Shm.RingSize", "");
+
+#endif
+
+    server->shutdown();
+}
@@ -0,0 +1,98 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+#ifndef _WIN32
+#   include <unistd.h>
+#endif
+
+void
+TestIntfI::ping(const Ice::Current&)
+{
+}
+
+Ice::ByteSeq
+TestIntfI::echo(ICE_IN(Ice::ByteSeq) seq, const Ice::Current&)
+{
+    return seq;
+}
+
+void
+TestIntfI::sink(ICE_IN(Ice::ByteSeq), const Ice::Current&)
+{
+}
+
+Ice::Int
+TestIntfI::getRingSize(const Ice::Current& current)
+{
+    Ice::ShmConnectionInfoPtr info = ICE_DYNAMIC_CAST(Ice::ShmConnectionInfo, current.con->getInfo());
+    return info ? info->ringSize : -1;
+}
+
+Ice::Int
+TestIntfI::getPid(const Ice::Current&)
+{
+#ifdef _WIN32
+    return -1;
+#else
+    return static_cast<Ice::Int>(getpid());
+#endif
+}
+
+RemoteObjectAdapterI::RemoteObjectAdapterI(const Ice::ObjectAdapterPtr& adapter) :
+    _adapter(adapter),
+    _testIntf(ICE_UNCHECKED_CAST(Test::TestIntfPrx,
+                                 _adapter->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("test"))))
+{
+    _adapter->activate();
+}
+
+Test::TestIntfPrxPtr
+RemoteObjectAdapterI::getTestIntf(const Ice::Current&)
+{
+    return _testIntf;
+}
+
+void
+RemoteObjectAdapterI::hold(const Ice::Current&)
+{
+    _adapter->hold();
+    _adapter->waitForHold();
+}
+
+void
+RemoteObjectAdapterI::activate(const Ice::Current&)
+{
+    _adapter->activate();
+}
+
+void
+RemoteObjectAdapterI::deactivate(const Ice::Current& current)
+{
+    _adapter->destroy();
+    current.adapter->remove(current.id);
+}
+
+Test::RemoteObjectAdapterPrxPtr
+RemoteCommunicatorI::createObjectAdapter(ICE_IN(std::string) name, ICE_IN(std::string) endpoints,
+                                         const Ice::Current& current)
+{
+    Ice::ObjectAdapterPtr adapter =
+        current.adapter->getCommunicator()->createObjectAdapterWithEndpoints(name, endpoints);
+    Ice::ObjectPrxPtr proxy = current.adapter->addWithUUID(ICE_MAKE_SHARED(RemoteObjectAdapterI, adapter));
+    return ICE_UNCHECKED_CAST(Test::RemoteObjectAdapterPrx, proxy);
+}
+
+void
+RemoteCommunicatorI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,52 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    virtual void ping(const Ice::Current&);
+    virtual Ice::ByteSeq echo(ICE_IN(Ice::ByteSeq), const Ice::Current&);
+    virtual void sink(ICE_IN(Ice::ByteSeq), const Ice::Current&);
+    virtual Ice::Int getRingSize(const Ice::Current&);
+    virtual Ice::Int getPid(const Ice::Current&);
+};
+
+class RemoteObjectAdapterI : public Test::RemoteObjectAdapter
+{
+public:
+
+    RemoteObjectAdapterI(const Ice::ObjectAdapterPtr&);
+
+    virtual Test::TestIntfPrxPtr getTestIntf(const Ice::Current&);
+    virtual void hold(const Ice::Current&);
+    virtual void activate(const Ice::Current&);
+    virtual void deactivate(const Ice::Current&);
+
+private:
+
+    const Ice::ObjectAdapterPtr _adapter;
+    const Test::TestIntfPrxPtr _testIntf;
+};
+
+class RemoteCommunicatorI : public Test::RemoteCommunicator
+{
+public:
+
+    virtual Test::RemoteObjectAdapterPrxPtr createObjectAdapter(ICE_IN(std::string), ICE_IN(std::string),
+                                                                const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+};
+
+#endif
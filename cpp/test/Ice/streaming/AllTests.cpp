@@ -0,0 +1,246 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Monitor.h>
+#include <TestCommon.h>
+#include <TestI.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+void
+testStreams(const TestIntfPrxPtr& proxy)
+{
+    const Ice::Long sizes[] = { 0, 1, 1024, 100 * 1024 + 7, 3 * 1024 * 1024 };
+    for(size_t i = 0; i < sizeof(sizes) / sizeof(Ice::Long); ++i)
+    {
+        test(proxy->upload(ICE_MAKE_SHARED(PatternSource, sizes[i])) == sizes[i]);
+        test(readPattern(proxy->download(sizes[i])) == sizes[i]);
+        test(readPattern(proxy->echo(ICE_MAKE_SHARED(PatternSource, sizes[i]))) == sizes[i]);
+    }
+}
+
+//
+// A pattern source whose first read blocks until release() is called.
+//
+class BlockingSource : public PatternSource, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    BlockingSource(Ice::Long size) : PatternSource(size), _blocked(false), _released(false)
+    {
+    }
+
+    virtual bool
+    read(vector<Ice::Byte>& data, Ice::Int maxSize)
+    {
+        {
+            Lock sync(*this);
+            _blocked = true;
+            notifyAll();
+            while(!_released)
+            {
+                wait();
+            }
+        }
+        return PatternSource::read(data, maxSize);
+    }
+
+    void
+    waitBlocked()
+    {
+        Lock sync(*this);
+        while(!_blocked)
+        {
+            wait();
+        }
+    }
+
+    void
+    release()
+    {
+        Lock sync(*this);
+        _released = true;
+        notifyAll();
+    }
+
+private:
+
+    bool _blocked;
+    bool _released;
+};
+ICE_DEFINE_PTR(BlockingSourcePtr, BlockingSource);
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx,
+        communicator->stringToProxy("test:" + getTestEndpoint(communicator, 0)));
+
+    cout << "testing streamed sequences... " << flush;
+    testStreams(proxy);
+    cout << "ok" << endl;
+
+    cout << "testing concurrent streamed sequences... " << flush;
+    {
+        //
+        // The uploads are dispatched at the same time, each of them waits
+        // for its chunks.
+        //
+        const Ice::Long size = 1024 * 1024;
+#ifdef ICE_CPP11_MAPPING
+        vector<future<long long int>> results;
+        for(int i = 0; i < 5; ++i)
+        {
+            results.push_back(proxy->uploadAsync(ICE_MAKE_SHARED(PatternSource, size)));
+        }
+        for(vector<future<long long int>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            test(p->get() == size);
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(int i = 0; i < 5; ++i)
+        {
+            results.push_back(proxy->begin_upload(ICE_MAKE_SHARED(PatternSource, size)));
+        }
+        for(vector<Ice::AsyncResultPtr>::const_iterator p = results.begin(); p != results.end(); ++p)
+        {
+            test(proxy->end_upload(*p) == size);
+        }
+#endif
+    }
+    cout << "ok" << endl;
+
+    cout << "testing aborted streams... " << flush;
+    {
+        //
+        // The server reads the data of an upload aborted by a failure of
+        // the source up to the failure.
+        //
+        test(proxy->upload(ICE_MAKE_SHARED(PatternSource, 1024 * 1024, true)) == -1);
+
+        //
+        // A download source released before all the data is read aborts
+        // the transfer, the connection remains usable.
+        //
+        Ice::ByteSourcePtr source = proxy->download(100 * 1024 * 1024);
+        vector<Ice::Byte> data;
+        test(source->read(data, 1024) && data.size() <= 1024);
+        source = ICE_NULLPTR;
+        Ice::ConnectionPtr connection = proxy->ice_getConnection();
+        test(proxy->upload(ICE_MAKE_SHARED(PatternSource, 1024)) == 1024);
+        test(proxy->ice_getConnection() == connection);
+
+        //
+        // A download source raises the exception which closed the
+        // connection.
+        //
+        source = proxy->download(100 * 1024 * 1024);
+        connection->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, Forcefully));
+        try
+        {
+            while(source->read(data, 1024 * 1024));
+            test(false);
+        }
+        catch(const Ice::LocalException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing oneway streamed sequences... " << flush;
+    {
+        //
+        // Oneway requests are sent with the data inline.
+        //
+        proxy->ice_oneway()->push(ICE_MAKE_SHARED(PatternSource, 1000));
+        proxy->ice_oneway()->push(ICE_MAKE_SHARED(PatternSource, 2000));
+        for(int i = 0; i < 100 && proxy->getPushed() != 3000; ++i)
+        {
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+        }
+        test(proxy->getPushed() == 3000);
+
+        try
+        {
+            proxy->ice_oneway()->push(ICE_MAKE_SHARED(PatternSource, 1024, true));
+            test(false);
+        }
+        catch(const Ice::MarshalException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing stream thread pool limit... " << flush;
+    {
+        //
+        // The thread of the stream thread pool is busy with the blocked
+        // upload, the stream of the second upload is rejected and aborted.
+        //
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.StreamThreadPool.SizeMax", "1");
+        Ice::CommunicatorPtr client = Ice::initialize(initData);
+        TestIntfPrxPtr prx = ICE_UNCHECKED_CAST(TestIntfPrx,
+            client->stringToProxy("test:" + getTestEndpoint(client, 0)));
+        const Ice::Long size = 100 * 1024;
+        BlockingSourcePtr blocking = ICE_MAKE_SHARED(BlockingSource, size);
+#ifdef ICE_CPP11_MAPPING
+        future<long long int> result = prx->uploadAsync(blocking);
+#else
+        Ice::AsyncResultPtr result = prx->begin_upload(blocking);
+#endif
+        blocking->waitBlocked();
+        test(prx->upload(ICE_MAKE_SHARED(PatternSource, size)) == -1);
+        blocking->release();
+#ifdef ICE_CPP11_MAPPING
+        test(result.get() == size);
+#else
+        test(prx->end_upload(result) == size);
+#endif
+
+        //
+        // The thread is available again once it's done with the blocked
+        // upload, it might still be returning when the reply is received.
+        //
+        Ice::Long uploaded = -1;
+        for(int i = 0; i < 100 && uploaded == -1; ++i)
+        {
+            uploaded = prx->upload(ICE_MAKE_SHARED(PatternSource, size));
+            if(uploaded == -1)
+            {
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+            }
+        }
+        test(uploaded == size);
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing collocated streamed sequences... " << flush;
+    {
+        Ice::ObjectAdapterPtr collocated = communicator->createObjectAdapter("");
+        TestIntfPrxPtr prx = ICE_UNCHECKED_CAST(TestIntfPrx,
+            collocated->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("collocated")));
+        testStreams(prx);
+        test(prx->upload(ICE_MAKE_SHARED(PatternSource, 1024 * 1024, true)) == -1);
+        collocated->destroy();
+    }
+    cout << "ok" << endl;
+
+    proxy->shutdown();
+}
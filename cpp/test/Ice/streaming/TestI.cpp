@@ -0,0 +1,108 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+PatternSource::PatternSource(Ice::Long size, bool fail) :
+    _size(size),
+    _fail(fail),
+    _pos(0)
+{
+}
+
+bool
+PatternSource::read(vector<Ice::Byte>& data, Ice::Int maxSize)
+{
+    if(_fail && _pos >= _size / 2)
+    {
+        throw runtime_error("source failure");
+    }
+
+    data.resize(static_cast<size_t>(min(static_cast<Ice::Long>(maxSize), _size - _pos)));
+    for(vector<Ice::Byte>::iterator p = data.begin(); p != data.end(); ++p)
+    {
+        *p = static_cast<Ice::Byte>(_pos++ % 251);
+    }
+    return !data.empty();
+}
+
+Ice::Long
+readPattern(const Ice::ByteSourcePtr& source)
+{
+    Ice::Long pos = 0;
+    bool valid = true;
+    vector<Ice::Byte> data;
+    while(source->read(data, 16 * 1024))
+    {
+        for(vector<Ice::Byte>::const_iterator p = data.begin(); p != data.end(); ++p)
+        {
+            valid = valid && *p == static_cast<Ice::Byte>(pos % 251);
+            ++pos;
+        }
+    }
+    return valid ? pos : -1;
+}
+
+TestIntfI::TestIntfI() :
+    _pushed(0)
+{
+}
+
+Ice::Long
+TestIntfI::upload(ICE_IN(Ice::ByteSourcePtr) data, const Ice::Current&)
+{
+    try
+    {
+        return readPattern(data);
+    }
+    catch(const std::exception&)
+    {
+        //
+        // The upload was aborted by the client, or the source raised
+        // an exception with a collocated invocation.
+        //
+        return -1;
+    }
+}
+
+Ice::ByteSourcePtr
+TestIntfI::download(Ice::Long size, const Ice::Current&)
+{
+    return ICE_MAKE_SHARED(PatternSource, size);
+}
+
+Ice::ByteSourcePtr
+TestIntfI::echo(ICE_IN(Ice::ByteSourcePtr) data, const Ice::Current&)
+{
+    return data;
+}
+
+void
+TestIntfI::push(ICE_IN(Ice::ByteSourcePtr) data, const Ice::Current&)
+{
+    Ice::Long size = readPattern(data);
+    IceUtil::Mutex::Lock sync(_mutex);
+    _pushed += size;
+}
+
+Ice::Long
+TestIntfI::getPushed(const Ice::Current&)
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    return _pushed;
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,65 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+#include <IceUtil/Mutex.h>
+
+//
+// A source of size bytes, byte i is i % 251. If fail is true, read()
+// raises an exception once half of the data is read.
+//
+class PatternSource : public Ice::ByteSource
+{
+public:
+
+    PatternSource(Ice::Long, bool = false);
+
+    virtual bool read(std::vector<Ice::Byte>&, Ice::Int);
+
+private:
+
+    const Ice::Long _size;
+    const bool _fail;
+    Ice::Long _pos;
+};
+
+//
+// Reads the given source and returns the number of bytes read, or -1
+// if the data doesn't match the pattern of PatternSource.
+//
+Ice::Long readPattern(const Ice::ByteSourcePtr&);
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    TestIntfI();
+
+    virtual Ice::Long upload(ICE_IN(Ice::ByteSourcePtr), const Ice::Current&);
+
+    virtual Ice::ByteSourcePtr download(Ice::Long, const Ice::Current&);
+
+    virtual Ice::ByteSourcePtr echo(ICE_IN(Ice::ByteSourcePtr), const Ice::Current&);
+
+    virtual void push(ICE_IN(Ice::ByteSourcePtr), const Ice::Current&);
+
+    virtual Ice::Long getPushed(const Ice::Current&);
+
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    IceUtil::Mutex _mutex;
+    Ice::Long _pushed;
+};
+
+#endif
@@ -0,0 +1,152 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+
+namespace
+{
+
+class LoggerI : public Ice::Logger,
+                private IceUtil::Mutex
+#ifdef ICE_CPP11_MAPPING
+              , public std::enable_shared_from_this<LoggerI>
+#endif
+{
+public:
+
+    virtual void
+    print(const string&)
+    {
+    }
+
+    virtual void
+    trace(const string&, const string&)
+    {
+    }
+
+    virtual void
+    warning(const string& message)
+    {
+        Lock sync(*this);
+        _messages.push_back("warning: " + message);
+    }
+
+    virtual void
+    error(const string& message)
+    {
+        Lock sync(*this);
+        _messages.push_back("error: " + message);
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return ICE_SHARED_FROM_THIS;
+    }
+
+    bool
+    contains(const string& str)
+    {
+        Lock sync(*this);
+        for(vector<string>::const_iterator p = _messages.begin(); p != _messages.end(); ++p)
+        {
+            if(p->find(str) != string::npos)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+
+    vector<string> _messages;
+};
+ICE_DEFINE_PTR(LoggerIPtr, LoggerI);
+
+void
+testEcho(const Test::EchoPrxPtr& echo)
+{
+    echo->ice_ping();
+    echo->ping();
+
+    Ice::ByteSeq seq;
+    test(echo->echoBytes(seq).empty());
+    for(int size = 1; size < 1024 * 1024; size *= 4)
+    {
+        seq.resize(size);
+        for(int i = 0; i < size; ++i)
+        {
+            seq[i] = static_cast<Ice::Byte>(i);
+        }
+        test(echo->echoBytes(seq) == seq);
+    }
+}
+
+}
+
+Test::EchoPrxPtr
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    Test::EchoPrxPtr echo = ICE_UNCHECKED_CAST(Test::EchoPrx,
+                                               communicator->stringToProxy("test:" +
+                                                                           getTestEndpoint(communicator, 0)));
+
+    //
+    // Use a separate communicator for the io_uring backend, its client thread
+    // pool also uses io_uring to read replies. The logger tells whether the
+    // thread pool fell back to the default backend.
+    //
+    LoggerIPtr logger = ICE_MAKE_SHARED(LoggerI);
+    Ice::InitializationData initData;
+    initData.logger = logger;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.ThreadPool.Client.Backend", "io_uring");
+    Ice::CommunicatorPtr ioUringCommunicator = Ice::initialize(initData);
+    Test::EchoPrxPtr ioUringEcho = ICE_UNCHECKED_CAST(Test::EchoPrx,
+                                                      ioUringCommunicator->stringToProxy("test:" +
+                                                          getTestEndpoint(communicator, 1)));
+
+    cout << "testing default backend... " << flush;
+    testEcho(echo);
+    cout << "ok" << endl;
+
+    cout << "testing io_uring backend... " << flush;
+    testEcho(ioUringEcho);
+    bool ioUring = !logger->contains("io_uring");
+    if(ioUring)
+    {
+        cout << "ok" << endl;
+    }
+    else
+    {
+        cout << "skipped (io_uring not available, using the default backend)" << endl;
+    }
+
+    cout << "testing connection closure with io_uring backend... " << flush;
+    for(int i = 0; i < 20; ++i)
+    {
+        ioUringEcho->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+        ioUringEcho->ping();
+    }
+    cout << "ok" << endl;
+
+    ioUringCommunicator->destroy();
+    return echo;
+}
@@ -0,0 +1,73 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+#include <TestCommon.h>
+
+DEFINE_TEST("server")
+
+using namespace std;
+
+int
+run(int, char**, const Ice::CommunicatorPtr& communicator)
+{
+    //
+    // Each adapter has its own thread pool, the first one uses the default
+    // selector and the second one uses io_uring.
+    //
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    properties->setProperty("DefaultAdapter.Endpoints", getTestEndpoint(communicator, 0));
+    properties->setProperty("DefaultAdapter.ThreadPool.Size", "1");
+    properties->setProperty("IoUringAdapter.Endpoints", getTestEndpoint(communicator, 1));
+    properties->setProperty("IoUringAdapter.ThreadPool.Size", "1");
+    properties->setProperty("IoUringAdapter.ThreadPool.Backend", "io_uring");
+
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("DefaultAdapter");
+    adapter->add(ICE_MAKE_SHARED(EchoI), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    adapter = communicator->createObjectAdapter("IoUringAdapter");
+    adapter->add(ICE_MAKE_SHARED(EchoI), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    TEST_READY
+    communicator->waitForShutdown();
+    return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[])
+{
+#ifdef ICE_STATIC_LIBS
+    Ice::registerIceSSL(false);
+#endif
+
+    int status;
+    Ice::CommunicatorPtr communicator;
+
+    try
+    {
+        Ice::InitializationData initData = getTestInitData(argc, argv);
+        communicator = Ice::initialize(argc, argv, initData);
+        status = run(argc, argv, communicator);
+    }
+    catch(const Ice::Exception& ex)
+    {
+        cerr << ex << endl;
+        status = EXIT_FAILURE;
+    }
+
+    if(communicator)
+    {
+        communicator->destroy();
+    }
+
+    return status;
+}
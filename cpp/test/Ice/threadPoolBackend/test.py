@@ -0,0 +1,16 @@
+# **********************************************************************
+#
+# Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+#
+# This copy of Ice is licensed to you under the terms described in the
+# ICE_LICENSE file included in this distribution.
+#
+# **********************************************************************
+
+#
+# The io_uring backend is only available on Linux, on other platforms (or
+# if Ice is built without USE_IO_URING) the thread pools fall back to the
+# default selector.
+#
+if isinstance(platform, Linux):
+    TestSuite(__file__, [ ClientServerTestCase() ], options={ "mx" : [False] })
@@ -0,0 +1,154 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+const int connectionCount = 16;
+
+bool
+contains(const Ice::StringSeq& messages, const string& str)
+{
+    for(Ice::StringSeq::const_iterator p = messages.begin(); p != messages.end(); ++p)
+    {
+        if(p->find(str) != string::npos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+RemoteCommunicatorPrxPtr
+createServer(const RemoteCommunicatorFactoryPrxPtr& factory, int num, int shards, const string& affinity)
+{
+    ostringstream os;
+    os << shards;
+    Ice::PropertyDict props;
+    props["Ice.Trace.ThreadPool"] = "1";
+    props["TestAdapter.Endpoints"] = getTestEndpoint(factory->ice_getCommunicator(), num);
+    props["TestAdapter.ThreadPool.Size"] = "2";
+    props["TestAdapter.ThreadPool.Shards"] = os.str();
+    props["TestAdapter.ThreadPool.CpuAffinity"] = affinity;
+    return factory->createCommunicator(props);
+}
+
+vector<TestIntfPrxPtr>
+createProxies(const Ice::CommunicatorPtr& communicator, int num, int count)
+{
+    TestIntfPrxPtr base = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                             communicator->stringToProxy("test:" +
+                                                                         getTestEndpoint(communicator, num)));
+    vector<TestIntfPrxPtr> proxies;
+    for(int i = 0; i < count; ++i)
+    {
+        ostringstream os;
+        os << "connection-" << i;
+        proxies.push_back(ICE_UNCHECKED_CAST(TestIntfPrx, base->ice_connectionId(os.str())));
+    }
+    return proxies;
+}
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    RemoteCommunicatorFactoryPrxPtr factory =
+        ICE_UNCHECKED_CAST(RemoteCommunicatorFactoryPrx,
+                           communicator->stringToProxy("factory:" + getTestEndpoint(communicator, 0)));
+
+    cout << "testing sharded thread pools... " << flush;
+    {
+        RemoteCommunicatorPrxPtr server = createServer(factory, 1, 4, "");
+        test(contains(server->getLogMessages(),
+                      "creating TestAdapter.ThreadPool: Size = 2, SizeMax = 2, SizeWarn = 0, Shards = 4"));
+
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ThreadPool.Client.Shards", "3");
+        Ice::CommunicatorPtr client = Ice::initialize(initData);
+
+        //
+        // Open and close the connections several times to check that
+        // connections keep being spread over the shards.
+        //
+        for(int i = 0; i < 3; ++i)
+        {
+            vector<TestIntfPrxPtr> proxies = createProxies(client, 1, connectionCount);
+            for(vector<TestIntfPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+            {
+                (*p)->ping();
+            }
+            for(vector<TestIntfPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+            {
+                (*p)->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+            }
+        }
+
+        client->destroy();
+        server->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing CPU affinity... " << flush;
+    {
+        RemoteCommunicatorPrxPtr server = createServer(factory, 1, 1, "foo");
+        test(contains(server->getLogMessages(), "warning: TestAdapter.ThreadPool.CpuAffinity"));
+        server->destroy();
+
+#ifdef __linux
+        const int shardCounts[] = { 1, 2 };
+        for(int i = 0; i < 2; ++i)
+        {
+            server = createServer(factory, 1, shardCounts[i], "0");
+            Ice::StringSeq messages = server->getLogMessages();
+            test(contains(messages, "CpuAffinity = 0"));
+            test(!contains(messages, "warning:"));
+
+            vector<TestIntfPrxPtr> proxies = createProxies(communicator, 1, 4);
+            for(vector<TestIntfPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+            {
+                test((*p)->getCpu() == 0);
+            }
+            server->destroy();
+        }
+#endif
+    }
+    cout << "ok" << endl;
+
+    cout << "testing server idle time with sharded thread pool... " << flush;
+    {
+        Ice::PropertyDict props;
+        props["Ice.ServerIdleTime"] = "1";
+        props["Ice.ThreadPool.Server.Shards"] = "2";
+        props["TestAdapter.Endpoints"] = getTestEndpoint(communicator, 1);
+        RemoteCommunicatorPrxPtr server = factory->createCommunicator(props);
+
+        vector<TestIntfPrxPtr> proxies = createProxies(communicator, 1, 2);
+        for(vector<TestIntfPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+        {
+            (*p)->ping();
+            (*p)->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+        }
+
+        server->waitForShutdown();
+        server->destroy();
+    }
+    cout << "ok" << endl;
+
+    factory->shutdown();
+}
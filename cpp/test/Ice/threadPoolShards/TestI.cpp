@@ -0,0 +1,135 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+#ifdef __linux
+#   include <sched.h>
+#endif
+
+void
+TestIntfI::ping(const Ice::Current&)
+{
+}
+
+int
+TestIntfI::getCpu(const Ice::Current&)
+{
+#ifdef __linux
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+void
+LoggerI::print(const std::string&)
+{
+}
+
+void
+LoggerI::trace(const std::string&, const std::string& message)
+{
+    Lock sync(*this);
+    _messages.push_back(message);
+}
+
+void
+LoggerI::warning(const std::string& message)
+{
+    Lock sync(*this);
+    _messages.push_back("warning: " + message);
+}
+
+void
+LoggerI::error(const std::string& message)
+{
+    Lock sync(*this);
+    _messages.push_back("error: " + message);
+}
+
+std::string
+LoggerI::getPrefix()
+{
+    return "";
+}
+
+Ice::LoggerPtr
+LoggerI::cloneWithPrefix(const std::string&)
+{
+    return ICE_SHARED_FROM_THIS;
+}
+
+Ice::StringSeq
+LoggerI::getMessages()
+{
+    Lock sync(*this);
+    return _messages;
+}
+
+RemoteCommunicatorI::RemoteCommunicatorI(const Ice::CommunicatorPtr& communicator, const LoggerIPtr& logger) :
+    _communicator(communicator),
+    _logger(logger)
+{
+}
+
+Ice::StringSeq
+RemoteCommunicatorI::getLogMessages(const Ice::Current&)
+{
+    return _logger->getMessages();
+}
+
+void
+RemoteCommunicatorI::waitForShutdown(const Ice::Current&)
+{
+    //
+    // Note that we are executing in a thread of the *main* communicator,
+    // not the one that is being shut down.
+    //
+    _communicator->waitForShutdown();
+}
+
+void
+RemoteCommunicatorI::destroy(const Ice::Current& current)
+{
+    _communicator->destroy();
+    current.adapter->remove(current.id);
+}
+
+Test::RemoteCommunicatorPrxPtr
+RemoteCommunicatorFactoryI::createCommunicator(ICE_IN(Ice::PropertyDict) props, const Ice::Current& current)
+{
+    //
+    // The properties of the main communicator provide the protocol
+    // configuration.
+    //
+    Ice::InitializationData initData;
+    initData.properties = current.adapter->getCommunicator()->getProperties()->clone();
+    for(Ice::PropertyDict::const_iterator p = props.begin(); p != props.end(); ++p)
+    {
+        initData.properties->setProperty(p->first, p->second);
+    }
+    LoggerIPtr logger = ICE_MAKE_SHARED(LoggerI);
+    initData.logger = logger;
+    Ice::CommunicatorPtr communicator = Ice::initialize(initData);
+
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("test"));
+    adapter->activate();
+
+    Ice::ObjectPrxPtr proxy = current.adapter->addWithUUID(ICE_MAKE_SHARED(RemoteCommunicatorI, communicator, logger));
+    return ICE_UNCHECKED_CAST(Test::RemoteCommunicatorPrx, proxy);
+}
+
+void
+RemoteCommunicatorFactoryI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
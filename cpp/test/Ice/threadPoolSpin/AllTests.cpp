@@ -0,0 +1,230 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+namespace
+{
+
+const int threadCount = 4;
+
+class LoggerI : public Ice::Logger,
+                private IceUtil::Mutex
+#ifdef ICE_CPP11_MAPPING
+              , public std::enable_shared_from_this<LoggerI>
+#endif
+{
+public:
+
+    virtual void
+    print(const string&)
+    {
+    }
+
+    virtual void
+    trace(const string&, const string& message)
+    {
+        Lock sync(*this);
+        _messages.push_back(message);
+    }
+
+    virtual void
+    warning(const string& message)
+    {
+        Lock sync(*this);
+        _messages.push_back("warning: " + message);
+    }
+
+    virtual void
+    error(const string& message)
+    {
+        Lock sync(*this);
+        _messages.push_back("error: " + message);
+    }
+
+    virtual string
+    getPrefix()
+    {
+        return "";
+    }
+
+    virtual Ice::LoggerPtr
+    cloneWithPrefix(const string&)
+    {
+        return ICE_SHARED_FROM_THIS;
+    }
+
+    bool
+    contains(const string& str)
+    {
+        Lock sync(*this);
+        for(vector<string>::const_iterator p = _messages.begin(); p != _messages.end(); ++p)
+        {
+            if(p->find(str) != string::npos)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+
+    vector<string> _messages;
+};
+ICE_DEFINE_PTR(LoggerIPtr, LoggerI);
+
+Ice::CommunicatorPtr
+createCommunicator(const Ice::CommunicatorPtr& communicator, const string& pool, const string& spinMicros,
+                   const LoggerIPtr& logger = 0)
+{
+    Ice::InitializationData initData;
+    initData.properties = communicator->getProperties()->clone();
+    initData.properties->setProperty("Ice.ThreadPool." + pool + ".SpinMicros", spinMicros);
+    initData.properties->setProperty("Ice.Trace.ThreadPool", "1");
+    initData.logger = logger ? logger : ICE_MAKE_SHARED(LoggerI);
+    return Ice::initialize(initData);
+}
+
+EchoPrxPtr
+createProxy(const Ice::CommunicatorPtr& communicator, int num)
+{
+    return ICE_UNCHECKED_CAST(EchoPrx, communicator->stringToProxy("test:" + getTestEndpoint(communicator, num)));
+}
+
+class InvokeThread : public IceUtil::Thread
+{
+public:
+
+    InvokeThread(const EchoPrxPtr& echo) : _echo(echo), _failed(false)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        try
+        {
+            Ice::ByteSeq seq(1024, 1);
+            for(int i = 0; i < 1000; ++i)
+            {
+                if(i % 10 == 0)
+                {
+                    test(_echo->echoBytes(seq) == seq);
+                }
+                else
+                {
+                    _echo->ping();
+                }
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            cerr << ex.what() << endl;
+            _failed = true;
+        }
+    }
+
+    bool
+    failed() const
+    {
+        return _failed;
+    }
+
+private:
+
+    const EchoPrxPtr _echo;
+    bool _failed;
+};
+typedef IceUtil::Handle<InvokeThread> InvokeThreadPtr;
+
+}
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    cout << "testing SpinMicros configuration... " << flush;
+    {
+        LoggerIPtr logger = ICE_MAKE_SHARED(LoggerI);
+        createCommunicator(communicator, "Client", "-1", logger)->destroy();
+        test(logger->contains("warning: Ice.ThreadPool.Client.SpinMicros < 0"));
+
+        logger = ICE_MAKE_SHARED(LoggerI);
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ThreadPool.Client.BusyPoll", "1");
+        initData.logger = logger;
+        Ice::initialize(initData)->destroy();
+        test(logger->contains("warning: Ice.ThreadPool.Client.BusyPoll: requires"));
+
+        logger = ICE_MAKE_SHARED(LoggerI);
+        createCommunicator(communicator, "Client", "50", logger)->destroy();
+#if defined(_WIN32)
+        test(logger->contains("warning: Ice.ThreadPool.Client.SpinMicros: not supported"));
+#else
+        test(logger->contains("creating Ice.ThreadPool.Client: Size = 1, SizeMax = 1, SizeWarn = 0, SpinMicros = 50"));
+#endif
+    }
+    cout << "ok" << endl;
+
+    cout << "testing spinning thread pools... " << flush;
+    {
+        Ice::CommunicatorPtr client = createCommunicator(communicator, "Client", "50");
+
+        vector<InvokeThreadPtr> threads;
+        for(int i = 0; i < threadCount; ++i)
+        {
+            ostringstream os;
+            os << "connection-" << i;
+            threads.push_back(new InvokeThread(ICE_UNCHECKED_CAST(EchoPrx,
+                                                                  createProxy(client, 1)->ice_connectionId(os.str()))));
+        }
+        for(vector<InvokeThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+        {
+            (*p)->start();
+        }
+        for(vector<InvokeThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+        {
+            (*p)->getThreadControl().join();
+            test(!(*p)->failed());
+        }
+
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing busy polling... " << flush;
+    {
+        LoggerIPtr logger = ICE_MAKE_SHARED(LoggerI);
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ThreadPool.Client.SpinMicros", "50");
+        initData.properties->setProperty("Ice.ThreadPool.Client.BusyPoll", "1");
+        initData.logger = logger;
+        Ice::CommunicatorPtr client = Ice::initialize(initData);
+
+        //
+        // Busy polling requires privileges on some systems, in which case
+        // a warning is logged and the socket is used without it.
+        //
+        createProxy(client, 0)->ping();
+        test(!logger->contains("warning:") || logger->contains("warning: unable to enable busy polling"));
+
+        client->destroy();
+    }
+    cout << "ok" << endl;
+
+    createProxy(communicator, 0)->shutdown();
+}
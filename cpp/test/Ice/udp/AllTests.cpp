@@ -134,6 +134,64 @@ allTests(const CommunicatorPtr& communicator)
 
     cout << "ok" << endl;
 
+    cout << "testing udp with batched datagrams... " << flush;
+    {
+        //
+        // With Ice.UDP.BatchSize, bursts of datagrams are received with
+        // recvmmsg and queued datagrams are sent with sendmmsg (Linux only,
+        // the property is ignored otherwise).
+        //
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.UDP.BatchSize", "32");
+        initData.properties->setProperty("Ice.UDP.RcvSize", ""); // Large enough for the bursts below.
+        initData.properties->setProperty("BatchReplyAdapter.Endpoints", "udp");
+        Ice::CommunicatorPtr batchCommunicator = Ice::initialize(initData);
+        ObjectAdapterPtr batchAdapter = batchCommunicator->createObjectAdapter("BatchReplyAdapter");
+        batchAdapter->activate();
+
+        TestIntfPrxPtr batchObj = ICE_UNCHECKED_CAST(TestIntfPrx, batchCommunicator->stringToProxy(
+                                                         "test -d:" + getTestEndpoint(communicator, 0, "udp")));
+        const int count = 100;
+        nRetry = 5;
+        while(nRetry-- > 0)
+        {
+            PingReplyIPtr batchReplyI = ICE_MAKE_SHARED(PingReplyI);
+            batchReplyI->reset();
+            PingReplyPrxPtr batchReply =
+                ICE_UNCHECKED_CAST(PingReplyPrx, batchAdapter->addWithUUID(batchReplyI))->ice_datagram();
+            PingReplyPrxPtr sender = ICE_UNCHECKED_CAST(PingReplyPrx,
+                                                        batchCommunicator->stringToProxy(
+                                                            batchCommunicator->proxyToString(batchReply)));
+            sender = sender->ice_collocationOptimized(false);
+
+            //
+            // A burst of datagrams sent directly to the batched adapter and
+            // a few replies from the server. The burst is sent asynchronously,
+            // datagrams are queued if the socket isn't ready for write.
+            //
+            for(int i = 0; i < count; ++i)
+            {
+#ifdef ICE_CPP11_MAPPING
+                sender->replyAsync();
+#else
+                sender->begin_reply();
+#endif
+            }
+            batchObj->ping(batchReply);
+            batchObj->ping(batchReply);
+            batchObj->ping(batchReply);
+            ret = batchReplyI->waitReply(count + 3, IceUtil::Time::seconds(2));
+            if(ret)
+            {
+                break; // Success
+            }
+        }
+        test(ret);
+        batchCommunicator->destroy();
+    }
+    cout << "ok" << endl;
+
     ostringstream endpoint;
     if(communicator->getProperties()->getProperty("Ice.IPv6") == "1")
     {
@@ -0,0 +1,254 @@
+// **********************************************************************
+//
+// Copyright (c) 2003-2017 ZeroC, Inc. All rights reserved.
+//
+// This copy of Ice is licensed to you under the terms described in the
+// ICE_LICENSE file included in this distribution.
+//
+// **********************************************************************
+
+#include <Ice/Ice.h>
+#include <TestCommon.h>
+#include <Test.h>
+
+#ifndef _WIN32
+#   include <unistd.h>
+#   include <sys/socket.h>
+#   include <sys/stat.h>
+#   include <sys/un.h>
+#endif
+
+using namespace std;
+using namespace Test;
+
+#ifndef _WIN32
+
+namespace
+{
+
+string
+getSocketPath(const string& name)
+{
+    const char* tmpdir = getenv("TMPDIR");
+    ostringstream os;
+    os << (tmpdir && *tmpdir ? tmpdir : "/tmp") << "/ice-unix-" << name << "-" << getpid() << ".sock";
+    return os.str();
+}
+
+bool
+fileExists(const string& path)
+{
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+//
+// Create a socket file nobody listens on, as left behind by a process
+// which crashed without closing its acceptor.
+//
+void
+createStaleSocket(const string& path)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    test(fd >= 0);
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    test(::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    ::close(fd);
+    test(fileExists(path));
+}
+
+}
+
+#endif
+
+void
+allTests(const Ice::CommunicatorPtr& communicator)
+{
+    RemoteCommunicatorPrxPtr server =
+        ICE_UNCHECKED_CAST(RemoteCommunicatorPrx,
+                           communicator->stringToProxy("communicator:" + getTestEndpoint(communicator, 0)));
+
+#ifdef _WIN32
+    cout << "skipping unix domain socket tests (not supported on this platform)" << endl;
+#else
+    const string path = getSocketPath("test");
+    const string endpoint = "unix -p " + path;
+
+    cout << "testing unix endpoint parsing... " << flush;
+    {
+        Ice::ObjectPrxPtr base = communicator->stringToProxy("test:" + endpoint + " -t 10000 -z");
+        test(base->ice_toString() == "test -t -e 1.1:" + endpoint + " -t 10000 -z");
+        test(communicator->stringToProxy(base->ice_toString())->ice_getEndpoints()[0]->toString() ==
+             base->ice_getEndpoints()[0]->toString());
+
+        Ice::EndpointInfoPtr info = base->ice_getEndpoints()[0]->getInfo();
+        Ice::UnixEndpointInfoPtr unixInfo = ICE_DYNAMIC_CAST(Ice::UnixEndpointInfo, info);
+        test(unixInfo);
+        test(unixInfo->path == path);
+        test(unixInfo->timeout == 10000);
+        test(unixInfo->compress);
+        test(info->type() == Ice::UnixEndpointType);
+        test(!info->datagram());
+        test(!info->secure());
+
+        //
+        // Paths with colons or spaces are quoted.
+        //
+        base = communicator->stringToProxy("test:unix -p \"/tmp/a b:c.sock\"");
+        unixInfo = ICE_DYNAMIC_CAST(Ice::UnixEndpointInfo, base->ice_getEndpoints()[0]->getInfo());
+        test(unixInfo->path == "/tmp/a b:c.sock");
+        test(communicator->stringToProxy(base->ice_toString())->ice_getEndpoints()[0]->toString() ==
+             base->ice_getEndpoints()[0]->toString());
+
+        const string invalid[] =
+        {
+            "unix",
+            "unix -p",
+            "unix -t 1000",
+            "unix -p " + string(sizeof(sockaddr_un().sun_path), 'a'),
+            "unix -p /tmp/x -t",
+            "unix -p /tmp/x -z 1",
+            "unix -p @"
+        };
+        for(size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+        {
+            try
+            {
+                communicator->stringToProxy("test:" + invalid[i]);
+                test(false);
+            }
+            catch(const Ice::EndpointParseException&)
+            {
+            }
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing unix endpoint... " << flush;
+    {
+        RemoteObjectAdapterPrxPtr adapter = server->createObjectAdapter("UnixAdapter", endpoint);
+        test(fileExists(path));
+
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" + endpoint));
+        proxy->ping();
+
+        Ice::UnixEndpointInfoPtr unixInfo =
+            ICE_DYNAMIC_CAST(Ice::UnixEndpointInfo, adapter->getTestIntf()->ice_getEndpoints()[0]->getInfo());
+        test(unixInfo && unixInfo->path == path);
+
+        //
+        // The socket file is removed when the adapter is destroyed.
+        //
+        adapter->deactivate();
+        test(!fileExists(path));
+        try
+        {
+            proxy->ice_connectionId("other")->ping();
+            test(false);
+        }
+        catch(const Ice::SocketException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing connection info... " << flush;
+    {
+        RemoteObjectAdapterPrxPtr adapter = server->createObjectAdapter("InfoAdapter", endpoint);
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" + endpoint));
+
+        Ice::ConnectionInfoPtr info = proxy->ice_getConnection()->getInfo();
+        Ice::UnixConnectionInfoPtr unixInfo = ICE_DYNAMIC_CAST(Ice::UnixConnectionInfo, info);
+        test(unixInfo);
+        test(!unixInfo->incoming);
+        test(unixInfo->path == path);
+        test(unixInfo->peerUid == static_cast<Ice::Int>(getuid()));
+        test(unixInfo->peerGid == static_cast<Ice::Int>(getgid()));
+#if defined(__linux)
+        test(unixInfo->peerPid == proxy->getPid());
+#endif
+
+        //
+        // The server sees the credentials of the client.
+        //
+        Ice::Int pid;
+        Ice::Int uid;
+        Ice::Int gid;
+        proxy->getPeerCredentials(pid, uid, gid);
+        test(uid == static_cast<Ice::Int>(getuid()));
+        test(gid == static_cast<Ice::Int>(getgid()));
+#if defined(__linux)
+        test(pid == static_cast<Ice::Int>(getpid()));
+#endif
+
+        ostringstream os;
+        os << proxy->ice_getConnection()->toString();
+        test(os.str().find("remote address = " + path) != string::npos);
+
+        adapter->deactivate();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing stale socket file... " << flush;
+    {
+        createStaleSocket(path);
+        RemoteObjectAdapterPrxPtr adapter = server->createObjectAdapter("StaleAdapter", endpoint);
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:" + endpoint));
+        proxy->ping();
+
+        //
+        // A socket file with a live acceptor isn't replaced.
+        //
+        try
+        {
+            server->createObjectAdapter("LiveAdapter", endpoint);
+            test(false);
+        }
+        catch(const Ice::UnknownLocalException& ex)
+        {
+            test(ex.unknown.find("SocketException") != string::npos);
+        }
+        test(fileExists(path));
+        proxy->ice_connectionId("live")->ping();
+
+        adapter->deactivate();
+        test(!fileExists(path));
+    }
+    cout << "ok" << endl;
+
+#if defined(__linux)
+    cout << "testing abstract namespace... " << flush;
+    {
+        ostringstream os;
+        os << "@ice-unix-test-" << getpid();
+        const string name = os.str();
+
+        RemoteObjectAdapterPrxPtr adapter = server->createObjectAdapter("AbstractAdapter", "unix -p " + name);
+        TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->stringToProxy("test:unix -p " + name));
+        proxy->ping();
+
+        Ice::UnixConnectionInfoPtr unixInfo =
+            ICE_DYNAMIC_CAST(Ice::UnixConnectionInfo, proxy->ice_getConnection()->getInfo());
+        test(unixInfo && unixInfo->path == name);
+        test(!fileExists(name.substr(1)));
+
+        adapter->deactivate();
+        try
+        {
+            proxy->ice_connectionId("other")->ping();
+            test(false);
+        }
+        catch(const Ice::SocketException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+#endif
+
+#endif
+
+    server->shutdown();
+}
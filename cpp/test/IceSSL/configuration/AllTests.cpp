@@ -2024,6 +2024,231 @@ allTests(const CommunicatorPtr& communicator, const string& testDir, bool p12)
     }
     cout << "ok" << endl;
 
+#ifdef ICE_USE_OPENSSL
+    cout << "testing kernel TLS... " << flush;
+    {
+        //
+        // Kernel TLS is only used if the kernel supports it for the
+        // negotiated cipher, the connection falls back to user space
+        // encryption otherwise. The connection must work in both cases.
+        //
+        InitializationData initData;
+        initData.properties = createClientProps(defaultProps, p12, "c_rsa_ca1", "cacert1");
+        initData.properties->setProperty("IceSSL.KernelTLS", "1");
+        CommunicatorPtr comm = initialize(initData);
+        Test::ServerFactoryPrxPtr fact = ICE_CHECKED_CAST(Test::ServerFactoryPrx, comm->stringToProxy(factoryRef));
+        test(fact);
+        Test::Properties d = createServerProps(defaultProps, p12, "s_rsa_ca1", "cacert1");
+        d["IceSSL.KernelTLS"] = "1";
+        d["IceSSL.VerifyPeer"] = "2";
+        Test::ServerPrxPtr server = fact->createServer(d);
+        try
+        {
+            for(int i = 0; i < 10; ++i)
+            {
+                server->ice_ping();
+            }
+            info = ICE_DYNAMIC_CAST(IceSSL::ConnectionInfo, server->ice_getConnection()->getInfo());
+            test(info->verified);
+            server->checkCipher(info->cipher);
+        }
+        catch(const LocalException& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+        fact->destroyServer(server);
+        comm->destroy();
+    }
+    cout << "ok" << endl;
+
+    cout << "testing session resumption... " << flush;
+    {
+        InitializationData initData;
+        initData.properties = createClientProps(defaultProps, p12, "c_rsa_ca1", "cacert1");
+        initData.properties->setProperty("IceSSL.SessionCache.Size", "10");
+        CommunicatorPtr comm = initialize(initData);
+        Test::ServerFactoryPrxPtr fact = ICE_CHECKED_CAST(Test::ServerFactoryPrx, comm->stringToProxy(factoryRef));
+        test(fact);
+        Test::Properties d = createServerProps(defaultProps, p12, "s_rsa_ca1", "cacert1");
+        d["IceSSL.SessionTicketLifetime"] = "60";
+        d["IceSSL.VerifyPeer"] = "2";
+        d["IceSSL.TrustOnly.Server"] =
+            "C=US, ST=Florida, O=ZeroC\\, Inc., OU=Ice, emailAddress=info@zeroc.com,CN=Client";
+        Test::ServerPrxPtr server = fact->createServer(d);
+        try
+        {
+            IceSSL::CertificatePtr clientCert = IceSSL::OpenSSL::Certificate::load(defaultDir + "/c_rsa_ca1_pub.pem");
+            for(int i = 0; i < 3; ++i)
+            {
+                server->ice_ping();
+                info = ICE_DYNAMIC_CAST(IceSSL::ConnectionInfo, server->ice_getConnection()->getInfo());
+                test(info->resumed == (i > 0));
+                test(info->verified);
+                test(!info->certs.empty());
+
+                //
+                // The peer certificates are still available to the trust manager
+                // and the application when the session is resumed.
+                //
+                server->checkCert(clientCert->getSubjectDN(), clientCert->getIssuerDN());
+                server->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+            }
+        }
+        catch(const LocalException& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+        fact->destroyServer(server);
+        comm->destroy();
+    }
+    {
+        //
+        // Connections aren't resumed if the client doesn't cache the sessions.
+        //
+        InitializationData initData;
+        initData.properties = createClientProps(defaultProps, p12, "c_rsa_ca1", "cacert1");
+        CommunicatorPtr comm = initialize(initData);
+        Test::ServerFactoryPrxPtr fact = ICE_CHECKED_CAST(Test::ServerFactoryPrx, comm->stringToProxy(factoryRef));
+        test(fact);
+        Test::Properties d = createServerProps(defaultProps, p12, "s_rsa_ca1", "cacert1");
+        d["IceSSL.SessionTicketLifetime"] = "60";
+        Test::ServerPrxPtr server = fact->createServer(d);
+        try
+        {
+            for(int i = 0; i < 2; ++i)
+            {
+                server->ice_ping();
+                info = ICE_DYNAMIC_CAST(IceSSL::ConnectionInfo, server->ice_getConnection()->getInfo());
+                test(!info->resumed);
+                server->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+            }
+        }
+        catch(const LocalException& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+        fact->destroyServer(server);
+        comm->destroy();
+    }
+    {
+        //
+        // The session tickets are encrypted with the keys of the key file.
+        //
+        string keyFile = testDir + "/ticketkeys.bin";
+        {
+            ofstream out(keyFile.c_str(), ios::binary);
+            for(int i = 0; i < 80; ++i)
+            {
+                out.put(static_cast<char>(i));
+            }
+        }
+
+        InitializationData initData;
+        initData.properties = createClientProps(defaultProps, p12, "c_rsa_ca1", "cacert1");
+        initData.properties->setProperty("IceSSL.SessionCache.Size", "10");
+        CommunicatorPtr comm = initialize(initData);
+        Test::ServerFactoryPrxPtr fact = ICE_CHECKED_CAST(Test::ServerFactoryPrx, comm->stringToProxy(factoryRef));
+        test(fact);
+        Test::Properties d = createServerProps(defaultProps, p12, "s_rsa_ca1", "cacert1");
+        d["IceSSL.SessionIdContext"] = "configuration";
+        d["IceSSL.SessionTicketKeyFile"] = keyFile;
+        Test::ServerPrxPtr server = fact->createServer(d);
+        try
+        {
+            for(int i = 0; i < 2; ++i)
+            {
+                server->ice_ping();
+                info = ICE_DYNAMIC_CAST(IceSSL::ConnectionInfo, server->ice_getConnection()->getInfo());
+                test(info->resumed == (i > 0));
+                server->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+            }
+        }
+        catch(const LocalException& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+        fact->destroyServer(server);
+        comm->destroy();
+        remove(keyFile.c_str());
+    }
+    cout << "ok" << endl;
+
+    cout << "testing handshake thread pool... " << flush;
+    {
+        InitializationData initData;
+        initData.properties = createClientProps(defaultProps, p12, "c_rsa_ca1", "cacert1");
+        initData.properties->setProperty("IceSSL.HandshakeThreads", "2");
+        CommunicatorPtr comm = initialize(initData);
+        Test::ServerFactoryPrxPtr fact = ICE_CHECKED_CAST(Test::ServerFactoryPrx, comm->stringToProxy(factoryRef));
+        test(fact);
+        Test::Properties d = createServerProps(defaultProps, p12, "s_rsa_ca1", "cacert1");
+        d["IceSSL.HandshakeThreads"] = "2";
+        d["IceSSL.VerifyPeer"] = "2";
+        Test::ServerPrxPtr server = fact->createServer(d);
+        try
+        {
+            //
+            // Establish several connections, each connection handshake is
+            // performed by the handshake threads of both the client and the
+            // server.
+            //
+            IceSSL::CertificatePtr clientCert = IceSSL::OpenSSL::Certificate::load(defaultDir + "/c_rsa_ca1_pub.pem");
+            for(int i = 0; i < 5; ++i)
+            {
+                ostringstream os;
+                os << "handshake-" << i;
+                Test::ServerPrxPtr prx = ICE_UNCHECKED_CAST(Test::ServerPrx, server->ice_connectionId(os.str()));
+                prx->ice_ping();
+                info = ICE_DYNAMIC_CAST(IceSSL::ConnectionInfo, prx->ice_getConnection()->getInfo());
+                test(info->verified);
+                test(!info->certs.empty());
+                prx->checkCert(clientCert->getSubjectDN(), clientCert->getIssuerDN());
+            }
+        }
+        catch(const LocalException& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+        fact->destroyServer(server);
+        comm->destroy();
+
+        //
+        // Verification failures are reported to the connection.
+        //
+        initData.properties = createClientProps(defaultProps, p12, "", "");
+        initData.properties->setProperty("IceSSL.HandshakeThreads", "2");
+        comm = initialize(initData);
+        fact = ICE_CHECKED_CAST(Test::ServerFactoryPrx, comm->stringToProxy(factoryRef));
+        test(fact);
+        d = createServerProps(defaultProps, p12, "s_rsa_ca1", "cacert1");
+        d["IceSSL.HandshakeThreads"] = "2";
+        d["IceSSL.VerifyPeer"] = "0";
+        server = fact->createServer(d);
+        try
+        {
+            server->ice_ping();
+            test(false);
+        }
+        catch(const SecurityException&)
+        {
+            // Expected.
+        }
+        catch(const LocalException& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+        fact->destroyServer(server);
+        comm->destroy();
+    }
+    cout << "ok" << endl;
+#endif
+
     //
     // IceSSL.Protocols is not supported with UWP
     //
@@ -3822,6 +4047,81 @@ allTests(const CommunicatorPtr& communicator, const string& testDir, bool p12)
     }
     cout << "ok" << endl;
 
+#ifndef ICE_OS_UWP
+    cout << "testing trust manager cache... " << flush;
+    {
+        InitializationData initData;
+        initData.properties = createClientProps(defaultProps, p12, "c_rsa_ca1", "cacert1");
+        initData.properties->setProperty("IceSSL.TrustCache.Size", "10");
+        initData.properties->setProperty("IceSSL.TrustOnly.Client", "CN=Server");
+        initData.properties->setProperty("Ice.Admin.Endpoints", "tcp -h 127.0.0.1");
+        initData.properties->setProperty("Ice.Admin.InstanceName", "client");
+        initData.properties->setProperty("Ice.RetryIntervals", "-1");
+        CommunicatorPtr comm = initialize(initData);
+        IceSSL::PluginPtr plugin = ICE_DYNAMIC_CAST(IceSSL::Plugin, comm->getPluginManager()->getPlugin("IceSSL"));
+        test(plugin);
+
+        Test::ServerFactoryPrxPtr fact = ICE_CHECKED_CAST(Test::ServerFactoryPrx, comm->stringToProxy(factoryRef));
+        test(fact);
+        Test::Properties d = createServerProps(defaultProps, p12, "s_rsa_ca1", "cacert1");
+        Test::ServerPrxPtr server = fact->createServer(d);
+        try
+        {
+            //
+            // Only the first connection evaluates the trust rules, the
+            // decision is cached for the next connections.
+            //
+            for(int i = 0; i < 3; ++i)
+            {
+                server->ice_ping();
+                server->ice_getConnection()->close(Ice::ICE_SCOPED_ENUM(ConnectionClose, GracefullyWithWait));
+            }
+            Ice::Long hits, misses;
+            plugin->getTrustCacheStatistics(hits, misses);
+            test(hits == 2 && misses == 1);
+
+            //
+            // Updating the rules through the Properties admin facet flushes
+            // the cache.
+            //
+            Ice::ObjectPrxPtr admin = comm->getAdmin();
+#ifdef ICE_CPP11_MAPPING
+            shared_ptr<Ice::PropertiesAdminPrx> pa = Ice::checkedCast<Ice::PropertiesAdminPrx>(admin, "Properties");
+#else
+            Ice::PropertiesAdminPrx pa = Ice::PropertiesAdminPrx::checkedCast(admin, "Properties");
+#endif
+            Ice::PropertyDict changes;
+            changes["IceSSL.TrustOnly.Client"] = "!CN=Server";
+            pa->setProperties(changes);
+            try
+            {
+                server->ice_ping();
+                test(false);
+            }
+            catch(const SecurityException&)
+            {
+                // Expected.
+            }
+            plugin->getTrustCacheStatistics(hits, misses);
+            test(hits == 2 && misses == 2);
+
+            changes["IceSSL.TrustOnly.Client"] = "CN=Server";
+            pa->setProperties(changes);
+            server->ice_ping();
+            plugin->getTrustCacheStatistics(hits, misses);
+            test(hits == 2 && misses == 3);
+        }
+        catch(const LocalException& ex)
+        {
+            cerr << ex << endl;
+            test(false);
+        }
+        fact->destroyServer(server);
+        comm->destroy();
+    }
+    cout << "ok" << endl;
+#endif
+
     {
 #if defined(ICE_USE_SCHANNEL)
         cout << "testing IceSSL.FindCert... " << flush;
@@ -8,6 +8,7 @@
 // **********************************************************************
 
 #include <IceUtil/Timer.h>
+#include <IceUtil/TimerWheel.h>
 #include <TestCommon.h>
 
 #include <vector>
@@ -152,11 +153,32 @@ private:
 };
 ICE_DEFINE_PTR(DestroyTaskPtr, DestroyTask);
 
-int main(int, char**)
+typedef IceUtil::TimerPtr (*TimerFactory)();
+
+IceUtil::TimerPtr
+createTimer()
+{
+    return new IceUtil::Timer();
+}
+
+IceUtil::TimerPtr
+createTimerWheel()
+{
+    return new IceUtil::TimerWheel(IceUtil::Time::milliSeconds(10), 1);
+}
+
+IceUtil::TimerPtr
+createTimerWheelThreads()
 {
-    cout << "testing timer... " << flush;
+    return new IceUtil::TimerWheel(IceUtil::Time::milliSeconds(10), 4);
+}
+
+void
+testTimer(const string& name, TimerFactory createTimer)
+{
+    cout << "testing " << name << "... " << flush;
     {
-        IceUtil::TimerPtr timer = new IceUtil::Timer();
+        IceUtil::TimerPtr timer = createTimer();
 
         {
             TestTaskPtr task = ICE_MAKE_SHARED(TestTask);
@@ -243,10 +265,10 @@ int main(int, char**)
     }
     cout << "ok" << endl;
 
-    cout << "testing timer destroy... " << flush;
+    cout << "testing " << name << " destroy... " << flush;
     {
         {
-            IceUtil::TimerPtr timer = new IceUtil::Timer();
+            IceUtil::TimerPtr timer = createTimer();
             DestroyTaskPtr destroyTask = ICE_MAKE_SHARED(DestroyTask, timer);
             timer->schedule(destroyTask, IceUtil::Time());
             destroyTask->waitForRun();
@@ -260,7 +282,7 @@ int main(int, char**)
             }
         }
         {
-            IceUtil::TimerPtr timer = new IceUtil::Timer();
+            IceUtil::TimerPtr timer = createTimer();
             TestTaskPtr testTask = ICE_MAKE_SHARED(TestTask);
             timer->schedule(testTask, IceUtil::Time());
             timer->destroy();
@@ -275,6 +297,13 @@ int main(int, char**)
         }
     }
     cout << "ok" << endl;
+}
+
+int main(int, char**)
+{
+    testTimer("timer", createTimer);
+    testTimer("timer wheel", createTimerWheel);
+    testTimer("timer wheel with 4 threads", createTimerWheelThreads);
 
     return EXIT_SUCCESS;
 }